@@ -0,0 +1,359 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include "MediaLibrary.h"
+#include "compat/ConditionVariable.h"
+#include "compat/Mutex.h"
+#include "logging/IostreamLogger.h"
+#include "logging/Logger.h"
+#include "medialibrary/parser/IItem.h"
+#include "medialibrary/parser/IParserService.h"
+#include "medialibrary/parser/Parser.h"
+#include "mocks/FileSystem.h"
+#include "mocks/filesystem/MockFile.h"
+#include "test/common/NoopCallback.h"
+#include "utils/Directory.h"
+#include "utils/File.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace medialibrary;
+
+namespace
+{
+
+const std::string BenchFolder = "/tmp/bench_ml_discovery/";
+const std::string DbPath = BenchFolder + "bench.db";
+
+/* Not a global, since mock::FileSystemFactory::Root could be initialized after it */
+std::string rootMrl()
+{
+    return mock::FileSystemFactory::Root + "library/";
+}
+
+/*
+ * Describes the generated tree:
+ * - the number of nested folder levels below the root
+ * - the number of sub folders in each folder
+ * - the number of files in each folder
+ * - the percentage of audio files, the others being video files
+ */
+struct TreeConfig
+{
+    int64_t depth;
+    int64_t fanOut;
+    int64_t filesPerFolder;
+    int64_t audioPercent;
+};
+
+TreeConfig treeConfig( const benchmark::State& state )
+{
+    return TreeConfig{ state.range( 0 ), state.range( 1 ),
+                       state.range( 2 ), state.range( 3 ) };
+}
+
+void populate( mock::FileSystemFactory& fsFactory, const std::string& folder,
+               int64_t depth, const TreeConfig& cfg,
+               std::vector<std::string>& mrls )
+{
+    for ( auto i = 0; i < cfg.filesPerFolder; ++i )
+    {
+        /* Spread the audio files evenly rather than grouping them */
+        auto isAudio = static_cast<int64_t>( mrls.size() % 100 ) < cfg.audioPercent;
+        auto mrl = folder + "file_" + std::to_string( i ) +
+                   ( isAudio ? ".mp3" : ".mkv" );
+        fsFactory.addFile( mrl );
+        mrls.push_back( std::move( mrl ) );
+    }
+    if ( depth == 0 )
+        return;
+    for ( auto i = 0; i < cfg.fanOut; ++i )
+    {
+        auto subFolder = folder + "dir_" + std::to_string( i ) + "/";
+        fsFactory.addFolder( subFolder );
+        populate( fsFactory, subFolder, depth - 1, cfg, mrls );
+    }
+}
+
+/*
+ * Fills the item the way the libvlc based extraction would, without actually
+ * probing anything. Audio files are spread over a few albums so the analysis
+ * step has some artists & albums to create.
+ */
+class StubExtractionService : public parser::IParserService
+{
+public:
+    virtual parser::Status run( parser::IItem& item ) override
+    {
+        const auto& mrl = item.mrl();
+        auto isAudio = mrl.compare( mrl.size() - 4, 4, ".mp3" ) == 0;
+        auto nameHash = std::hash<std::string>{}( mrl );
+
+        parser::IItem::Track audio{};
+        audio.type = parser::IItem::Track::Type::Audio;
+        audio.codec = "mp4a";
+        audio.bitrate = 128000;
+        audio.u.a.nbChannels = 2;
+        audio.u.a.rate = 44100;
+        item.addTrack( std::move( audio ) );
+        if ( isAudio == true )
+        {
+            auto album = nameHash % 64;
+            item.setMeta( parser::IItem::Metadata::Title, "Track " + mrl );
+            item.setMeta( parser::IItem::Metadata::Artist,
+                          "Artist " + std::to_string( album % 16 ) );
+            item.setMeta( parser::IItem::Metadata::Album,
+                          "Album " + std::to_string( album ) );
+            item.setMeta( parser::IItem::Metadata::TrackNumber,
+                          std::to_string( nameHash % 12 + 1 ) );
+        }
+        else
+        {
+            parser::IItem::Track video{};
+            video.type = parser::IItem::Track::Type::Video;
+            video.codec = "h264";
+            video.bitrate = 4000000;
+            video.u.v.width = 1920;
+            video.u.v.height = 1080;
+            video.u.v.sarNum = 1;
+            video.u.v.sarDen = 1;
+            video.u.v.fpsNum = 25;
+            video.u.v.fpsDen = 1;
+            item.addTrack( std::move( video ) );
+        }
+        item.setDuration( static_cast<int64_t>( 60000 + nameHash % 3600000 ) );
+        return parser::Status::Success;
+    }
+
+    virtual const char* name() const override
+    {
+        return "StubExtraction";
+    }
+
+    virtual parser::Step targetedStep() const override
+    {
+        return parser::Step::MetadataExtraction;
+    }
+
+    virtual bool initialize( IMediaLibrary* ) override
+    {
+        return true;
+    }
+
+    virtual void onFlushing() override
+    {
+    }
+
+    virtual void onRestarted() override
+    {
+    }
+
+    virtual void stop() override
+    {
+    }
+};
+
+class BenchCallback : public mock::NoopCallback
+{
+public:
+    virtual void onDiscoveryCompleted() override
+    {
+        {
+            std::lock_guard<compat::Mutex> lock( m_mutex );
+            m_discoveryDone = true;
+        }
+        m_cond.notify_all();
+    }
+
+    /* Must be called before triggering the discovery */
+    void prepareWait()
+    {
+        std::lock_guard<compat::Mutex> lock( m_mutex );
+        m_discoveryDone = false;
+    }
+
+    void waitDiscovery()
+    {
+        std::unique_lock<compat::Mutex> lock( m_mutex );
+        m_cond.wait( lock, [this]() { return m_discoveryDone; } );
+    }
+
+private:
+    compat::Mutex m_mutex;
+    compat::ConditionVariable m_cond;
+    bool m_discoveryDone = false;
+};
+
+class BenchMediaLibrary : public MediaLibrary
+{
+public:
+    BenchMediaLibrary( std::shared_ptr<mock::FileSystemFactory> fsFactory,
+                       const SetupConfig* cfg )
+        : MediaLibrary( DbPath, BenchFolder, nullptr, cfg )
+        , m_fsFactory( std::move( fsFactory ) )
+    {
+    }
+
+    /* Waits for the discovery to complete, and for all its tasks to be parsed */
+    void waitCompletion( BenchCallback& cb )
+    {
+        cb.waitDiscovery();
+        waitForBackgroundTasksIdle();
+    }
+
+    virtual void addLocalFsFactory() override
+    {
+        m_fsHolder.addFsFactory( m_fsFactory );
+    }
+
+    virtual void populateNetworkFsFactories() override
+    {
+    }
+
+private:
+    std::shared_ptr<mock::FileSystemFactory> m_fsFactory;
+};
+
+struct BenchSetup
+{
+    BenchCallback cb;
+    std::shared_ptr<mock::FileSystemFactory> fsFactory;
+    std::unique_ptr<BenchMediaLibrary> ml;
+    std::vector<std::string> mrls;
+
+    explicit BenchSetup( const TreeConfig& treeCfg )
+        : fsFactory( std::make_shared<mock::FileSystemFactory>() )
+    {
+        /* This is usually done by NewMediaLibrary */
+        Log::SetLogger( std::make_shared<IostreamLogger>() );
+        Log::setLogLevel( LogLevel::Error );
+        utils::fs::mkdir( BenchFolder );
+        for ( const auto& ext : { "", "-wal", "-shm" } )
+            utils::fs::remove( DbPath + ext );
+        fsFactory->addFolder( rootMrl() );
+        populate( *fsFactory, rootMrl(), treeCfg.depth, treeCfg, mrls );
+
+        SetupConfig cfg;
+        cfg.parserServices.push_back( std::make_shared<StubExtractionService>() );
+        ml = std::make_unique<BenchMediaLibrary>( fsFactory, &cfg );
+        if ( ml->initialize( &cb ) != InitializeResult::Success )
+            abort();
+    }
+
+    void discover()
+    {
+        cb.prepareWait();
+        ml->discover( rootMrl() );
+        ml->waitCompletion( cb );
+    }
+
+    void reload()
+    {
+        cb.prepareWait();
+        ml->reload();
+        ml->waitCompletion( cb );
+    }
+};
+
+void setCounters( benchmark::State& state, size_t nbFiles )
+{
+    state.counters["files"] = static_cast<double>( nbFiles );
+    state.counters["files/s"] = benchmark::Counter(
+                static_cast<double>( nbFiles * state.iterations() ),
+                benchmark::Counter::kIsRate );
+}
+
+}
+
+static void BenchInitialDiscovery( benchmark::State& state )
+{
+    auto treeCfg = treeConfig( state );
+    size_t nbFiles = 0;
+    while ( state.KeepRunning() )
+    {
+        state.PauseTiming();
+        {
+            BenchSetup setup{ treeCfg };
+            nbFiles = setup.mrls.size();
+            state.ResumeTiming();
+            setup.discover();
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    setCounters( state, nbFiles );
+}
+
+/* Reloads an unchanged tree, which only has to compare the folders' content */
+static void BenchNoopRescan( benchmark::State& state )
+{
+    BenchSetup setup{ treeConfig( state ) };
+    setup.discover();
+    while ( state.KeepRunning() )
+        setup.reload();
+    setCounters( state, setup.mrls.size() );
+}
+
+/* Reloads a tree where 10% of the files were modified, and have to be refreshed */
+static void BenchPartialRescan( benchmark::State& state )
+{
+    BenchSetup setup{ treeConfig( state ) };
+    setup.discover();
+    while ( state.KeepRunning() )
+    {
+        state.PauseTiming();
+        for ( auto i = 0u; i < setup.mrls.size(); i += 10 )
+        {
+            auto f = std::static_pointer_cast<mock::File>(
+                        setup.fsFactory->file( setup.mrls[i] ) );
+            f->markAsModified();
+        }
+        state.ResumeTiming();
+        setup.reload();
+    }
+    setCounters( state, setup.mrls.size() );
+}
+
+/* { depth, fan out, files per folder, audio percentage } */
+static void TreeShapes( benchmark::internal::Benchmark* b )
+{
+    b->Args( { 1, 10, 50, 50 } );
+    b->Args( { 3, 4, 20, 80 } );
+    b->Args( { 2, 30, 5, 20 } );
+}
+
+BENCHMARK(BenchInitialDiscovery)->Apply( TreeShapes )
+    ->UseRealTime()->Unit( benchmark::kMillisecond );
+BENCHMARK(BenchNoopRescan)->Apply( TreeShapes )
+    ->UseRealTime()->Unit( benchmark::kMillisecond );
+BENCHMARK(BenchPartialRescan)->Apply( TreeShapes )
+    ->UseRealTime()->Unit( benchmark::kMillisecond );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <benchmark/benchmark.h>
+#include "utils/SWMRLock.h"
+
+using namespace medialibrary;
+
+namespace
+{
+
+utils::SWMRLock lock;
+
+}
+
+/* Only touches the atomic reader count */
+static void BenchUncontendedRead( benchmark::State& state )
+{
+    while ( state.KeepRunning() )
+    {
+        lock.lock_read();
+        lock.unlock_read();
+    }
+}
+
+/* Readers only, sharing the lock from several threads */
+static void BenchConcurrentReads( benchmark::State& state )
+{
+    while ( state.KeepRunning() )
+    {
+        lock.lock_read();
+        lock.unlock_read();
+    }
+}
+
+/* One writer for every 16 reads, which forces the readers on the slow path */
+static void BenchMixedReadWrite( benchmark::State& state )
+{
+    if ( state.thread_index() == 0 )
+        lock.setPolicy( static_cast<LockPolicy>( state.range( 0 ) ), 8 );
+    while ( state.KeepRunning() )
+    {
+        if ( state.iterations() % 16 == 0 )
+        {
+            lock.lock_write();
+            lock.unlock_write();
+        }
+        else
+        {
+            lock.lock_read();
+            lock.unlock_read();
+        }
+    }
+}
+
+BENCHMARK(BenchUncontendedRead);
+BENCHMARK(BenchConcurrentReads)->ThreadRange( 2, 8 );
+BENCHMARK(BenchMixedReadWrite)
+    ->Arg( static_cast<int>( LockPolicy::ReaderPreferring ) )
+    ->Arg( static_cast<int>( LockPolicy::WriterPreferring ) )
+    ->Arg( static_cast<int>( LockPolicy::BoundedWriterBatches ) )
+    ->ThreadRange( 2, 8 );
+
+BENCHMARK_MAIN();
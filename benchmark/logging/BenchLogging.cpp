@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <string>
+#include "logging/Logger.h"
+#include "logging/AsyncLogger.h"
+
+using namespace medialibrary;
+
+namespace
+{
+
+/* A sink which serializes its callers, as most application loggers do */
+class LockedLogger : public ILogger
+{
+public:
+    virtual void Error( const std::string& msg ) override { write( msg ); }
+    virtual void Warning( const std::string& msg ) override { write( msg ); }
+    virtual void Info( const std::string& msg ) override { write( msg ); }
+    virtual void Debug( const std::string& msg ) override { write( msg ); }
+    virtual void Verbose( const std::string& msg ) override { write( msg ); }
+
+private:
+    void write( const std::string& msg )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_size += msg.size();
+        benchmark::DoNotOptimize( m_size );
+    }
+
+    std::mutex m_mutex;
+    size_t m_size = 0;
+};
+
+const std::string mrl = "file:///home/otter/Videos/The Fluffy Sea Otters Chronicles/"
+                        "Season 01/Episode 04 - Holding hands.mkv";
+
+/* Mimics the copies made by the hot paths when logging, ie. task->mrl() */
+std::string copyMrl()
+{
+    return mrl;
+}
+
+}
+
+static void BenchDisabledLog( benchmark::State& state )
+{
+    Log::SetLogger( std::make_shared<LockedLogger>() );
+    Log::setLogLevel( LogLevel::Info );
+    while ( state.KeepRunning() )
+        LOG_DEBUG( "Parsing ", copyMrl(), " at step ", state.iterations() );
+}
+
+/* The baseline, for the disabled log to be compared with */
+static void BenchNoLog( benchmark::State& state )
+{
+    while ( state.KeepRunning() )
+        benchmark::ClobberMemory();
+}
+
+static void BenchSyncLog( benchmark::State& state )
+{
+    if ( state.thread_index() == 0 )
+    {
+        Log::SetLogger( std::make_shared<LockedLogger>() );
+        Log::setLogLevel( LogLevel::Debug );
+    }
+    while ( state.KeepRunning() )
+        LOG_DEBUG( "Parsing ", copyMrl(), " at step ", state.iterations() );
+}
+
+static void BenchAsyncLog( benchmark::State& state )
+{
+    if ( state.thread_index() == 0 )
+    {
+        Log::SetLogger( std::make_shared<AsyncLogger>(
+                            std::make_shared<LockedLogger>() ) );
+        Log::setLogLevel( LogLevel::Debug );
+    }
+    while ( state.KeepRunning() )
+        LOG_DEBUG( "Parsing ", copyMrl(), " at step ", state.iterations() );
+}
+
+BENCHMARK(BenchNoLog);
+BENCHMARK(BenchDisabledLog);
+BENCHMARK(BenchSyncLog)->ThreadRange( 1, 8 );
+BENCHMARK(BenchAsyncLog)->ThreadRange( 1, 8 );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,264 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "BenchRequestsCommon.h"
+#include <benchmark/benchmark.h>
+#include "medialibrary/IFolder.h"
+#include "medialibrary/IPlaylist.h"
+
+#include <functional>
+
+/*
+ * Those benchmarks run on generated libraries, see LibrarySizes for how to
+ * select their size. The first argument is always the number of media.
+ */
+
+namespace
+{
+
+/* The generator favors the first words of its vocabulary */
+const char* const Patterns[] = { "love", "memory", "night dream" };
+
+constexpr uint32_t PageSize = 100;
+
+uint32_t librarySize( const benchmark::State& state )
+{
+    return static_cast<uint32_t>( state.range( 0 ) );
+}
+
+}
+
+static void SearchPatterns( benchmark::internal::Benchmark* b )
+{
+    for ( const auto s : librarySizes() )
+        for ( auto i = 0u; i < sizeof( Patterns ) / sizeof( Patterns[0] ); ++i )
+            b->Args( { s, static_cast<int64_t>( i ) } );
+}
+
+static void SearchMedia( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    const std::string pattern = Patterns[state.range( 1 )];
+    for ( auto _ : state )
+    {
+        auto media = bml.ml->searchMedia( pattern, nullptr )->items( PageSize, 0 );
+        benchmark::DoNotOptimize( media );
+    }
+}
+
+static void SearchAlbums( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    const std::string pattern = Patterns[state.range( 1 )];
+    for ( auto _ : state )
+    {
+        auto albums = bml.ml->searchAlbums( pattern, nullptr )->items( PageSize, 0 );
+        benchmark::DoNotOptimize( albums );
+    }
+}
+
+/* Runs all the queries a global search screen would display */
+static void SearchAll( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    const std::string pattern = Patterns[state.range( 1 )];
+    for ( auto _ : state )
+    {
+        auto res = bml.ml->search( pattern, nullptr );
+        auto albums = res.albums->items( PageSize, 0 );
+        auto artists = res.artists->items( PageSize, 0 );
+        auto genres = res.genres->items( PageSize, 0 );
+        auto media = res.media->items( PageSize, 0 );
+        auto shows = res.shows->items( PageSize, 0 );
+        auto playlists = res.playlists->items( PageSize, 0 );
+        benchmark::DoNotOptimize( albums );
+        benchmark::DoNotOptimize( artists );
+        benchmark::DoNotOptimize( genres );
+        benchmark::DoNotOptimize( media );
+        benchmark::DoNotOptimize( shows );
+        benchmark::DoNotOptimize( playlists );
+    }
+}
+
+static void ListHistory( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    for ( auto _ : state )
+    {
+        auto history = bml.ml->history( HistoryType::Global, nullptr )->items( PageSize, 0 );
+        benchmark::DoNotOptimize( history );
+    }
+}
+
+static void ListMediaGroups( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    for ( auto _ : state )
+    {
+        auto groups = bml.ml->mediaGroups( IMedia::Type::Unknown, nullptr )->items( PageSize, 0 );
+        benchmark::DoNotOptimize( groups );
+    }
+}
+
+static void ListFolders( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    QueryParameters params{};
+    params.sort = SortingCriteria::NbMedia;
+    params.desc = true;
+    for ( auto _ : state )
+    {
+        auto folders = bml.ml->folders( IMedia::Type::Unknown, &params )->items( PageSize, 0 );
+        benchmark::DoNotOptimize( folders );
+    }
+}
+
+/* Lists the content of the folder containing the most videos */
+static void ListFolderMedia( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    QueryParameters params{};
+    params.sort = SortingCriteria::NbVideo;
+    params.desc = true;
+    auto folders = bml.ml->folders( IMedia::Type::Video, &params )->items( 1, 0 );
+    if ( folders.empty() == true )
+        abort();
+    for ( auto _ : state )
+    {
+        auto media = folders[0]->media( IMedia::Type::Unknown, nullptr )->items( PageSize, 0 );
+        benchmark::DoNotOptimize( media );
+    }
+}
+
+static void ListPlaylists( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    for ( auto _ : state )
+    {
+        auto playlists = bml.ml->playlists( PlaylistType::All, nullptr )->items( PageSize, 0 );
+        benchmark::DoNotOptimize( playlists );
+    }
+}
+
+static void ListPlaylistMedia( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    auto playlist = bml.ml->playlist( 1 );
+    if ( playlist == nullptr )
+        abort();
+    for ( auto _ : state )
+    {
+        auto media = playlist->media( nullptr )->all();
+        benchmark::DoNotOptimize( media );
+    }
+}
+
+/* The second argument is the position of the page, as a percentage of the list */
+static void PageDepths( benchmark::internal::Benchmark* b )
+{
+    for ( const auto s : librarySizes() )
+        for ( const auto depth : { 0, 50, 100 } )
+            b->Args( { s, depth } );
+}
+
+static void PaginateAudio( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    QueryParameters params{};
+    params.sort = SortingCriteria::Alpha;
+    auto query = bml.ml->audioFiles( &params );
+    auto count = query->count();
+    auto offset = count > PageSize ?
+                static_cast<uint32_t>( ( count - PageSize ) * state.range( 1 ) / 100 ) : 0;
+    for ( auto _ : state )
+    {
+        auto media = query->items( PageSize, offset );
+        benchmark::DoNotOptimize( media );
+    }
+}
+
+enum class CountedQuery
+{
+    Audio,
+    Video,
+    Albums,
+    Artists,
+    History,
+    Search,
+};
+
+static void CountedQueries( benchmark::internal::Benchmark* b )
+{
+    for ( const auto s : librarySizes() )
+        for ( auto q = CountedQuery::Audio; q <= CountedQuery::Search;
+              q = static_cast<CountedQuery>( static_cast<int>( q ) + 1 ) )
+            b->Args( { s, static_cast<int64_t>( q ) } );
+}
+
+static void CountQuery( benchmark::State& state )
+{
+    auto bml = generatedInit( librarySize( state ) );
+    auto ml = bml.ml.get();
+    std::function<size_t()> count;
+    switch ( static_cast<CountedQuery>( state.range( 1 ) ) )
+    {
+        case CountedQuery::Audio:
+            count = [ml]() { return ml->audioFiles( nullptr )->count(); };
+            break;
+        case CountedQuery::Video:
+            count = [ml]() { return ml->videoFiles( nullptr )->count(); };
+            break;
+        case CountedQuery::Albums:
+            count = [ml]() { return ml->albums( nullptr )->count(); };
+            break;
+        case CountedQuery::Artists:
+            count = [ml]() { return ml->artists( ArtistIncluded::All, nullptr )->count(); };
+            break;
+        case CountedQuery::History:
+            count = [ml]() { return ml->history( HistoryType::Global, nullptr )->count(); };
+            break;
+        case CountedQuery::Search:
+            count = [ml]() { return ml->searchMedia( Patterns[0], nullptr )->count(); };
+            break;
+    }
+    for ( auto _ : state )
+    {
+        auto res = count();
+        benchmark::DoNotOptimize( res );
+    }
+}
+
+BENCHMARK( SearchMedia )->Apply( SearchPatterns );
+BENCHMARK( SearchAlbums )->Apply( SearchPatterns );
+BENCHMARK( SearchAll )->Apply( SearchPatterns );
+BENCHMARK( ListHistory )->Apply( LibrarySizes );
+BENCHMARK( ListMediaGroups )->Apply( LibrarySizes );
+BENCHMARK( ListFolders )->Apply( LibrarySizes );
+BENCHMARK( ListFolderMedia )->Apply( LibrarySizes );
+BENCHMARK( ListPlaylists )->Apply( LibrarySizes );
+BENCHMARK( ListPlaylistMedia )->Apply( LibrarySizes );
+BENCHMARK( PaginateAudio )->Apply( PageDepths );
+BENCHMARK( CountQuery )->Apply( CountedQueries );
@@ -25,15 +25,142 @@
 #endif
 
 #include "BenchRequestsCommon.h"
+#include "LibraryGenerator.h"
+#include "logging/IostreamLogger.h"
+#include "logging/Logger.h"
+#include "mocks/FileSystem.h"
 #include "utils/File.h"
 #include "medialibrary/filesystem/Errors.h"
 
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t GeneratorSeed = 0x6d6c;
+
+/*
+ * The generated media are stored on the mock file system root device, so the
+ * library is not flagged as missing when it gets opened again.
+ */
+class GeneratedMediaLibrary : public MediaLibrary
+{
+public:
+    explicit GeneratedMediaLibrary( const std::string& dbPath )
+        : MediaLibrary( dbPath, "/tmp/bench_ml", nullptr, nullptr )
+        , m_fsFactory( std::make_shared<mock::FileSystemFactory>() )
+    {
+    }
+
+    fs::IDevice& rootDevice()
+    {
+        return *m_fsFactory->device( mock::FileSystemFactory::Root );
+    }
+
+    /* Nothing is left to parse, and no parser thread competes with the queries */
+    virtual parser::Parser* getParser() const override
+    {
+        return nullptr;
+    }
+
+    virtual void addLocalFsFactory() override
+    {
+        m_fsHolder.addFsFactory( m_fsFactory );
+    }
+
+    virtual void populateNetworkFsFactories() override
+    {
+    }
+
+private:
+    std::shared_ptr<mock::FileSystemFactory> m_fsFactory;
+};
+
+bool isEmpty( const std::string& db )
+{
+    try
+    {
+        return utils::fs::fileSize( db ) == 0;
+    }
+    catch ( const fs::errors::Exception& )
+    {
+        return true;
+    }
+}
+
+std::unique_ptr<GeneratedMediaLibrary> openGenerated( const std::string& dbPath,
+                                                      mock::NoopCallback& cb )
+{
+    /* This is usually done by NewMediaLibrary */
+    Log::SetLogger( std::make_shared<IostreamLogger>() );
+    Log::setLogLevel( LogLevel::Error );
+    auto ml = std::make_unique<GeneratedMediaLibrary>( dbPath );
+    if ( ml->initialize( &cb ) != InitializeResult::Success )
+        abort();
+    return ml;
+}
+
+}
+
+BenchMedialib generatedInit( uint32_t nbMedia )
+{
+    BenchMedialib bml;
+    auto db = "bench_library_" + std::to_string( nbMedia ) + ".db";
+    if ( isEmpty( db ) == true )
+    {
+        /*
+         * Generate in a temporary file, so an interrupted generation doesn't
+         * leave a partial library behind.
+         */
+        auto tmpDb = db + ".tmp";
+        for ( const auto& ext : { "", "-wal", "-shm" } )
+            utils::fs::remove( tmpDb + ext );
+        {
+            auto ml = openGenerated( tmpDb, bml.cb );
+            generateLibrary( ml.get(), ml->rootDevice(),
+                             mock::FileSystemFactory::Root + "library/",
+                             nbMedia, GeneratorSeed );
+        }
+        if ( utils::fs::rename( tmpDb, db ) == false )
+            abort();
+    }
+    bml.ml = openGenerated( db, bml.cb );
+    return bml;
+}
+
+std::vector<int64_t> librarySizes()
+{
+    auto sizes = getenv( "ML_BENCH_LIBRARY_SIZES" );
+    if ( sizes == nullptr )
+        return { 10000 };
+    std::vector<int64_t> res;
+    for ( auto s = sizes; *s != 0; )
+    {
+        char* end;
+        auto size = strtol( s, &end, 10 );
+        if ( end == s || size <= 0 )
+            abort();
+        res.push_back( size );
+        s = *end == ',' ? end + 1 : end;
+    }
+    return res;
+}
+
+void LibrarySizes( benchmark::internal::Benchmark* b )
+{
+    for ( const auto s : librarySizes() )
+        b->Arg( s );
+}
+
 BenchMedialib commonInit()
 {
     BenchMedialib bml;
     auto db = "bench.db";
-    if ( utils::fs::fileSize( db ) == 0 )
-        abort();
+    /* Fallback to a generated library when no real database was provided */
+    if ( isEmpty( db ) == true )
+        return generatedInit( 10000 );
     bml.ml.reset(
         NewMediaLibrary( db, "/tmp/bench_ml", false, nullptr ) );
     bml.ml->initialize( &bml.cb );
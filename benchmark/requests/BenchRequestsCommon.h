@@ -24,8 +24,17 @@
 
 #include "MediaLibrary.h"
 #include <memory>
+#include <vector>
 #include "test/common/NoopCallback.h"
 
+namespace benchmark
+{
+namespace internal
+{
+class Benchmark;
+}
+}
+
 using namespace medialibrary;
 
 struct BenchMedialib
@@ -40,3 +49,22 @@ constexpr int64_t toInt( SortingCriteria sc )
 }
 
 BenchMedialib commonInit();
+
+/**
+ * @brief generatedInit Opens a synthetic library containing nbMedia media
+ *
+ * The library is generated on the first use, and kept in the working directory
+ * as bench_library_<nbMedia>.db for the next runs.
+ */
+BenchMedialib generatedInit( uint32_t nbMedia );
+
+/**
+ * @brief librarySizes Returns the generated library sizes to benchmark
+ *
+ * The sizes are read from the ML_BENCH_LIBRARY_SIZES environment variable, as
+ * a comma separated list (ie. "10000,100000,1000000"). It defaults to 10000
+ */
+std::vector<int64_t> librarySizes();
+
+/* Registers one run per library size */
+void LibrarySizes( benchmark::internal::Benchmark* b );
@@ -0,0 +1,145 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "MediaLibrary.h"
+#include "Media.h"
+#include "database/SqliteTools.h"
+#include "utils/File.h"
+#include "utils/SharedPool.h"
+#include "test/common/NoopCallback.h"
+
+using namespace medialibrary;
+
+/*
+ * Count the heap allocations performed by the whole program, in order to
+ * report the number of allocations per materialized row
+ */
+static std::atomic<uint64_t> NbAllocations{ 0 };
+
+void* operator new( size_t size )
+{
+    NbAllocations.fetch_add( 1, std::memory_order_relaxed );
+    if ( size == 0 )
+        size = 1;
+    auto p = malloc( size );
+    if ( p == nullptr )
+        throw std::bad_alloc{};
+    return p;
+}
+
+void operator delete( void* p ) noexcept
+{
+    free( p );
+}
+
+void operator delete( void* p, size_t ) noexcept
+{
+    free( p );
+}
+
+namespace
+{
+
+constexpr auto NbMedia = 10000u;
+
+struct MaterializationMedialib
+{
+    MaterializationMedialib()
+    {
+        const auto dbPath = "bench_materialization.db";
+        utils::fs::remove( dbPath );
+        ml.reset( NewMediaLibrary( dbPath, "/tmp/bench_ml_materialization",
+                                   false, nullptr ) );
+        ml->initialize( &cb );
+        auto mlImpl = static_cast<MediaLibrary*>( ml.get() );
+        auto t = mlImpl->getConn()->newTransaction();
+        for ( auto i = 0u; i < NbMedia; ++i )
+        {
+            Media::createExternal( mlImpl, "a rather long media file name #" +
+                                   std::to_string( i ) + ".mkv", i * 1000 );
+        }
+        t->commit();
+    }
+
+    mock::NoopCallback cb;
+    std::unique_ptr<IMediaLibrary> ml;
+};
+
+MaterializationMedialib& instance()
+{
+    static MaterializationMedialib bml;
+    return bml;
+}
+
+}
+
+/*
+ * Materialize all the media from a single request, either by allocating
+ * each entity on its own, as fetchAll used to do, or by allocating them
+ * from a SharedPool
+ */
+static void MaterializeMedia( benchmark::State& state )
+{
+    auto ml = static_cast<MediaLibrary*>( instance().ml.get() );
+    const auto pooled = state.range( 0 ) != 0;
+    const std::string req = "SELECT * FROM " + Media::Table::Name;
+    uint64_t nbRows = 0;
+    uint64_t nbAllocs = 0;
+    for ( auto _ : state )
+    {
+        auto before = NbAllocations.load( std::memory_order_relaxed );
+        std::vector<std::shared_ptr<IMedia>> res;
+        {
+            OPEN_READ_CONTEXT( ctx, ml->getConn() );
+            sqlite::Statement stmt{ req };
+            stmt.execute();
+            utils::SharedPool pool;
+            sqlite::Row row;
+            while ( ( row = stmt.row() ) != nullptr )
+            {
+                if ( pooled == true )
+                    res.push_back( pool.make_shared<Media>( ml, row ) );
+                else
+                    res.push_back( std::make_shared<Media>( ml, row ) );
+            }
+        }
+        nbAllocs += NbAllocations.load( std::memory_order_relaxed ) - before;
+        nbRows += res.size();
+        benchmark::DoNotOptimize( res );
+    }
+    state.counters["allocs_per_row"] = static_cast<double>( nbAllocs ) / nbRows;
+    state.SetItemsProcessed( nbRows );
+}
+
+BENCHMARK( MaterializeMedia )
+    ->Arg( 0 )
+    ->Arg( 1 );
@@ -0,0 +1,405 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "LibraryGenerator.h"
+
+#include "Album.h"
+#include "Artist.h"
+#include "Device.h"
+#include "Folder.h"
+#include "Genre.h"
+#include "Media.h"
+#include "MediaGroup.h"
+#include "MediaLibrary.h"
+#include "Movie.h"
+#include "Playlist.h"
+#include "Show.h"
+#include "database/SqliteTools.h"
+#include "database/SqliteTransaction.h"
+#include "mocks/FileSystem.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using namespace medialibrary;
+
+namespace
+{
+
+/* The history is relative to a fixed date, so the generated database doesn't
+ * depend on when it was generated */
+constexpr int64_t Now = 1700000000;
+constexpr int64_t TwoYears = 2 * 365 * 24 * 3600;
+
+/* Flush the pending changes every few thousand media */
+constexpr uint32_t MediaPerTransaction = 5000;
+
+const char* const Words[] = {
+    "love", "night", "dream", "fire", "heart", "blue", "river", "shadow",
+    "light", "storm", "city", "ghost", "summer", "winter", "gold", "silver",
+    "wild", "broken", "electric", "silent", "midnight", "ocean", "stone",
+    "glass", "paper", "machine", "garden", "desert", "mirror", "echo",
+    "velvet", "thunder", "crystal", "neon", "hollow", "lonely", "burning",
+    "secret", "falling", "rising", "empire", "signal", "harbor", "forest",
+    "morning", "satellite", "highway", "memory",
+};
+
+const char* const Genres[] = {
+    "Rock", "Pop", "Jazz", "Classical", "Electronic", "Hip-Hop", "Metal",
+    "Folk", "Blues", "Country", "Reggae", "Soul", "Funk", "Punk", "Techno",
+    "House", "Ambient", "Indie", "Alternative", "R&B", "Disco", "Latin",
+    "Soundtrack", "World", "Gospel", "Ska", "Grunge", "Trance", "Dubstep",
+    "Drum & Bass", "Opera", "Swing", "Bossa Nova", "Trip-Hop", "Shoegaze",
+    "Synthwave", "Chiptune", "Lo-Fi", "Post-Rock", "New Wave",
+};
+
+/*
+ * std::mt19937 output is fully specified by the standard, unlike the
+ * std::*_distribution classes, so the values are derived from it by hand to
+ * generate the same library with all standard libraries.
+ */
+class Rng
+{
+public:
+    explicit Rng( uint32_t seed )
+        : m_engine( seed )
+    {
+    }
+
+    /* Returns a value in [0; max[ */
+    uint32_t below( uint32_t max )
+    {
+        return m_engine() % max;
+    }
+
+    /* Returns a value in [min; max] */
+    uint32_t between( uint32_t min, uint32_t max )
+    {
+        return min + below( max - min + 1 );
+    }
+
+    /* Returns a value in [0; max[, low values being much more likely */
+    uint32_t skewed( uint32_t max )
+    {
+        uint64_t a = below( max );
+        uint64_t b = below( max );
+        return static_cast<uint32_t>( a * b / max );
+    }
+
+    bool percent( uint32_t p )
+    {
+        return below( 100 ) < p;
+    }
+
+private:
+    std::mt19937 m_engine;
+};
+
+class Generator
+{
+public:
+    Generator( MediaLibrary* ml, fs::IDevice& deviceFs, std::string rootMrl,
+               uint32_t seed )
+        : m_ml( ml )
+        , m_deviceFs( deviceFs )
+        , m_rootMrl( std::move( rootMrl ) )
+        , m_rng( seed )
+    {
+    }
+
+    void run( uint32_t nbMedia )
+    {
+        m_transaction = m_ml->getConn()->newTransaction();
+        m_device = Device::create( m_ml, m_deviceFs.uuid(), "file://",
+                                   false, false );
+        m_root = createFolder( m_rootMrl, 0 );
+        for ( const auto g : Genres )
+            m_genres.push_back( Genre::create( m_ml, g ) );
+
+        auto nbTracks = nbMedia * 70 / 100;
+        auto nbEpisodes = nbMedia * 12 / 100;
+        auto nbMovies = nbMedia * 6 / 100;
+        generateMusic( nbTracks );
+        generateShows( nbEpisodes );
+        generateMovies( nbMovies );
+        generateClips( nbMedia - nbTracks - nbEpisodes - nbMovies );
+        generatePlaylists( std::max( 1u, nbMedia / 500 ) );
+        m_transaction->commit();
+    }
+
+private:
+    std::string title( uint32_t minWords, uint32_t maxWords )
+    {
+        constexpr auto NbWords = sizeof( Words ) / sizeof( Words[0] );
+        auto nbWords = m_rng.between( minWords, maxWords );
+        std::string res;
+        for ( auto i = 0u; i < nbWords; ++i )
+        {
+            if ( i > 0 )
+                res += ' ';
+            res += Words[m_rng.skewed( NbWords )];
+        }
+        res[0] = static_cast<char>( toupper( res[0] ) );
+        return res;
+    }
+
+    /* Artist names must be unique */
+    std::string artistName()
+    {
+        auto name = title( 1, 3 );
+        while ( m_artistNames.insert( name ).second == false )
+            name += ' ' + std::to_string( m_artistNames.size() );
+        return name;
+    }
+
+    std::string thumbnailMrl( const std::string& name )
+    {
+        return m_rootMrl + ".thumbnails/" + name + ".jpg";
+    }
+
+    std::shared_ptr<Folder> createFolder( const std::string& mrl, int64_t parentId )
+    {
+        auto f = Folder::create( m_ml, mrl, parentId, *m_device, m_deviceFs );
+        if ( f == nullptr )
+            abort();
+        return f;
+    }
+
+    std::shared_ptr<Media> createMedia( IMedia::Type type, const Folder& folder,
+                                        const std::string& folderMrl,
+                                        const std::string& fileName,
+                                        const std::string& title,
+                                        int64_t duration )
+    {
+        auto m = Media::create( m_ml, type, m_device->id(), folder.id(),
+                                title, duration );
+        if ( m == nullptr ||
+             m->addFile( mock::NoopFile{ folderMrl + fileName }, folder.id(),
+                         false, IFile::Type::Main ) == nullptr )
+            abort();
+        m_mediaIds.push_back( m->id() );
+        if ( m_rng.percent( 15 ) == true )
+            addHistory( *m, type == IMedia::Type::Video );
+        if ( type == IMedia::Type::Video )
+        {
+            if ( m_rng.percent( 60 ) == true )
+                m->setThumbnail( thumbnailMrl( std::to_string( m->id() ) ),
+                                 ThumbnailSizeType::Thumbnail );
+            if ( m_rng.percent( 5 ) == true )
+            {
+                auto nbBookmarks = m_rng.between( 1, 4 );
+                for ( auto i = 1u; i <= nbBookmarks; ++i )
+                    m->addBookmark( duration * i / ( nbBookmarks + 1 ) );
+            }
+        }
+        if ( ++m_nbPendingMedia == MediaPerTransaction )
+        {
+            m_transaction->commit();
+            /* The previous transaction must be destroyed before the next one
+             * starts, or its destructor would roll the new one back */
+            m_transaction.reset();
+            m_transaction = m_ml->getConn()->newTransaction();
+            m_nbPendingMedia = 0;
+        }
+        return m;
+    }
+
+    /* Most media are played a few times, while a few of them are played a lot */
+    void addHistory( Media& m, bool isVideo )
+    {
+        static const std::string req = "UPDATE " + Media::Table::Name +
+                " SET play_count = ?, last_played_date = ?, last_position = ?,"
+                " last_time = ? WHERE id_media = ?";
+        auto playCount = 1 + m_rng.skewed( 100 );
+        auto lastPlayed = Now - m_rng.skewed( TwoYears );
+        float position = -1.f;
+        int64_t time = -1;
+        if ( isVideo == true && m_rng.percent( 30 ) == true )
+        {
+            position = static_cast<float>( m_rng.between( 5, 95 ) ) / 100.f;
+            time = static_cast<int64_t>( position * m.duration() );
+        }
+        if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, playCount,
+                                           lastPlayed, position,
+                                           time, m.id() ) == false )
+            abort();
+    }
+
+    void generateMusic( uint32_t nbTracks )
+    {
+        auto musicMrl = m_rootMrl + "music/";
+        auto musicFolder = createFolder( musicMrl, m_root->id() );
+        for ( auto artistIdx = 0u; nbTracks > 0; ++artistIdx )
+        {
+            auto artist = Artist::create( m_ml, artistName() );
+            auto artistMrl = musicMrl + "artist_" + std::to_string( artistIdx ) + "/";
+            auto artistFolder = createFolder( artistMrl, musicFolder->id() );
+            if ( m_rng.percent( 50 ) == true )
+                artist->setThumbnail( thumbnailMrl( "artist_" + std::to_string( artistIdx ) ),
+                                      ThumbnailSizeType::Thumbnail );
+            auto nbAlbums = 1 + m_rng.skewed( 12 );
+            auto genre = m_genres[m_rng.skewed( m_genres.size() )];
+            for ( auto albumIdx = 0u; albumIdx < nbAlbums && nbTracks > 0; ++albumIdx )
+            {
+                auto album = Album::create( m_ml, title( 1, 4 ) );
+                album->setAlbumArtist( artist );
+                album->setReleaseYear( m_rng.between( 1960, 2023 ), true );
+                auto albumMrl = artistMrl + "album_" + std::to_string( albumIdx ) + "/";
+                auto albumFolder = createFolder( albumMrl, artistFolder->id() );
+                auto nbAlbumTracks = std::min( nbTracks, m_rng.between( 6, 16 ) );
+                for ( auto trackNb = 1u; trackNb <= nbAlbumTracks; ++trackNb )
+                {
+                    auto m = createMedia( IMedia::Type::Audio, *albumFolder, albumMrl,
+                                          "track_" + std::to_string( trackNb ) + ".mp3",
+                                          title( 1, 5 ),
+                                          m_rng.between( 90, 420 ) * 1000 );
+                    if ( album->addTrack( m, trackNb, 1, artist->id(),
+                                          genre.get() ) == false ||
+                         artist->addMedia( *m ) == false )
+                        abort();
+                    if ( trackNb == 1 && m_rng.percent( 80 ) == true )
+                    {
+                        m->setThumbnail( thumbnailMrl( std::to_string( m->id() ) ),
+                                         ThumbnailSizeType::Thumbnail );
+                        album->setThumbnail( m->thumbnail( ThumbnailSizeType::Thumbnail ) );
+                    }
+                }
+                nbTracks -= nbAlbumTracks;
+            }
+        }
+    }
+
+    void generateShows( uint32_t nbEpisodes )
+    {
+        auto showsMrl = m_rootMrl + "shows/";
+        auto showsFolder = createFolder( showsMrl, m_root->id() );
+        for ( auto showIdx = 0u; nbEpisodes > 0; ++showIdx )
+        {
+            auto show = Show::create( m_ml, title( 1, 3 ) );
+            auto showMrl = showsMrl + "show_" + std::to_string( showIdx ) + "/";
+            auto showFolder = createFolder( showMrl, showsFolder->id() );
+            auto nbSeasons = m_rng.between( 1, 6 );
+            for ( auto season = 1u; season <= nbSeasons && nbEpisodes > 0; ++season )
+            {
+                auto seasonMrl = showMrl + "season_" + std::to_string( season ) + "/";
+                auto seasonFolder = createFolder( seasonMrl, showFolder->id() );
+                auto nbSeasonEpisodes = std::min( nbEpisodes, m_rng.between( 6, 24 ) );
+                for ( auto ep = 1u; ep <= nbSeasonEpisodes; ++ep )
+                {
+                    auto epTitle = title( 1, 4 );
+                    auto m = createMedia( IMedia::Type::Video, *seasonFolder, seasonMrl,
+                                          "episode_" + std::to_string( ep ) + ".mkv",
+                                          epTitle,
+                                          m_rng.between( 20, 60 ) * 60000 );
+                    if ( show->addEpisode( *m, season, ep, std::move( epTitle ) ) == nullptr )
+                        abort();
+                }
+                nbEpisodes -= nbSeasonEpisodes;
+            }
+        }
+    }
+
+    void generateMovies( uint32_t nbMovies )
+    {
+        auto moviesMrl = m_rootMrl + "movies/";
+        auto moviesFolder = createFolder( moviesMrl, m_root->id() );
+        for ( auto i = 0u; i < nbMovies; ++i )
+        {
+            auto m = createMedia( IMedia::Type::Video, *moviesFolder, moviesMrl,
+                                  "movie_" + std::to_string( i ) + ".mkv",
+                                  title( 1, 4 ), m_rng.between( 80, 180 ) * 60000 );
+            auto movie = Movie::create( m_ml, m->id() );
+            if ( movie == nullptr || m->setMovie( std::move( movie ) ) == false )
+                abort();
+        }
+    }
+
+    /* Clips are grouped in media groups, each of them in its own folder */
+    void generateClips( uint32_t nbClips )
+    {
+        auto clipsMrl = m_rootMrl + "clips/";
+        auto clipsFolder = createFolder( clipsMrl, m_root->id() );
+        for ( auto groupIdx = 0u; nbClips > 0; ++groupIdx )
+        {
+            auto groupName = title( 1, 3 );
+            auto group = MediaGroup::create( m_ml, groupName, false, false );
+            auto groupMrl = clipsMrl + "group_" + std::to_string( groupIdx ) + "/";
+            auto groupFolder = createFolder( groupMrl, clipsFolder->id() );
+            auto nbGroupClips = std::min( nbClips, m_rng.between( 2, 12 ) );
+            for ( auto i = 1u; i <= nbGroupClips; ++i )
+            {
+                auto m = createMedia( IMedia::Type::Video, *groupFolder, groupMrl,
+                                      "clip_" + std::to_string( i ) + ".mp4",
+                                      groupName + " " + std::to_string( i ),
+                                      m_rng.between( 10, 600 ) * 1000 );
+                if ( m->addToGroup( *group ) == false )
+                    abort();
+            }
+            nbClips -= nbGroupClips;
+        }
+    }
+
+    /* Playlists favor the same few media, as the play counts do */
+    void generatePlaylists( uint32_t nbPlaylists )
+    {
+        for ( auto i = 0u; i < nbPlaylists; ++i )
+        {
+            auto pl = Playlist::create( m_ml, title( 1, 3 ) );
+            auto nbItems = 5 + m_rng.skewed( 300 );
+            std::vector<int64_t> items;
+            items.reserve( nbItems );
+            for ( auto j = 0u; j < nbItems; ++j )
+                items.push_back( m_mediaIds[m_rng.skewed( m_mediaIds.size() )] );
+            if ( pl == nullptr || pl->append( items ) == false )
+                abort();
+        }
+    }
+
+private:
+    MediaLibrary* m_ml;
+    fs::IDevice& m_deviceFs;
+    const std::string m_rootMrl;
+    Rng m_rng;
+    std::unique_ptr<sqlite::Transaction> m_transaction;
+    uint32_t m_nbPendingMedia = 0;
+    std::shared_ptr<Device> m_device;
+    std::shared_ptr<Folder> m_root;
+    std::vector<std::shared_ptr<Genre>> m_genres;
+    std::unordered_set<std::string> m_artistNames;
+    std::vector<int64_t> m_mediaIds;
+};
+
+}
+
+void generateLibrary( MediaLibrary* ml, fs::IDevice& deviceFs,
+                      const std::string& rootMrl, uint32_t nbMedia,
+                      uint32_t seed )
+{
+    Generator g{ ml, deviceFs, rootMrl, seed };
+    g.run( nbMedia );
+}
@@ -0,0 +1,53 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace medialibrary
+{
+class MediaLibrary;
+namespace fs
+{
+class IDevice;
+}
+}
+
+/**
+ * @brief generateLibrary Populates an empty database with a synthetic library
+ * @param ml An initialized medialibrary instance
+ * @param deviceFs The device the generated files are stored on
+ * @param rootMrl The folder containing the generated tree, on deviceFs
+ * @param nbMedia The number of media to generate
+ * @param seed A given seed and size always generate the same library
+ *
+ * 70% of the media are album tracks, the others being show episodes, movies
+ * and clips grouped in media groups. Artists, genres and play counts follow a
+ * skewed distribution, so a few of them are much more popular than the others.
+ * The library also contains playlists, an history, bookmarks & thumbnails.
+ */
+void generateLibrary( medialibrary::MediaLibrary* ml,
+                      medialibrary::fs::IDevice& deviceFs,
+                      const std::string& rootMrl, uint32_t nbMedia,
+                      uint32_t seed );
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2021 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include "utils/Strings.h"
+
+namespace utf8 = medialibrary::utils::str::utf8;
+
+namespace
+{
+
+struct Titles
+{
+    const char* lhs;
+    const char* rhs;
+};
+
+/* Pairs of titles sharing a prefix, as they would during media grouping */
+const Titles titles[] = {
+    {
+        "The Fluffy Sea Otters Chronicles - Season 01 Episode 04 - Holding hands.mkv",
+        "the fluffy sea otters chronicles - Season 01 Episode 05 - Sleeping.mkv",
+    },
+    {
+        "Éléphants roses à la fenêtre de l'hôtel, été 1998 — première époque.avi",
+        "Éléphants roses à la fenêtre de l'hôtel, été 1998 — deuxième époque.avi",
+    },
+    {
+        "ラッコは手をつないで眠る 第一話 海の上の小さな家族の物語.mp4",
+        "ラッコは手をつないで眠る 第二話 海の上の小さな家族の物語.mp4",
+    },
+};
+
+}
+
+static void BenchNbChars( benchmark::State& state )
+{
+    const std::string input = titles[state.range( 0 )].lhs;
+    while ( state.KeepRunning() )
+        benchmark::DoNotOptimize( utf8::nbChars( input ) );
+    state.SetBytesProcessed( state.iterations() * input.size() );
+}
+
+static void BenchNbCharsScalar( benchmark::State& state )
+{
+    const std::string input = titles[state.range( 0 )].lhs;
+    while ( state.KeepRunning() )
+        benchmark::DoNotOptimize( utf8::scalar::nbChars( input ) );
+    state.SetBytesProcessed( state.iterations() * input.size() );
+}
+
+static void BenchNbBytes( benchmark::State& state )
+{
+    const std::string input = titles[state.range( 0 )].lhs;
+    while ( state.KeepRunning() )
+        benchmark::DoNotOptimize( utf8::nbBytes( input, 0, 48 ) );
+}
+
+static void BenchNbBytesScalar( benchmark::State& state )
+{
+    const std::string input = titles[state.range( 0 )].lhs;
+    while ( state.KeepRunning() )
+        benchmark::DoNotOptimize( utf8::scalar::nbBytes( input, 0, 48 ) );
+}
+
+static void BenchCommonPattern( benchmark::State& state )
+{
+    const std::string lhs = titles[state.range( 0 )].lhs;
+    const std::string rhs = titles[state.range( 0 )].rhs;
+    while ( state.KeepRunning() )
+        benchmark::DoNotOptimize( utf8::commonPattern( lhs, 0, rhs, 0, 6 ) );
+}
+
+static void BenchCommonPatternScalar( benchmark::State& state )
+{
+    const std::string lhs = titles[state.range( 0 )].lhs;
+    const std::string rhs = titles[state.range( 0 )].rhs;
+    while ( state.KeepRunning() )
+        benchmark::DoNotOptimize( utf8::scalar::commonPattern( lhs, 0, rhs, 0, 6 ) );
+}
+
+/* 0: ASCII, 1: Latin-1 heavy, 2: CJK */
+BENCHMARK(BenchNbChars)->DenseRange( 0, 2 );
+BENCHMARK(BenchNbCharsScalar)->DenseRange( 0, 2 );
+BENCHMARK(BenchNbBytes)->DenseRange( 0, 2 );
+BENCHMARK(BenchNbBytesScalar)->DenseRange( 0, 2 );
+BENCHMARK(BenchCommonPattern)->DenseRange( 0, 2 );
+BENCHMARK(BenchCommonPatternScalar)->DenseRange( 0, 2 );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "thumbnails/imagecompressors/JpegCompressor.h"
+#include "utils/Image.h"
+
+using namespace medialibrary;
+
+namespace
+{
+
+struct Resolution
+{
+    uint32_t width;
+    uint32_t height;
+};
+
+/* 0: thumbnail, 1: small banner, 2: large banner */
+const Resolution resolutions[] = {
+    { 320, 180 },
+    { 640, 360 },
+    { 1280, 720 },
+};
+
+const ThumbnailEncoding::Subsampling subsamplings[] = {
+    ThumbnailEncoding::Subsampling::Yuv444,
+    ThumbnailEncoding::Subsampling::Yuv422,
+    ThumbnailEncoding::Subsampling::Yuv420,
+};
+
+/*
+ * A smooth gradient with some noise, which compresses roughly like a video
+ * frame would, unlike a uniform or a completely random picture
+ */
+std::vector<uint8_t> syntheticFrame( uint32_t width, uint32_t height )
+{
+    std::vector<uint8_t> frame( width * height * 3 );
+    auto seed = 0x2545F491u;
+    for ( auto y = 0u; y < height; ++y )
+    {
+        for ( auto x = 0u; x < width; ++x )
+        {
+            seed = seed * 1664525u + 1013904223u;
+            auto noise = ( seed >> 24 ) & 0x0F;
+            auto p = &frame[( y * width + x ) * 3];
+            p[0] = static_cast<uint8_t>( x * 255 / width + noise );
+            p[1] = static_cast<uint8_t>( y * 255 / height + noise );
+            p[2] = static_cast<uint8_t>( ( x + y ) * 127 / ( width + height ) + noise );
+        }
+    }
+    return frame;
+}
+
+}
+
+static void BenchEncode( benchmark::State& state )
+{
+    const auto& res = resolutions[state.range( 0 )];
+    ThumbnailEncoding encoding;
+    encoding.quality = static_cast<uint8_t>( state.range( 1 ) );
+    encoding.subsampling = subsamplings[state.range( 2 )];
+    const auto frame = syntheticFrame( res.width, res.height );
+    JpegCompressor compressor;
+    std::vector<uint8_t> output;
+
+    while ( state.KeepRunning() )
+    {
+        if ( compressor.compress( frame.data(), output, res.width, res.height,
+                                  res.width, res.height, 0, 0, encoding ) == false )
+        {
+            state.SkipWithError( "Failed to encode the frame" );
+            break;
+        }
+        benchmark::DoNotOptimize( output.data() );
+    }
+    state.SetItemsProcessed( state.iterations() );
+    state.counters["bytes"] = output.size();
+}
+
+/*
+ * Generates all the thumbnail sizes from a frame decoded at the largest
+ * size, as the vmem thumbnailer does
+ */
+static void BenchDownscaleAndEncode( benchmark::State& state )
+{
+    const auto& src = resolutions[2];
+    const auto frame = syntheticFrame( src.width, src.height );
+    std::vector<uint8_t> scaled( frame.size() );
+    JpegCompressor compressor;
+    ThumbnailEncoding encoding;
+    std::vector<uint8_t> output;
+
+    while ( state.KeepRunning() )
+    {
+        for ( const auto& res : resolutions )
+        {
+            const uint8_t* buff = frame.data();
+            if ( res.width != src.width || res.height != src.height )
+            {
+                utils::image::downscale( frame.data(), src.width, src.height,
+                                         scaled.data(), res.width, res.height,
+                                         compressor.bpp() );
+                buff = scaled.data();
+            }
+            compressor.compress( buff, output, res.width, res.height,
+                                 res.width, res.height, 0, 0, encoding );
+            benchmark::DoNotOptimize( output.data() );
+        }
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+BENCHMARK(BenchEncode)->ArgsProduct( { { 0, 1, 2 }, { 70, 80, 90 }, { 0, 2 } } );
+BENCHMARK(BenchDownscaleAndEncode);
+
+BENCHMARK_MAIN();
@@ -46,7 +46,21 @@ public:
      * @brief thumbnailStatus Returns this album current thumbnail status.
      */
     virtual ThumbnailStatus thumbnailStatus( ThumbnailSizeType sizeType ) const = 0;
+    /**
+     * @brief thumbnailMrl Returns this album thumbnail mrl
+     *
+     * When SetupConfig::packThumbnails is enabled, the mrl isn't backed by a
+     * file once the thumbnail was packed, see thumbnailData
+     */
     virtual const std::string& thumbnailMrl( ThumbnailSizeType sizeType ) const = 0;
+    /**
+     * @brief thumbnailData Returns the content of this album thumbnail if it
+     *        was packed, or an empty view otherwise.
+     *
+     * Albums usually share their thumbnail with one of their tracks, see
+     * IMedia::thumbnailData
+     */
+    virtual ThumbnailData thumbnailData( ThumbnailSizeType sizeType ) const = 0;
     /**
      * @brief tracks fetches album tracks from the database
      */
@@ -57,7 +57,20 @@ public:
      * @see{medialibrary::ThumbnailStatus}
      */
     virtual ThumbnailStatus thumbnailStatus( ThumbnailSizeType sizeType ) const = 0;
+    /**
+     * @brief thumbnailMrl Returns this artist thumbnail mrl
+     *
+     * When SetupConfig::packThumbnails is enabled, the mrl isn't backed by a
+     * file once the thumbnail was packed, see thumbnailData
+     */
     virtual const std::string& thumbnailMrl( ThumbnailSizeType sizeType ) const = 0;
+    /**
+     * @brief thumbnailData Returns the content of this artist thumbnail if it
+     *        was packed, or an empty view otherwise.
+     *
+     * @see{IMedia::thumbnailData}
+     */
+    virtual ThumbnailData thumbnailData( ThumbnailSizeType sizeType ) const = 0;
     /**
      * @brief setThumbnail Assign a thumbnail to the artist
      * @param thumbnailMrl An mrl pointing to the thumbnail
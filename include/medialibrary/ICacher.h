@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace medialibrary
@@ -33,7 +34,46 @@ public:
     virtual ~ICacher() = default;
     virtual bool cache( const std::string& inputMrl,
                         const std::string& outputPath ) = 0;
+    /**
+     * @brief interrupt Interrupts all the ongoing transfers
+     *
+     * The interruption is definitive: any transfer started afterward is
+     * expected to fail right away.
+     */
     virtual void interrupt() = 0;
+    /**
+     * @brief resume Continues a transfer which didn't complete
+     * @param inputMrl The MRL being cached
+     * @param outputPath The partially written output file
+     * @param offset The number of bytes already present in the output file
+     * @return true if the transfer completed
+     *
+     * The default implementation restarts the transfer from the beginning,
+     * overwriting the partial file.
+     * This is only invoked if canResume() returns true.
+     */
+    virtual bool resume( const std::string& inputMrl,
+                         const std::string& outputPath,
+                         uint64_t /* offset */ )
+    {
+        return cache( inputMrl, outputPath );
+    }
+    /**
+     * @brief canResume Returns true if resume() continues a transfer from the
+     *        provided offset.
+     *
+     * If false, the partial files of interrupted transfers are removed instead
+     * of being kept until the transfer is resumed.
+     */
+    virtual bool canResume() const { return false; }
+    /**
+     * @brief canCacheConcurrently Returns true if cache() & resume() can be
+     *        invoked from multiple threads at once.
+     *
+     * If false, the medialibrary will only run one transfer at a time,
+     * regardless of SetupConfig::maxCacheTransfers
+     */
+    virtual bool canCacheConcurrently() const { return false; }
 };
 
 }
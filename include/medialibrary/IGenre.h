@@ -77,8 +77,19 @@ public:
      * @brief thumbnailMrl Returns this genre thumbnail mrl
      * @param sizeType The target thumbnail size type
      * @return An mrl to the thumbnail if any, or an empty string
+     *
+     * When SetupConfig::packThumbnails is enabled, the mrl isn't backed by a
+     * file once the thumbnail was packed, see thumbnailData
      */
     virtual const std::string& thumbnailMrl( ThumbnailSizeType sizeType ) const = 0;
+    /**
+     * @brief thumbnailData Returns the content of this genre thumbnail if it
+     *        was packed, or an empty view otherwise.
+     * @param sizeType The target thumbnail size type
+     *
+     * @see{IMedia::thumbnailData}
+     */
+    virtual ThumbnailData thumbnailData( ThumbnailSizeType sizeType ) const = 0;
     /**
      * @brief hasThumbnail Returns true if this genre has a thumbnail available
      * @param sizeType The probed thumbnail size type
@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <time.h>
 #include <unordered_map>
@@ -35,6 +37,20 @@
 namespace medialibrary
 {
 
+///
+/// \brief The ThumbnailData struct is a read only view on a thumbnail content
+///
+/// The data remains valid for as long as the ThumbnailData instance, or a
+/// copy of it, is alive.
+///
+struct ThumbnailData
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    /// Keeps the underlying storage alive
+    std::shared_ptr<const void> handle;
+};
+
 class IMedia
 {
 public:
@@ -272,10 +288,28 @@ public:
     ///         or an empty string, if the thumbnail generation failed or
     ///         was never requested
     ///
+    /// When SetupConfig::packThumbnails is enabled, the mrl isn't backed by a
+    /// file once the thumbnail was packed, and the thumbnail content must be
+    /// read through thumbnailData.
+    ///
     /// \sa{thumbnailStatus}
     ///
     virtual const std::string& thumbnailMrl( ThumbnailSizeType sizeType ) const = 0;
 
+    ///
+    /// \brief thumbnailData Returns the content of a packed thumbnail
+    /// \param sizeType The targeted thumbnail size
+    /// \return A view on the thumbnail content, or an empty view if the
+    ///         thumbnail isn't available or isn't packed.
+    ///
+    /// Thumbnails are only packed when SetupConfig::packThumbnails is enabled.
+    /// In this case, thumbnailMrl still returns the thumbnail mrl, but the mrl
+    /// isn't backed by a file anymore once the thumbnail was packed. The
+    /// thumbnails which aren't owned by the media library are never packed,
+    /// and must still be accessed through their mrl.
+    ///
+    virtual ThumbnailData thumbnailData( ThumbnailSizeType sizeType ) const = 0;
+
     ///
     /// \brief thumbnailStatus Returns this media thumbnail status
     /// \param sizeType The targeted thumbnail size
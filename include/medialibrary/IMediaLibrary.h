@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <set>
@@ -34,6 +36,7 @@
 #include "IQuery.h"
 #include "IMedia.h"
 #include "IService.h"
+#include "IThumbnailer.h"
 
 struct libvlc_instance_t;
 
@@ -114,10 +117,10 @@ struct QueryParameters
     bool includeMissing = false;
     /*
      * If true, only public entities will be returned.
-     * When fetching public entities only, some features related to counters
-     * will be disabled, for instance, it will not be possible to sort an artist
-     * by its number of tracks since the triggers don't maintain a count for
-     * public entities only.
+     * When listing public artists, albums, genres or shows, sorting by number
+     * of tracks or duration only accounts for their public tracks. The counters
+     * returned by the listed entities are disabled, and it is not possible to
+     * sort an artist by its number of albums.
      */
     bool publicOnly = false;
 
@@ -183,6 +186,28 @@ enum class HistoryType : uint8_t
     Network,
 };
 
+enum class ProgressDurability : uint8_t
+{
+    /// Each progress update is written to the database as soon as it is provided
+    Immediate,
+    /// Progress updates are kept in memory and written to the database in
+    /// batches. See SetupConfig::progressFlushPeriod
+    Deferred,
+};
+
+enum class CacheEvictionPolicy : uint8_t
+{
+    /// Evict the files which were played, or cached if never played, the
+    /// longest time ago first
+    LeastRecentlyPlayed,
+    /// Greedy-Dual-Size-Frequency: favor evicting large and rarely played
+    /// files, while aging the files which weren't played recently
+    SizeAware,
+    /// Evict the media which were played until their end first, then fall
+    /// back to the least recently played ones
+    PlayedFirst,
+};
+
 enum class ArtistIncluded : uint8_t
 {
     /// Include all artists, as long as they have at least one track present
@@ -206,6 +231,90 @@ enum class PlaylistType : uint8_t
     VideoOnly,
 };
 
+struct QueryStats
+{
+    static constexpr size_t NbLatencyBuckets = 24;
+
+    /// The request, with its literal values replaced by '?' placeholders
+    std::string sql;
+    uint64_t nbExecutions;
+    std::chrono::microseconds totalDuration;
+    std::chrono::microseconds maxDuration;
+    /// The number of rows returned by all the executions
+    uint64_t nbRows;
+    /// The sqlite3_stmt_status counters, summed over all the executions
+    uint64_t nbFullScanSteps;
+    uint64_t nbSorts;
+    uint64_t nbAutoIndexes;
+    uint64_t nbVmSteps;
+    /// latencyHistogram[i] is the number of executions which lasted between
+    /// 2^i and 2^(i+1) µs. The first and last buckets also count the faster
+    /// and slower executions, respectively.
+    std::array<uint64_t, NbLatencyBuckets> latencyHistogram;
+};
+
+/**
+ * @brief The LockMode enum describes the way the database lock was acquired
+ */
+enum class LockMode : uint8_t
+{
+    Read,
+    Write,
+    /// Priority access, which blocks the new requests from the other threads
+    Priority,
+};
+
+/**
+ * @brief The LockClient enum describes the subsystem acquiring the database lock
+ */
+enum class LockClient : uint8_t
+{
+    /// Any thread owned by the application, including the async query threads
+    Application,
+    Parser,
+    Discoverer,
+    Thumbnailer,
+    Cache,
+    /// The notification & progress reporting threads
+    Background,
+};
+
+/**
+ * @brief The LockPolicy enum describes which waiters are favored when both
+ * readers and writers are waiting for the database lock.
+ */
+enum class LockPolicy : uint8_t
+{
+    /// Readers only wait for the current writer, writers can be starved
+    ReaderPreferring,
+    /// Readers wait as long as a writer is waiting, readers can be starved
+    WriterPreferring,
+    /// Waiting writers are favored, but after SetupConfig::maxWriterBatch
+    /// consecutive writes, the waiting readers are let in.
+    BoundedWriterBatches,
+};
+
+struct LockStats
+{
+    static constexpr size_t NbBuckets = 24;
+
+    LockMode mode;
+    LockClient client;
+    uint64_t nbAcquisitions;
+    /// The number of acquisitions which had to wait for a priority access
+    /// held by another thread
+    uint64_t nbPreempted;
+    std::chrono::microseconds totalWait;
+    std::chrono::microseconds maxWait;
+    std::chrono::microseconds totalHold;
+    std::chrono::microseconds maxHold;
+    /// waitHistogram[i] & holdHistogram[i] are the number of acquisitions
+    /// which waited for/held the lock between 2^i and 2^(i+1) µs. The first
+    /// and last buckets also count the shorter and longer durations.
+    std::array<uint64_t, NbBuckets> waitHistogram;
+    std::array<uint64_t, NbBuckets> holdHistogram;
+};
+
 struct SetupConfig
 {
     /**
@@ -241,7 +350,96 @@ struct SetupConfig
      */
     std::shared_ptr<ILogger> logger;
 
+    /**
+     * @brief asyncLogging Forward the log messages to the logger from a
+     * dedicated thread.
+     *
+     * This avoids serializing the medialibrary threads on the logger when
+     * verbose logging is enabled. Messages are dropped if the logger can't
+     * keep up.
+     */
+    bool asyncLogging = false;
+
     std::shared_ptr<ICacher> cacher;
+
+    /**
+     * @brief cacheEvictionPolicy Defines which cached files get removed first
+     * when some room needs to be made in the cache
+     */
+    CacheEvictionPolicy cacheEvictionPolicy = CacheEvictionPolicy::PlayedFirst;
+
+    /**
+     * @brief maxCacheTransfers The maximum number of subscription media being
+     * cached simultaneously.
+     *
+     * This is only honored when the cacher supports concurrent transfers, see
+     * ICacher::canCacheConcurrently. The available transfers are shared fairly
+     * between the subscriptions.
+     */
+    uint32_t maxCacheTransfers = 4;
+    /**
+     * @brief cacheBandwidthLimit The maximum average throughput for the
+     * subscription media caching, in bytes per second, or 0 for no limit.
+     */
+    uint64_t cacheBandwidthLimit = 0;
+
+    /**
+     * @brief progressDurability Defines when the playback progress provided
+     * through IMedia::setLastPosition & IMedia::setLastTime gets written to
+     * the database.
+     *
+     * When using ProgressDurability::Deferred, the latest progress for each
+     * media is kept in memory, and is still returned by the media library
+     * getters. The pending updates are written at most progressFlushPeriod
+     * after they were provided, when IMediaLibrary::flushPlaybackProgress is
+     * called, and when the media library gets destroyed.
+     * Pending updates will be lost if the application crashes.
+     */
+    ProgressDurability progressDurability = ProgressDurability::Immediate;
+    std::chrono::seconds progressFlushPeriod{ 30 };
+
+    /**
+     * @brief nbAsyncQueryThreads The maximum number of threads running the
+     * asynchronous requests, see IQuery::itemsAsync
+     */
+    uint32_t nbAsyncQueryThreads = 2;
+
+    /**
+     * @brief packThumbnails Store the generated thumbnails in a few large
+     * segment files instead of one file per thumbnail.
+     *
+     * Packed thumbnails must be accessed through the thumbnailData accessor
+     * of the entity they belong to, ie. IMedia::thumbnailData,
+     * IAlbum::thumbnailData, IArtist::thumbnailData or IGenre::thumbnailData
+     */
+    bool packThumbnails = false;
+
+    /**
+     * @brief thumbnailEncoding The settings used to encode the thumbnails,
+     * for each ThumbnailSizeType
+     *
+     * This is only used when the medialibrary encodes the thumbnails itself,
+     * which depends on the thumbnailer in use.
+     */
+    ThumbnailEncoding thumbnailEncoding[static_cast<size_t>( ThumbnailSizeType::Count )];
+
+    /**
+     * @brief slowQueryThreshold The duration above which a request is reported
+     * through IMediaLibraryCb::onSlowQuery, along with its query plan.
+     *
+     * 0 disables the reporting.
+     */
+    std::chrono::milliseconds slowQueryThreshold{ 0 };
+
+    /**
+     * @brief lockPolicy The fairness policy of the database lock
+     */
+    LockPolicy lockPolicy = LockPolicy::ReaderPreferring;
+    /**
+     * @brief maxWriterBatch The number of consecutive writes after which the
+     * waiting readers are let in, when using LockPolicy::BoundedWriterBatches
+     */
+    uint32_t maxWriterBatch = 8;
 };
 
 class IMediaLibraryCb
@@ -451,6 +649,36 @@ public:
      *             some media and/or subscriptions are being cached.
      */
     virtual void onCacheIdleChanged( bool idle ) = 0;
+
+    /**
+     * @brief onInitializationStep Will be invoked after each step of
+     *                             IMediaLibrary::initialize
+     * @param step A short, static, step name ("directories", "database",
+     *             "settings", "migration", "devices" or "parser")
+     * @param duration The time spent in this step
+     *
+     * This is meant for applications willing to monitor the startup time.
+     * It is invoked synchronously from the thread calling initialize(), and
+     * must not call back into the medialibrary.
+     * The "migration" step is only reported when a migration was required.
+     */
+    virtual void onInitializationStep( const char* /* step */,
+                                       std::chrono::microseconds /* duration */ ) {}
+
+    /**
+     * @brief onSlowQuery Will be invoked when a request lasted longer than
+     *                    SetupConfig::slowQueryThreshold
+     * @param sql The request
+     * @param duration The request execution time
+     * @param queryPlan The request EXPLAIN QUERY PLAN output, one step per line
+     *
+     * This is invoked synchronously from the thread which ran the request,
+     * while it still holds the database lock, and must not call back into
+     * the medialibrary.
+     */
+    virtual void onSlowQuery( const std::string& /* sql */,
+                              std::chrono::microseconds /* duration */,
+                              const std::string& /* queryPlan */ ) {}
 };
 
 class IMediaLibrary
@@ -1104,8 +1332,10 @@ public:
      * When the thumbnail is generated, IMediaLibraryCb::onMediaThumbnailReady
      * will be invoked from the thumbnailer thread.
      * If this is invoked multiple time before the original request is processed,
-     * the later requests will be ignored, and no callback will be invoked before
-     * the first one has completed.
+     * the later requests for the same size type will be ignored, and no callback
+     * will be invoked before the first one has completed. Requests for another
+     * size type are merged with the pending one, so that all the sizes are
+     * generated from the same frame, and one callback is invoked for each size.
      * The desired width or height might be 0 to automatically infer one from the
      * other by respecting the source aspect ratio.
      * If both sizes are provided, the resulting thumbnail will be cropped to
@@ -1153,6 +1383,16 @@ public:
      */
     virtual bool flushUserProvidedThumbnails() = 0;
 
+    /**
+     * @brief flushPlaybackProgress Writes the pending playback progress updates
+     * to the database
+     * @return true in case of success, false otherwise.
+     *
+     * This is only relevant when using ProgressDurability::Deferred, and should
+     * be called when the playback gets paused or stopped.
+     */
+    virtual bool flushPlaybackProgress() = 0;
+
     virtual bool removeSubscription( int64_t subscriptionId ) = 0;
 
     /**
@@ -1160,6 +1400,17 @@ public:
      */
     virtual void cacheNewSubscriptionMedia() = 0;
 
+    /**
+     * @brief repairCache Asynchronously verifies the whole cache folder
+     *
+     * On startup, the media library only verifies the cached files which were
+     * being written or removed when it was last stopped. This lists the cache
+     * folder and fixes any mismatch with the database, which is only needed if
+     * the cache folder was modified externally.
+     * @return false if no cache implementation is available
+     */
+    virtual bool repairCache() = 0;
+
     /**
      * @brief fitsInSubscriptionCache Checks if the provided media will fit in
      *                                the subscription cache
@@ -1247,6 +1498,30 @@ public:
      * @return true if all the subscriptions were refreshed successfully.
      */
     virtual bool refreshAllSubscriptions() = 0;
+
+    /**
+     * @brief queryStats Returns the statistics of each request shape
+     *
+     * Requests are grouped by shape, ie. with their literal values replaced
+     * by placeholders. The statistics are gathered for the whole process,
+     * since startup or the last call to resetQueryStats()
+     */
+    virtual std::vector<QueryStats> queryStats() const = 0;
+    /**
+     * @brief resetQueryStats Discards the statistics gathered so far
+     */
+    virtual void resetQueryStats() = 0;
+    /**
+     * @brief lockStats Returns the database lock statistics
+     *
+     * One entry is returned for each lock mode & client which acquired the
+     * lock since startup or the last call to resetLockStats()
+     */
+    virtual std::vector<LockStats> lockStats() const = 0;
+    /**
+     * @brief resetLockStats Discards the lock statistics gathered so far
+     */
+    virtual void resetLockStats() = 0;
 };
 
 /**
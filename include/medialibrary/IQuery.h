@@ -22,19 +22,57 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
 namespace medialibrary
 {
 
+/**
+ * @brief The CancellationToken class allows an asynchronous request to be cancelled
+ *
+ * Copies share the same state: the caller keeps a copy of the token provided
+ * to the request, and calls cancel() when the result isn't needed anymore.
+ */
+class CancellationToken
+{
+public:
+    CancellationToken()
+        : m_cancelled( std::make_shared<std::atomic_bool>( false ) )
+    {
+    }
+    void cancel()
+    {
+        m_cancelled->store( true, std::memory_order_release );
+    }
+    bool isCancelled() const
+    {
+        return m_cancelled->load( std::memory_order_acquire );
+    }
+
+private:
+    std::shared_ptr<std::atomic_bool> m_cancelled;
+};
+
 template <typename T>
 class IQuery
 {
 public:
     using Result = std::vector<std::shared_ptr<T>>;
+    /* The first parameter is false if the request failed */
+    using ResultCb = std::function<void( bool, Result )>;
+    using CountCb = std::function<void( bool, size_t )>;
+    using ItemCb = std::function<bool( std::shared_ptr<T> )>;
+    struct Page
+    {
+        Result items;
+        /* The total number of items, as returned by count() */
+        size_t count;
+    };
 
     virtual ~IQuery() = default;
     /**
@@ -56,6 +94,65 @@ public:
      */
     virtual Result items( uint32_t nbItems,  uint32_t offset ) = 0;
     virtual Result all() = 0;
+    /**
+     * @brief page returns a subset of a query result along with the total count
+     * @param nbItems The number of item requested
+     * @param offset The number of elements to omit from the beginning of the result
+     *
+     * This is equivalent to calling count() and items(), but the query is
+     * only evaluated once when possible, and both values are consistent with
+     * each other.
+     * If nbItems & offset are both 0, then this returns all results.
+     */
+    virtual Page page( uint32_t nbItems, uint32_t offset ) = 0;
+    /**
+     * @brief forEach Iterates over all the results without storing them
+     * @param cb A callback invoked with each item, in the query order. It can
+     *           return false to stop the iteration early.
+     * @return true if all items were iterated over, false if the callback
+     *         interrupted the iteration or if the query failed.
+     *
+     * The items are built one at a time while the underlying request is being
+     * stepped, so the memory usage doesn't depend on the number of results.
+     * The callback is invoked synchronously, from the calling thread, while
+     * a database read context is held: the database can't be modified until
+     * forEach returns, including by other threads. The callback must not
+     * modify the database, and must not run the query being iterated over.
+     * Any other read is allowed.
+     */
+    virtual bool forEach( ItemCb cb ) = 0;
+
+    /**
+     * @brief countAsync Computes count() on the media library reader threads
+     * @param cb Invoked with the result, from a media library thread. Its
+     *           first parameter is false if the request failed, in which case
+     *           the result is empty.
+     * @param token Allows the request to be cancelled, in which case the
+     *              callback won't be invoked.
+     *
+     * Identical requests that are pending at the same time are only executed
+     * once, and their callbacks all receive the same result. A request
+     * submitted while an identical one is running is executed again, since
+     * the running one might not observe the latest changes.
+     * The query doesn't need to outlive the asynchronous requests.
+     * Requests still pending when the media library is destroyed are dropped.
+     */
+    virtual void countAsync( CountCb cb,
+                             CancellationToken token = CancellationToken{} ) = 0;
+    /**
+     * @brief itemsAsync Asynchronous version of items()
+     *
+     * \sa{countAsync} for the threading & cancellation semantics
+     */
+    virtual void itemsAsync( uint32_t nbItems, uint32_t offset, ResultCb cb,
+                             CancellationToken token = CancellationToken{} ) = 0;
+    /**
+     * @brief allAsync Asynchronous version of all()
+     *
+     * \sa{countAsync} for the threading & cancellation semantics
+     */
+    virtual void allAsync( ResultCb cb,
+                           CancellationToken token = CancellationToken{} ) = 0;
 };
 
 template <typename T>
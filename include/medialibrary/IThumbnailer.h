@@ -24,12 +24,29 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace medialibrary
 {
 
 class IMedia;
 
+struct ThumbnailEncoding
+{
+    enum class Subsampling : uint8_t
+    {
+        /// Full chroma resolution
+        Yuv444,
+        /// Horizontally halved chroma resolution
+        Yuv422,
+        /// Horizontally & vertically halved chroma resolution
+        Yuv420,
+    };
+    /// The encoder quality, in the [1;100] range
+    uint8_t quality = 80;
+    Subsampling subsampling = Subsampling::Yuv420;
+};
+
 class IThumbnailer
 {
 public:
@@ -51,6 +68,45 @@ public:
     virtual bool generate( const IMedia& media, const std::string& mrl,
                            uint32_t desiredWidth, uint32_t desiredHeight,
                            float position, const std::string& destination ) = 0;
+
+    struct Output
+    {
+        uint32_t desiredWidth;
+        uint32_t desiredHeight;
+        /// The path in which to save this thumbnail
+        std::string destination;
+        /// The settings to encode this thumbnail with, when the thumbnailer
+        /// encodes the picture itself
+        ThumbnailEncoding encoding;
+        /// If not null, the thumbnailer may store the encoded thumbnail in
+        /// this buffer instead of writing it to destination. This is provided
+        /// when the media library packs the thumbnails itself.
+        std::vector<uint8_t>* encoded = nullptr;
+    };
+    /**
+     * @brief generate Generate multiple thumbnails from the same frame
+     * @param media A reference to the media thumbnails are being generated for
+     * @param mrl The mrl to the main file for this media
+     * @param position The position at which to generate the thumbnails, in the [0;1] range
+     * @param outputs The thumbnails to generate
+     *
+     * This is used when multiple thumbnail sizes were requested for the same
+     * media, so that implementations can seek & decode only once.
+     * Upon successful return, all the outputs destination, or encoded buffer
+     * when provided, must contain their generated thumbnail.
+     * The default implementation generates each output independently.
+     */
+    virtual bool generate( const IMedia& media, const std::string& mrl,
+                           float position, const std::vector<Output>& outputs )
+    {
+        for ( const auto& o : outputs )
+        {
+            if ( generate( media, mrl, o.desiredWidth, o.desiredHeight,
+                           position, o.destination ) == false )
+                return false;
+        }
+        return true;
+    }
     /**
      * @brief stop Stop any ongoing processing as soon as possible
      */
@@ -59,6 +59,7 @@ class ITrackInformation;
 class IMetadata;
 
 struct QueryParameters;
+struct ThumbnailData;
 
 enum class ThumbnailSizeType : uint8_t;
 enum class ThumbnailStatus : uint8_t;
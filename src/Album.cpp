@@ -30,6 +30,7 @@
 #include "Artist.h"
 #include "Genre.h"
 #include "Media.h"
+#include "MediaAggregate.h"
 #include "Thumbnail.h"
 #include "utils/Enums.h"
 #include "utils/ModificationsNotifier.h"
@@ -126,8 +127,8 @@ bool Album::setReleaseYear( unsigned int date, bool force )
             date = 0;
         }
     }
-    static const std::string req = "UPDATE " + Album::Table::Name
-            + " SET release_year = ? WHERE id_album = ?";
+    static const sqlite::Request req{ "UPDATE " + Album::Table::Name
+            + " SET release_year = ? WHERE id_album = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, date, m_id ) == false )
         return false;
     m_releaseYear = date;
@@ -141,8 +142,8 @@ const std::string& Album::shortSummary() const
 
 bool Album::setShortSummary( const std::string& summary )
 {
-    static const std::string req = "UPDATE " + Album::Table::Name
-            + " SET short_summary = ? WHERE id_album = ?";
+    static const sqlite::Request req{ "UPDATE " + Album::Table::Name
+            + " SET short_summary = ? WHERE id_album = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, summary, m_id ) == false )
         return false;
     m_shortSummary = summary;
@@ -165,6 +166,14 @@ const std::string& Album::thumbnailMrl( ThumbnailSizeType sizeType ) const
     return t->mrl();
 }
 
+ThumbnailData Album::thumbnailData( ThumbnailSizeType sizeType ) const
+{
+    const auto t = thumbnail( sizeType );
+    if ( t == nullptr )
+        return {};
+    return t->packedData();
+}
+
 std::shared_ptr<Thumbnail> Album::thumbnail( ThumbnailSizeType sizeType ) const
 {
     auto idx = Thumbnail::SizeToInt( sizeType );
@@ -254,6 +263,9 @@ std::string Album::addRequestJoin( const QueryParameters* params,
         req += "LEFT JOIN " + Artist::Table::Name + " art ON alb.artist_id = art.id_artist ";
     if ( media == true )
         req += "INNER JOIN " + Media::Table::Name + " m ON m.album_id = alb.id_album ";
+    if ( params != nullptr && params->publicOnly == true )
+        req += MediaAggregate::publicJoin( MediaAggregate::EntityType::Album,
+                                           "alb.id_album" ) + " ";
     return req;
 }
 
@@ -267,7 +279,13 @@ std::string Album::addRequestConditions( const QueryParameters* params, bool for
     if ( params == nullptr )
         return req;
 
-    if ( params->publicOnly || forcePublic )
+    if ( params->publicOnly == true )
+    {
+        if ( req.empty() == false )
+            req += " AND";
+        req += MediaAggregate::publicCondition( params );
+    }
+    else if ( forcePublic == true )
     {
         if ( req.empty() == false )
             req += " AND";
@@ -289,12 +307,7 @@ std::string Album::orderBy( const QueryParameters* params )
     std::string req = " ORDER BY ";
     auto sort = params != nullptr ? params->sort : SortingCriteria::Default;
     auto desc = params != nullptr ? params->desc : false;
-    if ( params != nullptr && params->publicOnly == true &&
-         ( sort == SortingCriteria::TrackNumber ) )
-    {
-        LOG_WARN( "Unsupported sort for public entities. Falling back to Default" );
-        sort = SortingCriteria::Default;
-    }
+    const auto publicOnly = params != nullptr && params->publicOnly == true;
     switch ( sort )
     {
     case SortingCriteria::Artist:
@@ -310,12 +323,12 @@ std::string Album::orderBy( const QueryParameters* params )
             req += "release_year, title";
         break;
     case SortingCriteria::Duration:
-        req += "duration";
+        req += publicOnly == true ? "agg.public_duration" : "duration";
         if ( desc == true )
             req += " DESC";
         break;
     case SortingCriteria::TrackNumber:
-        req += "nb_tracks";
+        req += publicOnly == true ? "agg.nb_public_tracks" : "nb_tracks";
         if ( desc == false )
             req += " DESC";
         break;
@@ -412,9 +425,9 @@ bool Album::removeTrack( Media& media )
     if ( media.setSubTypeUnknown() == false )
         return false;
 
-    static const std::string req = "UPDATE " + Table::Name + " SET "
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
         "duration = duration - ? "
-        "WHERE id_album = ?";
+        "WHERE id_album = ?" };
     auto duration = media.duration() >= 0 ? media.duration() : 0;
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req,
                                        duration, m_id ) == false )
@@ -456,8 +469,8 @@ uint32_t Album::nbDiscs() const
 
 bool Album::setNbDiscs( uint32_t nbDiscs )
 {
-    static const std::string req = "UPDATE " + Album::Table::Name
-            + " SET nb_discs = ? WHERE id_album = ?";
+    static const sqlite::Request req{ "UPDATE " + Album::Table::Name
+            + " SET nb_discs = ? WHERE id_album = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, nbDiscs, m_id ) == false )
         return false;
     m_nbDiscs = nbDiscs;
@@ -481,7 +494,7 @@ bool Album::isFavorite() const
 
 bool Album::setFavorite( bool favorite )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_album = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_album = ?" };
     if ( m_isFavorite == favorite )
         return true;
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, favorite, m_id ) == false )
@@ -505,14 +518,14 @@ bool Album::setAlbumArtist( std::shared_ptr<Artist> artist )
         return true;
     if ( artist->id() == 0 )
         return false;
-    static const std::string req = "UPDATE " + Table::Name + " SET "
-            "artist_id = ? WHERE id_album = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
+            "artist_id = ? WHERE id_album = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, artist->id(), m_id ) == false )
         return false;
     m_artistId = artist->id();
     m_albumArtist = std::move( artist );
-    static const std::string ftsReq = "UPDATE " + FtsTable::Name + " SET "
-            " artist = ? WHERE rowid = ?";
+    static const sqlite::Request ftsReq{ "UPDATE " + FtsTable::Name + " SET "
+            " artist = ? WHERE rowid = ?" };
     return sqlite::Tools::executeUpdate( m_ml->getConn(), ftsReq,
                                          m_albumArtist->name(), m_id );
 }
@@ -841,6 +854,13 @@ std::string Album::index( Indexes index, uint32_t dbModel )
                     Table::Name + "(nb_tracks, is_present)";
         case Indexes::Title:
             assert( dbModel >= 37 );
+            /*
+             * Models 45 & 46 included the artist id, which was used to break
+             * the title ties instead of the artist name
+             */
+            if ( dbModel == 45 || dbModel == 46 )
+                return "CREATE INDEX " + indexName( index, dbModel ) + " ON " +
+                        Table::Name + "(title, artist_id)";
             return "CREATE INDEX " + indexName( index, dbModel ) + " ON " +
                     Table::Name + "(title)";
     }
@@ -896,14 +916,15 @@ bool Album::checkDbModel( MediaLibraryPtr ml )
             check( Triggers::DeleteEmpty ) &&
             check( Triggers::UpdateOnMediaAlbumIdChange ) &&
             checkIndex( Indexes::ArtistId ) &&
-            checkIndex( Indexes::NbTracks );
+            checkIndex( Indexes::NbTracks ) &&
+            checkIndex( Indexes::Title );
 }
 
 std::shared_ptr<Album> Album::create( MediaLibraryPtr ml, std::string title )
 {
     auto album = std::make_shared<Album>( ml, std::move( title ) );
-    static const std::string req = "INSERT INTO " + Table::Name +
-            "(id_album, title) VALUES(NULL, ?)";
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name +
+            "(id_album, title) VALUES(NULL, ?)" };
     if ( insert( ml, album, req, album->m_title ) == false )
         return nullptr;
     return album;
@@ -912,8 +933,8 @@ std::shared_ptr<Album> Album::create( MediaLibraryPtr ml, std::string title )
 std::shared_ptr<Album> Album::createUnknownAlbum( MediaLibraryPtr ml, const Artist* artist )
 {
     auto album = std::make_shared<Album>( ml, artist );
-    static const std::string req = "INSERT INTO " + Table::Name +
-            "(id_album, artist_id) VALUES(NULL, ?)";
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name +
+            "(id_album, artist_id) VALUES(NULL, ?)" };
     if ( insert( ml, album, req, artist->id() ) == false )
         return nullptr;
     return album;
@@ -931,9 +952,11 @@ Query<IAlbum> Album::search( MediaLibraryPtr ml, const std::string& pattern,
     if ( cond.empty() == false )
         req += " AND" + cond;
 
+    const auto publicOnly = params != nullptr && params->publicOnly;
     return make_query<Album, IAlbum>( ml, "alb.*", std::move( req ),
                                       orderBy( params ),
-                                      sqlite::Tools::sanitizePattern( pattern ) ).build();
+                                      sqlite::Tools::sanitizePattern( pattern ) )
+            .markPublic( publicOnly ).build();
 }
 
 Query<IAlbum> Album::searchFromArtist( MediaLibraryPtr ml, const std::string& pattern,
@@ -950,10 +973,12 @@ Query<IAlbum> Album::searchFromArtist( MediaLibraryPtr ml, const std::string& pa
     if ( cond.empty() == false )
         req += " AND" + cond;
 
+    const auto publicOnly = params != nullptr && params->publicOnly;
     return make_query<Album, IAlbum>( ml, "alb.*", std::move( req ),
                                       orderBy( params ),
                                       sqlite::Tools::sanitizePattern( pattern ),
-                                      artistId ).build();
+                                      artistId )
+            .markPublic( publicOnly ).build();
 }
 
 Query<IAlbum> Album::fromArtist( MediaLibraryPtr ml, int64_t artistId, const QueryParameters* params )
@@ -964,7 +989,8 @@ Query<IAlbum> Album::fromArtist( MediaLibraryPtr ml, int64_t artistId, const Que
                     "WHERE (m.artist_id = ? OR alb.artist_id = ?)";
     if ( params == nullptr || params->includeMissing == false )
         req += " AND m.is_present != 0";
-    if ( params != nullptr && params->publicOnly == true )
+    const auto publicOnly = params != nullptr && params->publicOnly;
+    if ( publicOnly == true )
         req += " AND m.is_public != 0";
     std::string groupAndOrder = " GROUP BY m.album_id ORDER BY ";
     auto sort = params != nullptr ? params->sort : SortingCriteria::Default;
@@ -994,7 +1020,8 @@ Query<IAlbum> Album::fromArtist( MediaLibraryPtr ml, int64_t artistId, const Que
 
     return make_query<Album, IAlbum>( ml, "alb.*", std::move( req ),
                                       std::move( groupAndOrder ),
-                                      artistId, artistId ).build();
+                                      artistId, artistId )
+            .markPublic( publicOnly ).build();
 }
 
 Query<IAlbum> Album::fromGenre( MediaLibraryPtr ml, int64_t genreId,
@@ -1009,8 +1036,10 @@ Query<IAlbum> Album::fromGenre( MediaLibraryPtr ml, int64_t genreId,
         req += " AND" + cond;
 
     std::string groupAndOrderBy = "GROUP BY m.album_id" + orderBy( params );
+    const auto publicOnly = ( params != nullptr && params->publicOnly ) || forcePublic;
     return make_query<Album, IAlbum>( ml, "alb.*", std::move( req ),
-                                      std::move( groupAndOrderBy ), genreId ).build();
+                                      std::move( groupAndOrderBy ), genreId )
+            .markPublic( publicOnly ).build();
 }
 
 Query<IAlbum> Album::searchFromGenre( MediaLibraryPtr ml, const std::string& pattern,
@@ -1029,10 +1058,12 @@ Query<IAlbum> Album::searchFromGenre( MediaLibraryPtr ml, const std::string& pat
         req += " AND" + cond;
 
     std::string groupAndOrderBy = "GROUP BY m.album_id" + orderBy( params );
+    const auto publicOnly = ( params != nullptr && params->publicOnly ) || forcePublic;
     return make_query<Album, IAlbum>( ml, "alb.*", std::move( req ),
                                       std::move( groupAndOrderBy ),
                                       sqlite::Tools::sanitizePattern( pattern ),
-                                      genreId ).build();
+                                      genreId )
+            .markPublic( publicOnly ).build();
 }
 
 Query<IAlbum> Album::listAll( MediaLibraryPtr ml, const QueryParameters* params )
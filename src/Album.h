@@ -92,6 +92,7 @@ class Album : public IAlbum, public DatabaseHelpers<Album>
         bool setShortSummary( const std::string& summary );
         virtual ThumbnailStatus thumbnailStatus( ThumbnailSizeType sizeType ) const override;
         virtual const std::string& thumbnailMrl( ThumbnailSizeType sizeType ) const override;
+        virtual ThumbnailData thumbnailData( ThumbnailSizeType sizeType ) const override;
         std::shared_ptr<Thumbnail> thumbnail( ThumbnailSizeType sizeType ) const;
         bool setThumbnail(std::shared_ptr<Thumbnail> thumbnail );
         virtual Query<IMedia> tracks( const QueryParameters* params ) const override;
@@ -27,6 +27,7 @@
 #include "Artist.h"
 #include "Album.h"
 #include "Media.h"
+#include "MediaAggregate.h"
 #include "utils/Enums.h"
 #include "utils/ModificationsNotifier.h"
 #include "Deprecated.h"
@@ -90,8 +91,8 @@ const std::string& Artist::shortBio() const
 
 bool Artist::setShortBio(const std::string& shortBio)
 {
-    static const std::string req = "UPDATE " + Table::Name
-            + " SET shortbio = ? WHERE id_artist = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name
+            + " SET shortbio = ? WHERE id_artist = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, shortBio, m_id ) == false )
         return false;
     m_shortBio = shortBio;
@@ -122,8 +123,8 @@ Query<IMedia> Artist::searchTracks( const std::string& pattern, const QueryParam
 
 bool Artist::addMedia( const Media& media )
 {
-    static const std::string req = "INSERT INTO " + MediaRelationTable::Name +
-            " VALUES(?, ?)";
+    static const sqlite::Request req{ "INSERT INTO " + MediaRelationTable::Name +
+            " VALUES(?, ?)" };
     if ( sqlite::Tools::executeInsert( m_ml->getConn(), req, media.id(), m_id ) == 0 )
         return false;
     ++m_nbTracks;
@@ -146,6 +147,14 @@ const std::string& Artist::thumbnailMrl( ThumbnailSizeType sizeType ) const
     return t->mrl();
 }
 
+ThumbnailData Artist::thumbnailData( ThumbnailSizeType sizeType ) const
+{
+    const auto t = thumbnail( sizeType );
+    if ( t == nullptr )
+        return {};
+    return t->packedData();
+}
+
 std::shared_ptr<Thumbnail> Artist::thumbnail( ThumbnailSizeType sizeType ) const
 {
     auto idx = Thumbnail::SizeToInt( sizeType );
@@ -176,17 +185,23 @@ bool Artist::shouldUpdateThumbnail( const Thumbnail& currentThumbnail )
 
 std::string Artist::addRequestJoin(const QueryParameters* params)
 {
+    std::string req;
     auto sort = params != nullptr ? params->sort : SortingCriteria::Default;
     switch ( sort )
     {
     default:
-        return std::string{};
+        break;
     case SortingCriteria::LastPlaybackDate:
-        return std::string{ " INNER JOIN " } + MediaRelationTable::Name +
+        req = std::string{ " INNER JOIN " } + MediaRelationTable::Name +
                 " mrt ON art.id_artist = mrt.artist_id"
                 " INNER JOIN " + Media::Table::Name +
                 " m ON mrt.media_id = m.id_media";
+        break;
     }
+    if ( params != nullptr && params->publicOnly == true )
+        req += MediaAggregate::publicJoin( MediaAggregate::EntityType::Artist,
+                                           "art.id_artist" );
+    return req;
 }
 
 std::string Artist::addRequestConditions( const QueryParameters* params )
@@ -231,8 +246,8 @@ bool Artist::setThumbnail( const std::string& thumbnailMrl, ThumbnailSizeType si
 
 std::shared_ptr<Album> Artist::unknownAlbum()
 {
-    static const std::string req = "SELECT * FROM " + Album::Table::Name +
-                        " WHERE artist_id = ? AND title IS NULL";
+    static const sqlite::Request req{ "SELECT * FROM " + Album::Table::Name +
+                        " WHERE artist_id = ? AND title IS NULL" };
     return Album::fetch( m_ml, req, m_id );
 }
 
@@ -252,8 +267,8 @@ const std::string& Artist::musicBrainzId() const
 
 bool Artist::setMusicBrainzId( const std::string& mbId )
 {
-    static const std::string req = "UPDATE " + Table::Name
-            + " SET mb_id = ? WHERE id_artist = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name
+            + " SET mb_id = ? WHERE id_artist = ?" };
     if ( mbId == m_mbId )
         return true;
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, mbId, m_id ) == false )
@@ -290,7 +305,7 @@ bool Artist::isFavorite() const
 
 bool Artist::setFavorite( bool favorite )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_artist = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_artist = ?" };
     if ( m_isFavorite == favorite )
         return true;
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, favorite, m_id ) == false )
@@ -715,8 +730,8 @@ bool Artist::checkDbModel(MediaLibraryPtr ml)
 
 bool Artist::createDefaultArtists( sqlite::Connection* dbConnection )
 {
-    static const std::string req = "INSERT INTO " + Table::Name +
-            "(id_artist) VALUES(?),(?)";
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name +
+            "(id_artist) VALUES(?),(?)" };
     return sqlite::Tools::executeInsert( dbConnection, req, UnknownArtistID,
                                          VariousArtistID ) != 0;
 }
@@ -724,8 +739,8 @@ bool Artist::createDefaultArtists( sqlite::Connection* dbConnection )
 std::shared_ptr<Artist> Artist::create( MediaLibraryPtr ml, std::string name )
 {
     auto artist = std::make_shared<Artist>( ml, std::move( name ) );
-    static const std::string req = "INSERT INTO " + Table::Name +
-            "(id_artist, name) VALUES(NULL, ?)";
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name +
+            "(id_artist, name) VALUES(NULL, ?)" };
     if ( insert( ml, artist, req, artist->m_name ) == false )
         return nullptr;
     return artist;
@@ -740,6 +755,9 @@ Query<IArtist> Artist::search( MediaLibraryPtr ml, const std::string& name,
             "(SELECT rowid FROM " + FtsTable::Name + " WHERE name MATCH ?)";
 
     req += addRequestConditions( params );
+    const auto publicOnly = params != nullptr && params->publicOnly == true;
+    if ( publicOnly == true )
+        req += " AND" + MediaAggregate::publicCondition( params );
 
     // We are searching based on the name, so we're ignoring unknown/various artist
     // This means all artist we find has at least one track associated with it, so
@@ -750,7 +768,8 @@ Query<IArtist> Artist::search( MediaLibraryPtr ml, const std::string& name,
         req += " AND art.nb_tracks > 0";
     return make_query<Artist, IArtist>( ml, "art.*", std::move( req ),
                                         sortRequest( params ),
-                                        sqlite::Tools::sanitizePattern( name ) ).build();
+                                        sqlite::Tools::sanitizePattern( name ) )
+            .markPublic( publicOnly ).build();
 }
 
 Query<IArtist> Artist::listAll( MediaLibraryPtr ml, ArtistIncluded included,
@@ -758,21 +777,19 @@ Query<IArtist> Artist::listAll( MediaLibraryPtr ml, ArtistIncluded included,
 {
     std::string req = "FROM " + Table::Name + " art";
     req += addRequestJoin( params );
-    req += " WHERE ";
     auto publicOnly = params != nullptr && params->publicOnly == true;
     if ( publicOnly == true )
     {
         if ( included != ArtistIncluded::All )
             LOG_WARN( "Filtering by album artist is unsupported for public listing" );
-        req += " EXISTS(SELECT artist_id FROM " + Media::Table::Name +
-                " WHERE artist_id = art.id_artist AND is_public != 0)";
+        req += " WHERE" + MediaAggregate::publicCondition( params );
     }
     else
     {
         if ( included == ArtistIncluded::AlbumArtistOnly )
-            req += "art.nb_albums > 0";
+            req += " WHERE art.nb_albums > 0";
         else
-            req += "art.nb_tracks > 0";
+            req += " WHERE art.nb_tracks > 0";
     }
 
     req += addRequestConditions( params );
@@ -825,7 +842,8 @@ Query<IArtist> Artist::searchByGenre( MediaLibraryPtr ml, const std::string& pat
                       FtsTable::Name +
                       " WHERE name MATCH ?)"
                       " AND m.genre_id = ?";
-    if ( ( params != nullptr && params->publicOnly == true ) || forcePublic == true )
+    auto publicOnly = ( params != nullptr && params->publicOnly == true ) || forcePublic == true;
+    if ( publicOnly == true )
         req += " AND m.is_public != 0";
 
     req += addRequestConditions( params );
@@ -840,6 +858,7 @@ Query<IArtist> Artist::searchByGenre( MediaLibraryPtr ml, const std::string& pat
     }
     return make_query<Artist, IArtist>( ml, "art.*", std::move( req ), std::move( groupBy ),
                                         sqlite::Tools::sanitizePattern( pattern ), genreId )
+        .markPublic( publicOnly )
         .build();
 }
 
@@ -856,8 +875,7 @@ std::string Artist::sortRequest( const QueryParameters* params )
     auto desc = params != nullptr ? params->desc : false;
     std::string req = " ORDER BY ";
     if ( params != nullptr && params->publicOnly == true &&
-         ( sort == SortingCriteria::TrackNumber ||
-           sort == SortingCriteria::NbAlbum ) )
+         sort == SortingCriteria::NbAlbum )
     {
         LOG_WARN( "Unsupported sort for public entities. Falling back to Default" );
         sort = SortingCriteria::Default;
@@ -875,7 +893,10 @@ std::string Artist::sortRequest( const QueryParameters* params )
             req += "art.nb_albums";
             break;
         case SortingCriteria::TrackNumber:
-            req += "art.nb_tracks";
+            if ( params->publicOnly == true )
+                req += "agg.nb_public_tracks";
+            else
+                req += "art.nb_tracks";
             break;
     case SortingCriteria::LastPlaybackDate:
             req = " GROUP BY art.id_artist"
@@ -84,6 +84,7 @@ public:
     bool addMedia( const Media& tracks );
     virtual ThumbnailStatus thumbnailStatus( ThumbnailSizeType sizeType ) const override;
     virtual const std::string& thumbnailMrl( ThumbnailSizeType sizeType ) const override;
+    virtual ThumbnailData thumbnailData( ThumbnailSizeType sizeType ) const override;
     std::shared_ptr<Thumbnail> thumbnail( ThumbnailSizeType sizeType ) const;
     /**
      * @brief setThumbnail Set a new thumbnail for this artist.
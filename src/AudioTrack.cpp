@@ -233,9 +233,9 @@ std::shared_ptr<AudioTrack> AudioTrack::create( MediaLibraryPtr ml, std::string
                                                 int64_t mediaId,
                                                 int64_t attachedFileId )
 {
-    static const std::string req = "INSERT INTO " + Table::Name
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name
             + "(codec, bitrate, samplerate, nb_channels, language, description, "
-            "media_id, attached_file_id) VALUES(?, ?, ?, ?, ?, ?, ?, ?)";
+            "media_id, attached_file_id) VALUES(?, ?, ?, ?, ?, ?, ?, ?)" };
     auto track = std::make_shared<AudioTrack>( ml, std::move( codec ), bitrate, sampleRate,
                                                nbChannels, std::move( language ),
                                                std::move( desc ), mediaId,
@@ -0,0 +1,261 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "CacheEvictor.h"
+#include "File.h"
+#include "Media.h"
+#include "MediaLibrary.h"
+#include "database/SqliteTools.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace medialibrary
+{
+
+bool CacheEvictor::Key::operator<( const Key& k ) const
+{
+    if ( tier != k.tier )
+        return tier < k.tier;
+    if ( priority != k.priority )
+        return priority < k.priority;
+    return fileId < k.fileId;
+}
+
+CacheEvictor::CacheEvictor( CacheEvictionPolicy policy )
+    : m_policy( policy )
+    , m_inflation( 0 )
+    , m_totalSize( 0 )
+{
+}
+
+void CacheEvictor::setPolicy( CacheEvictionPolicy policy )
+{
+    if ( policy == m_policy )
+        return;
+    m_policy = policy;
+    m_inflation = 0;
+    std::vector<Entry> entries;
+    entries.reserve( m_files.size() );
+    for ( auto& f : m_files )
+        entries.push_back( std::move( f.second.entry ) );
+    reset( std::move( entries ) );
+}
+
+CacheEvictionPolicy CacheEvictor::policy() const
+{
+    return m_policy;
+}
+
+std::vector<CacheEvictor::Entry> CacheEvictor::fetchCachedFiles( MediaLibraryPtr ml )
+{
+    /*
+     * Ensure we see the latest play state if the progress is buffered. The
+     * last_position is -1 both for media that were never played and media that
+     * were played until their end.
+     */
+    ml->progressBuffer().flush();
+    OPEN_READ_CONTEXT( ctx, ml->getConn() );
+    sqlite::Statement stmt{ cachedFilesRequest() };
+    stmt.execute( IFile::Type::Cache );
+    std::vector<Entry> entries;
+    fetchEntries( stmt, entries );
+    return entries;
+}
+
+std::vector<CacheEvictor::Entry>
+CacheEvictor::fetchCachedFiles( MediaLibraryPtr ml,
+                                const std::unordered_set<int64_t>& mediaIds )
+{
+    ml->progressBuffer().flush();
+    static const std::string req = cachedFilesRequest() + " AND f.media_id = ?";
+    OPEN_READ_CONTEXT( ctx, ml->getConn() );
+    std::vector<Entry> entries;
+    for ( auto mediaId : mediaIds )
+    {
+        sqlite::Statement stmt{ req };
+        stmt.execute( IFile::Type::Cache, mediaId );
+        fetchEntries( stmt, entries );
+    }
+    return entries;
+}
+
+std::string CacheEvictor::cachedFilesRequest()
+{
+    return "SELECT f.id_file, f.mrl, f.size, "
+            "f.insertion_date, m.last_played_date, m.play_count, m.last_position"
+            " FROM " + File::Table::Name + " f"
+            " INNER JOIN " + Media::Table::Name + " m ON m.id_media = f.media_id"
+            " WHERE f.type = ?";
+}
+
+void CacheEvictor::fetchEntries( sqlite::Statement& stmt, std::vector<Entry>& entries )
+{
+    sqlite::Row row;
+    while ( ( row = stmt.row() ) != nullptr )
+    {
+        Entry e;
+        float lastPosition;
+        row >> e.fileId >> e.mrl >> e.size >> e.insertionDate
+            >> e.lastPlayedDate >> e.playCount >> lastPosition;
+        e.inProgress = lastPosition >= 0.f;
+        entries.push_back( std::move( e ) );
+    }
+}
+
+void CacheEvictor::reset( std::vector<Entry> entries )
+{
+    m_queue.clear();
+    m_files.clear();
+    m_totalSize = 0;
+    for ( auto& e : entries )
+        track( std::move( e ) );
+}
+
+void CacheEvictor::insert( Entry entry )
+{
+    untrack( entry.fileId, nullptr );
+    track( std::move( entry ) );
+}
+
+void CacheEvictor::refresh( const std::vector<Entry>& entries )
+{
+    for ( const auto& e : entries )
+    {
+        auto it = m_files.find( e.fileId );
+        if ( it == end( m_files ) )
+            continue;
+        auto& tracked = it->second.entry;
+        if ( tracked.lastPlayedDate == e.lastPlayedDate &&
+             tracked.playCount == e.playCount &&
+             tracked.inProgress == e.inProgress )
+            continue;
+        auto updated = tracked;
+        updated.lastPlayedDate = e.lastPlayedDate;
+        updated.playCount = e.playCount;
+        updated.inProgress = e.inProgress;
+        insert( std::move( updated ) );
+    }
+}
+
+bool CacheEvictor::remove( int64_t fileId )
+{
+    return untrack( fileId, nullptr );
+}
+
+bool CacheEvictor::evicted( int64_t fileId )
+{
+    double priority;
+    if ( untrack( fileId, &priority ) == false )
+        return false;
+    if ( m_policy == CacheEvictionPolicy::SizeAware )
+        m_inflation = std::max( m_inflation, priority );
+    return true;
+}
+
+bool CacheEvictor::selectVictims( uint64_t nbBytes, uint32_t nbFiles,
+                                  const Filter& filter,
+                                  std::vector<Entry>& victims ) const
+{
+    uint64_t reclaimed = 0;
+    uint32_t nbEvicted = 0;
+    for ( const auto& k : m_queue )
+    {
+        if ( reclaimed >= nbBytes && nbEvicted >= nbFiles )
+            break;
+        const auto& e = m_files.at( k.fileId ).entry;
+        if ( filter != nullptr && filter( e ) == false )
+            continue;
+        reclaimed += e.size;
+        ++nbEvicted;
+        victims.push_back( e );
+    }
+    return reclaimed >= nbBytes && nbEvicted >= nbFiles;
+}
+
+size_t CacheEvictor::nbFiles() const
+{
+    return m_files.size();
+}
+
+uint64_t CacheEvictor::totalSize() const
+{
+    return m_totalSize;
+}
+
+CacheEvictor::Key CacheEvictor::computeKey( const Entry& e ) const
+{
+    auto lastUse = std::max( e.lastPlayedDate, e.insertionDate );
+    switch ( m_policy )
+    {
+        case CacheEvictionPolicy::LeastRecentlyPlayed:
+            return Key{ 0, static_cast<double>( lastUse ), e.fileId };
+        case CacheEvictionPolicy::SizeAware:
+        {
+            /*
+             * The priority is the file's worth per MiB, on top of the priority
+             * of the last evicted file, so that files which weren't played in
+             * a long time eventually become eviction candidates again.
+             */
+            auto sizeMiB = std::max( static_cast<double>( e.size ) /
+                                        ( 1024 * 1024 ), 1.0 / 1024 );
+            return Key{ 0, m_inflation + ( e.playCount + 1 ) / sizeMiB,
+                        e.fileId };
+        }
+        case CacheEvictionPolicy::PlayedFirst:
+        {
+            auto finished = e.playCount > 0 && e.inProgress == false;
+            return Key{ finished == true ? 0u : 1u,
+                        static_cast<double>( lastUse ), e.fileId };
+        }
+    }
+    assert( !"Invalid eviction policy" );
+    return Key{ 0, 0, e.fileId };
+}
+
+void CacheEvictor::track( Entry entry )
+{
+    auto key = computeKey( entry );
+    auto fileId = entry.fileId;
+    m_totalSize += entry.size;
+    m_queue.insert( key );
+    m_files.emplace( fileId, Tracked{ std::move( entry ), key } );
+}
+
+bool CacheEvictor::untrack( int64_t fileId, double* priority )
+{
+    auto it = m_files.find( fileId );
+    if ( it == end( m_files ) )
+        return false;
+    if ( priority != nullptr )
+        *priority = it->second.key.priority;
+    m_queue.erase( it->second.key );
+    m_totalSize -= it->second.entry.size;
+    m_files.erase( it );
+    return true;
+}
+
+}
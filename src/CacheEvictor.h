@@ -0,0 +1,159 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include "medialibrary/IMediaLibrary.h"
+#include "Types.h"
+
+#include <ctime>
+#include <functional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace medialibrary
+{
+
+namespace sqlite
+{
+class Statement;
+}
+
+/**
+ * @brief The CacheEvictor class keeps track of the cached files, ordered by
+ * eviction priority according to a CacheEvictionPolicy.
+ *
+ * Inserting, updating & removing a file as well as fetching the next victim are
+ * O(log n) operations. This is meant to be used from the CacheWorker thread
+ * only, and therefore isn't thread safe.
+ */
+class CacheEvictor
+{
+public:
+    struct Entry
+    {
+        int64_t fileId;
+        std::string mrl;
+        uint64_t size;
+        time_t insertionDate;
+        time_t lastPlayedDate;
+        uint32_t playCount;
+        /* true if the media was started but not played until its end */
+        bool inProgress;
+    };
+    using Filter = std::function<bool( const Entry& )>;
+
+    explicit CacheEvictor( CacheEvictionPolicy policy );
+
+    void setPolicy( CacheEvictionPolicy policy );
+    CacheEvictionPolicy policy() const;
+
+    /**
+     * @brief fetchCachedFiles Loads the eviction related properties of all the
+     *        cached files in a single request
+     */
+    static std::vector<Entry> fetchCachedFiles( MediaLibraryPtr ml );
+    /**
+     * @brief fetchCachedFiles Loads the eviction related properties of the
+     *        files cached for the provided media only
+     */
+    static std::vector<Entry> fetchCachedFiles( MediaLibraryPtr ml,
+                                                const std::unordered_set<int64_t>& mediaIds );
+
+    /**
+     * @brief reset Replaces all the tracked files
+     */
+    void reset( std::vector<Entry> entries );
+    /**
+     * @brief insert Starts tracking a file, or updates it if it was already
+     *        tracked.
+     */
+    void insert( Entry entry );
+    /**
+     * @brief refresh Updates the play state of the tracked files
+     *
+     * Only the files which play state changed are moved in the queue, and
+     * files which aren't tracked yet are ignored.
+     */
+    void refresh( const std::vector<Entry>& entries );
+    bool remove( int64_t fileId );
+    /**
+     * @brief evicted Stops tracking a file that was evicted.
+     *
+     * Unlike remove(), this will age the remaining files when using the
+     * CacheEvictionPolicy::SizeAware policy.
+     */
+    bool evicted( int64_t fileId );
+
+    /**
+     * @brief selectVictims Selects the files to evict, in eviction order
+     * @param nbBytes The minimum number of bytes to reclaim
+     * @param nbFiles The minimum number of files to evict
+     * @param filter If provided, only the files it accepts can be selected
+     * @param victims The selected files. This is filled even if the requested
+     *                amounts can't be reclaimed
+     * @return true if the requested amount of files & bytes can be reclaimed
+     *
+     * This doesn't modify the evictor; evicted() must be called for each file
+     * that was actually removed from the cache.
+     */
+    bool selectVictims( uint64_t nbBytes, uint32_t nbFiles, const Filter& filter,
+                        std::vector<Entry>& victims ) const;
+
+    size_t nbFiles() const;
+    uint64_t totalSize() const;
+
+private:
+    struct Key
+    {
+        uint32_t tier;
+        double priority;
+        int64_t fileId;
+
+        bool operator<( const Key& k ) const;
+    };
+
+    struct Tracked
+    {
+        Entry entry;
+        Key key;
+    };
+
+    static std::string cachedFilesRequest();
+    static void fetchEntries( sqlite::Statement& stmt, std::vector<Entry>& entries );
+    Key computeKey( const Entry& e ) const;
+    void track( Entry entry );
+    bool untrack( int64_t fileId, double* priority );
+
+private:
+    CacheEvictionPolicy m_policy;
+    /* The SizeAware policy inflation value, ie. the last evicted file priority */
+    double m_inflation;
+    uint64_t m_totalSize;
+    std::set<Key> m_queue;
+    std::unordered_map<int64_t, Tracked> m_files;
+};
+
+}
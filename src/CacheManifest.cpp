@@ -0,0 +1,195 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "CacheManifest.h"
+#include "File.h"
+#include "MediaLibrary.h"
+#include "Settings.h"
+#include "database/SqliteTools.h"
+#include "utils/Filename.h"
+#include "utils/Url.h"
+
+namespace medialibrary
+{
+
+const std::string CacheManifest::Table::Name = "CacheManifest";
+
+void CacheManifest::createTable( sqlite::Connection* dbConn )
+{
+    sqlite::Tools::executeRequest( dbConn, schema( Table::Name,
+                                                   Settings::DbModelVersion ) );
+}
+
+void CacheManifest::createIndexes( sqlite::Connection* dbConn )
+{
+    sqlite::Tools::executeRequest( dbConn, index( Indexes::Dirty,
+                                                  Settings::DbModelVersion ) );
+}
+
+std::string CacheManifest::schema( const std::string& tableName, uint32_t )
+{
+    UNUSED_IN_RELEASE( tableName );
+
+    assert( tableName == Table::Name );
+    return "CREATE TABLE " + Table::Name +
+    "("
+        "file_name TEXT PRIMARY KEY NOT NULL,"
+        "file_id INTEGER,"
+        "size UNSIGNED INTEGER NOT NULL,"
+        "last_modification_date UNSIGNED INTEGER NOT NULL,"
+        "state UNSIGNED INTEGER NOT NULL,"
+        "FOREIGN KEY(file_id) REFERENCES " + File::Table::Name +
+            "(" + File::Table::PrimaryKeyColumn + ") ON DELETE SET NULL"
+    ")";
+}
+
+std::string CacheManifest::index( Indexes index, uint32_t dbModel )
+{
+    switch ( index )
+    {
+        case Indexes::Dirty:
+            /* Keep the startup verification from scanning the whole manifest */
+            return "CREATE INDEX " + indexName( index, dbModel ) + " ON " +
+                    Table::Name + "(state) WHERE " + dirtyCondition();
+    }
+    return "<invalid request>";
+}
+
+std::string CacheManifest::indexName( Indexes index, uint32_t dbModel )
+{
+    UNUSED_IN_RELEASE( dbModel );
+
+    switch ( index )
+    {
+        case Indexes::Dirty:
+            assert( dbModel >= 42 );
+            return "cache_manifest_dirty_idx";
+    }
+    return "<invalid request>";
+}
+
+bool CacheManifest::checkDbModel( MediaLibraryPtr ml )
+{
+    OPEN_READ_CONTEXT( ctx, ml->getConn() );
+
+    return sqlite::Tools::checkTableSchema(
+                                       schema( Table::Name, Settings::DbModelVersion ),
+                                       Table::Name ) &&
+           sqlite::Tools::checkIndexStatement(
+                                       index( Indexes::Dirty, Settings::DbModelVersion ),
+                                       indexName( Indexes::Dirty, Settings::DbModelVersion ) );
+}
+
+std::string CacheManifest::fileName( const std::string& mrl )
+{
+    return utils::url::decode( utils::file::fileName( mrl ) );
+}
+
+bool CacheManifest::insertPending( MediaLibraryPtr ml, const std::string& fileName )
+{
+    static const sqlite::Request req{ "INSERT OR REPLACE INTO " + Table::Name +
+            "(file_name, file_id, size, last_modification_date, state) "
+            "VALUES(?, NULL, 0, 0, ?)" };
+    return sqlite::Tools::executeInsert( ml->getConn(), req, fileName,
+                                         State::Pending ) != 0;
+}
+
+bool CacheManifest::commit( MediaLibraryPtr ml, const std::string& fileName,
+                            int64_t fileId, uint64_t size,
+                            time_t lastModificationDate )
+{
+    static const sqlite::Request req{ "INSERT OR REPLACE INTO " + Table::Name +
+            "(file_name, file_id, size, last_modification_date, state) "
+            "VALUES(?, ?, ?, ?, ?)" };
+    return sqlite::Tools::executeInsert( ml->getConn(), req, fileName,
+                                         sqlite::ForeignKey{ fileId }, size,
+                                         lastModificationDate,
+                                         State::Committed ) != 0;
+}
+
+bool CacheManifest::setState( MediaLibraryPtr ml, const std::string& fileName,
+                              State state )
+{
+    static const sqlite::Request req{ "UPDATE " + Table::Name +
+            " SET state = ? WHERE file_name = ?" };
+    return sqlite::Tools::executeUpdate( ml->getConn(), req, state, fileName );
+}
+
+bool CacheManifest::remove( MediaLibraryPtr ml, const std::string& fileName )
+{
+    static const sqlite::Request req{ "DELETE FROM " + Table::Name +
+            " WHERE file_name = ?" };
+    return sqlite::Tools::executeDelete( ml->getConn(), req, fileName );
+}
+
+bool CacheManifest::clear( MediaLibraryPtr ml )
+{
+    static const sqlite::Request req{ "DELETE FROM " + Table::Name };
+    return sqlite::Tools::executeDelete( ml->getConn(), req );
+}
+
+std::vector<CacheManifest::Entry> CacheManifest::fetchDirty( MediaLibraryPtr ml )
+{
+    static const sqlite::Request req{ "SELECT file_name, file_id, size, "
+            "last_modification_date, state FROM " + Table::Name +
+            " WHERE " + dirtyCondition() };
+    return fetch( ml, req );
+}
+
+std::vector<CacheManifest::Entry> CacheManifest::fetchAll( MediaLibraryPtr ml )
+{
+    static const sqlite::Request req{ "SELECT file_name, file_id, size, "
+            "last_modification_date, state FROM " + Table::Name };
+    return fetch( ml, req );
+}
+
+std::string CacheManifest::dirtyCondition()
+{
+    /* Inlined so that sqlite can use the partial index */
+    using StateType = typename std::underlying_type<State>::type;
+    return "state != " + std::to_string( static_cast<StateType>( State::Committed ) ) +
+            " OR file_id IS NULL";
+}
+
+std::vector<CacheManifest::Entry> CacheManifest::fetch( MediaLibraryPtr ml,
+                                                        const sqlite::Request& req )
+{
+    OPEN_READ_CONTEXT( ctx, ml->getConn() );
+    sqlite::Statement stmt{ req };
+    stmt.execute();
+    std::vector<Entry> entries;
+    sqlite::Row row;
+    while ( ( row = stmt.row() ) != nullptr )
+    {
+        Entry e;
+        row >> e.fileName >> e.fileId >> e.size >> e.lastModificationDate
+            >> e.state;
+        entries.push_back( std::move( e ) );
+    }
+    return entries;
+}
+
+}
@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Types.h"
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace medialibrary
+{
+
+namespace sqlite
+{
+class Connection;
+class Request;
+}
+
+/**
+ * @brief The CacheManifest class persists the content of the cache folder
+ *
+ * Each file stored in the cache folder is journaled before being written or
+ * removed, and committed in the same transaction as its cached File. This
+ * allows the cache worker to only reconcile the entries that were left in an
+ * intermediate state instead of listing the whole cache folder on startup.
+ * The size and modification date recorded when committing a file are then
+ * compared to the file on disk, so that a modified file isn't used.
+ */
+class CacheManifest
+{
+public:
+    struct Table
+    {
+        static const std::string Name;
+    };
+    enum class Indexes : uint8_t
+    {
+        Dirty,
+    };
+    enum class State : uint8_t
+    {
+        /* The file is being written, or its transfer was interrupted */
+        Pending,
+        /* The file is complete and linked to a cached File */
+        Committed,
+        /* The file is being removed from the cache */
+        Removing,
+    };
+    struct Entry
+    {
+        /* The file name, relative to the cache folder */
+        std::string fileName;
+        /* The cached File, or 0 if the file isn't linked to a File (anymore) */
+        int64_t fileId;
+        uint64_t size;
+        time_t lastModificationDate;
+        State state;
+    };
+
+    static void createTable( sqlite::Connection* dbConn );
+    static void createIndexes( sqlite::Connection* dbConn );
+    static std::string schema( const std::string& tableName, uint32_t dbModel );
+    static std::string index( Indexes index, uint32_t dbModel );
+    static std::string indexName( Indexes index, uint32_t dbModel );
+    static bool checkDbModel( MediaLibraryPtr ml );
+
+    /**
+     * @brief fileName Returns the manifest file name for a cached file MRL
+     */
+    static std::string fileName( const std::string& mrl );
+
+    /**
+     * @brief insertPending Records a file that is about to be written
+     */
+    static bool insertPending( MediaLibraryPtr ml, const std::string& fileName );
+    /**
+     * @brief commit Records a complete file
+     *
+     * This is expected to be called in the same transaction as the one
+     * creating the cached File
+     */
+    static bool commit( MediaLibraryPtr ml, const std::string& fileName,
+                        int64_t fileId, uint64_t size, time_t lastModificationDate );
+    static bool setState( MediaLibraryPtr ml, const std::string& fileName,
+                          State state );
+    static bool remove( MediaLibraryPtr ml, const std::string& fileName );
+    /**
+     * @brief clear Removes all entries, before rebuilding the entire manifest
+     */
+    static bool clear( MediaLibraryPtr ml );
+    /**
+     * @brief fetchDirty Returns the entries that need to be verified
+     *
+     * Those are the entries which aren't committed, and the committed ones
+     * which lost their cached File, for instance when their media got removed.
+     */
+    static std::vector<Entry> fetchDirty( MediaLibraryPtr ml );
+    static std::vector<Entry> fetchAll( MediaLibraryPtr ml );
+
+private:
+    static std::string dirtyCondition();
+    static std::vector<Entry> fetch( MediaLibraryPtr ml, const sqlite::Request& req );
+};
+
+}
@@ -0,0 +1,308 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "CacheScheduler.h"
+#include "medialibrary/ICacher.h"
+#include "medialibrary/filesystem/Errors.h"
+#include "logging/Logger.h"
+#include "utils/File.h"
+#include "utils/SWMRLock.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace medialibrary
+{
+
+namespace
+{
+
+class SteadyClock : public CacheScheduler::Clock
+{
+public:
+    virtual TimePoint now() override
+    {
+        return std::chrono::steady_clock::now();
+    }
+
+    virtual void waitUntil( std::unique_lock<compat::Mutex>& lock,
+                            compat::ConditionVariable& cond,
+                            TimePoint deadline ) override
+    {
+        cond.wait_until( lock, deadline );
+    }
+};
+
+}
+
+CacheScheduler::CacheScheduler()
+    : m_maxTransfers( 1 )
+    , m_maxBytesPerSec( 0 )
+    , m_interrupted( false )
+    , m_stopWorkers( false )
+    , m_clock( std::make_shared<SteadyClock>() )
+{
+}
+
+void CacheScheduler::setClock( std::shared_ptr<Clock> clock )
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    m_clock = std::move( clock );
+}
+
+void CacheScheduler::setLimits( uint32_t maxTransfers, uint64_t maxBytesPerSec )
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    m_maxTransfers = std::max( maxTransfers, 1u );
+    m_maxBytesPerSec = maxBytesPerSec;
+}
+
+void CacheScheduler::run( std::shared_ptr<ICacher> cacher,
+                          std::vector<Transfer> transfers,
+                          const StartCb& onStart, const DoneCb& onDone )
+{
+    assert( cacher != nullptr );
+    std::unique_lock<compat::Mutex> lock{ m_mutex };
+    m_stopWorkers = false;
+    m_groups.clear();
+    for ( auto& t : transfers )
+    {
+        auto it = std::find_if( begin( m_groups ), end( m_groups ),
+                                [&t]( const Group& g ) { return g.id == t.groupId; } );
+        if ( it == end( m_groups ) )
+        {
+            m_groups.push_back( Group{ t.groupId, {}, 0 } );
+            it = end( m_groups ) - 1;
+        }
+        it->pending.push_back( std::move( t ) );
+    }
+
+    auto nbWorkers = cacher->canCacheConcurrently() == true ? m_maxTransfers : 1u;
+    nbWorkers = std::min<uint32_t>( nbWorkers, transfers.size() );
+    std::vector<compat::Thread> workers;
+    workers.reserve( nbWorkers );
+    for ( auto i = 0u; i < nbWorkers; ++i )
+        workers.emplace_back( &CacheScheduler::work, this, std::ref( *cacher ) );
+    LOG_DEBUG( "Scheduling ", transfers.size(), " cache transfer(s) for ",
+               m_groups.size(), " group(s) using ", nbWorkers, " worker(s)" );
+
+    size_t nbPending = transfers.size();
+    auto nbRunning = 0u;
+    while ( true )
+    {
+        while ( m_done.empty() == false )
+        {
+            auto res = std::move( m_done.front() );
+            m_done.pop_front();
+            --nbRunning;
+            transferDone( res.transfer.groupId );
+            lock.unlock();
+            onDone( res.transfer, res.success );
+            lock.lock();
+        }
+        if ( nbPending == 0 || m_interrupted == true )
+        {
+            if ( nbRunning == 0 )
+                break;
+            m_doneCond.wait( lock, [this]() { return m_done.empty() == false; } );
+            continue;
+        }
+        if ( nbRunning >= nbWorkers )
+        {
+            m_doneCond.wait( lock, [this]() {
+                return m_done.empty() == false || m_interrupted == true;
+            });
+            continue;
+        }
+        auto now = m_clock->now();
+        if ( m_maxBytesPerSec > 0 && now < m_nextSlot )
+        {
+            /* The loop handles the completions, interruptions & spurious wakeups */
+            if ( m_done.empty() == true && m_interrupted == false )
+                m_clock->waitUntil( lock, m_doneCond, m_nextSlot );
+            continue;
+        }
+        Transfer t;
+        if ( nextTransfer( t ) == false )
+        {
+            assert( !"Inconsistent pending transfers count" );
+            break;
+        }
+        --nbPending;
+        lock.unlock();
+        auto start = onStart( t );
+        lock.lock();
+        if ( start == false )
+        {
+            transferDone( t.groupId );
+            continue;
+        }
+        if ( m_maxBytesPerSec > 0 )
+        {
+            auto size = t.size;
+            try
+            {
+                /* Only account for what's left to transfer */
+                if ( cacher->canResume() == true )
+                    size -= std::min( size, utils::fs::fileSize( partialPath( t.outputPath ) ) );
+            }
+            catch ( const fs::errors::Exception& )
+            {
+            }
+            auto duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(
+                            static_cast<double>( size ) / m_maxBytesPerSec ) );
+            m_nextSlot = std::max( now, m_nextSlot ) + duration;
+        }
+        ++nbRunning;
+        m_ready.push_back( std::move( t ) );
+        m_workCond.notify_one();
+    }
+    m_stopWorkers = true;
+    m_ready.clear();
+    m_groups.clear();
+    m_workCond.notify_all();
+    lock.unlock();
+    for ( auto& w : workers )
+        w.join();
+}
+
+void CacheScheduler::interrupt()
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    m_interrupted = true;
+    m_doneCond.notify_all();
+}
+
+std::string CacheScheduler::partialPath( const std::string& outputPath )
+{
+    return outputPath + ".part";
+}
+
+void CacheScheduler::work( ICacher& cacher )
+{
+    utils::SWMRLock::setThreadClient( LockClient::Cache );
+    std::unique_lock<compat::Mutex> lock{ m_mutex };
+    while ( true )
+    {
+        m_workCond.wait( lock, [this]() {
+            return m_stopWorkers == true || m_ready.empty() == false;
+        });
+        if ( m_stopWorkers == true )
+            break;
+        auto t = std::move( m_ready.front() );
+        m_ready.pop_front();
+        /*
+         * The transfer might have been queued before an interruption, in which
+         * case the cacher was already interrupted and must not be started
+         */
+        if ( m_interrupted == true )
+        {
+            m_done.push_back( Result{ std::move( t ), false } );
+            m_doneCond.notify_all();
+            continue;
+        }
+        lock.unlock();
+        auto success = transfer( cacher, t );
+        lock.lock();
+        m_done.push_back( Result{ std::move( t ), success } );
+        m_doneCond.notify_all();
+    }
+}
+
+bool CacheScheduler::transfer( ICacher& cacher, const Transfer& t )
+{
+    auto partial = partialPath( t.outputPath );
+    uint64_t offset = 0;
+    try
+    {
+        if ( cacher.canResume() == true )
+            offset = utils::fs::fileSize( partial );
+    }
+    catch ( const fs::errors::Exception& )
+    {
+    }
+    bool res;
+    if ( offset > 0 )
+    {
+        LOG_DEBUG( "Resuming transfer of ", t.inputMrl, " at offset ", offset );
+        res = cacher.resume( t.inputMrl, partial, offset );
+    }
+    else
+    {
+        LOG_DEBUG( "Caching ", t.inputMrl, " to ", t.outputPath );
+        res = cacher.cache( t.inputMrl, partial );
+    }
+    if ( res == false )
+    {
+        LOG_DEBUG( "Transfer of ", t.inputMrl, " didn't complete" );
+        return false;
+    }
+    if ( utils::fs::rename( partial, t.outputPath ) == false )
+    {
+        LOG_ERROR( "Failed to move ", partial, " to ", t.outputPath );
+        return false;
+    }
+    return true;
+}
+
+bool CacheScheduler::nextTransfer( Transfer& t )
+{
+    /*
+     * Pick the group with the fewest running transfers, and in case of tie the
+     * one which was served the longest time ago.
+     */
+    auto it = end( m_groups );
+    for ( auto g = begin( m_groups ); g != end( m_groups ); ++g )
+    {
+        if ( g->pending.empty() == true )
+            continue;
+        if ( it == end( m_groups ) || g->nbRunning < it->nbRunning )
+            it = g;
+    }
+    if ( it == end( m_groups ) )
+        return false;
+    t = std::move( it->pending.front() );
+    it->pending.pop_front();
+    it->nbRunning++;
+    auto g = std::move( *it );
+    m_groups.erase( it );
+    m_groups.push_back( std::move( g ) );
+    return true;
+}
+
+void CacheScheduler::transferDone( int64_t groupId )
+{
+    auto it = std::find_if( begin( m_groups ), end( m_groups ),
+                            [groupId]( const Group& g ) { return g.id == groupId; } );
+    assert( it != end( m_groups ) );
+    assert( it->nbRunning > 0 );
+    it->nbRunning--;
+    if ( it->nbRunning == 0 && it->pending.empty() == true )
+        m_groups.erase( it );
+}
+
+}
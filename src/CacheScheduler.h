@@ -0,0 +1,156 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include "compat/Thread.h"
+#include "compat/Mutex.h"
+#include "compat/ConditionVariable.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace medialibrary
+{
+
+class ICacher;
+
+/**
+ * @brief The CacheScheduler class runs multiple cache transfers concurrently
+ *
+ * The transfers are grouped (by subscription) and the available transfer slots
+ * are shared fairly between the groups, so that a slow source only delays its
+ * own transfers. The transfers can also be limited to an average throughput.
+ *
+ * Transfers are written to a partial file which is renamed once complete, so
+ * an interrupted transfer can be resumed by a later run.
+ *
+ * All the callbacks are invoked on the thread calling run(), which allows the
+ * caller to update the database & cache accounting without extra locking.
+ */
+class CacheScheduler
+{
+public:
+    struct Transfer
+    {
+        /* The entity between which the transfers are shared, ie. a subscription */
+        int64_t groupId;
+        /* An opaque ID for the caller, ie. the media being cached */
+        int64_t itemId;
+        std::string inputMrl;
+        std::string outputPath;
+        /* The expected transfer size, used to enforce the bandwidth limit */
+        uint64_t size;
+    };
+    /* Invoked before starting a transfer. Returning false skips it */
+    using StartCb = std::function<bool( const Transfer& )>;
+    using DoneCb = std::function<void( const Transfer&, bool success )>;
+
+    /**
+     * @brief The Clock class provides the time used to enforce the bandwidth
+     *        limit, so that it can be simulated.
+     */
+    class Clock
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        virtual ~Clock() = default;
+        virtual TimePoint now() = 0;
+        /**
+         * @brief waitUntil Waits until the deadline is reached or until the
+         *        condition variable gets notified, whichever happens first.
+         */
+        virtual void waitUntil( std::unique_lock<compat::Mutex>& lock,
+                                compat::ConditionVariable& cond,
+                                TimePoint deadline ) = 0;
+    };
+
+    CacheScheduler();
+
+    void setClock( std::shared_ptr<Clock> clock );
+
+    /**
+     * @brief setLimits Configures the transfers budgets
+     * @param maxTransfers The maximum number of simultaneous transfers
+     * @param maxBytesPerSec The maximum average throughput, or 0 for no limit
+     */
+    void setLimits( uint32_t maxTransfers, uint64_t maxBytesPerSec );
+
+    /**
+     * @brief run Runs the provided transfers and returns once they are all
+     *        done, or when interrupted.
+     */
+    void run( std::shared_ptr<ICacher> cacher, std::vector<Transfer> transfers,
+              const StartCb& onStart, const DoneCb& onDone );
+    /**
+     * @brief interrupt Prevents the pending transfers from starting
+     *
+     * Ongoing transfers must be interrupted through the ICacher instance,
+     * after calling this function. The transfers which were scheduled but
+     * not started yet are reported as failed.
+     * Once interrupted, run() will return without starting any transfer.
+     */
+    void interrupt();
+
+    static std::string partialPath( const std::string& outputPath );
+
+private:
+    struct Group
+    {
+        int64_t id;
+        std::deque<Transfer> pending;
+        uint32_t nbRunning;
+    };
+    struct Result
+    {
+        Transfer transfer;
+        bool success;
+    };
+
+    void work( ICacher& cacher );
+    static bool transfer( ICacher& cacher, const Transfer& t );
+    bool nextTransfer( Transfer& t );
+    void transferDone( int64_t groupId );
+
+private:
+    compat::Mutex m_mutex;
+    compat::ConditionVariable m_workCond;
+    compat::ConditionVariable m_doneCond;
+    uint32_t m_maxTransfers;
+    uint64_t m_maxBytesPerSec;
+    bool m_interrupted;
+    bool m_stopWorkers;
+    /* Groups with pending transfers, in round robin order */
+    std::deque<Group> m_groups;
+    std::deque<Transfer> m_ready;
+    std::deque<Result> m_done;
+    std::shared_ptr<Clock> m_clock;
+    /* The earliest time at which the next transfer fits in the bandwidth budget */
+    Clock::TimePoint m_nextSlot;
+};
+
+}
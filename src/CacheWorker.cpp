@@ -25,25 +25,51 @@
 #endif
 
 #include "CacheWorker.h"
+#include "CacheManifest.h"
 #include "Media.h"
 #include "Subscription.h"
 #include "utils/Url.h"
 #include "utils/File.h"
 #include "utils/Filename.h"
+#include "utils/SWMRLock.h"
 #include "medialibrary/filesystem/IFileSystemFactory.h"
 #include "medialibrary/filesystem/IDirectory.h"
 #include "medialibrary/filesystem/IFile.h"
+#include "medialibrary/filesystem/Errors.h"
 #include "medialibrary/ICacher.h"
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace medialibrary
 {
 
+namespace
+{
+
+/*
+ * Returns true if a cached file still matches what was recorded when it got
+ * committed. Entries seeded by the model 42 migration have an unknown
+ * modification date, in which case only the size can be compared.
+ */
+bool matchesManifest( const CacheManifest::Entry& e, uint64_t size,
+                      time_t lastModificationDate )
+{
+    return e.size == size && ( e.lastModificationDate == 0 ||
+                               e.lastModificationDate == lastModificationDate );
+}
+
+}
+
 CacheWorker::CacheWorker( MediaLibrary* ml )
     : m_ml( ml )
     , m_paused( false )
     , m_run( true )
+    , m_evictor( CacheEvictionPolicy::PlayedFirst )
+    , m_reservedSize( 0 )
+    , m_historyCleared( false )
+    , m_committedEntriesVerified( false )
 {
 }
 
@@ -58,7 +84,18 @@ void CacheWorker::setCacher( std::shared_ptr<ICacher> cacher )
     m_cacher = std::move( cacher );
 }
 
-bool CacheWorker::queueTask( std::shared_ptr<Media> m, bool cache )
+void CacheWorker::setEvictionPolicy( CacheEvictionPolicy policy )
+{
+    assert( m_thread.joinable() == false );
+    m_evictor.setPolicy( policy );
+}
+
+void CacheWorker::setTransferLimits( uint32_t maxTransfers, uint64_t maxBytesPerSec )
+{
+    m_scheduler.setLimits( maxTransfers, maxBytesPerSec );
+}
+
+bool CacheWorker::queueTask( std::shared_ptr<Media> m, Task::Type type )
 {
     std::lock_guard<compat::Mutex> lock{ m_mutex };
 
@@ -68,7 +105,7 @@ bool CacheWorker::queueTask( std::shared_ptr<Media> m, bool cache )
         return false;
     }
 
-    m_tasks.emplace( std::move( m ), cache );
+    m_tasks.emplace( std::move( m ), type );
     if ( m_thread.joinable() == false )
         m_thread = compat::Thread{ &CacheWorker::run, this };
     else
@@ -86,7 +123,7 @@ bool CacheWorker::cacheMedia( std::shared_ptr<Media> m )
         LOG_DEBUG( "Media ", m->id(), " is already cached" );
         return true;
     }
-    return queueTask( std::move( m ), true );
+    return queueTask( std::move( m ), Task::Type::Cache );
 }
 
 bool CacheWorker::removeCached( std::shared_ptr<Media> m )
@@ -99,12 +136,17 @@ bool CacheWorker::removeCached( std::shared_ptr<Media> m )
         LOG_DEBUG( "Media ", m->id(), " is not cached" );
         return false;
     }
-    return queueTask( std::move( m ), false );
+    return queueTask( std::move( m ), Task::Type::Uncache );
 }
 
 void CacheWorker::cacheSubscriptions()
 {
-    queueTask( nullptr, true );
+    queueTask( nullptr, Task::Type::CacheSubscriptions );
+}
+
+bool CacheWorker::repairCache()
+{
+    return queueTask( nullptr, Task::Type::Repair );
 }
 
 void CacheWorker::pause()
@@ -123,6 +165,7 @@ void CacheWorker::resume()
 
 void CacheWorker::stop()
 {
+    m_scheduler.interrupt();
     if ( m_cacher != nullptr )
         m_cacher->interrupt();
 
@@ -155,7 +198,7 @@ uint64_t CacheWorker::availableSubscriptionCacheSize() const
 
 uint64_t CacheWorker::availableCacheSize() const
 {
-    auto usedSize = cacheSize();
+    auto usedSize = cacheSize() + m_reservedSize;
     auto totalSize = m_ml->settings().maxCacheSize();
     if ( usedSize > totalSize )
     {
@@ -170,15 +213,24 @@ void CacheWorker::run()
     auto cb = m_ml->getCb();
 
     LOG_DEBUG( "Starting cache worker" );
+    utils::SWMRLock::setThreadClient( LockClient::Cache );
     checkCache();
     while ( true )
     {
         Task t;
+        auto verify = false;
         {
             std::unique_lock<compat::Mutex> lock{ m_mutex };
             if ( m_run == false )
                 break;
-            if ( m_paused == true || m_tasks.empty() == true )
+            /*
+             * Comparing each committed file with the manifest requires probing
+             * all of them, so only do it once the pending tasks are served
+             */
+            if ( m_paused == false && m_tasks.empty() == true &&
+                 m_committedEntriesVerified == false )
+                verify = true;
+            else if ( m_paused == true || m_tasks.empty() == true )
             {
                 if ( cb != nullptr )
                     cb->onCacheIdleChanged( true );
@@ -193,15 +245,32 @@ void CacheWorker::run()
                     cb->onCacheIdleChanged( false );
             }
 
-            t = std::move( m_tasks.front() );
-            m_tasks.pop();
+            if ( verify == false )
+            {
+                t = std::move( m_tasks.front() );
+                m_tasks.pop();
+            }
+        }
+        if ( verify == true )
+        {
+            verifyCommittedEntries();
+            continue;
+        }
+        switch ( t.type )
+        {
+            case Task::Type::Cache:
+                doCache( std::move( t.m ), nullptr, File::CacheType::Manual );
+                break;
+            case Task::Type::Uncache:
+                doUncache( std::move( t.m ) );
+                break;
+            case Task::Type::CacheSubscriptions:
+                doSubscriptionCache();
+                break;
+            case Task::Type::Repair:
+                doRepairCache();
+                break;
         }
-        if ( t.m == nullptr )
-            doSubscriptionCache();
-        else if ( t.cache == true )
-            doCache( std::move( t.m ), nullptr, File::CacheType::Manual );
-        else
-            doUncache( std::move( t.m ) );
     }
     LOG_DEBUG( "Terminating cache worker" );
 }
@@ -209,32 +278,78 @@ void CacheWorker::run()
 uint64_t CacheWorker::doCache( std::shared_ptr<Media> m, Subscription* s,
                                IFile::CacheType cacheType )
 {
-    auto f = std::static_pointer_cast<File>( m->mainFile() );
+    auto f = prepareCache( *m, s, cacheType );
     if ( f == nullptr )
+        return 0;
+    auto fileName = f->cachedFileName();
+    auto cachedPath = m_ml->cachePath() + fileName;
+    if ( CacheManifest::insertPending( m_ml, fileName ) == false )
+        return 0;
+    if ( m_cacher->cache( f->mrl(), cachedPath ) == false )
     {
-        assert( !"No main file for the media" );
+        utils::fs::remove( cachedPath );
+        CacheManifest::remove( m_ml, fileName );
         return 0;
     }
+    return completeCache( *m, *f, cachedPath, cacheType );
+}
+
+std::shared_ptr<File> CacheWorker::prepareCache( Media& m, Subscription* s,
+                                                 IFile::CacheType cacheType )
+{
+    auto f = std::static_pointer_cast<File>( m.mainFile() );
+    if ( f == nullptr )
+    {
+        assert( !"No main file for the media" );
+        return nullptr;
+    }
     if ( f->type() == IFile::Type::Cache )
     {
         assert( !"Media was already cached" );
-        return 0;
+        return nullptr;
     }
     LOG_DEBUG( "Attempting to ", ( cacheType == IFile::CacheType::Automatic ?
                  "automatically" : "manually" ), " cache file at ", f->mrl() );
     if ( evictIfNeeded( *f, s, cacheType ) == false )
     {
         LOG_DEBUG( "Failed to evict media from cache, can't cache ", f->mrl() );
-        return 0;
+        return nullptr;
     }
-    auto cachedPath = m_ml->cachePath() + f->cachedFileName();
-    if ( m_cacher->cache( f->mrl(), cachedPath ) == false )
+    return f;
+}
+
+uint64_t CacheWorker::completeCache( Media& m, const File& f,
+                                     const std::string& cachedPath,
+                                     IFile::CacheType cacheType )
+{
+    uint64_t diskSize;
+    time_t lastModificationDate;
+    if ( utils::fs::fileInfo( cachedPath, diskSize, lastModificationDate ) == false )
+    {
+        LOG_ERROR( "Failed to probe cached file ", cachedPath );
         return 0;
-    auto fileSize = f->size();
-    if ( fileSize == 0 )
-        fileSize = utils::fs::fileSize( cachedPath );
-    m->cache( utils::file::toMrl( cachedPath ), cacheType, fileSize );
-    return f->size();
+    }
+    auto fileSize = f.size() > 0 ? static_cast<uint64_t>( f.size() ) : diskSize;
+    std::shared_ptr<File> cachedFile;
+    {
+        auto t = m_ml->getConn()->newTransaction();
+        if ( m.cache( utils::file::toMrl( cachedPath ), cacheType, fileSize ) == false )
+            return 0;
+        cachedFile = std::static_pointer_cast<File>( m.mainFile() );
+        assert( cachedFile->type() == IFile::Type::Cache );
+        if ( CacheManifest::commit( m_ml, utils::file::fileName( cachedPath ),
+                                    cachedFile->id(), diskSize,
+                                    lastModificationDate ) == false )
+            return 0;
+        t->commit();
+    }
+    m_evictor.insert( CacheEvictor::Entry{ cachedFile->id(), cachedFile->mrl(),
+                                           cachedFile->size(),
+                                           cachedFile->insertionDate(),
+                                           m.lastPlayedDate(), m.playCount(),
+                                           m.lastPosition() >= 0.f } );
+    m_cacheSize.fetch_add( cachedFile->size(), std::memory_order_acq_rel );
+    return cachedFile->size();
 }
 
 bool CacheWorker::removeFromCache( const std::string& mrl )
@@ -253,35 +368,177 @@ void CacheWorker::doUncache( std::shared_ptr<Media> m )
         return;
     }
     const auto& mrl = f->mrl();
+    auto fileName = CacheManifest::fileName( mrl );
+    if ( CacheManifest::setState( m_ml, fileName,
+                                  CacheManifest::State::Removing ) == false )
+        return;
     if ( removeFromCache( mrl ) == false )
+    {
+        CacheManifest::setState( m_ml, fileName, CacheManifest::State::Committed );
         return;
-    m->removeCached();
+    }
+    auto fileId = f->id();
+    auto fileSize = f->size();
+    {
+        auto t = m_ml->getConn()->newTransaction();
+        if ( m->removeCached() == false ||
+             CacheManifest::remove( m_ml, fileName ) == false )
+            return;
+        t->commit();
+    }
+    if ( m_evictor.remove( fileId ) == true )
+        m_cacheSize.fetch_sub( fileSize, std::memory_order_acq_rel );
 }
 
 void CacheWorker::doSubscriptionCache()
 {
     auto cb = m_ml->getCb();
     auto subscriptions = Subscription::fetchAll( m_ml );
+    std::unordered_map<int64_t, Subscription*> subscriptionsById;
+    std::unordered_map<int64_t, std::shared_ptr<Media>> media;
+    std::vector<CacheScheduler::Transfer> transfers;
     for ( auto& s : subscriptions )
     {
+        subscriptionsById.emplace( s->id(), s.get() );
         auto uncachedMedia = s->uncachedMedia( true );
+        for ( auto& m : uncachedMedia )
+        {
+            /* A media can belong to multiple subscriptions */
+            if ( media.find( m->id() ) != end( media ) )
+                continue;
+            auto f = std::static_pointer_cast<File>( m->mainFile() );
+            if ( f == nullptr )
+                continue;
+            transfers.push_back( CacheScheduler::Transfer{ s->id(), m->id(),
+                    f->mrl(), m_ml->cachePath() + f->cachedFileName(),
+                    static_cast<uint64_t>( f->size() ) } );
+            media.emplace( m->id(), std::move( m ) );
+        }
+    }
 
-        if ( uncachedMedia.empty() == false )
+    if ( m_partials.empty() == false )
+    {
+        /*
+         * The partial transfers of media which don't need to be cached anymore
+         * would otherwise never be resumed nor removed
+         */
+        std::unordered_set<std::string> resumable;
+        for ( const auto& s : subscriptions )
         {
-            for ( auto& m : uncachedMedia )
+            for ( const auto& m : s->uncachedMedia( false ) )
             {
-                doCache( m, s.get(), File::CacheType::Automatic );
+                auto f = std::static_pointer_cast<File>( m->mainFile() );
+                if ( f != nullptr )
+                    resumable.insert( f->cachedFileName() );
             }
-            if ( cb != nullptr )
-                cb->onSubscriptionCacheUpdated( s->id() );
         }
+        removeOrphanPartials( resumable );
+    }
+
+    std::unordered_set<int64_t> updatedSubscriptions;
+    m_scheduler.run( m_cacher, std::move( transfers ),
+        [this, &media, &subscriptionsById]( const CacheScheduler::Transfer& t ) {
+            auto& m = media.at( t.itemId );
+            auto fileName = utils::file::fileName( t.outputPath );
+            /* The partial file is now accounted for by the reserved size */
+            untrackPartial( fileName );
+            if ( prepareCache( *m, subscriptionsById.at( t.groupId ),
+                               File::CacheType::Automatic ) == nullptr ||
+                 CacheManifest::insertPending( m_ml, fileName ) == false )
+            {
+                trackPartial( fileName, t.outputPath );
+                return false;
+            }
+            /* Account for the ongoing transfers when checking the cache usage */
+            m_reservedSize += t.size;
+            auto& inFlight = m_inFlight[t.groupId];
+            inFlight.nbMedia++;
+            inFlight.size += t.size;
+            return true;
+        },
+        [this, &media, &updatedSubscriptions]( const CacheScheduler::Transfer& t,
+                                               bool success ) {
+            m_reservedSize -= t.size;
+            auto it = m_inFlight.find( t.groupId );
+            assert( it != end( m_inFlight ) );
+            it->second.nbMedia--;
+            it->second.size -= t.size;
+            if ( it->second.nbMedia == 0 )
+                m_inFlight.erase( it );
+            if ( success == false )
+            {
+                /* Keep track of the partial transfer so it can be resumed */
+                auto fileName = utils::file::fileName( t.outputPath );
+                if ( trackPartial( fileName, t.outputPath ) == false )
+                    CacheManifest::remove( m_ml, fileName );
+                return;
+            }
+            auto& m = media.at( t.itemId );
+            auto f = std::static_pointer_cast<File>( m->mainFile() );
+            if ( completeCache( *m, *f, t.outputPath,
+                                File::CacheType::Automatic ) > 0 )
+                updatedSubscriptions.insert( t.groupId );
+        });
+
+    for ( auto& s : subscriptions )
+    {
+        if ( cb != nullptr &&
+             updatedSubscriptions.find( s->id() ) != end( updatedSubscriptions ) )
+            cb->onSubscriptionCacheUpdated( s->id() );
         s->markCacheAsHandled();
     }
 }
 
+void CacheWorker::onPlayStateChanged( int64_t mediaId )
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    if ( m_historyCleared == false )
+        m_playStateChanged.insert( mediaId );
+}
+
+void CacheWorker::onHistoryCleared()
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    m_historyCleared = true;
+    m_playStateChanged.clear();
+}
+
+void CacheWorker::refreshPlayState()
+{
+    /* Pick up the play state changes since the last eviction pass */
+    std::unordered_set<int64_t> changed;
+    bool historyCleared;
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        std::swap( changed, m_playStateChanged );
+        historyCleared = m_historyCleared;
+        m_historyCleared = false;
+    }
+    if ( historyCleared == true )
+        m_evictor.refresh( CacheEvictor::fetchCachedFiles( m_ml ) );
+    else if ( changed.empty() == false )
+        m_evictor.refresh( CacheEvictor::fetchCachedFiles( m_ml, changed ) );
+}
+
+void CacheWorker::resetEvictor()
+{
+    /*
+     * Drop the pending play state changes first, so that the ones happening
+     * while the cached files are loaded are picked up by the next eviction
+     */
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_playStateChanged.clear();
+        m_historyCleared = false;
+    }
+    m_evictor.reset( CacheEvictor::fetchCachedFiles( m_ml ) );
+    m_cacheSize.fetch_add( m_evictor.totalSize(), std::memory_order_acq_rel );
+}
+
 bool CacheWorker::evictIfNeeded( const File& file, Subscription* s,
                                  IFile::CacheType cacheType )
 {
+    auto fileSize = file.size();
     if ( cacheType == File::CacheType::Automatic )
     {
         /* Automatic caching is only requested for subscription */
@@ -299,55 +556,212 @@ bool CacheWorker::evictIfNeeded( const File& file, Subscription* s,
         auto subCacheSize = s->cachedSize();
         auto maxSubCacheSize = s->maxCacheSize();
         auto nbCachedMediaInSub = s->cachedMedia( false )->count();
+        auto inFlight = m_inFlight.find( s->id() );
+        if ( inFlight != end( m_inFlight ) )
+        {
+            nbCachedMediaInSub += inFlight->second.nbMedia;
+            subCacheSize += inFlight->second.size;
+        }
         LOG_DEBUG( "Subscription #", s->id(), " has ", nbCachedMediaInSub,
                    "/", maxMedia, " cached media" );
-        while ( nbCachedMediaInSub >= static_cast<uint32_t>( maxMedia ) ||
-                ( maxSubCacheSize > 0 &&
-                  static_cast<uint64_t>( maxSubCacheSize ) >= subCacheSize ) )
+        uint32_t nbFilesToEvict = 0;
+        if ( nbCachedMediaInSub >= static_cast<uint32_t>( maxMedia ) )
+            nbFilesToEvict = nbCachedMediaInSub - maxMedia + 1;
+        uint64_t nbBytesToEvict = 0;
+        if ( maxSubCacheSize > 0 &&
+             subCacheSize + fileSize > static_cast<uint64_t>( maxSubCacheSize ) )
+            nbBytesToEvict = subCacheSize + fileSize - maxSubCacheSize;
+        if ( nbFilesToEvict > 0 || nbBytesToEvict > 0 )
         {
-            auto toEvict = s->cachedMedia( true )->items( 1, 0 );
-            if ( toEvict.size() != 1 )
-                return false;
-            auto f = toEvict[0]->mainFile();
-            if ( f->type() != File::Type::Cache )
+            refreshPlayState();
+            auto evictable = s->evictableCachedFiles();
+            std::vector<CacheEvictor::Entry> victims;
+            auto res = m_evictor.selectVictims( nbBytesToEvict, nbFilesToEvict,
+                [&evictable]( const CacheEvictor::Entry& e ) {
+                    return evictable.find( e.fileId ) != end( evictable );
+                }, victims );
+            if ( res == false )
             {
-                assert( !"Invalid file type" );
+                LOG_DEBUG( "Not enough evictable media in subscription #", s->id() );
                 return false;
             }
-            if ( removeFromCache( f->mrl() ) == false )
-                return false;
-            if ( toEvict[0]->removeCached() == false )
+            if ( evict( victims ) < nbBytesToEvict )
                 return false;
-            m_cacheSize.fetch_sub( f->size(), std::memory_order_acq_rel );
-            subCacheSize -= f->size();
         }
     }
-    auto fileSize = file.size();
-    auto evictionNeeded = fileSize > availableCacheSize();
-    if ( evictionNeeded == false )
+    auto availableSize = availableCacheSize();
+    if ( fileSize <= availableSize )
         return true;
 
-    auto cachedFiles = File::cachedFiles( m_ml );
-    auto cachedFilesIdx = 0;
-    assert( cachedFiles.empty() == false );
+    refreshPlayState();
+    std::vector<CacheEvictor::Entry> victims;
+    if ( m_evictor.selectVictims( fileSize - availableSize, 0, nullptr,
+                                  victims ) == false )
+        return false;
+    evict( victims );
+    return fileSize <= availableCacheSize();
+}
 
-    while ( evictionNeeded == true )
+uint64_t CacheWorker::evict( const std::vector<CacheEvictor::Entry>& victims )
+{
     {
-        auto f = std::move( cachedFiles[cachedFilesIdx] );
-        const auto& mrl = f->mrl();
-        if ( removeFromCache( mrl ) == false )
-            return false;
-        if ( cachedFiles[cachedFilesIdx]->destroy() == false )
-            return false;
-        m_cacheSize.fetch_sub( cachedFiles[cachedFilesIdx]->size(),
-                               std::memory_order_acq_rel );
-        evictionNeeded = fileSize > availableCacheSize();
+        auto t = m_ml->getConn()->newTransaction();
+        for ( const auto& v : victims )
+        {
+            if ( CacheManifest::setState( m_ml, CacheManifest::fileName( v.mrl ),
+                                          CacheManifest::State::Removing ) == false )
+                return 0;
+        }
+        t->commit();
     }
-    return true;
+    std::vector<const CacheEvictor::Entry*> removed;
+    removed.reserve( victims.size() );
+    for ( const auto& v : victims )
+    {
+        if ( removeFromCache( v.mrl ) == false )
+        {
+            LOG_WARN( "Failed to remove ", v.mrl, " from the cache" );
+            CacheManifest::setState( m_ml, CacheManifest::fileName( v.mrl ),
+                                     CacheManifest::State::Committed );
+            continue;
+        }
+        removed.push_back( &v );
+    }
+    if ( removed.empty() == true )
+        return 0;
+
+    {
+        auto t = m_ml->getConn()->newTransaction();
+        for ( const auto v : removed )
+        {
+            if ( CacheManifest::remove( m_ml, CacheManifest::fileName( v->mrl ) ) == false ||
+                 DatabaseHelpers<File>::destroy( m_ml, v->fileId ) == false )
+            {
+                LOG_ERROR( "Failed to remove evicted file #", v->fileId,
+                           " from the database" );
+                return 0;
+            }
+        }
+        t->commit();
+    }
+
+    uint64_t reclaimed = 0;
+    for ( const auto v : removed )
+    {
+        m_evictor.evicted( v->fileId );
+        m_cacheSize.fetch_sub( v->size, std::memory_order_acq_rel );
+        reclaimed += v->size;
+    }
+    LOG_INFO( "Evicted ", removed.size(), " file(s) from the cache, reclaimed ",
+              reclaimed, " bytes" );
+    return reclaimed;
 }
 
 void CacheWorker::checkCache()
 {
+    /*
+     * The manifest is updated along with the database, so only the entries
+     * left in an intermediate state need to be reconciled. The committed
+     * ones are probed later on by verifyCommittedEntries()
+     */
+    auto cachePath = m_ml->cachePath();
+    m_partials.clear();
+    m_cacheSize.store( 0, std::memory_order_release );
+    auto dirty = CacheManifest::fetchDirty( m_ml );
+    LOG_DEBUG( "Verifying ", dirty.size(), " cache manifest entries" );
+    for ( const auto& e : dirty )
+    {
+        auto path = cachePath + e.fileName;
+        switch ( e.state )
+        {
+            case CacheManifest::State::Pending:
+            {
+                /*
+                 * The transfer might have completed without being committed,
+                 * in which case the file won't be used.
+                 * Keep partial transfers around so they can be resumed.
+                 */
+                utils::fs::remove( path );
+                if ( trackPartial( e.fileName, path ) == true )
+                    continue;
+                break;
+            }
+            case CacheManifest::State::Removing:
+                if ( e.fileId != 0 &&
+                     DatabaseHelpers<File>::destroy( m_ml, e.fileId ) == false )
+                {
+                    LOG_WARN( "Failed to remove cached file #", e.fileId );
+                    continue;
+                }
+                /* fall-through */
+            case CacheManifest::State::Committed:
+                /* The file isn't linked to a cached File anymore */
+                LOG_DEBUG( "Removing stale file from cache: ", path );
+                utils::fs::remove( path );
+                break;
+        }
+        CacheManifest::remove( m_ml, e.fileName );
+    }
+
+    resetEvictor();
+}
+
+void CacheWorker::verifyCommittedEntries()
+{
+    LOG_DEBUG( "Comparing the cached files with the cache manifest" );
+    m_committedEntriesVerified = true;
+    auto cachePath = m_ml->cachePath();
+    auto entries = CacheManifest::fetchAll( m_ml );
+    for ( const auto& e : entries )
+    {
+        /* The pending entries left are the partial transfers */
+        if ( e.state != CacheManifest::State::Committed )
+            continue;
+        {
+            std::lock_guard<compat::Mutex> lock{ m_mutex };
+            if ( m_run == false )
+                return;
+        }
+        auto path = cachePath + e.fileName;
+        uint64_t size;
+        time_t lastModificationDate;
+        if ( utils::fs::fileInfo( path, size, lastModificationDate ) == true &&
+             matchesManifest( e, size, lastModificationDate ) == true )
+        {
+            if ( e.lastModificationDate == 0 )
+                CacheManifest::commit( m_ml, e.fileName, e.fileId, size,
+                                       lastModificationDate );
+            continue;
+        }
+        /*
+         * The file was removed, truncated or modified behind our back, so it
+         * can't be trusted anymore. Unflag it, the media will be cached again
+         * if needed.
+         */
+        LOG_WARN( "Cached file ", path, " doesn't match the cache manifest."
+                  " Removing it from the cache" );
+        auto t = m_ml->getConn()->newTransaction();
+        if ( DatabaseHelpers<File>::destroy( m_ml, e.fileId ) == false ||
+             CacheManifest::remove( m_ml, e.fileName ) == false )
+        {
+            LOG_WARN( "Failed to remove cached file #", e.fileId );
+            continue;
+        }
+        t->commit();
+        utils::fs::remove( path );
+        /* The evictor tracks the size of the file when it got cached */
+        auto trackedSize = m_evictor.totalSize();
+        if ( m_evictor.remove( e.fileId ) == true )
+            m_cacheSize.fetch_sub( trackedSize - m_evictor.totalSize(),
+                                   std::memory_order_acq_rel );
+    }
+}
+
+void CacheWorker::doRepairCache()
+{
+    LOG_INFO( "Repairing the cache" );
+    /* The repair compares all the cached files with the manifest */
+    m_committedEntriesVerified = true;
     auto cachePath = m_ml->cachePath();
     auto cacheMrl = utils::file::toMrl( cachePath );
     auto fsFactory = m_ml->fsFactoryForMrl( cacheMrl );
@@ -375,33 +789,53 @@ void CacheWorker::checkCache()
 
     // Fetch the known cached files from the DB
     auto cachedFiles = File::cachedFiles( m_ml );
+    // And what was recorded when they got cached
+    std::unordered_map<std::string, CacheManifest::Entry> manifest;
+    for ( auto& e : CacheManifest::fetchAll( m_ml ) )
+    {
+        auto fileName = e.fileName;
+        manifest.emplace( std::move( fileName ), std::move( e ) );
+    }
 
+    m_partials.clear();
     m_cacheSize.store( 0, std::memory_order_release );
-    for ( auto cachedIt = begin( cachedFiles ); cachedIt != end( cachedFiles ); )
+    auto t = m_ml->getConn()->newTransaction();
+    CacheManifest::clear( m_ml );
+    for ( const auto& cachedFile : cachedFiles )
     {
-        auto wantedFileName = utils::url::encode( (*cachedIt)->cachedFileName() );
-
-        auto it = std::lower_bound( begin( files ), end( files ), wantedFileName,
-                                 Comp{} );
-        if ( it != end( files ) )
+        auto fileName = CacheManifest::fileName( cachedFile->mrl() );
+        auto it = std::lower_bound( begin( files ), end( files ),
+                                    utils::url::encode( fileName ), Comp{} );
+        if ( it != end( files ) &&
+             (*it)->name() == utils::url::encode( fileName ) )
         {
-            if ( (*it)->name() == wantedFileName )
+            auto size = (*it)->size();
+            auto lastModificationDate = (*it)->lastModificationDate();
+            auto manifestIt = manifest.find( fileName );
+            if ( manifestIt == end( manifest ) ||
+                 matchesManifest( manifestIt->second, size,
+                                  lastModificationDate ) == true )
             {
-                /* The cached file was indeed found it cache, all is well */
-                auto fileSize = (*it)->size();
-                assert( fileSize != 0 );
-                m_cacheSize.fetch_add( fileSize, std::memory_order_acq_rel );
-
+                /* The cached file was indeed found in cache, all is well */
+                CacheManifest::commit( m_ml, fileName, cachedFile->id(),
+                                       size, lastModificationDate );
                 files.erase( it );
-                cachedIt = cachedFiles.erase( cachedIt );
                 continue;
             }
+            /*
+             * The file was modified since it was cached. Keep it in the files
+             * vector so it gets removed along with the stale files
+             */
+            LOG_DEBUG( "File ", cachedFile->rawMrl(), " doesn't match the cache "
+                       "manifest. Unflagging it." );
+        }
+        else
+        {
+            /* A file flagged as cached in DB was not found on disk, unflag it */
+            LOG_DEBUG( "File ", cachedFile->rawMrl(), " was flagged as cached but "
+                       "wasn't found on disk. Unflagging it." );
         }
-        /* A file flagged as cached in DB was not found on disk, unflag it */
-        LOG_DEBUG( "File ", (*cachedIt)->rawMrl(), " was flagged as cached but "
-                   "wasn't found on disk. Unflagging it." );
-        (*cachedIt)->destroy();
-        cachedIt = cachedFiles.erase( cachedIt );
+        cachedFile->destroy();
     }
     /*
      * Whatever remains in the files vector are files that were not flagged as cached
@@ -409,17 +843,86 @@ void CacheWorker::checkCache()
      * For now, take the easy way out and remove the cached version without touching
      * the database, but ideally we should flag the file as cached
      */
+    const auto partialExt = CacheScheduler::partialPath( "" );
     for ( const auto& f : files )
     {
+        /* Keep the partial transfers around so they can be resumed */
+        auto name = utils::url::decode( f->name() );
+        if ( name.size() > partialExt.size() &&
+             name.compare( name.size() - partialExt.size(), partialExt.size(),
+                           partialExt ) == 0 )
+        {
+            auto fileName = name.substr( 0, name.size() - partialExt.size() );
+            if ( trackPartial( fileName, cachePath + fileName ) == true )
+                CacheManifest::insertPending( m_ml, fileName );
+            continue;
+        }
         auto path = utils::url::toLocalPath( f->mrl() );
         LOG_DEBUG( "Removing stale file from cache: ", path );
         utils::fs::remove( path );
     }
+    t->commit();
+
+    resetEvictor();
+}
+
+bool CacheWorker::trackPartial( const std::string& fileName,
+                                const std::string& outputPath )
+{
+    auto partialPath = CacheScheduler::partialPath( outputPath );
+    if ( m_cacher == nullptr || m_cacher->canResume() == false )
+    {
+        /* The transfer would start over, so don't keep the partial file around */
+        utils::fs::remove( partialPath );
+        return false;
+    }
+    uint64_t size;
+    time_t lastModificationDate;
+    if ( utils::fs::fileInfo( partialPath, size, lastModificationDate ) == false )
+        return false;
+    auto& partialSize = m_partials[fileName];
+    m_cacheSize.fetch_sub( partialSize, std::memory_order_acq_rel );
+    m_cacheSize.fetch_add( size, std::memory_order_acq_rel );
+    partialSize = size;
+    return true;
+}
+
+void CacheWorker::untrackPartial( const std::string& fileName )
+{
+    auto it = m_partials.find( fileName );
+    if ( it == end( m_partials ) )
+        return;
+    m_cacheSize.fetch_sub( it->second, std::memory_order_acq_rel );
+    m_partials.erase( it );
+}
+
+void CacheWorker::removeOrphanPartials( const std::unordered_set<std::string>& resumable )
+{
+    auto cachePath = m_ml->cachePath();
+    for ( auto it = begin( m_partials ); it != end( m_partials ); )
+    {
+        if ( resumable.find( it->first ) != end( resumable ) )
+        {
+            ++it;
+            continue;
+        }
+        auto path = CacheScheduler::partialPath( cachePath + it->first );
+        LOG_DEBUG( "Removing orphan partial transfer ", path );
+        if ( utils::fs::remove( path ) == false ||
+             CacheManifest::remove( m_ml, it->first ) == false )
+        {
+            LOG_WARN( "Failed to remove partial transfer ", path );
+            ++it;
+            continue;
+        }
+        m_cacheSize.fetch_sub( it->second, std::memory_order_acq_rel );
+        it = m_partials.erase( it );
+    }
 }
 
-CacheWorker::Task::Task( std::shared_ptr<Media> m, bool c )
+CacheWorker::Task::Task( std::shared_ptr<Media> m, Type t )
     : m( std::move( m ) )
-    , cache( c )
+    , type( t )
 {
 }
 
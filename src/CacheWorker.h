@@ -28,9 +28,13 @@
 #include "compat/Mutex.h"
 #include "compat/ConditionVariable.h"
 #include "medialibrary/IFile.h"
+#include "CacheEvictor.h"
+#include "CacheScheduler.h"
 
 #include <queue>
 #include <atomic>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace medialibrary
 {
@@ -46,19 +50,51 @@ class CacheWorker
 private:
     struct Task
     {
+        enum class Type : uint8_t
+        {
+            Cache,
+            Uncache,
+            CacheSubscriptions,
+            Repair,
+        };
         Task() = default;
-        Task( std::shared_ptr<Media> m, bool c );
-        std::shared_ptr<Media> m; // If nullptr, we're caching all subscriptions
-        bool cache; // true if we're caching, false if we're uncaching
+        Task( std::shared_ptr<Media> m, Type t );
+        std::shared_ptr<Media> m; // Only provided for Cache & Uncache tasks
+        Type type;
     };
 
 public:
     CacheWorker( MediaLibrary* ml );
     ~CacheWorker();
     void setCacher( std::shared_ptr<ICacher> cacher );
+    void setEvictionPolicy( CacheEvictionPolicy policy );
+    void setTransferLimits( uint32_t maxTransfers, uint64_t maxBytesPerSec );
     bool cacheMedia( std::shared_ptr<Media> m );
     bool removeCached( std::shared_ptr<Media> m );
     void cacheSubscriptions();
+    /**
+     * @brief onPlayStateChanged Flags a media which play state changed
+     *
+     * Its cached file, if any, will be moved in the eviction queue before the
+     * next eviction, without reloading all the cached files.
+     */
+    void onPlayStateChanged( int64_t mediaId );
+    /**
+     * @brief onHistoryCleared Flags all the cached files as needing to be
+     *        moved in the eviction queue
+     */
+    void onHistoryCleared();
+    /**
+     * @brief repairCache Verifies the entire cache folder against the database
+     *
+     * On startup, only the cache entries which were left in an intermediate
+     * state are verified, and the committed files are compared with their
+     * manifest entry once the pending tasks are served. This will list the
+     * cache folder, compare each cached file and rebuild the
+     * cache manifest, which is only needed if the cache folder was tampered
+     * with.
+     */
+    bool repairCache();
     void pause();
     void resume();
     void stop();
@@ -68,12 +104,24 @@ private:
     void run();
     uint64_t doCache( std::shared_ptr<Media> m, Subscription* s,
                       IFile::CacheType cacheType );
+    std::shared_ptr<File> prepareCache( Media& m, Subscription* s,
+                                        IFile::CacheType cacheType );
+    uint64_t completeCache( Media& m, const File& f, const std::string& cachedPath,
+                            IFile::CacheType cacheType );
     void doUncache( std::shared_ptr<Media> m );
     void doSubscriptionCache();
     void checkCache();
+    void verifyCommittedEntries();
+    void doRepairCache();
+    bool trackPartial( const std::string& fileName, const std::string& outputPath );
+    void untrackPartial( const std::string& fileName );
+    void removeOrphanPartials( const std::unordered_set<std::string>& resumable );
     bool removeFromCache( const std::string& mrl );
     bool evictIfNeeded( const File& file, Subscription* s, IFile::CacheType cacheType );
-    bool queueTask( std::shared_ptr<Media> m, bool cache );
+    void refreshPlayState();
+    void resetEvictor();
+    uint64_t evict( const std::vector<CacheEvictor::Entry>& victims );
+    bool queueTask( std::shared_ptr<Media> m, Task::Type type );
     uint64_t availableSubscriptionCacheSize() const;
     uint64_t availableCacheSize() const;
 
@@ -86,6 +134,33 @@ private:
     bool m_paused;
     bool m_run;
     std::shared_ptr<ICacher> m_cacher;
+    /* Only accessed from the worker thread once it's started */
+    CacheEvictor m_evictor;
+    CacheScheduler m_scheduler;
+    struct InFlight
+    {
+        uint32_t nbMedia;
+        uint64_t size;
+    };
+    /* The ongoing subscription transfers, per subscription */
+    std::unordered_map<int64_t, InFlight> m_inFlight;
+    uint64_t m_reservedSize;
+    /*
+     * The interrupted transfers which can be resumed, and their size on disk.
+     * They are accounted for in the cache size until they are resumed.
+     */
+    std::unordered_map<std::string, uint64_t> m_partials;
+    /*
+     * The media which play state changed since the last eviction, or true if
+     * all of them need to be refreshed. Protected by m_mutex.
+     */
+    std::unordered_set<int64_t> m_playStateChanged;
+    bool m_historyCleared;
+    /*
+     * false until the committed files were compared with the manifest. Only
+     * accessed from the worker thread.
+     */
+    bool m_committedEntriesVerified;
 
     std::atomic_uint64_t m_cacheSize;
 };
@@ -105,8 +105,8 @@ std::shared_ptr<Chapter> Chapter::create( MediaLibraryPtr ml, int64_t offset,
                                           int64_t duration, std::string name,
                                           int64_t mediaId )
 {
-    static const std::string req = "INSERT INTO " + Table::Name +
-            "(offset, duration, name, media_id) VALUES(?, ?, ?, ?)";
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name +
+            "(offset, duration, name, media_id) VALUES(?, ?, ?, ?)" };
     auto self = std::make_shared<Chapter>( ml, offset, duration,
                                            std::move( name ) );
     if ( insert( ml, self, req, offset, duration, self->m_name, mediaId ) == false )
@@ -96,8 +96,8 @@ void Device::setPresent(bool value)
         return;
     }
     assert( m_isPresent != value );
-    static const std::string req = "UPDATE " + Device::Table::Name +
-            " SET is_present = ? WHERE id_device = ?";
+    static const sqlite::Request req{ "UPDATE " + Device::Table::Name +
+            " SET is_present = ? WHERE id_device = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, value, m_id ) == false )
         return;
     m_isPresent = value;
@@ -136,8 +136,8 @@ bool Device::addMountpoint( const std::string& mrl, int64_t seenDate )
     assert( m_isRemovable == true );
     assert( m_isNetwork == true );
     assert( utils::url::schemeIs( m_scheme, mrl ) == true );
-    static const std::string req = "INSERT INTO " + MountpointTable::Name +
-            " VALUES(?, ?, ?)";
+    static const sqlite::Request req{ "INSERT INTO " + MountpointTable::Name +
+            " VALUES(?, ?, ?)" };
     return sqlite::Tools::executeInsert( m_ml->getConn(), req, m_id,
                                          utils::file::toFolderPath( mrl ),
                                          seenDate ) != 0;
@@ -147,9 +147,9 @@ std::shared_ptr<Device> Device::create( MediaLibraryPtr ml, std::string uuid,
                                         std::string scheme, bool isRemovable,
                                         bool isNetwork )
 {
-    static const std::string req = "INSERT INTO " + Device::Table::Name
+    static const sqlite::Request req{ "INSERT INTO " + Device::Table::Name
             + "(uuid, scheme, is_removable, is_present, is_network, last_seen) "
-            "VALUES(?, ?, ?, ?, ?, ?)";
+            "VALUES(?, ?, ?, ?, ?, ?)" };
     auto lastSeen = isRemovable ? std::chrono::duration_cast<std::chrono::seconds>(
         std::chrono::system_clock::now().time_since_epoch()
     ).count() : 0;
@@ -236,15 +236,15 @@ bool Device::checkDbModel( MediaLibraryPtr ml )
 std::shared_ptr<Device> Device::fromUuid( MediaLibraryPtr ml, const std::string& uuid,
                                           const std::string& scheme )
 {
-    static const std::string req = "SELECT * FROM " + Device::Table::Name +
-            " WHERE uuid = ? AND scheme = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + Device::Table::Name +
+            " WHERE uuid = ? AND scheme = ?" };
     return fetch( ml, req, uuid, scheme );
 }
 
 void Device::removeOldDevices( MediaLibraryPtr ml, std::chrono::seconds maxLifeTime )
 {
-    static const std::string req = "DELETE FROM " + Device::Table::Name + " "
-            "WHERE last_seen < ? AND is_removable != 0";
+    static const sqlite::Request req{ "DELETE FROM " + Device::Table::Name + " "
+            "WHERE last_seen < ? AND is_removable != 0" };
     auto deadline = std::chrono::duration_cast<std::chrono::seconds>(
                 (std::chrono::system_clock::now() - maxLifeTime).time_since_epoch() );
     if ( sqlite::Tools::executeDelete( ml->getConn(), req,
@@ -255,7 +255,7 @@ void Device::removeOldDevices( MediaLibraryPtr ml, std::chrono::seconds maxLifeT
 std::vector<std::shared_ptr<Device>> Device::fetchByScheme( MediaLibraryPtr ml,
                                                             const std::string& scheme )
 {
-    static const std::string req = "SELECT * FROM " + Table::Name + " WHERE scheme = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + Table::Name + " WHERE scheme = ?" };
     return fetchAll<Device>( ml, req, scheme );
 }
 
@@ -311,8 +311,8 @@ Device::fromMountpoint( MediaLibraryPtr ml, const std::string& mrl )
 
 std::string Device::cachedMountpoint() const
 {
-    static const std::string req = "SELECT mrl FROM " +
-        MountpointTable::Name + " WHERE device_id = ? ORDER BY last_seen DESC";
+    static const sqlite::Request req{ "SELECT mrl FROM " +
+        MountpointTable::Name + " WHERE device_id = ? ORDER BY last_seen DESC" };
     auto dbConn = m_ml->getConn();
     auto ctx = dbConn->acquireReadContext();
     sqlite::Statement stmt{ ctx.handle(), req };
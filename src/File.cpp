@@ -156,8 +156,8 @@ void File::setMrl( std::string mrl )
 
 bool File::setMrl( MediaLibraryPtr ml, const std::string& mrl, int64_t fileId )
 {
-    const static std::string req = "UPDATE " + File::Table::Name + " SET "
-            "mrl = ? WHERE id_file = ?";
+    static const sqlite::Request req{ "UPDATE " + File::Table::Name + " SET "
+            "mrl = ? WHERE id_file = ?" };
     return sqlite::Tools::executeUpdate( ml->getConn(), req, mrl, fileId );
 }
 
@@ -468,10 +468,10 @@ std::shared_ptr<File> File::createFromMedia( MediaLibraryPtr ml, int64_t mediaId
     assert( mediaId > 0 );
     auto self = std::make_shared<File>( ml, mediaId, 0, type, fileFs, folderId,
                                         isRemovable, insertionDate );
-    static const std::string req = "INSERT INTO " + File::Table::Name +
+    static const sqlite::Request req{ "INSERT INTO " + File::Table::Name +
             "(media_id, mrl, type, folder_id, last_modification_date, size, "
             "is_removable, is_external, is_network, insertion_date) "
-            "VALUES(?, ?, ?, ?, ?, ?, ?, 0, ?, ?)";
+            "VALUES(?, ?, ?, ?, ?, ?, ?, 0, ?, ?)" };
 
     if ( insert( ml, self, req, mediaId, self->m_mrl, type, sqlite::ForeignKey( folderId ),
                          self->m_lastModificationDate, self->m_size, isRemovable,
@@ -488,18 +488,18 @@ std::shared_ptr<File> File::createFromExternalMedia( MediaLibraryPtr ml, int64_t
     assert( mediaId > 0 );
     // Sqlite won't ensure uniqueness for (folder_id, mrl) when folder_id is null, so we have to ensure
     // of it ourselves
-    static const std::string existingReq = "SELECT * FROM " + File::Table::Name +
-            " WHERE folder_id IS NULL AND mrl = ?";
+    static const sqlite::Request existingReq{ "SELECT * FROM " + File::Table::Name +
+            " WHERE folder_id IS NULL AND mrl = ?" };
     auto existing = fetch( ml, existingReq, mrl );
     if ( existing != nullptr )
         return nullptr;
 
     auto self = std::make_shared<File>( ml, mediaId, 0, 0, type, mrl, fileSize,
                                         insertionDate, CacheType::Uncached );
-    static const std::string req = "INSERT INTO " + File::Table::Name +
+    static const sqlite::Request req{ "INSERT INTO " + File::Table::Name +
             "(media_id, mrl, type, size, folder_id, is_removable, is_external,"
             "is_network, subscription_id, insertion_date) "
-            "VALUES(?, ?, ?, ?, NULL, 0, 1, ?, ?, ?)";
+            "VALUES(?, ?, ?, ?, NULL, 0, 1, ?, ?, ?)" };
 
     if ( insert( ml, self, req, mediaId, mrl, type, fileSize,
                  self->m_isNetwork, nullptr, insertionDate ) == false )
@@ -517,10 +517,10 @@ std::shared_ptr<File> File::createForCache( MediaLibraryPtr ml, int64_t mediaId,
     assert( mediaId > 0 );
     auto self = std::make_shared<File>( ml, mediaId, 0, 0, Type::Cache, mrl,
                                         fileSize, insertionDate, cacheType );
-    static const std::string req = "INSERT INTO " + File::Table::Name +
+    static const sqlite::Request req{ "INSERT INTO " + File::Table::Name +
             "(media_id, mrl, type, size, folder_id, is_removable, is_external,"
             "is_network, insertion_date, cache_type) "
-            "VALUES(?, ?, ?, ?, NULL, 0, 1, 0, ?, ?)";
+            "VALUES(?, ?, ?, ?, NULL, 0, 1, 0, ?, ?)" };
 
     if ( insert( ml, self, req, mediaId, mrl, self->m_type, fileSize,
                  insertionDate, cacheType ) == false )
@@ -537,10 +537,10 @@ std::shared_ptr<File> File::createFromPlaylist( MediaLibraryPtr ml, int64_t play
     const auto type = IFile::Type::Playlist;
     auto self = std::make_shared<File>( ml, 0, playlistId, type , fileFs, folderId,
                                         isRemovable, insertionDate );
-    static const std::string req = "INSERT INTO " + File::Table::Name +
+    static const sqlite::Request req{ "INSERT INTO " + File::Table::Name +
             "(playlist_id, mrl, type, folder_id, last_modification_date, size, "
             "is_removable, is_external, is_network, insertion_date) "
-            "VALUES(?, ?, ?, ?, ?, ?, ?, 0, ?, ?)";
+            "VALUES(?, ?, ?, ?, ?, ?, ?, 0, ?, ?)" };
 
     if ( insert( ml, self, req, playlistId, self->m_mrl, type, sqlite::ForeignKey( folderId ),
                  self->m_lastModificationDate, self->m_size, isRemovable,
@@ -584,8 +584,8 @@ bool File::exists( MediaLibraryPtr ml, const std::string& mrl )
 std::shared_ptr<File> File::fromMrl( MediaLibraryPtr ml, const std::string& mrl )
 {
     /* Be optimistic and attempt to fetch a non-removable file first */
-    static const std::string req = "SELECT * FROM " + File::Table::Name +
-            " WHERE mrl = ? AND folder_id IS NOT NULL";
+    static const sqlite::Request req{ "SELECT * FROM " + File::Table::Name +
+            " WHERE mrl = ? AND folder_id IS NOT NULL" };
     auto file = fetch( ml, req, mrl );
     if ( file != nullptr )
     {
@@ -616,8 +616,8 @@ std::shared_ptr<File> File::fromMrl( MediaLibraryPtr ml, const std::string& mrl
 std::shared_ptr<File> File::fromFileName( MediaLibraryPtr ml, const std::string& fileName,
                                           int64_t folderId )
 {
-    static const std::string req = "SELECT * FROM " + File::Table::Name +
-            " WHERE mrl = ? AND folder_id = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + File::Table::Name +
+            " WHERE mrl = ? AND folder_id = ?" };
     auto file = fetch( ml, req, fileName, folderId );
     if ( file == nullptr )
         return nullptr;
@@ -636,8 +636,8 @@ std::shared_ptr<File> File::fromExternalMrl( MediaLibraryPtr ml, const std::stri
     {
         return nullptr;
     }
-    static const std::string req = "SELECT * FROM " + File::Table::Name +
-            " WHERE mrl = ? AND folder_id IS NULL";
+    static const sqlite::Request req{ "SELECT * FROM " + File::Table::Name +
+            " WHERE mrl = ? AND folder_id IS NULL" };
     auto file = fetch( ml, req, mrl );
     if ( file == nullptr )
         return nullptr;
@@ -648,8 +648,8 @@ std::shared_ptr<File> File::fromExternalMrl( MediaLibraryPtr ml, const std::stri
 std::vector<std::shared_ptr<File>> File::fromParentFolder( MediaLibraryPtr ml,
                                                            int64_t parentFolderId )
 {
-    static const std::string req = "SELECT * FROM " + File::Table::Name
-            + " WHERE folder_id = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + File::Table::Name
+            + " WHERE folder_id = ?" };
     return File::fetchAll<File>( ml, req, parentFolderId );
 }
 
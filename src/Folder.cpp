@@ -568,8 +568,8 @@ std::shared_ptr<Folder> Folder::create( MediaLibraryPtr ml, const std::string& m
         path = mrl;
     auto self = std::make_shared<Folder>( ml, std::move( path ), std::move( name ),
                                           parentId, device.id(), deviceFs.isRemovable() );
-    static const std::string req = "INSERT INTO " + Folder::Table::Name +
-            "(path, name, parent_id, device_id, is_removable, is_public) VALUES(?, ?, ?, ?, ?, ?)";
+    static const sqlite::Request req{ "INSERT INTO " + Folder::Table::Name +
+            "(path, name, parent_id, device_id, is_removable, is_public) VALUES(?, ?, ?, ?, ?, ?)" };
     if ( insert( ml, self, req, self->m_path, self->m_name, sqlite::ForeignKey( parentId ),
                  device.id(), deviceFs.isRemovable(), self->m_isPublic ) == false )
         return nullptr;
@@ -624,9 +624,9 @@ bool Folder::ban( MediaLibraryPtr ml, const std::string& mrl )
         path = deviceFs->relativeMrl( mrl );
     else
         path = mrl;
-    static const std::string req = "INSERT INTO " + Folder::Table::Name +
+    static const sqlite::Request req{ "INSERT INTO " + Folder::Table::Name +
             "(path, parent_id, is_banned, device_id, is_removable, is_public) "
-            "VALUES(?, ?, ?, ?, ?, FALSE)";
+            "VALUES(?, ?, ?, ?, ?, FALSE)" };
     auto res = sqlite::Tools::executeInsert( ml->getConn(), req, path,
                                              nullptr, true, device->id(),
                                              deviceFs->isRemovable() ) != 0;
@@ -1041,8 +1041,8 @@ void Folder::setMrl( std::string mrl )
 {
     if ( m_path == mrl )
         return;
-    static const std::string req = "UPDATE " + Folder::Table::Name + " SET "
-            "path = ? WHERE id_folder = ?";
+    static const sqlite::Request req{ "UPDATE " + Folder::Table::Name + " SET "
+            "path = ? WHERE id_folder = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, mrl, m_id ) == false )
         return;
     // We shouldn't use this if any full path/mrl has been cached.
@@ -1054,16 +1054,16 @@ void Folder::setMrl( std::string mrl )
 
 std::vector<std::shared_ptr<File>> Folder::files()
 {
-    static const std::string req = "SELECT * FROM " + File::Table::Name +
-        " WHERE folder_id = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + File::Table::Name +
+        " WHERE folder_id = ?" };
     return File::fetchAll<File>( m_ml, req, m_id );
 }
 
 std::vector<std::shared_ptr<Folder>> Folder::folders()
 {
-    static const std::string req = "SELECT f.* FROM " + Folder::Table::Name + " f "
+    static const sqlite::Request req{ "SELECT f.* FROM " + Folder::Table::Name + " f "
             " LEFT JOIN " + Device::Table::Name + " d ON d.id_device = f.device_id"
-            " WHERE parent_id = ? AND is_banned = 0 AND d.is_present != 0";
+            " WHERE parent_id = ? AND is_banned = 0 AND d.is_present != 0" };
     return DatabaseHelpers::fetchAll<Folder>( m_ml, req, m_id );
 }
 
@@ -1164,7 +1164,7 @@ bool Folder::isFavorite() const
 
 bool Folder::setFavorite( bool favorite )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_folder = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_folder = ?" };
     if ( m_isFavorite == favorite )
         return true;
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, favorite, m_id ) == false )
@@ -1175,9 +1175,9 @@ bool Folder::setFavorite( bool favorite )
 
 std::vector<std::shared_ptr<Folder>> Folder::fetchRootFolders( MediaLibraryPtr ml )
 {
-    static const std::string req = "SELECT f.* FROM " + Folder::Table::Name + " f "
+    static const sqlite::Request req{ "SELECT f.* FROM " + Folder::Table::Name + " f "
             " LEFT JOIN " + Device::Table::Name + " d ON d.id_device = f.device_id"
-            " WHERE f.parent_id IS NULL AND f.is_banned = 0 AND d.is_present != 0";
+            " WHERE f.parent_id IS NULL AND f.is_banned = 0 AND d.is_present != 0" };
     return DatabaseHelpers::fetchAll<Folder>( ml, req );
 }
 
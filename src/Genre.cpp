@@ -29,6 +29,7 @@
 #include "Album.h"
 #include "Artist.h"
 #include "Media.h"
+#include "MediaAggregate.h"
 #include "database/SqliteQuery.h"
 #include "utils/Enums.h"
 #include "utils/ModificationsNotifier.h"
@@ -106,7 +107,7 @@ bool Genre::isFavorite() const
 
 bool Genre::setFavorite( bool favorite )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_genre = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_genre = ?" };
     if ( m_isFavorite == favorite )
         return true;
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, favorite, m_id ) == false )
@@ -157,6 +158,14 @@ const std::string&Genre::thumbnailMrl( ThumbnailSizeType sizeType ) const
     return t->mrl();
 }
 
+ThumbnailData Genre::thumbnailData( ThumbnailSizeType sizeType ) const
+{
+    const auto t = thumbnail( sizeType );
+    if ( t == nullptr )
+        return {};
+    return t->packedData();
+}
+
 bool Genre::hasThumbnail( ThumbnailSizeType sizeType ) const
 {
     if ( m_thumbnails[Thumbnail::SizeToInt( sizeType )] != nullptr )
@@ -469,8 +478,8 @@ bool Genre::checkDbModel(MediaLibraryPtr ml)
 
 std::shared_ptr<Genre> Genre::create( MediaLibraryPtr ml, std::string name )
 {
-    static const std::string req = "INSERT INTO " + Table::Name + "(name)"
-            "VALUES(?)";
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name + "(name)"
+            "VALUES(?)" };
     auto self = std::make_shared<Genre>( ml, std::move( name ) );
     if ( insert( ml, self, req, self->m_name ) == false )
         return nullptr;
@@ -479,10 +488,18 @@ std::shared_ptr<Genre> Genre::create( MediaLibraryPtr ml, std::string name )
 
 std::shared_ptr<Genre> Genre::fromName( MediaLibraryPtr ml, const std::string& name )
 {
-    static const std::string req = "SELECT * FROM " + Table::Name + " WHERE name = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + Table::Name + " WHERE name = ?" };
     return fetch( ml, req, name );
 }
 
+std::string Genre::addRequestJoin( const QueryParameters* params )
+{
+    if ( params == nullptr || params->publicOnly == false )
+        return "";
+    return MediaAggregate::publicJoin( MediaAggregate::EntityType::Genre,
+                                       Table::Name + ".id_genre" );
+}
+
 std::string Genre::addRequestConditions( const QueryParameters* params )
 {
     if ( params == nullptr )
@@ -490,8 +507,7 @@ std::string Genre::addRequestConditions( const QueryParameters* params )
 
     std::string req;
     if ( params->publicOnly == true )
-        req = " EXISTS(SELECT genre_id FROM " + Media::Table::Name +
-              " WHERE genre_id = id_genre AND is_public != 0)";
+        req = MediaAggregate::publicCondition( params );
 
     if ( params->favoriteOnly == true )
     {
@@ -506,7 +522,9 @@ std::string Genre::addRequestConditions( const QueryParameters* params )
 Query<IGenre> Genre::search( MediaLibraryPtr ml, const std::string& name,
                              const QueryParameters* params )
 {
-    std::string req = "FROM " + Table::Name + " WHERE id_genre IN "
+    std::string req = "FROM " + Table::Name;
+    req += addRequestJoin( params );
+    req += " WHERE id_genre IN "
             "(SELECT rowid FROM " + FtsTable::Name + " "
             "WHERE name MATCH ?)";
 
@@ -522,14 +540,17 @@ Query<IGenre> Genre::search( MediaLibraryPtr ml, const std::string& name,
         if ( params->desc == true )
             orderBy += " DESC";
     }
-    return make_query<Genre, IGenre>( ml, "*", std::move( req ),
+    const auto publicOnly = params != nullptr && params->publicOnly;
+    return make_query<Genre, IGenre>( ml, Table::Name + ".*", std::move( req ),
                                       std::move( orderBy ),
-                                      sqlite::Tools::sanitizePattern( name ) ).build();
+                                      sqlite::Tools::sanitizePattern( name ) )
+            .markPublic( publicOnly ).build();
 }
 
 Query<IGenre> Genre::listAll( MediaLibraryPtr ml, const QueryParameters* params )
 {
     std::string req = "FROM " + Table::Name;
+    req += addRequestJoin( params );
 
     const auto cond = addRequestConditions( params );
     if ( cond.empty() == false )
@@ -545,7 +566,7 @@ Query<IGenre> Genre::listAll( MediaLibraryPtr ml, const QueryParameters* params
     }
 
     const bool publicOnly = params != nullptr && params->publicOnly == true;
-    return make_query<Genre, IGenre>( ml, "*", std::move( req ),
+    return make_query<Genre, IGenre>( ml, Table::Name + ".*", std::move( req ),
                                       std::move( orderBy ) )
             .markPublic( publicOnly ).build();
 }
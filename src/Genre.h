@@ -75,6 +75,7 @@ public:
                                         const QueryParameters* params = nullptr ) const override;
 
     virtual const std::string& thumbnailMrl( ThumbnailSizeType sizeType ) const override;
+    virtual ThumbnailData thumbnailData( ThumbnailSizeType sizeType ) const override;
     virtual bool hasThumbnail( ThumbnailSizeType sizeType ) const override;
     virtual bool setThumbnail( const std::string& mrl, ThumbnailSizeType sizeType,
                                bool takeOwnership ) override;
@@ -93,6 +94,7 @@ public:
 
 private:
     static bool shouldUpdateThumbnail( const Thumbnail& oldThumbnail );
+    static std::string addRequestJoin( const QueryParameters* params );
     static std::string addRequestConditions( const QueryParameters* params );
 
   private:
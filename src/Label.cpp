@@ -77,7 +77,7 @@ Query<IMedia> Label::media()
 LabelPtr Label::create( MediaLibraryPtr ml, const std::string& name )
 {
     auto self = std::make_shared<Label>( ml, name );
-    const char* req = "INSERT INTO Label VALUES(NULL, ?)";
+    static const sqlite::Request req{ "INSERT INTO Label VALUES(NULL, ?)" };
     if ( insert( ml, self, req, self->m_name ) == false )
         return nullptr;
     return self;
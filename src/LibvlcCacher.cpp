@@ -32,11 +32,13 @@
 
 #include <vlcpp/vlc.hpp>
 
+#include <algorithm>
+
 namespace medialibrary
 {
 
 LibvlcCacher::LibvlcCacher()
-    : m_currentMp( nullptr )
+    : m_interrupted( false )
 {
 }
 
@@ -58,26 +60,28 @@ bool LibvlcCacher::cache( const std::string& inputMrl,
 #endif
 
     std::unique_lock<compat::Mutex> lock{ m_mutex };
-    m_currentMp = &mp;
+    if ( m_interrupted == true )
+        return false;
+    m_players.push_back( &mp );
     auto done = false;
     auto success = false;
 
-    auto d = utils::make_defer([this]() {
+    auto d = utils::make_defer([this, &mp]() {
         /* /!\ The lock is already held /!\ */
-        stop();
-        m_currentMp = nullptr;
+        stop( mp );
+        m_players.erase( std::find( begin( m_players ), end( m_players ), &mp ) );
     });
     auto em = mp.eventManager();
     em.onStopped([this, &done, &success](){
         std::unique_lock<compat::Mutex> lock{ m_mutex };
         done = true;
         success = true;
-        m_cond.notify_one();
+        m_cond.notify_all();
     });
     em.onEncounteredError([this, &done](){
         std::unique_lock<compat::Mutex> lock{ m_mutex };
         done = true;
-        m_cond.notify_one();
+        m_cond.notify_all();
     });
 
     mp.play();
@@ -92,19 +96,23 @@ bool LibvlcCacher::cache( const std::string& inputMrl,
 void LibvlcCacher::interrupt()
 {
     std::lock_guard<compat::Mutex> lock{ m_mutex };
-    stop();
+    m_interrupted = true;
+    for ( auto mp : m_players )
+        stop( *mp );
+}
+
+bool LibvlcCacher::canCacheConcurrently() const
+{
+    return true;
 }
 
-void LibvlcCacher::stop()
+void LibvlcCacher::stop( VLC::MediaPlayer& mp )
 {
-    if ( m_currentMp != nullptr )
-    {
 #if LIBVLC_VERSION_INT >= LIBVLC_VERSION(4, 0, 0, 0)
-        m_currentMp->stopAsync();
+    mp.stopAsync();
 #else
-        m_currentMp->stop();
+    mp.stop();
 #endif
-    }
 }
 
 }
@@ -26,6 +26,8 @@
 #include "compat/Mutex.h"
 #include "compat/ConditionVariable.h"
 
+#include <vector>
+
 namespace VLC
 {
 class MediaPlayer;
@@ -34,6 +36,11 @@ class MediaPlayer;
 namespace medialibrary
 {
 
+/*
+ * The dump demuxer can only restart the input from its beginning, so this
+ * cacher doesn't support resuming and relies on ICacher::canResume() returning
+ * false: interrupted transfers start over.
+ */
 class LibvlcCacher : public ICacher
 {
 public:
@@ -41,14 +48,17 @@ public:
     virtual bool cache( const std::string& inputMrl,
                         const std::string& outputPath ) override;
     virtual void interrupt() override;
+    virtual bool canCacheConcurrently() const override;
 
 private:
-    void stop();
+    static void stop( VLC::MediaPlayer& mp );
 
 private:
     compat::Mutex m_mutex;
     compat::ConditionVariable m_cond;
-    VLC::MediaPlayer* m_currentMp;
+    /* The media players for the ongoing transfers */
+    std::vector<VLC::MediaPlayer*> m_players;
+    bool m_interrupted;
 };
 
 }
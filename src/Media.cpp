@@ -57,6 +57,7 @@
 #include "utils/Filename.h"
 #include "utils/Url.h"
 #include "thumbnails/ThumbnailerWorker.h"
+#include "thumbnails/ThumbnailStore.h"
 #include "utils/ModificationsNotifier.h"
 #include "utils/Enums.h"
 
@@ -109,6 +110,8 @@ Media::Media( MediaLibraryPtr ml, sqlite::Row& row )
     else
         m_publicOnlyListing = false;
     assert( row.hasRemainingColumns() == false );
+    m_ml->progressBuffer().apply( m_id, m_lastPosition, m_lastTime,
+                                  m_playCount, m_lastPlayedDate );
 }
 
 Media::Media( MediaLibraryPtr ml, const std::string& title, Type type,
@@ -189,10 +192,10 @@ std::shared_ptr<Media> Media::create( MediaLibraryPtr ml, Type type,
 {
     auto self = std::make_shared<Media>( ml, fileName, type, duration, deviceId,
                                          folderId );
-    static const std::string req = "INSERT INTO " + Media::Table::Name +
+    static const sqlite::Request req{ "INSERT INTO " + Media::Table::Name +
             "(type, duration, insertion_date, title, filename, device_id, "
             "folder_id, import_type) "
-            "VALUES(?, ?, ?, ?, ?, ?, ?, ?)";
+            "VALUES(?, ?, ?, ?, ?, ?, ?, ?)" };
 
     if ( insert( ml, self, req, type, self->m_duration, self->m_insertionDate,
                  self->m_title, self->m_filename, deviceId, folderId,
@@ -212,9 +215,9 @@ std::shared_ptr<Media> Media::createExternalMedia( MediaLibraryPtr ml,
         duration = -1;
     auto fileName = utils::url::decode( utils::file::fileName( mrl ) );
     auto self = std::make_shared<Media>( ml, fileName, importType, duration );
-    static const std::string req = "INSERT INTO " + Media::Table::Name +
+    static const sqlite::Request req{ "INSERT INTO " + Media::Table::Name +
             "(type, duration, insertion_date, title, filename, import_type) "
-            "VALUES(?, ?, ?, ?, ?, ?)";
+            "VALUES(?, ?, ?, ?, ?, ?)" };
 
     if ( insert( ml, self, req, Type::Unknown, duration, self->m_insertionDate,
                  self->m_title, self->m_filename, importType ) == false )
@@ -246,9 +249,9 @@ std::shared_ptr<Media> Media::createStream( MediaLibraryPtr ml, const std::strin
 bool Media::markAsAlbumTrack( int64_t albumId, uint32_t trackNb,
                               uint32_t discNumber, int64_t artistId, Genre* genre )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET "
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
             "subtype = ?, album_id = ?, track_number = ?, disc_number = ?, "
-            "artist_id = ?, genre_id = ? WHERE id_media = ?";
+            "artist_id = ?, genre_id = ? WHERE id_media = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, SubType::AlbumTrack,
             sqlite::ForeignKey{ albumId }, trackNb, discNumber,
             sqlite::ForeignKey{ artistId },
@@ -304,8 +307,8 @@ ShowEpisodePtr Media::showEpisode() const
 
 bool Media::setShowEpisode( ShowEpisodePtr episode )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET "
-        "subtype = ? WHERE id_media = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
+        "subtype = ? WHERE id_media = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req,
                                        SubType::ShowEpisode, m_id ) == false )
         return false;
@@ -402,16 +405,25 @@ Media::setLastPositionAndTime( PositionTypes positionType, float lastPos,
         curatedPosition = lastPos;
         curatedTime = lastTime;
     }
-    if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, curatedPosition,
-                                       curatedTime, lastPlayedDate, m_id ) == false )
+    auto& progressBuffer = m_ml->progressBuffer();
+    if ( progressBuffer.isDeferred() == true )
+    {
+        progressBuffer.record( m_id, curatedPosition, curatedTime,
+                               lastPlayedDate, incrementPlaycount );
+    }
+    else if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, curatedPosition,
+                                            curatedTime, lastPlayedDate, m_id ) == false )
         return ProgressResult::Error;
     if ( incrementPlaycount == true )
         m_playCount++;
     m_lastPlayedDate = lastPlayedDate;
     m_lastPosition = curatedPosition;
     m_lastTime = curatedTime;
-    m_ml->getCb()->onHistoryChanged( isStream() ? HistoryType::Network :
-                                                  HistoryType::Local );
+    m_ml->cacheWorker().onPlayStateChanged( m_id );
+    auto historyType = isStream() ? HistoryType::Network : HistoryType::Local;
+    if ( progressBuffer.moveToHistoryHead( historyType, m_id ) == true ||
+         progressBuffer.isDeferred() == false )
+        m_ml->getCb()->onHistoryChanged( historyType );
     switch ( positionType )
     {
     case PositionTypes::Begin:
@@ -465,23 +477,32 @@ bool Media::markAsPlayed()
     const std::string req = "UPDATE " + Table::Name +
             " SET last_played_date = ?, play_count = play_count + 1"
             " WHERE id_media = ?";
+    /* Ensure a pending progress update won't overwrite the played date */
+    m_ml->progressBuffer().flush();
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, lastPlayedDate,
                                        m_id ) == false )
         return false;
     m_lastPlayedDate = lastPlayedDate;
     ++m_playCount;
-    m_ml->getCb()->onHistoryChanged( isStream() ? HistoryType::Network :
-                                                  HistoryType::Local );
+    m_ml->cacheWorker().onPlayStateChanged( m_id );
+    auto historyType = isStream() ? HistoryType::Network : HistoryType::Local;
+    auto& progressBuffer = m_ml->progressBuffer();
+    if ( progressBuffer.moveToHistoryHead( historyType, m_id ) == true ||
+         progressBuffer.isDeferred() == false )
+        m_ml->getCb()->onHistoryChanged( historyType );
     return true;
 }
 
 bool Media::setPlayCount( uint32_t playCount )
 {
-    static const std::string req = "UPDATE " + Media::Table::Name + " SET "
-            "play_count = ? WHERE id_media = ?";
+    static const sqlite::Request req{ "UPDATE " + Media::Table::Name + " SET "
+            "play_count = ? WHERE id_media = ?" };
+    /* Don't let a pending progress update increment the new play count */
+    m_ml->progressBuffer().flush();
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, playCount, m_id ) == false )
         return false;
     m_playCount = playCount;
+    m_ml->cacheWorker().onPlayStateChanged( m_id );
     return true;
 }
 
@@ -492,11 +513,12 @@ time_t Media::lastPlayedDate() const
 
 bool Media::removeFromHistory()
 {
-    static const std::string req = "UPDATE " + Media::Table::Name + " SET "
+    static const sqlite::Request req{ "UPDATE " + Media::Table::Name + " SET "
             "last_position = ?, last_time = ?, play_count = ?, "
-            "last_played_date = ? WHERE id_media = ?";
+            "last_played_date = ? WHERE id_media = ?" };
     auto dbConn = m_ml->getConn();
 
+    m_ml->progressBuffer().flush();
     if ( sqlite::Tools::executeUpdate( dbConn, req, -1.f, -1, 0, nullptr, m_id ) == false )
         return false;
 
@@ -504,7 +526,9 @@ bool Media::removeFromHistory()
     m_lastTime = -1;
     m_lastPlayedDate = 0;
     m_playCount = 0;
+    m_ml->cacheWorker().onPlayStateChanged( m_id );
     auto historyType = isStream() ? HistoryType::Network: HistoryType::Local;
+    m_ml->progressBuffer().resetHistoryHead( historyType );
     m_ml->getCb()->onHistoryChanged( historyType );
     return true;
 }
@@ -516,7 +540,7 @@ bool Media::isFavorite() const
 
 bool Media::setFavorite( bool favorite )
 {
-    static const std::string req = "UPDATE " + Media::Table::Name + " SET is_favorite = ? WHERE id_media = ?";
+    static const sqlite::Request req{ "UPDATE " + Media::Table::Name + " SET is_favorite = ? WHERE id_media = ?" };
     if ( m_isFavorite == favorite )
         return true;
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, favorite, m_id ) == false )
@@ -529,8 +553,8 @@ const std::vector<FilePtr>& Media::files() const
 {
     if ( m_files.empty() == true )
     {
-        static const std::string req = "SELECT * FROM " + File::Table::Name
-                + " WHERE media_id = ?";
+        static const sqlite::Request req{ "SELECT * FROM " + File::Table::Name
+                + " WHERE media_id = ?" };
         m_files = File::fetchAll<IFile>( m_ml, req, m_id );
     }
     return m_files;
@@ -596,8 +620,8 @@ bool Media::setMovie( MoviePtr movie )
 {
     if ( m_subType == SubType::Movie )
         return true;
-    static const std::string req = "UPDATE " + Table::Name + " SET "
-        "subtype = ? WHERE id_media = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
+        "subtype = ? WHERE id_media = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req,
                                        SubType::Movie, m_id ) == false )
         return false;
@@ -691,6 +715,14 @@ const std::string& Media::thumbnailMrl( ThumbnailSizeType sizeType ) const
     return t->mrl();
 }
 
+ThumbnailData Media::thumbnailData( ThumbnailSizeType sizeType ) const
+{
+    auto t = thumbnail( sizeType );
+    if ( t == nullptr )
+        return {};
+    return t->packedData();
+}
+
 ThumbnailStatus Media::thumbnailStatus( ThumbnailSizeType sizeType ) const
 {
     auto t = thumbnail( sizeType );
@@ -1037,8 +1069,8 @@ bool Media::setReleaseDate( unsigned int date )
 {
     if ( m_releaseDate == date )
         return true;
-    static const std::string req = "UPDATE " + Table::Name + " SET "
-        "release_date = ? WHERE id_media = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
+        "release_date = ? WHERE id_media = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, date, m_id ) == false )
         return false;
     m_releaseDate = date;
@@ -1057,9 +1089,9 @@ int64_t Media::folderId() const
 
 bool Media::markAsInternal( Type type, int64_t duration, int64_t deviceId, int64_t folderId )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET "
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
         "type = ?, duration = ?, device_id = ?, folder_id = ?, import_type = ? "
-        "WHERE id_media = ?";
+        "WHERE id_media = ?" };
     assert( deviceId != 0 );
     assert( folderId != 0 );
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, type, duration,
@@ -1550,6 +1582,8 @@ Query<IMedia> Media::listAll( MediaLibraryPtr ml, IMedia::Type type,
 Query<IMedia> Media::listInProgress( MediaLibraryPtr ml, IMedia::Type type,
                                      const QueryParameters *params )
 {
+    /* The listing depends on the pending progress updates */
+    auto sync = [ml]() { ml->progressBuffer().sync(); };
     std::string req = "FROM " + Media::Table::Name + " m ";
 
     req += addRequestJoin( params );
@@ -1559,11 +1593,13 @@ Query<IMedia> Media::listInProgress( MediaLibraryPtr ml, IMedia::Type type,
     if ( type == IMedia::Type::Unknown )
     {
         return make_query<Media, IMedia>( ml, "m.*", std::move( req ),
-                                          sortRequest( params ) ).build();
+                                          sortRequest( params ) )
+                .preExecute( std::move( sync ) ).build();
     }
     req += " AND m.type = ?";
     return make_query<Media, IMedia>( ml, "m.*", std::move( req ),
-                                      sortRequest( params ), type ).build();
+                                      sortRequest( params ), type )
+            .preExecute( std::move( sync ) ).build();
 }
 
 Query<IMedia> Media::listSubscriptionMedia( MediaLibraryPtr ml, const QueryParameters* params )
@@ -1626,9 +1662,9 @@ IMedia::SubType Media::subType() const
 
 bool Media::setSubTypeUnknown()
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET "
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
             "subtype = ?, album_id = NULL, track_number = 0, disc_number = 0, "
-            "artist_id = NULL, genre_id = NULL WHERE id_media = ?";
+            "artist_id = NULL, genre_id = NULL WHERE id_media = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, SubType::Unknown,
             m_id ) == false )
         return false;
@@ -1656,8 +1692,8 @@ bool Media::setTitle( const std::string& title, bool forced )
     if ( ( m_forcedTitle == true && forced == false ) ||
          m_title == title )
         return true;
-    static const std::string req = "UPDATE " + Media::Table::Name +
-            " SET title = ?, forced_title = ? WHERE id_media = ?";
+    static const sqlite::Request req{ "UPDATE " + Media::Table::Name +
+            " SET title = ?, forced_title = ? WHERE id_media = ?" };
     try
     {
         if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, title, forced,
@@ -1692,7 +1728,7 @@ bool Media::setFileName( std::string fileName )
 {
     if ( fileName == m_filename )
         return true;
-    static const std::string req = "UPDATE " + Media::Table::Name + " SET filename = ? WHERE id_media = ?";
+    static const sqlite::Request req{ "UPDATE " + Media::Table::Name + " SET filename = ? WHERE id_media = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, fileName, m_id ) == false )
         return false;
     m_filename = std::move( fileName );
@@ -1793,6 +1829,27 @@ void Media::createIndexes( sqlite::Connection* connection )
     sqlite::Tools::executeRequest( connection,
                                    index( Indexes::ArtistId,
                                           Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( connection,
+                                   index( Indexes::TypeTitle,
+                                          Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( connection,
+                                   index( Indexes::TypeDuration,
+                                          Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( connection,
+                                   index( Indexes::TypeInsertionDate,
+                                          Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( connection,
+                                   index( Indexes::TypeReleaseDate,
+                                          Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( connection,
+                                   index( Indexes::TypeFileName,
+                                          Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( connection,
+                                   index( Indexes::ImportTypeTitle,
+                                          Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( connection,
+                                   index( Indexes::ImportTypeInsertionDate,
+                                          Settings::DbModelVersion ) );
 }
 
 std::string Media::schema( const std::string& tableName, uint32_t dbModel )
@@ -2378,6 +2435,94 @@ std::string Media::index( Indexes index, uint32_t dbModel )
             assert( dbModel >= 34 );
             return "CREATE INDEX " + indexName( index, dbModel ) +
                     " ON " + Table::Name + "(artist_id)";
+        /*
+         * Those match the listAll() filters for a single media type, followed
+         * by the sort key, so that listing a type ordered by any of the
+         * columns stored in the media table is a range scan instead of a full
+         * table sort. Missing media are excluded, which keeps the indexes
+         * smaller and matches the default listing conditions.
+         * The play count and last played date ones were removed in model 47:
+         * those columns are updated on each playback, which then had to
+         * update all of them, and the global play count & last played date
+         * indexes already provide those orders.
+         */
+        case Indexes::TypeTitle:
+            assert( dbModel >= 40 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(type, import_type, title)"
+                    " WHERE is_present != 0";
+        case Indexes::TypeDuration:
+            assert( dbModel >= 40 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(type, import_type, duration)"
+                    " WHERE is_present != 0";
+        case Indexes::TypeInsertionDate:
+            assert( dbModel >= 40 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(type, import_type, "
+                        "insertion_date) WHERE is_present != 0";
+        case Indexes::TypeReleaseDate:
+            assert( dbModel >= 40 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(type, import_type, release_date)"
+                    " WHERE is_present != 0";
+        case Indexes::TypePlayCount:
+            assert( dbModel >= 40 && dbModel < 47 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(type, import_type, play_count)"
+                    " WHERE is_present != 0";
+        case Indexes::TypeFileName:
+            assert( dbModel >= 40 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(type, import_type, filename)"
+                    " WHERE is_present != 0";
+        case Indexes::TypeLastPlayedDate:
+            assert( dbModel >= 40 && dbModel < 47 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(type, import_type, "
+                        "last_played_date) WHERE is_present != 0";
+        /*
+         * Same as above for the listings which don't filter on a single type
+         * (all media, or all video including the unknown type) and only
+         * have an equality constraint on the import type.
+         * Only the title & insertion date ones, which are the common orders
+         * for those listings, are kept since model 47.
+         */
+        case Indexes::ImportTypeTitle:
+            assert( dbModel >= 45 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(import_type, title)"
+                    " WHERE is_present != 0";
+        case Indexes::ImportTypeDuration:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(import_type, duration)"
+                    " WHERE is_present != 0";
+        case Indexes::ImportTypeInsertionDate:
+            assert( dbModel >= 45 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(import_type, insertion_date)"
+                    " WHERE is_present != 0";
+        case Indexes::ImportTypeReleaseDate:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(import_type, release_date)"
+                    " WHERE is_present != 0";
+        case Indexes::ImportTypePlayCount:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(import_type, play_count)"
+                    " WHERE is_present != 0";
+        case Indexes::ImportTypeFileName:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(import_type, filename)"
+                    " WHERE is_present != 0";
+        case Indexes::ImportTypeLastPlayedDate:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(import_type, last_played_date)"
+                    " WHERE is_present != 0";
         default:
             assert( !"Invalid index provided" );
     }
@@ -2436,6 +2581,48 @@ std::string Media::indexName( Indexes index, uint32_t dbModel )
         case Indexes::ArtistId:
             assert( dbModel >= 34 );
             return "media_artist_id_idx";
+        case Indexes::TypeTitle:
+            assert( dbModel >= 40 );
+            return "media_type_title_idx";
+        case Indexes::TypeDuration:
+            assert( dbModel >= 40 );
+            return "media_type_duration_idx";
+        case Indexes::TypeInsertionDate:
+            assert( dbModel >= 40 );
+            return "media_type_insertion_date_idx";
+        case Indexes::TypeReleaseDate:
+            assert( dbModel >= 40 );
+            return "media_type_release_date_idx";
+        case Indexes::TypePlayCount:
+            assert( dbModel >= 40 && dbModel < 47 );
+            return "media_type_play_count_idx";
+        case Indexes::TypeFileName:
+            assert( dbModel >= 40 );
+            return "media_type_filename_idx";
+        case Indexes::TypeLastPlayedDate:
+            assert( dbModel >= 40 && dbModel < 47 );
+            return "media_type_last_played_date_idx";
+        case Indexes::ImportTypeTitle:
+            assert( dbModel >= 45 );
+            return "media_import_type_title_idx";
+        case Indexes::ImportTypeDuration:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "media_import_type_duration_idx";
+        case Indexes::ImportTypeInsertionDate:
+            assert( dbModel >= 45 );
+            return "media_import_type_insertion_date_idx";
+        case Indexes::ImportTypeReleaseDate:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "media_import_type_release_date_idx";
+        case Indexes::ImportTypePlayCount:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "media_import_type_play_count_idx";
+        case Indexes::ImportTypeFileName:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "media_import_type_filename_idx";
+        case Indexes::ImportTypeLastPlayedDate:
+            assert( dbModel >= 45 && dbModel < 47 );
+            return "media_import_type_last_played_date_idx";
         default:
             assert( !"Invalid index provided" );
     }
@@ -2489,7 +2676,14 @@ bool Media::checkDbModel( MediaLibraryPtr ml )
             checkIndex( Indexes::Title ) &&
             checkIndex( Indexes::FileName ) &&
             checkIndex( Indexes::GenreId ) &&
-            checkIndex( Indexes::ArtistId );
+            checkIndex( Indexes::ArtistId ) &&
+            checkIndex( Indexes::TypeTitle ) &&
+            checkIndex( Indexes::TypeDuration ) &&
+            checkIndex( Indexes::TypeInsertionDate ) &&
+            checkIndex( Indexes::TypeReleaseDate ) &&
+            checkIndex( Indexes::TypeFileName ) &&
+            checkIndex( Indexes::ImportTypeTitle ) &&
+            checkIndex( Indexes::ImportTypeInsertionDate );
 }
 
 bool Media::addLabel( LabelPtr label )
@@ -2771,6 +2965,8 @@ Query<IMedia> Media::searchInService( MediaLibraryPtr ml, const std::string& pat
 Query<IMedia> Media::fetchHistoryInternal( MediaLibraryPtr ml, HistoryType type,
                                            IMedia::Type media_type, const QueryParameters* params )
 {
+    /* The history ordering depends on the pending progress updates */
+    auto sync = [ml]() { ml->progressBuffer().sync(); };
     std::string req = "FROM " + Media::Table::Name + " m ";
 
     const auto sort = (params != nullptr && params->sort != SortingCriteria::Default)
@@ -2791,6 +2987,7 @@ Query<IMedia> Media::fetchHistoryInternal( MediaLibraryPtr ml, HistoryType type,
     {
         return make_query<Media, IMedia>( ml, "*", req, sortRequest( sort, desc ) )
             .markPublic( publicOnly )
+            .preExecute( std::move( sync ) )
             .build();
     }
 
@@ -2802,6 +2999,7 @@ Query<IMedia> Media::fetchHistoryInternal( MediaLibraryPtr ml, HistoryType type,
     return make_query<Media, IMedia>( ml, "*", req, sortRequest( sort, desc ),
                                       Media::ImportType::Stream )
         .markPublic( publicOnly )
+        .preExecute( std::move( sync ) )
         .build();
 }
 
@@ -2822,6 +3020,7 @@ Query<IMedia> Media::searchInHistory( MediaLibraryPtr ml, HistoryType hisType,
                                       const std::string& pattern, const QueryParameters* params,
                                       Media::Type type, Media::SubType subType )
 {
+    auto sync = [ml]() { ml->progressBuffer().sync(); };
     std::string req = "FROM " + Media::Table::Name + " m ";
 
     const SortingCriteria sort = (params != nullptr && params->sort != SortingCriteria::Default)
@@ -2851,7 +3050,7 @@ Query<IMedia> Media::searchInHistory( MediaLibraryPtr ml, HistoryType hisType,
     {
         return make_query<Media, IMedia>( ml, "m.*", std::move( req ), sortRequest( sort, desc ),
                                           sqlite::Tools::sanitizePattern( pattern ) )
-                .markPublic( publicOnly ).build();
+                .markPublic( publicOnly ).preExecute( std::move( sync ) ).build();
     }
 
     if ( hisType != HistoryType::Network )
@@ -2862,7 +3061,7 @@ Query<IMedia> Media::searchInHistory( MediaLibraryPtr ml, HistoryType hisType,
     return make_query<Media, IMedia>( ml, "m.*", std::move( req ), sortRequest( sort, desc ),
                                       sqlite::Tools::sanitizePattern( pattern ),
                                       ImportType::Stream )
-            .markPublic( publicOnly ).build();
+            .markPublic( publicOnly ).preExecute( std::move( sync ) ).build();
 }
 
 Query<IMedia> Media::fromFolderId( MediaLibraryPtr ml, IMedia::Type type,
@@ -2974,6 +3173,7 @@ Query<IMedia> Media::searchFromMediaGroup( MediaLibraryPtr ml, int64_t groupId,
 
 bool Media::clearHistory( MediaLibraryPtr ml, HistoryType type )
 {
+    ml->progressBuffer().flush();
     auto dbConn = ml->getConn();
     auto t = dbConn->newTransaction();
     std::string req = "UPDATE " + Media::Table::Name +
@@ -2993,6 +3193,8 @@ bool Media::clearHistory( MediaLibraryPtr ml, HistoryType type )
     if ( sqlite::Tools::executeUpdate( dbConn, req ) == false )
         return false;
     t->commit();
+    ml->cacheWorker().onHistoryCleared();
+    ml->progressBuffer().resetHistoryHead( type );
     ml->getCb()->onHistoryChanged( type );
     return true;
 }
@@ -3002,6 +3204,7 @@ bool Media::clearHistoryByMediaType( MediaLibraryPtr ml, IMedia::Type mediaType
     if ( mediaType == IMedia::Type::Unknown )
         return false;
 
+    ml->progressBuffer().flush();
     auto dbConn = ml->getConn();
     auto t = dbConn->newTransaction();
     std::string req = "UPDATE " + Media::Table::Name +
@@ -3016,6 +3219,8 @@ bool Media::clearHistoryByMediaType( MediaLibraryPtr ml, IMedia::Type mediaType
     if ( sqlite::Tools::executeUpdate( dbConn, req ) == false )
         return false;
     t->commit();
+    ml->cacheWorker().onHistoryCleared();
+    ml->progressBuffer().resetHistoryHead( HistoryType::Local );
     ml->getCb()->onHistoryChanged( HistoryType::Local );
     return true;
 }
@@ -102,6 +102,20 @@ class Media : public IMedia,
             FileName,
             GenreId,
             ArtistId,
+            TypeTitle,
+            TypeDuration,
+            TypeInsertionDate,
+            TypeReleaseDate,
+            TypePlayCount,
+            TypeFileName,
+            TypeLastPlayedDate,
+            ImportTypeTitle,
+            ImportTypeDuration,
+            ImportTypeInsertionDate,
+            ImportTypeReleaseDate,
+            ImportTypePlayCount,
+            ImportTypeFileName,
+            ImportTypeLastPlayedDate,
         };
 
         // Those should be private, however the standard states that the expression
@@ -235,6 +249,7 @@ class Media : public IMedia,
         bool addChapter( int64_t offset, int64_t duration, std::string name );
         std::shared_ptr<Thumbnail> thumbnail( ThumbnailSizeType sizeType ) const;
         virtual const std::string& thumbnailMrl( ThumbnailSizeType sizeType ) const override;
+        virtual ThumbnailData thumbnailData( ThumbnailSizeType sizeType ) const override;
         virtual ThumbnailStatus thumbnailStatus( ThumbnailSizeType sizeType ) const override;
         virtual bool setThumbnail( const std::string &thumbnail,
                                    ThumbnailSizeType sizeType ) override;
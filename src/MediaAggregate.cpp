@@ -0,0 +1,460 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "MediaAggregate.h"
+#include "Media.h"
+#include "MediaLibrary.h"
+#include "Settings.h"
+#include "ShowEpisode.h"
+#include "database/SqliteTools.h"
+#include "utils/Enums.h"
+
+namespace medialibrary
+{
+
+const std::string MediaAggregate::Table::Name = "MediaAggregate";
+
+void MediaAggregate::createTable( sqlite::Connection* dbConn )
+{
+    sqlite::Tools::executeRequest( dbConn, schema( Table::Name,
+                                                   Settings::DbModelVersion ) );
+}
+
+void MediaAggregate::createTriggers( sqlite::Connection* dbConn )
+{
+    sqlite::Tools::executeRequest( dbConn,
+                                   trigger( Triggers::InsertMedia, Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( dbConn,
+                                   trigger( Triggers::DeleteMedia, Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( dbConn,
+                                   trigger( Triggers::UpdateMedia, Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( dbConn,
+                                   trigger( Triggers::InsertShowEpisode, Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( dbConn,
+                                   trigger( Triggers::DeleteShowEpisode, Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( dbConn,
+                                   trigger( Triggers::DeleteEmpty, Settings::DbModelVersion ) );
+}
+
+void MediaAggregate::createIndexes( sqlite::Connection* dbConn )
+{
+    sqlite::Tools::executeRequest( dbConn,
+                                   index( Indexes::NbPublicTracks, Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( dbConn,
+                                   index( Indexes::PublicDuration, Settings::DbModelVersion ) );
+}
+
+std::string MediaAggregate::schema( const std::string& tableName, uint32_t )
+{
+    UNUSED_IN_RELEASE( tableName );
+
+    assert( tableName == Table::Name );
+    return "CREATE TABLE " + Table::Name +
+    "("
+        "entity_type UNSIGNED INTEGER NOT NULL,"
+        "entity_id UNSIGNED INTEGER NOT NULL,"
+        "nb_tracks UNSIGNED INTEGER NOT NULL DEFAULT 0,"
+        "nb_present_tracks UNSIGNED INTEGER NOT NULL DEFAULT 0,"
+        "nb_public_tracks UNSIGNED INTEGER NOT NULL DEFAULT 0,"
+        "nb_public_present_tracks UNSIGNED INTEGER NOT NULL DEFAULT 0,"
+        "duration INTEGER NOT NULL DEFAULT 0,"
+        "public_duration INTEGER NOT NULL DEFAULT 0,"
+        "last_insertion_date UNSIGNED INTEGER NOT NULL DEFAULT 0,"
+        "PRIMARY KEY(entity_type, entity_id)"
+    ") WITHOUT ROWID";
+}
+
+std::string MediaAggregate::trigger( Triggers trigger, uint32_t dbModel )
+{
+    assert( dbModel >= 43 );
+    const std::string showId = "(SELECT show_id FROM " + ShowEpisode::Table::Name +
+            " WHERE media_id = ";
+    switch ( trigger )
+    {
+        case Triggers::InsertMedia:
+        {
+            return "CREATE TRIGGER " + triggerName( trigger, dbModel ) +
+                   " AFTER INSERT ON " + Media::Table::Name +
+                   " BEGIN " +
+                   upsert( EntityType::Artist, "new.artist_id",
+                           contribution( "new", false ), "", "" ) +
+                   upsert( EntityType::Album, "new.album_id",
+                           contribution( "new", false ), "", "" ) +
+                   upsert( EntityType::Genre, "new.genre_id",
+                           contribution( "new", false ), "", "" ) +
+                   " END";
+        }
+        case Triggers::DeleteMedia:
+        {
+            /*
+             * This needs to run before the deletion, since the show episode
+             * is removed by a cascading foreign key
+             */
+            return "CREATE TRIGGER " + triggerName( trigger, dbModel ) +
+                   " BEFORE DELETE ON " + Media::Table::Name +
+                   " BEGIN " +
+                   upsert( EntityType::Artist, "old.artist_id",
+                           contribution( "old", true ), "", "" ) +
+                   upsert( EntityType::Album, "old.album_id",
+                           contribution( "old", true ), "", "" ) +
+                   upsert( EntityType::Genre, "old.genre_id",
+                           contribution( "old", true ), "", "" ) +
+                   upsert( EntityType::Show, showId + "old.id_media)",
+                           contribution( "old", true ), "", "" ) +
+                   ( dbModel >= 46 ?
+                       lastInsertionDate( EntityType::Artist, "old.artist_id",
+                                          "old.insertion_date", "old.id_media", "" ) +
+                       lastInsertionDate( EntityType::Album, "old.album_id",
+                                          "old.insertion_date", "old.id_media", "" ) +
+                       lastInsertionDate( EntityType::Genre, "old.genre_id",
+                                          "old.insertion_date", "old.id_media", "" ) +
+                       lastInsertionDate( EntityType::Show, showId + "old.id_media)",
+                                          "old.insertion_date", "old.id_media", "" )
+                       : "" ) +
+                   " END";
+        }
+        case Triggers::UpdateMedia:
+        {
+            std::string req = "CREATE TRIGGER " + triggerName( trigger, dbModel ) +
+                   " AFTER UPDATE OF is_present, is_public, duration, insertion_date,"
+                       " artist_id, album_id, genre_id ON " + Media::Table::Name +
+                   " WHEN old.is_present IS NOT new.is_present"
+                       " OR old.is_public IS NOT new.is_public"
+                       " OR old.duration IS NOT new.duration"
+                       " OR old.insertion_date IS NOT new.insertion_date"
+                       " OR old.artist_id IS NOT new.artist_id"
+                       " OR old.album_id IS NOT new.album_id"
+                       " OR old.genre_id IS NOT new.genre_id"
+                   " BEGIN ";
+            const std::pair<EntityType, std::string> columns[] = {
+                { EntityType::Artist, "artist_id" },
+                { EntityType::Album, "album_id" },
+                { EntityType::Genre, "genre_id" },
+            };
+            for ( const auto& c : columns )
+            {
+                const auto oldId = "old." + c.second;
+                const auto newId = "new." + c.second;
+                /*
+                 * When the media is still linked to the same entity, apply the
+                 * difference in a single step so that the aggregate doesn't
+                 * get deleted when its last track is updated
+                 */
+                req += upsert( c.first, newId, difference(), "",
+                               " AND " + newId + " IS " + oldId );
+                req += upsert( c.first, oldId, contribution( "old", true ), "",
+                               " AND " + oldId + " IS NOT " + newId );
+                req += upsert( c.first, newId, contribution( "new", false ), "",
+                               " AND " + oldId + " IS NOT " + newId );
+                /*
+                 * The media might have been the latest one of the entity it
+                 * was moved from, or its insertion date might have decreased
+                 */
+                if ( dbModel >= 46 )
+                    req += lastInsertionDate( c.first, oldId, "old.insertion_date", "",
+                        " AND (" + oldId + " IS NOT " + newId +
+                        " OR old.insertion_date IS NOT new.insertion_date)" );
+            }
+            req += upsert( EntityType::Show, showId + "new.id_media)",
+                           difference(), "", "" );
+            if ( dbModel >= 46 )
+                req += lastInsertionDate( EntityType::Show, showId + "new.id_media)",
+                                          "old.insertion_date", "",
+                    " AND old.insertion_date IS NOT new.insertion_date" );
+            return req + " END";
+        }
+        case Triggers::InsertShowEpisode:
+        {
+            return "CREATE TRIGGER " + triggerName( trigger, dbModel ) +
+                   " AFTER INSERT ON " + ShowEpisode::Table::Name +
+                   " BEGIN " +
+                   upsert( EntityType::Show, "new.show_id",
+                           contribution( "m", false ),
+                           " FROM " + Media::Table::Name + " m",
+                           " AND m.id_media = new.media_id" ) +
+                   " END";
+        }
+        case Triggers::DeleteShowEpisode:
+        {
+            /*
+             * When the episode is removed along with its media, the media
+             * doesn't exist anymore and its contribution was already removed
+             */
+            return "CREATE TRIGGER " + triggerName( trigger, dbModel ) +
+                   " AFTER DELETE ON " + ShowEpisode::Table::Name +
+                   " BEGIN " +
+                   upsert( EntityType::Show, "old.show_id",
+                           contribution( "m", true ),
+                           " FROM " + Media::Table::Name + " m",
+                           " AND m.id_media = old.media_id" ) +
+                   ( dbModel >= 46 ?
+                       lastInsertionDate( EntityType::Show, "old.show_id",
+                                          "(SELECT insertion_date FROM " +
+                                              Media::Table::Name +
+                                              " WHERE id_media = old.media_id)",
+                                          "", "" )
+                       : "" ) +
+                   " END";
+        }
+        case Triggers::DeleteEmpty:
+        {
+            return "CREATE TRIGGER " + triggerName( trigger, dbModel ) +
+                   " AFTER UPDATE OF nb_tracks ON " + Table::Name +
+                   " WHEN new.nb_tracks = 0"
+                   " BEGIN"
+                   " DELETE FROM " + Table::Name +
+                       " WHERE entity_type = new.entity_type"
+                       " AND entity_id = new.entity_id;"
+                   " END";
+        }
+    }
+    return "<invalid request>";
+}
+
+std::string MediaAggregate::triggerName( Triggers trigger, uint32_t dbModel )
+{
+    UNUSED_IN_RELEASE( dbModel );
+
+    assert( dbModel >= 43 );
+    switch ( trigger )
+    {
+        case Triggers::InsertMedia:
+            return "media_aggregate_insert_media";
+        case Triggers::DeleteMedia:
+            return "media_aggregate_delete_media";
+        case Triggers::UpdateMedia:
+            return "media_aggregate_update_media";
+        case Triggers::InsertShowEpisode:
+            return "media_aggregate_insert_show_episode";
+        case Triggers::DeleteShowEpisode:
+            return "media_aggregate_delete_show_episode";
+        case Triggers::DeleteEmpty:
+            return "media_aggregate_delete_empty";
+    }
+    return "<invalid request>";
+}
+
+std::string MediaAggregate::index( Indexes index, uint32_t dbModel )
+{
+    switch ( index )
+    {
+        case Indexes::NbPublicTracks:
+            return "CREATE INDEX " + indexName( index, dbModel ) + " ON " +
+                    Table::Name + "(entity_type, nb_public_tracks)";
+        case Indexes::PublicDuration:
+            return "CREATE INDEX " + indexName( index, dbModel ) + " ON " +
+                    Table::Name + "(entity_type, public_duration)";
+    }
+    return "<invalid request>";
+}
+
+std::string MediaAggregate::indexName( Indexes index, uint32_t dbModel )
+{
+    UNUSED_IN_RELEASE( dbModel );
+
+    assert( dbModel >= 43 );
+    switch ( index )
+    {
+        case Indexes::NbPublicTracks:
+            return "media_aggregate_nb_public_tracks_idx";
+        case Indexes::PublicDuration:
+            return "media_aggregate_public_duration_idx";
+    }
+    return "<invalid request>";
+}
+
+bool MediaAggregate::checkDbModel( MediaLibraryPtr ml )
+{
+    OPEN_READ_CONTEXT( ctx, ml->getConn() );
+
+    if ( sqlite::Tools::checkTableSchema(
+                                       schema( Table::Name, Settings::DbModelVersion ),
+                                       Table::Name ) == false )
+        return false;
+    auto checkTrigger = []( Triggers t ) {
+        return sqlite::Tools::checkTriggerStatement(
+                                    trigger( t, Settings::DbModelVersion ),
+                                    triggerName( t, Settings::DbModelVersion ) );
+    };
+    auto checkIndex = []( Indexes i ) {
+        return sqlite::Tools::checkIndexStatement(
+                                    index( i, Settings::DbModelVersion ),
+                                    indexName( i, Settings::DbModelVersion ) );
+    };
+    return checkTrigger( Triggers::InsertMedia ) &&
+            checkTrigger( Triggers::DeleteMedia ) &&
+            checkTrigger( Triggers::UpdateMedia ) &&
+            checkTrigger( Triggers::InsertShowEpisode ) &&
+            checkTrigger( Triggers::DeleteShowEpisode ) &&
+            checkTrigger( Triggers::DeleteEmpty ) &&
+            checkIndex( Indexes::NbPublicTracks ) &&
+            checkIndex( Indexes::PublicDuration );
+}
+
+std::string MediaAggregate::seed( EntityType type )
+{
+    std::string entityId;
+    auto source = mediaSource( type, entityId );
+    return "INSERT INTO " + Table::Name +
+           "(entity_type, entity_id, nb_tracks, nb_present_tracks,"
+           " nb_public_tracks, nb_public_present_tracks, duration,"
+           " public_duration, last_insertion_date)"
+           " SELECT " + utils::enum_to_string( type ) + ", " + entityId + ","
+           " COUNT(*), SUM(m.is_present != 0), SUM(m.is_public != 0),"
+           " SUM(m.is_present != 0 AND m.is_public != 0),"
+           " SUM(MAX(m.duration, 0)),"
+           " SUM(IIF(m.is_public != 0, MAX(m.duration, 0), 0)),"
+           " MAX(IFNULL(m.insertion_date, 0))" +
+           source + " WHERE " + entityId + " IS NOT NULL"
+           " GROUP BY " + entityId;
+}
+
+std::string MediaAggregate::publicJoin( EntityType type, const std::string& entityId )
+{
+    return " INNER JOIN " + Table::Name + " agg"
+           " ON agg.entity_type = " + utils::enum_to_string( type ) +
+           " AND agg.entity_id = " + entityId;
+}
+
+std::string MediaAggregate::publicCondition( const QueryParameters* params )
+{
+    if ( params != nullptr && params->includeMissing == true )
+        return " agg.nb_public_tracks > 0";
+    return " agg.nb_public_present_tracks > 0";
+}
+
+std::string MediaAggregate::upsert( EntityType type, const std::string& entityId,
+                                    const std::string& values, const std::string& source,
+                                    const std::string& condition )
+{
+    /*
+     * The WHERE clause is mandatory to avoid an ambiguity between the upsert
+     * clause & a join constraint
+     */
+    return "INSERT INTO " + Table::Name +
+           "(entity_type, entity_id, nb_tracks, nb_present_tracks,"
+           " nb_public_tracks, nb_public_present_tracks, duration,"
+           " public_duration, last_insertion_date)"
+           " SELECT " + utils::enum_to_string( type ) + ", " + entityId + ", " +
+           values + source +
+           " WHERE " + entityId + " IS NOT NULL" + condition +
+           " ON CONFLICT(entity_type, entity_id) DO UPDATE SET"
+           " nb_tracks = nb_tracks + excluded.nb_tracks,"
+           " nb_present_tracks = nb_present_tracks + excluded.nb_present_tracks,"
+           " nb_public_tracks = nb_public_tracks + excluded.nb_public_tracks,"
+           " nb_public_present_tracks = nb_public_present_tracks +"
+               " excluded.nb_public_present_tracks,"
+           " duration = duration + excluded.duration,"
+           " public_duration = public_duration + excluded.public_duration,"
+           " last_insertion_date = MAX(last_insertion_date,"
+               " excluded.last_insertion_date);";
+}
+
+std::string MediaAggregate::mediaSource( EntityType type, std::string& entityId )
+{
+    std::string source = " FROM " + Media::Table::Name + " m";
+    switch ( type )
+    {
+        case EntityType::Artist:
+            entityId = "m.artist_id";
+            break;
+        case EntityType::Album:
+            entityId = "m.album_id";
+            break;
+        case EntityType::Genre:
+            entityId = "m.genre_id";
+            break;
+        case EntityType::Show:
+            entityId = "ep.show_id";
+            source += " INNER JOIN " + ShowEpisode::Table::Name +
+                      " ep ON ep.media_id = m.id_media";
+            break;
+    }
+    return source;
+}
+
+std::string MediaAggregate::lastInsertionDate( EntityType type,
+                                               const std::string& entityId,
+                                               const std::string& removedDate,
+                                               const std::string& removedMediaId,
+                                               const std::string& condition )
+{
+    /*
+     * Only the removal of the latest media requires the date to be computed
+     * again, which is done through the index on the entity column
+     */
+    std::string column;
+    auto source = mediaSource( type, column );
+    return "UPDATE " + Table::Name + " SET last_insertion_date = IFNULL(("
+               "SELECT MAX(IFNULL(m.insertion_date, 0))" + source +
+               " WHERE " + column + " = " + entityId +
+               ( removedMediaId.empty() == false ?
+                   " AND m.id_media != " + removedMediaId : "" ) +
+           "), 0)"
+           " WHERE entity_type = " + utils::enum_to_string( type ) +
+           " AND entity_id = " + entityId +
+           " AND last_insertion_date <= IFNULL(" + removedDate + ", 0)" +
+           condition + ";";
+}
+
+std::string MediaAggregate::contribution( const std::string& row, bool removal )
+{
+    const std::string sign = removal == true ? "-" : "";
+    const auto present = "(" + row + ".is_present != 0)";
+    const auto isPublic = "(" + row + ".is_public != 0)";
+    const auto duration = "MAX(" + row + ".duration, 0)";
+    return sign + "1, " +
+           sign + present + ", " +
+           sign + isPublic + ", " +
+           sign + "(" + present + " AND " + isPublic + "), " +
+           sign + duration + ", " +
+           sign + "IIF(" + isPublic + ", " + duration + ", 0), " +
+           ( removal == true ? "0" : "IFNULL(" + row + ".insertion_date, 0)" );
+}
+
+std::string MediaAggregate::difference()
+{
+    const auto present = []( const std::string& row ) {
+        return "(" + row + ".is_present != 0)";
+    };
+    const auto isPublic = []( const std::string& row ) {
+        return "(" + row + ".is_public != 0)";
+    };
+    const auto duration = []( const std::string& row ) {
+        return "MAX(" + row + ".duration, 0)";
+    };
+    return "0, " +
+           present( "new" ) + " - " + present( "old" ) + ", " +
+           isPublic( "new" ) + " - " + isPublic( "old" ) + ", " +
+           "(" + present( "new" ) + " AND " + isPublic( "new" ) + ") - "
+           "(" + present( "old" ) + " AND " + isPublic( "old" ) + "), " +
+           duration( "new" ) + " - " + duration( "old" ) + ", " +
+           "IIF(" + isPublic( "new" ) + ", " + duration( "new" ) + ", 0) - "
+           "IIF(" + isPublic( "old" ) + ", " + duration( "old" ) + ", 0), " +
+           "IFNULL(new.insertion_date, 0)";
+}
+
+}
@@ -0,0 +1,130 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Types.h"
+
+#include <string>
+
+namespace medialibrary
+{
+
+struct QueryParameters;
+
+namespace sqlite
+{
+class Connection;
+}
+
+/**
+ * @brief The MediaAggregate class materializes per entity media statistics
+ *
+ * For each artist, album, genre & show, the table holds the total, present
+ * and public number of tracks, their duration and the latest insertion date.
+ * It is maintained by triggers on the media & show episode tables, so that
+ * listings can filter & sort public entities through an index instead of
+ * probing the media table for each entity.
+ * An artist, album & genre aggregate the media referencing them through
+ * their artist_id, album_id & genre_id columns, a show aggregates its episodes.
+ */
+class MediaAggregate
+{
+public:
+    struct Table
+    {
+        static const std::string Name;
+    };
+    enum class EntityType : uint8_t
+    {
+        Artist = 1,
+        Album,
+        Genre,
+        Show,
+    };
+    enum class Triggers : uint8_t
+    {
+        InsertMedia,
+        DeleteMedia,
+        UpdateMedia,
+        InsertShowEpisode,
+        DeleteShowEpisode,
+        DeleteEmpty,
+    };
+    enum class Indexes : uint8_t
+    {
+        NbPublicTracks,
+        PublicDuration,
+    };
+
+    static void createTable( sqlite::Connection* dbConn );
+    static void createTriggers( sqlite::Connection* dbConn );
+    static void createIndexes( sqlite::Connection* dbConn );
+    static std::string schema( const std::string& tableName, uint32_t dbModel );
+    static std::string trigger( Triggers trigger, uint32_t dbModel );
+    static std::string triggerName( Triggers trigger, uint32_t dbModel );
+    static std::string index( Indexes index, uint32_t dbModel );
+    static std::string indexName( Indexes index, uint32_t dbModel );
+    static bool checkDbModel( MediaLibraryPtr ml );
+    /**
+     * @brief seed Returns a request computing the aggregates of all entities
+     *             of the provided type from scratch
+     */
+    static std::string seed( EntityType type );
+
+    /**
+     * @brief publicJoin Returns a join against the aggregates of the entities
+     *                   of the provided type, using the "agg" alias
+     * @param entityId The column containing the entity ID in the main table
+     */
+    static std::string publicJoin( EntityType type, const std::string& entityId );
+    /**
+     * @brief publicCondition Returns the condition to match entities which
+     *                        have at least one public track
+     *
+     * If params->includeMissing is false, the public track must be present.
+     * This expects publicJoin() to be part of the request.
+     */
+    static std::string publicCondition( const QueryParameters* params );
+
+private:
+    static std::string upsert( EntityType type, const std::string& entityId,
+                               const std::string& values, const std::string& source,
+                               const std::string& condition );
+    /*
+     * Returns the media table, joined with the show episodes for shows, and
+     * sets the column containing the entity ID
+     */
+    static std::string mediaSource( EntityType type, std::string& entityId );
+    /*
+     * Returns a request computing the latest insertion date of an entity
+     * again, when the media inserted at removedDate stops contributing to it
+     */
+    static std::string lastInsertionDate( EntityType type, const std::string& entityId,
+                                          const std::string& removedDate,
+                                          const std::string& removedMediaId,
+                                          const std::string& condition );
+    static std::string contribution( const std::string& row, bool removal );
+    static std::string difference();
+};
+
+}
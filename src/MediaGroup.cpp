@@ -392,7 +392,7 @@ bool MediaGroup::isFavorite() const
 
 bool MediaGroup::setFavorite( bool favorite )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_group = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_group = ?" };
     if ( m_isFavorite == favorite )
         return true;
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, favorite, m_id ) == false )
@@ -406,9 +406,9 @@ std::shared_ptr<MediaGroup> MediaGroup::create( MediaLibraryPtr ml,
                                                 bool userInitiated,
                                                 bool isForcedSingleton )
 {
-    static const std::string req = "INSERT INTO " + Table::Name +
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name +
             "(name, user_interacted, forced_singleton, creation_date, last_modification_date) "
-            "VALUES(?, ?, ?, ?, ?)";
+            "VALUES(?, ?, ?, ?, ?)" };
     auto self = std::make_shared<MediaGroup>( ml, std::move( name ),
                                               userInitiated, isForcedSingleton );
     if ( insert( ml, self, req, self->name(), userInitiated,
@@ -448,9 +448,9 @@ std::shared_ptr<MediaGroup> MediaGroup::create( MediaLibraryPtr ml,
     }
     if ( media.empty() == true )
         return nullptr;
-    static const std::string req = "INSERT INTO " + Table::Name +
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name +
             "(name, user_interacted, forced_singleton, creation_date, last_modification_date) "
-            "VALUES(?, ?, ?, ?, ?)";
+            "VALUES(?, ?, ?, ?, ?)" };
     auto self = std::make_shared<MediaGroup>( ml, std::move( name ) );
     if ( insert( ml, self, req, self->name(), true, false, self->creationDate(),
                  self->lastModificationDate() ) == false )
@@ -471,9 +471,9 @@ MediaGroup::fetchMatching( MediaLibraryPtr ml, const std::string& prefix )
     if ( prefix.length() < AutomaticGroupPrefixSize )
         return {};
     auto nbChar = utils::str::utf8::nbChars( prefix );
-    static const std::string req = "SELECT * FROM " + Table::Name +
+    static const sqlite::Request req{ "SELECT * FROM " + Table::Name +
             " WHERE forced_singleton = 0"
-            " AND SUBSTR(name, 1, ?) = ? COLLATE NOCASE";
+            " AND SUBSTR(name, 1, ?) = ? COLLATE NOCASE" };
     return fetchAll<MediaGroup>( ml, req, nbChar, prefix );
 }
 
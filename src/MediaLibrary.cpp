@@ -46,6 +46,7 @@
 #include "MediaLibrary.h"
 #include "Label.h"
 #include "logging/Logger.h"
+#include "logging/AsyncLogger.h"
 #include "logging/IostreamLogger.h"
 #include "Movie.h"
 #include "parser/Parser.h"
@@ -73,6 +74,8 @@
 #include "Deprecated.h"
 #include "Subscription.h"
 #include "Service.h"
+#include "CacheManifest.h"
+#include "MediaAggregate.h"
 
 // Discoverers:
 #include "discoverer/FsDiscoverer.h"
@@ -85,9 +88,13 @@
 #include "metadata_services/LinkService.h"
 
 #include "thumbnails/ThumbnailerWorker.h"
+#include "thumbnails/ThumbnailStore.h"
 
 // FileSystem
 #include "factory/DeviceListerFactory.h"
+#if defined(__linux__) && !defined(__ANDROID__)
+#include "filesystem/posix/FileSystemFactory.h"
+#endif
 
 #ifdef HAVE_LIBVLC
 #include "filesystem/libvlc/FileSystemFactory.h"
@@ -295,16 +302,58 @@ const std::vector<const char*> SupportedSubtitleExtensions = {
     "webvtt"
 };
 
+/*
+ * Measures a step of MediaLibrary::initialize and reports it to the
+ * application once done, or when going out of scope
+ */
+class InitializationStep
+{
+public:
+    InitializationStep( IMediaLibraryCb* cb, const char* name )
+        : m_cb( cb )
+        , m_name( name )
+        , m_start( std::chrono::steady_clock::now() )
+    {
+    }
+
+    ~InitializationStep()
+    {
+        done();
+    }
+
+    void done()
+    {
+        if ( m_name == nullptr )
+            return;
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - m_start );
+        LOG_DEBUG( "Initialization step \"", m_name, "\" took ",
+                   duration.count(), "us" );
+        if ( m_cb != nullptr )
+            m_cb->onInitializationStep( m_name, duration );
+        m_name = nullptr;
+    }
+
+private:
+    IMediaLibraryCb* m_cb;
+    const char* m_name;
+    std::chrono::steady_clock::time_point m_start;
+};
+
 }
 
 std::unique_ptr<MediaLibrary> MediaLibrary::create( const std::string& dbPath,
                                                     const std::string& mlFolderPath,
                                                     bool lockFile, const SetupConfig* cfg )
 {
+    std::shared_ptr<ILogger> logger;
     if ( cfg != nullptr && cfg->logger != nullptr )
-        Log::SetLogger( cfg->logger );
+        logger = cfg->logger;
     else
-        Log::SetLogger( std::make_shared<IostreamLogger>() );
+        logger = std::make_shared<IostreamLogger>();
+    if ( cfg != nullptr && cfg->asyncLogging == true )
+        logger = std::make_shared<AsyncLogger>( std::move( logger ) );
+    Log::SetLogger( std::move( logger ) );
     Log::setLogLevel( cfg != nullptr ? cfg->logLevel : LogLevel::Error );
 
     std::unique_ptr<LockFile> lock;
@@ -337,9 +386,24 @@ MediaLibrary::MediaLibrary( const std::string& dbPath,
     , m_parser( this, &m_fsHolder )
     , m_discovererWorker( this, &m_fsHolder )
     , m_cacheWorker( this )
+    , m_progressBuffer( this )
 {
     if ( cfg != nullptr )
     {
+        m_progressBuffer.setDurability( cfg->progressDurability,
+                                        cfg->progressFlushPeriod );
+        m_asyncQueryExecutor.setNbThreads( cfg->nbAsyncQueryThreads );
+        m_cacheWorker.setEvictionPolicy( cfg->cacheEvictionPolicy );
+        m_cacheWorker.setTransferLimits( cfg->maxCacheTransfers,
+                                         cfg->cacheBandwidthLimit );
+        if ( cfg->packThumbnails == true )
+            m_thumbnailStore = std::make_unique<ThumbnailStore>( this );
+        std::copy( std::begin( cfg->thumbnailEncoding ),
+                   std::end( cfg->thumbnailEncoding ),
+                   std::begin( m_thumbnailEncoding ) );
+        m_slowQueryThreshold = cfg->slowQueryThreshold;
+        m_lockPolicy = cfg->lockPolicy;
+        m_maxWriterBatch = cfg->maxWriterBatch;
         for ( const auto& p : cfg->deviceListers )
             m_fsHolder.registerDeviceLister( p.first, p.second );
         for ( const auto& fsf : cfg->fsFactories )
@@ -376,6 +440,8 @@ MediaLibrary::MediaLibrary( const std::string& dbPath,
 MediaLibrary::~MediaLibrary()
 {
     stopBackgroundJobs();
+    if ( m_reportsSlowQueries == true )
+        sqlite::QueryMetrics::setSlowQueryHandler( {}, nullptr );
 }
 
 bool MediaLibrary::createAllTables()
@@ -420,6 +486,9 @@ bool MediaLibrary::createAllTables()
     MediaGroup::createTable( dbConn );
     Subscription::createTable( dbConn );
     Service::createTable( dbConn );
+    CacheManifest::createTable( dbConn );
+    MediaAggregate::createTable( dbConn );
+    ThumbnailStore::createTable( dbConn );
     return true;
 }
 
@@ -470,6 +539,10 @@ void MediaLibrary::deleteAllTables( sqlite::Connection* dbConn )
         Subscription::Table::Name,
         Subscription::FtsTable::Name,
         Subscription::MediaRelationTable::Name,
+        CacheManifest::Table::Name,
+        MediaAggregate::Table::Name,
+        ThumbnailStore::Table::Name,
+        ThumbnailStore::SegmentTable::Name,
         "Settings",
     };
     for ( const auto& table : tables )
@@ -526,11 +599,53 @@ void MediaLibrary::createAllTriggers()
     Subscription::createTriggers( dbConn );
     Subscription::createIndexes( dbConn );
     Service::createTriggers( dbConn );
+    CacheManifest::createIndexes( dbConn );
+    MediaAggregate::createTriggers( dbConn );
+    MediaAggregate::createIndexes( dbConn );
+    ThumbnailStore::createIndexes( dbConn );
 }
 
 bool MediaLibrary::checkDatabaseIntegrity()
 {
-    auto schemaOk = Device::checkDbModel( this ) &&
+    uint32_t fingerprint;
+    {
+        OPEN_READ_CONTEXT( ctx, m_dbConnection );
+        fingerprint = m_dbConnection->schemaFingerprint();
+        /*
+         * Introspecting the schema of each entity is costly, and pointless if
+         * the schema didn't change since the last successful check
+         */
+        if ( fingerprint != m_dbConnection->checkedSchemaFingerprint() &&
+             checkDatabaseSchema() == false )
+            return false;
+        if ( m_dbConnection->checkSchemaIntegrity() == false ||
+             m_dbConnection->checkForeignKeysIntegrity() == false )
+            return false;
+    }
+    m_dbConnection->setCheckedSchemaFingerprint( fingerprint );
+    return true;
+}
+
+bool MediaLibrary::checkModifiedSchema( IMediaLibraryCb* mlCallback )
+{
+    {
+        OPEN_READ_CONTEXT( ctx, m_dbConnection );
+        if ( m_dbConnection->schemaFingerprint() ==
+             m_dbConnection->checkedSchemaFingerprint() )
+            return true;
+    }
+    /*
+     * The schema was created by a previous run, or modified since it was last
+     * checked, for instance by an external tool
+     */
+    InitializationStep integrityStep{ mlCallback, "integrity" };
+    LOG_INFO( "Database schema changed since it was last checked, verifying it" );
+    return checkDatabaseIntegrity();
+}
+
+bool MediaLibrary::checkDatabaseSchema()
+{
+    return Device::checkDbModel( this ) &&
             Folder::checkDbModel( this ) &&
             Thumbnail::checkDbModel( this ) &&
             Media::checkDbModel( this ) &&
@@ -551,10 +666,10 @@ bool MediaLibrary::checkDatabaseIntegrity()
             Chapter::checkDbModel( this ) &&
             Bookmark::checkDbModel( this ) &&
             MediaGroup::checkDbModel( this ) &&
-            Subscription::checkDbModel( this );
-    return schemaOk == true &&
-            m_dbConnection->checkSchemaIntegrity() == true &&
-            m_dbConnection->checkForeignKeysIntegrity() == true;
+            Subscription::checkDbModel( this ) &&
+            CacheManifest::checkDbModel( this ) &&
+            MediaAggregate::checkDbModel( this ) &&
+            ThumbnailStore::checkDbModel( this );
 }
 
 void MediaLibrary::registerEntityHooks()
@@ -634,6 +749,8 @@ void MediaLibrary::registerEntityHooks()
 
 void MediaLibrary::removeThumbnails()
 {
+    if ( m_thumbnailStore != nullptr )
+        m_thumbnailStore->reset();
     auto thumbnailsFolderMrl = utils::file::toMrl( m_thumbnailPath );
     auto fsFactory = fsFactoryForMrl( thumbnailsFolderMrl );
     if ( fsFactory == nullptr )
@@ -669,6 +786,7 @@ InitializeResult MediaLibrary::initialize( IMediaLibraryCb* mlCallback )
     LOG_INFO( "Current version is " PROJECT_VERSION ". Database model is ",
               Settings::DbModelVersion );
 
+    InitializationStep dirStep{ mlCallback, "directories" };
     auto mlFolder = utils::file::toFolderPath( m_mlFolderPath );
     if ( utils::fs::mkdir( m_thumbnailPath ) == false )
     {
@@ -688,9 +806,21 @@ InitializeResult MediaLibrary::initialize( IMediaLibraryCb* mlCallback )
                     ": ", strerror( errno ) );
         return InitializeResult::Failed;
     }
+    dirStep.done();
 
+    InitializationStep dbStep{ mlCallback, "database" };
     m_callback = mlCallback;
+    if ( m_slowQueryThreshold.count() > 0 && mlCallback != nullptr )
+    {
+        sqlite::QueryMetrics::setSlowQueryHandler( m_slowQueryThreshold,
+            [mlCallback]( const std::string& sql, std::chrono::microseconds duration,
+                          const std::string& queryPlan ) {
+                mlCallback->onSlowQuery( sql, duration, queryPlan );
+        });
+        m_reportsSlowQueries = true;
+    }
     m_dbConnection = sqlite::Connection::connect( m_dbPath );
+    m_dbConnection->setLockPolicy( m_lockPolicy, m_maxWriterBatch );
 
     onDbConnectionReady( m_dbConnection.get() );
 
@@ -711,10 +841,12 @@ InitializeResult MediaLibrary::initialize( IMediaLibraryCb* mlCallback )
     // This will be done when the user explicitly
     // invokes IMediaLibrary::setDiscoverNetworkEnabled
     populateNetworkFsFactories();
+    dbStep.done();
 
     auto res = InitializeResult::Success;
     try
     {
+        InitializationStep settingsStep{ mlCallback, "settings" };
         auto t = m_dbConnection->newTransaction();
         Settings::createTable( m_dbConnection.get() );
         if ( m_settings.load() == false )
@@ -729,6 +861,16 @@ InitializeResult MediaLibrary::initialize( IMediaLibraryCb* mlCallback )
                 return InitializeResult::Failed;
             createAllTriggers();
             t->commit();
+            /*
+             * We just created the schema ourselves, so there's no need to
+             * verify it upon next startup
+             */
+            uint32_t fingerprint;
+            {
+                OPEN_READ_CONTEXT( ctx, m_dbConnection );
+                fingerprint = m_dbConnection->schemaFingerprint();
+            }
+            m_dbConnection->setCheckedSchemaFingerprint( fingerprint );
         }
         else
         {
@@ -738,8 +880,10 @@ InitializeResult MediaLibrary::initialize( IMediaLibraryCb* mlCallback )
              * each version migration
              */
             t->commit();
+            settingsStep.done();
             if ( dbModel != Settings::DbModelVersion )
             {
+                InitializationStep migrationStep{ mlCallback, "migration" };
                 res = updateDatabaseModel( dbModel );
                 if ( res == InitializeResult::Failed )
                 {
@@ -747,6 +891,11 @@ InitializeResult MediaLibrary::initialize( IMediaLibraryCb* mlCallback )
                     return res;
                 }
             }
+            else if ( checkModifiedSchema( mlCallback ) == false )
+            {
+                LOG_ERROR( "The database schema doesn't match the expected one" );
+                res = InitializeResult::DbCorrupted;
+            }
         }
     }
     catch ( const sqlite::errors::Exception& ex )
@@ -762,7 +911,12 @@ InitializeResult MediaLibrary::initialize( IMediaLibraryCb* mlCallback )
          * initialized, and let the application handle what to do with its
          * corrupted database
          */
+        InitializationStep devicesStep{ mlCallback, "devices" };
         Device::markNetworkAsDeviceMissing( this );
+        if ( m_thumbnailStore != nullptr )
+            m_thumbnailStore->initialize();
+        else if ( ThumbnailStore{ this }.unpack() == false )
+            LOG_WARN( "Failed to unpack the previously packed thumbnails" );
         LOG_INFO( "Successfully initialized" );
     }
     else
@@ -776,6 +930,7 @@ InitializeResult MediaLibrary::initialize( IMediaLibraryCb* mlCallback )
      * the idle callback will be invoked with the lock held, which would deadlock.
      */
     lock.unlock();
+    InitializationStep parserStep{ mlCallback, "parser" };
     auto parser = getParser();
     if ( parser != nullptr )
         parser->start();
@@ -1336,6 +1491,7 @@ void MediaLibrary::onDbConnectionReady( sqlite::Connection* )
 
 void MediaLibrary::stopBackgroundJobs()
 {
+    m_asyncQueryExecutor.stop();
     m_cacheWorker.stop();
     {
         std::lock_guard<compat::Mutex> lock{ m_thumbnailerWorkerMutex };
@@ -1344,11 +1500,18 @@ void MediaLibrary::stopBackgroundJobs()
     // Explicitly stop the discoverer, to avoid it writing while tearing down.
     m_discovererWorker.stop();
     m_parser.stop();
+    // Write the pending progress updates once nothing else is writing anymore
+    m_progressBuffer.stop();
 }
 
 void MediaLibrary::addLocalFsFactory()
 {
-#ifdef HAVE_LIBVLC
+#if defined(__linux__) && !defined(__ANDROID__)
+    if ( m_fsHolder.addFsFactory( std::make_shared<fs::posix::FileSystemFactory>() ) == false )
+    {
+        assert( !"Can't add local file system factory" );
+    }
+#elif defined(HAVE_LIBVLC)
     if ( m_fsHolder.addFsFactory( std::make_shared<fs::libvlc::FileSystemFactory>( "file://" ) ) == false )
     {
         assert( !"Can't add local file system factory" );
@@ -1538,6 +1701,46 @@ InitializeResult MediaLibrary::updateDatabaseModel( unsigned int previousVersion
                 migrateModel38to39();
                 previousVersion = 39;
             }
+            if ( previousVersion == 39 )
+            {
+                migrateModel39to40();
+                previousVersion = 40;
+            }
+            if ( previousVersion == 40 )
+            {
+                migrateModel40to41();
+                previousVersion = 41;
+            }
+            if ( previousVersion == 41 )
+            {
+                migrateModel41to42();
+                previousVersion = 42;
+            }
+            if ( previousVersion == 42 )
+            {
+                migrateModel42to43();
+                previousVersion = 43;
+            }
+            if ( previousVersion == 43 )
+            {
+                migrateModel43to44();
+                previousVersion = 44;
+            }
+            if ( previousVersion == 44 )
+            {
+                migrateModel44to45();
+                previousVersion = 45;
+            }
+            if ( previousVersion == 45 )
+            {
+                migrateModel45to46();
+                previousVersion = 46;
+            }
+            if ( previousVersion == 46 )
+            {
+                migrateModel46to47();
+                previousVersion = 47;
+            }
             // To be continued in the future!
 
             migrationEpilogue( originalPreviousVersion );
@@ -1572,8 +1775,6 @@ InitializeResult MediaLibrary::updateDatabaseModel( unsigned int previousVersion
     assert( previousVersion == Settings::DbModelVersion );
     assert( previousVersion == m_settings.dbModelVersion() );
 
-
-    auto ctx = getConn()->acquireReadContext();
     if ( checkDatabaseIntegrity() == false )
         return InitializeResult::DbCorrupted;
 
@@ -2235,6 +2436,157 @@ void MediaLibrary::migrateModel38to39()
     t->commit();
 }
 
+void MediaLibrary::migrateModel39to40()
+{
+    auto dbConn = getConn();
+    sqlite::Connection::WeakDbContext weakConnCtx{ dbConn };
+    auto t = dbConn->newTransaction();
+
+    std::string reqs[] = {
+#       include "database/migrations/migration39-40.sql"
+    };
+
+    for ( const auto& req : reqs )
+        sqlite::Tools::executeRequest( dbConn, req );
+
+    m_settings.setDbModelVersion( 40 );
+    t->commit();
+}
+
+void MediaLibrary::migrateModel40to41()
+{
+    auto dbConn = getConn();
+    sqlite::Connection::WeakDbContext weakConnCtx{ dbConn };
+    auto t = dbConn->newTransaction();
+
+    std::string reqs[] = {
+#       include "database/migrations/migration40-41.sql"
+    };
+
+    for ( const auto& req : reqs )
+        sqlite::Tools::executeRequest( dbConn, req );
+
+    m_settings.setDbModelVersion( 41 );
+    t->commit();
+}
+
+void MediaLibrary::migrateModel41to42()
+{
+    auto dbConn = getConn();
+    sqlite::Connection::WeakDbContext weakConnCtx{ dbConn };
+    auto t = dbConn->newTransaction();
+
+    std::string reqs[] = {
+#       include "database/migrations/migration41-42.sql"
+    };
+
+    for ( const auto& req : reqs )
+        sqlite::Tools::executeRequest( dbConn, req );
+
+    /*
+     * Seed the manifest with the known cached files. Their modification date
+     * is unknown, so the cache worker only compares their size and records
+     * their modification date the next time it checks the cache.
+     */
+    auto cachedFiles = File::cachedFiles( this );
+    for ( const auto& f : cachedFiles )
+    {
+        if ( CacheManifest::commit( this, CacheManifest::fileName( f->mrl() ),
+                                    f->id(), f->size(), 0 ) == false )
+            throw std::runtime_error( "Failed to add cached file #" +
+                                      std::to_string( f->id() ) +
+                                      " to the cache manifest" );
+    }
+
+    m_settings.setDbModelVersion( 42 );
+    t->commit();
+}
+
+void MediaLibrary::migrateModel42to43()
+{
+    auto dbConn = getConn();
+    sqlite::Connection::WeakDbContext weakConnCtx{ dbConn };
+    auto t = dbConn->newTransaction();
+
+    std::string reqs[] = {
+#       include "database/migrations/migration42-43.sql"
+    };
+
+    for ( const auto& req : reqs )
+        sqlite::Tools::executeRequest( dbConn, req );
+
+    m_settings.setDbModelVersion( 43 );
+    t->commit();
+}
+
+void MediaLibrary::migrateModel43to44()
+{
+    auto dbConn = getConn();
+    sqlite::Connection::WeakDbContext weakConnCtx{ dbConn };
+    auto t = dbConn->newTransaction();
+
+    std::string reqs[] = {
+#       include "database/migrations/migration43-44.sql"
+    };
+
+    for ( const auto& req : reqs )
+        sqlite::Tools::executeRequest( dbConn, req );
+
+    m_settings.setDbModelVersion( 44 );
+    t->commit();
+}
+
+void MediaLibrary::migrateModel44to45()
+{
+    auto dbConn = getConn();
+    sqlite::Connection::WeakDbContext weakConnCtx{ dbConn };
+    auto t = dbConn->newTransaction();
+
+    std::string reqs[] = {
+#       include "database/migrations/migration44-45.sql"
+    };
+
+    for ( const auto& req : reqs )
+        sqlite::Tools::executeRequest( dbConn, req );
+
+    m_settings.setDbModelVersion( 45 );
+    t->commit();
+}
+
+void MediaLibrary::migrateModel45to46()
+{
+    auto dbConn = getConn();
+    sqlite::Connection::WeakDbContext weakConnCtx{ dbConn };
+    auto t = dbConn->newTransaction();
+
+    std::string reqs[] = {
+#       include "database/migrations/migration45-46.sql"
+    };
+
+    for ( const auto& req : reqs )
+        sqlite::Tools::executeRequest( dbConn, req );
+
+    m_settings.setDbModelVersion( 46 );
+    t->commit();
+}
+
+void MediaLibrary::migrateModel46to47()
+{
+    auto dbConn = getConn();
+    sqlite::Connection::WeakDbContext weakConnCtx{ dbConn };
+    auto t = dbConn->newTransaction();
+
+    std::string reqs[] = {
+#       include "database/migrations/migration46-47.sql"
+    };
+
+    for ( const auto& req : reqs )
+        sqlite::Tools::executeRequest( dbConn, req );
+
+    m_settings.setDbModelVersion( 47 );
+    t->commit();
+}
+
 void MediaLibrary::migrationEpilogue( uint32_t )
 {
 }
@@ -2426,11 +2778,32 @@ ThumbnailerWorker* MediaLibrary::thumbnailer() const
     return m_thumbnailerWorker.get();
 }
 
-CacheWorker& MediaLibrary::cacheWorker()
+ThumbnailStore* MediaLibrary::thumbnailStore() const
+{
+    return m_thumbnailStore.get();
+}
+
+const ThumbnailEncoding& MediaLibrary::thumbnailEncoding( ThumbnailSizeType sizeType ) const
+{
+    assert( sizeType < ThumbnailSizeType::Count );
+    return m_thumbnailEncoding[static_cast<size_t>( sizeType )];
+}
+
+CacheWorker& MediaLibrary::cacheWorker() const
 {
     return m_cacheWorker;
 }
 
+ProgressBuffer& MediaLibrary::progressBuffer() const
+{
+    return m_progressBuffer;
+}
+
+AsyncQueryExecutor& MediaLibrary::asyncQueryExecutor() const
+{
+    return m_asyncQueryExecutor;
+}
+
 DeviceListerPtr MediaLibrary::deviceLister( const std::string& scheme ) const
 {
     return m_fsHolder.deviceLister( scheme );
@@ -2644,6 +3017,11 @@ bool MediaLibrary::flushUserProvidedThumbnails()
     return Thumbnail::flushUserProvided( this );
 }
 
+bool MediaLibrary::flushPlaybackProgress()
+{
+    return m_progressBuffer.flush();
+}
+
 SubscriptionPtr MediaLibrary::subscription( int64_t subscriptionId ) const
 {
     return Subscription::fetch( this, subscriptionId );
@@ -2684,6 +3062,11 @@ void MediaLibrary::cacheNewSubscriptionMedia()
     m_cacheWorker.cacheSubscriptions();
 }
 
+bool MediaLibrary::repairCache()
+{
+    return m_cacheWorker.repairCache();
+}
+
 ServicePtr MediaLibrary::service( IService::Type type ) const
 {
     return Service::fetch( this, type );
@@ -2739,4 +3122,24 @@ bool MediaLibrary::refreshAllSubscriptions()
     return status;
 }
 
+std::vector<QueryStats> MediaLibrary::queryStats() const
+{
+    return sqlite::QueryMetrics::snapshot();
+}
+
+void MediaLibrary::resetQueryStats()
+{
+    sqlite::QueryMetrics::reset();
+}
+
+std::vector<LockStats> MediaLibrary::lockStats() const
+{
+    return m_dbConnection->lockStats();
+}
+
+void MediaLibrary::resetLockStats()
+{
+    m_dbConnection->resetLockStats();
+}
+
 }
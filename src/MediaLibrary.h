@@ -37,6 +37,8 @@
 #include "discoverer/DiscovererWorker.h"
 #include "parser/Parser.h"
 #include "CacheWorker.h"
+#include "ProgressBuffer.h"
+#include "database/AsyncQueryExecutor.h"
 
 #include <atomic>
 
@@ -46,6 +48,7 @@ namespace medialibrary
 class ModificationNotifier;
 class DiscovererWorker;
 class ThumbnailerWorker;
+class ThumbnailStore;
 
 class Album;
 class Artist;
@@ -235,7 +238,15 @@ public:
     std::shared_ptr<ModificationNotifier> getNotifier() const;
     virtual parser::Parser* getParser() const;
     ThumbnailerWorker* thumbnailer() const;
-    CacheWorker& cacheWorker();
+    /**
+     * @brief thumbnailStore Returns the packed thumbnail store, or nullptr if
+     * the thumbnails aren't packed
+     */
+    ThumbnailStore* thumbnailStore() const;
+    const ThumbnailEncoding& thumbnailEncoding( ThumbnailSizeType sizeType ) const;
+    CacheWorker& cacheWorker() const;
+    ProgressBuffer& progressBuffer() const;
+    AsyncQueryExecutor& asyncQueryExecutor() const;
 
     virtual DeviceListerPtr deviceLister( const std::string& scheme ) const override;
 
@@ -270,6 +281,7 @@ public:
     virtual PriorityAccess acquirePriorityAccess() override;
 
     virtual bool flushUserProvidedThumbnails() override;
+    virtual bool flushPlaybackProgress() override;
 
     virtual SubscriptionPtr subscription( int64_t id ) const override;
     virtual bool removeSubscription( int64_t subscriptionId ) override;
@@ -277,6 +289,7 @@ public:
     virtual bool fitsInSubscriptionCache( const IMedia& m ) const override;
 
     virtual void cacheNewSubscriptionMedia() override;
+    virtual bool repairCache() override;
 
     virtual ServicePtr service( IService::Type type ) const override;
     virtual SubscriptionPtr subscription(uint64_t id) const override;
@@ -290,6 +303,11 @@ public:
     virtual uint64_t getMaxCacheSize() const override;
     virtual bool refreshAllSubscriptions() override;
 
+    virtual std::vector<QueryStats> queryStats() const override;
+    virtual void resetQueryStats() override;
+    virtual std::vector<LockStats> lockStats() const override;
+    virtual void resetLockStats() override;
+
 protected:
     virtual void startDeletionNotifier();
     virtual void populateNetworkFsFactories();
@@ -336,6 +354,14 @@ private:
     void migrateModel36to37();
     void migrateModel37to38();
     void migrateModel38to39();
+    void migrateModel39to40();
+    void migrateModel40to41();
+    void migrateModel41to42();
+    void migrateModel42to43();
+    void migrateModel43to44();
+    void migrateModel44to45();
+    void migrateModel45to46();
+    void migrateModel46to47();
     /**
      * Runs some migration steps that depend on the actual C++ code, and that
      * therefore require the migration to have already completed
@@ -344,6 +370,12 @@ private:
     bool createAllTables();
     void createAllTriggers();
     bool checkDatabaseIntegrity();
+    /*
+     * Runs checkDatabaseIntegrity if the schema changed since the last
+     * successful check
+     */
+    bool checkModifiedSchema( IMediaLibraryCb* mlCallback );
+    bool checkDatabaseSchema();
     void registerEntityHooks();
     void removeThumbnails();
     void startThumbnailer() const;
@@ -376,6 +408,13 @@ protected:
     FsHolder m_fsHolder;
 
     mutable std::shared_ptr<IThumbnailer> m_thumbnailer;
+    std::unique_ptr<ThumbnailStore> m_thumbnailStore;
+    ThumbnailEncoding m_thumbnailEncoding[static_cast<size_t>( ThumbnailSizeType::Count )];
+    std::chrono::milliseconds m_slowQueryThreshold{ 0 };
+    /* true if this instance installed the slow query handler */
+    bool m_reportsSlowQueries = false;
+    LockPolicy m_lockPolicy = LockPolicy::ReaderPreferring;
+    uint32_t m_maxWriterBatch = 0;
     // Keep the parser as last field.
     // The parser holds a (raw) pointer to the media library. When MediaLibrary's destructor gets called
     // it might still finish a few operations before exiting the parser thread. Those operations are
@@ -388,7 +427,9 @@ protected:
     std::shared_ptr<ModificationNotifier> m_modificationNotifier;
     mutable compat::Mutex m_thumbnailerWorkerMutex;
     mutable std::unique_ptr<ThumbnailerWorker> m_thumbnailerWorker;
-    CacheWorker m_cacheWorker;
+    mutable CacheWorker m_cacheWorker;
+    mutable ProgressBuffer m_progressBuffer;
+    mutable AsyncQueryExecutor m_asyncQueryExecutor;
 };
 
 }
@@ -95,8 +95,8 @@ void Metadata::init( int64_t entityId, uint32_t nbMeta )
     // to another IMediaMetadata held by another thread.
     // This guarantees the vector will not grow afterward.
     m_records.reserve( m_nbMeta );
-    static const std::string req = "SELECT * FROM " + Metadata::Table::Name +
-            " WHERE id_media = ? AND entity_type = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + Metadata::Table::Name +
+            " WHERE id_media = ? AND entity_type = ?" };
     auto conn = m_ml->getConn();
     auto ctx = conn->acquireReadContext();
     sqlite::Statement stmt( ctx.handle(), req );
@@ -151,8 +151,8 @@ bool Metadata::set( uint32_t type, const std::string& value )
         m_records.emplace_back( type, value );
     try
     {
-        static const std::string req = "INSERT OR REPLACE INTO " + Metadata::Table::Name +
-                "(id_media, entity_type, type, value) VALUES(?, ?, ?, ?)";
+        static const sqlite::Request req{ "INSERT OR REPLACE INTO " + Metadata::Table::Name +
+                "(id_media, entity_type, type, value) VALUES(?, ?, ?, ?)" };
 
         if ( sqlite::Tools::executeInsert( m_ml->getConn(), req, m_entityId, m_entityType,
                                           type, value ) == false )
@@ -187,8 +187,8 @@ bool Metadata::unset( uint32_t type )
     });
     if ( it != end( m_records ) )
     {
-        static const std::string req = "DELETE FROM " + Metadata::Table::Name +
-                " WHERE id_media = ? AND entity_type = ? AND type = ?";
+        static const sqlite::Request req{ "DELETE FROM " + Metadata::Table::Name +
+                " WHERE id_media = ? AND entity_type = ? AND type = ?" };
         (*it).unset();
         return sqlite::Tools::executeDelete( m_ml->getConn(), req, m_entityId,
                                              m_entityType, type );
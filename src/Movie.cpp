@@ -64,8 +64,8 @@ const std::string& Movie::shortSummary() const
 
 bool Movie::setShortSummary( const std::string& summary )
 {
-    static const std::string req = "UPDATE " + Movie::Table::Name
-            + " SET summary = ? WHERE id_movie = ?";
+    static const sqlite::Request req{ "UPDATE " + Movie::Table::Name
+            + " SET summary = ? WHERE id_movie = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, summary, m_id ) == false )
         return false;
     m_summary = summary;
@@ -79,8 +79,8 @@ const std::string& Movie::imdbId() const
 
 bool Movie::setImdbId( const std::string& imdbId )
 {
-    static const std::string req = "UPDATE " + Movie::Table::Name
-            + " SET imdb_id = ? WHERE id_movie = ?";
+    static const sqlite::Request req{ "UPDATE " + Movie::Table::Name
+            + " SET imdb_id = ? WHERE id_movie = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, imdbId, m_id ) == false )
         return false;
     m_imdbId = imdbId;
@@ -145,8 +145,8 @@ bool Movie::checkDbModel(MediaLibraryPtr ml)
 std::shared_ptr<Movie> Movie::create(MediaLibraryPtr ml, int64_t mediaId )
 {
     auto movie = std::make_shared<Movie>( ml, mediaId );
-    static const std::string req = "INSERT INTO " + Movie::Table::Name
-            + "(media_id) VALUES(?)";
+    static const sqlite::Request req{ "INSERT INTO " + Movie::Table::Name
+            + "(media_id) VALUES(?)" };
     if ( insert( ml, movie, req, mediaId ) == false )
         return nullptr;
     return movie;
@@ -154,7 +154,7 @@ std::shared_ptr<Movie> Movie::create(MediaLibraryPtr ml, int64_t mediaId )
 
 MoviePtr Movie::fromMedia( MediaLibraryPtr ml, int64_t mediaId )
 {
-    static const std::string req = "SELECT * FROM " + Movie::Table::Name + " WHERE media_id = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + Movie::Table::Name + " WHERE media_id = ?" };
     return fetch( ml, req, mediaId );
 }
 
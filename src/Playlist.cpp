@@ -98,8 +98,8 @@ Playlist::Playlist( MediaLibraryPtr ml, std::string name )
 std::shared_ptr<Playlist> Playlist::create( MediaLibraryPtr ml, std::string name )
 {
     auto self = std::make_shared<Playlist>( ml, std::move( name ) );
-    static const std::string req = "INSERT INTO " + Playlist::Table::Name +
-            "(name, creation_date, artwork_mrl) VALUES(?, ?, ?)";
+    static const sqlite::Request req{ "INSERT INTO " + Playlist::Table::Name +
+            "(name, creation_date, artwork_mrl) VALUES(?, ?, ?)" };
     if ( insert( ml, self, req, self->m_name, self->m_creationDate,
                  self->m_artworkMrl ) == false )
         return nullptr;
@@ -120,7 +120,7 @@ bool Playlist::setName( const std::string& name )
 {
     if ( name == m_name )
         return true;
-    static const std::string req = "UPDATE " + Playlist::Table::Name + " SET name = ? WHERE id_playlist = ?";
+    static const sqlite::Request req{ "UPDATE " + Playlist::Table::Name + " SET name = ? WHERE id_playlist = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, name, m_id ) == false )
         return false;
     m_name = name;
@@ -359,19 +359,19 @@ bool Playlist::addInternal( const std::vector<int64_t>& mediaList, uint32_t posi
     {
         if ( position == UINT32_MAX )
         {
-            static const std::string req = "INSERT INTO " + Playlist::MediaRelationTable::Name +
+            static const sqlite::Request req{ "INSERT INTO " + Playlist::MediaRelationTable::Name +
                     "(media_id, playlist_id, position) VALUES(?1, ?2, "
                     "(SELECT COUNT(media_id) FROM " + Playlist::MediaRelationTable::Name +
-                    " WHERE playlist_id = ?2))";
+                    " WHERE playlist_id = ?2))" };
             res = sqlite::Tools::executeInsert( m_ml->getConn(), req, mediaId,
                                                 m_id );
         }
         else
         {
-            static const std::string req = "INSERT INTO " + Playlist::MediaRelationTable::Name + " "
+            static const sqlite::Request req{ "INSERT INTO " + Playlist::MediaRelationTable::Name + " "
                     "(media_id, playlist_id, position) VALUES(?1, ?2,"
                     "min(?3, (SELECT COUNT(media_id) FROM " + Playlist::MediaRelationTable::Name +
-                    " WHERE playlist_id = ?2)))";
+                    " WHERE playlist_id = ?2)))" };
             res = sqlite::Tools::executeInsert( m_ml->getConn(), req, mediaId,
                                                m_id, position );
             position++;
@@ -456,8 +456,8 @@ bool Playlist::removeInternal( uint32_t position, uint32_t count , bool updateCo
         return false;
     }
 
-    static const std::string req = "DELETE FROM " + MediaRelationTable::Name +
-                                   " WHERE playlist_id = ? AND position >= ? AND position < ?";
+    static const sqlite::Request req{ "DELETE FROM " + MediaRelationTable::Name +
+                                   " WHERE playlist_id = ? AND position >= ? AND position < ?" };
     if ( sqlite::Tools::executeDelete( m_ml->getConn(), req, m_id, position, position + count ) == false )
         return false;
 
@@ -629,7 +629,7 @@ bool Playlist::isFavorite() const
 
 bool Playlist::setFavorite( bool favorite )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_playlist = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET is_favorite = ? WHERE id_playlist = ?" };
     if ( m_isFavorite == favorite )
         return true;
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, favorite, m_id ) == false )
@@ -1508,10 +1508,10 @@ Playlist::Backups Playlist::loadBackups( MediaLibraryPtr ml )
 
 std::shared_ptr<Playlist> Playlist::fromFile( MediaLibraryPtr ml, int64_t fileId )
 {
-    static const std::string req = "SELECT pl.* FROM " + Table::Name + " pl"
+    static const sqlite::Request req{ "SELECT pl.* FROM " + Table::Name + " pl"
             " INNER JOIN " + File::Table::Name + " f"
             " ON f.playlist_id = pl.id_playlist"
-            " WHERE f.id_file = ?";
+            " WHERE f.id_file = ?" };
     return fetch( ml, req, fileId );
 }
 
@@ -0,0 +1,290 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ProgressBuffer.h"
+#include "Media.h"
+#include "MediaLibrary.h"
+#include "database/SqliteTools.h"
+#include "logging/Logger.h"
+#include "utils/SWMRLock.h"
+
+#include <cassert>
+
+namespace medialibrary
+{
+
+ProgressBuffer::ProgressBuffer( MediaLibrary* ml )
+    : m_ml( ml )
+    , m_durability( ProgressDurability::Immediate )
+    , m_flushPeriod( 0 )
+    , m_run( true )
+    , m_syncRequested( 0 )
+    , m_syncDone( 0 )
+    , m_hasUpdates( false )
+    , m_historyHeads{ 0, 0, 0 }
+{
+}
+
+ProgressBuffer::~ProgressBuffer()
+{
+    stop();
+}
+
+void ProgressBuffer::setDurability( ProgressDurability durability,
+                                    std::chrono::seconds flushPeriod )
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    m_durability = durability;
+    m_flushPeriod = flushPeriod;
+}
+
+bool ProgressBuffer::isDeferred() const
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    return m_durability == ProgressDurability::Deferred && m_run == true;
+}
+
+void ProgressBuffer::record( int64_t mediaId, float position, int64_t time,
+                             time_t lastPlayedDate, bool played )
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    auto it = m_pending.find( mediaId );
+    if ( it == end( m_pending ) )
+    {
+        m_pending.emplace( mediaId, Progress{ position, time, lastPlayedDate,
+                                              played == true ? 1u : 0u } );
+    }
+    else
+    {
+        it->second.position = position;
+        it->second.time = time;
+        it->second.lastPlayedDate = lastPlayedDate;
+        if ( played == true )
+            ++it->second.nbPlays;
+    }
+    m_hasUpdates.store( true, std::memory_order_release );
+    if ( m_thread.joinable() == false )
+        m_thread = compat::Thread{ &ProgressBuffer::run, this };
+    else
+        m_cond.notify_all();
+}
+
+void ProgressBuffer::apply( int64_t mediaId, float& position, int64_t& time,
+                            unsigned int& playCount, time_t& lastPlayedDate ) const
+{
+    if ( m_hasUpdates.load( std::memory_order_acquire ) == false )
+        return;
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    /*
+     * The in flight updates might already have been written, in which case
+     * the play count we fetched from the database already accounts for them.
+     * Since we can't know, only apply the pending ones to the play count
+     */
+    auto it = m_pending.find( mediaId );
+    if ( it == cend( m_pending ) )
+    {
+        it = m_inFlight.find( mediaId );
+        if ( it == cend( m_inFlight ) )
+            return;
+    }
+    else
+        playCount += it->second.nbPlays;
+    position = it->second.position;
+    time = it->second.time;
+    lastPlayedDate = it->second.lastPlayedDate;
+}
+
+bool ProgressBuffer::flush()
+{
+    std::lock_guard<compat::Mutex> flushLock{ m_flushMutex };
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        if ( m_pending.empty() == true )
+            return true;
+        assert( m_inFlight.empty() == true );
+        std::swap( m_pending, m_inFlight );
+    }
+    auto res = write( m_inFlight );
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    if ( res == false )
+    {
+        /*
+         * Put the updates back in the pending queue, unless they were
+         * superseded while we were trying to write them
+         */
+        for ( const auto& p : m_inFlight )
+        {
+            auto it = m_pending.find( p.first );
+            if ( it == end( m_pending ) )
+                m_pending.emplace( p.first, p.second );
+            else
+                it->second.nbPlays += p.second.nbPlays;
+        }
+    }
+    m_inFlight.clear();
+    if ( m_pending.empty() == true )
+        m_hasUpdates.store( false, std::memory_order_release );
+    return res;
+}
+
+void ProgressBuffer::sync()
+{
+    if ( m_hasUpdates.load( std::memory_order_acquire ) == false )
+        return;
+    /*
+     * The background thread wouldn't be able to acquire the write context
+     * while this thread holds a context, so write the updates from here.
+     */
+    if ( sqlite::Connection::Context::isOpened(
+             sqlite::Connection::Context::Type::Read ) == true ||
+         sqlite::Connection::Context::isOpened(
+             sqlite::Connection::Context::Type::Write ) == true )
+    {
+        flush();
+        return;
+    }
+    {
+        std::unique_lock<compat::Mutex> lock{ m_mutex };
+        if ( m_run == true && m_thread.joinable() == true )
+        {
+            auto target = ++m_syncRequested;
+            m_cond.notify_all();
+            m_syncCond.wait( lock, [this, target]() {
+                return m_syncDone >= target || m_run == false;
+            });
+            if ( m_syncDone >= target )
+                return;
+        }
+    }
+    flush();
+}
+
+bool ProgressBuffer::write( const std::unordered_map<int64_t, Progress>& updates )
+{
+    static const sqlite::Request req{ "UPDATE " + Media::Table::Name + " SET "
+        "last_position = ?, last_time = ?, play_count = play_count + ?, "
+        "last_played_date = ? WHERE id_media = ?" };
+    try
+    {
+        auto dbConn = m_ml->getConn();
+        auto t = dbConn->newTransaction();
+        for ( const auto& p : updates )
+        {
+            /* The media might have been deleted since, which is fine */
+            sqlite::Tools::executeRequest( dbConn, req, p.second.position,
+                                           p.second.time, p.second.nbPlays,
+                                           p.second.lastPlayedDate, p.first );
+        }
+        t->commit();
+    }
+    catch ( const sqlite::errors::Exception& ex )
+    {
+        LOG_ERROR( "Failed to write ", updates.size(), " progress updates: ",
+                   ex.what() );
+        return false;
+    }
+    LOG_DEBUG( "Flushed ", updates.size(), " progress updates" );
+    return true;
+}
+
+void ProgressBuffer::stop()
+{
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_run = false;
+        m_cond.notify_all();
+        m_syncCond.notify_all();
+    }
+    if ( m_thread.joinable() == true )
+        m_thread.join();
+    flush();
+}
+
+bool ProgressBuffer::moveToHistoryHead( HistoryType type, int64_t mediaId )
+{
+    assert( type != HistoryType::Global );
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    auto& typeHead = m_historyHeads[static_cast<uint8_t>( type )];
+    auto& globalHead = m_historyHeads[static_cast<uint8_t>( HistoryType::Global )];
+    if ( typeHead == mediaId && globalHead == mediaId )
+        return false;
+    typeHead = mediaId;
+    globalHead = mediaId;
+    return true;
+}
+
+void ProgressBuffer::resetHistoryHead( HistoryType type )
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    if ( type == HistoryType::Global )
+    {
+        for ( auto& h : m_historyHeads )
+            h = 0;
+        return;
+    }
+    m_historyHeads[static_cast<uint8_t>( type )] = 0;
+    m_historyHeads[static_cast<uint8_t>( HistoryType::Global )] = 0;
+}
+
+void ProgressBuffer::run()
+{
+    LOG_INFO( "Starting progress write-behind thread" );
+    utils::SWMRLock::setThreadClient( LockClient::Background );
+    while ( true )
+    {
+        uint64_t syncTarget;
+        {
+            std::unique_lock<compat::Mutex> lock{ m_mutex };
+            m_cond.wait( lock, [this]() {
+                return m_pending.empty() == false || m_run == false ||
+                       m_syncRequested != m_syncDone;
+            });
+            if ( m_run == false )
+                break;
+            /*
+             * Give the player some time to report a few more updates, which
+             * will only result in a single write, unless a reader is waiting
+             * for them.
+             */
+            m_cond.wait_for( lock, m_flushPeriod, [this]() {
+                return m_run == false || m_syncRequested != m_syncDone;
+            });
+            if ( m_run == false )
+                break;
+            syncTarget = m_syncRequested;
+        }
+        flush();
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        if ( m_syncDone != syncTarget )
+        {
+            m_syncDone = syncTarget;
+            m_syncCond.notify_all();
+        }
+    }
+    LOG_INFO( "Exiting progress write-behind thread" );
+}
+
+}
@@ -0,0 +1,136 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include "compat/Thread.h"
+#include "compat/Mutex.h"
+#include "compat/ConditionVariable.h"
+#include "medialibrary/IMediaLibrary.h"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <unordered_map>
+
+namespace medialibrary
+{
+
+class MediaLibrary;
+
+/**
+ * @brief The ProgressBuffer class holds the playback progress updates until
+ * they get written to the database.
+ *
+ * In ProgressDurability::Immediate mode, the buffer is always empty and only
+ * tracks the history ordering.
+ * In ProgressDurability::Deferred mode, only the latest progress of each
+ * media is kept, and all the pending updates are written in a single
+ * transaction, either periodically from a background thread, or when flush()
+ * gets called explicitly.
+ */
+class ProgressBuffer
+{
+public:
+    struct Progress
+    {
+        float position;
+        int64_t time;
+        time_t lastPlayedDate;
+        uint32_t nbPlays;
+    };
+
+    explicit ProgressBuffer( MediaLibrary* ml );
+    ~ProgressBuffer();
+
+    void setDurability( ProgressDurability durability,
+                        std::chrono::seconds flushPeriod );
+    bool isDeferred() const;
+
+    /**
+     * @brief record Stores the latest progress of a media
+     * @param played true if the playback reached the end of the media and its
+     *               play count must be incremented.
+     */
+    void record( int64_t mediaId, float position, int64_t time,
+                 time_t lastPlayedDate, bool played );
+    /**
+     * @brief apply Overrides the provided values with the pending progress, if any
+     */
+    void apply( int64_t mediaId, float& position, int64_t& time,
+                unsigned int& playCount, time_t& lastPlayedDate ) const;
+    /**
+     * @brief flush Writes all the pending updates to the database
+     * @return false if the updates couldn't be written. They will be retried
+     *         upon next flush.
+     */
+    bool flush();
+    /**
+     * @brief sync Ensures the pending updates are written before returning
+     *
+     * This is a no-op when nothing is buffered. Otherwise the background thread
+     * is woken up to write the updates and the caller waits for it, so that
+     * a read-only caller doesn't have to acquire the write context itself.
+     */
+    void sync();
+    /**
+     * @brief stop Stops the background flushing thread and writes the pending
+     *        updates.
+     */
+    void stop();
+
+    /**
+     * @brief moveToHistoryHead Records the provided media as the most recently
+     *        played one.
+     * @return true if the history ordering changed, false if this media already
+     *         was the most recently played one.
+     */
+    bool moveToHistoryHead( HistoryType type, int64_t mediaId );
+    void resetHistoryHead( HistoryType type );
+
+private:
+    void run();
+    bool write( const std::unordered_map<int64_t, Progress>& updates );
+
+private:
+    MediaLibrary* m_ml;
+    mutable compat::Mutex m_mutex;
+    compat::Mutex m_flushMutex;
+    compat::ConditionVariable m_cond;
+    /* Signaled by the background thread once a requested sync is done */
+    compat::ConditionVariable m_syncCond;
+    compat::Thread m_thread;
+    ProgressDurability m_durability;
+    std::chrono::seconds m_flushPeriod;
+    bool m_run;
+    uint64_t m_syncRequested;
+    uint64_t m_syncDone;
+    std::unordered_map<int64_t, Progress> m_pending;
+    /* The updates being written by flush() */
+    std::unordered_map<int64_t, Progress> m_inFlight;
+    /* Allows apply() to skip locking when nothing is buffered */
+    std::atomic_bool m_hasUpdates;
+    /* Most recently played media, for the global, local & network histories */
+    int64_t m_historyHeads[3];
+};
+
+}
@@ -32,7 +32,7 @@
 namespace medialibrary
 {
 
-const uint32_t Settings::DbModelVersion = 39u;
+const uint32_t Settings::DbModelVersion = 47u;
 const uint32_t Settings::MaxTaskAttempts = 2u;
 const uint32_t Settings::MaxLinkTaskAttempts = 6u;
 const uint32_t Settings::DefaultNbCachedMediaPerSubscription = 2u;
@@ -44,6 +44,7 @@ Settings::Settings( MediaLibrary* ml )
     , m_dbModelVersion( 0 )
     , m_nbCachedMediaPerSubscription( 0 )
     , m_maxSubscriptionCacheSize( 0 )
+    , m_maxCacheSize( 0 )
 {
 }
 
@@ -54,8 +55,9 @@ bool Settings::load()
     // First launch: no settings
     if ( row == nullptr )
     {
-        if ( sqlite::Tools::executeInsert( m_ml->getConn(),
-                "INSERT INTO Settings VALUES(?, ?, ?, ?, ?, ?)",
+        static const sqlite::Request req{
+                "INSERT INTO Settings VALUES(?, ?, ?, ?, ?, ?)" };
+        if ( sqlite::Tools::executeInsert( m_ml->getConn(), req,
                 DbModelVersion, MaxTaskAttempts, MaxLinkTaskAttempts,
                 DefaultNbCachedMediaPerSubscription,
                 DefaultMaxSubscriptionCacheSize, DefaultCacheSize ) == false )
@@ -65,6 +67,7 @@ bool Settings::load()
         m_dbModelVersion = 0;
         m_nbCachedMediaPerSubscription = DefaultNbCachedMediaPerSubscription;
         m_maxSubscriptionCacheSize = DefaultMaxSubscriptionCacheSize;
+        m_maxCacheSize = DefaultCacheSize;
     }
     else
     {
@@ -73,6 +76,7 @@ bool Settings::load()
         {
             m_nbCachedMediaPerSubscription = row.load<decltype(m_nbCachedMediaPerSubscription)>( 3 );
             m_maxSubscriptionCacheSize = row.load<decltype(m_maxSubscriptionCacheSize)>( 4 );
+            m_maxCacheSize = row.load<decltype(m_maxCacheSize)>( 5 );
         }
         // safety check: there should only be one row
         assert( s.row() == nullptr );
@@ -88,7 +92,7 @@ uint32_t Settings::dbModelVersion() const
 bool Settings::setDbModelVersion( uint32_t dbModelVersion )
 {
     assert( dbModelVersion != m_dbModelVersion );
-    static const std::string req = "UPDATE Settings SET db_model_version = ?";
+    static const sqlite::Request req{ "UPDATE Settings SET db_model_version = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, dbModelVersion ) == false )
         return false;
     m_dbModelVersion = dbModelVersion;
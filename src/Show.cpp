@@ -27,6 +27,7 @@
 #include "Show.h"
 
 #include "Media.h"
+#include "MediaAggregate.h"
 #include "ShowEpisode.h"
 #include "MediaLibrary.h"
 #include "utils/Enums.h"
@@ -82,8 +83,8 @@ time_t Show::releaseDate() const
 
 bool Show::setReleaseDate( time_t date )
 {
-    static const std::string req = "UPDATE " + Show::Table::Name
-            + " SET release_date = ? WHERE id_show = ?";
+    static const sqlite::Request req{ "UPDATE " + Show::Table::Name
+            + " SET release_date = ? WHERE id_show = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, date, m_id ) == false )
         return false;
     m_releaseDate = date;
@@ -97,8 +98,8 @@ const std::string& Show::shortSummary() const
 
 bool Show::setShortSummary( const std::string& summary )
 {
-    static const std::string req = "UPDATE " + Show::Table::Name
-            + " SET short_summary = ? WHERE id_show = ?";
+    static const sqlite::Request req{ "UPDATE " + Show::Table::Name
+            + " SET short_summary = ? WHERE id_show = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, summary, m_id ) == false )
         return false;
     m_shortSummary = summary;
@@ -112,8 +113,8 @@ const std::string& Show::artworkMrl() const
 
 bool Show::setArtworkMrl( const std::string& artworkMrl )
 {
-    static const std::string req = "UPDATE " + Show::Table::Name
-            + " SET artwork_mrl = ? WHERE id_show = ?";
+    static const sqlite::Request req{ "UPDATE " + Show::Table::Name
+            + " SET artwork_mrl = ? WHERE id_show = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, artworkMrl, m_id ) == false )
         return false;
     m_artworkMrl = artworkMrl;
@@ -127,8 +128,8 @@ const std::string& Show::tvdbId() const
 
 bool Show::setTvdbId( const std::string& tvdbId )
 {
-    static const std::string req = "UPDATE " + Show::Table::Name
-            + " SET tvdb_id = ? WHERE id_show = ?";
+    static const sqlite::Request req{ "UPDATE " + Show::Table::Name
+            + " SET tvdb_id = ? WHERE id_show = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, tvdbId, m_id ) == false )
         return false;
     m_tvdbId = tvdbId;
@@ -383,8 +384,8 @@ bool Show::checkDbModel(MediaLibraryPtr ml)
 std::shared_ptr<Show> Show::create( MediaLibraryPtr ml, std::string name )
 {
     auto show = std::make_shared<Show>( ml, std::move( name ) );
-    static const std::string req = "INSERT INTO " + Show::Table::Name
-            + "(title) VALUES(?)";
+    static const sqlite::Request req{ "INSERT INTO " + Show::Table::Name
+            + "(title) VALUES(?)" };
     if ( insert( ml, show, req, show->m_title ) == false )
         return nullptr;
     return show;
@@ -393,9 +394,21 @@ std::shared_ptr<Show> Show::create( MediaLibraryPtr ml, std::string name )
 Query<IShow> Show::listAll( MediaLibraryPtr ml, const QueryParameters* params )
 {
     std::string req = "FROM " + Show::Table::Name;
+    std::string cond;
     if ( params == nullptr || params->includeMissing == false )
-        req += " WHERE is_present != 0";
-    return make_query<Show, IShow>( ml, "*", std::move( req ), orderBy( params ) ).build();
+        cond = " is_present != 0";
+    if ( params != nullptr && params->publicOnly == true )
+    {
+        req += MediaAggregate::publicJoin( MediaAggregate::EntityType::Show,
+                                           Table::Name + ".id_show" );
+        if ( cond.empty() == false )
+            cond += " AND";
+        cond += MediaAggregate::publicCondition( params );
+    }
+    if ( cond.empty() == false )
+        req += " WHERE" + cond;
+    return make_query<Show, IShow>( ml, Table::Name + ".*", std::move( req ),
+                                    orderBy( params ) ).build();
 }
 
 std::string Show::orderBy( const QueryParameters* params )
@@ -85,8 +85,8 @@ const std::string& ShowEpisode::shortSummary() const
 
 bool ShowEpisode::setShortSummary( const std::string& summary )
 {
-    static const std::string req = "UPDATE " + Table::Name
-            + " SET episode_summary = ? WHERE id_episode = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name
+            + " SET episode_summary = ? WHERE id_episode = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, summary, m_id ) == false )
         return false;
     m_shortSummary = summary;
@@ -100,8 +100,8 @@ const std::string& ShowEpisode::tvdbId() const
 
 bool ShowEpisode::setTvdbId( const std::string& tvdbId )
 {
-    static const std::string req = "UPDATE " + Table::Name
-            + " SET tvdb_id = ? WHERE id_episode = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name
+            + " SET tvdb_id = ? WHERE id_episode = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, tvdbId, m_id ) == false )
         return false;
     m_tvdbId = tvdbId;
@@ -233,9 +233,9 @@ std::shared_ptr<ShowEpisode> ShowEpisode::create( MediaLibraryPtr ml,
 {
     auto episode = std::make_shared<ShowEpisode>( ml, mediaId, seasonId, episodeId,
                                                   std::move( title ), showId );
-    static const std::string req = "INSERT INTO " + Table::Name
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name
             + "(media_id, episode_number, season_number, episode_title, show_id)"
-            " VALUES(?, ?, ?, ?, ?)";
+            " VALUES(?, ?, ?, ?, ?)" };
     if ( insert( ml, episode, req, mediaId, episodeId, seasonId,
                  episode->title(), showId ) == false )
         return nullptr;
@@ -244,7 +244,7 @@ std::shared_ptr<ShowEpisode> ShowEpisode::create( MediaLibraryPtr ml,
 
 ShowEpisodePtr ShowEpisode::fromMedia( MediaLibraryPtr ml, int64_t mediaId )
 {
-    static const std::string req = "SELECT * FROM " + Table::Name + " WHERE media_id = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + Table::Name + " WHERE media_id = ?" };
     return fetch( ml, req, mediaId );
 }
 
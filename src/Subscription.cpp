@@ -247,6 +247,24 @@ Query<Media> Subscription::cachedMedia( bool evictableOnly ) const
                     IFile::Type::Cache ).build();
 }
 
+std::unordered_set<int64_t> Subscription::evictableCachedFiles() const
+{
+    const std::string req = "SELECT f.id_file FROM " + File::Table::Name + " f"
+            " INNER JOIN " + MediaRelationTable::Name + " mrt"
+            " ON f.media_id = mrt.media_id"
+            " INNER JOIN " + Media::Table::Name + " m ON m.id_media = f.media_id"
+            " WHERE mrt.subscription_id = ? AND f.type = ? AND"
+            " (f.cache_type = ? OR m.play_count > 0)";
+    OPEN_READ_CONTEXT( ctx, m_ml->getConn() );
+    sqlite::Statement stmt{ req };
+    stmt.execute( m_id, IFile::Type::Cache, File::CacheType::Automatic );
+    std::unordered_set<int64_t> fileIds;
+    sqlite::Row row;
+    while ( ( row = stmt.row() ) != nullptr )
+        fileIds.insert( row.extract<int64_t>() );
+    return fileIds;
+}
+
 std::vector<std::shared_ptr<Media>> Subscription::uncachedMedia( bool autoOnly ) const
 {
     std::string req = "SELECT m.* FROM " + Media::Table::Name + " m "
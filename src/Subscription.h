@@ -23,6 +23,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_set>
 #include "medialibrary/ISubscription.h"
 #include "database/DatabaseHelpers.h"
 #include "Service.h"
@@ -123,6 +124,14 @@ public:
      * been played, or if it was automatically cached.
      */
     Query<Media> cachedMedia(bool evictableOnly) const;
+    /**
+     * @brief evictableCachedFiles Returns the IDs of the cached files which can
+     *        be evicted from this subscription's cache.
+     *
+     * This uses the same eviction criteria as cachedMedia(true), but only
+     * fetches the file IDs so the eviction order can be decided by the caller.
+     */
+    std::unordered_set<int64_t> evictableCachedFiles() const;
     /**
      * @brief uncachedMedia Returns the uncached media in this collection
      * @param autoOnly If true, only the media not already handled by automatic
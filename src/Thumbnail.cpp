@@ -31,6 +31,7 @@
 #include "Album.h"
 #include "Artist.h"
 #include "Media.h"
+#include "thumbnails/ThumbnailStore.h"
 #include "medialibrary/filesystem/Errors.h"
 #include "medialibrary/parser/IItem.h"
 #include "utils/Enums.h"
@@ -167,9 +168,9 @@ bool Thumbnail::update( std::string mrl, bool isOwned )
         storedMrl = mrl;
     // Also include the current generated state to the request, in case this update
     // request came while the thumbnailer was also generating a thumbnail
-    static const std::string req = "UPDATE " + Table::Name +
+    static const sqlite::Request req{ "UPDATE " + Table::Name +
             " SET mrl = ?, status = ?, nb_attempts = 0, is_owned = ? "
-            "WHERE id_thumbnail = ? AND is_owned = ?";
+            "WHERE id_thumbnail = ? AND is_owned = ?" };
     if( sqlite::Tools::executeUpdate( m_ml->getConn(), req, storedMrl,
                                       ThumbnailStatus::Available, isOwned,
                                       m_id, m_isOwned ) == false )
@@ -256,6 +257,15 @@ ThumbnailStatus Thumbnail::status() const
     return m_status;
 }
 
+ThumbnailData Thumbnail::packedData() const
+{
+    auto store = m_ml->thumbnailStore();
+    if ( store == nullptr || m_status != ThumbnailStatus::Available ||
+         m_isOwned == false )
+        return {};
+    return store->read( m_mrl );
+}
+
 bool Thumbnail::markFailed()
 {
     const std::string req = "UPDATE " + Table::Name +
@@ -831,8 +841,8 @@ bool Thumbnail::removeAllCleanupRequests( MediaLibraryPtr ml )
 int64_t Thumbnail::insert()
 {
     assert( m_id == 0 );
-    static const std::string req = "INSERT INTO " + Table::Name +
-            "(mrl, status, is_owned, file_size, hash) VALUES(?, ?, ?, ?, ?)";
+    static const sqlite::Request req{ "INSERT INTO " + Table::Name +
+            "(mrl, status, is_owned, file_size, hash) VALUES(?, ?, ?, ?, ?)" };
     auto pKey = sqlite::Tools::executeInsert( m_ml->getConn(), req,
                             m_isOwned == true ? toRelativeMrl( m_mrl ) : m_mrl,
                             m_status, m_isOwned, m_fileSize, m_hash );
@@ -846,16 +856,20 @@ int64_t Thumbnail::insert()
                         m_embeddedThumbnail->extension();
         LOG_DEBUG( "Saving embedded thumbnail to ", destPath );
         m_embeddedThumbnail->save( destPath );
-        update( utils::file::toMrl( destPath ), true );
+        auto destMrl = utils::file::toMrl( destPath );
+        update( destMrl, true );
         m_embeddedThumbnail = nullptr;
+        auto store = m_ml->thumbnailStore();
+        if ( store != nullptr && store->pack( destMrl ) == false )
+            LOG_WARN( "Failed to pack embedded thumbnail ", destMrl );
     }
     return m_id;
 }
 
 bool Thumbnail::deleteFailureRecords(MediaLibraryPtr ml)
 {
-    static const std::string req = "DELETE FROM " + Table::Name +
-                                   " WHERE mrl IS NULL";
+    static const sqlite::Request req{ "DELETE FROM " + Table::Name +
+                                   " WHERE mrl IS NULL" };
     return sqlite::Tools::executeDelete( ml->getConn(), req );
 }
 
@@ -177,6 +177,11 @@ public:
     ThumbnailSizeType sizeType() const;
 
     ThumbnailStatus status() const;
+    /**
+     * @brief packedData Returns the thumbnail content if it was packed in the
+     *        thumbnail store, or an empty view otherwise.
+     */
+    ThumbnailData packedData() const;
     /**
      * @brief setErrorStatus Updates the status in case of an error
      * @param status An error status
@@ -153,8 +153,8 @@ std::shared_ptr<VideoTrack> VideoTrack::create( MediaLibraryPtr ml, std::string
 
 bool VideoTrack::removeFromMedia( MediaLibraryPtr ml, int64_t mediaId )
 {
-    static const std::string req = "DELETE FROM " + Table::Name + " "
-            "WHERE media_id = ?";
+    static const sqlite::Request req{ "DELETE FROM " + Table::Name + " "
+            "WHERE media_id = ?" };
     return sqlite::Tools::executeDelete( ml->getConn(), req, mediaId );
 }
 
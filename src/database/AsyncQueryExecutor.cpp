@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "AsyncQueryExecutor.h"
+#include "logging/Logger.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace medialibrary
+{
+
+AsyncQueryExecutor::AsyncQueryExecutor()
+    : m_nbThreads( 2 )
+    , m_nbIdle( 0 )
+    , m_stop( false )
+{
+}
+
+AsyncQueryExecutor::~AsyncQueryExecutor()
+{
+    stop();
+}
+
+void AsyncQueryExecutor::setNbThreads( uint32_t nbThreads )
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    m_nbThreads = std::max( nbThreads, 1u );
+}
+
+void AsyncQueryExecutor::submit( std::shared_ptr<Job> job )
+{
+    std::lock_guard<compat::Mutex> lock{ m_mutex };
+    if ( m_stop == true )
+        return;
+    auto range = m_queued.equal_range( job->key() );
+    for ( auto it = range.first; it != range.second; ++it )
+    {
+        if ( it->second->merge( *job ) == true )
+        {
+            LOG_DEBUG( "Coalescing request with a pending one" );
+            return;
+        }
+    }
+    m_queued.emplace( job->key(), job );
+    m_jobs.push_back( std::move( job ) );
+    if ( m_nbIdle == 0 && m_threads.size() < m_nbThreads )
+        m_threads.emplace_back( &AsyncQueryExecutor::work, this );
+    else
+        m_cond.notify_one();
+}
+
+void AsyncQueryExecutor::stop()
+{
+    std::vector<compat::Thread> threads;
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_stop = true;
+        m_jobs.clear();
+        m_queued.clear();
+        threads = std::move( m_threads );
+        m_cond.notify_all();
+    }
+    for ( auto& t : threads )
+        t.join();
+}
+
+void AsyncQueryExecutor::work()
+{
+    std::unique_lock<compat::Mutex> lock{ m_mutex };
+    while ( true )
+    {
+        if ( m_jobs.empty() == true )
+        {
+            ++m_nbIdle;
+            m_cond.wait( lock, [this]() {
+                return m_stop == true || m_jobs.empty() == false;
+            });
+            --m_nbIdle;
+        }
+        if ( m_stop == true )
+            break;
+        auto job = std::move( m_jobs.front() );
+        m_jobs.pop_front();
+        /*
+         * Once started, the job can't take over any other caller: it might
+         * read the database before the changes the caller expects to see.
+         */
+        removeQueued( *job );
+        lock.unlock();
+        if ( job->isCancelled() == false )
+            job->execute();
+        job->deliver();
+        job.reset();
+        lock.lock();
+    }
+}
+
+void AsyncQueryExecutor::removeQueued( const Job& job )
+{
+    auto range = m_queued.equal_range( job.key() );
+    auto it = std::find_if( range.first, range.second,
+        [&job]( const decltype(m_queued)::value_type& p ) {
+            return p.second.get() == &job;
+        });
+    if ( it != range.second )
+        m_queued.erase( it );
+}
+
+}
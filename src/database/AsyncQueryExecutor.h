@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include "compat/Thread.h"
+#include "compat/Mutex.h"
+#include "compat/ConditionVariable.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace medialibrary
+{
+
+/**
+ * @brief The AsyncQueryExecutor class runs read requests on a bounded pool
+ *
+ * The threads are spawned on demand, up to the configured limit. Jobs with the
+ * same key which are pending at the same time are merged, so that the request
+ * is only executed once. A job is never merged into a running one, which might
+ * have read the database before the new caller's last changes.
+ */
+class AsyncQueryExecutor
+{
+public:
+    class Job
+    {
+    public:
+        virtual ~Job() = default;
+        /* Identifies the request. Only jobs with the same key can be merged */
+        virtual const std::string& key() const = 0;
+        /* Identifies the job implementation */
+        virtual const void* type() const = 0;
+        /* Takes over the other job's callbacks, if both run the same request */
+        virtual bool merge( Job& job ) = 0;
+        /* Returns true if all the callbacks were cancelled */
+        virtual bool isCancelled() const = 0;
+        virtual void execute() = 0;
+        /* Invokes the callbacks which weren't cancelled with the result */
+        virtual void deliver() = 0;
+    };
+
+    AsyncQueryExecutor();
+    ~AsyncQueryExecutor();
+
+    void setNbThreads( uint32_t nbThreads );
+    void submit( std::shared_ptr<Job> job );
+    /**
+     * @brief stop Waits for the running jobs and drops the pending ones
+     */
+    void stop();
+
+private:
+    void work();
+    void removeQueued( const Job& job );
+
+private:
+    compat::Mutex m_mutex;
+    compat::ConditionVariable m_cond;
+    std::vector<compat::Thread> m_threads;
+    std::deque<std::shared_ptr<Job>> m_jobs;
+    /* The pending jobs, by key */
+    std::unordered_multimap<std::string, std::shared_ptr<Job>> m_queued;
+    uint32_t m_nbThreads;
+    uint32_t m_nbIdle;
+    bool m_stop;
+};
+
+}
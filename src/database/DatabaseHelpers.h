@@ -40,23 +40,19 @@ class DatabaseHelpers
         template <typename... Args>
         static std::shared_ptr<IMPL> fetch( MediaLibraryPtr ml, const std::string& req, Args&&... args )
         {
-            try
-            {
-                return sqlite::Tools::fetchOne<IMPL>( ml, req, std::forward<Args>( args )... );
-            }
-            catch ( const sqlite::errors::Exception& ex )
-            {
-                if ( sqlite::errors::isInnocuous( ex ) == false )
-                    throw;
-                LOG_WARN( "Ignoring innocuous error: ", ex.what() );
-            }
-            return {};
+            return fetchIgnoringErrors( ml, req, std::forward<Args>( args )... );
+        }
+
+        template <typename... Args>
+        static std::shared_ptr<IMPL> fetch( MediaLibraryPtr ml, const sqlite::Request& req, Args&&... args )
+        {
+            return fetchIgnoringErrors( ml, req, std::forward<Args>( args )... );
         }
 
         static std::shared_ptr<IMPL> fetch( MediaLibraryPtr ml, int64_t pkValue )
         {
-            static std::string req = "SELECT * FROM " + IMPL::Table::Name + " WHERE " +
-                    IMPL::Table::PrimaryKeyColumn + " = ?";
+            static const sqlite::Request req{ "SELECT * FROM " + IMPL::Table::Name +
+                    " WHERE " + IMPL::Table::PrimaryKeyColumn + " = ?" };
             try
             {
                 return sqlite::Tools::fetchOne<IMPL>( ml, req, pkValue );
@@ -75,7 +71,7 @@ class DatabaseHelpers
         template <typename INTF = IMPL>
         static std::vector<std::shared_ptr<INTF>> fetchAll( MediaLibraryPtr ml )
         {
-            static const std::string req = "SELECT * FROM " + IMPL::Table::Name;
+            static const sqlite::Request req{ "SELECT * FROM " + IMPL::Table::Name };
             try
             {
                 return sqlite::Tools::fetchAll<IMPL, INTF>( ml, req );
@@ -89,8 +85,8 @@ class DatabaseHelpers
             return {};
         }
 
-        template <typename INTF, typename... Args>
-        static std::vector<std::shared_ptr<INTF>> fetchAll( MediaLibraryPtr ml, const std::string& req, Args&&... args )
+        template <typename INTF, typename Req, typename... Args>
+        static std::vector<std::shared_ptr<INTF>> fetchAll( MediaLibraryPtr ml, const Req& req, Args&&... args )
         {
             try
             {
@@ -105,16 +101,53 @@ class DatabaseHelpers
             return {};
         }
 
+        template <typename INTF, typename Req, typename... Args>
+        static std::vector<std::shared_ptr<INTF>> fetchPage( MediaLibraryPtr ml, const Req& req,
+                                                             size_t& count, Args&&... args )
+        {
+            try
+            {
+                return sqlite::Tools::fetchPage<IMPL, INTF>( ml, req, count,
+                                                             std::forward<Args>( args )... );
+            }
+            catch ( const sqlite::errors::Exception& ex )
+            {
+                if ( sqlite::errors::isInnocuous( ex ) == false )
+                    throw;
+                LOG_WARN( "Ignoring innocuous error: ", ex.what() );
+            }
+            return {};
+        }
+
+        template <typename INTF, typename Req, typename Cb, typename... Args>
+        static bool forEach( MediaLibraryPtr ml, const Req& req, Cb&& cb,
+                             Args&&... args )
+        {
+            try
+            {
+                return sqlite::Tools::forEach<IMPL, INTF>( ml, req,
+                                                           std::forward<Cb>( cb ),
+                                                           std::forward<Args>( args )... );
+            }
+            catch ( const sqlite::errors::Exception& ex )
+            {
+                if ( sqlite::errors::isInnocuous( ex ) == false )
+                    throw;
+                LOG_WARN( "Ignoring innocuous error: ", ex.what() );
+            }
+            return false;
+        }
+
         static bool destroy( MediaLibraryPtr ml, int64_t pkValue )
         {
-            static const std::string req = "DELETE FROM " + IMPL::Table::Name + " WHERE "
-                    + IMPL::Table::PrimaryKeyColumn + " = ?";
+            static const sqlite::Request req{ "DELETE FROM " + IMPL::Table::Name +
+                    " WHERE " + IMPL::Table::PrimaryKeyColumn + " = ?" };
             return sqlite::Tools::executeDelete( ml->getConn(), req, pkValue );
         }
 
         static bool deleteAll( MediaLibraryPtr ml )
         {
-            static const std::string req = "DELETE FROM " + IMPL::Table::Name;
+            static const sqlite::Request req{ "DELETE FROM " + IMPL::Table::Name };
             return sqlite::Tools::executeDelete( ml->getConn(), req );
         }
 
@@ -122,8 +155,8 @@ class DatabaseHelpers
         /*
          * Create a new instance of the cache class.
          */
-        template <typename... Args>
-        static bool insert( MediaLibraryPtr ml, std::shared_ptr<IMPL> self, const std::string& req, Args&&... args )
+        template <typename Req, typename... Args>
+        static bool insert( MediaLibraryPtr ml, std::shared_ptr<IMPL> self, const Req& req, Args&&... args )
         {
             int64_t pKey = sqlite::Tools::executeInsert( ml->getConn(), req, std::forward<Args>( args )... );
             if ( pKey == 0 )
@@ -131,6 +164,23 @@ class DatabaseHelpers
             (self.get())->*IMPL::Table::PrimaryKey = pKey;
             return true;
         }
+
+    private:
+        template <typename Req, typename... Args>
+        static std::shared_ptr<IMPL> fetchIgnoringErrors( MediaLibraryPtr ml, const Req& req, Args&&... args )
+        {
+            try
+            {
+                return sqlite::Tools::fetchOne<IMPL>( ml, req, std::forward<Args>( args )... );
+            }
+            catch ( const sqlite::errors::Exception& ex )
+            {
+                if ( sqlite::errors::isInnocuous( ex ) == false )
+                    throw;
+                LOG_WARN( "Ignoring innocuous error: ", ex.what() );
+            }
+            return {};
+        }
 };
 
 }
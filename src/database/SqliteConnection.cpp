@@ -224,7 +224,7 @@ bool Connection::checkSchemaIntegrity()
     sqlite::Statement stmt( conn, req );
     stmt.execute();
     auto row = stmt.row();
-    if ( row.load<std::string>( 0 ) == "ok" )
+    if ( row.load<sqlite::Text>( 0 ) == "ok" )
     {
         row = stmt.row();
         assert( row == nullptr );
@@ -263,6 +263,30 @@ bool Connection::checkForeignKeysIntegrity()
     return false;
 }
 
+uint32_t Connection::schemaFingerprint()
+{
+    sqlite::Statement stmt( handle(), "PRAGMA schema_version" );
+    stmt.execute();
+    auto row = stmt.row();
+    return row.load<uint32_t>( 0 );
+}
+
+uint32_t Connection::checkedSchemaFingerprint()
+{
+    sqlite::Statement stmt( handle(), "PRAGMA user_version" );
+    stmt.execute();
+    auto row = stmt.row();
+    return row.load<uint32_t>( 0 );
+}
+
+void Connection::setCheckedSchemaFingerprint( uint32_t fingerprint )
+{
+    auto ctx = acquireWriteContext();
+    /* user_version is a signed 32 bits integer */
+    setPragma( ctx.handle(), "user_version",
+               std::to_string( static_cast<int32_t>( fingerprint ) ) );
+}
+
 const std::string&Connection::dbPath() const
 {
     return m_dbPath;
@@ -275,6 +299,21 @@ void Connection::flushAll()
     m_conns.clear();
 }
 
+void Connection::setLockPolicy( LockPolicy policy, uint32_t maxWriterBatch )
+{
+    m_contextLock.setPolicy( policy, maxWriterBatch );
+}
+
+std::vector<LockStats> Connection::lockStats() const
+{
+    return m_contextLock.stats();
+}
+
+void Connection::resetLockStats()
+{
+    m_contextLock.resetStats();
+}
+
 std::shared_ptr<Connection> Connection::connect( const std::string& dbPath )
 {
     // Use a wrapper to allow make_shared to use the private Connection ctor
@@ -265,11 +265,38 @@ public:
     void registerUpdateHook( const std::string& table, UpdateHookCb cb );
     bool checkSchemaIntegrity();
     bool checkForeignKeysIntegrity();
+    /**
+     * @brief schemaFingerprint Returns a value which changes every time the
+     *        database schema is modified
+     *
+     * This is sqlite's schema cookie, and is stored in the database header so
+     * fetching it doesn't involve parsing the schema.
+     */
+    uint32_t schemaFingerprint();
+    /**
+     * @brief checkedSchemaFingerprint Returns the fingerprint of the last schema
+     *        which was successfully checked, or 0 if none was.
+     */
+    uint32_t checkedSchemaFingerprint();
+    /**
+     * @brief setCheckedSchemaFingerprint Persists the fingerprint of a schema
+     *        which was successfully checked
+     *
+     * This will acquire a write context and must not be called while a context
+     * is already held by the current thread
+     */
+    void setCheckedSchemaFingerprint( uint32_t fingerprint );
     const std::string& dbPath() const;
     /**
      * @brief flushAll Closes all connections for all threads
      */
     void flushAll();
+    /**
+     * @brief setLockPolicy Sets the fairness policy of the context lock
+     */
+    void setLockPolicy( LockPolicy policy, uint32_t maxWriterBatch );
+    std::vector<LockStats> lockStats() const;
+    void resetLockStats();
 
     static std::shared_ptr<Connection> connect( const std::string& dbPath );
 
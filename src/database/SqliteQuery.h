@@ -25,7 +25,10 @@
 #include "medialibrary/IQuery.h"
 #include "SqliteConnection.h"
 #include "SqliteTools.h"
+#include "AsyncQueryExecutor.h"
+#include "MediaLibrary.h"
 
+#include <algorithm>
 #include <vector>
 #include <functional>
 #include <string>
@@ -33,11 +36,106 @@
 namespace medialibrary
 {
 
+/**
+ * Runs a request with its parameters on the asynchronous query executor, and
+ * hands the result to all the callers which requested the same thing while it
+ * was pending. If the request fails, the callers are notified with an empty
+ * result.
+ */
+template <typename T, typename Params>
+class SqliteAsyncJob : public AsyncQueryExecutor::Job
+{
+public:
+    using Callback = std::function<void( bool, T )>;
+    using Executor = std::function<T( const Params& )>;
+
+    SqliteAsyncJob( std::string key, Params params, Executor exec,
+                    Callback cb, CancellationToken token )
+        : m_key( std::move( key ) )
+        , m_params( std::move( params ) )
+        , m_exec( std::move( exec ) )
+        , m_success( false )
+        , m_result{}
+    {
+        m_subscribers.push_back( Subscriber{ std::move( cb ), std::move( token ) } );
+    }
+
+    virtual const std::string& key() const override
+    {
+        return m_key;
+    }
+
+    virtual bool merge( AsyncQueryExecutor::Job& job ) override
+    {
+        /* The jobs don't necessarily share the same type if they share a key */
+        if ( job.type() != type() || job.key() != m_key )
+            return false;
+        auto& j = static_cast<SqliteAsyncJob&>( job );
+        if ( j.m_params != m_params )
+            return false;
+        std::move( begin( j.m_subscribers ), end( j.m_subscribers ),
+                   std::back_inserter( m_subscribers ) );
+        j.m_subscribers.clear();
+        return true;
+    }
+
+    virtual bool isCancelled() const override
+    {
+        return std::all_of( begin( m_subscribers ), end( m_subscribers ),
+                            []( const Subscriber& s ) {
+            return s.token.isCancelled();
+        });
+    }
+
+    virtual void execute() override
+    {
+        try
+        {
+            m_result = m_exec( m_params );
+            m_success = true;
+        }
+        catch ( const std::exception& ex )
+        {
+            LOG_ERROR( "Failed to execute asynchronous request: ", ex.what() );
+        }
+    }
+
+    virtual void deliver() override
+    {
+        for ( const auto& s : m_subscribers )
+        {
+            if ( s.token.isCancelled() == false )
+                s.cb( m_success, m_result );
+        }
+    }
+
+    virtual const void* type() const override
+    {
+        /* Uniquely identifies this template instantiation without requiring RTTI */
+        static const char tag = 0;
+        return &tag;
+    }
+
+private:
+    struct Subscriber
+    {
+        Callback cb;
+        CancellationToken token;
+    };
+    const std::string m_key;
+    const Params m_params;
+    const Executor m_exec;
+    std::vector<Subscriber> m_subscribers;
+    bool m_success;
+    T m_result;
+};
+
 template <typename Impl, typename Intf, typename... RequestParams>
 class SqliteQueryBase : public IQuery<Intf>
 {
 protected:
     using Result = typename IQuery<Intf>::Result;
+    using Page = typename IQuery<Intf>::Page;
 
     template <typename... Params>
     SqliteQueryBase( MediaLibraryPtr ml, Params&&... params )
@@ -46,13 +144,121 @@ protected:
     {
     }
 
+public:
+    /**
+     * Registers a callback to be invoked before each execution of the request,
+     * outside of any database context.
+     */
+    void setPreExecute( std::function<void()> cb )
+    {
+        m_preExecute = std::move( cb );
+    }
+
+protected:
+    void preExecute() const
+    {
+        if ( m_preExecute )
+            m_preExecute();
+    }
+
     size_t executeCount( const std::string& req ) const
     {
-        auto dbConn = m_ml->getConn();
+        return count( m_ml, req, m_params );
+    }
+
+    Result executeFetchItems( const std::string& req, uint32_t nbItems, uint32_t offset ) const
+    {
+        return Impl::template fetchAll<Intf>( m_ml, req, m_params, nbItems, offset );
+    }
+
+    Result executeFetchAll( const std::string& req ) const
+    {
+        return Impl::template fetchAll<Intf>( m_ml, req, m_params );
+    }
+
+    bool executeForEach( const std::string& req,
+                         typename IQuery<Intf>::ItemCb& cb ) const
+    {
+        return Impl::template forEach<Intf>( m_ml, req, cb, m_params );
+    }
+
+    /*
+     * pageReq is expected to return the total number of rows as its last
+     * column. countReq is only used if the requested page is past the end
+     */
+    Page executeFetchPage( const std::string& pageReq, const std::string& countReq,
+                           uint32_t nbItems, uint32_t offset ) const
+    {
+        OPEN_READ_CONTEXT( ctx, m_ml->getConn() );
+        Page page{ {}, 0 };
+        page.items = Impl::template fetchPage<Intf>( m_ml, pageReq, page.count,
+                                                     m_params, nbItems, offset );
+        if ( page.items.empty() == true && offset > 0 )
+            page.count = executeCount( countReq );
+        return page;
+    }
+
+    Page executeCountAndFetchItems( const std::string& countReq,
+                                    const std::string& itemsReq,
+                                    uint32_t nbItems, uint32_t offset ) const
+    {
+        OPEN_READ_CONTEXT( ctx, m_ml->getConn() );
+        Page page{ {}, executeCount( countReq ) };
+        if ( page.count > offset )
+            page.items = executeFetchItems( itemsReq, nbItems, offset );
+        return page;
+    }
+
+    void submitCount( const std::string& req, typename IQuery<Intf>::CountCb cb,
+                      CancellationToken token ) const
+    {
+        auto ml = m_ml;
+        auto prepare = m_preExecute;
+        submit<size_t>( "count:" + req, [ml, req, prepare]( const Params& params ) {
+            if ( prepare )
+                prepare();
+            return count( ml, req, params );
+        }, std::move( cb ), std::move( token ) );
+    }
+
+    void submitFetchItems( const std::string& req, uint32_t nbItems,
+                           uint32_t offset, typename IQuery<Intf>::ResultCb cb,
+                           CancellationToken token ) const
+    {
+        auto ml = m_ml;
+        auto prepare = m_preExecute;
+        submit<Result>( "items:" + std::to_string( nbItems ) + ":" +
+                        std::to_string( offset ) + ":" + req,
+                        [ml, req, nbItems, offset, prepare]( const Params& params ) {
+            if ( prepare )
+                prepare();
+            return Impl::template fetchAll<Intf>( ml, req, params, nbItems, offset );
+        }, std::move( cb ), std::move( token ) );
+    }
+
+    void submitFetchAll( const std::string& req, typename IQuery<Intf>::ResultCb cb,
+                         CancellationToken token ) const
+    {
+        auto ml = m_ml;
+        auto prepare = m_preExecute;
+        submit<Result>( "all:" + req, [ml, req, prepare]( const Params& params ) {
+            if ( prepare )
+                prepare();
+            return Impl::template fetchAll<Intf>( ml, req, params );
+        }, std::move( cb ), std::move( token ) );
+    }
+
+private:
+    using Params = std::tuple<typename std::decay<RequestParams>::type...>;
+
+    static size_t count( MediaLibraryPtr ml, const std::string& req,
+                         const Params& params )
+    {
+        auto dbConn = ml->getConn();
         OPEN_READ_CONTEXT( ctx, dbConn );
         sqlite::QueryTimer qt{ req };
         sqlite::Statement stmt( req );
-        stmt.execute( m_params );
+        stmt.execute( params );
         auto row = stmt.row();
         size_t count;
         row >> count;
@@ -60,19 +266,20 @@ protected:
         return count;
     }
 
-    Result executeFetchItems( const std::string& req, uint32_t nbItems, uint32_t offset ) const
+    template <typename T>
+    void submit( std::string key, typename SqliteAsyncJob<T, Params>::Executor exec,
+                 typename SqliteAsyncJob<T, Params>::Callback cb,
+                 CancellationToken token ) const
     {
-        return Impl::template fetchAll<Intf>( m_ml, req, m_params, nbItems, offset );
-    }
-
-    Result executeFetchAll( const std::string& req ) const
-    {
-        return Impl::template fetchAll<Intf>( m_ml, req, m_params );
+        m_ml->asyncQueryExecutor().submit( std::make_shared<SqliteAsyncJob<T, Params>>(
+                std::move( key ), m_params, std::move( exec ), std::move( cb ),
+                std::move( token ) ) );
     }
 
 private:
     MediaLibraryPtr m_ml;
-    const std::tuple<typename std::decay<RequestParams>::type...> m_params;
+    const Params m_params;
+    std::function<void()> m_preExecute;
 };
 
 template <typename Impl, typename Intf, typename... Args>
@@ -81,6 +288,7 @@ class SqliteQuery : public SqliteQueryBase<Impl, Intf, Args...>
 public:
     using Base = SqliteQueryBase<Impl, Intf, Args...>;
     using Result = typename Base::Result;
+    using Page = typename Base::Page;
 
     template <typename... Params>
     SqliteQuery( MediaLibraryPtr ml, std::string field, std::string base,
@@ -100,31 +308,105 @@ public:
 
     virtual size_t count() override
     {
-        std::string req = "SELECT COUNT(DISTINCT " + Impl::Table::PrimaryKeyColumn +
-                " ) " + m_base;
-        return Base::executeCount( req );
+        buildCountRequest();
+        Base::preExecute();
+        return Base::executeCount( m_countReq );
     }
 
     virtual Result items( uint32_t nbItems, uint32_t offset ) override
     {
         if ( nbItems == 0 && offset == 0 )
             return all();
-        const std::string req = "SELECT " + m_field + " " + m_base + " " +
-                m_groupAndOrderBy + " LIMIT ? OFFSET ?";
-        return Base::executeFetchItems( req, nbItems, offset );
+        /*
+         * The same query is usually used to fetch many pages, so only build
+         * the request once
+         */
+        if ( m_itemsReq.empty() == true )
+            m_itemsReq = "SELECT " + m_field + " " + m_base + " " +
+                    m_groupAndOrderBy + " LIMIT ? OFFSET ?";
+        Base::preExecute();
+        return Base::executeFetchItems( m_itemsReq, nbItems, offset );
     }
 
     virtual Result all() override
     {
         const std::string req = "SELECT " + m_field + " " + m_base + " " +
                 m_groupAndOrderBy;
+        Base::preExecute();
         return Base::executeFetchAll( req );
     }
 
+    virtual Page page( uint32_t nbItems, uint32_t offset ) override
+    {
+        if ( nbItems == 0 && offset == 0 )
+        {
+            auto items = all();
+            auto count = items.size();
+            return Page{ std::move( items ), count };
+        }
+        /*
+         * The window is computed over the grouped rows before the LIMIT is
+         * applied, so the count & the items only require a single evaluation
+         * of the base query.
+         */
+        if ( m_pageReq.empty() == true )
+            m_pageReq = "SELECT " + m_field + ", COUNT(*) OVER () " + m_base +
+                    " " + m_groupAndOrderBy + " LIMIT ? OFFSET ?";
+        buildCountRequest();
+        Base::preExecute();
+        return Base::executeFetchPage( m_pageReq, m_countReq, nbItems, offset );
+    }
+
+    virtual bool forEach( typename IQuery<Intf>::ItemCb cb ) override
+    {
+        const std::string req = "SELECT " + m_field + " " + m_base + " " +
+                m_groupAndOrderBy;
+        Base::preExecute();
+        return Base::executeForEach( req, cb );
+    }
+
+    virtual void countAsync( typename IQuery<Intf>::CountCb cb,
+                             CancellationToken token ) override
+    {
+        buildCountRequest();
+        Base::submitCount( m_countReq, std::move( cb ), std::move( token ) );
+    }
+
+    virtual void itemsAsync( uint32_t nbItems, uint32_t offset,
+                             typename IQuery<Intf>::ResultCb cb,
+                             CancellationToken token ) override
+    {
+        if ( nbItems == 0 && offset == 0 )
+            return allAsync( std::move( cb ), std::move( token ) );
+        if ( m_itemsReq.empty() == true )
+            m_itemsReq = "SELECT " + m_field + " " + m_base + " " +
+                    m_groupAndOrderBy + " LIMIT ? OFFSET ?";
+        Base::submitFetchItems( m_itemsReq, nbItems, offset, std::move( cb ),
+                                std::move( token ) );
+    }
+
+    virtual void allAsync( typename IQuery<Intf>::ResultCb cb,
+                           CancellationToken token ) override
+    {
+        Base::submitFetchAll( "SELECT " + m_field + " " + m_base + " " +
+                              m_groupAndOrderBy, std::move( cb ), std::move( token ) );
+    }
+
+private:
+    void buildCountRequest()
+    {
+        if ( m_countReq.empty() == true )
+            m_countReq = "SELECT COUNT(DISTINCT " + Impl::Table::PrimaryKeyColumn +
+                    " ) " + m_base;
+    }
+
 private:
     std::string m_field;
     const std::string m_base;
     const std::string m_groupAndOrderBy;
+    std::string m_countReq;
+    std::string m_itemsReq;
+    std::string m_pageReq;
 };
 
 /**
@@ -138,6 +420,7 @@ class SqliteQueryWithCount : public SqliteQueryBase<Impl, Intf, RequestParams...
 public:
     using Base = SqliteQueryBase<Impl, Intf, RequestParams...>;
     using Result = typename Base::Result;
+    using Page = typename Base::Page;
 
     template <typename... Args>
     SqliteQueryWithCount( MediaLibraryPtr ml, std::string countReq,
@@ -145,6 +428,7 @@ public:
         : SqliteQueryBase<Impl, Intf, Args...>( ml, std::forward<Args>( args )... )
         , m_countReq( std::move( countReq ) )
         , m_req ( std::move( req ) )
+        , m_itemsReq( m_req + " LIMIT ? OFFSET ?" )
     {
     }
 
@@ -157,7 +441,7 @@ public:
     {
         if ( nbItems == 0 && offset == 0 )
             return all();
-        return Base::executeFetchItems( m_req + " LIMIT ? OFFSET ?", nbItems, offset );
+        return Base::executeFetchItems( m_itemsReq, nbItems, offset );
     }
 
     virtual Result all() override
@@ -165,9 +449,53 @@ public:
         return Base::executeFetchAll( m_req );
     }
 
+    virtual Page page( uint32_t nbItems, uint32_t offset ) override
+    {
+        /*
+         * The dedicated count request is expected to be cheaper than a window
+         * over the listing request, so run both in the same read context.
+         */
+        if ( nbItems == 0 && offset == 0 )
+        {
+            auto items = all();
+            auto count = items.size();
+            return Page{ std::move( items ), count };
+        }
+        return Base::executeCountAndFetchItems( m_countReq, m_itemsReq,
+                                                nbItems, offset );
+    }
+
+    virtual bool forEach( typename IQuery<Intf>::ItemCb cb ) override
+    {
+        return Base::executeForEach( m_req, cb );
+    }
+
+    virtual void countAsync( typename IQuery<Intf>::CountCb cb,
+                             CancellationToken token ) override
+    {
+        Base::submitCount( m_countReq, std::move( cb ), std::move( token ) );
+    }
+
+    virtual void itemsAsync( uint32_t nbItems, uint32_t offset,
+                             typename IQuery<Intf>::ResultCb cb,
+                             CancellationToken token ) override
+    {
+        if ( nbItems == 0 && offset == 0 )
+            return allAsync( std::move( cb ), std::move( token ) );
+        Base::submitFetchItems( m_itemsReq, nbItems, offset, std::move( cb ),
+                                std::move( token ) );
+    }
+
+    virtual void allAsync( typename IQuery<Intf>::ResultCb cb,
+                           CancellationToken token ) override
+    {
+        Base::submitFetchAll( m_req, std::move( cb ), std::move( token ) );
+    }
+
 private:
     const std::string m_countReq;
     const std::string m_req;
+    const std::string m_itemsReq;
 };
 
 template <typename Impl, typename Intf = Impl, typename... Args>
@@ -177,6 +505,11 @@ public:
     using Query = std::unique_ptr<SqliteQuery<Impl, Intf, Args...>>;
     QueryBuilder( Query q ) : m_query( std::move( q ) ) {}
     QueryBuilder& markPublic( bool p ) { m_query->markPublic( p ); return *this; }
+    QueryBuilder& preExecute( std::function<void()> cb )
+    {
+        m_query->setPreExecute( std::move( cb ) );
+        return *this;
+    }
     Query build() { return std::move( m_query ); }
 
 private:
@@ -0,0 +1,234 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "SqliteQueryMetrics.h"
+
+#include "logging/Logger.h"
+#include "utils/Histogram.h"
+
+#include <cctype>
+
+namespace medialibrary
+{
+
+namespace sqlite
+{
+
+constexpr size_t QueryMetrics::MaxCachedShapes;
+compat::Mutex QueryMetrics::s_lock;
+std::unordered_map<std::string, QueryStats> QueryMetrics::s_stats;
+std::unordered_map<std::string, QueryStats*> QueryMetrics::s_shapes;
+std::atomic<int64_t> QueryMetrics::s_slowQueryThreshold;
+std::shared_ptr<QueryMetrics::SlowQueryHandler> QueryMetrics::s_slowQueryHandler;
+
+namespace
+{
+
+bool isIdentifierChar( char c )
+{
+    return isalnum( static_cast<unsigned char>( c ) ) || c == '_' || c == '.';
+}
+
+}
+
+void QueryMetrics::record( const std::string& req, std::chrono::microseconds duration,
+                           const Counters& counters )
+{
+    std::lock_guard<compat::Mutex> lock( s_lock );
+    auto it = s_shapes.find( req );
+    QueryStats* stats;
+    if ( it != end( s_shapes ) )
+        stats = it->second;
+    else
+    {
+        auto shape = normalize( req );
+        auto statsIt = s_stats.find( shape );
+        if ( statsIt == end( s_stats ) )
+        {
+            QueryStats s{};
+            s.sql = shape;
+            statsIt = s_stats.emplace( std::move( shape ), std::move( s ) ).first;
+        }
+        stats = &statsIt->second;
+        if ( s_shapes.size() >= MaxCachedShapes )
+            s_shapes.clear();
+        s_shapes.emplace( req, stats );
+    }
+    ++stats->nbExecutions;
+    stats->totalDuration += duration;
+    stats->maxDuration = std::max( stats->maxDuration, duration );
+    stats->nbRows += counters.nbRows;
+    stats->nbFullScanSteps += counters.nbFullScanSteps;
+    stats->nbSorts += counters.nbSorts;
+    stats->nbAutoIndexes += counters.nbAutoIndexes;
+    stats->nbVmSteps += counters.nbVmSteps;
+    auto bucket = utils::histogram::log2Bucket( duration,
+                                                QueryStats::NbLatencyBuckets );
+    ++stats->latencyHistogram[bucket];
+}
+
+std::vector<QueryStats> QueryMetrics::snapshot()
+{
+    std::vector<QueryStats> res;
+    std::lock_guard<compat::Mutex> lock( s_lock );
+    res.reserve( s_stats.size() );
+    for ( const auto& p : s_stats )
+        res.push_back( p.second );
+    return res;
+}
+
+void QueryMetrics::reset()
+{
+    std::lock_guard<compat::Mutex> lock( s_lock );
+    s_shapes.clear();
+    s_stats.clear();
+}
+
+void QueryMetrics::setSlowQueryHandler( std::chrono::microseconds threshold,
+                                        SlowQueryHandler handler )
+{
+    std::lock_guard<compat::Mutex> lock( s_lock );
+    if ( handler == nullptr || threshold.count() <= 0 )
+    {
+        s_slowQueryHandler.reset();
+        s_slowQueryThreshold.store( 0, std::memory_order_relaxed );
+        return;
+    }
+    s_slowQueryHandler = std::make_shared<SlowQueryHandler>( std::move( handler ) );
+    s_slowQueryThreshold.store( threshold.count(), std::memory_order_relaxed );
+}
+
+bool QueryMetrics::isSlow( std::chrono::microseconds duration )
+{
+    auto threshold = s_slowQueryThreshold.load( std::memory_order_relaxed );
+    return threshold > 0 && duration.count() >= threshold;
+}
+
+void QueryMetrics::reportSlowQuery( Connection::Handle handle, const std::string& req,
+                                    std::chrono::microseconds duration )
+{
+    std::shared_ptr<SlowQueryHandler> handler;
+    {
+        std::lock_guard<compat::Mutex> lock( s_lock );
+        handler = s_slowQueryHandler;
+    }
+    if ( handler == nullptr )
+        return;
+    auto plan = handle != nullptr ? queryPlan( handle, req ) : std::string{};
+    (*handler)( req, duration, plan );
+}
+
+std::string QueryMetrics::normalize( const std::string& req )
+{
+    std::string res;
+    res.reserve( req.size() );
+    auto placeholder = [&res]() {
+        /* Collapse lists of values: "(?, ?, ?)" becomes "(?)" */
+        auto size = res.size();
+        if ( size >= 2 && res[size - 1] == ',' && res[size - 2] == '?' )
+            res.pop_back();
+        else if ( size >= 3 && res[size - 1] == ' ' && res[size - 2] == ',' &&
+                  res[size - 3] == '?' )
+            res.resize( size - 2 );
+        else
+            res.push_back( '?' );
+    };
+    for ( auto i = 0u; i < req.size(); ++i )
+    {
+        auto c = req[i];
+        if ( isspace( static_cast<unsigned char>( c ) ) )
+        {
+            if ( res.empty() == false && res.back() != ' ' )
+                res.push_back( ' ' );
+        }
+        else if ( c == '\'' )
+        {
+            /* Skip the string literal, '' being an escaped quote */
+            for ( ++i; i < req.size(); ++i )
+            {
+                if ( req[i] != '\'' )
+                    continue;
+                if ( i + 1 < req.size() && req[i + 1] == '\'' )
+                    ++i;
+                else
+                    break;
+            }
+            placeholder();
+        }
+        else if ( isdigit( static_cast<unsigned char>( c ) ) &&
+                  ( res.empty() == true || isIdentifierChar( res.back() ) == false ) )
+        {
+            while ( i + 1 < req.size() && isIdentifierChar( req[i + 1] ) )
+                ++i;
+            placeholder();
+        }
+        else if ( c == '?' )
+            placeholder();
+        else
+            res.push_back( c );
+    }
+    if ( res.empty() == false && res.back() == ' ' )
+        res.pop_back();
+    return res;
+}
+
+std::string QueryMetrics::queryPlan( Connection::Handle handle, const std::string& req )
+{
+    /*
+     * Use the raw sqlite API, the plan request must neither be timed nor
+     * kept in the statement cache
+     */
+    const auto explain = "EXPLAIN QUERY PLAN " + req;
+    sqlite3_stmt* stmt;
+    if ( sqlite3_prepare_v2( handle, explain.c_str(), explain.size() + 1,
+                             &stmt, nullptr ) != SQLITE_OK )
+    {
+        LOG_WARN( "Failed to compute the query plan for ", req, ": ",
+                  sqlite3_errmsg( handle ) );
+        return {};
+    }
+    /* Indent each step below its parent */
+    std::unordered_map<int64_t, size_t> depths;
+    std::string plan;
+    while ( sqlite3_step( stmt ) == SQLITE_ROW )
+    {
+        auto id = sqlite3_column_int64( stmt, 0 );
+        auto parent = sqlite3_column_int64( stmt, 1 );
+        auto detail = reinterpret_cast<const char*>( sqlite3_column_text( stmt, 3 ) );
+        auto it = depths.find( parent );
+        auto depth = it != end( depths ) ? it->second + 1 : 0;
+        depths[id] = depth;
+        plan.append( depth * 2, ' ' );
+        plan += detail != nullptr ? detail : "";
+        plan += '\n';
+    }
+    sqlite3_finalize( stmt );
+    return plan;
+}
+
+}
+
+}
@@ -0,0 +1,121 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "compat/Mutex.h"
+#include "database/SqliteConnection.h"
+#include "medialibrary/IMediaLibrary.h"
+
+namespace medialibrary
+{
+
+namespace sqlite
+{
+
+/**
+ * @brief The QueryMetrics class gathers the requests statistics, for all
+ * the connections of the process
+ *
+ * Requests are grouped by shape, ie. their SQL with the literal values
+ * replaced by placeholders, so that requests built on the fly with different
+ * values share the same statistics.
+ */
+class QueryMetrics
+{
+public:
+    /* The statement counters for a single execution */
+    struct Counters
+    {
+        uint64_t nbRows;
+        uint64_t nbFullScanSteps;
+        uint64_t nbSorts;
+        uint64_t nbAutoIndexes;
+        uint64_t nbVmSteps;
+    };
+
+    using SlowQueryHandler = std::function<void( const std::string& sql,
+                                                 std::chrono::microseconds duration,
+                                                 const std::string& queryPlan )>;
+
+    static void record( const std::string& req, std::chrono::microseconds duration,
+                        const Counters& counters );
+    static std::vector<QueryStats> snapshot();
+    static void reset();
+
+    /**
+     * @brief setSlowQueryHandler Sets the handler to invoke for the requests
+     * lasting longer than the provided threshold
+     *
+     * A 0 threshold or an empty handler disables the slow requests reporting.
+     */
+    static void setSlowQueryHandler( std::chrono::microseconds threshold,
+                                     SlowQueryHandler handler );
+    static bool isSlow( std::chrono::microseconds duration );
+    /**
+     * @brief reportSlowQuery Computes the request plan with the provided
+     * connection and forwards it to the slow query handler
+     */
+    static void reportSlowQuery( Connection::Handle handle, const std::string& req,
+                                 std::chrono::microseconds duration );
+
+    /**
+     * @brief normalize Returns the request shape
+     *
+     * Whitespace runs are collapsed, string & numeric literals are replaced by
+     * a '?' placeholder, and lists of placeholders are collapsed to a
+     * single one.
+     */
+    static std::string normalize( const std::string& req );
+    /**
+     * @brief queryPlan Returns the request EXPLAIN QUERY PLAN, one step per line
+     */
+    static std::string queryPlan( Connection::Handle handle, const std::string& req );
+
+private:
+    /*
+     * Normalizing a request is much more expensive than hashing it, so the
+     * shape of each raw request is cached. Requests embedding many different
+     * values could make this cache grow without bounds, so it is flushed
+     * once it reaches this size.
+     */
+    static constexpr size_t MaxCachedShapes = 4096;
+
+    static compat::Mutex s_lock;
+    static std::unordered_map<std::string, QueryStats> s_stats;
+    static std::unordered_map<std::string, QueryStats*> s_shapes;
+    static std::atomic<int64_t> s_slowQueryThreshold;
+    static std::shared_ptr<SlowQueryHandler> s_slowQueryHandler;
+};
+
+}
+
+}
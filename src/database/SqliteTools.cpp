@@ -26,15 +26,80 @@
 
 #include "SqliteTools.h"
 
+#include <list>
+
 namespace medialibrary
 {
 
 namespace sqlite
 {
-std::unordered_map<Connection::Handle,
-                   Statement::StatementsCacheMap> Statement::StatementsCache;
+struct Statement::ConnectionCache
+{
+    struct Entry
+    {
+        Entry( std::string r, CachedStmtPtr s )
+            : req( std::move( r ) ), stmt( std::move( s ) ), nbUsers( 0 ) {}
+        std::string req;
+        CachedStmtPtr stmt;
+        uint32_t nbUsers;
+    };
+    using LruList = std::list<Entry>;
+
+    // Slots for the registered requests, indexed by Request::id()
+    std::vector<CachedStmtPtr> slots;
+    // Requests built on the fly, most recently used first
+    LruList lru;
+    std::unordered_map<std::string, LruList::iterator,
+                       utils::hash::xxhasher> index;
+    /*
+     * Only the thread owning the connection updates the counters, but they
+     * can be read from any thread through cacheStats()
+     */
+    std::atomic<uint64_t> nbHits{ 0 };
+    std::atomic<uint64_t> nbMisses{ 0 };
+    std::atomic<uint64_t> nbEvictions{ 0 };
+
+    static void increment( std::atomic<uint64_t>& counter )
+    {
+        counter.store( counter.load( std::memory_order_relaxed ) + 1,
+                       std::memory_order_relaxed );
+    }
+
+    void evict()
+    {
+        /*
+         * A statement can't be finalized while a Statement instance still uses
+         * it, which happens when a result row loop runs other requests, so
+         * skip those and evict the next least recently used one.
+         */
+        for ( auto it = lru.rbegin(); it != lru.rend(); ++it )
+        {
+            if ( it->nbUsers > 0 )
+                continue;
+            index.erase( it->req );
+            lru.erase( std::next( it ).base() );
+            increment( nbEvictions );
+            return;
+        }
+    }
+};
 
 compat::Mutex Statement::StatementsCacheLock;
+std::unordered_map<Connection::Handle,
+                   std::unique_ptr<Statement::ConnectionCache>> Statement::StatementsCache;
+std::atomic<uint32_t> Statement::CacheGeneration{ 1 };
+thread_local Connection::Handle Statement::LastHandle;
+thread_local Statement::ConnectionCache* Statement::LastCache;
+thread_local uint32_t Statement::LastGeneration;
+constexpr size_t Statement::MaxCachedStatements;
+
+std::atomic<uint32_t> Request::NbRequests{ 0 };
+
+Request::Request( std::string req )
+    : m_req( std::move( req ) )
+    , m_id( NbRequests.fetch_add( 1, std::memory_order_relaxed ) )
+{
+}
 
 bool Tools::checkTriggerStatement(const std::string& expectedStatement, const std::string& triggerName)
 {
@@ -139,34 +204,32 @@ std::string Tools::fetchIndexStatement(const std::string& indexName)
 }
 
 Statement::Statement(Connection::Handle dbConnection, const std::string& req)
-    : m_stmt( nullptr, [](sqlite3_stmt* stmt) {
-        sqlite3_clear_bindings( stmt );
-        sqlite3_reset( stmt );
-    })
-    , m_dbConn( dbConnection )
+    : m_dbConn( dbConnection )
     , m_bindIdx( 0 )
     , m_isCommit( false )
+    , m_nbRows( 0 )
 {
-    std::lock_guard<compat::Mutex> lock( StatementsCacheLock );
-    auto& connMap = StatementsCache[ dbConnection ];
-    auto it = connMap.find( req );
-    if ( it == end( connMap ) )
+    auto& cache = connectionCache( dbConnection );
+    auto it = cache.index.find( req );
+    if ( it == end( cache.index ) )
     {
-        sqlite3_stmt* stmt;
-        int res = sqlite3_prepare_v2( dbConnection, req.c_str(),
-                                      req.size() + 1, &stmt, nullptr );
-        if ( res != SQLITE_OK )
-        {
-            errors::mapToException( req.c_str(), sqlite3_errmsg( dbConnection ),
-                                    res );
-        }
-        m_stmt.reset( stmt );
-        connMap.emplace( req, CachedStmtPtr( stmt, &sqlite3_finalize ) );
+        ConnectionCache::increment( cache.nbMisses );
+        initialize( dbConnection, req );
+        if ( cache.lru.size() >= MaxCachedStatements )
+            cache.evict();
+        cache.lru.emplace_front( req, CachedStmtPtr( m_stmt.get() ) );
+        cache.index.emplace( req, begin( cache.lru ) );
     }
     else
     {
-        m_stmt.reset( it->second.get() );
+        ConnectionCache::increment( cache.nbHits );
+        if ( it->second != begin( cache.lru ) )
+            cache.lru.splice( begin( cache.lru ), cache.lru, it->second );
+        m_stmt.reset( it->second->stmt.get() );
     }
+    auto& entry = cache.lru.front();
+    ++entry.nbUsers;
+    m_stmt.get_deleter().nbUsers = &entry.nbUsers;
     if ( req == "COMMIT" )
         m_isCommit = true;
 }
@@ -176,6 +239,101 @@ Statement::Statement( const std::string& req )
 {
 }
 
+Statement::Statement( Connection::Handle dbConnection, const Request& req )
+    : m_dbConn( dbConnection )
+    , m_bindIdx( 0 )
+    , m_isCommit( false )
+    , m_nbRows( 0 )
+{
+    auto& cache = connectionCache( dbConnection );
+    if ( req.id() >= cache.slots.size() )
+        cache.slots.resize( req.id() + 1 );
+    auto& slot = cache.slots[req.id()];
+    if ( slot == nullptr )
+    {
+        ConnectionCache::increment( cache.nbMisses );
+        initialize( dbConnection, req.str() );
+        slot.reset( m_stmt.get() );
+    }
+    else
+    {
+        ConnectionCache::increment( cache.nbHits );
+        m_stmt.reset( slot.get() );
+    }
+    if ( req.str() == "COMMIT" )
+        m_isCommit = true;
+}
+
+Statement::Statement( const Request& req )
+    : Statement( Connection::Context::handle(), req )
+{
+}
+
+Statement::~Statement()
+{
+    reportCounters();
+}
+
+Statement& Statement::operator=( Statement&& stmt )
+{
+    reportCounters();
+    m_stmt = std::move( stmt.m_stmt );
+    m_dbConn = stmt.m_dbConn;
+    m_bindIdx = stmt.m_bindIdx;
+    m_isCommit = stmt.m_isCommit;
+    m_nbRows = stmt.m_nbRows;
+    return *this;
+}
+
+void Statement::reportCounters()
+{
+    auto stmt = m_stmt.get();
+    if ( stmt == nullptr )
+        return;
+    /*
+     * Always reset the counters, since the compiled statement is reused by
+     * the next executions
+     */
+    QueryMetrics::Counters counters{
+        m_nbRows,
+        static_cast<uint64_t>( sqlite3_stmt_status( stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1 ) ),
+        static_cast<uint64_t>( sqlite3_stmt_status( stmt, SQLITE_STMTSTATUS_SORT, 1 ) ),
+        static_cast<uint64_t>( sqlite3_stmt_status( stmt, SQLITE_STMTSTATUS_AUTOINDEX, 1 ) ),
+        static_cast<uint64_t>( sqlite3_stmt_status( stmt, SQLITE_STMTSTATUS_VM_STEP, 1 ) ),
+    };
+    auto timer = QueryTimer::current();
+    if ( timer != nullptr )
+        timer->addStatement( m_dbConn, counters );
+}
+
+void Statement::initialize( Connection::Handle dbConnection, const std::string& req )
+{
+    sqlite3_stmt* stmt;
+    int res = sqlite3_prepare_v2( dbConnection, req.c_str(),
+                                  req.size() + 1, &stmt, nullptr );
+    if ( res != SQLITE_OK )
+    {
+        errors::mapToException( req.c_str(), sqlite3_errmsg( dbConnection ),
+                                res );
+    }
+    m_stmt.reset( stmt );
+}
+
+Statement::ConnectionCache& Statement::connectionCache( Connection::Handle dbConnection )
+{
+    auto generation = CacheGeneration.load( std::memory_order_acquire );
+    if ( LastHandle == dbConnection && LastGeneration == generation )
+        return *LastCache;
+    std::lock_guard<compat::Mutex> lock( StatementsCacheLock );
+    auto& cache = StatementsCache[dbConnection];
+    if ( cache == nullptr )
+        cache.reset( new ConnectionCache );
+    LastHandle = dbConnection;
+    LastCache = cache.get();
+    LastGeneration = CacheGeneration.load( std::memory_order_relaxed );
+    return *cache;
+}
+
 Row Statement::row()
 {
     auto maxRetries = 10;
@@ -184,7 +342,10 @@ Row Statement::row()
         auto extRes = sqlite3_step( m_stmt.get() );
         auto res = extRes & 0xFF;
         if ( res == SQLITE_ROW )
+        {
+            ++m_nbRows;
             return Row( m_stmt.get() );
+        }
         else if ( res == SQLITE_DONE )
             return Row{};
         else if ( ( Transaction::isInProgress() == false ||
@@ -204,6 +365,7 @@ void Statement::FlushStatementCache()
 {
     std::lock_guard<compat::Mutex> lock( StatementsCacheLock );
     StatementsCache.clear();
+    CacheGeneration.fetch_add( 1, std::memory_order_release );
 }
 
 void Statement::FlushConnectionStatementCache( Connection::Handle h )
@@ -212,6 +374,20 @@ void Statement::FlushConnectionStatementCache( Connection::Handle h )
     auto it = StatementsCache.find( h );
     if ( it != end( StatementsCache ) )
         StatementsCache.erase( it );
+    CacheGeneration.fetch_add( 1, std::memory_order_release );
+}
+
+Statement::CacheStats Statement::cacheStats()
+{
+    CacheStats stats{ 0, 0, 0 };
+    std::lock_guard<compat::Mutex> lock( StatementsCacheLock );
+    for ( const auto& p : StatementsCache )
+    {
+        stats.nbHits += p.second->nbHits.load( std::memory_order_relaxed );
+        stats.nbMisses += p.second->nbMisses.load( std::memory_order_relaxed );
+        stats.nbEvictions += p.second->nbEvictions.load( std::memory_order_relaxed );
+    }
+    return stats;
 }
 
 Row::Row(sqlite3_stmt* stmt)
@@ -241,17 +417,48 @@ bool Row::hasRemainingColumns() const
     return m_idx < m_nbColumns;
 }
 
+thread_local QueryTimer* QueryTimer::s_current;
+
 QueryTimer::QueryTimer(const std::string& req)
     : m_req( req )
     , m_chrono( std::chrono::steady_clock::now() )
+    , m_counters{}
+    , m_handle( nullptr )
+    , m_previous( s_current )
+{
+    s_current = this;
+}
+
+QueryTimer::QueryTimer( const Request& req )
+    : QueryTimer( req.str() )
 {
 }
 
 QueryTimer::~QueryTimer()
 {
-    auto duration = std::chrono::steady_clock::now() - m_chrono;
-    LOG_VERBOSE("Executed ", m_req, " in ",
-                std::chrono::duration_cast<std::chrono::microseconds>( duration ).count(), "µs" );
+    s_current = m_previous;
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_chrono );
+    LOG_VERBOSE("Executed ", m_req, " in ", duration.count(), "µs" );
+    QueryMetrics::record( m_req, duration, m_counters );
+    if ( QueryMetrics::isSlow( duration ) == true )
+        QueryMetrics::reportSlowQuery( m_handle, m_req, duration );
+}
+
+QueryTimer* QueryTimer::current()
+{
+    return s_current;
+}
+
+void QueryTimer::addStatement( Connection::Handle handle,
+                               const QueryMetrics::Counters& counters )
+{
+    m_handle = handle;
+    m_counters.nbRows += counters.nbRows;
+    m_counters.nbFullScanSteps += counters.nbFullScanSteps;
+    m_counters.nbSorts += counters.nbSorts;
+    m_counters.nbAutoIndexes += counters.nbAutoIndexes;
+    m_counters.nbVmSteps += counters.nbVmSteps;
 }
 
 }
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <memory>
@@ -34,9 +35,11 @@
 #include "Common.h"
 #include "database/SqliteConnection.h"
 #include "database/SqliteErrors.h"
+#include "database/SqliteQueryMetrics.h"
 #include "database/SqliteTraits.h"
 #include "database/SqliteTransaction.h"
 #include "logging/Logger.h"
+#include "utils/SharedPool.h"
 #include "MediaLibrary.h"
 
 namespace medialibrary
@@ -92,6 +95,22 @@ public:
         return *this;
     }
 
+    /**
+     * @brief extractLast Returns the value in the last column, and hides that
+     *        column from the other accessors.
+     *
+     * This allows a request to append a column, ie. a window, without the
+     * entity constructors noticing it.
+     */
+    template <typename T>
+    T extractLast()
+    {
+        if ( m_idx >= m_nbColumns )
+            throw errors::ColumnOutOfRange( m_idx, m_nbColumns );
+        --m_nbColumns;
+        return sqlite::Traits<T>::Load( m_stmt, m_nbColumns );
+    }
+
     /**
      * @return The number of columns in this row
      */
@@ -132,6 +151,33 @@ private:
     unsigned int m_nbColumns;
 };
 
+/**
+ * @brief The Request class holds a request which doesn't change during the
+ *        application runtime
+ *
+ * Each instance is assigned a unique index upon construction, which is used to
+ * store its compiled statement in a per-connection slot. This avoids hashing
+ * the request text and locking the global statement cache for each execution.
+ * Instances are meant to be function local statics:
+ *     static const sqlite::Request req{ "SELECT * FROM " + Table::Name };
+ * Requests built on the fly must keep using a plain std::string.
+ */
+class Request
+{
+public:
+    explicit Request( std::string req );
+    Request( const Request& ) = delete;
+    Request& operator=( const Request& ) = delete;
+
+    const std::string& str() const { return m_req; }
+    uint32_t id() const { return m_id; }
+
+private:
+    const std::string m_req;
+    const uint32_t m_id;
+    static std::atomic<uint32_t> NbRequests;
+};
+
 class Statement
 {
 public:
@@ -157,6 +203,22 @@ public:
      */
     Statement( const std::string& req );
 
+    /**
+     * @brief Statement Constructs a statement from a registered request
+     *
+     * The compiled statement is fetched from the slot associated with the
+     * request id for the given connection, which doesn't involve any hashing
+     * nor global locking.
+     */
+    Statement( Connection::Handle dbConnection, const Request& req );
+    Statement( const Request& req );
+    /**
+     * Reports the statement counters to the running QueryTimer, if any
+     */
+    ~Statement();
+    Statement( Statement&& ) = default;
+    Statement& operator=( Statement&& stmt );
+
     /**
      * @brief execute Executes the request and binds the parameters if any
      * @tparam A parameter pack representing the values to bind with the placeholders
@@ -193,6 +255,26 @@ public:
      */
     static void FlushConnectionStatementCache( Connection::Handle h );
 
+    struct CacheStats
+    {
+        uint64_t nbHits;
+        uint64_t nbMisses;
+        uint64_t nbEvictions;
+    };
+    /**
+     * @brief cacheStats Returns the statement cache counters, accumulated over
+     *                   all the connections which are currently cached
+     */
+    static CacheStats cacheStats();
+
+    /**
+     * @brief MaxCachedStatements The maximum number of statements built on the
+     *                            fly to be kept compiled for each connection
+     *
+     * This doesn't account for the registered requests, which are always kept.
+     */
+    static constexpr size_t MaxCachedStatements = 256;
+
 private:
     template <typename T>
     bool _bind( T&& value )
@@ -209,34 +291,100 @@ private:
     }
 
 private:
+    void initialize( Connection::Handle dbConnection, const std::string& req );
+    void reportCounters();
+
+private:
+    struct StatementFinalizer
+    {
+        void operator()( sqlite3_stmt* stmt ) const
+        {
+            sqlite3_finalize( stmt );
+        }
+    };
     // Used during the connection lifetime. This holds a compiled request
-    using CachedStmtPtr = std::unique_ptr<sqlite3_stmt, int (*)(sqlite3_stmt*)>;
+    using CachedStmtPtr = std::unique_ptr<sqlite3_stmt, StatementFinalizer>;
+    struct StatementReleaser
+    {
+        StatementReleaser() : nbUsers( nullptr ) {}
+
+        // The number of Statement instances using the cached statement, if
+        // it can be evicted from the cache
+        uint32_t* nbUsers;
+
+        void operator()( sqlite3_stmt* stmt ) const
+        {
+            sqlite3_clear_bindings( stmt );
+            sqlite3_reset( stmt );
+            if ( nbUsers != nullptr )
+                --*nbUsers;
+        }
+    };
     // Used for the current statement execution, this
     // basically holds the state of the currently executed request.
-    using StatementPtr = std::unique_ptr<sqlite3_stmt, void(*)(sqlite3_stmt*)>;
+    using StatementPtr = std::unique_ptr<sqlite3_stmt, StatementReleaser>;
     StatementPtr m_stmt;
     Connection::Handle m_dbConn;
     int m_bindIdx;
     bool m_isCommit;
+    uint64_t m_nbRows;
+
+    /*
+     * Each connection owns its compiled statements: the registered requests
+     * are stored in slots indexed by Request::id(), and the requests built on
+     * the fly are kept in a bounded LRU cache.
+     * Since each connection is only used by the thread that opened it, the
+     * cache for the last used connection is referenced by a thread local
+     * pointer, and the global lock is only taken when a thread starts using
+     * a new connection, or after the cache was flushed.
+     */
+    struct ConnectionCache;
+    static ConnectionCache& connectionCache( Connection::Handle dbConnection );
     static compat::Mutex StatementsCacheLock;
-    using StatementsCacheMap = std::unordered_map<std::string, CachedStmtPtr,utils::hash::xxhasher>;
-    static std::unordered_map<Connection::Handle, StatementsCacheMap> StatementsCache;
+    static std::unordered_map<Connection::Handle,
+                              std::unique_ptr<ConnectionCache>> StatementsCache;
+    static std::atomic<uint32_t> CacheGeneration;
+    static thread_local Connection::Handle LastHandle;
+    static thread_local ConnectionCache* LastCache;
+    static thread_local uint32_t LastGeneration;
 };
 
 /**
  * @brief The QueryTimer struct provides a RAII-type helper to time a query
  *
- * The results are displayed as a verbose log including the query and its duration
+ * The duration and the counters of the statements executed during the timer
+ * lifetime are recorded in the QueryMetrics, and displayed as a verbose log.
+ * Requests lasting longer than the configured threshold are reported along
+ * with their query plan.
  */
 struct QueryTimer
 {
     QueryTimer( const std::string& req );
+    QueryTimer( const Request& req );
+    // The request is held by reference, so it must outlive the timer
+    QueryTimer( std::string&& req ) = delete;
     ~QueryTimer();
+
+    /**
+     * @brief current Returns the innermost timer running on the calling thread
+     */
+    static QueryTimer* current();
+    void addStatement( Connection::Handle handle,
+                       const QueryMetrics::Counters& counters );
+
 private:
     const std::string& m_req;
     std::chrono::steady_clock::time_point m_chrono;
+    QueryMetrics::Counters m_counters;
+    Connection::Handle m_handle;
+    QueryTimer* m_previous;
+    static thread_local QueryTimer* s_current;
 };
 
+/*
+ * All the helpers below accept either a std::string or a sqlite::Request as
+ * their request parameter
+ */
 class Tools
 {
     public:
@@ -247,9 +395,9 @@ class Tools
          * @param results   A reference to the result vector. All existing elements will
          *                  be discarded.
          */
-        template <typename IMPL, typename INTF, typename... Args>
+        template <typename IMPL, typename INTF, typename Req, typename... Args>
         static std::vector<std::shared_ptr<INTF>> fetchAll( MediaLibraryPtr ml,
-                                                            const std::string& req,
+                                                            const Req& req,
                                                             Args&&... args )
         {
             auto dbConnection = ml->getConn();
@@ -259,18 +407,80 @@ class Tools
             std::vector<std::shared_ptr<INTF>> results;
             Statement stmt( Connection::Context::handle(), req );
             stmt.execute( std::forward<Args>( args )... );
+            /*
+             * Listings can return many thousands of rows, allocate the entities
+             * and their control blocks in batches instead of one by one
+             */
+            utils::SharedPool pool;
+            Row sqliteRow;
+            while ( ( sqliteRow = stmt.row() ) != nullptr )
+            {
+                auto row = pool.make_shared<IMPL>( ml, sqliteRow );
+                results.push_back( std::move( row ) );
+            }
+            return results;
+        }
+
+        /**
+         * Same as fetchAll, but each entity is passed to the provided callback
+         * instead of being stored. The read context is held until all rows
+         * were processed, or until the callback returns false.
+         * Returns false if the iteration was interrupted.
+         */
+        template <typename IMPL, typename INTF, typename Req, typename Cb,
+                  typename... Args>
+        static bool forEach( MediaLibraryPtr ml, const Req& req, Cb&& cb,
+                             Args&&... args )
+        {
+            auto dbConnection = ml->getConn();
+            OPEN_READ_CONTEXT( ctx, dbConnection );
+            QueryTimer qt{ req };
+
+            Statement stmt( Connection::Context::handle(), req );
+            stmt.execute( std::forward<Args>( args )... );
+            Row sqliteRow;
+            while ( ( sqliteRow = stmt.row() ) != nullptr )
+            {
+                std::shared_ptr<INTF> row = std::make_shared<IMPL>( ml, sqliteRow );
+                if ( cb( std::move( row ) ) == false )
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * Same as fetchAll, for a request whose last column is the total
+         * number of rows, ie. a COUNT(*) OVER () window. That column is
+         * hidden from the entity constructors.
+         * count is left untouched if the request doesn't return any row.
+         */
+        template <typename IMPL, typename INTF, typename Req, typename... Args>
+        static std::vector<std::shared_ptr<INTF>> fetchPage( MediaLibraryPtr ml,
+                                                             const Req& req,
+                                                             size_t& count,
+                                                             Args&&... args )
+        {
+            auto dbConnection = ml->getConn();
+            OPEN_READ_CONTEXT( ctx, dbConnection );
+            QueryTimer qt{ req };
+
+            std::vector<std::shared_ptr<INTF>> results;
+            Statement stmt( Connection::Context::handle(), req );
+            stmt.execute( std::forward<Args>( args )... );
+            utils::SharedPool pool;
             Row sqliteRow;
             while ( ( sqliteRow = stmt.row() ) != nullptr )
             {
-                auto row = std::make_shared<IMPL>( ml, sqliteRow );
+                count = sqliteRow.extractLast<size_t>();
+                auto row = pool.make_shared<IMPL>( ml, sqliteRow );
                 results.push_back( std::move( row ) );
             }
             return results;
         }
 
-        template <typename T, typename... Args>
+        template <typename T, typename Req, typename... Args>
         static std::shared_ptr<T> fetchOne( MediaLibraryPtr ml,
-                                            const std::string& req, Args&&... args )
+                                            const Req& req, Args&&... args )
         {
             auto dbConnection = ml->getConn();
             OPEN_READ_CONTEXT( ctx, dbConnection );
@@ -284,17 +494,17 @@ class Tools
             return nullptr;
         }
 
-        template <typename... Args>
+        template <typename Req, typename... Args>
         static void executeRequest( sqlite::Connection* dbConnection,
-                                    const std::string& req, Args&&... args )
+                                    const Req& req, Args&&... args )
         {
             OPEN_WRITE_CONTEXT( ctx, dbConnection );
             executeRequestLocked( Connection::Context::handle(), req, std::forward<Args>( args )... );
         }
 
-        template <typename... Args>
+        template <typename Req, typename... Args>
         ML_FORCE_USED static bool executeDelete( sqlite::Connection* dbConnection,
-                                                 const std::string& req,
+                                                 const Req& req,
                                                  Args&&... args )
         {
             OPEN_WRITE_CONTEXT( ctx, dbConnection );
@@ -315,9 +525,9 @@ class Tools
             return true;
         }
 
-        template <typename... Args>
+        template <typename Req, typename... Args>
         ML_FORCE_USED static bool executeUpdate( sqlite::Connection* dbConnection,
-                                                 const std::string& req,
+                                                 const Req& req,
                                                  Args&&... args )
         {
             // The code would be exactly the same, do not freak out because it calls executeDelete :)
@@ -328,9 +538,9 @@ class Tools
          * Inserts a record to the DB and return the newly created primary key.
          * Returns 0 (which is an invalid sqlite primary key) when insertion fails.
          */
-        template <typename... Args>
+        template <typename Req, typename... Args>
         ML_FORCE_USED static int64_t executeInsert( sqlite::Connection* dbConnection,
-                                                    const std::string& req,
+                                                    const Req& req,
                                                     Args&&... args )
         {
             OPEN_WRITE_CONTEXT( ctx, dbConnection );
@@ -370,9 +580,9 @@ class Tools
         static std::string sanitizePattern( const std::string& pattern );
 
     private:
-        template <typename... Args>
+        template <typename Req, typename... Args>
         static void executeRequestLocked( sqlite::Connection::Handle handle,
-                                          const std::string& req, Args&&... args )
+                                          const Req& req, Args&&... args )
         {
             QueryTimer qt{ req };
 
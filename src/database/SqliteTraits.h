@@ -23,6 +23,8 @@
 #pragma once
 
 #include <sqlite3.h>
+#include <cstring>
+#include <string>
 #include <tuple>
 #include <atomic>
 #include <utility>
@@ -98,7 +100,7 @@ struct Traits<T, typename std::enable_if<std::is_same<T, const char*>::value>::t
     {
         auto tmp = reinterpret_cast<const char*>( sqlite3_column_text( stmt, pos ) );
         if ( tmp != nullptr )
-            return std::string( tmp );
+            return std::string( tmp, sqlite3_column_bytes( stmt, pos ) );
         return std::string();
     }
 };
@@ -123,11 +125,56 @@ struct Traits<T, typename std::enable_if<IsSameDecay<T, std::string>::value>::ty
     {
         auto tmp = reinterpret_cast<const char*>( sqlite3_column_text( stmt, pos ) );
         if ( tmp != nullptr )
-            return std::string( tmp );
+            return std::string( tmp, sqlite3_column_bytes( stmt, pos ) );
         return std::string();
     }
 };
 
+/**
+ * @brief The Text struct is a non owning view over a TEXT column
+ *
+ * It points to the statement's own buffer, which is only valid until the
+ * statement gets stepped or reset, so it must not outlive the row it was loaded
+ * from. This is meant for values which are only inspected or parsed, and
+ * avoids allocating a std::string for each of them.
+ */
+struct Text
+{
+    const char* data;
+    size_t size;
+
+    std::string str() const
+    {
+        return std::string( data, size );
+    }
+
+    bool operator==( const char* rhs ) const
+    {
+        return strlen( rhs ) == size && memcmp( data, rhs, size ) == 0;
+    }
+
+    bool operator!=( const char* rhs ) const
+    {
+        return !( *this == rhs );
+    }
+};
+
+/**
+ * Traits that handles Text views. Those can only be loaded, as binding a value
+ * requires it to be owned by someone else
+ */
+template <typename T>
+struct Traits<T, typename std::enable_if<IsSameDecay<T, Text>::value>::type>
+{
+    static Text Load( sqlite3_stmt* stmt, int pos )
+    {
+        auto tmp = reinterpret_cast<const char*>( sqlite3_column_text( stmt, pos ) );
+        if ( tmp == nullptr )
+            return Text{ "", 0 };
+        return Text{ tmp, static_cast<size_t>( sqlite3_column_bytes( stmt, pos ) ) };
+    }
+};
+
 /**
  * Traits handling floating point value
  */
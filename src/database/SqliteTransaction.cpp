@@ -41,7 +41,8 @@ ActualTransaction::ActualTransaction( sqlite::Connection* dbConn )
 {
     assert( CurrentTransaction == nullptr );
     LOG_VERBOSE( "Starting SQLite transaction" );
-    Statement s( m_ctx.handle(), "BEGIN EXCLUSIVE" );
+    static const Request req{ "BEGIN EXCLUSIVE" };
+    Statement s( m_ctx.handle(), req );
     s.execute();
     while ( s.row() != nullptr )
         ;
@@ -58,7 +59,8 @@ void ActualTransaction::commitNoUnlock()
 {
     assert( CurrentTransaction != nullptr );
     auto chrono = std::chrono::steady_clock::now();
-    Statement s( m_ctx.handle(), "COMMIT" );
+    static const Request req{ "COMMIT" };
+    Statement s( m_ctx.handle(), req );
     s.execute();
     while ( s.row() != nullptr )
         ;
@@ -79,7 +81,8 @@ ActualTransaction::~ActualTransaction()
     {
         try
         {
-            Statement s( m_ctx.handle(), "ROLLBACK" );
+            static const Request req{ "ROLLBACK" };
+            Statement s( m_ctx.handle(), req );
             s.execute();
             while ( s.row() != nullptr )
                 ;
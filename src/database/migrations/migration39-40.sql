@@ -0,0 +1,8 @@
+/* Add composite indexes matching the per type media listings & their sort keys */
+Media::index( Media::Indexes::TypeTitle, 40 ),
+Media::index( Media::Indexes::TypeDuration, 40 ),
+Media::index( Media::Indexes::TypeInsertionDate, 40 ),
+Media::index( Media::Indexes::TypeReleaseDate, 40 ),
+Media::index( Media::Indexes::TypePlayCount, 40 ),
+Media::index( Media::Indexes::TypeFileName, 40 ),
+Media::index( Media::Indexes::TypeLastPlayedDate, 40 ),
@@ -0,0 +1,2 @@
+/* Add a partial index on the tasks that still need to be restored on startup */
+parser::Task::index( parser::Task::Indexes::Uncompleted, 41 ),
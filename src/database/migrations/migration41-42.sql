@@ -0,0 +1,3 @@
+/* Persist the cache folder content to avoid listing it on each startup */
+CacheManifest::schema( CacheManifest::Table::Name, 42 ),
+CacheManifest::index( CacheManifest::Indexes::Dirty, 42 ),
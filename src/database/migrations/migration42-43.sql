@@ -0,0 +1,14 @@
+/* Materialize the per entity statistics, including the public ones */
+MediaAggregate::schema( MediaAggregate::Table::Name, 43 ),
+MediaAggregate::seed( MediaAggregate::EntityType::Artist ),
+MediaAggregate::seed( MediaAggregate::EntityType::Album ),
+MediaAggregate::seed( MediaAggregate::EntityType::Genre ),
+MediaAggregate::seed( MediaAggregate::EntityType::Show ),
+MediaAggregate::index( MediaAggregate::Indexes::NbPublicTracks, 43 ),
+MediaAggregate::index( MediaAggregate::Indexes::PublicDuration, 43 ),
+MediaAggregate::trigger( MediaAggregate::Triggers::InsertMedia, 43 ),
+MediaAggregate::trigger( MediaAggregate::Triggers::DeleteMedia, 43 ),
+MediaAggregate::trigger( MediaAggregate::Triggers::UpdateMedia, 43 ),
+MediaAggregate::trigger( MediaAggregate::Triggers::InsertShowEpisode, 43 ),
+MediaAggregate::trigger( MediaAggregate::Triggers::DeleteShowEpisode, 43 ),
+MediaAggregate::trigger( MediaAggregate::Triggers::DeleteEmpty, 43 ),
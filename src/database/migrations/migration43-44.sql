@@ -0,0 +1,4 @@
+/* Store the packed thumbnails location */
+ThumbnailStore::schema( ThumbnailStore::SegmentTable::Name, 44 ),
+ThumbnailStore::schema( ThumbnailStore::Table::Name, 44 ),
+ThumbnailStore::index( ThumbnailStore::Indexes::SegmentId, 44 ),
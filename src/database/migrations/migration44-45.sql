@@ -0,0 +1,12 @@
+/* Add the media listing indexes which only filter on the import type */
+Media::index( Media::Indexes::ImportTypeTitle, 45 ),
+Media::index( Media::Indexes::ImportTypeDuration, 45 ),
+Media::index( Media::Indexes::ImportTypeInsertionDate, 45 ),
+Media::index( Media::Indexes::ImportTypeReleaseDate, 45 ),
+Media::index( Media::Indexes::ImportTypePlayCount, 45 ),
+Media::index( Media::Indexes::ImportTypeFileName, 45 ),
+Media::index( Media::Indexes::ImportTypeLastPlayedDate, 45 ),
+
+/* Break the album title ties with the artist id */
+"DROP INDEX " + Album::indexName( Album::Indexes::Title, 44 ),
+Album::index( Album::Indexes::Title, 45 ),
@@ -0,0 +1,14 @@
+/* Compute the last insertion date again when a media stops contributing */
+"DROP TRIGGER " + MediaAggregate::triggerName( MediaAggregate::Triggers::DeleteMedia, 45 ),
+"DROP TRIGGER " + MediaAggregate::triggerName( MediaAggregate::Triggers::UpdateMedia, 45 ),
+"DROP TRIGGER " + MediaAggregate::triggerName( MediaAggregate::Triggers::DeleteShowEpisode, 45 ),
+MediaAggregate::trigger( MediaAggregate::Triggers::DeleteMedia, 46 ),
+MediaAggregate::trigger( MediaAggregate::Triggers::UpdateMedia, 46 ),
+MediaAggregate::trigger( MediaAggregate::Triggers::DeleteShowEpisode, 46 ),
+
+/* Fix the dates which were left behind by previous removals */
+"DELETE FROM " + MediaAggregate::Table::Name,
+MediaAggregate::seed( MediaAggregate::EntityType::Artist ),
+MediaAggregate::seed( MediaAggregate::EntityType::Album ),
+MediaAggregate::seed( MediaAggregate::EntityType::Genre ),
+MediaAggregate::seed( MediaAggregate::EntityType::Show ),
@@ -0,0 +1,15 @@
+/*
+ * Remove the listing indexes on columns updated by each playback, and the
+ * ones for the rarely used orders of the listings without a type
+ */
+"DROP INDEX " + Media::indexName( Media::Indexes::TypePlayCount, 46 ),
+"DROP INDEX " + Media::indexName( Media::Indexes::TypeLastPlayedDate, 46 ),
+"DROP INDEX " + Media::indexName( Media::Indexes::ImportTypeDuration, 46 ),
+"DROP INDEX " + Media::indexName( Media::Indexes::ImportTypeReleaseDate, 46 ),
+"DROP INDEX " + Media::indexName( Media::Indexes::ImportTypePlayCount, 46 ),
+"DROP INDEX " + Media::indexName( Media::Indexes::ImportTypeFileName, 46 ),
+"DROP INDEX " + Media::indexName( Media::Indexes::ImportTypeLastPlayedDate, 46 ),
+
+/* Albums with the same title are ordered by artist name again */
+"DROP INDEX " + Album::indexName( Album::Indexes::Title, 46 ),
+Album::index( Album::Indexes::Title, 47 ),
@@ -34,6 +34,7 @@
 #include "utils/Filename.h"
 #include "medialibrary/filesystem/Errors.h"
 #include "utils/Defer.h"
+#include "utils/SWMRLock.h"
 #include "parser/Parser.h"
 #include "FsDiscoverer.h"
 
@@ -417,6 +418,7 @@ void DiscovererWorker::notify()
 void DiscovererWorker::run()
 {
     LOG_INFO( "Entering DiscovererWorker thread" );
+    utils::SWMRLock::setThreadClient( LockClient::Discoverer );
     m_fsHolder->registerCallback( this );
     m_ml->onDiscovererIdleChanged( false );
     runReloadAllDevices();
@@ -399,12 +399,15 @@ void FsDiscoverer::checkFolder( std::shared_ptr<fs::IDirectory> folderFs,
         if ( m_cb != nullptr )
             m_cb->onDiscoveryProgress( currentDirFs->mrl() );
         auto subFoldersInDB = currentDir->folders();
+        std::string decodeBuffer;
         for ( const auto& subFolder : currentDirFs->dirs() )
         {
+            /* Decode the name once, not once per comparison */
+            auto subFolderName = utils::file::directoryName( subFolder->mrl() );
+            const auto& decodedName = utils::url::decode( subFolderName, decodeBuffer );
             auto it = std::find_if( begin( subFoldersInDB ), end( subFoldersInDB ),
-                                    [&subFolder](const std::shared_ptr<Folder>& f) {
-                auto subFolderName = utils::file::directoryName( subFolder->mrl() );
-                return f->name() == utils::url::decode( subFolderName );
+                                    [&decodedName](const std::shared_ptr<Folder>& f) {
+                return f->name() == decodedName;
             });
             // We don't know this folder, it's a new one
             if ( it == end( subFoldersInDB ) )
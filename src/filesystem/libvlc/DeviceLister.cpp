@@ -28,7 +28,6 @@
 #include "utils/VLCInstance.h"
 #include "utils/Filename.h"
 #include "utils/Url.h"
-#include "filesystem/libvlc/Device.h"
 
 #include "logging/Logger.h"
 
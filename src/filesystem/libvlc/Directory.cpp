@@ -56,11 +56,31 @@ namespace fs
 namespace libvlc
 {
 
+namespace
+{
+
+/*
+ * Normalizes the MRL encoding. Most MRLs provided by libvlc are already
+ * properly encoded, in which case no copy is performed.
+ */
+std::string normalizeMrl( std::string mrl )
+{
+    std::string decodeBuffer;
+    std::string encodeBuffer;
+    const auto& decoded = utils::url::decode( mrl, decodeBuffer );
+    const auto& encoded = utils::url::encode( decoded, encodeBuffer );
+    if ( &encoded == &mrl )
+        return mrl;
+    if ( &encoded == &decodeBuffer )
+        return decodeBuffer;
+    return encodeBuffer;
+}
+
+}
+
 Directory::Directory( std::string mrl, fs::IFileSystemFactory& fsFactory )
     : CommonDirectory( fsFactory )
-    , m_mrl( utils::file::toFolderPath(
-                 utils::url::encode(
-                     utils::url::decode( std::move( mrl ) ) ) ) )
+    , m_mrl( utils::file::toFolderPath( normalizeMrl( std::move( mrl ) ) ) )
 {
 }
 
@@ -22,12 +22,7 @@
 
 #pragma once
 
-#include "medialibrary/filesystem/IFileSystemFactory.h"
-#include "medialibrary/IDeviceLister.h"
-#include "compat/Mutex.h"
-#include "compat/ConditionVariable.h"
-#include "Types.h"
-#include <vector>
+#include "filesystem/common/CommonFileSystemFactory.h"
 
 namespace medialibrary
 {
@@ -37,44 +32,11 @@ namespace fs
 namespace libvlc
 {
 
-class FileSystemFactory : public fs::IFileSystemFactory, public IDeviceListerCb
+class FileSystemFactory : public CommonFileSystemFactory
 {
 public:
-    /**
-     * @brief FileSystemFactory Constructs a filesystem factory for the given scheme
-     * @param scheme The targeted scheme, including '://'
-     */
-    FileSystemFactory( const std::string& scheme );
-    virtual bool initialize( const IMediaLibrary* ml ) override;
+    using CommonFileSystemFactory::CommonFileSystemFactory;
     virtual std::shared_ptr<fs::IDirectory> createDirectory( const std::string& mrl ) override;
-    virtual std::shared_ptr<fs::IFile> createFile( const std::string& mrl ) override;
-    virtual std::shared_ptr<fs::IDevice> createDevice( const std::string& uuid ) override;
-    virtual std::shared_ptr<fs::IDevice> createDeviceFromMrl( const std::string& mrl ) override;
-    virtual void refreshDevices() override;
-    virtual bool isMrlSupported( const std::string& mrl ) const override;
-    virtual bool isNetworkFileSystem() const override;
-    virtual const std::string& scheme() const override;
-    virtual bool start( fs::IFileSystemFactoryCb* cb ) override;
-    virtual void stop() override;
-    virtual bool isStarted() const override;
-    virtual bool waitForDevice( const std::string& mrl, uint32_t timeout ) const override;
-
-private:
-    virtual void onDeviceMounted( const std::string& uuid,
-                                  const std::string& mountpoint, bool removable ) override;
-    virtual void onDeviceUnmounted( const std::string& uuid, const std::string& mountpoint ) override;
-
-    std::shared_ptr<fs::IDevice> deviceByUuidLocked( const std::string& uuid );
-    std::shared_ptr<fs::IDevice> deviceByMrlLocked( const std::string& mrl );
-
-private:
-    const std::string m_scheme;
-    mutable compat::Mutex m_devicesLock;
-    mutable compat::ConditionVariable m_devicesCond;
-    std::vector<std::shared_ptr<fs::IDevice>> m_devices;
-    std::shared_ptr<IDeviceLister> m_deviceLister;
-    fs::IFileSystemFactoryCb* m_cb;
-    bool m_isNetwork;
 };
 
 }
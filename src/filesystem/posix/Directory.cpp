@@ -0,0 +1,400 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Directory.h"
+#include "File.h"
+#ifdef HAVE_IO_URING
+# include "IoUring.h"
+#endif
+#include "utils/Filename.h"
+#include "utils/Url.h"
+#include "medialibrary/IMediaLibrary.h"
+#include "medialibrary/filesystem/Errors.h"
+#include "logging/Logger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace medialibrary
+{
+namespace fs
+{
+namespace posix
+{
+
+namespace
+{
+
+/*
+ * Layout of the records returned by getdents64. We go through the raw syscall
+ * since the glibc wrapper is only available starting with 2.30
+ */
+struct LinuxDirent64
+{
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[256];
+};
+
+class ScopedFd
+{
+public:
+    explicit ScopedFd( int fd ) : m_fd( fd ) {}
+    ~ScopedFd() { if ( m_fd >= 0 ) ::close( m_fd ); }
+    ScopedFd( const ScopedFd& ) = delete;
+    ScopedFd& operator=( const ScopedFd& ) = delete;
+    int get() const { return m_fd; }
+
+private:
+    int m_fd;
+};
+
+enum class EntryType
+{
+    Directory,
+    File,
+    Other,
+};
+
+struct EntryInfo
+{
+    EntryType type;
+    time_t lastModificationDate;
+    uint64_t size;
+};
+
+struct PendingEntry
+{
+    std::string name;
+    EntryInfo info;
+    /* 0, or the errno reported while fetching the entry info */
+    int error;
+};
+
+EntryType entryType( mode_t mode )
+{
+    if ( S_ISDIR( mode ) )
+        return EntryType::Directory;
+    if ( S_ISREG( mode ) )
+        return EntryType::File;
+    return EntryType::Other;
+}
+
+#ifdef HAVE_STATX
+/* Symbolic links are followed, like libvlc does */
+constexpr auto StatxFlags = AT_NO_AUTOMOUNT;
+constexpr auto StatxMask = STATX_TYPE | STATX_MTIME | STATX_SIZE;
+
+void fromStatx( const struct statx& s, EntryInfo& info )
+{
+    info.type = entryType( s.stx_mode );
+    info.lastModificationDate = s.stx_mtime.tv_sec;
+    info.size = s.stx_size;
+}
+#endif
+
+/*
+ * Fetches the type, size & modification date of an entry relative to the
+ * directory being browsed.
+ */
+void statEntry( int dirFd, PendingEntry& e )
+{
+#ifdef HAVE_STATX
+    struct statx s;
+    if ( statx( dirFd, e.name.c_str(), StatxFlags, StatxMask, &s ) != 0 )
+    {
+        e.error = errno;
+        return;
+    }
+    fromStatx( s, e.info );
+#else
+    struct stat s;
+    if ( fstatat( dirFd, e.name.c_str(), &s, 0 ) != 0 )
+    {
+        e.error = errno;
+        return;
+    }
+    e.info.type = entryType( s.st_mode );
+    e.info.lastModificationDate = s.st_mtime;
+    e.info.size = s.st_size;
+#endif
+    e.error = 0;
+}
+
+/*
+ * Fetches all the entries info at once through io_uring when possible, which
+ * keeps many requests in flight for storages which benefit from it (network
+ * or FUSE mounts, spinning disks...)
+ */
+void statEntries( int dirFd, std::vector<PendingEntry>& entries )
+{
+#ifdef HAVE_IO_URING
+    auto ring = entries.size() > 1 ? IoUring::instance() : nullptr;
+    if ( ring != nullptr )
+    {
+        std::vector<struct statx> bufs( entries.size() );
+        std::vector<IoUring::StatxRequest> reqs;
+        reqs.reserve( entries.size() );
+        for ( auto i = 0u; i < entries.size(); ++i )
+            reqs.push_back( IoUring::StatxRequest{ entries[i].name.c_str(),
+                                                   &bufs[i], 0 } );
+        if ( ring->statx( dirFd, StatxFlags, StatxMask, reqs.data(),
+                          reqs.size() ) == true )
+        {
+            for ( auto i = 0u; i < entries.size(); ++i )
+            {
+                if ( reqs[i].res < 0 )
+                {
+                    entries[i].error = -reqs[i].res;
+                    continue;
+                }
+                fromStatx( bufs[i], entries[i].info );
+                entries[i].error = 0;
+            }
+            return;
+        }
+    }
+#endif
+    for ( auto& e : entries )
+        statEntry( dirFd, e );
+}
+
+/*
+ * Audio files which are only expected to be found alongside a video, and that
+ * will be linked to it when their names match.
+ */
+bool isSoundtrackExtension( const std::string& ext )
+{
+    static const char* const extensions[] = {
+        "a52", "ac3", "dts", "dtshd", "eac3", "mka",
+    };
+    return std::any_of( std::begin( extensions ), std::end( extensions ),
+                        [&ext]( const char* e ) {
+        return strcasecmp( e, ext.c_str() ) == 0;
+    });
+}
+
+/*
+ * Lowercases the file name without its extension, and replaces all the
+ * punctuation & whitespace sequences by a single space, so that
+ * "My.Movie (2001).en.srt" can be matched with "my movie (2001).mkv"
+ */
+std::string matchKey( const std::string& fileName )
+{
+    auto name = utils::file::stripExtension( fileName );
+    std::string res;
+    res.reserve( name.size() );
+    auto pendingSpace = false;
+    for ( auto c : name )
+    {
+        if ( isalnum( static_cast<unsigned char>( c ) ) == 0 &&
+             ( static_cast<unsigned char>( c ) & 0x80 ) == 0 )
+        {
+            pendingSpace = res.empty() == false;
+            continue;
+        }
+        if ( pendingSpace == true )
+        {
+            res.push_back( ' ' );
+            pendingSpace = false;
+        }
+        res.push_back( static_cast<char>(
+                           tolower( static_cast<unsigned char>( c ) ) ) );
+    }
+    return res;
+}
+
+}
+
+Directory::Directory( std::string mrl, fs::IFileSystemFactory& fsFactory )
+    : CommonDirectory( fsFactory )
+    , m_path( utils::file::toFolderPath( utils::url::toLocalPath( mrl ) ) )
+    , m_mrl( utils::file::toMrl( m_path ) )
+{
+}
+
+const std::string& Directory::mrl() const
+{
+    return m_mrl;
+}
+
+void Directory::read() const
+{
+    ScopedFd fd{ open( m_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC ) };
+    if ( fd.get() < 0 )
+    {
+        LOG_ERROR( "Failed to open directory ", m_path );
+        throw errors::System{ errno, "Failed to open directory" };
+    }
+
+    std::vector<PendingEntry> pending;
+    alignas( LinuxDirent64 ) char buffer[32 * 1024];
+    while ( true )
+    {
+        auto nbBytes = syscall( SYS_getdents64, fd.get(), buffer, sizeof( buffer ) );
+        if ( nbBytes < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+            LOG_ERROR( "Failed to list directory ", m_path );
+            throw errors::System{ errno, "Failed to list directory" };
+        }
+        if ( nbBytes == 0 )
+            break;
+        for ( long offset = 0; offset < nbBytes; )
+        {
+            auto d = reinterpret_cast<const LinuxDirent64*>( buffer + offset );
+            offset += d->d_reclen;
+            const char* name = d->d_name;
+            if ( name[0] == '.' )
+            {
+                if ( name[1] == 0 || ( name[1] == '.' && name[2] == 0 ) )
+                    continue;
+                /*
+                 * We need to expose the .nomedia file to the discoverer, but we
+                 * don't want to bother with hidden files & folders since they
+                 * would be ignored later on.
+                 * However, we consider something starting with '..' as a
+                 * non-hidden file or folder, see #218
+                 */
+                if ( strcasecmp( name, ".nomedia" ) != 0 && name[1] != '.' )
+                    continue;
+            }
+            /*
+             * Folders don't need any stat, but files need their size and
+             * modification date, and links/unknown types need to be resolved.
+             * Those are fetched once the whole folder has been listed, so
+             * they can be batched.
+             */
+            if ( d->d_type == DT_DIR )
+            {
+                m_dirs.push_back( std::make_shared<Directory>(
+                                      m_mrl + utils::url::encode( name ),
+                                      m_fsFactory ) );
+                continue;
+            }
+            if ( d->d_type != DT_REG && d->d_type != DT_LNK &&
+                 d->d_type != DT_UNKNOWN )
+                continue;
+            pending.push_back( PendingEntry{ name, EntryInfo{}, 0 } );
+        }
+    }
+
+    statEntries( fd.get(), pending );
+    std::vector<Entry> files;
+    files.reserve( pending.size() );
+    for ( auto& e : pending )
+    {
+        if ( e.error != 0 )
+        {
+            if ( e.error == EACCES )
+                continue;
+            /* The entry might have been removed since we listed it */
+            if ( e.error == ENOENT )
+            {
+                LOG_WARN( "Ignoring unexpected ENOENT while listing folder content." );
+                continue;
+            }
+            LOG_ERROR( "Failed to get file ", e.name, " info" );
+            throw errors::System{ e.error, "Failed to get file info" };
+        }
+        if ( e.info.type == EntryType::Directory )
+            m_dirs.push_back( std::make_shared<Directory>(
+                                  m_mrl + utils::url::encode( e.name ),
+                                  m_fsFactory ) );
+        else if ( e.info.type == EntryType::File )
+            files.push_back( Entry{ std::move( e.name ),
+                                    e.info.lastModificationDate, e.info.size } );
+    }
+    addFiles( std::move( files ) );
+}
+
+void Directory::addFiles( std::vector<Entry> entries ) const
+{
+    /*
+     * Mimic libvlc's subtitles & soundtrack autodetection, using the fuzziness
+     * the libvlc backend requests: a file is linked to the media with the longest name that its
+     * own name contains.
+     */
+    struct Candidate
+    {
+        const Entry* entry;
+        std::string key;
+        std::string mrl;
+    };
+    std::vector<Candidate> media;
+    std::vector<std::pair<const Entry*, IFile::LinkedFileType>> linkable;
+    for ( const auto& e : entries )
+    {
+        auto ext = utils::file::extension( e.name );
+        if ( isSubtitleExtensionSupported( ext.c_str() ) == true )
+            linkable.emplace_back( &e, IFile::LinkedFileType::Subtitles );
+        else if ( isSoundtrackExtension( ext ) == true )
+            linkable.emplace_back( &e, IFile::LinkedFileType::SoundTrack );
+        else
+        {
+            auto mrl = m_mrl + utils::url::encode( e.name );
+            if ( isMediaExtensionSupported( ext.c_str() ) == true )
+                media.push_back( Candidate{ &e, matchKey( e.name ), mrl } );
+            m_files.push_back( std::make_shared<File>( std::move( mrl ),
+                               e.lastModificationDate, e.size ) );
+        }
+    }
+    for ( const auto& l : linkable )
+    {
+        auto key = matchKey( l.first->name );
+        const Candidate* linkedWith = nullptr;
+        for ( const auto& m : media )
+        {
+            if ( m.key.empty() == true || key.find( m.key ) == std::string::npos )
+                continue;
+            if ( linkedWith == nullptr || m.key.size() > linkedWith->key.size() )
+                linkedWith = &m;
+        }
+        auto mrl = m_mrl + utils::url::encode( l.first->name );
+        if ( linkedWith == nullptr )
+            m_files.push_back( std::make_shared<File>( std::move( mrl ),
+                               l.first->lastModificationDate, l.first->size ) );
+        else
+            m_files.push_back( std::make_shared<File>( std::move( mrl ),
+                               l.first->lastModificationDate, l.first->size,
+                               l.second, linkedWith->mrl ) );
+    }
+}
+
+}
+}
+}
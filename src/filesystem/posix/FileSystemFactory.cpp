@@ -1,7 +1,7 @@
 /*****************************************************************************
  * Media Library
  *****************************************************************************
- * Copyright (C) 2015-2019 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
  *
  * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
  *
@@ -24,18 +24,26 @@
 # include "config.h"
 #endif
 
-#ifndef HAVE_LIBVLC
-# error This file requires libvlc
-#endif
-
-#include "Device.h"
+#include "FileSystemFactory.h"
+#include "Directory.h"
 
 namespace medialibrary
 {
-
 namespace fs
 {
+namespace posix
+{
+
+FileSystemFactory::FileSystemFactory()
+    : CommonFileSystemFactory( "file://" )
+{
+}
 
+std::shared_ptr<fs::IDirectory> FileSystemFactory::createDirectory( const std::string& mrl )
+{
+    return std::make_shared<Directory>( mrl, *this );
 }
 
 }
+}
+}
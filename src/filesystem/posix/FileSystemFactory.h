@@ -1,7 +1,7 @@
 /*****************************************************************************
  * Media Library
  *****************************************************************************
- * Copyright (C) 2015-2019 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
  *
  * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
  *
@@ -22,25 +22,26 @@
 
 #pragma once
 
-#include "filesystem/common/CommonDevice.h"
+#include "filesystem/common/CommonFileSystemFactory.h"
 
 namespace medialibrary
 {
-
 namespace fs
 {
-
-namespace libvlc
+namespace posix
 {
 
-class Device : public CommonDevice
+/*
+ * Browses local folders using the native Linux APIs instead of libvlc's
+ * directory access module.
+ */
+class FileSystemFactory : public CommonFileSystemFactory
 {
 public:
-    using CommonDevice::CommonDevice;
+    FileSystemFactory();
+    virtual std::shared_ptr<fs::IDirectory> createDirectory( const std::string& mrl ) override;
 };
 
 }
-
 }
-
 }
@@ -0,0 +1,281 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "IoUring.h"
+#include "logging/Logger.h"
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace medialibrary
+{
+namespace fs
+{
+namespace posix
+{
+
+namespace
+{
+
+/* The completion ring is twice as big, so this can't overflow it */
+constexpr uint32_t QueueDepth = 64;
+
+inline uint32_t loadAcquire( const uint32_t* p )
+{
+    return __atomic_load_n( p, __ATOMIC_ACQUIRE );
+}
+
+inline void storeRelease( uint32_t* p, uint32_t v )
+{
+    __atomic_store_n( p, v, __ATOMIC_RELEASE );
+}
+
+}
+
+IoUring* IoUring::instance()
+{
+    static thread_local std::unique_ptr<IoUring> ring;
+    static thread_local bool initialized = false;
+    if ( initialized == false )
+    {
+        initialized = true;
+        ring.reset( new IoUring );
+        if ( ring->setup() == false )
+        {
+            LOG_DEBUG( "io_uring is not available, using synchronous stats" );
+            ring.reset();
+        }
+    }
+    if ( ring != nullptr && ring->m_statxSupported == false )
+        return nullptr;
+    return ring.get();
+}
+
+IoUring::IoUring()
+    : m_fd( -1 )
+    , m_statxSupported( true )
+    , m_sqRing( MAP_FAILED )
+    , m_sqRingSize( 0 )
+    , m_cqRing( MAP_FAILED )
+    , m_cqRingSize( 0 )
+    , m_sqes( static_cast<io_uring_sqe*>( MAP_FAILED ) )
+    , m_sqesSize( 0 )
+    , m_sqEntries( 0 )
+    , m_sqHead( nullptr )
+    , m_sqTail( nullptr )
+    , m_sqMask( nullptr )
+    , m_sqArray( nullptr )
+    , m_cqHead( nullptr )
+    , m_cqTail( nullptr )
+    , m_cqMask( nullptr )
+    , m_cqes( nullptr )
+{
+}
+
+IoUring::~IoUring()
+{
+    if ( m_sqes != MAP_FAILED )
+        munmap( m_sqes, m_sqesSize );
+    if ( m_cqRing != MAP_FAILED && m_cqRing != m_sqRing )
+        munmap( m_cqRing, m_cqRingSize );
+    if ( m_sqRing != MAP_FAILED )
+        munmap( m_sqRing, m_sqRingSize );
+    if ( m_fd >= 0 )
+        close( m_fd );
+}
+
+bool IoUring::setup()
+{
+    io_uring_params params;
+    memset( &params, 0, sizeof( params ) );
+    /*
+     * This will fail with ENOSYS on kernels older than 5.1, and with EPERM
+     * when io_uring is disabled through the kernel.io_uring_disabled sysctl
+     * or a seccomp filter.
+     */
+    m_fd = syscall( __NR_io_uring_setup, QueueDepth, &params );
+    if ( m_fd < 0 )
+        return false;
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof( uint32_t );
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof( io_uring_cqe );
+    auto singleMmap = ( params.features & IORING_FEAT_SINGLE_MMAP ) != 0;
+    if ( singleMmap == true )
+    {
+        if ( m_cqRingSize > m_sqRingSize )
+            m_sqRingSize = m_cqRingSize;
+        m_cqRingSize = m_sqRingSize;
+    }
+    m_sqRing = mmap( nullptr, m_sqRingSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING );
+    if ( m_sqRing == MAP_FAILED )
+        return false;
+    if ( singleMmap == true )
+        m_cqRing = m_sqRing;
+    else
+    {
+        m_cqRing = mmap( nullptr, m_cqRingSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING );
+        if ( m_cqRing == MAP_FAILED )
+            return false;
+    }
+    m_sqesSize = params.sq_entries * sizeof( io_uring_sqe );
+    m_sqes = static_cast<io_uring_sqe*>( mmap( nullptr, m_sqesSize,
+                    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                    IORING_OFF_SQES ) );
+    if ( m_sqes == MAP_FAILED )
+        return false;
+
+    auto sq = static_cast<uint8_t*>( m_sqRing );
+    m_sqEntries = params.sq_entries;
+    m_sqHead = reinterpret_cast<uint32_t*>( sq + params.sq_off.head );
+    m_sqTail = reinterpret_cast<uint32_t*>( sq + params.sq_off.tail );
+    m_sqMask = reinterpret_cast<uint32_t*>( sq + params.sq_off.ring_mask );
+    m_sqArray = reinterpret_cast<uint32_t*>( sq + params.sq_off.array );
+
+    auto cq = static_cast<uint8_t*>( m_cqRing );
+    m_cqHead = reinterpret_cast<uint32_t*>( cq + params.cq_off.head );
+    m_cqTail = reinterpret_cast<uint32_t*>( cq + params.cq_off.tail );
+    m_cqMask = reinterpret_cast<uint32_t*>( cq + params.cq_off.ring_mask );
+    m_cqes = reinterpret_cast<io_uring_cqe*>( cq + params.cq_off.cqes );
+    return true;
+}
+
+bool IoUring::submitAndWait()
+{
+    while ( true )
+    {
+        auto toSubmit = *m_sqTail - loadAcquire( m_sqHead );
+        auto res = syscall( __NR_io_uring_enter, m_fd, toSubmit, 1,
+                            IORING_ENTER_GETEVENTS, nullptr, 0 );
+        if ( res >= 0 )
+            return true;
+        /*
+         * On EAGAIN & EBUSY the kernel is short on resources, and will make
+         * progress as the pending requests complete.
+         */
+        if ( errno != EINTR && errno != EAGAIN && errno != EBUSY )
+            return false;
+    }
+}
+
+size_t IoUring::reap( StatxRequest* reqs, bool& unsupported )
+{
+    auto head = *m_cqHead;
+    auto cqTail = loadAcquire( m_cqTail );
+    auto cqMask = *m_cqMask;
+    size_t nbReaped = 0;
+    for ( ; head != cqTail; ++head )
+    {
+        const auto& cqe = m_cqes[head & cqMask];
+        reqs[cqe.user_data].res = cqe.res;
+        /*
+         * Kernels before 5.6 don't know about IORING_OP_STATX and will
+         * reject it.
+         */
+        if ( cqe.res == -EINVAL )
+            unsupported = true;
+        ++nbReaped;
+    }
+    storeRelease( m_cqHead, head );
+    return nbReaped;
+}
+
+bool IoUring::statx( int dirFd, int flags, unsigned int mask,
+                     StatxRequest* reqs, size_t nbReqs )
+{
+    size_t submitted = 0;
+    size_t completed = 0;
+    auto unsupported = false;
+    while ( completed < nbReqs )
+    {
+        auto tail = *m_sqTail;
+        auto sqMask = *m_sqMask;
+        while ( submitted < nbReqs &&
+                tail - loadAcquire( m_sqHead ) < m_sqEntries &&
+                submitted - completed < m_sqEntries )
+        {
+            auto idx = tail & sqMask;
+            auto& sqe = m_sqes[idx];
+            memset( &sqe, 0, sizeof( sqe ) );
+            sqe.opcode = IORING_OP_STATX;
+            sqe.fd = dirFd;
+            sqe.addr = reinterpret_cast<uintptr_t>( reqs[submitted].path );
+            sqe.len = mask;
+            sqe.off = reinterpret_cast<uintptr_t>( reqs[submitted].buf );
+            sqe.statx_flags = flags;
+            sqe.user_data = submitted;
+            m_sqArray[idx] = idx;
+            ++tail;
+            ++submitted;
+        }
+        storeRelease( m_sqTail, tail );
+
+        if ( submitAndWait() == false )
+        {
+            auto err = errno;
+            /*
+             * Take back the requests the kernel didn't consume yet, and wait
+             * for the ones it did: it may still write into the caller's
+             * buffers until their completion is posted.
+             */
+            auto sqHead = loadAcquire( m_sqHead );
+            storeRelease( m_sqTail, sqHead );
+            auto inFlight = submitted - completed - ( tail - sqHead );
+            while ( inFlight > 0 )
+            {
+                auto nbReaped = reap( reqs, unsupported );
+                completed += nbReaped;
+                inFlight -= nbReaped;
+                /* If waiting keeps failing, poll the completion queue */
+                if ( inFlight > 0 && submitAndWait() == false )
+                    usleep( 1000 );
+            }
+            LOG_WARN( "Failed to submit io_uring requests: ", strerror( err ),
+                      ". Using synchronous stats" );
+            m_statxSupported = false;
+            return false;
+        }
+        completed += reap( reqs, unsupported );
+    }
+    if ( unsupported == true )
+    {
+        LOG_INFO( "io_uring doesn't support statx, using synchronous stats" );
+        m_statxSupported = false;
+        return false;
+    }
+    return true;
+}
+
+}
+}
+}
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef HAVE_IO_URING
+# error This file requires io_uring support
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+#include <linux/io_uring.h>
+#include <sys/stat.h>
+
+namespace medialibrary
+{
+namespace fs
+{
+namespace posix
+{
+
+/*
+ * Minimal io_uring wrapper, used to batch the metadata requests issued while
+ * browsing a directory.
+ * There is no liburing dependency, the ring is driven through the raw syscalls.
+ * Rings are bound to the thread which created them.
+ */
+class IoUring
+{
+public:
+    struct StatxRequest
+    {
+        const char* path;
+        struct statx* buf;
+        /* 0 on success, or a negative errno value */
+        int res;
+    };
+
+    /**
+     * @brief instance Returns the calling thread's ring
+     * @return The ring, or nullptr if io_uring isn't usable on this system, in
+     *         which case the caller is expected to fallback to synchronous calls
+     */
+    static IoUring* instance();
+
+    ~IoUring();
+    IoUring( const IoUring& ) = delete;
+    IoUring& operator=( const IoUring& ) = delete;
+
+    /**
+     * @brief statx Runs a statx for each request, relatively to dirFd
+     * @return false if io_uring turned out not to be usable, in which case the
+     *         results are undefined and the caller must fallback to synchronous
+     *         calls for all the requests.
+     *
+     * This will keep as many requests in flight as the ring allows, and only
+     * returns once all of them have completed, including when failing.
+     */
+    bool statx( int dirFd, int flags, unsigned int mask,
+                StatxRequest* reqs, size_t nbReqs );
+
+private:
+    IoUring();
+    bool setup();
+    bool submitAndWait();
+    /* Consumes the available completions, and returns how many there were */
+    size_t reap( StatxRequest* reqs, bool& unsupported );
+
+private:
+    int m_fd;
+    bool m_statxSupported;
+
+    void* m_sqRing;
+    size_t m_sqRingSize;
+    void* m_cqRing;
+    size_t m_cqRingSize;
+    io_uring_sqe* m_sqes;
+    size_t m_sqesSize;
+
+    uint32_t m_sqEntries;
+    uint32_t* m_sqHead;
+    uint32_t* m_sqTail;
+    uint32_t* m_sqMask;
+    uint32_t* m_sqArray;
+
+    uint32_t* m_cqHead;
+    uint32_t* m_cqTail;
+    uint32_t* m_cqMask;
+    io_uring_cqe* m_cqes;
+};
+
+}
+}
+}
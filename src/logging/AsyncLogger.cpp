@@ -0,0 +1,186 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "AsyncLogger.h"
+
+#include <cassert>
+
+namespace medialibrary
+{
+
+constexpr size_t AsyncLogger::DefaultCapacity;
+
+AsyncLogger::AsyncLogger( std::shared_ptr<ILogger> sink, size_t capacity )
+    : m_sink( std::move( sink ) )
+    , m_entries( capacity )
+    , m_head( 0 )
+    , m_size( 0 )
+    , m_writing( false )
+    , m_stop( false )
+    , m_nbDropped( 0 )
+    , m_nbUnreported( 0 )
+{
+    assert( m_sink != nullptr );
+    assert( capacity > 0 );
+    m_thread = compat::Thread{ &AsyncLogger::run, this };
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    {
+        std::lock_guard<compat::Mutex> lock( m_lock );
+        m_stop = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+}
+
+void AsyncLogger::Error( const std::string& msg )
+{
+    push( LogLevel::Error, msg );
+}
+
+void AsyncLogger::Warning( const std::string& msg )
+{
+    push( LogLevel::Warning, msg );
+}
+
+void AsyncLogger::Info( const std::string& msg )
+{
+    push( LogLevel::Info, msg );
+}
+
+void AsyncLogger::Debug( const std::string& msg )
+{
+    push( LogLevel::Debug, msg );
+}
+
+void AsyncLogger::Verbose( const std::string& msg )
+{
+    push( LogLevel::Verbose, msg );
+}
+
+void AsyncLogger::flush()
+{
+    std::unique_lock<compat::Mutex> lock( m_lock );
+    m_flushedCond.wait( lock, [this]() {
+        return m_size == 0 && m_writing == false;
+    });
+}
+
+uint64_t AsyncLogger::nbDropped() const
+{
+    std::lock_guard<compat::Mutex> lock( m_lock );
+    return m_nbDropped;
+}
+
+void AsyncLogger::push( LogLevel level, const std::string& msg )
+{
+    {
+        std::lock_guard<compat::Mutex> lock( m_lock );
+        if ( m_size == m_entries.size() )
+        {
+            ++m_nbDropped;
+            ++m_nbUnreported;
+            return;
+        }
+        auto& e = m_entries[( m_head + m_size ) % m_entries.size()];
+        e.level = level;
+        /* Reuse the entry's string allocation when possible */
+        e.msg.assign( msg );
+        ++m_size;
+        if ( m_size > 1 )
+            return;
+    }
+    m_cond.notify_one();
+}
+
+void AsyncLogger::write( LogLevel level, const std::string& msg )
+{
+    switch ( level )
+    {
+    case LogLevel::Error:
+        m_sink->Error( msg );
+        break;
+    case LogLevel::Warning:
+        m_sink->Warning( msg );
+        break;
+    case LogLevel::Info:
+        m_sink->Info( msg );
+        break;
+    case LogLevel::Debug:
+        m_sink->Debug( msg );
+        break;
+    case LogLevel::Verbose:
+        m_sink->Verbose( msg );
+        break;
+    }
+}
+
+void AsyncLogger::run()
+{
+    std::vector<Entry> batch;
+    std::unique_lock<compat::Mutex> lock( m_lock );
+    while ( true )
+    {
+        m_cond.wait( lock, [this]() {
+            return m_size > 0 || m_stop == true;
+        });
+        if ( m_size == 0 )
+        {
+            /* Only exit once the queued messages were all written */
+            assert( m_stop == true );
+            break;
+        }
+        /*
+         * Swap the entries with the previous batch ones instead of copying
+         * them, so that the string allocations keep being reused
+         */
+        batch.resize( m_size );
+        for ( auto i = 0u; i < m_size; ++i )
+            std::swap( batch[i], m_entries[( m_head + i ) % m_entries.size()] );
+        m_head = ( m_head + m_size ) % m_entries.size();
+        m_size = 0;
+        auto nbUnreported = m_nbUnreported;
+        m_nbUnreported = 0;
+        m_writing = true;
+        lock.unlock();
+
+        for ( const auto& e : batch )
+            write( e.level, e.msg );
+        if ( nbUnreported > 0 )
+            m_sink->Warning( "AsyncLogger: " + std::to_string( nbUnreported ) +
+                             " messages were dropped" );
+
+        lock.lock();
+        m_writing = false;
+        if ( m_size == 0 )
+            m_flushedCond.notify_all();
+    }
+    m_flushedCond.notify_all();
+}
+
+}
@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include "medialibrary/ILogger.h"
+#include "compat/ConditionVariable.h"
+#include "compat/Mutex.h"
+#include "compat/Thread.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace medialibrary
+{
+
+/**
+ * @brief The AsyncLogger class forwards the messages to another logger from a
+ * dedicated thread
+ *
+ * Logging threads only copy their message into a fixed size ring buffer, so
+ * they are never serialized on a slow sink. When the buffer is full, the new
+ * messages are dropped, and the number of dropped messages is reported to the
+ * sink once some space is available again.
+ */
+class AsyncLogger : public ILogger
+{
+public:
+    static constexpr size_t DefaultCapacity = 1024;
+
+    explicit AsyncLogger( std::shared_ptr<ILogger> sink,
+                          size_t capacity = DefaultCapacity );
+    virtual ~AsyncLogger();
+
+    virtual void Error( const std::string& msg ) override;
+    virtual void Warning( const std::string& msg ) override;
+    virtual void Info( const std::string& msg ) override;
+    virtual void Debug( const std::string& msg ) override;
+    virtual void Verbose( const std::string& msg ) override;
+
+    /**
+     * @brief flush Blocks until all the queued messages were written to the sink
+     */
+    void flush();
+
+    /**
+     * @brief nbDropped Returns the number of messages dropped so far
+     */
+    uint64_t nbDropped() const;
+
+private:
+    struct Entry
+    {
+        LogLevel level;
+        std::string msg;
+    };
+
+    void push( LogLevel level, const std::string& msg );
+    void write( LogLevel level, const std::string& msg );
+    void run();
+
+private:
+    std::shared_ptr<ILogger> m_sink;
+    mutable compat::Mutex m_lock;
+    compat::ConditionVariable m_cond;
+    compat::ConditionVariable m_flushedCond;
+    /* The ring buffer, m_entries.size() being its capacity */
+    std::vector<Entry> m_entries;
+    size_t m_head;
+    size_t m_size;
+    bool m_writing;
+    bool m_stop;
+    uint64_t m_nbDropped;
+    /* The dropped messages which weren't reported to the sink yet */
+    uint64_t m_nbUnreported;
+    compat::Thread m_thread;
+};
+
+}
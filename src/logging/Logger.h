@@ -82,6 +82,11 @@ public:
         return s_logLevel.load( std::memory_order_relaxed );
     }
 
+    static bool isEnabled( LogLevel level )
+    {
+        return s_logLevel.load( std::memory_order_relaxed ) <= level;
+    }
+
     template <typename... Args>
     static void Error( Args&&... args )
     {
@@ -135,8 +140,18 @@ private:
 # define LOG_ORIGIN __FILE__, ":", __LINE__, ' ', __func__
 #endif
 
+/*
+ * Check the level before anything else, so that the arguments of a disabled
+ * log aren't even evaluated.
+ */
+#define LOG_IF_ENABLED( level, func, ... ) \
+    do { \
+        if ( medialibrary::Log::isEnabled( level ) ) \
+            medialibrary::Log::func( LOG_ORIGIN, ' ', __VA_ARGS__ ); \
+    } while ( 0 )
+
 #define LOG_ERROR( ... ) medialibrary::Log::Error( LOG_ORIGIN, ' ', __VA_ARGS__ )
-#define LOG_WARN( ... ) medialibrary::Log::Warning( LOG_ORIGIN, ' ', __VA_ARGS__ )
-#define LOG_INFO( ... ) medialibrary::Log::Info( LOG_ORIGIN, ' ', __VA_ARGS__ )
-#define LOG_DEBUG( ... ) medialibrary::Log::Debug( LOG_ORIGIN, ' ', __VA_ARGS__ )
-#define LOG_VERBOSE( ... ) medialibrary::Log::Verbose( LOG_ORIGIN, ' ', __VA_ARGS__ )
+#define LOG_WARN( ... ) LOG_IF_ENABLED( medialibrary::LogLevel::Warning, Warning, __VA_ARGS__ )
+#define LOG_INFO( ... ) LOG_IF_ENABLED( medialibrary::LogLevel::Info, Info, __VA_ARGS__ )
+#define LOG_DEBUG( ... ) LOG_IF_ENABLED( medialibrary::LogLevel::Debug, Debug, __VA_ARGS__ )
+#define LOG_VERBOSE( ... ) LOG_IF_ENABLED( medialibrary::LogLevel::Verbose, Verbose, __VA_ARGS__ )
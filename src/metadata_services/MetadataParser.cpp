@@ -1242,8 +1242,8 @@ std::shared_ptr<Album> MetadataAnalyzer::findAlbum( IItem& item,
 
     // Album matching depends on the difference between artist & album artist.
     // Specifically pass the albumArtist here.
-    static const std::string req = "SELECT * FROM " + Album::Table::Name +
-            " WHERE title = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + Album::Table::Name +
+            " WHERE title = ?" };
     auto albums = Album::fetchAll<Album>( m_ml, req, albumName );
 
     if ( albums.empty() == true )
@@ -1412,7 +1412,7 @@ std::pair<std::shared_ptr<Artist>, std::shared_ptr<Artist>> MetadataAnalyzer::fi
 {
     std::shared_ptr<Artist> albumArtist;
     std::shared_ptr<Artist> artist;
-    static const std::string req = "SELECT * FROM " + Artist::Table::Name + " WHERE name = ?";
+    static const sqlite::Request req{ "SELECT * FROM " + Artist::Table::Name + " WHERE name = ?" };
 
     auto albumArtistStr = item.meta( IItem::Metadata::AlbumArtist );
     auto artistStr = item.meta( IItem::Metadata::Artist );
@@ -31,6 +31,7 @@
 #include "File.h"
 #include "medialibrary/filesystem/Errors.h"
 #include "Folder.h"
+#include "utils/SWMRLock.h"
 
 namespace medialibrary
 {
@@ -168,6 +169,7 @@ void Worker::mainloop()
     // that the underlying service has been deleted already.
     std::string serviceName = m_service->name();
     LOG_INFO("Entering ParserService [", serviceName, "] thread");
+    utils::SWMRLock::setThreadClient( LockClient::Parser );
     m_parserCb->onIdleChanged( false );
 
     // Run the service specific initializer
@@ -168,13 +168,13 @@ void Task::markStepCompleted( Step stepCompleted )
 
 bool Task::saveParserStep()
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET step = ?, "
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET step = ?, "
             "attempts_left = "
             "(CASE type "
                 "WHEN " + utils::enum_to_string( Type::Link ) + " "
                 "THEN (SELECT max_link_task_attempts FROM Settings) "
                 "ELSE (SELECT max_task_attempts FROM Settings) END) "
-            "WHERE id_task = ?";
+            "WHERE id_task = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, m_step,
                                        m_id ) == false )
         return false;
@@ -185,8 +185,8 @@ bool Task::saveParserStep()
 
 bool Task::decrementRetryCount()
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET "
-            "attempts_left = attempts_left + 1 WHERE id_task = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
+            "attempts_left = attempts_left + 1 WHERE id_task = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, m_id ) == false )
         return false;
     ++m_attemptsRemaining;
@@ -236,8 +236,8 @@ bool Task::isStepCompleted( Step step ) const
 
 void Task::startParserStep()
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET "
-            "attempts_left = attempts_left - 1 WHERE id_task = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
+            "attempts_left = attempts_left - 1 WHERE id_task = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, m_id ) == false )
         return;
     --m_attemptsRemaining;
@@ -435,8 +435,8 @@ bool Task::restoreLinkedEntities( LastTaskInfo& lastTask )
 
 bool Task::setMrl( MediaLibraryPtr ml, int64_t taskId, const std::string& mrl )
 {
-    static const std::string req = "UPDATE " + Table::Name + " SET "
-            "mrl = ? WHERE id_task = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
+            "mrl = ? WHERE id_task = ?" };
     return sqlite::Tools::executeUpdate( ml->getConn(), req, mrl, taskId );
 }
 
@@ -473,6 +473,9 @@ void Task::createIndex( sqlite::Connection* dbConnection )
     sqlite::Tools::executeRequest( dbConnection,
                                    index( Indexes::FileId,
                                           Settings::DbModelVersion ) );
+    sqlite::Tools::executeRequest( dbConnection,
+                                   index( Indexes::Uncompleted,
+                                          Settings::DbModelVersion ) );
 }
 
 std::string Task::schema( const std::string& tableName, uint32_t dbModel )
@@ -677,6 +680,11 @@ std::string Task::index( Task::Indexes index, uint32_t dbModel )
             assert( dbModel >= 34 );
             return "CREATE INDEX " + indexName( index, dbModel ) +
                     " ON " + Table::Name + "(file_id)";
+        case Indexes::Uncompleted:
+            assert( dbModel >= 41 );
+            return "CREATE INDEX " + indexName( index, dbModel ) +
+                    " ON " + Table::Name + "(parent_folder_id)"
+                    " WHERE " + uncompletedCondition();
     }
     return "<invalid request>";
 }
@@ -693,6 +701,9 @@ std::string Task::indexName( Task::Indexes index, uint32_t dbModel )
         case Indexes::FileId:
             assert( dbModel >= 34 );
             return "task_file_id_idx";
+        case Indexes::Uncompleted:
+            assert( dbModel >= 41 );
+            return "task_uncompleted_idx";
     }
     return "<invalid request>";
 }
@@ -715,18 +726,34 @@ bool Task::checkDbModel( MediaLibraryPtr ml )
                 indexName( Indexes::ParentFolderId, Settings::DbModelVersion ) ) &&
            sqlite::Tools::checkIndexStatement(
                 index( Indexes::FileId, Settings::DbModelVersion ),
-                indexName( Indexes::FileId, Settings::DbModelVersion ) );
+                indexName( Indexes::FileId, Settings::DbModelVersion ) ) &&
+           sqlite::Tools::checkIndexStatement(
+                index( Indexes::Uncompleted, Settings::DbModelVersion ),
+                indexName( Indexes::Uncompleted, Settings::DbModelVersion ) );
+}
+
+std::string Task::uncompletedCondition()
+{
+    /*
+     * The constants are inlined so that the condition matches the partial
+     * index definition; sqlite can't use a partial index for a WHERE clause
+     * using bound parameters.
+     */
+    using StepType = typename std::underlying_type<Step>::type;
+    const auto completed = std::to_string(
+                static_cast<StepType>( Step::Completed ) );
+    return "step & " + completed + " != " + completed + " AND attempts_left > 0";
 }
 
 bool Task::resetRetryCount( MediaLibraryPtr ml )
 {
     auto t = ml->getConn()->newTransaction();
-    static const std::string req = "UPDATE " + Table::Name + " SET "
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
             "attempts_left = (SELECT max_task_attempts FROM SETTINGS) "
-            "WHERE step & ?1 != ?1 AND type = ?";
-    static const std::string linkReq = "UPDATE " + Table::Name + " SET "
+            "WHERE step & ?1 != ?1 AND type = ?" };
+    static const sqlite::Request linkReq{ "UPDATE " + Table::Name + " SET "
             "attempts_left = (SELECT max_link_task_attempts FROM SETTINGS) "
-            "WHERE step & ?1 != ?1 AND type = ?";
+            "WHERE step & ?1 != ?1 AND type = ?" };
     auto res = sqlite::Tools::executeUpdate( ml->getConn(), req, Step::Completed,
                                              Type::Creation ) &&
                sqlite::Tools::executeUpdate( ml->getConn(), linkReq, Step::Completed,
@@ -740,17 +767,17 @@ bool Task::resetRetryCount( MediaLibraryPtr ml )
 bool Task::resetParsing( MediaLibraryPtr ml )
 {
     assert( sqlite::Transaction::isInProgress() == true );
-    static const std::string resetReq = "UPDATE " + Table::Name + " SET "
+    static const sqlite::Request resetReq{ "UPDATE " + Table::Name + " SET "
             "attempts_left = (SELECT max_task_attempts FROM Settings), "
-            "step = ? WHERE type != ?";
-    static const std::string resetLinkReq = "UPDATE " + Table::Name + " SET "
+            "step = ? WHERE type != ?" };
+    static const sqlite::Request resetLinkReq{ "UPDATE " + Table::Name + " SET "
             "attempts_left = (SELECT max_link_task_attempts FROM Settings), "
-            "step = ? WHERE type = ?";
+            "step = ? WHERE type = ?" };
     /* We also want to delete the refresh tasks, since we are going to rescan
      * all existing media anyway
      */
-    static const std::string deleteRefreshReq = "DELETE FROM " + Table::Name +
-            " WHERE type = ?";
+    static const sqlite::Request deleteRefreshReq{ "DELETE FROM " + Table::Name +
+            " WHERE type = ?" };
     return sqlite::Tools::executeDelete( ml->getConn(), deleteRefreshReq, Type::Refresh ) &&
             sqlite::Tools::executeUpdate( ml->getConn(), resetReq,
                                           Step::None, Type::Link ) &&
@@ -760,15 +787,14 @@ bool Task::resetParsing( MediaLibraryPtr ml )
 
 std::vector<std::shared_ptr<Task>> Task::fetchUncompleted( MediaLibraryPtr ml )
 {
-    static const std::string req = "SELECT t.* FROM " + Table::Name + " t"
+    static const sqlite::Request req{ "SELECT t.* FROM " + Table::Name + " t"
         " LEFT JOIN " + Folder::Table::Name + " fol ON t.parent_folder_id = fol.id_folder"
         " LEFT JOIN " + Device::Table::Name + " d ON d.id_device = fol.device_id"
-        " WHERE step & ? != ? AND attempts_left > 0 AND "
+        " WHERE " + uncompletedCondition() + " AND "
             "((d.is_present != 0 OR (t.parent_folder_id IS NULL AND t.type = ?))"
                 " OR t.file_type = ?)"
-        " ORDER BY parent_folder_id";
-    return Task::fetchAll<Task>( ml, req, Step::Completed,
-                                 Step::Completed, Type::Link, IFile::Type::Subscription );
+        " ORDER BY parent_folder_id" };
+    return Task::fetchAll<Task>( ml, req, Type::Link, IFile::Type::Subscription );
 }
 
 std::shared_ptr<Task>
@@ -1053,8 +1079,8 @@ bool Task::setFile( FilePtr file )
         return true ;
     assert( m_fileId == 0 );
     assert( fileId != 0 );
-    static const std::string req = "UPDATE " + Table::Name + " SET "
-            "file_id = ? WHERE id_task = ?";
+    static const sqlite::Request req{ "UPDATE " + Table::Name + " SET "
+            "file_id = ? WHERE id_task = ?" };
     if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req, fileId, m_id ) == false )
         return false;
     m_fileId = fileId;
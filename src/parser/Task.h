@@ -73,6 +73,7 @@ public:
     {
         ParentFolderId,
         FileId,
+        Uncompleted,
     };
 
     enum class Type : uint8_t
@@ -324,6 +325,9 @@ public:
         embeddedThumbnails() const override;
     virtual void addEmbeddedThumbnail( std::shared_ptr<IEmbeddedThumbnail> t ) override;
 
+private:
+    static std::string uncompletedCondition();
+
 private:
     MediaLibraryPtr m_ml = nullptr;
     int64_t     m_id = 0;
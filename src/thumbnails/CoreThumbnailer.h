@@ -36,6 +36,11 @@ class CoreThumbnailer : public IThumbnailer
 public:
     CoreThumbnailer();
 
+    /*
+     * libvlc thumbnail requests only output a single picture, so keep the
+     * default implementation which generates each size independently
+     */
+    using IThumbnailer::generate;
     virtual bool generate( const IMedia& media, const std::string& mrl,
                            uint32_t desiredWidth, uint32_t desiredHeight,
                            float position, const std::string& dest ) override;
@@ -0,0 +1,660 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ThumbnailStore.h"
+#include "MediaLibrary.h"
+#include "Settings.h"
+#include "Thumbnail.h"
+#include "database/SqliteTools.h"
+#include "logging/Logger.h"
+#include "medialibrary/filesystem/Errors.h"
+#include "utils/File.h"
+#include "utils/Filename.h"
+#include "utils/Url.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#else
+# include "utils/Charsets.h"
+#endif
+
+namespace medialibrary
+{
+
+const std::string ThumbnailStore::Table::Name = "ThumbnailPack";
+const std::string ThumbnailStore::SegmentTable::Name = "ThumbnailSegment";
+constexpr uint64_t ThumbnailStore::DefaultSegmentMaxSize;
+
+namespace
+{
+
+using FilePtr = std::unique_ptr<FILE, int(*)(FILE*)>;
+
+FilePtr openFile( const std::string& path, const char* mode )
+{
+    return FilePtr{ fopen( path.c_str(), mode ), &fclose };
+}
+
+}
+
+/*
+ * A read only view on a whole segment, mapped in memory
+ */
+struct ThumbnailStore::Mapping
+{
+    Mapping( const uint8_t* d, uint64_t s )
+        : data( d )
+        , size( s )
+    {
+    }
+    ~Mapping()
+    {
+#ifndef _WIN32
+        munmap( const_cast<uint8_t*>( data ), size );
+#else
+        UnmapViewOfFile( data );
+#endif
+    }
+    Mapping( const Mapping& ) = delete;
+    Mapping& operator=( const Mapping& ) = delete;
+
+    const uint8_t* data;
+    uint64_t size;
+};
+
+ThumbnailStore::ThumbnailStore( MediaLibraryPtr ml, uint64_t segmentMaxSize )
+    : m_ml( ml )
+    , m_segmentMaxSize( segmentMaxSize )
+    , m_activeSegment( 1 )
+    , m_activeSize( 0 )
+{
+}
+
+ThumbnailStore::~ThumbnailStore() = default;
+
+void ThumbnailStore::createTable( sqlite::Connection* dbConn )
+{
+    const std::string reqs[] = {
+        schema( SegmentTable::Name, Settings::DbModelVersion ),
+        schema( Table::Name, Settings::DbModelVersion ),
+    };
+    for ( const auto& req : reqs )
+        sqlite::Tools::executeRequest( dbConn, req );
+}
+
+void ThumbnailStore::createIndexes( sqlite::Connection* dbConn )
+{
+    sqlite::Tools::executeRequest( dbConn, index( Indexes::SegmentId,
+                                                  Settings::DbModelVersion ) );
+}
+
+std::string ThumbnailStore::schema( const std::string& tableName, uint32_t dbModel )
+{
+    UNUSED_IN_RELEASE( dbModel );
+
+    assert( dbModel >= 44 );
+    if ( tableName == SegmentTable::Name )
+    {
+        return "CREATE TABLE " + SegmentTable::Name +
+        "("
+            "id_segment INTEGER PRIMARY KEY,"
+            "size UNSIGNED INTEGER NOT NULL"
+        ")";
+    }
+    assert( tableName == Table::Name );
+    return "CREATE TABLE " + Table::Name +
+    "("
+        "mrl TEXT PRIMARY KEY NOT NULL,"
+        "segment_id INTEGER NOT NULL,"
+        "offset UNSIGNED INTEGER NOT NULL,"
+        "size UNSIGNED INTEGER NOT NULL,"
+        "FOREIGN KEY(segment_id) REFERENCES " + SegmentTable::Name +
+            "(id_segment) ON DELETE CASCADE"
+    ")";
+}
+
+std::string ThumbnailStore::index( Indexes index, uint32_t dbModel )
+{
+    switch ( index )
+    {
+        case Indexes::SegmentId:
+            return "CREATE INDEX " + indexName( index, dbModel ) + " ON " +
+                    Table::Name + "(segment_id)";
+    }
+    return "<invalid request>";
+}
+
+std::string ThumbnailStore::indexName( Indexes index, uint32_t dbModel )
+{
+    UNUSED_IN_RELEASE( dbModel );
+
+    switch ( index )
+    {
+        case Indexes::SegmentId:
+            assert( dbModel >= 44 );
+            return "thumbnail_pack_segment_idx";
+    }
+    return "<invalid request>";
+}
+
+bool ThumbnailStore::checkDbModel( MediaLibraryPtr ml )
+{
+    OPEN_READ_CONTEXT( ctx, ml->getConn() );
+
+    return sqlite::Tools::checkTableSchema(
+                                       schema( Table::Name, Settings::DbModelVersion ),
+                                       Table::Name ) &&
+           sqlite::Tools::checkTableSchema(
+                                       schema( SegmentTable::Name, Settings::DbModelVersion ),
+                                       SegmentTable::Name ) &&
+           sqlite::Tools::checkIndexStatement(
+                                       index( Indexes::SegmentId, Settings::DbModelVersion ),
+                                       indexName( Indexes::SegmentId, Settings::DbModelVersion ) );
+}
+
+void ThumbnailStore::initialize()
+{
+    int64_t segmentId;
+    {
+        OPEN_READ_CONTEXT( ctx, m_ml->getConn() );
+        sqlite::Statement stmt{ "SELECT COALESCE(MAX(id_segment), 1) FROM " +
+                                SegmentTable::Name };
+        stmt.execute();
+        auto row = stmt.row();
+        row >> segmentId;
+    }
+    uint64_t size;
+    try
+    {
+        size = utils::fs::fileSize( segmentPath( m_ml, segmentId ) );
+    }
+    catch ( const fs::errors::Exception& )
+    {
+        size = 0;
+    }
+    std::lock_guard<compat::Mutex> lock( m_mutex );
+    m_activeSegment = segmentId;
+    m_activeSize = size;
+}
+
+bool ThumbnailStore::pack( const std::string& mrl )
+{
+    auto relMrl = relativeMrl( mrl );
+    if ( relMrl.empty() == true )
+    {
+        LOG_WARN( "Can't pack thumbnail ", mrl, " from outside the thumbnail folder" );
+        return false;
+    }
+    auto path = utils::url::toLocalPath( mrl );
+    std::vector<uint8_t> buffer;
+    {
+        auto f = openFile( path, "rb" );
+        if ( f == nullptr )
+        {
+            LOG_ERROR( "Failed to open thumbnail ", path, " for packing" );
+            return false;
+        }
+        uint8_t buff[4096];
+        size_t nbRead;
+        while ( ( nbRead = fread( buff, 1, sizeof( buff ), f.get() ) ) > 0 )
+            buffer.insert( end( buffer ), buff, buff + nbRead );
+        if ( ferror( f.get() ) != 0 || buffer.empty() == true )
+        {
+            LOG_ERROR( "Failed to read thumbnail ", path, " for packing" );
+            return false;
+        }
+    }
+    if ( store( relMrl, buffer.data(), buffer.size() ) == false )
+        return false;
+    utils::fs::remove( path );
+    return true;
+}
+
+bool ThumbnailStore::pack( const std::string& mrl, const uint8_t* data,
+                           uint64_t size )
+{
+    auto relMrl = relativeMrl( mrl );
+    if ( relMrl.empty() == true )
+    {
+        LOG_WARN( "Can't pack thumbnail ", mrl, " from outside the thumbnail folder" );
+        return false;
+    }
+    if ( size == 0 )
+        return false;
+    return store( relMrl, data, size );
+}
+
+ThumbnailData ThumbnailStore::read( const std::string& mrl )
+{
+    Location loc;
+    if ( fetchLocation( relativeMrl( mrl ), loc ) == false )
+        return {};
+    auto m = mapping( loc.segmentId, loc.offset + loc.size );
+    if ( m == nullptr )
+        return {};
+    ThumbnailData res;
+    res.data = m->data + loc.offset;
+    res.size = loc.size;
+    res.handle = std::move( m );
+    return res;
+}
+
+bool ThumbnailStore::remove( const std::string& relativeMrl )
+{
+    static const sqlite::Request req{ "DELETE FROM " + Table::Name +
+            " WHERE mrl = ?" };
+    return sqlite::Tools::executeDelete( m_ml->getConn(), req, relativeMrl );
+}
+
+void ThumbnailStore::compact()
+{
+    struct Segment
+    {
+        int64_t id;
+        uint64_t size;
+        uint64_t liveSize;
+    };
+    struct Entry
+    {
+        std::string mrl;
+        uint64_t offset;
+        uint64_t size;
+    };
+    std::vector<Segment> segments;
+    {
+        OPEN_READ_CONTEXT( ctx, m_ml->getConn() );
+        sqlite::Statement stmt{ "SELECT s.id_segment, s.size,"
+                " COALESCE(SUM(p.size), 0) FROM " + SegmentTable::Name + " s"
+                " LEFT JOIN " + Table::Name + " p ON p.segment_id = s.id_segment"
+                " GROUP BY s.id_segment" };
+        stmt.execute();
+        sqlite::Row row;
+        while ( ( row = stmt.row() ) != nullptr )
+        {
+            Segment s;
+            row >> s.id >> s.size >> s.liveSize;
+            segments.push_back( s );
+        }
+    }
+    int64_t activeSegment;
+    {
+        std::lock_guard<compat::Mutex> lock( m_mutex );
+        activeSegment = m_activeSegment;
+    }
+    for ( const auto& s : segments )
+    {
+        /* Only rewrite the segments which are mostly made of dead thumbnails */
+        if ( s.id == activeSegment ||
+             ( s.liveSize > 0 && s.liveSize * 2 >= s.size ) )
+            continue;
+        LOG_DEBUG( "Compacting thumbnail segment #", s.id, " (", s.liveSize,
+                   "/", s.size, " bytes in use)" );
+        std::vector<Entry> entries;
+        uint64_t minSize = 0;
+        {
+            OPEN_READ_CONTEXT( ctx, m_ml->getConn() );
+            sqlite::Statement stmt{ "SELECT mrl, offset, size FROM " +
+                                    Table::Name + " WHERE segment_id = ?" };
+            stmt.execute( s.id );
+            sqlite::Row row;
+            while ( ( row = stmt.row() ) != nullptr )
+            {
+                Entry e;
+                row >> e.mrl >> e.offset >> e.size;
+                minSize = std::max( minSize, e.offset + e.size );
+                entries.push_back( std::move( e ) );
+            }
+        }
+        if ( entries.empty() == false )
+        {
+            auto m = mapping( s.id, minSize );
+            if ( m == nullptr )
+                continue;
+            static const sqlite::Request req{ "UPDATE " + Table::Name +
+                    " SET segment_id = ?, offset = ?, size = ?"
+                    " WHERE mrl = ? AND segment_id = ? AND offset = ?" };
+            for ( const auto& e : entries )
+            {
+                Location loc;
+                {
+                    std::lock_guard<compat::Mutex> lock( m_mutex );
+                    if ( append( m->data + e.offset, e.size, loc ) == false )
+                        return;
+                }
+                /*
+                 * The thumbnail might have been replaced or removed in the
+                 * meantime, in which case this is a no-op and the copy we
+                 * just made is dead already.
+                 */
+                auto t = m_ml->getConn()->newTransaction();
+                updateSegmentSize( loc );
+                if ( sqlite::Tools::executeUpdate( m_ml->getConn(), req,
+                                        loc.segmentId, loc.offset, loc.size,
+                                        e.mrl, s.id, e.offset ) == false )
+                    continue;
+                t->commit();
+            }
+        }
+        {
+            auto t = m_ml->getConn()->newTransaction();
+            uint64_t nbLeft;
+            {
+                OPEN_READ_CONTEXT( ctx, m_ml->getConn() );
+                sqlite::Statement stmt{ "SELECT COUNT(*) FROM " + Table::Name +
+                                        " WHERE segment_id = ?" };
+                stmt.execute( s.id );
+                auto row = stmt.row();
+                row >> nbLeft;
+            }
+            if ( nbLeft > 0 )
+                continue;
+            static const sqlite::Request req{ "DELETE FROM " + SegmentTable::Name +
+                    " WHERE id_segment = ?" };
+            if ( sqlite::Tools::executeDelete( m_ml->getConn(), req, s.id ) == false )
+                continue;
+            t->commit();
+        }
+        {
+            std::lock_guard<compat::Mutex> lock( m_mutex );
+            m_mappings.erase( s.id );
+        }
+        utils::fs::remove( segmentPath( m_ml, s.id ) );
+    }
+}
+
+bool ThumbnailStore::reset()
+{
+    /* The packed thumbnails get removed by the foreign key */
+    static const sqlite::Request req{ "DELETE FROM " + SegmentTable::Name };
+    if ( sqlite::Tools::executeDelete( m_ml->getConn(), req ) == false )
+        return false;
+    std::lock_guard<compat::Mutex> lock( m_mutex );
+    m_mappings.clear();
+    m_activeSegment = 1;
+    m_activeSize = 0;
+    return true;
+}
+
+bool ThumbnailStore::unpack()
+{
+    struct Entry
+    {
+        std::string mrl;
+        Location loc;
+    };
+    std::vector<Entry> entries;
+    std::vector<int64_t> segments;
+    {
+        OPEN_READ_CONTEXT( ctx, m_ml->getConn() );
+        sqlite::Statement stmt{ "SELECT mrl, segment_id, offset, size FROM " +
+                                Table::Name + " ORDER BY segment_id" };
+        stmt.execute();
+        sqlite::Row row;
+        while ( ( row = stmt.row() ) != nullptr )
+        {
+            Entry e;
+            row >> e.mrl >> e.loc.segmentId >> e.loc.offset >> e.loc.size;
+            entries.push_back( std::move( e ) );
+        }
+        sqlite::Statement segStmt{ "SELECT id_segment FROM " + SegmentTable::Name };
+        segStmt.execute();
+        while ( ( row = segStmt.row() ) != nullptr )
+            segments.push_back( row.extract<int64_t>() );
+    }
+    if ( segments.empty() == true )
+        return true;
+    LOG_INFO( "Thumbnail packing is disabled, unpacking ", entries.size(),
+              " thumbnails" );
+    for ( const auto& e : entries )
+    {
+        auto path = m_ml->thumbnailPath() + e.mrl;
+        auto m = mapping( e.loc.segmentId, e.loc.offset + e.loc.size );
+        if ( m != nullptr )
+        {
+            auto f = openFile( path, "wb" );
+            if ( f != nullptr &&
+                 fwrite( m->data + e.loc.offset, 1, e.loc.size, f.get() ) == e.loc.size &&
+                 fclose( f.release() ) == 0 )
+                continue;
+            utils::fs::remove( path );
+        }
+        /*
+         * Forget about the thumbnail so it gets reported as missing instead
+         * of pointing to a file which doesn't exist, and can be generated
+         * again.
+         */
+        LOG_WARN( "Failed to unpack thumbnail ", e.mrl, ", removing it" );
+        static const sqlite::Request req{ "DELETE FROM " + Thumbnail::Table::Name +
+                " WHERE mrl = ? AND is_owned != 0" };
+        if ( sqlite::Tools::executeDelete( m_ml->getConn(), req, e.mrl ) == false )
+            return false;
+    }
+    if ( reset() == false )
+        return false;
+    for ( auto segmentId : segments )
+        utils::fs::remove( segmentPath( m_ml, segmentId ) );
+    return true;
+}
+
+std::string ThumbnailStore::segmentPath( MediaLibraryPtr ml, int64_t segmentId )
+{
+    return ml->thumbnailPath() + "thumbnails_" + std::to_string( segmentId ) +
+            ".pack";
+}
+
+std::string ThumbnailStore::relativeMrl( const std::string& mrl ) const
+{
+    auto thumbnailDirMrl = utils::file::toMrl( m_ml->thumbnailPath() );
+    if ( mrl.size() <= thumbnailDirMrl.size() ||
+         mrl.compare( 0, thumbnailDirMrl.size(), thumbnailDirMrl ) != 0 )
+        return {};
+    return mrl.substr( thumbnailDirMrl.size() );
+}
+
+bool ThumbnailStore::fetchLocation( const std::string& relativeMrl,
+                                    Location& loc ) const
+{
+    if ( relativeMrl.empty() == true )
+        return false;
+    static const sqlite::Request req{ "SELECT segment_id, offset, size FROM " +
+            Table::Name + " WHERE mrl = ?" };
+    OPEN_READ_CONTEXT( ctx, m_ml->getConn() );
+    sqlite::Statement stmt{ req };
+    stmt.execute( relativeMrl );
+    auto row = stmt.row();
+    if ( row == nullptr )
+        return false;
+    row >> loc.segmentId >> loc.offset >> loc.size;
+    return true;
+}
+
+bool ThumbnailStore::append( const uint8_t* data, uint64_t size, Location& loc )
+{
+    if ( m_activeSize > 0 && m_activeSize + size > m_segmentMaxSize )
+    {
+        ++m_activeSegment;
+        m_activeSize = 0;
+    }
+    auto path = segmentPath( m_ml, m_activeSegment );
+    auto f = openFile( path, "ab" );
+    if ( f == nullptr )
+    {
+        LOG_ERROR( "Failed to open thumbnail segment ", path );
+        return false;
+    }
+    /*
+     * Don't trust the size we know about, the segment might contain some
+     * data which was appended before a crash and never committed.
+     */
+    long offset;
+    if ( fseek( f.get(), 0, SEEK_END ) != 0 ||
+         ( offset = ftell( f.get() ) ) < 0 )
+    {
+        LOG_ERROR( "Failed to probe thumbnail segment ", path, " size" );
+        return false;
+    }
+    if ( fwrite( data, 1, size, f.get() ) != size ||
+         fclose( f.release() ) != 0 )
+    {
+        LOG_ERROR( "Failed to append to thumbnail segment ", path );
+        return false;
+    }
+    loc.segmentId = m_activeSegment;
+    loc.offset = static_cast<uint64_t>( offset );
+    loc.size = size;
+    m_activeSize = loc.offset + size;
+    return true;
+}
+
+void ThumbnailStore::updateSegmentSize( const Location& loc )
+{
+    static const sqlite::Request req{ "INSERT INTO " + SegmentTable::Name +
+            "(id_segment, size) VALUES(?, ?)"
+            " ON CONFLICT(id_segment) DO UPDATE SET size = MAX(size, excluded.size)" };
+    sqlite::Tools::executeRequest( m_ml->getConn(), req, loc.segmentId,
+                                   loc.offset + loc.size );
+}
+
+bool ThumbnailStore::commit( const std::string& relativeMrl, const Location& loc )
+{
+    static const sqlite::Request req{ "INSERT OR REPLACE INTO " + Table::Name +
+            "(mrl, segment_id, offset, size) VALUES(?, ?, ?, ?)" };
+    auto t = m_ml->getConn()->newTransaction();
+    updateSegmentSize( loc );
+    if ( sqlite::Tools::executeInsert( m_ml->getConn(), req, relativeMrl,
+                                       loc.segmentId, loc.offset, loc.size ) == 0 )
+        return false;
+    t->commit();
+    return true;
+}
+
+bool ThumbnailStore::store( const std::string& relativeMrl, const uint8_t* data,
+                            uint64_t size )
+{
+    Location loc;
+    {
+        std::lock_guard<compat::Mutex> lock( m_mutex );
+        if ( append( data, size, loc ) == false )
+            return false;
+    }
+    /*
+     * Don't hold the store lock while writing to the database, as other
+     * threads might try to read a thumbnail while holding a database context
+     */
+    if ( commit( relativeMrl, loc ) == false )
+        return false;
+    LOG_DEBUG( "Packed thumbnail ", relativeMrl, " in segment #", loc.segmentId,
+               " at offset ", loc.offset );
+    return true;
+}
+
+std::shared_ptr<ThumbnailStore::Mapping>
+ThumbnailStore::mapping( int64_t segmentId, uint64_t minSize )
+{
+    std::lock_guard<compat::Mutex> lock( m_mutex );
+    auto it = m_mappings.find( segmentId );
+    if ( it != end( m_mappings ) && it->second->size >= minSize )
+        return it->second;
+    auto path = segmentPath( m_ml, segmentId );
+    std::shared_ptr<Mapping> m;
+#ifndef _WIN32
+    auto fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if ( fd < 0 )
+    {
+        LOG_ERROR( "Failed to open thumbnail segment ", path );
+        return nullptr;
+    }
+    struct stat s;
+    void* data = MAP_FAILED;
+    if ( fstat( fd, &s ) == 0 && static_cast<uint64_t>( s.st_size ) >= minSize )
+        data = mmap( nullptr, s.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    /* The mapping keeps a reference on the file */
+    close( fd );
+    if ( data == MAP_FAILED )
+    {
+        LOG_ERROR( "Failed to map thumbnail segment ", path );
+        return nullptr;
+    }
+    m = std::make_shared<Mapping>( static_cast<const uint8_t*>( data ),
+                                   s.st_size );
+#else
+    /*
+     * Share everything, the active segment keeps being appended to, and
+     * compacted segments get removed while a view might still be in use
+     */
+    const DWORD shareMode = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+    auto wpath = charset::ToWide( path.c_str() );
+    HANDLE file = INVALID_HANDLE_VALUE;
+    if ( wpath != nullptr )
+    {
+# if _WIN32_WINNT >= 0x0602 /* _WIN32_WINNT_WIN8 */
+        file = CreateFile2( wpath.get(), GENERIC_READ, shareMode,
+                            OPEN_EXISTING, nullptr );
+# else
+        file = CreateFileW( wpath.get(), GENERIC_READ, shareMode, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+# endif
+    }
+    if ( file == INVALID_HANDLE_VALUE )
+    {
+        LOG_ERROR( "Failed to open thumbnail segment ", path );
+        return nullptr;
+    }
+    LARGE_INTEGER size;
+    void* data = nullptr;
+    if ( GetFileSizeEx( file, &size ) != 0 && size.QuadPart > 0 &&
+         static_cast<uint64_t>( size.QuadPart ) >= minSize )
+    {
+        auto fileMapping = CreateFileMappingW( file, nullptr, PAGE_READONLY,
+                                               0, 0, nullptr );
+        if ( fileMapping != nullptr )
+        {
+            data = MapViewOfFile( fileMapping, FILE_MAP_READ, 0, 0, 0 );
+            /* The view keeps a reference on the mapping object */
+            CloseHandle( fileMapping );
+        }
+    }
+    CloseHandle( file );
+    if ( data == nullptr )
+    {
+        LOG_ERROR( "Failed to map thumbnail segment ", path );
+        return nullptr;
+    }
+    m = std::make_shared<Mapping>( static_cast<const uint8_t*>( data ),
+                                   static_cast<uint64_t>( size.QuadPart ) );
+#endif
+    m_mappings[segmentId] = m;
+    return m;
+}
+
+}
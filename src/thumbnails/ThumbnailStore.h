@@ -0,0 +1,177 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Types.h"
+#include "compat/Mutex.h"
+#include "medialibrary/IMedia.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace medialibrary
+{
+
+namespace sqlite
+{
+class Connection;
+}
+
+/**
+ * @brief The ThumbnailStore class packs the generated thumbnails in segments
+ *
+ * Instead of keeping one file per thumbnail, the thumbnails owned by the media
+ * library are appended to large segment files stored in the thumbnail folder,
+ * and their location is recorded in database. Packed thumbnails are read
+ * through a memory mapped view of their segment.
+ * Since segments are append-only, replacing or removing a thumbnail leaves
+ * some dead bytes behind, which are reclaimed by compact()
+ *
+ * Thumbnails are identified by their mrl, relative to the thumbnail folder,
+ * which is the mrl stored in the Thumbnail table for owned thumbnails.
+ */
+class ThumbnailStore
+{
+public:
+    struct Table
+    {
+        static const std::string Name;
+    };
+    struct SegmentTable
+    {
+        static const std::string Name;
+    };
+    enum class Indexes : uint8_t
+    {
+        SegmentId,
+    };
+
+    /* The default size after which a new segment gets created */
+    static constexpr uint64_t DefaultSegmentMaxSize = 32 * 1024 * 1024;
+
+    explicit ThumbnailStore( MediaLibraryPtr ml,
+                             uint64_t segmentMaxSize = DefaultSegmentMaxSize );
+    ~ThumbnailStore();
+
+    static void createTable( sqlite::Connection* dbConn );
+    static void createIndexes( sqlite::Connection* dbConn );
+    static std::string schema( const std::string& tableName, uint32_t dbModel );
+    static std::string index( Indexes index, uint32_t dbModel );
+    static std::string indexName( Indexes index, uint32_t dbModel );
+    static bool checkDbModel( MediaLibraryPtr ml );
+
+    /**
+     * @brief initialize Loads the segment being written to
+     *
+     * This must be called once the database is ready to be used
+     */
+    void initialize();
+
+    /**
+     * @brief pack Moves a thumbnail file into the active segment
+     * @param mrl The thumbnail absolute mrl, which must be in the thumbnail folder
+     * @return true if the thumbnail was packed
+     *
+     * If the thumbnail was already packed, its previous content becomes dead
+     * and will be reclaimed by the next compaction.
+     * The source file is removed once the thumbnail location is committed.
+     */
+    bool pack( const std::string& mrl );
+    /**
+     * @brief pack Stores an encoded thumbnail in the active segment
+     * @param mrl The thumbnail absolute mrl, which must be in the thumbnail folder
+     * @param data The encoded thumbnail
+     * @param size The encoded thumbnail size
+     * @return true if the thumbnail was packed
+     *
+     * This avoids writing the thumbnail to a file only to read it back.
+     */
+    bool pack( const std::string& mrl, const uint8_t* data, uint64_t size );
+    /**
+     * @brief read Returns a view on a packed thumbnail content
+     * @param mrl The thumbnail absolute mrl
+     *
+     * The returned data is empty if the thumbnail isn't packed
+     */
+    ThumbnailData read( const std::string& mrl );
+    /**
+     * @brief remove Forgets about a packed thumbnail
+     * @param relativeMrl The thumbnail mrl, relative to the thumbnail folder
+     */
+    bool remove( const std::string& relativeMrl );
+    /**
+     * @brief compact Rewrites the segments containing mostly dead thumbnails
+     *
+     * The segment being written to is left untouched
+     */
+    void compact();
+    /**
+     * @brief reset Forgets about all the packed thumbnails
+     *
+     * This is meant to be invoked before all the thumbnail files, including
+     * the segments, get removed.
+     */
+    bool reset();
+    /**
+     * @brief unpack Moves all the packed thumbnails back to their own file
+     *
+     * This is meant to be invoked when the store gets disabled after some
+     * thumbnails were packed. The thumbnails which can't be restored are
+     * removed, so they can be generated again.
+     */
+    bool unpack();
+
+    static std::string segmentPath( MediaLibraryPtr ml, int64_t segmentId );
+
+private:
+    struct Location
+    {
+        int64_t segmentId;
+        uint64_t offset;
+        uint64_t size;
+    };
+    struct Mapping;
+
+    std::string relativeMrl( const std::string& mrl ) const;
+    bool fetchLocation( const std::string& relativeMrl, Location& loc ) const;
+    /*
+     * Appends some data to the active segment and returns its location.
+     * This must be called with m_mutex held.
+     */
+    bool append( const uint8_t* data, uint64_t size, Location& loc );
+    void updateSegmentSize( const Location& loc );
+    bool commit( const std::string& relativeMrl, const Location& loc );
+    bool store( const std::string& relativeMrl, const uint8_t* data, uint64_t size );
+    std::shared_ptr<Mapping> mapping( int64_t segmentId, uint64_t minSize );
+
+private:
+    MediaLibraryPtr m_ml;
+    const uint64_t m_segmentMaxSize;
+    compat::Mutex m_mutex;
+    int64_t m_activeSegment;
+    uint64_t m_activeSize;
+    std::unordered_map<int64_t, std::shared_ptr<Mapping>> m_mappings;
+};
+
+}
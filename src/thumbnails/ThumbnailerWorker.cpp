@@ -25,6 +25,7 @@
 #endif
 
 #include "ThumbnailerWorker.h"
+#include "ThumbnailStore.h"
 
 #include "Media.h"
 #include "File.h"
@@ -33,6 +34,11 @@
 #include "medialibrary/filesystem/Errors.h"
 #include "utils/Filename.h"
 #include "utils/File.h"
+#include "utils/SWMRLock.h"
+#include "utils/Url.h"
+#include "medialibrary/filesystem/IDirectory.h"
+#include "medialibrary/filesystem/IFile.h"
+#include "medialibrary/filesystem/IFileSystemFactory.h"
 #include "medialibrary/IThumbnailer.h"
 
 #include <algorithm>
@@ -62,18 +68,30 @@ void ThumbnailerWorker::requestThumbnailInternal( int64_t mediaId, MediaPtr medi
 {
     std::unique_lock<compat::Mutex> lock( m_mutex );
 
-    if ( m_queuedMedia.find( mediaId ) != cend( m_queuedMedia ) )
+    Output output{ sizeType, desiredWidth, desiredHeight };
+    auto it = m_queuedMedia.find( mediaId );
+    if ( it != end( m_queuedMedia ) )
+    {
+        /*
+         * Merge the requests for other sizes with the queued one, so they get
+         * generated from the same frame
+         */
+        auto& outputs = it->second;
+        if ( std::find_if( cbegin( outputs ), cend( outputs ),
+                           [sizeType]( const Output& o ) {
+                               return o.sizeType == sizeType;
+                           }) == cend( outputs ) )
+            outputs.push_back( output );
         return;
+    }
 
     Task t{
         mediaId,
         std::move( media ),
-        sizeType,
-        desiredWidth,
-        desiredHeight,
-        position
+        position,
+        {}
     };
-    m_queuedMedia.insert( mediaId );
+    m_queuedMedia.emplace( mediaId, std::vector<Output>{ output } );
     m_tasks.push( std::move( t ) );
     assert( m_tasks.size() == m_queuedMedia.size() );
     if ( m_thread.get_id() == compat::Thread::id{} )
@@ -87,9 +105,12 @@ void ThumbnailerWorker::requestThumbnailInternal( int64_t mediaId, MediaPtr medi
 
 void ThumbnailerWorker::runCleanupRequests()
 {
+    auto store = m_ml->thumbnailStore();
     auto requests = Thumbnail::fetchCleanups( m_ml );
     for ( const auto& r : requests )
     {
+        if ( store != nullptr && store->remove( r.second ) == false )
+            continue;
         auto path = m_ml->thumbnailPath() + r.second;
         LOG_DEBUG( "Running cleanup request #", r.first, ": removing ", path );
         if ( !utils::fs::remove( path ) )
@@ -114,6 +135,9 @@ void ThumbnailerWorker::runCleanupRequests()
         if ( Thumbnail::removeCleanupRequest( m_ml, r.first ) == false )
             LOG_WARN( "Failed to remove thumbnail cleanup request #", r.first );
     }
+    /* Reclaim the space used by the thumbnails we just removed */
+    if ( store != nullptr )
+        store->compact();
 }
 
 void ThumbnailerWorker::requestThumbnail( int64_t mediaId, ThumbnailSizeType sizeType,
@@ -123,6 +147,34 @@ void ThumbnailerWorker::requestThumbnail( int64_t mediaId, ThumbnailSizeType siz
     requestThumbnailInternal( mediaId, nullptr, sizeType, desiredWidth, desiredHeight, position );
 }
 
+void ThumbnailerWorker::removeTemporaryFiles()
+{
+    /*
+     * Thumbnails are written through a temporary file, which is left behind
+     * if we crashed while writing it
+     */
+    auto thumbnailMrl = utils::file::toMrl( m_ml->thumbnailPath() );
+    try
+    {
+        auto fsFactory = m_ml->fsFactoryForMrl( thumbnailMrl );
+        if ( fsFactory == nullptr )
+            return;
+        auto files = fsFactory->createDirectory( thumbnailMrl )->files();
+        for ( const auto& f : files )
+        {
+            if ( f->extension() != "tmp" )
+                continue;
+            auto path = utils::url::toLocalPath( f->mrl() );
+            LOG_DEBUG( "Removing leftover temporary thumbnail ", path );
+            utils::fs::remove( path );
+        }
+    }
+    catch ( const fs::errors::Exception& ex )
+    {
+        LOG_WARN( "Failed to list the thumbnail folder: ", ex.what() );
+    }
+}
+
 void ThumbnailerWorker::requestCleanupRun()
 {
     requestThumbnailInternal( 0, nullptr, ThumbnailSizeType::Thumbnail,
@@ -156,6 +208,8 @@ void ThumbnailerWorker::resume()
 void ThumbnailerWorker::run()
 {
     LOG_INFO( "Starting thumbnailer thread" );
+    utils::SWMRLock::setThreadClient( LockClient::Thumbnailer );
+    removeTemporaryFiles();
     while ( m_run == true )
     {
         ML_UNHANDLED_EXCEPTION_INIT
@@ -171,7 +225,10 @@ void ThumbnailerWorker::run()
                     break;
                 t = std::move( m_tasks.front() );
                 m_tasks.pop();
-                m_queuedMedia.erase( t.mediaId );
+                auto it = m_queuedMedia.find( t.mediaId );
+                assert( it != end( m_queuedMedia ) );
+                t.outputs = std::move( it->second );
+                m_queuedMedia.erase( it );
                 assert( m_tasks.size() == m_queuedMedia.size() );
             }
             if ( t.mediaId == 0 )
@@ -183,8 +240,12 @@ void ThumbnailerWorker::run()
                     /* No media found with this id */
                     continue;
             }
-            bool res = generateThumbnail( t );
-            m_ml->getCb()->onMediaThumbnailReady( t.media, t.sizeType, res );
+            auto res = generateThumbnails( t );
+            assert( res.size() == t.outputs.size() );
+            for ( auto i = 0u; i < t.outputs.size(); ++i )
+                m_ml->getCb()->onMediaThumbnailReady( t.media,
+                                                      t.outputs[i].sizeType,
+                                                      res[i] );
         }
         ML_UNHANDLED_EXCEPTION_BODY( "ThumbnailerWorker" )
     }
@@ -208,16 +269,17 @@ void ThumbnailerWorker::stop()
     }
 }
 
-bool ThumbnailerWorker::generateThumbnail( Task task )
+std::vector<bool> ThumbnailerWorker::generateThumbnails( const Task& task )
 {
     assert( task.media->type() != Media::Type::Audio );
 
+    std::vector<bool> results( task.outputs.size(), false );
     const auto files = task.media->files();
     if ( files.empty() == true )
     {
         LOG_WARN( "Can't generate thumbnail for a media without associated files (",
                   task.media->title() );
-        return false;
+        return results;
     }
     auto mainFileIt = std::find_if( files.cbegin(), files.cend(),
                                     [](const FilePtr& f) {
@@ -226,7 +288,7 @@ bool ThumbnailerWorker::generateThumbnail( Task task )
     if ( mainFileIt == files.cend() )
     {
         assert( !"A media must have a file of type Main" );
-        return false;
+        return results;
     }
     auto file = std::static_pointer_cast<File>( *mainFileIt );
     std::string mrl;
@@ -238,70 +300,154 @@ bool ThumbnailerWorker::generateThumbnail( Task task )
     {
         LOG_WARN( "Aborting file ", file->rawMrl(), " generation due to its "
                   "containing device being missing" );
-        return false;
+        return results;
     }
 
     auto m = static_cast<Media*>( task.media.get() );
-    bool isFirstThumbnailGeneration = false;
-    if ( m->thumbnailStatus( task.sizeType ) == ThumbnailStatus::Missing )
+    struct Pending
     {
-        /*
-         * Insert a failure record before computing the thumbnail.
-         * If the thumbnailer crashes, we don't want to re-run it. If it succeeds,
-         * the thumbnail will be updated right after
-         * This is done here instead of from the mainloop as we don't want to prevent
-         * the thumbnail generation of a file that has been removed.
-         *
-         * This assumes that the thumbnail won't crash if it succeeded once.
-         */
-        m->setThumbnail( std::make_shared<Thumbnail>( m_ml, ThumbnailStatus::Crash,
-                                                      Thumbnail::Origin::Media,
-                                                      task.sizeType ) );
-        isFirstThumbnailGeneration = true;
-    }
-    auto thumbnail = m->thumbnail( task.sizeType );
-    if ( thumbnail == nullptr )
-    {
-        // Handle sporadic read errors gracefully
-        assert( !"The thumbnail can't be nullptr as it just was inserted" );
-        return false;
-    }
-    auto dest = Thumbnail::path( m_ml, thumbnail->id() );
-    LOG_DEBUG( "Generating ", mrl, " thumbnail in ", dest );
-
-    if ( m_generator->generate( *m, mrl, task.desiredWidth, task.desiredHeight,
-                                task.position, dest ) == false )
+        size_t idx;
+        std::shared_ptr<Thumbnail> thumbnail;
+        bool isFirstThumbnailGeneration;
+    };
+    std::vector<Pending> pending;
+    std::vector<IThumbnailer::Output> outputs;
+    for ( auto i = 0u; i < task.outputs.size(); ++i )
     {
-        if ( m_run == false )
+        const auto& o = task.outputs[i];
+        bool isFirstThumbnailGeneration = false;
+        if ( m->thumbnailStatus( o.sizeType ) == ThumbnailStatus::Missing )
         {
             /*
-             * The generation failed because the thumbnailer was interrupted.
+             * Insert a failure record before computing the thumbnail.
+             * If the thumbnailer crashes, we don't want to re-run it. If it succeeds,
+             * the thumbnail will be updated right after
+             * This is done here instead of from the mainloop as we don't want to prevent
+             * the thumbnail generation of a file that has been removed.
              *
-             * If we were trying to generate the first thumbnail for this media
-             * we need to remove the record, as there were no crashes, and we
-             * don't want to report that information to the user.
-             * Otherwise, just keep the previous thumbnail.
+             * This assumes that the thumbnail won't crash if it succeeded once.
              */
-            if ( isFirstThumbnailGeneration == true )
-                m->removeThumbnail( task.sizeType );
+            m->setThumbnail( std::make_shared<Thumbnail>( m_ml, ThumbnailStatus::Crash,
+                                                          Thumbnail::Origin::Media,
+                                                          o.sizeType ) );
+            isFirstThumbnailGeneration = true;
         }
-        else
+        auto thumbnail = m->thumbnail( o.sizeType );
+        if ( thumbnail == nullptr )
         {
-            // Otherwise, ensure the status is "Failure" (since getting here means
-            // there was no crash) and bump the number of attempt
-            thumbnail->markFailed();
+            // Handle sporadic read errors gracefully
+            assert( !"The thumbnail can't be nullptr as it just was inserted" );
+            continue;
         }
-        return false;
+        auto dest = Thumbnail::path( m_ml, thumbnail->id() );
+        LOG_DEBUG( "Generating ", mrl, " thumbnail in ", dest );
+        outputs.push_back( { o.desiredWidth, o.desiredHeight, std::move( dest ),
+                             m_ml->thumbnailEncoding( o.sizeType ) } );
+        pending.push_back( { i, std::move( thumbnail ), isFirstThumbnailGeneration } );
     }
+    if ( outputs.empty() == true )
+        return results;
 
-    auto destMrl = utils::file::toMrl( dest );
     /*
-     * Even if we had a thumbnail before, we still might need to update its
-     * status, so we still invoke setThumbnail and let it decide what needs
-     * to be updated in db
+     * When packing the thumbnails, let the thumbnailer hand them over in
+     * memory instead of writing them to a file we'd read back right away
      */
-    return m->setThumbnail( std::make_shared<Thumbnail>( m_ml, std::move( destMrl ),
-                        Thumbnail::Origin::Media, task.sizeType, true ) );
+    auto store = m_ml->thumbnailStore();
+    std::vector<std::vector<uint8_t>> encoded;
+    if ( store != nullptr )
+    {
+        encoded.resize( outputs.size() );
+        for ( auto i = 0u; i < outputs.size(); ++i )
+            outputs[i].encoded = &encoded[i];
+    }
+
+    if ( m_generator->generate( *m, mrl, task.position, outputs ) == false )
+    {
+        for ( const auto& p : pending )
+        {
+            if ( m_run == false )
+            {
+                /*
+                 * The generation failed because the thumbnailer was interrupted.
+                 *
+                 * If we were trying to generate the first thumbnail for this media
+                 * we need to remove the record, as there were no crashes, and we
+                 * don't want to report that information to the user.
+                 * Otherwise, just keep the previous thumbnail.
+                 */
+                if ( p.isFirstThumbnailGeneration == true )
+                    m->removeThumbnail( task.outputs[p.idx].sizeType );
+            }
+            else
+            {
+                // Otherwise, ensure the status is "Failure" (since getting here means
+                // there was no crash) and bump the number of attempt
+                p.thumbnail->markFailed();
+            }
+        }
+        return results;
+    }
+
+    std::vector<std::string> destMrls;
+    destMrls.reserve( outputs.size() );
+    for ( const auto& o : outputs )
+        destMrls.push_back( utils::file::toMrl( o.destination ) );
+    /*
+     * The thumbnails provided in memory are packed before being referenced,
+     * so they are available as soon as the database points to them
+     */
+    std::vector<bool> available( pending.size(), true );
+    for ( auto i = 0u; i < encoded.size(); ++i )
+    {
+        const auto& data = encoded[i];
+        if ( data.empty() == true )
+            continue;
+        if ( store->pack( destMrls[i], data.data(), data.size() ) == true )
+        {
+            /* Don't keep a previous version of the thumbnail around */
+            utils::fs::remove( outputs[i].destination );
+            continue;
+        }
+        LOG_WARN( "Failed to pack thumbnail ", destMrls[i], ". Keeping it as a file" );
+        if ( utils::fs::write( outputs[i].destination, data.data(), data.size() ) == false )
+        {
+            LOG_ERROR( "Failed to write thumbnail ", outputs[i].destination );
+            pending[i].thumbnail->markFailed();
+            available[i] = false;
+        }
+    }
+    {
+        /* Store all the sizes at once */
+        auto t = m_ml->getConn()->newTransaction();
+        for ( auto i = 0u; i < pending.size(); ++i )
+        {
+            if ( available[i] == false )
+                continue;
+            const auto& destMrl = destMrls[i];
+            /*
+             * Even if we had a thumbnail before, we still might need to update its
+             * status, so we still invoke setThumbnail and let it decide what needs
+             * to be updated in db
+             */
+            results[pending[i].idx] = m->setThumbnail(
+                        std::make_shared<Thumbnail>( m_ml, destMrl,
+                                                     Thumbnail::Origin::Media,
+                                                     task.outputs[pending[i].idx].sizeType,
+                                                     true ) );
+        }
+        t->commit();
+    }
+    if ( store != nullptr )
+    {
+        /* Pack the thumbnails the thumbnailer wrote to a file */
+        for ( auto i = 0u; i < pending.size(); ++i )
+        {
+            if ( results[pending[i].idx] == true && encoded[i].empty() == true &&
+                 store->pack( destMrls[i] ) == false )
+                LOG_WARN( "Failed to pack thumbnail ", destMrls[i], ". Keeping it as a file" );
+        }
+    }
+    return results;
 }
 
 }
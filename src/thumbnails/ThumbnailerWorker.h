@@ -30,7 +30,8 @@
 
 #include <queue>
 #include <atomic>
-#include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace medialibrary
 {
@@ -54,34 +55,48 @@ public:
     void resume();
 
 private:
-    struct Task
+    struct Output
     {
-        int64_t mediaId; /* if 0, then this is a request to run the cleanup */
-        MediaPtr media; /* may be null */
         ThumbnailSizeType sizeType;
         uint32_t desiredWidth;
         uint32_t desiredHeight;
+    };
+    struct Task
+    {
+        int64_t mediaId; /* if 0, then this is a request to run the cleanup */
+        MediaPtr media; /* may be null */
         float position;
+        /*
+         * The requested sizes. This is only populated when the task is
+         * dequeued, since the requests for other sizes are merged until then
+         */
+        std::vector<Output> outputs;
     };
 
 private:
     void run();
     void stop();
 
-    bool generateThumbnail( Task task );
+    /*
+     * Generates all the sizes requested by a task from the same frame, and
+     * returns a result for each of them
+     */
+    std::vector<bool> generateThumbnails( const Task& task );
     void requestThumbnailInternal( int64_t mediaId, MediaPtr media,
                                    ThumbnailSizeType sizeType,
                                    uint32_t desiredWidth,
                                    uint32_t desiredHeight,
                                    float position );
     void runCleanupRequests();
+    void removeTemporaryFiles();
 
 private:
     MediaLibraryPtr m_ml;
     compat::Mutex m_mutex;
     compat::ConditionVariable m_cond;
     std::queue<Task> m_tasks;
-    std::set<int64_t> m_queuedMedia;
+    /* The sizes requested for each queued media */
+    std::unordered_map<int64_t, std::vector<Output>> m_queuedMedia;
     std::atomic_bool m_run;
     std::shared_ptr<IThumbnailer> m_generator;
     compat::Thread m_thread;
@@ -29,6 +29,8 @@
 #include "Media.h"
 #include "Thumbnail.h"
 #include "utils/VLCInstance.h"
+#include "utils/Image.h"
+#include "utils/File.h"
 #include "metadata_services/vlc/Common.hpp"
 #ifdef HAVE_JPEG
 #include "imagecompressors/JpegCompressor.h"
@@ -36,11 +38,32 @@
 #error No image compressor available
 #endif
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
 namespace medialibrary
 {
 
+namespace
+{
+
+bool writeThumbnail( const std::string& path, const std::vector<uint8_t>& data )
+{
+    if ( utils::fs::write( path, data.data(), data.size() ) == false )
+    {
+        LOG_ERROR( "Failed to write thumbnail file ", path, '(', strerror( errno ), ')' );
+        return false;
+    }
+    return true;
+}
+
+}
+
 VmemThumbnailer::VmemThumbnailer()
     : m_prevSize( 0 )
+    , m_prevScaledSize( 0 )
 {
 #ifdef HAVE_JPEG
     m_compressor.reset( new JpegCompressor );
@@ -51,6 +74,16 @@ bool VmemThumbnailer::generate( const IMedia& media, const std::string& mrl,
                                 uint32_t desiredWidth, uint32_t desiredHeight,
                                 float position, const std::string& dest )
 {
+    return generate( media, mrl, position,
+                     { Output{ desiredWidth, desiredHeight, dest, ThumbnailEncoding{} } } );
+}
+
+bool VmemThumbnailer::generate( const IMedia& media, const std::string& mrl,
+                                float position,
+                                const std::vector<Output>& outputs )
+{
+    if ( outputs.empty() == true )
+        return true;
     VLC::Media vlcMedia = VLC::Media( VLCInstance::get(), mrl,
                                       VLC::Media::FromType::FromLocation );
     vlcMedia.addOption( ":no-audio" );
@@ -72,7 +105,7 @@ bool VmemThumbnailer::generate( const IMedia& media, const std::string& mrl,
         vlcMedia.addOption( ss.str() );
     }
 
-    Task task{ mrl, desiredWidth, desiredHeight };
+    Task task{ mrl, outputs };
 
     task.mp = VLC::MediaPlayer( vlcMedia );
 
@@ -96,7 +129,7 @@ bool VmemThumbnailer::generate( const IMedia& media, const std::string& mrl,
             return false;
         }
     }
-    return takeThumbnail( task, dest );
+    return takeThumbnail( task );
 }
 
 bool VmemThumbnailer::seekAhead( Task& task, float position )
@@ -133,26 +166,38 @@ void VmemThumbnailer::setupVout( Task& task )
 
             const float inputAR = (float)*width / *height;
 
-            if ( task.desiredWidth == 0 && task.desiredHeight == 0 )
+            task.width = 0;
+            task.height = 0;
+            for ( auto& t : task.targets )
             {
-                task.desiredWidth = *width;
-                task.desiredHeight = *height;
-            }
-            else if ( task.desiredHeight == 0 )
-            {
-                task.desiredHeight = (float)task.desiredWidth / inputAR;
-            }
-            else if ( task.desiredWidth == 0 )
-            {
-                task.desiredWidth = (float)task.desiredHeight * inputAR;
-            }
-            task.width = task.desiredWidth;
-            task.height = (float)task.width / inputAR + 1;
-            if ( task.height < task.desiredHeight )
-            {
-                // Avoid downscaling too much for really wide pictures
-                task.width = inputAR * task.desiredHeight;
-                task.height = task.desiredHeight;
+                if ( t.desiredWidth == 0 && t.desiredHeight == 0 )
+                {
+                    t.desiredWidth = *width;
+                    t.desiredHeight = *height;
+                }
+                else if ( t.desiredHeight == 0 )
+                {
+                    t.desiredHeight = (float)t.desiredWidth / inputAR;
+                }
+                else if ( t.desiredWidth == 0 )
+                {
+                    t.desiredWidth = (float)t.desiredHeight * inputAR;
+                }
+                t.width = t.desiredWidth;
+                t.height = (float)t.width / inputAR + 1;
+                if ( t.height < t.desiredHeight )
+                {
+                    // Avoid downscaling too much for really wide pictures
+                    t.width = inputAR * t.desiredHeight;
+                    t.height = t.desiredHeight;
+                }
+                // Decode once, at the largest size, and derive the other
+                // targets from that frame
+                if ( t.width * t.height > task.width * task.height )
+                {
+                    task.width = t.width;
+                    task.height = t.height;
+                }
             }
             auto size = task.width * task.height * m_compressor->bpp();
             // If our buffer isn't enough anymore, reallocate a new one.
@@ -189,7 +234,7 @@ void VmemThumbnailer::setupVout( Task& task )
     );
 }
 
-bool VmemThumbnailer::takeThumbnail( Task& task, const std::string& dest )
+bool VmemThumbnailer::takeThumbnail( Task& task )
 {
     // lock, signal that we want a thumbnail, and wait.
     {
@@ -206,17 +251,50 @@ bool VmemThumbnailer::takeThumbnail( Task& task, const std::string& dest )
         }
     }
     task.mp.stop();
-    return compress( task, dest );
+    return compress( task );
 }
 
-bool VmemThumbnailer::compress( const Task& task, const std::string& dest )
+bool VmemThumbnailer::compress( const Task& task )
 {
-    auto hOffset = task.width > task.desiredWidth ? ( task.width - task.desiredWidth ) / 2 : 0;
-    auto vOffset = task.height > task.desiredHeight ? ( task.height - task.desiredHeight ) / 2 : 0;
+    for ( const auto& t : task.targets )
+    {
+        const uint8_t* buff = m_buff.get();
+        auto width = std::min( t.width, task.width );
+        auto height = std::min( t.height, task.height );
+        if ( width != task.width || height != task.height )
+        {
+            auto size = width * height * m_compressor->bpp();
+            if ( size > m_prevScaledSize )
+            {
+                m_scaledBuff.reset( new uint8_t[size] );
+                m_prevScaledSize = size;
+            }
+            utils::image::downscale( m_buff.get(), task.width, task.height,
+                                     m_scaledBuff.get(), width, height,
+                                     m_compressor->bpp() );
+            buff = m_scaledBuff.get();
+        }
+        auto desiredWidth = std::min( t.desiredWidth, width );
+        auto desiredHeight = std::min( t.desiredHeight, height );
+        auto hOffset = ( width - desiredWidth ) / 2;
+        auto vOffset = ( height - desiredHeight ) / 2;
 
-    return m_compressor->compress( m_buff.get(), dest, task.width, task.height,
-                                   task.desiredWidth, task.desiredHeight,
-                                   hOffset, vOffset );
+        /* Hand the thumbnail over in memory when the caller accepts it */
+        if ( t.encoded != nullptr )
+        {
+            if ( m_compressor->compress( buff, *t.encoded, width, height,
+                                         desiredWidth, desiredHeight,
+                                         hOffset, vOffset, t.encoding ) == false )
+                return false;
+            continue;
+        }
+        if ( m_compressor->compress( buff, m_encoded, width, height,
+                                     desiredWidth, desiredHeight,
+                                     hOffset, vOffset, t.encoding ) == false ||
+             writeThumbnail( t.destination, m_encoded ) == false )
+            return false;
+    }
+    return true;
 }
 
 void VmemThumbnailer::stop()
@@ -224,15 +302,16 @@ void VmemThumbnailer::stop()
     // Not implemented
 }
 
-VmemThumbnailer::Task::Task( std::string mrl, uint32_t desiredWidth,
-                             uint32_t desiredHeight )
+VmemThumbnailer::Task::Task( std::string mrl, const std::vector<Output>& outputs )
     : mrl( std::move( mrl ) )
     , width( 0 )
     , height( 0 )
     , thumbnailRequired( false )
-    , desiredWidth( desiredWidth )
-    , desiredHeight( desiredHeight )
 {
+    targets.reserve( outputs.size() );
+    for ( const auto& o : outputs )
+        targets.push_back( Target{ o.desiredWidth, o.desiredHeight, 0, 0,
+                                   o.destination, o.encoding, o.encoded } );
 }
 
 }
@@ -31,25 +31,38 @@
 #include <vlcpp/vlc.hpp>
 
 #include <atomic>
+#include <vector>
 
 namespace medialibrary
 {
 
 class VmemThumbnailer : public IThumbnailer
 {
+    struct Target
+    {
+        uint32_t desiredWidth;
+        uint32_t desiredHeight;
+        /* The dimensions to scale the frame to before cropping it */
+        uint32_t width;
+        uint32_t height;
+        std::string destination;
+        ThumbnailEncoding encoding;
+        std::vector<uint8_t>* encoded;
+    };
+
     struct Task
     {
-        Task( std::string mrl, uint32_t desiredWidth, uint32_t desiredHeight );
+        Task( std::string mrl, const std::vector<Output>& outputs );
 
         compat::Mutex mutex;
         compat::ConditionVariable cond;
         std::string mrl;
+        /* The decoded frame dimensions, which are the largest target ones */
         uint32_t width;
         uint32_t height;
         VLC::MediaPlayer mp;
         std::atomic_bool thumbnailRequired;
-        uint32_t desiredWidth;
-        uint32_t desiredHeight;
+        std::vector<Target> targets;
     };
 
 public:
@@ -57,15 +70,23 @@ public:
     virtual bool generate( const IMedia& media, const std::string& mrl,
                            uint32_t desiredWidth, uint32_t desiredHeight,
                            float position, const std::string& dest ) override;
+    virtual bool generate( const IMedia& media, const std::string& mrl,
+                           float position,
+                           const std::vector<Output>& outputs ) override;
     virtual void stop() override;
     bool seekAhead( Task& task, float position );
     void setupVout( Task& task );
-    bool takeThumbnail( Task& task, const std::string& dest );
-    bool compress( const Task& task, const std::string& dest );
+    bool takeThumbnail( Task& task );
+    bool compress( const Task& task );
 
 private:
     std::unique_ptr<uint8_t[]> m_buff;
     uint32_t m_prevSize;
+    /* Holds the frame downscaled for the smaller targets */
+    std::unique_ptr<uint8_t[]> m_scaledBuff;
+    uint32_t m_prevScaledSize;
+    /* The encoded picture, kept around to reuse its allocation */
+    std::vector<uint8_t> m_encoded;
     std::unique_ptr<IImageCompressor> m_compressor;
 };
 
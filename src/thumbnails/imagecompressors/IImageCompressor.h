@@ -24,6 +24,9 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
+
+#include "medialibrary/IThumbnailer.h"
 
 namespace medialibrary
 {
@@ -37,10 +40,20 @@ public:
      */
     virtual const char* fourCC() const = 0;
     virtual uint32_t bpp() const = 0;
-    virtual bool compress( const uint8_t* buffer, const std::string& output,
+    /**
+     * @brief compress Encodes a part of the provided picture in memory
+     * @param buffer The input picture, tightly packed, in the fourCC() format
+     * @param output The buffer to store the encoded picture in. Its previous
+     *               content is discarded, but its capacity is reused
+     * @param hOffset The horizontal offset of the area to encode
+     * @param vOffset The vertical offset of the area to encode
+     * @param encoding The settings to encode the picture with
+     */
+    virtual bool compress( const uint8_t* buffer, std::vector<uint8_t>& output,
                            uint32_t inputWidth, uint32_t inputHeight,
                            uint32_t outputWidth, uint32_t outputHeight,
-                           uint32_t hOffset, uint32_t vOffset ) = 0;
+                           uint32_t hOffset, uint32_t vOffset,
+                           const ThumbnailEncoding& encoding ) = 0;
 };
 
 }
@@ -28,12 +28,14 @@
 
 #include "logging/Logger.h"
 
-#include <jpeglib.h>
-
-#include <cerrno>
-#include <cstring>
-#include <memory>
-#include <setjmp.h>
+#ifdef HAVE_TURBOJPEG
+# include <turbojpeg.h>
+#else
+# include <algorithm>
+# include <cstdio>
+# include <jpeglib.h>
+# include <setjmp.h>
+#endif
 
 namespace medialibrary
 {
@@ -48,6 +50,70 @@ uint32_t JpegCompressor::bpp() const
     return 3;
 }
 
+#ifdef HAVE_TURBOJPEG
+
+namespace
+{
+
+int toTjSubsampling( ThumbnailEncoding::Subsampling subsampling )
+{
+    switch ( subsampling )
+    {
+        case ThumbnailEncoding::Subsampling::Yuv444:
+            return TJSAMP_444;
+        case ThumbnailEncoding::Subsampling::Yuv422:
+            return TJSAMP_422;
+        case ThumbnailEncoding::Subsampling::Yuv420:
+            return TJSAMP_420;
+    }
+    return TJSAMP_420;
+}
+
+}
+
+JpegCompressor::JpegCompressor()
+    : m_handle( tjInitCompress(), &tjDestroy )
+{
+}
+
+bool JpegCompressor::compress( const uint8_t* buffer, std::vector<uint8_t>& output,
+                               uint32_t inputWidth, uint32_t,
+                               uint32_t outputWidth, uint32_t outputHeight,
+                               uint32_t hOffset, uint32_t vOffset,
+                               const ThumbnailEncoding& encoding )
+{
+    if ( m_handle == nullptr )
+    {
+        LOG_ERROR( "Failed to initialize TurboJPEG" );
+        return false;
+    }
+    const auto stride = inputWidth * bpp();
+    const auto subsampling = toTjSubsampling( encoding.subsampling );
+    /*
+     * Encode straight from the decoded frame, and into the provided buffer,
+     * which is large enough for the worst case, so that TurboJPEG never
+     * needs to allocate nor copy anything
+     */
+    output.resize( tjBufSize( outputWidth, outputHeight, subsampling ) );
+    auto outputBuffer = output.data();
+    unsigned long outputSize = output.size();
+    if ( tjCompress2( m_handle.get(), &buffer[vOffset * stride + hOffset * bpp()],
+                      outputWidth, stride, outputHeight, TJPF_RGB,
+                      &outputBuffer, &outputSize, subsampling,
+                      encoding.quality, TJFLAG_NOREALLOC ) != 0 )
+    {
+        LOG_ERROR( "JPEG failure: ", tjGetErrorStr2( m_handle.get() ) );
+        return false;
+    }
+    output.resize( outputSize );
+    return true;
+}
+
+#else
+
+namespace
+{
+
 struct jpegError : public jpeg_error_mgr
 {
     jmp_buf buff;
@@ -61,21 +127,67 @@ struct jpegError : public jpeg_error_mgr
     }
 };
 
-bool JpegCompressor::compress( const uint8_t* buffer, const std::string& outputFile,
-                              uint32_t inputWidth, uint32_t,
-                              uint32_t outputWidth, uint32_t outputHeight,
-                              uint32_t hOffset, uint32_t vOffset )
+/*
+ * Write the compressed picture directly in the provided vector, growing it
+ * when libjpeg runs out of space.
+ * jpeg_mem_dest isn't available with the libjpeg 6b API, and would require
+ * a copy to the output buffer anyway.
+ */
+struct vectorDestination : public jpeg_destination_mgr
 {
-    const auto stride = inputWidth * bpp();
+    explicit vectorDestination( std::vector<uint8_t>& output )
+        : output( output )
+    {
+        init_destination = &init;
+        empty_output_buffer = &grow;
+        term_destination = &term;
+    }
 
-    //FIXME: Abstract this away, though libjpeg requires a FILE*...
-    auto fOut = std::unique_ptr<FILE, int(*)(FILE*)>( fopen( outputFile.c_str(), "wb" ), &fclose );
-    if ( fOut == nullptr )
+    static void init( j_compress_ptr compInfo )
     {
-        LOG_ERROR( "Failed to open thumbnail file ", outputFile, '(', strerror( errno ), ')' );
-        return false;
+        auto self = reinterpret_cast<vectorDestination*>( compInfo->dest );
+        /* Reuse the previous picture buffer if any */
+        self->output.resize( std::max( self->output.capacity(), InitialSize ) );
+        self->next_output_byte = self->output.data();
+        self->free_in_buffer = self->output.size();
+    }
+
+    static boolean grow( j_compress_ptr compInfo )
+    {
+        auto self = reinterpret_cast<vectorDestination*>( compInfo->dest );
+        auto used = self->output.size();
+        self->output.resize( used * 2 );
+        self->next_output_byte = self->output.data() + used;
+        self->free_in_buffer = self->output.size() - used;
+        return TRUE;
     }
 
+    static void term( j_compress_ptr compInfo )
+    {
+        auto self = reinterpret_cast<vectorDestination*>( compInfo->dest );
+        self->output.resize( self->output.size() - self->free_in_buffer );
+    }
+
+    static constexpr size_t InitialSize = 16 * 1024;
+    std::vector<uint8_t>& output;
+};
+
+constexpr size_t vectorDestination::InitialSize;
+
+}
+
+JpegCompressor::JpegCompressor()
+{
+}
+
+bool JpegCompressor::compress( const uint8_t* buffer, std::vector<uint8_t>& output,
+                               uint32_t inputWidth, uint32_t,
+                               uint32_t outputWidth, uint32_t outputHeight,
+                               uint32_t hOffset, uint32_t vOffset,
+                               const ThumbnailEncoding& encoding )
+{
+    const auto stride = inputWidth * bpp();
+
     jpeg_compress_struct compInfo;
     JSAMPROW row_pointer[1];
 
@@ -93,14 +205,31 @@ bool JpegCompressor::compress( const uint8_t* buffer, const std::string& outputF
     }
 
     jpeg_create_compress(&compInfo);
-    jpeg_stdio_dest(&compInfo, fOut.get());
+    output.clear();
+    vectorDestination dest{ output };
+    compInfo.dest = &dest;
 
     compInfo.image_width = outputWidth;
     compInfo.image_height = outputHeight;
     compInfo.input_components = bpp();
     compInfo.in_color_space = JCS_RGB;
     jpeg_set_defaults( &compInfo );
-    jpeg_set_quality( &compInfo, 80, TRUE );
+    jpeg_set_quality( &compInfo, encoding.quality, TRUE );
+    switch ( encoding.subsampling )
+    {
+        case ThumbnailEncoding::Subsampling::Yuv444:
+            compInfo.comp_info[0].h_samp_factor = 1;
+            compInfo.comp_info[0].v_samp_factor = 1;
+            break;
+        case ThumbnailEncoding::Subsampling::Yuv422:
+            compInfo.comp_info[0].h_samp_factor = 2;
+            compInfo.comp_info[0].v_samp_factor = 1;
+            break;
+        case ThumbnailEncoding::Subsampling::Yuv420:
+            compInfo.comp_info[0].h_samp_factor = 2;
+            compInfo.comp_info[0].v_samp_factor = 2;
+            break;
+    }
 
     jpeg_start_compress( &compInfo, TRUE );
 
@@ -114,4 +243,6 @@ bool JpegCompressor::compress( const uint8_t* buffer, const std::string& outputF
     return true;
 }
 
+#endif
+
 }
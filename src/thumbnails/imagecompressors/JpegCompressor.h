@@ -24,18 +24,30 @@
 
 #include "IImageCompressor.h"
 
+#ifdef HAVE_TURBOJPEG
+# include <memory>
+#endif
+
 namespace medialibrary
 {
 
 class JpegCompressor : public IImageCompressor
 {
 public:
+    JpegCompressor();
     virtual const char* fourCC() const override;
     virtual uint32_t bpp() const override;
-    virtual bool compress(const uint8_t* buffer, const std::string& output,
-                          uint32_t inputWidth, uint32_t inputHeight,
-                          uint32_t outputWidth, uint32_t outputHeight,
-                          uint32_t hOffset, uint32_t vOffset) override;
+    virtual bool compress( const uint8_t* buffer, std::vector<uint8_t>& output,
+                           uint32_t inputWidth, uint32_t inputHeight,
+                           uint32_t outputWidth, uint32_t outputHeight,
+                           uint32_t hOffset, uint32_t vOffset,
+                           const ThumbnailEncoding& encoding ) override;
+
+private:
+#ifdef HAVE_TURBOJPEG
+    /* The TurboJPEG handle, reused for all pictures */
+    std::unique_ptr<void, int(*)(void*)> m_handle;
+#endif
 };
 
 }
@@ -102,6 +102,31 @@ bool remove( const std::string& path )
     return unlink( path.c_str() ) == 0;
 }
 
+bool rename( const std::string& from, const std::string& to )
+{
+#ifdef _WIN32
+    /* Unlike POSIX, windows refuses to overwrite an existing file */
+    remove( to );
+#endif
+    return ::rename( from.c_str(), to.c_str() ) == 0;
+}
+
+bool write( const std::string& path, const uint8_t* data, size_t size )
+{
+    const auto tmpPath = path + ".tmp";
+    auto f = fopen( tmpPath.c_str(), "wb" );
+    if ( f == nullptr )
+        return false;
+    auto res = fwrite( data, 1, size, f ) == size;
+    if ( fclose( f ) != 0 || res == false ||
+         rename( tmpPath, path ) == false )
+    {
+        remove( tmpPath );
+        return false;
+    }
+    return true;
+}
+
 uint64_t fileSize( const std::string& path )
 {
     struct stat s;
@@ -113,6 +138,17 @@ uint64_t fileSize( const std::string& path )
     return s.st_size;
 }
 
+bool fileInfo( const std::string& path, uint64_t& size,
+               time_t& lastModificationDate )
+{
+    struct stat s;
+    if ( stat( path.c_str(), &s ) != 0 )
+        return false;
+    size = s.st_size;
+    lastModificationDate = s.st_mtime;
+    return true;
+}
+
 }
 
 }
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <cstdint>
+#include <ctime>
 #include <string>
 
 namespace medialibrary
@@ -43,7 +44,25 @@ namespace fs
  */
 bool copy( const std::string& from, const std::string& to );
 bool remove( const std::string& path );
+/**
+ * @brief rename Moves a file, overwriting the destination if it exists
+ */
+bool rename( const std::string& from, const std::string& to );
+/**
+ * @brief write Writes a file through a temporary file which is then renamed
+ *
+ * The file is never observed half written, including after a crash, in which
+ * case the temporary file, named after the file with a .tmp extension, is
+ * left behind.
+ */
+bool write( const std::string& path, const uint8_t* data, size_t size );
 uint64_t fileSize( const std::string& path );
+/**
+ * @brief fileInfo Probes a file size and last modification date
+ * @return false if the file couldn't be probed, ie. if it doesn't exist
+ */
+bool fileInfo( const std::string& path, uint64_t& size,
+               time_t& lastModificationDate );
 
 }
 
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace medialibrary
+{
+
+namespace utils
+{
+
+namespace histogram
+{
+
+/**
+ * @brief log2Bucket Returns the index of the bucket counting the provided duration
+ *
+ * Bucket i counts the durations between 2^i and 2^(i+1) µs. Shorter durations
+ * land in the first bucket, and longer ones in the last.
+ */
+inline size_t log2Bucket( std::chrono::microseconds duration, size_t nbBuckets )
+{
+    auto us = static_cast<uint64_t>( std::max<int64_t>( duration.count(), 1 ) );
+    auto bucket = size_t{ 0 };
+    while ( us >>= 1 )
+        ++bucket;
+    return std::min( bucket, nbBuckets - 1 );
+}
+
+}
+
+}
+
+}
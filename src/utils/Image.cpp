@@ -0,0 +1,268 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Image.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+# include <emmintrin.h>
+# define ML_IMAGE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+# include <arm_neon.h>
+# define ML_IMAGE_NEON 1
+#endif
+
+namespace medialibrary
+{
+namespace utils
+{
+namespace image
+{
+
+namespace
+{
+
+/*
+ * Weights are fixed point values, so that the sum of a source pixel component
+ * multiplied by 2 weights still fits in a signed 32 bits integer, as required
+ * by _mm_madd_epi16
+ */
+constexpr uint32_t WeightBits = 14;
+constexpr uint32_t WeightOne = 1u << WeightBits;
+
+/*
+ * For each destination row or column, the source rows or columns it covers,
+ * and how much of each of them it covers
+ */
+struct Contributions
+{
+    explicit Contributions( uint32_t srcSize, uint32_t dstSize );
+
+    std::vector<uint32_t> first;
+    std::vector<uint32_t> count;
+    /* maxCount weights for each destination index */
+    std::vector<uint16_t> weights;
+    uint32_t maxCount;
+};
+
+Contributions::Contributions( uint32_t srcSize, uint32_t dstSize )
+    : first( dstSize )
+    , count( dstSize )
+    , maxCount( ( srcSize + dstSize - 1 ) / dstSize + 1 )
+{
+    assert( dstSize > 0 && dstSize <= srcSize );
+    weights.resize( dstSize * maxCount, 0 );
+    for ( auto i = 0u; i < dstSize; ++i )
+    {
+        /*
+         * Using 1/dstSize of a source pixel as the unit, the destination
+         * pixel covers [i * srcSize; (i + 1) * srcSize[ and the source
+         * pixel j covers [j * dstSize; (j + 1) * dstSize[
+         */
+        const auto begin = static_cast<uint64_t>( i ) * srcSize;
+        const auto end = begin + srcSize;
+        const auto firstIdx = static_cast<uint32_t>( begin / dstSize );
+        const auto lastIdx = static_cast<uint32_t>( ( end - 1 ) / dstSize );
+        assert( lastIdx - firstIdx < maxCount );
+        first[i] = firstIdx;
+        count[i] = lastIdx - firstIdx + 1;
+        auto w = &weights[i * maxCount];
+        auto total = 0u;
+        auto maxIdx = 0u;
+        for ( auto j = firstIdx; j <= lastIdx; ++j )
+        {
+            const auto overlap =
+                    std::min<uint64_t>( end, static_cast<uint64_t>( j + 1 ) * dstSize ) -
+                    std::max<uint64_t>( begin, static_cast<uint64_t>( j ) * dstSize );
+            const auto weight = static_cast<uint16_t>( overlap * WeightOne / srcSize );
+            w[j - firstIdx] = weight;
+            total += weight;
+            if ( weight > w[maxIdx] )
+                maxIdx = j - firstIdx;
+        }
+        /* Don't let the rounding errors darken the picture */
+        w[maxIdx] += WeightOne - total;
+    }
+}
+
+inline uint8_t normalize( uint32_t value )
+{
+    return static_cast<uint8_t>( ( value + WeightOne / 2 ) >> WeightBits );
+}
+
+/* acc[i] += rowA[i] * wA + rowB[i] * wB */
+template <bool Vectorized>
+void accumulateRows( uint32_t* acc, const uint8_t* rowA, uint16_t wA,
+                     const uint8_t* rowB, uint16_t wB, size_t size )
+{
+    size_t i = 0;
+    if ( Vectorized == true )
+    {
+#if defined(ML_IMAGE_SSE2)
+        /* Each 32 bits lane holds a (wA, wB) pair of 16 bits weights */
+        const auto weights = _mm_set1_epi32( static_cast<int>(
+                                    ( static_cast<uint32_t>( wB ) << 16 ) | wA ) );
+        const auto zero = _mm_setzero_si128();
+        for ( ; i + 16 <= size; i += 16 )
+        {
+            const auto a = _mm_loadu_si128( reinterpret_cast<const __m128i*>( rowA + i ) );
+            const auto b = _mm_loadu_si128( reinterpret_cast<const __m128i*>( rowB + i ) );
+            const auto aLo = _mm_unpacklo_epi8( a, zero );
+            const auto aHi = _mm_unpackhi_epi8( a, zero );
+            const auto bLo = _mm_unpacklo_epi8( b, zero );
+            const auto bHi = _mm_unpackhi_epi8( b, zero );
+            /* Interleave both rows so that each madd computes a * wA + b * wB */
+            const __m128i sums[] = {
+                _mm_madd_epi16( _mm_unpacklo_epi16( aLo, bLo ), weights ),
+                _mm_madd_epi16( _mm_unpackhi_epi16( aLo, bLo ), weights ),
+                _mm_madd_epi16( _mm_unpacklo_epi16( aHi, bHi ), weights ),
+                _mm_madd_epi16( _mm_unpackhi_epi16( aHi, bHi ), weights ),
+            };
+            for ( auto j = 0u; j < 4; ++j )
+            {
+                auto dst = reinterpret_cast<__m128i*>( acc + i + j * 4 );
+                _mm_storeu_si128( dst, _mm_add_epi32( _mm_loadu_si128( dst ),
+                                                      sums[j] ) );
+            }
+        }
+#elif defined(ML_IMAGE_NEON)
+        for ( ; i + 8 <= size; i += 8 )
+        {
+            const auto a = vmovl_u8( vld1_u8( rowA + i ) );
+            const auto b = vmovl_u8( vld1_u8( rowB + i ) );
+            auto lo = vld1q_u32( acc + i );
+            auto hi = vld1q_u32( acc + i + 4 );
+            lo = vmlal_n_u16( lo, vget_low_u16( a ), wA );
+            lo = vmlal_n_u16( lo, vget_low_u16( b ), wB );
+            hi = vmlal_n_u16( hi, vget_high_u16( a ), wA );
+            hi = vmlal_n_u16( hi, vget_high_u16( b ), wB );
+            vst1q_u32( acc + i, lo );
+            vst1q_u32( acc + i + 4, hi );
+        }
+#endif
+    }
+    for ( ; i < size; ++i )
+        acc[i] += rowA[i] * wA + rowB[i] * wB;
+}
+
+template <bool Vectorized>
+void downscaleImpl( const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                    uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight,
+                    uint32_t bpp )
+{
+    assert( dstWidth <= srcWidth && dstHeight <= srcHeight );
+    if ( dstWidth == 0 || dstHeight == 0 )
+        return;
+    const size_t srcPitch = static_cast<size_t>( srcWidth ) * bpp;
+    const size_t dstPitch = static_cast<size_t>( dstWidth ) * bpp;
+    if ( dstWidth == srcWidth && dstHeight == srcHeight )
+    {
+        memcpy( dst, src, srcPitch * srcHeight );
+        return;
+    }
+    const Contributions rows{ srcHeight, dstHeight };
+    const Contributions cols{ srcWidth, dstWidth };
+    std::vector<uint32_t> acc( srcPitch );
+    std::vector<uint8_t> row( srcPitch );
+
+    for ( auto y = 0u; y < dstHeight; ++y )
+    {
+        /*
+         * Start with the vertical pass, which processes whole rows and
+         * therefore vectorizes nicely, and leaves a single row to the
+         * horizontal pass
+         */
+        const uint8_t* srcRow;
+        if ( dstHeight == srcHeight )
+            srcRow = src + y * srcPitch;
+        else
+        {
+            std::fill( begin( acc ), end( acc ), 0 );
+            const auto w = &rows.weights[y * rows.maxCount];
+            const auto first = src + rows.first[y] * srcPitch;
+            auto k = 0u;
+            for ( ; k + 1 < rows.count[y]; k += 2 )
+                accumulateRows<Vectorized>( acc.data(), first + k * srcPitch, w[k],
+                                            first + ( k + 1 ) * srcPitch, w[k + 1],
+                                            srcPitch );
+            if ( k < rows.count[y] )
+                accumulateRows<Vectorized>( acc.data(), first + k * srcPitch, w[k],
+                                            first + k * srcPitch, 0, srcPitch );
+            for ( auto i = 0u; i < srcPitch; ++i )
+                row[i] = normalize( acc[i] );
+            srcRow = row.data();
+        }
+
+        auto dstRow = dst + y * dstPitch;
+        if ( dstWidth == srcWidth )
+        {
+            memcpy( dstRow, srcRow, dstPitch );
+            continue;
+        }
+        for ( auto x = 0u; x < dstWidth; ++x )
+        {
+            const auto w = &cols.weights[x * cols.maxCount];
+            const auto first = srcRow + cols.first[x] * bpp;
+            for ( auto c = 0u; c < bpp; ++c )
+            {
+                auto sum = 0u;
+                for ( auto k = 0u; k < cols.count[x]; ++k )
+                    sum += first[k * bpp + c] * w[k];
+                dstRow[x * bpp + c] = normalize( sum );
+            }
+        }
+    }
+}
+
+}
+
+void downscale( const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight,
+                uint32_t bpp )
+{
+    downscaleImpl<true>( src, srcWidth, srcHeight, dst, dstWidth, dstHeight, bpp );
+}
+
+namespace scalar
+{
+
+void downscale( const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight,
+                uint32_t bpp )
+{
+    downscaleImpl<false>( src, srcWidth, srcHeight, dst, dstWidth, dstHeight, bpp );
+}
+
+}
+
+}
+}
+}
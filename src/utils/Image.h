@@ -0,0 +1,68 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace medialibrary
+{
+namespace utils
+{
+namespace image
+{
+
+/**
+ * @brief downscale Downscales a picture by averaging the covered source area
+ * @param src The source picture, made of packed 8 bits components
+ * @param srcWidth The source width, in pixels
+ * @param srcHeight The source height, in pixels
+ * @param dst A buffer of at least dstWidth * dstHeight * bpp bytes
+ * @param dstWidth The destination width, which can't be larger than srcWidth
+ * @param dstHeight The destination height, which can't be larger than srcHeight
+ * @param bpp The number of bytes per pixel
+ *
+ * Both pictures are expected to be tightly packed, ie. their pitch is
+ * their width multiplied by bpp.
+ * The vertical pass uses the SIMD instructions available at build time
+ * (SSE2 or NEON).
+ */
+void downscale( const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight,
+                uint32_t bpp );
+
+/*
+ * The plain implementation, used as a reference for the vectorized version.
+ * Both versions are expected to output the exact same picture.
+ */
+namespace scalar
+{
+
+void downscale( const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight,
+                uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight,
+                uint32_t bpp );
+
+}
+
+}
+}
+}
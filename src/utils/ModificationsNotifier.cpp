@@ -29,6 +29,7 @@
 #include "ModificationsNotifier.h"
 #include "MediaLibrary.h"
 #include "utils/File.h"
+#include "utils/SWMRLock.h"
 #include "database/SqliteErrors.h"
 #include "Common.h"
 #include "thumbnails/ThumbnailerWorker.h"
@@ -232,6 +233,7 @@ void ModificationNotifier::flush()
 
 void ModificationNotifier::run()
 {
+    utils::SWMRLock::setThreadClient( LockClient::Background );
     // Create some other queue to swap with the ones that are used
     // by other threads. That way we can release those early and allow
     // more insertions to proceed
@@ -23,6 +23,7 @@
 #endif
 
 #include "SWMRLock.h"
+#include "Histogram.h"
 
 #include <cassert>
 #include <algorithm>
@@ -33,50 +34,121 @@ namespace medialibrary
 namespace utils
 {
 
+constexpr size_t SWMRLock::NbModes;
+constexpr size_t SWMRLock::NbClients;
+constexpr uint32_t SWMRLock::SlowPath;
+thread_local LockClient SWMRLock::s_client = LockClient::Application;
+thread_local SWMRLock::Clock::time_point SWMRLock::s_acquiredAt[SWMRLock::NbModes];
+
+namespace
+{
+
+void updateMax( std::atomic<uint64_t>& max, uint64_t value )
+{
+    auto current = max.load( std::memory_order_relaxed );
+    while ( current < value &&
+            max.compare_exchange_weak( current, value,
+                                       std::memory_order_relaxed ) == false )
+        ;
+}
+
+}
+
 void SWMRLock::lock_read()
 {
+    auto start = Clock::now();
+    auto state = m_state.load( std::memory_order_relaxed );
+    while ( ( state & SlowPath ) == 0 )
+    {
+        if ( m_state.compare_exchange_weak( state, state + 1,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed ) == true )
+        {
+            s_acquiredAt[static_cast<size_t>( LockMode::Read )] = start;
+            record_wait( LockMode::Read, start, start, false );
+            return;
+        }
+    }
+
     auto tid = compat::this_thread::get_id();
+    auto preempted = false;
 
     std::unique_lock<compat::Mutex> lock( m_lock );
     ++m_nbReaderWaiting;
-    m_cond.wait( lock, [this, tid](){
+    m_cond.wait( lock, [this, tid, &preempted](){
         if ( must_give_way( tid ) )
+        {
             /* There are other clients with priority access */
+            preempted = true;
             return false;
-        return m_writing == false;
+        }
+        if ( has_priority( tid ) == true )
+            return m_writing == false;
+        return reader_may_enter();
     });
     --m_nbReaderWaiting;
-    m_nbReader++;
+    m_nbConsecutiveWrites = 0;
+    m_state.fetch_add( 1, std::memory_order_acquire );
+    lock.unlock();
+
+    auto acquired = Clock::now();
+    s_acquiredAt[static_cast<size_t>( LockMode::Read )] = acquired;
+    record_wait( LockMode::Read, start, acquired, preempted );
 }
 
 void SWMRLock::unlock_read()
 {
-    std::unique_lock<compat::Mutex> lock( m_lock );
-    --m_nbReader;
-    if ( m_nbReader == 0 && m_nbWriterWaiting > 0 )
-        m_cond.notify_one();
+    record_hold( LockMode::Read,
+                 s_acquiredAt[static_cast<size_t>( LockMode::Read )] );
+    auto state = m_state.fetch_sub( 1, std::memory_order_release );
+    /* If the fast path is closed, someone might be waiting for the last
+     * reader to leave */
+    if ( state == ( SlowPath | 1 ) )
+    {
+        std::lock_guard<compat::Mutex> lock( m_lock );
+        m_cond.notify_all();
+    }
 }
 
 void SWMRLock::lock_write()
 {
+    auto start = Clock::now();
     auto tid = compat::this_thread::get_id();
+    auto preempted = false;
 
     std::unique_lock<compat::Mutex> lock( m_lock );
     ++m_nbWriterWaiting;
-    m_cond.wait( lock, [this, tid](){
+    /* Prevent new readers from taking the fast path before checking for
+     * the active ones */
+    update_fast_path();
+    m_cond.wait( lock, [this, tid, &preempted](){
         if ( must_give_way( tid ) )
+        {
             /* There are other clients with priority access */
+            preempted = true;
             return false;
-        return m_writing == false && m_nbReader == 0;
+        }
+        if ( m_writing == true || nb_readers() > 0 )
+            return false;
+        return has_priority( tid ) == true || writer_may_enter();
     });
     --m_nbWriterWaiting;
     m_writing = true;
+    ++m_nbConsecutiveWrites;
+    lock.unlock();
+
+    auto acquired = Clock::now();
+    s_acquiredAt[static_cast<size_t>( LockMode::Write )] = acquired;
+    record_wait( LockMode::Write, start, acquired, preempted );
 }
 
 void SWMRLock::unlock_write()
 {
+    record_hold( LockMode::Write,
+                 s_acquiredAt[static_cast<size_t>( LockMode::Write )] );
     std::unique_lock<compat::Mutex> lock( m_lock );
     m_writing = false;
+    update_fast_path();
     if ( m_nbReaderWaiting > 0 || m_nbWriterWaiting > 0 )
         m_cond.notify_all();
 }
@@ -86,12 +158,19 @@ void SWMRLock::acquire_priority_access()
     auto &tids = m_priorityAccessOwners;
     auto tid = compat::this_thread::get_id();
 
-    std::unique_lock<compat::Mutex> lock( m_lock );
+    {
+        std::unique_lock<compat::Mutex> lock( m_lock );
 
-    /* The priority access is not recursive */
-    assert( !has_priority( tid ) );
+        /* The priority access is not recursive */
+        assert( !has_priority( tid ) );
 
-    tids.push_back( tid );
+        tids.push_back( tid );
+        update_fast_path();
+    }
+
+    auto acquired = Clock::now();
+    s_acquiredAt[static_cast<size_t>( LockMode::Priority )] = acquired;
+    record_wait( LockMode::Priority, acquired, acquired, false );
 }
 
 void SWMRLock::release_priority_access()
@@ -99,6 +178,9 @@ void SWMRLock::release_priority_access()
     auto &tids = m_priorityAccessOwners;
     auto tid = compat::this_thread::get_id();
 
+    record_hold( LockMode::Priority,
+                 s_acquiredAt[static_cast<size_t>( LockMode::Priority )] );
+
     std::unique_lock<compat::Mutex> lock( m_lock );
 
     auto end = std::remove( tids.begin(), tids.end(), tid );
@@ -107,7 +189,81 @@ void SWMRLock::release_priority_access()
     tids.erase( end, tids.end() );
 
     if ( tids.empty() )
+    {
+        update_fast_path();
         m_cond.notify_all();
+    }
+}
+
+void SWMRLock::setPolicy( LockPolicy policy, uint32_t maxWriterBatch )
+{
+    std::lock_guard<compat::Mutex> lock( m_lock );
+    m_policy = policy;
+    m_maxWriterBatch = maxWriterBatch;
+    m_cond.notify_all();
+}
+
+std::vector<LockStats> SWMRLock::stats() const
+{
+    std::vector<LockStats> res;
+    for ( auto m = 0u; m < NbModes; ++m )
+    {
+        for ( auto c = 0u; c < NbClients; ++c )
+        {
+            const auto& counters = m_counters[m][c];
+            auto nbAcquisitions =
+                    counters.nbAcquisitions.load( std::memory_order_relaxed );
+            if ( nbAcquisitions == 0 )
+                continue;
+            LockStats s{};
+            s.mode = static_cast<LockMode>( m );
+            s.client = static_cast<LockClient>( c );
+            s.nbAcquisitions = nbAcquisitions;
+            s.nbPreempted = counters.nbPreempted.load( std::memory_order_relaxed );
+            s.totalWait = std::chrono::microseconds{
+                    counters.totalWait.load( std::memory_order_relaxed ) };
+            s.maxWait = std::chrono::microseconds{
+                    counters.maxWait.load( std::memory_order_relaxed ) };
+            s.totalHold = std::chrono::microseconds{
+                    counters.totalHold.load( std::memory_order_relaxed ) };
+            s.maxHold = std::chrono::microseconds{
+                    counters.maxHold.load( std::memory_order_relaxed ) };
+            for ( auto i = 0u; i < LockStats::NbBuckets; ++i )
+            {
+                s.waitHistogram[i] =
+                        counters.waitHistogram[i].load( std::memory_order_relaxed );
+                s.holdHistogram[i] =
+                        counters.holdHistogram[i].load( std::memory_order_relaxed );
+            }
+            res.push_back( s );
+        }
+    }
+    return res;
+}
+
+void SWMRLock::resetStats()
+{
+    for ( auto& modeCounters : m_counters )
+    {
+        for ( auto& counters : modeCounters )
+        {
+            counters.nbAcquisitions.store( 0, std::memory_order_relaxed );
+            counters.nbPreempted.store( 0, std::memory_order_relaxed );
+            counters.totalWait.store( 0, std::memory_order_relaxed );
+            counters.maxWait.store( 0, std::memory_order_relaxed );
+            counters.totalHold.store( 0, std::memory_order_relaxed );
+            counters.maxHold.store( 0, std::memory_order_relaxed );
+            for ( auto& b : counters.waitHistogram )
+                b.store( 0, std::memory_order_relaxed );
+            for ( auto& b : counters.holdHistogram )
+                b.store( 0, std::memory_order_relaxed );
+        }
+    }
+}
+
+void SWMRLock::setThreadClient( LockClient client )
+{
+    s_client = client;
 }
 
 bool SWMRLock::has_priority( compat::Thread::id tid ) const
@@ -121,6 +277,84 @@ bool SWMRLock::must_give_way( compat::Thread::id tid ) const
     return !m_priorityAccessOwners.empty() && !has_priority( tid );
 }
 
+bool SWMRLock::reader_may_enter() const
+{
+    if ( m_writing == true )
+        return false;
+    switch ( m_policy )
+    {
+        case LockPolicy::ReaderPreferring:
+            return true;
+        case LockPolicy::WriterPreferring:
+            return m_nbWriterWaiting == 0;
+        case LockPolicy::BoundedWriterBatches:
+            return m_nbWriterWaiting == 0 ||
+                   m_nbConsecutiveWrites >= m_maxWriterBatch;
+    }
+    return true;
+}
+
+bool SWMRLock::writer_may_enter() const
+{
+    /* Once the batch is over, let the waiting readers in before the next
+     * writer */
+    if ( m_policy == LockPolicy::BoundedWriterBatches &&
+         m_nbReaderWaiting > 0 && m_nbConsecutiveWrites >= m_maxWriterBatch )
+        return false;
+    return true;
+}
+
+unsigned int SWMRLock::nb_readers() const
+{
+    return m_state.load( std::memory_order_acquire ) & ~SlowPath;
+}
+
+void SWMRLock::update_fast_path()
+{
+    if ( m_writing == true || m_nbWriterWaiting > 0 ||
+         m_priorityAccessOwners.empty() == false )
+    {
+        m_state.fetch_or( SlowPath, std::memory_order_acq_rel );
+        return;
+    }
+    /* The lock is idle, which ends the current writer batch */
+    m_nbConsecutiveWrites = 0;
+    m_state.fetch_and( ~SlowPath, std::memory_order_acq_rel );
+}
+
+void SWMRLock::record_wait( LockMode mode, Clock::time_point start,
+                            Clock::time_point acquired, bool preempted )
+{
+    auto& counters = m_counters[static_cast<size_t>( mode )]
+                               [static_cast<size_t>( s_client )];
+    auto wait = std::chrono::duration_cast<std::chrono::microseconds>(
+                acquired - start );
+    auto us = static_cast<uint64_t>( wait.count() );
+    counters.nbAcquisitions.fetch_add( 1, std::memory_order_relaxed );
+    if ( preempted == true )
+        counters.nbPreempted.fetch_add( 1, std::memory_order_relaxed );
+    if ( us > 0 )
+    {
+        counters.totalWait.fetch_add( us, std::memory_order_relaxed );
+        updateMax( counters.maxWait, us );
+    }
+    auto bucket = histogram::log2Bucket( wait, LockStats::NbBuckets );
+    counters.waitHistogram[bucket].fetch_add( 1, std::memory_order_relaxed );
+}
+
+void SWMRLock::record_hold( LockMode mode, Clock::time_point acquired )
+{
+    auto& counters = m_counters[static_cast<size_t>( mode )]
+                               [static_cast<size_t>( s_client )];
+    auto hold = std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - acquired );
+    auto us = static_cast<uint64_t>( hold.count() );
+    counters.totalHold.fetch_add( us, std::memory_order_relaxed );
+    updateMax( counters.maxHold, us );
+    auto bucket = histogram::log2Bucket( hold, LockStats::NbBuckets );
+    counters.holdHistogram[bucket].fetch_add( 1, std::memory_order_relaxed );
+}
+
 }
 
 }
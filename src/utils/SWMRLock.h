@@ -25,7 +25,10 @@
 #include "compat/ConditionVariable.h"
 #include "compat/Mutex.h"
 #include "compat/Thread.h"
+#include "medialibrary/IMediaLibrary.h"
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 
 namespace medialibrary
@@ -37,6 +40,10 @@ namespace utils
 ///
 /// \brief Single Write Multiple Reader lock
 ///
+/// Uncontended read acquisitions only touch an atomic counter. As soon as a
+/// writer or a priority access owner shows up, all acquisitions go through
+/// the mutex & condition variable until the lock is idle again.
+///
 class SWMRLock
 {
 public:
@@ -49,22 +56,73 @@ public:
     void acquire_priority_access();
     void release_priority_access();
 
+    void setPolicy( LockPolicy policy, uint32_t maxWriterBatch );
+    std::vector<LockStats> stats() const;
+    void resetStats();
+
+    /**
+     * @brief setThreadClient Sets the client the calling thread's acquisitions
+     *                        are accounted for.
+     *
+     * Threads default to LockClient::Application
+     */
+    static void setThreadClient( LockClient client );
+
 private:
+    using Clock = std::chrono::steady_clock;
+
     bool has_priority( compat::Thread::id tid ) const;
     bool must_give_way( compat::Thread::id tid ) const;
+    bool reader_may_enter() const;
+    bool writer_may_enter() const;
+    unsigned int nb_readers() const;
+    void update_fast_path();
+
+    void record_wait( LockMode mode, Clock::time_point start,
+                      Clock::time_point acquired, bool preempted );
+    void record_hold( LockMode mode, Clock::time_point acquired );
+
+    struct Counters
+    {
+        std::atomic<uint64_t> nbAcquisitions;
+        std::atomic<uint64_t> nbPreempted;
+        std::atomic<uint64_t> totalWait;
+        std::atomic<uint64_t> maxWait;
+        std::atomic<uint64_t> totalHold;
+        std::atomic<uint64_t> maxHold;
+        std::atomic<uint64_t> waitHistogram[LockStats::NbBuckets];
+        std::atomic<uint64_t> holdHistogram[LockStats::NbBuckets];
+    };
+    static constexpr size_t NbModes =
+            static_cast<size_t>( LockMode::Priority ) + 1;
+    static constexpr size_t NbClients =
+            static_cast<size_t>( LockClient::Background ) + 1;
+
+    /* Set in m_state when the readers must go through the mutex */
+    static constexpr uint32_t SlowPath = 1u << 31;
 
     compat::ConditionVariable m_cond;
     compat::Mutex m_lock;
-    unsigned int m_nbReader = 0;
+    /* The number of active readers, and the SlowPath flag */
+    std::atomic<uint32_t> m_state{ 0 };
     unsigned int m_nbReaderWaiting = 0;
     bool m_writing = false;
     unsigned int m_nbWriterWaiting = 0;
+    LockPolicy m_policy = LockPolicy::ReaderPreferring;
+    uint32_t m_maxWriterBatch = 0;
+    /* The number of writes since a reader last entered */
+    uint32_t m_nbConsecutiveWrites = 0;
 
     /* If there is at least one thread with priority access, then all new lock
      * requests from threads without priority access are blocked. However, they
      * can continue executing their current requests following the traditional
      * RW-lock rules. */
     std::vector<compat::Thread::id> m_priorityAccessOwners;
+
+    Counters m_counters[NbModes][NbClients]{};
+
+    static thread_local LockClient s_client;
+    static thread_local Clock::time_point s_acquiredAt[NbModes];
 };
 
 class WriteLocker
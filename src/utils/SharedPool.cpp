@@ -0,0 +1,113 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "SharedPool.h"
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace medialibrary
+{
+namespace utils
+{
+
+namespace
+{
+/*
+ * Each allocation is preceded by a pointer to its chunk, padded so that the
+ * object itself is suitably aligned for any fundamental type.
+ */
+constexpr size_t HeaderSize = alignof( std::max_align_t ) > sizeof( void* ) ?
+            alignof( std::max_align_t ) : sizeof( void* );
+
+constexpr size_t alignUp( size_t value )
+{
+    return ( value + HeaderSize - 1 ) & ~( HeaderSize - 1 );
+}
+}
+
+struct SharedPool::Chunk
+{
+    // One reference per live allocation, and one for the pool while it is
+    // still allocating from this chunk
+    std::atomic<uint32_t> nbRefs;
+};
+
+constexpr size_t SharedPool::DefaultChunkSize;
+
+SharedPool::SharedPool( size_t chunkSize )
+    : m_chunkSize( chunkSize )
+    , m_chunk( nullptr )
+    , m_offset( 0 )
+{
+}
+
+SharedPool::~SharedPool()
+{
+    if ( m_chunk != nullptr )
+        release( m_chunk );
+}
+
+void* SharedPool::allocate( size_t size, size_t alignment )
+{
+    assert( alignment <= HeaderSize );
+    (void)alignment;
+    auto needed = HeaderSize + alignUp( size );
+    if ( m_chunk == nullptr || m_offset + needed > m_chunkSize )
+    {
+        if ( m_chunk != nullptr )
+            release( m_chunk );
+        auto chunkSize = needed + alignUp( sizeof( Chunk ) );
+        if ( chunkSize < m_chunkSize )
+            chunkSize = m_chunkSize;
+        auto buff = static_cast<uint8_t*>( ::operator new( chunkSize ) );
+        m_chunk = new ( buff ) Chunk{ { 1 } };
+        m_offset = alignUp( sizeof( Chunk ) );
+    }
+    auto base = reinterpret_cast<uint8_t*>( m_chunk ) + m_offset;
+    *reinterpret_cast<Chunk**>( base ) = m_chunk;
+    m_offset += needed;
+    m_chunk->nbRefs.fetch_add( 1, std::memory_order_relaxed );
+    return base + HeaderSize;
+}
+
+void SharedPool::deallocate( void* p ) noexcept
+{
+    auto base = static_cast<uint8_t*>( p ) - HeaderSize;
+    release( *reinterpret_cast<Chunk**>( base ) );
+}
+
+void SharedPool::release( Chunk* chunk ) noexcept
+{
+    if ( chunk->nbRefs.fetch_sub( 1, std::memory_order_acq_rel ) != 1 )
+        return;
+    chunk->~Chunk();
+    ::operator delete( chunk );
+}
+
+}
+}
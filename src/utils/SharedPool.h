@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace medialibrary
+{
+namespace utils
+{
+
+/**
+ * @brief The SharedPool class provides the memory for many shared_ptr created
+ *        at once, such as the entities of a result set.
+ *
+ * Objects are carved out of chunks, which are released when the last object
+ * they contain is destroyed. This saves a heap allocation per object, at the
+ * cost of keeping a whole chunk alive for as long as one of its objects is.
+ *
+ * Allocations must all be performed from the same thread, but the objects
+ * can be released from any thread, and can outlive the pool.
+ */
+class SharedPool
+{
+public:
+    template <typename T>
+    struct Allocator
+    {
+        using value_type = T;
+
+        explicit Allocator( SharedPool* p ) noexcept : pool( p ) {}
+        template <typename U>
+        Allocator( const Allocator<U>& a ) noexcept : pool( a.pool ) {}
+
+        T* allocate( size_t n )
+        {
+            return static_cast<T*>( pool->allocate( n * sizeof( T ), alignof( T ) ) );
+        }
+
+        void deallocate( T* p, size_t ) noexcept
+        {
+            SharedPool::deallocate( p );
+        }
+
+        template <typename U>
+        bool operator==( const Allocator<U>& a ) const noexcept
+        {
+            return pool == a.pool;
+        }
+
+        template <typename U>
+        bool operator!=( const Allocator<U>& a ) const noexcept
+        {
+            return pool != a.pool;
+        }
+
+        /*
+         * Only used to allocate: the objects only refer to their chunk when
+         * they get released, so they can outlive the pool
+         */
+        SharedPool* pool;
+    };
+
+    static constexpr size_t DefaultChunkSize = 16 * 1024;
+
+    explicit SharedPool( size_t chunkSize = DefaultChunkSize );
+    ~SharedPool();
+    SharedPool( const SharedPool& ) = delete;
+    SharedPool& operator=( const SharedPool& ) = delete;
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make_shared( Args&&... args )
+    {
+        return std::allocate_shared<T>( Allocator<T>{ this },
+                                        std::forward<Args>( args )... );
+    }
+
+    void* allocate( size_t size, size_t alignment );
+    static void deallocate( void* p ) noexcept;
+
+private:
+    struct Chunk;
+    static void release( Chunk* chunk ) noexcept;
+
+private:
+    const size_t m_chunkSize;
+    Chunk* m_chunk;
+    size_t m_offset;
+};
+
+}
+}
@@ -30,6 +30,16 @@
 #include <cassert>
 #include <cctype>
 #include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+# include <emmintrin.h>
+# define ML_UTF8_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+# include <arm_neon.h>
+# define ML_UTF8_NEON 1
+#endif
 
 namespace medialibrary
 {
@@ -52,6 +62,300 @@ std::string trim( std::string value )
 namespace utf8
 {
 
+namespace
+{
+
+#if defined(ML_UTF8_SSE2) || defined(ML_UTF8_NEON)
+constexpr size_t BlockSize = 16;
+#else
+constexpr size_t BlockSize = sizeof( uint64_t );
+#endif
+
+inline unsigned int firstSetBit( uint32_t mask )
+{
+    assert( mask != 0 );
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz( mask );
+#else
+    auto i = 0u;
+    while ( ( mask & 1 ) == 0 )
+    {
+        mask >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+inline unsigned int nbSetBits( uint32_t mask )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount( mask );
+#else
+    auto i = 0u;
+    for ( ; mask != 0; mask &= mask - 1 )
+        ++i;
+    return i;
+#endif
+}
+
+/**
+ * @brief countBlock Counts the characters in a BlockSize bytes block
+ * @param data A pointer to the block, which must start on a code point boundary
+ * @param nbChars Will be set to the number of characters in the block
+ * @return The number of bytes that were processed, or 0 if the block must be
+ *         processed by the byte per byte implementation
+ *
+ * This only handles well formed blocks, where each continuation byte follows
+ * a matching leading byte, since the counting then boils down to counting the
+ * non-continuation bytes. Everything else (invalid sequences, 5 & 6 bytes
+ * sequences...) is left to the scalar path, which knows how to handle them.
+ * A code point that spans over the block end is not processed, so that the
+ * returned size always ends on a code point boundary.
+ */
+inline size_t countBlock( const char* data, size_t& nbChars )
+{
+#if defined(ML_UTF8_SSE2)
+    const auto v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data ) );
+    if ( _mm_movemask_epi8( v ) == 0 )
+    {
+        nbChars = BlockSize;
+        return BlockSize;
+    }
+    auto ge = []( __m128i v, uint8_t b ) {
+        auto bound = _mm_set1_epi8( static_cast<char>( b ) );
+        return _mm_cmpeq_epi8( _mm_max_epu8( v, bound ), v );
+    };
+    auto isCont = _mm_cmpeq_epi8( _mm_and_si128( v, _mm_set1_epi8( static_cast<char>( 0xC0 ) ) ),
+                                  _mm_set1_epi8( static_cast<char>( 0x80 ) ) );
+    /*
+     * Compute which bytes must be continuation bytes based on the 3 previous
+     * leading bytes. Since the block starts on a code point boundary, the bytes
+     * before the block are irrelevant and shifting zeros in is fine.
+     */
+    auto needCont = _mm_or_si128( ge( _mm_slli_si128( v, 1 ), 0xC0 ),
+                      _mm_or_si128( ge( _mm_slli_si128( v, 2 ), 0xE0 ),
+                                    ge( _mm_slli_si128( v, 3 ), 0xF0 ) ) );
+    auto invalid = _mm_or_si128( _mm_xor_si128( isCont, needCont ), ge( v, 0xF8 ) );
+    if ( _mm_movemask_epi8( invalid ) != 0 )
+        return 0;
+    auto contMask = static_cast<uint32_t>( _mm_movemask_epi8( isCont ) );
+    auto nbNonCont = BlockSize - nbSetBits( contMask );
+#elif defined(ML_UTF8_NEON)
+    const auto v = vld1q_u8( reinterpret_cast<const uint8_t*>( data ) );
+    if ( vmaxvq_u8( v ) < 0x80 )
+    {
+        nbChars = BlockSize;
+        return BlockSize;
+    }
+    const auto zero = vdupq_n_u8( 0 );
+    auto isCont = vceqq_u8( vandq_u8( v, vdupq_n_u8( 0xC0 ) ), vdupq_n_u8( 0x80 ) );
+    auto needCont = vorrq_u8( vcgeq_u8( vextq_u8( zero, v, 15 ), vdupq_n_u8( 0xC0 ) ),
+                      vorrq_u8( vcgeq_u8( vextq_u8( zero, v, 14 ), vdupq_n_u8( 0xE0 ) ),
+                                vcgeq_u8( vextq_u8( zero, v, 13 ), vdupq_n_u8( 0xF0 ) ) ) );
+    auto invalid = vorrq_u8( veorq_u8( isCont, needCont ),
+                             vcgeq_u8( v, vdupq_n_u8( 0xF8 ) ) );
+    if ( vmaxvq_u8( invalid ) != 0 )
+        return 0;
+    size_t nbNonCont = BlockSize - vaddvq_u8( vshrq_n_u8( isCont, 7 ) );
+#else
+    /* Without SIMD support, only skip over pure ASCII blocks */
+    uint64_t word;
+    memcpy( &word, data, sizeof( word ) );
+    if ( ( word & 0x8080808080808080ull ) != 0 )
+        return 0;
+    size_t nbNonCont = BlockSize;
+#endif
+    /* Leave a truncated trailing code point to the next block */
+    const auto last = reinterpret_cast<const uint8_t*>( data ) + BlockSize - 1;
+    size_t truncated = 0;
+    if ( last[0] >= 0xC0 )
+        truncated = 1;
+    else if ( last[-1] >= 0xE0 )
+        truncated = 2;
+    else if ( last[-2] >= 0xF0 )
+        truncated = 3;
+    nbChars = nbNonCont - ( truncated != 0 ? 1 : 0 );
+    return BlockSize - truncated;
+}
+
+/**
+ * @brief codepointLength Returns the number of bytes used by the code point
+ *                        starting at the provided offset, or 0 if it is
+ *                        invalid or truncated.
+ */
+inline size_t codepointLength( const char* data, size_t size, size_t offset )
+{
+    uint8_t c = data[offset];
+    if ( ( c & 0x80 ) == 0 )
+        return 1;
+    /*
+     * Skip over the leading unicode byte, and skip an extra byte
+     * for each leading bit set to 1 in the first byte
+     */
+    auto i = offset + 1;
+    c <<= 1;
+    while ( ( c & 0x80 ) != 0 )
+    {
+        if ( i >= size || ( data[i] & 0x80 ) == 0 )
+            return 0;
+        ++i;
+        c <<= 1;
+    }
+    return i - offset;
+}
+
+struct Span
+{
+    size_t nbChars;
+    size_t nbBytes;
+    bool valid;
+};
+
+/**
+ * @brief walk Walks over at most maxChars complete code points
+ * @return The number of characters & bytes that were walked over, and a
+ *         validity flag that will be false if the walk stopped on an invalid or
+ *         truncated code point.
+ */
+inline Span walk( const char* data, size_t size, size_t maxChars )
+{
+    Span res{ 0, 0, true };
+    auto useBlocks = true;
+    while ( res.nbBytes < size && res.nbChars < maxChars )
+    {
+        if ( useBlocks == true && size - res.nbBytes >= BlockSize )
+        {
+            size_t nbChars;
+            auto nbBytes = countBlock( data + res.nbBytes, nbChars );
+            if ( nbBytes > 0 )
+            {
+                if ( nbChars <= maxChars - res.nbChars )
+                {
+                    res.nbBytes += nbBytes;
+                    res.nbChars += nbChars;
+                    continue;
+                }
+                /*
+                 * Less than a block worth of characters remain, there is no
+                 * point in trying to process any other block
+                 */
+                useBlocks = false;
+            }
+        }
+        auto length = codepointLength( data, size, res.nbBytes );
+        if ( length == 0 )
+        {
+            res.valid = false;
+            break;
+        }
+        res.nbBytes += length;
+        ++res.nbChars;
+    }
+    return res;
+}
+
+inline uint8_t asciiToLower( uint8_t c )
+{
+    if ( c >= 'A' && c <= 'Z' )
+        return c | 0x20;
+    return c;
+}
+
+/**
+ * @brief equalSpan Returns the number of leading bytes that are equal in both
+ *                  buffers. ASCII characters are compared case-insensitively.
+ */
+inline size_t equalSpan( const char* lhs, const char* rhs, size_t size )
+{
+    size_t i = 0;
+#if defined(ML_UTF8_SSE2)
+    const auto lowerBound = _mm_set1_epi8( 'A' - 1 );
+    const auto upperBound = _mm_set1_epi8( 'Z' + 1 );
+    const auto caseBit = _mm_set1_epi8( 0x20 );
+    auto toLower = [&]( __m128i v ) {
+        /*
+         * Signed comparisons are fine: non ASCII bytes are negative and will
+         * be left untouched
+         */
+        auto isUpper = _mm_and_si128( _mm_cmpgt_epi8( v, lowerBound ),
+                                      _mm_cmpgt_epi8( upperBound, v ) );
+        return _mm_or_si128( v, _mm_and_si128( isUpper, caseBit ) );
+    };
+    for ( ; i + 16 <= size; i += 16 )
+    {
+        auto l = _mm_loadu_si128( reinterpret_cast<const __m128i*>( lhs + i ) );
+        auto r = _mm_loadu_si128( reinterpret_cast<const __m128i*>( rhs + i ) );
+        auto eq = static_cast<uint32_t>( _mm_movemask_epi8(
+                        _mm_cmpeq_epi8( toLower( l ), toLower( r ) ) ) );
+        if ( eq != 0xFFFF )
+            return i + firstSetBit( ~eq & 0xFFFF );
+    }
+#elif defined(ML_UTF8_NEON)
+    const auto lowerBound = vdupq_n_u8( 'A' );
+    const auto upperBound = vdupq_n_u8( 'Z' );
+    const auto caseBit = vdupq_n_u8( 0x20 );
+    auto toLower = [&]( uint8x16_t v ) {
+        auto isUpper = vandq_u8( vcgeq_u8( v, lowerBound ),
+                                 vcleq_u8( v, upperBound ) );
+        return vorrq_u8( v, vandq_u8( isUpper, caseBit ) );
+    };
+    for ( ; i + 16 <= size; i += 16 )
+    {
+        auto l = vld1q_u8( reinterpret_cast<const uint8_t*>( lhs + i ) );
+        auto r = vld1q_u8( reinterpret_cast<const uint8_t*>( rhs + i ) );
+        if ( vminvq_u8( vceqq_u8( toLower( l ), toLower( r ) ) ) != 0xFF )
+            break;
+    }
+#endif
+    while ( i < size && asciiToLower( lhs[i] ) == asciiToLower( rhs[i] ) )
+        ++i;
+    return i;
+}
+
+}
+
+size_t nbChars( const std::string& value )
+{
+    auto res = walk( value.data(), value.size(), value.size() );
+    if ( res.valid == false )
+        return 0;
+    return res.nbChars;
+}
+
+size_t nbBytes( const std::string& input, size_t offset, size_t nbChars )
+{
+    if ( offset >= input.size() )
+        return 0;
+    auto res = walk( input.data() + offset, input.size() - offset, nbChars );
+    if ( res.valid == false )
+        return 0;
+    return res.nbBytes;
+}
+
+std::string commonPattern( const std::string& lhs, size_t lhsOffset,
+                           const std::string& rhs, size_t rhsOffset,
+                           size_t minPatternSize )
+{
+    if ( lhsOffset >= lhs.size() || rhsOffset >= rhs.size() )
+        return {};
+    /*
+     * First find how many bytes are equal, and then only keep the complete
+     * code points out of those bytes, since we don't want to return a
+     * potentially partial code point
+     */
+    auto nbEqualBytes = equalSpan( lhs.data() + lhsOffset, rhs.data() + rhsOffset,
+                                   std::min( lhs.size() - lhsOffset,
+                                             rhs.size() - rhsOffset ) );
+    auto res = walk( lhs.data() + lhsOffset, nbEqualBytes, nbEqualBytes );
+    if ( res.nbChars < minPatternSize )
+        return {};
+    return lhs.substr( lhsOffset, res.nbBytes );
+}
+
+namespace scalar
+{
+
 size_t nbChars( const std::string& value )
 {
     uint32_t nbChars = 0u;
@@ -198,6 +502,8 @@ std::string commonPattern( const std::string& lhs, size_t lhsOffset,
 
 }
 
+}
+
 }
 }
 }
@@ -70,6 +70,24 @@ std::string commonPattern( const std::string& lhs, size_t lhsOffset,
                            const std::string& rhs, size_t rhsOffset,
                            size_t minPatternSize );
 
+/*
+ * The functions above process ASCII runs by blocks, using the SIMD instructions
+ * available at build time (SSE2/AVX2 or NEON), and fall back to a byte per byte
+ * processing for multi bytes code points.
+ * The functions in this namespace are the plain byte per byte implementations
+ * which are used as a reference for the vectorized versions.
+ */
+namespace scalar
+{
+
+size_t nbChars( const std::string& value );
+size_t nbBytes( const std::string& input, size_t offset, size_t nbChars );
+std::string commonPattern( const std::string& lhs, size_t lhsOffset,
+                           const std::string& rhs, size_t rhsOffset,
+                           size_t minPatternSize );
+
+}
+
 }
 
 }
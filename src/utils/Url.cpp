@@ -29,6 +29,7 @@
 #include "medialibrary/filesystem/Errors.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
@@ -36,50 +37,171 @@
 
 namespace
 {
-inline bool isSafe( char c )
+
+/*
+ * The characters that can be left as-is when encoding an URL segment.
+ * The base set is accepted in all segments, and each other bit represents a
+ * set of characters that are accepted in a specific segment only.
+ */
+enum SafeFlags : uint8_t
+{
+    Base = 1 << 0,
+    Scheme = 1 << 1,
+    UserInfo = 1 << 2,
+    Host = 1 << 3,
+    Path = 1 << 4,
+    Query = 1 << 5,
+};
+
+struct EncodingTable
 {
-    return strchr( ".-_~/"
+    EncodingTable()
+        : flags{}
+    {
+        for ( auto c = 'a'; c <= 'z'; ++c )
+            flags[static_cast<uint8_t>( c )] = Base;
+        for ( auto c = 'A'; c <= 'Z'; ++c )
+            flags[static_cast<uint8_t>( c )] = Base;
+        for ( auto c = '0'; c <= '9'; ++c )
+            flags[static_cast<uint8_t>( c )] = Base;
+        add( ".-_~/"
 #ifdef _WIN32
-                    "\\"
+             "\\"
 #endif
-                   , c ) != nullptr;
+             , Base );
+        add( "+", Scheme );
+        add( "!$&'()*+,;=:", UserInfo );
+        add( "[]", Host );
+        add( "!$&'()*+,;=:@", Path );
+        add( "!$&'()*+,;=:@?", Query );
+    }
+
+    void add( const char* chars, SafeFlags flag )
+    {
+        for ( ; *chars != 0; ++chars )
+            flags[static_cast<uint8_t>( *chars )] |= flag;
+    }
+
+    bool isSafe( char c, uint8_t segment ) const
+    {
+        return ( flags[static_cast<uint8_t>( c )] & ( Base | segment ) ) != 0;
+    }
+
+    uint8_t flags[256];
+};
+
+const EncodingTable& encodingTable()
+{
+    static const EncodingTable table;
+    return table;
 }
 
-std::string::const_iterator encodeSegment( std::string& res,
-                                           std::string::const_iterator begin,
-                                           std::string::const_iterator end,
-                                           const char* extraChars )
+void encodeSegment( std::string& res, const char* begin, const char* end,
+                    uint8_t segment )
 {
-    for ( auto i = begin; i < end; ++i )
+    const auto& table = encodingTable();
+    /* Size the output for the worst case, and shrink it once we're done */
+    const auto offset = res.size();
+    res.resize( offset + ( end - begin ) * 3 );
+    auto out = &res[offset];
+    for ( ; begin < end; ++begin )
     {
-        // This must be an unsigned char for the bits operations below to work.
-        // auto will yield a signed char here.
-        const unsigned char c = *i;
-        if ( ( c >= 32 && c <= 126 ) && (
-                 ( c >= 'a' && c <= 'z' ) ||
-                 ( c >= 'A' && c <= 'Z' ) ||
-                 ( c >= '0' && c <= '9' ) ||
-                 isSafe( c ) == true ||
-                 ( extraChars != nullptr && strchr( extraChars, c ) != nullptr ) )
-             )
+        if ( table.isSafe( *begin, segment ) == true )
         {
-            res.push_back( c );
+            *out++ = *begin;
+            continue;
         }
-        else
-            res.append({ '%', "0123456789ABCDEF"[c >> 4], "0123456789ABCDEF"[c & 0xF] });
+        // This must be an unsigned char for the bits operations below to work.
+        const unsigned char c = *begin;
+        *out++ = '%';
+        *out++ = "0123456789ABCDEF"[c >> 4];
+        *out++ = "0123456789ABCDEF"[c & 0xF];
     }
-    return end;
+    res.resize( out - res.data() );
 }
 
-inline uint16_t charToVal( char c )
+void encodeLocalPath( std::string& res, const char* begin, const char* end )
 {
-    if ( c >= '0' && c <= '9' )
-        return c - '0';
-    if ( c >= 'a' && c <= 'f' )
-        return c - 'a' + 10;
-    if ( c >= 'A' && c <= 'F' )
-        return c - 'A' + 10;
-    throw std::runtime_error( "Incomplete/invalid character sequence" );
+#ifdef _WIN32
+    if ( end - begin >= 3 && *begin == '/' && isalpha( *(begin + 1) ) &&
+         *(begin + 2) == ':' )
+    {
+        // Don't encode the ':' after the drive letter.
+        // All other ':' need to be encoded, there are not allowed in a file path
+        // on windows, but they might appear in urls
+        res.append( begin, begin + 3 );
+        begin += 3;
+    }
+#endif
+    encodeSegment( res, begin, end, Base );
+}
+
+inline void encodeSegment( std::string& res, const std::string& segment,
+                           uint8_t segmentFlag )
+{
+    encodeSegment( res, segment.data(), segment.data() + segment.size(),
+                   segmentFlag );
+}
+
+bool needsEncoding( const char* begin, const char* end )
+{
+    const auto& table = encodingTable();
+    for ( ; begin < end; ++begin )
+    {
+        if ( table.isSafe( *begin, Base ) == false )
+            return true;
+    }
+    return false;
+}
+
+inline int8_t charToVal( char c )
+{
+    /* Maps the hexadecimal digits to their value, and everything else to -1 */
+    static const struct HexTable
+    {
+        HexTable()
+        {
+            memset( values, -1, sizeof( values ) );
+            for ( auto i = 0; i < 10; ++i )
+                values['0' + i] = i;
+            for ( auto i = 0; i < 6; ++i )
+            {
+                values['a' + i] = 10 + i;
+                values['A' + i] = 10 + i;
+            }
+        }
+        int8_t values[256];
+    } table;
+    auto v = table.values[static_cast<uint8_t>( c )];
+    if ( v < 0 )
+        throw std::runtime_error( "Incomplete/invalid character sequence" );
+    return v;
+}
+
+void decodeInto( std::string& res, const char* begin, const char* end )
+{
+    /* The decoded output can't be larger than the input */
+    const auto offset = res.size();
+    res.resize( offset + ( end - begin ) );
+    auto out = &res[offset];
+    while ( begin < end )
+    {
+        auto percent = static_cast<const char*>(
+                    memchr( begin, '%', end - begin ) );
+        if ( percent == nullptr )
+            percent = end;
+        memcpy( out, begin, percent - begin );
+        out += percent - begin;
+        if ( percent == end )
+            break;
+        if ( end - percent < 3 )
+            throw std::runtime_error( "Incomplete/invalid character sequence" );
+        const auto c1 = charToVal( percent[1] );
+        const auto c2 = charToVal( percent[2] );
+        *out++ = static_cast<std::string::value_type>( c1 * 16 + c2 );
+        begin = percent + 3;
+    }
+    res.resize( out - res.data() );
 }
 
 }
@@ -91,193 +213,190 @@ namespace utils
 namespace url
 {
 
-parts split( const std::string& url )
+void split( const std::string& url, parts& res )
 {
-    parts res{};
+    res.userInfo.clear();
+    res.hostMarker = false;
+    res.host.clear();
+    res.port.clear();
+    res.path.clear();
+    res.query.clear();
+    res.fragments.clear();
+
     auto schemePos = url.find( "://" );
     if ( schemePos == std::string::npos )
     {
+        res.scheme.clear();
         res.path = url;
-        return res;
+        return;
     }
-    std::copy( url.cbegin(), url.cbegin() + schemePos,
-               std::back_inserter( res.scheme ) );
-
+    res.scheme.assign( url, 0, schemePos );
 
     if ( res.scheme == "file" )
     {
-        std::copy( url.cbegin() + schemePos + 3, url.cend(),
-                   std::back_inserter( res.path ) );
-        return res;
+        res.path.assign( url, schemePos + 3, std::string::npos );
+        return;
     }
 
-    const auto authorityBegin = url.cbegin() + schemePos + 3;
-    auto authorityEnd = std::find( authorityBegin, url.cend(), '/' );
-    auto queryBegin = std::find( authorityBegin, url.cend(), '?' );
-    const auto fragmentBegin = std::find( authorityBegin, url.cend(), '#' );
+    const auto authorityBegin = schemePos + 3;
+    auto authorityEnd = url.find( '/', authorityBegin );
+    auto queryBegin = url.find( '?', authorityBegin );
+    const auto fragmentBegin = url.find( '#', authorityBegin );
 
     /*
      * The fragment must come after the query parameters. Since we use both
      * values at a later point, sanitize them now.
      */
-    if ( fragmentBegin != url.cend() && queryBegin != url.cend() &&
-         fragmentBegin < queryBegin )
-    {
-        queryBegin = url.cend();
-    }
+    if ( fragmentBegin < queryBegin )
+        queryBegin = std::string::npos;
 
     /* RFC 3986 §3.2:
      * The authority component is preceded by a double slash ("//") and is
      * terminated by the next slash ("/"), question mark ("?"), or number
      * sign ("#") character, or by the end of the URI.
      */
-    if ( authorityEnd == url.cend() )
-    {
-        if ( queryBegin != url.cend() )
-            authorityEnd = queryBegin;
-        else
-            authorityEnd = fragmentBegin;
-    }
-    else
-    {
-        if ( queryBegin != url.cend() && queryBegin < authorityEnd )
-            authorityEnd = queryBegin;
-        if ( fragmentBegin != url.cend() && fragmentBegin < authorityEnd )
-            authorityEnd = fragmentBegin;
-    }
+    authorityEnd = std::min( { authorityEnd, queryBegin, fragmentBegin } );
+    const auto authorityLength = std::min( authorityEnd, url.size() ) - authorityBegin;
 
     {
         /* Split the authority into its actual components */
-        auto userInfoEnd = std::find( authorityBegin, authorityEnd, '@' );
-        if ( userInfoEnd != authorityEnd )
+        auto hostBegin = authorityBegin;
+        auto userInfoEnd = url.find( '@', authorityBegin );
+        if ( userInfoEnd < authorityBegin + authorityLength )
         {
-            std::copy( authorityBegin, userInfoEnd,
-                       std::back_inserter( res.userInfo ) );
+            res.userInfo.assign( url, authorityBegin, userInfoEnd - authorityBegin );
             /* Skip the '@' when copying the host */
-            ++userInfoEnd;
+            hostBegin = userInfoEnd + 1;
             res.hostMarker = true;
         }
-        else
-            userInfoEnd = authorityBegin;
-
-        auto portBegin = std::find( userInfoEnd, authorityEnd, ':' );
-        if ( portBegin != authorityEnd )
-            std::copy( portBegin + 1, authorityEnd, std::back_inserter( res.port ) );
-        else
-            portBegin = authorityEnd;
-        std::copy( userInfoEnd, portBegin, std::back_inserter( res.host ) );
 
+        auto hostEnd = authorityBegin + authorityLength;
+        auto portBegin = url.find( ':', hostBegin );
+        if ( portBegin < hostEnd )
+        {
+            res.port.assign( url, portBegin + 1, hostEnd - portBegin - 1 );
+            hostEnd = portBegin;
+        }
+        res.host.assign( url, hostBegin, hostEnd - hostBegin );
     }
-    if ( authorityEnd == url.cend() )
+    if ( authorityEnd == std::string::npos )
     {
         /*
          * If we don't have a clear end for the authority segment, it means the
          * end is the url end, so we don't have anything else to split
          */
-        return res;
+        return;
     }
 
-    auto pathEnd = queryBegin != url.cend() ? queryBegin : fragmentBegin;
-    std::copy( authorityEnd, pathEnd,
-               std::back_inserter( res.path ) );
-    if ( queryBegin != url.cend() )
-    {
-        std::copy( queryBegin + 1,
-                   fragmentBegin != url.cend() ? fragmentBegin : url.cend(),
-                   std::back_inserter( res.query ) );
-    }
-    if ( fragmentBegin != url.cend() )
+    auto pathEnd = std::min( queryBegin, fragmentBegin );
+    res.path.assign( url, authorityEnd, pathEnd - authorityEnd );
+    if ( queryBegin != std::string::npos )
     {
-        std::copy( fragmentBegin + 1, url.cend(),
-                   std::back_inserter( res.fragments ) );
+        res.query.assign( url, queryBegin + 1,
+                          fragmentBegin != std::string::npos ?
+                              fragmentBegin - queryBegin - 1 : std::string::npos );
     }
+    if ( fragmentBegin != std::string::npos )
+        res.fragments.assign( url, fragmentBegin + 1, std::string::npos );
+}
+
+parts split( const std::string& url )
+{
+    parts res{};
+    split( url, res );
     return res;
 }
 
+const std::string& decode( const std::string& str, std::string& buffer )
+{
+    assert( &str != &buffer );
+    auto percent = str.find( '%' );
+    if ( percent == std::string::npos )
+        return str;
+    buffer.assign( str, 0, percent );
+    decodeInto( buffer, str.data() + percent, str.data() + str.size() );
+    return buffer;
+}
+
 std::string decode( const std::string& str )
 {
     std::string res;
-    res.reserve( str.size() );
-    auto it = str.cbegin();
-    auto ite = str.cend();
-    for ( ; it != ite; ++it )
-    {
-        if ( *it == '%' )
-        {
-            ++it;
-            const auto c1 = charToVal( *it );
-            const auto c2 = charToVal( *( it + 1 ) );
-            auto val = c1 * 16 + c2;
-            res.push_back( static_cast<std::string::value_type>( val ) );
-            ++it;
-        }
-        else
-            res.push_back( *it );
-    }
+    decodeInto( res, str.data(), str.data() + str.size() );
     return res;
 }
 
-std::string encode( const std::string& str )
+const std::string& encode( const std::string& str, std::string& buffer )
 {
-    auto parts = split( str );
-    std::string res{};
-    res.reserve( str.length() );
+    assert( &str != &buffer );
+    auto schemePos = str.find( "://" );
     /*
      * If the file is a local path, we need to encode everything as the
      * characters won't have any URL related meaning
      */
-    if ( parts.scheme == "file" || parts.scheme.empty() == true )
+    if ( schemePos == std::string::npos ||
+         str.compare( 0, schemePos, "file" ) == 0 )
     {
-        if ( parts.scheme.empty() == false )
-            res += "file://";
-        auto pathBegin = parts.path.cbegin();
-#ifdef _WIN32
-        if ( *pathBegin == '/' && isalpha( *(pathBegin + 1) ) && *(pathBegin + 2) == ':' )
-        {
-            // Don't encode the ':' after the drive letter.
-            // All other ':' need to be encoded, there are not allowed in a file path
-            // on windows, but they might appear in urls
-            std::copy( pathBegin, pathBegin + 3, std::back_inserter( res ) );
-            pathBegin += 3;
-        }
-#endif
-        encodeSegment( res, pathBegin, parts.path.cend(), nullptr );
-        return res;
+        const auto pathOffset = schemePos == std::string::npos ? 0 : schemePos + 3;
+        const auto pathBegin = str.data() + pathOffset;
+        const auto pathEnd = str.data() + str.size();
+        /* Fast path: the input is already its own encoded version */
+        if ( needsEncoding( pathBegin, pathEnd ) == false )
+            return str;
+        buffer.clear();
+        buffer.reserve( str.size() );
+        if ( schemePos != std::string::npos )
+            buffer += "file://";
+        encodeLocalPath( buffer, pathBegin, pathEnd );
+        return buffer;
+    }
+    auto parts = split( str );
+    buffer.clear();
+    buffer.reserve( str.length() );
+    if ( parts.scheme.empty() == true )
+    {
+        /* An empty scheme is handled as a local path */
+        encodeLocalPath( buffer, parts.path.data(),
+                         parts.path.data() + parts.path.size() );
+        return buffer;
     }
     /*
-     * We already accept any character in ".-_~/" through isSafe(), but we need
+     * We already accept any character in ".-_~/" for all segments, but we need
      * to accept more depending on the URL segments:
      */
-    encodeSegment( res, parts.scheme.cbegin(), parts.scheme.cend(), "+" );
-    res += "://";
+    encodeSegment( buffer, parts.scheme, Scheme );
+    buffer += "://";
     if ( parts.userInfo.empty() == false )
-    {
-        encodeSegment( res, parts.userInfo.cbegin(), parts.userInfo.cend(),
-                       "!$&'()*+,;=:" );
-    }
+        encodeSegment( buffer, parts.userInfo, UserInfo );
     if ( parts.hostMarker == true )
-        res += '@';
-    encodeSegment( res, parts.host.cbegin(), parts.host.cend(), "[]" );
+        buffer += '@';
+    encodeSegment( buffer, parts.host, Host );
     if ( parts.port.empty() == false )
     {
-        res += ':';
-        res += parts.port;
+        buffer += ':';
+        buffer += parts.port;
     }
 
-    encodeSegment( res, parts.path.cbegin(), parts.path.cend(), "!$&'()*+,;=:@" );
+    encodeSegment( buffer, parts.path, Path );
 
     if ( parts.query.empty() == false )
     {
-        res += '?';
-        encodeSegment( res, parts.query.cbegin(), parts.query.cend(),
-                       "!$&'()*+,;=:@?" );
+        buffer += '?';
+        encodeSegment( buffer, parts.query, Query );
     }
     if ( parts.fragments.empty() == false )
     {
-        res += '#';
-        encodeSegment( res, parts.query.cbegin(), parts.query.cend(),
-                       "!$&'()*+,;=:@?" );
+        buffer += '#';
+        encodeSegment( buffer, parts.query, Query );
     }
+    return buffer;
+}
+
+std::string encode( const std::string& str )
+{
+    std::string buffer;
+    const auto& res = encode( str, buffer );
+    if ( &res == &buffer )
+        return buffer;
     return res;
 }
 
@@ -289,6 +408,16 @@ std::string stripScheme( const std::string& mrl )
     return mrl.substr( pos + 3 );
 }
 
+const std::string& stripScheme( const std::string& mrl, std::string& buffer )
+{
+    assert( &mrl != &buffer );
+    auto pos = mrl.find( "://" );
+    if ( pos == std::string::npos )
+        throw fs::errors::UnhandledScheme( "<empty scheme>" );
+    buffer.assign( mrl, pos + 3, std::string::npos );
+    return buffer;
+}
+
 std::string scheme( const std::string& mrl )
 {
     auto pos = mrl.find( "://" );
@@ -299,17 +428,21 @@ std::string scheme( const std::string& mrl )
 
 #ifndef _WIN32
 
-std::string toLocalPath( const std::string& mrl )
+const std::string& toLocalPath( const std::string& mrl, std::string& buffer )
 {
+    assert( &mrl != &buffer );
     if ( mrl.compare( 0, 7, "file://" ) != 0 )
         throw fs::errors::UnhandledScheme( scheme( mrl ) );
-    return utils::url::decode( mrl.substr( 7 ) );
+    buffer.clear();
+    decodeInto( buffer, mrl.data() + 7, mrl.data() + mrl.size() );
+    return buffer;
 }
 
 #else
 
-std::string toLocalPath( const std::string& mrl )
+const std::string& toLocalPath( const std::string& mrl, std::string& buffer )
 {
+    assert( &mrl != &buffer );
     if ( mrl.compare( 0, 7, "file://" ) != 0 )
         throw fs::errors::UnhandledScheme( utils::url::scheme( mrl ) );
     auto localPath = mrl.substr( 7 );
@@ -322,11 +455,20 @@ std::string toLocalPath( const std::string& mrl )
     if ( localPath[0] == '/' && isalpha( localPath[1] ) )
         localPath.erase( 0, 1 );
     std::replace( begin( localPath ), end( localPath ), '/', '\\' );
-    return utils::url::decode( localPath );
+    buffer.clear();
+    decodeInto( buffer, localPath.data(), localPath.data() + localPath.size() );
+    return buffer;
 }
 
 #endif
 
+std::string toLocalPath( const std::string& mrl )
+{
+    std::string res;
+    toLocalPath( mrl, res );
+    return res;
+}
+
 bool schemeIs( const std::string& scheme, const std::string& mrl )
 {
     return mrl.compare( 0, scheme.size(), scheme ) == 0;
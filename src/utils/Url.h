@@ -34,6 +34,31 @@ namespace url
 std::string decode( const std::string& str );
 std::string encode( const std::string& str );
 
+/**
+ * @brief decode Decodes an URL without allocating when possible
+ * @param str The string to decode
+ * @param buffer A caller provided buffer, which can be reused across calls
+ * @return A reference to the decoded string, which is either str itself if it
+ *         didn't contain any escaped character, or buffer.
+ *
+ * Since the returned value may reference the input, str must outlive it.
+ * str and buffer must not be the same object.
+ */
+const std::string& decode( const std::string& str, std::string& buffer );
+
+/**
+ * @brief encode Encodes an URL without allocating when possible
+ * @param str The string to encode
+ * @param buffer A caller provided buffer, which can be reused across calls
+ * @return A reference to the encoded string, which is either str itself if it
+ *         is a local path or MRL that doesn't need escaping, or buffer.
+ *
+ * Since the returned value may reference the input, str must outlive it.
+ * str and buffer must not be the same object, as the buffer is cleared before
+ * the input is read.
+ */
+const std::string& encode( const std::string& str, std::string& buffer );
+
 /**
  * @brief path Returns the MRL path, ie. the mrl without the host and scheme parts
  * @param mrl The MRL to remove the host from
@@ -49,6 +74,14 @@ std::string path( const std::string& mrl );
  */
 std::string stripScheme( const std::string& mrl );
 
+/**
+ * @brief stripScheme Remove the scheme from a MRL in a caller provided buffer
+ * @return A reference to buffer
+ *
+ * mrl and buffer must not be the same object.
+ */
+const std::string& stripScheme( const std::string& mrl, std::string& buffer );
+
 /**
  * @brief scheme Returns the scheme used in an MRL
  * ie. for seaOtter://foo.bar it will return seaOtter://
@@ -61,6 +94,14 @@ std::string  scheme( const std::string& mrl );
  */
 std::string  toLocalPath( const std::string& mrl );
 
+/**
+ * @brief toLocalPath Converts an MRL to a local path in a caller provided buffer
+ * @return A reference to buffer
+ *
+ * mrl and buffer must not be the same object.
+ */
+const std::string& toLocalPath( const std::string& mrl, std::string& buffer );
+
 /**
  * @brief schemeIs Check if a mrl start with a specific scheme
  */
@@ -87,6 +128,14 @@ struct parts
  */
 parts split( const std::string& url );
 
+/**
+ * @brief split Splits an URL in a caller provided parts struct
+ *
+ * This reuses the output strings storage, which is useful when splitting
+ * many URLs in a row.
+ */
+void split( const std::string& url, parts& output );
+
 }
 }
 }
@@ -24,15 +24,37 @@
 # include "config.h"
 #endif
 
+#include <cstdlib>
 #include <string>
 
 #include "utils/Strings.h"
 
+namespace utf8 = medialibrary::utils::str::utf8;
+
+/*
+ * Checks that the vectorized UTF-8 helpers always return the same results as
+ * their byte per byte reference implementations
+ */
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     auto buff = reinterpret_cast<const char*>(data);
 
     std::string strBuffer{ buff, size };
-    medialibrary::utils::str::utf8::nbChars( strBuffer );
+    if ( utf8::nbChars( strBuffer ) != utf8::scalar::nbChars( strBuffer ) )
+        abort();
+
+    auto offset = size > 0 ? data[0] % ( size + 1 ) : 0;
+    auto nbChars = size > 1 ? data[1] : 0;
+    if ( utf8::nbBytes( strBuffer, offset, nbChars ) !=
+         utf8::scalar::nbBytes( strBuffer, offset, nbChars ) )
+        abort();
+
+    std::string lhs{ buff, size / 2 };
+    std::string rhs{ buff + size / 2, size - size / 2 };
+    auto lhsOffset = lhs.empty() == false ? data[0] % lhs.size() : 0;
+    auto rhsOffset = rhs.empty() == false ? data[size / 2] % rhs.size() : 0;
+    if ( utf8::commonPattern( lhs, lhsOffset, rhs, rhsOffset, 0 ) !=
+         utf8::scalar::commonPattern( lhs, lhsOffset, rhs, rhsOffset, 0 ) )
+        abort();
     return 0;
 }
 
@@ -1005,6 +1005,74 @@ static void Public( Tests* T )
     ASSERT_TRUE( tracks[0]->isPublic() );
 }
 
+static void PublicSort( Tests* T )
+{
+    auto big = T->ml->createAlbum( "Big" );
+    std::vector<std::shared_ptr<Media>> bigTracks;
+    for ( auto i = 0u; i < 3; ++i )
+    {
+        auto m = std::static_pointer_cast<Media>(
+                    T->ml->addMedia( "big" + std::to_string( i ) + ".mp3",
+                                     IMedia::Type::Audio ) );
+        m->setDuration( 1000 );
+        big->addTrack( m, i + 1, 0, 0, nullptr );
+        bigTracks.push_back( std::move( m ) );
+    }
+    auto small = T->ml->createAlbum( "Small" );
+    for ( auto i = 0u; i < 2; ++i )
+    {
+        auto m = std::static_pointer_cast<Media>(
+                    T->ml->addMedia( "small" + std::to_string( i ) + ".mp3",
+                                     IMedia::Type::Audio ) );
+        m->setDuration( 600 );
+        small->addTrack( m, i + 1, 0, 0, nullptr );
+        T->ml->markMediaAsPublic( m->id() );
+    }
+    T->ml->markMediaAsPublic( bigTracks[0]->id() );
+
+    /* Most tracks first */
+    QueryParameters params{ SortingCriteria::TrackNumber, false };
+    auto albums = T->ml->albums( &params )->all();
+    ASSERT_EQ( 2u, albums.size() );
+    ASSERT_EQ( big->id(), albums[0]->id() );
+    ASSERT_EQ( small->id(), albums[1]->id() );
+
+    /* Only the public tracks are accounted for when listing public albums */
+    params.publicOnly = true;
+    albums = T->ml->albums( &params )->all();
+    ASSERT_EQ( 2u, albums.size() );
+    ASSERT_EQ( small->id(), albums[0]->id() );
+    ASSERT_EQ( big->id(), albums[1]->id() );
+
+    params.sort = SortingCriteria::Duration;
+    albums = T->ml->albums( &params )->all();
+    ASSERT_EQ( 2u, albums.size() );
+    ASSERT_EQ( big->id(), albums[0]->id() );
+    ASSERT_EQ( small->id(), albums[1]->id() );
+
+    params.publicOnly = false;
+    albums = T->ml->albums( &params )->all();
+    ASSERT_EQ( 2u, albums.size() );
+    ASSERT_EQ( small->id(), albums[0]->id() );
+    ASSERT_EQ( big->id(), albums[1]->id() );
+
+    /* The aggregates must follow the track updates & removals */
+    bigTracks[0]->setDuration( 100 );
+    params.publicOnly = true;
+    params.desc = true;
+    albums = T->ml->albums( &params )->all();
+    ASSERT_EQ( 2u, albums.size() );
+    ASSERT_EQ( small->id(), albums[0]->id() );
+    ASSERT_EQ( big->id(), albums[1]->id() );
+
+    T->ml->deleteMedia( bigTracks[0]->id() );
+    albums = T->ml->albums( &params )->all();
+    ASSERT_EQ( 1u, albums.size() );
+    ASSERT_EQ( small->id(), albums[0]->id() );
+    params.publicOnly = false;
+    ASSERT_EQ( 2u, T->ml->albums( &params )->count() );
+}
+
 static void Favorite( Tests* T )
 {
     auto a = T->ml->createAlbum( "Album" );
@@ -1040,6 +1108,33 @@ static void Favorite( Tests* T )
     ASSERT_EQ(vec[1]->id(), a3->id());
 }
 
+static void Page( Tests* T )
+{
+    std::vector<AlbumPtr> albums;
+    for ( auto i = 0u; i < 3; ++i )
+    {
+        auto album = T->ml->createAlbum( "album " + std::to_string( i ) );
+        auto m = std::static_pointer_cast<Media>(
+                    T->ml->addMedia( "media" + std::to_string( i ) + ".mp3",
+                                     IMedia::Type::Audio ) );
+        album->addTrack( m, 1, 0, 0, nullptr );
+        albums.push_back( std::move( album ) );
+    }
+    QueryParameters params{ SortingCriteria::Alpha, false };
+    auto page = T->ml->albums( &params )->page( 2, 1 );
+    ASSERT_EQ( 3u, page.count );
+    ASSERT_EQ( 2u, page.items.size() );
+    ASSERT_EQ( albums[1]->id(), page.items[0]->id() );
+    ASSERT_EQ( "album 1", page.items[0]->title() );
+    ASSERT_EQ( 1u, page.items[0]->nbTracks() );
+    ASSERT_EQ( albums[2]->id(), page.items[1]->id() );
+    ASSERT_EQ( "album 2", page.items[1]->title() );
+
+    page = T->ml->albums( &params )->page( 2, 3 );
+    ASSERT_EQ( 3u, page.count );
+    ASSERT_EQ( 0u, page.items.size() );
+}
+
 int main( int ac, char** av )
 {
     INIT_TESTS( Album )
@@ -1077,7 +1172,9 @@ int main( int ac, char** av )
     ADD_TEST( SortByInsertionDate );
     ADD_TEST( ConvertToExternal );
     ADD_TEST( Public );
+    ADD_TEST( PublicSort );
     ADD_TEST( Favorite );
+    ADD_TEST( Page );
 
     END_TESTS
 }
@@ -29,6 +29,8 @@
 #include "Artist.h"
 #include "Album.h"
 #include "Media.h"
+#include "MediaAggregate.h"
+#include "database/SqliteTools.h"
 
 static void Create( Tests* T )
 {
@@ -887,6 +889,60 @@ static void Public( Tests* T )
     auto tracks = tracksQuery->all();
     ASSERT_EQ( 1u, tracks.size() );
     ASSERT_TRUE( tracks[0]->isPublic() );
+
+    /* The same goes for the artists returned by a public search */
+    artists = T->ml->searchArtists( "cepheide", ArtistIncluded::All, &params )->all();
+    ASSERT_EQ( 1u, artists.size() );
+    ASSERT_EQ( 0u, artists[0]->nbTracks() );
+    ASSERT_EQ( 1u, artists[0]->tracks( nullptr )->count() );
+}
+
+static void LastInsertionDate( Tests* T )
+{
+    auto a = T->ml->createArtist( "artist" );
+    auto album = T->ml->createAlbum( "album" );
+    ASSERT_NON_NULL( a );
+    ASSERT_NON_NULL( album );
+    auto m1 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "track1.mp3", IMedia::Type::Audio ) );
+    auto m2 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "track2.mp3", IMedia::Type::Audio ) );
+    ASSERT_NON_NULL( m1 );
+    ASSERT_NON_NULL( m2 );
+    auto res = album->addTrack( m1, 1, 1, a->id(), nullptr );
+    ASSERT_TRUE( res );
+    res = a->addMedia( *m1 );
+    ASSERT_TRUE( res );
+    res = album->addTrack( m2, 2, 1, a->id(), nullptr );
+    ASSERT_TRUE( res );
+    res = a->addMedia( *m2 );
+    ASSERT_TRUE( res );
+    res = T->ml->setMediaInsertionDate( m1->id(), 100 );
+    ASSERT_TRUE( res );
+    res = T->ml->setMediaInsertionDate( m2->id(), 200 );
+    ASSERT_TRUE( res );
+
+    auto lastInsertionDate = [T, &a]() {
+        OPEN_READ_CONTEXT( ctx, T->ml->getConn() );
+        int64_t date;
+        medialibrary::sqlite::Statement stmt{
+            "SELECT last_insertion_date FROM " + MediaAggregate::Table::Name +
+                " WHERE entity_type = ? AND entity_id = ?"
+        };
+        stmt.execute( MediaAggregate::EntityType::Artist, a->id() );
+        stmt.row() >> date;
+        return date;
+    };
+    ASSERT_EQ( 200, lastInsertionDate() );
+
+    /* Moving the latest media back in time must lower the date */
+    res = T->ml->setMediaInsertionDate( m2->id(), 150 );
+    ASSERT_TRUE( res );
+    ASSERT_EQ( 150, lastInsertionDate() );
+
+    /* So does removing it */
+    T->ml->deleteMedia( m2->id() );
+    ASSERT_EQ( 100, lastInsertionDate() );
 }
 
 static void Favorite( Tests* T )
@@ -928,6 +984,32 @@ static void Favorite( Tests* T )
     ASSERT_EQ( r[0]->id(), a2->id() );
 }
 
+static void Page( Tests* T )
+{
+    std::vector<ArtistPtr> artists;
+    for ( auto i = 0u; i < 3; ++i )
+    {
+        auto artist = T->ml->createArtist( "artist " + std::to_string( i ) );
+        auto album = T->ml->createAlbum( "album " + std::to_string( i ) );
+        auto m = std::static_pointer_cast<Media>(
+                    T->ml->addMedia( "media" + std::to_string( i ) + ".mp3",
+                                     IMedia::Type::Audio ) );
+        album->addTrack( m, 1, 0, artist->id(), nullptr );
+        album->setAlbumArtist( artist );
+        artist->addMedia( *m );
+        artists.push_back( std::move( artist ) );
+    }
+    QueryParameters params{ SortingCriteria::Alpha, false };
+    auto page = T->ml->artists( ArtistIncluded::All, &params )->page( 2, 1 );
+    ASSERT_EQ( 3u, page.count );
+    ASSERT_EQ( 2u, page.items.size() );
+    ASSERT_EQ( artists[1]->id(), page.items[0]->id() );
+    ASSERT_EQ( "artist 1", page.items[0]->name() );
+    ASSERT_EQ( 1u, page.items[0]->nbAlbums() );
+    ASSERT_EQ( artists[2]->id(), page.items[1]->id() );
+    ASSERT_EQ( "artist 2", page.items[1]->name() );
+}
+
 int main( int ac, char** av )
 {
     INIT_TESTS( Artist )
@@ -961,7 +1043,9 @@ int main( int ac, char** av )
     ADD_TEST( SortByNbTracks );
     ADD_TEST( SortByLastPlayedDate );
     ADD_TEST( Public );
+    ADD_TEST( LastInsertionDate );
     ADD_TEST( Favorite );
+    ADD_TEST( Page );
 
     END_TESTS
 }
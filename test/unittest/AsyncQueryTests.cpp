@@ -0,0 +1,308 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "UnitTests.h"
+
+#include "compat/Mutex.h"
+#include "compat/ConditionVariable.h"
+#include "database/SqliteQuery.h"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace
+{
+
+/* Collects the asynchronous results, which are delivered on another thread */
+template <typename T>
+class Results
+{
+public:
+    std::function<void( bool, T )> callback()
+    {
+        return [this]( bool success, T res ) {
+            std::lock_guard<compat::Mutex> lock{ m_mutex };
+            m_results.push_back( std::move( res ) );
+            m_success.push_back( success );
+            m_cond.notify_all();
+        };
+    }
+
+    bool wait( size_t nbResults )
+    {
+        std::unique_lock<compat::Mutex> lock{ m_mutex };
+        return m_cond.wait_for( lock, std::chrono::seconds{ 5 },
+                                [this, nbResults]() {
+            return m_results.size() >= nbResults;
+        });
+    }
+
+    std::vector<T> results()
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        return m_results;
+    }
+
+    bool succeeded( size_t idx )
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        return m_success.at( idx );
+    }
+
+private:
+    compat::Mutex m_mutex;
+    compat::ConditionVariable m_cond;
+    std::vector<T> m_results;
+    std::vector<bool> m_success;
+};
+
+/* Keeps the reader thread busy until released */
+class Blocker
+{
+public:
+    Blocker() : m_started( false ), m_released( false ) {}
+
+    void block()
+    {
+        std::unique_lock<compat::Mutex> lock{ m_mutex };
+        m_started = true;
+        m_cond.notify_all();
+        m_cond.wait( lock, [this]() { return m_released; } );
+    }
+
+    IQuery<IMedia>::CountCb callback()
+    {
+        return [this]( bool, size_t ) {
+            block();
+        };
+    }
+
+    bool waitStarted()
+    {
+        std::unique_lock<compat::Mutex> lock{ m_mutex };
+        return m_cond.wait_for( lock, std::chrono::seconds{ 5 },
+                                [this]() { return m_started; } );
+    }
+
+    void release()
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_released = true;
+        m_cond.notify_all();
+    }
+
+private:
+    compat::Mutex m_mutex;
+    compat::ConditionVariable m_cond;
+    bool m_started;
+    bool m_released;
+};
+
+}
+
+class AsyncQueryTests : public Tests
+{
+    virtual void InstantiateMediaLibrary( const std::string& dbPath,
+                                          const std::string& mlFolderDir,
+                                          const SetupConfig* cfg ) override
+    {
+        auto config = *cfg;
+        /* Use a single reader to be able to control the requests ordering */
+        config.nbAsyncQueryThreads = 1;
+        Tests::InstantiateMediaLibrary( dbPath, mlFolderDir, &config );
+    }
+
+public:
+    void addMedia( uint32_t nbMedia )
+    {
+        for ( auto i = 0u; i < nbMedia; ++i )
+        {
+            auto m = ml->addMedia( "media" + std::to_string( i ) + ".mkv",
+                                   IMedia::Type::Video );
+            ASSERT_NON_NULL( m );
+        }
+    }
+};
+
+static void Items( AsyncQueryTests* T )
+{
+    T->addMedia( 5 );
+    auto query = T->ml->videoFiles( nullptr );
+    auto expected = query->items( 2, 1 );
+    ASSERT_EQ( 2u, expected.size() );
+
+    Results<IQuery<IMedia>::Result> results;
+    query->itemsAsync( 2, 1, results.callback() );
+    ASSERT_TRUE( results.wait( 1 ) );
+    auto res = results.results()[0];
+    ASSERT_TRUE( results.succeeded( 0 ) );
+    ASSERT_EQ( 2u, res.size() );
+    ASSERT_EQ( expected[0]->id(), res[0]->id() );
+    ASSERT_EQ( expected[1]->id(), res[1]->id() );
+
+    query->allAsync( results.callback() );
+    ASSERT_TRUE( results.wait( 2 ) );
+    ASSERT_EQ( 5u, results.results()[1].size() );
+
+    Results<size_t> count;
+    query->countAsync( count.callback() );
+    ASSERT_TRUE( count.wait( 1 ) );
+    ASSERT_EQ( 5u, count.results()[0] );
+}
+
+static void QueryLifetime( AsyncQueryTests* T )
+{
+    T->addMedia( 3 );
+    Results<IQuery<IMedia>::Result> results;
+    {
+        auto query = T->ml->videoFiles( nullptr );
+        query->itemsAsync( 10, 0, results.callback() );
+    }
+    ASSERT_TRUE( results.wait( 1 ) );
+    ASSERT_EQ( 3u, results.results()[0].size() );
+}
+
+static void Coalesce( AsyncQueryTests* T )
+{
+    T->addMedia( 3 );
+    Blocker blocker;
+    T->ml->audioFiles( nullptr )->countAsync( blocker.callback() );
+    ASSERT_TRUE( blocker.waitStarted() );
+
+    /* Those requests are queued behind the blocked one */
+    Results<IQuery<IMedia>::Result> results;
+    auto query = T->ml->videoFiles( nullptr );
+    query->itemsAsync( 10, 0, results.callback() );
+    query->itemsAsync( 10, 0, results.callback() );
+    T->ml->videoFiles( nullptr )->itemsAsync( 10, 0, results.callback() );
+    /* A different page or sorting is a different request */
+    query->itemsAsync( 1, 0, results.callback() );
+    QueryParameters params{};
+    params.desc = true;
+    T->ml->videoFiles( &params )->itemsAsync( 10, 0, results.callback() );
+    blocker.release();
+
+    ASSERT_TRUE( results.wait( 5 ) );
+    auto res = results.results();
+    ASSERT_EQ( 5u, res.size() );
+    /* The coalesced requests share the same result */
+    ASSERT_EQ( 3u, res[0].size() );
+    ASSERT_EQ( 3u, res[1].size() );
+    ASSERT_EQ( 3u, res[2].size() );
+    ASSERT_EQ( res[0][0], res[1][0] );
+    ASSERT_EQ( res[0][0], res[2][0] );
+    ASSERT_EQ( 1u, res[3].size() );
+    ASSERT_NE( res[0][0], res[3][0] );
+    ASSERT_EQ( 3u, res[4].size() );
+    ASSERT_NE( res[0][0], res[4][2] );
+    ASSERT_EQ( res[0][0]->id(), res[4][2]->id() );
+}
+
+static void Cancel( AsyncQueryTests* T )
+{
+    T->addMedia( 3 );
+    Blocker blocker;
+    T->ml->audioFiles( nullptr )->countAsync( blocker.callback() );
+    ASSERT_TRUE( blocker.waitStarted() );
+
+    Results<size_t> cancelled;
+    Results<size_t> results;
+    auto query = T->ml->videoFiles( nullptr );
+    CancellationToken token;
+    query->countAsync( cancelled.callback(), token );
+    query->countAsync( results.callback() );
+    Results<IQuery<IMedia>::Result> cancelledItems;
+    CancellationToken token2;
+    query->itemsAsync( 10, 0, cancelledItems.callback(), token2 );
+    token.cancel();
+    token2.cancel();
+    blocker.release();
+
+    ASSERT_TRUE( results.wait( 1 ) );
+    /* Ensure the reader is done with the cancelled request */
+    query->countAsync( results.callback() );
+    ASSERT_TRUE( results.wait( 2 ) );
+    ASSERT_EQ( 3u, results.results()[0] );
+    ASSERT_TRUE( cancelled.results().empty() );
+    ASSERT_TRUE( cancelledItems.results().empty() );
+}
+
+using TestJob = SqliteAsyncJob<size_t, std::tuple<>>;
+
+static void NoCoalesceWithRunning( AsyncQueryTests* T )
+{
+    Blocker blocker;
+    std::atomic_uint nbExecuted{ 0 };
+    auto exec = [&blocker, &nbExecuted]( const std::tuple<>& ) -> size_t {
+        if ( nbExecuted.fetch_add( 1 ) == 0 )
+            blocker.block();
+        return nbExecuted.load();
+    };
+    Results<size_t> results;
+    auto& executor = T->ml->asyncQueryExecutor();
+    executor.submit( std::make_shared<TestJob>( "job", std::tuple<>{}, exec,
+                                                results.callback(),
+                                                CancellationToken{} ) );
+    ASSERT_TRUE( blocker.waitStarted() );
+
+    /* The running request might have read the database already */
+    executor.submit( std::make_shared<TestJob>( "job", std::tuple<>{}, exec,
+                                                results.callback(),
+                                                CancellationToken{} ) );
+    blocker.release();
+    ASSERT_TRUE( results.wait( 2 ) );
+    ASSERT_EQ( 2u, nbExecuted.load() );
+    ASSERT_EQ( 2u, results.results()[1] );
+}
+
+static void Failure( AsyncQueryTests* T )
+{
+    auto exec = []( const std::tuple<>& ) -> size_t {
+        throw std::runtime_error( "Request failed" );
+    };
+    Results<size_t> results;
+    T->ml->asyncQueryExecutor().submit(
+                std::make_shared<TestJob>( "failure", std::tuple<>{}, exec,
+                                           results.callback(),
+                                           CancellationToken{} ) );
+    ASSERT_TRUE( results.wait( 1 ) );
+    ASSERT_FALSE( results.succeeded( 0 ) );
+    ASSERT_EQ( 0u, results.results()[0] );
+}
+
+int main( int ac, char** av )
+{
+    INIT_TESTS_C( AsyncQueryTests );
+
+    ADD_TEST( Items );
+    ADD_TEST( QueryLifetime );
+    ADD_TEST( Coalesce );
+    ADD_TEST( Cancel );
+    ADD_TEST( NoCoalesceWithRunning );
+    ADD_TEST( Failure );
+
+    END_TESTS;
+}
@@ -122,6 +122,26 @@ static void UnlinkExternalTrack( Tests* T )
     ASSERT_EQ( 0u, tracks.size() );
 }
 
+static void Page( Tests* T )
+{
+    auto f = std::static_pointer_cast<Media>( T->ml->addMedia( "file.mp3", IMedia::Type::Audio ) );
+    f->addAudioTrack( "PCM", 128, 44100, 2, "en", "test desc", 0 );
+    f->addAudioTrack( "WMA", 256, 48000, 6, "fr", "test desc 2", 0 );
+
+    auto expected = f->audioTracks()->all();
+    auto page = f->audioTracks()->page( 1, 1 );
+    ASSERT_EQ( 2u, page.count );
+    ASSERT_EQ( 1u, page.items.size() );
+    auto t = page.items[0];
+    ASSERT_EQ( expected[1]->id(), t->id() );
+    ASSERT_EQ( t->codec(), "WMA" );
+    ASSERT_EQ( t->sampleRate(), 48000u );
+    ASSERT_EQ( t->bitrate(), 256u );
+    ASSERT_EQ( t->nbChannels(), 6u );
+    ASSERT_EQ( t->language(), "fr" );
+    ASSERT_EQ( t->description(), "test desc 2" );
+}
+
 int main( int ac, char** av )
 {
     INIT_TESTS(AudioTrack)
@@ -132,6 +152,7 @@ int main( int ac, char** av )
     ADD_TEST( RemoveTracks );
     ADD_TEST( CheckDbModel );
     ADD_TEST( UnlinkExternalTrack );
+    ADD_TEST( Page );
 
     END_TESTS
 }
@@ -0,0 +1,257 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "UnitTests.h"
+
+#include "CacheEvictor.h"
+#include "File.h"
+#include "Media.h"
+#include "Subscription.h"
+
+namespace
+{
+
+CacheEvictor::Entry entry( int64_t fileId, uint64_t size, time_t insertionDate,
+                           time_t lastPlayedDate = 0, uint32_t playCount = 0,
+                           bool inProgress = false )
+{
+    return CacheEvictor::Entry{ fileId, "file:///cache/" + std::to_string( fileId ),
+                                size, insertionDate, lastPlayedDate, playCount,
+                                inProgress };
+}
+
+std::vector<int64_t> victimIds( const CacheEvictor& evictor, uint64_t nbBytes,
+                                uint32_t nbFiles,
+                                const CacheEvictor::Filter& filter = nullptr )
+{
+    std::vector<CacheEvictor::Entry> victims;
+    evictor.selectVictims( nbBytes, nbFiles, filter, victims );
+    std::vector<int64_t> ids;
+    for ( const auto& v : victims )
+        ids.push_back( v.fileId );
+    return ids;
+}
+
+}
+
+static void LeastRecentlyPlayed( Tests* )
+{
+    CacheEvictor evictor{ CacheEvictionPolicy::LeastRecentlyPlayed };
+    evictor.insert( entry( 1, 100, 1000 ) );
+    evictor.insert( entry( 2, 100, 2000 ) );
+    /* Cached first, but played recently */
+    evictor.insert( entry( 3, 100, 500, 3000, 1 ) );
+    evictor.insert( entry( 4, 100, 1500 ) );
+    ASSERT_EQ( 4u, evictor.nbFiles() );
+    ASSERT_EQ( 400u, evictor.totalSize() );
+
+    auto ids = victimIds( evictor, 150, 0 );
+    ASSERT_EQ( 2u, ids.size() );
+    ASSERT_EQ( 1, ids[0] );
+    ASSERT_EQ( 4, ids[1] );
+
+    ids = victimIds( evictor, 0, 4 );
+    ASSERT_EQ( 4u, ids.size() );
+    ASSERT_EQ( 3, ids[3] );
+
+    /* Selecting victims doesn't remove them */
+    ASSERT_EQ( 4u, evictor.nbFiles() );
+    auto res = evictor.evicted( 1 );
+    ASSERT_TRUE( res );
+    res = evictor.evicted( 1 );
+    ASSERT_FALSE( res );
+    ASSERT_EQ( 300u, evictor.totalSize() );
+
+    std::vector<CacheEvictor::Entry> victims;
+    res = evictor.selectVictims( 1000, 0, nullptr, victims );
+    ASSERT_FALSE( res );
+    ASSERT_EQ( 3u, victims.size() );
+}
+
+static void SizeAware( Tests* )
+{
+    const uint64_t MiB = 1024 * 1024;
+    CacheEvictor evictor{ CacheEvictionPolicy::SizeAware };
+    evictor.insert( entry( 1, 10 * MiB, 1000 ) );
+    evictor.insert( entry( 2, 100 * MiB, 2000 ) );
+    /* As large as #2, but played often */
+    evictor.insert( entry( 3, 100 * MiB, 3000, 4000, 10 ) );
+
+    auto ids = victimIds( evictor, 0, 3 );
+    ASSERT_EQ( 3u, ids.size() );
+    ASSERT_EQ( 2, ids[0] );
+    ASSERT_EQ( 1, ids[1] );
+    ASSERT_EQ( 3, ids[2] );
+
+    /*
+     * Once some files were evicted, the new files get a priority boost so the
+     * files that weren't used in a while end up being evicted, even if they
+     * used to be played often
+     */
+    evictor.evicted( 2 );
+    evictor.evicted( 1 );
+    evictor.insert( entry( 4, 10 * MiB, 5000 ) );
+    ids = victimIds( evictor, 0, 2 );
+    ASSERT_EQ( 2u, ids.size() );
+    ASSERT_EQ( 3, ids[0] );
+    ASSERT_EQ( 4, ids[1] );
+}
+
+static void PlayedFirst( Tests* )
+{
+    CacheEvictor evictor{ CacheEvictionPolicy::PlayedFirst };
+    evictor.insert( entry( 1, 100, 1000 ) );
+    /* Played until the end */
+    evictor.insert( entry( 2, 100, 2000, 5000, 1 ) );
+    /* Currently being played */
+    evictor.insert( entry( 3, 100, 3000, 4000, 1, true ) );
+    evictor.insert( entry( 4, 100, 1500, 2500, 2 ) );
+
+    auto ids = victimIds( evictor, 0, 4 );
+    ASSERT_EQ( 4u, ids.size() );
+    ASSERT_EQ( 4, ids[0] );
+    ASSERT_EQ( 2, ids[1] );
+    ASSERT_EQ( 1, ids[2] );
+    ASSERT_EQ( 3, ids[3] );
+
+    /* Changing the policy reorders the tracked files */
+    evictor.setPolicy( CacheEvictionPolicy::LeastRecentlyPlayed );
+    ids = victimIds( evictor, 0, 1 );
+    ASSERT_EQ( 1u, ids.size() );
+    ASSERT_EQ( 1, ids[0] );
+}
+
+static void Refresh( Tests* )
+{
+    CacheEvictor evictor{ CacheEvictionPolicy::PlayedFirst };
+    evictor.reset( { entry( 1, 100, 1000 ), entry( 2, 100, 2000 ) } );
+
+    auto ids = victimIds( evictor, 0, 1 );
+    ASSERT_EQ( 1, ids[0] );
+
+    /* #2 got played until its end, unknown files are ignored */
+    evictor.refresh( { entry( 2, 100, 2000, 3000, 1 ), entry( 3, 100, 1000 ) } );
+    ASSERT_EQ( 2u, evictor.nbFiles() );
+    ids = victimIds( evictor, 0, 1 );
+    ASSERT_EQ( 2, ids[0] );
+
+    auto res = evictor.remove( 2 );
+    ASSERT_TRUE( res );
+    ids = victimIds( evictor, 0, 2 );
+    ASSERT_EQ( 1u, ids.size() );
+    ASSERT_EQ( 1, ids[0] );
+}
+
+static void Filter( Tests* )
+{
+    CacheEvictor evictor{ CacheEvictionPolicy::LeastRecentlyPlayed };
+    for ( auto i = 1; i <= 6; ++i )
+        evictor.insert( entry( i, 100, 1000 * i ) );
+
+    auto evenOnly = []( const CacheEvictor::Entry& e ) {
+        return e.fileId % 2 == 0;
+    };
+    auto ids = victimIds( evictor, 150, 0, evenOnly );
+    ASSERT_EQ( 2u, ids.size() );
+    ASSERT_EQ( 2, ids[0] );
+    ASSERT_EQ( 4, ids[1] );
+
+    /* Both the number of files and number of bytes must be reclaimed */
+    ids = victimIds( evictor, 100, 3, evenOnly );
+    ASSERT_EQ( 3u, ids.size() );
+    ASSERT_EQ( 6, ids[2] );
+
+    std::vector<CacheEvictor::Entry> victims;
+    auto res = evictor.selectVictims( 0, 4, evenOnly, victims );
+    ASSERT_FALSE( res );
+}
+
+static void FetchCachedFiles( Tests* T )
+{
+    auto s = Subscription::create( T->ml.get(), IService::Type::Podcast,
+                                   "collection", "artwork", 0 );
+    ASSERT_NON_NULL( s );
+    auto m1 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media1.mkv", IMedia::Type::Video ) );
+    auto m2 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media2.mkv", IMedia::Type::Video ) );
+    auto m3 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media3.mkv", IMedia::Type::Video ) );
+    ASSERT_NON_NULL( m1 );
+    ASSERT_NON_NULL( m2 );
+    ASSERT_NON_NULL( m3 );
+    s->addMedia( *m1 );
+    s->addMedia( *m2 );
+
+    auto res = m1->cache( "file:///cache/media1.mkv", IFile::CacheType::Automatic, 123 );
+    ASSERT_TRUE( res );
+    res = m2->cache( "file:///cache/media2.mkv", IFile::CacheType::Manual, 456 );
+    ASSERT_TRUE( res );
+    res = m3->cache( "file:///cache/media3.mkv", IFile::CacheType::Manual, 789 );
+    ASSERT_TRUE( res );
+    auto progress = m3->setLastPosition( 0.5f );
+    ASSERT_EQ( IMedia::ProgressResult::AsIs, progress );
+
+    auto entries = CacheEvictor::fetchCachedFiles( T->ml.get() );
+    ASSERT_EQ( 3u, entries.size() );
+    std::sort( begin( entries ), end( entries ),
+               []( const CacheEvictor::Entry& l, const CacheEvictor::Entry& r ) {
+        return l.fileId < r.fileId;
+    });
+    auto f1 = m1->mainFile();
+    ASSERT_EQ( f1->id(), entries[0].fileId );
+    ASSERT_EQ( "file:///cache/media1.mkv", entries[0].mrl );
+    ASSERT_EQ( 123u, entries[0].size );
+    ASSERT_FALSE( entries[0].inProgress );
+    ASSERT_EQ( 456u, entries[1].size );
+    ASSERT_TRUE( entries[2].inProgress );
+    ASSERT_NE( 0, entries[2].lastPlayedDate );
+
+    /* Only the automatically cached media are evictable until they get played */
+    auto evictable = s->evictableCachedFiles();
+    ASSERT_EQ( 1u, evictable.size() );
+    ASSERT_EQ( 1u, evictable.count( f1->id() ) );
+
+    res = m2->markAsPlayed();
+    ASSERT_TRUE( res );
+    evictable = s->evictableCachedFiles();
+    ASSERT_EQ( 2u, evictable.size() );
+}
+
+int main( int ac, char** av )
+{
+    INIT_TESTS( CacheEvictor );
+
+    ADD_TEST( LeastRecentlyPlayed );
+    ADD_TEST( SizeAware );
+    ADD_TEST( PlayedFirst );
+    ADD_TEST( Refresh );
+    ADD_TEST( Filter );
+    ADD_TEST( FetchCachedFiles );
+
+    END_TESTS;
+}
@@ -0,0 +1,354 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "UnitTests.h"
+
+#include "CacheManifest.h"
+#include "CacheScheduler.h"
+#include "File.h"
+#include "Media.h"
+#include "Subscription.h"
+#include "mocks/SimulatedCacher.h"
+#include "utils/File.h"
+
+#include <cstdio>
+
+namespace
+{
+
+class CacheIdleCb : public mock::NoopCallback
+{
+public:
+    CacheIdleCb() : m_idle( false ) {}
+
+    virtual void onCacheIdleChanged( bool idle ) override
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_idle = idle;
+        m_cond.notify_all();
+    }
+
+    /* Ensures the next waitIdle() waits for the worker to process a new task */
+    void prepareWait()
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_idle = false;
+    }
+
+    bool waitIdle()
+    {
+        std::unique_lock<compat::Mutex> lock{ m_mutex };
+        return m_cond.wait_for( lock, std::chrono::seconds{ 5 }, [this]() {
+            return m_idle;
+        });
+    }
+
+private:
+    compat::Mutex m_mutex;
+    compat::ConditionVariable m_cond;
+    bool m_idle;
+};
+
+bool exists( const std::string& path )
+{
+    uint64_t size;
+    time_t lastModificationDate;
+    return utils::fs::fileInfo( path, size, lastModificationDate );
+}
+
+bool touch( const std::string& path )
+{
+    auto f = fopen( path.c_str(), "wb" );
+    if ( f == nullptr )
+        return false;
+    fputs( "cached", f );
+    return fclose( f ) == 0;
+}
+
+}
+
+class CacheManifestTests : public UnitTests<CacheIdleCb>
+{
+public:
+    std::shared_ptr<mock::SimulatedCacher> cacher;
+
+private:
+    virtual void InstantiateMediaLibrary( const std::string& dbPath,
+                                          const std::string& mlFolderDir,
+                                          const SetupConfig* cfg ) override
+    {
+        auto config = *cfg;
+        cacher = std::make_shared<mock::SimulatedCacher>();
+        config.cacher = cacher;
+        UnitTests<CacheIdleCb>::InstantiateMediaLibrary( dbPath, mlFolderDir,
+                                                         &config );
+    }
+};
+
+static void Journal( CacheManifestTests* T )
+{
+    auto m = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media.mkv", IMedia::Type::Video ) );
+    ASSERT_NON_NULL( m );
+
+    auto res = CacheManifest::insertPending( T->ml.get(), "1_media.mkv" );
+    ASSERT_TRUE( res );
+    auto dirty = CacheManifest::fetchDirty( T->ml.get() );
+    ASSERT_EQ( 1u, dirty.size() );
+    ASSERT_EQ( "1_media.mkv", dirty[0].fileName );
+    ASSERT_EQ( 0, dirty[0].fileId );
+    ASSERT_EQ( CacheManifest::State::Pending, dirty[0].state );
+
+    res = m->cache( "file:///cache/1_media.mkv", IFile::CacheType::Manual, 123 );
+    ASSERT_TRUE( res );
+    auto cachedFile = std::static_pointer_cast<File>( m->mainFile() );
+    ASSERT_EQ( IFile::Type::Cache, cachedFile->type() );
+    ASSERT_EQ( "1_media.mkv", CacheManifest::fileName( cachedFile->mrl() ) );
+    res = CacheManifest::commit( T->ml.get(), "1_media.mkv", cachedFile->id(),
+                                 123, 456 );
+    ASSERT_TRUE( res );
+    ASSERT_TRUE( CacheManifest::fetchDirty( T->ml.get() ).empty() );
+
+    auto entries = CacheManifest::fetchAll( T->ml.get() );
+    ASSERT_EQ( 1u, entries.size() );
+    ASSERT_EQ( cachedFile->id(), entries[0].fileId );
+    ASSERT_EQ( 123u, entries[0].size );
+    ASSERT_EQ( 456, entries[0].lastModificationDate );
+    ASSERT_EQ( CacheManifest::State::Committed, entries[0].state );
+
+    res = CacheManifest::setState( T->ml.get(), "1_media.mkv",
+                                   CacheManifest::State::Removing );
+    ASSERT_TRUE( res );
+    dirty = CacheManifest::fetchDirty( T->ml.get() );
+    ASSERT_EQ( 1u, dirty.size() );
+    ASSERT_EQ( CacheManifest::State::Removing, dirty[0].state );
+
+    res = CacheManifest::setState( T->ml.get(), "1_media.mkv",
+                                   CacheManifest::State::Committed );
+    ASSERT_TRUE( res );
+    ASSERT_TRUE( CacheManifest::fetchDirty( T->ml.get() ).empty() );
+
+    /* Losing the cached File makes the entry stale */
+    res = m->removeCached();
+    ASSERT_TRUE( res );
+    dirty = CacheManifest::fetchDirty( T->ml.get() );
+    ASSERT_EQ( 1u, dirty.size() );
+    ASSERT_EQ( 0, dirty[0].fileId );
+    ASSERT_EQ( CacheManifest::State::Committed, dirty[0].state );
+
+    res = CacheManifest::remove( T->ml.get(), "1_media.mkv" );
+    ASSERT_TRUE( res );
+    ASSERT_TRUE( CacheManifest::fetchAll( T->ml.get() ).empty() );
+}
+
+static void Reconcile( CacheManifestTests* T )
+{
+    auto ml = T->ml.get();
+    const auto& cachePath = ml->cachePath();
+    auto m1 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media1.mkv", IMedia::Type::Video ) );
+    auto m2 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media2.mkv", IMedia::Type::Video ) );
+    auto m3 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media3.mkv", IMedia::Type::Video ) );
+    auto m4 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media4.mkv", IMedia::Type::Video ) );
+    auto m5 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media5.mkv", IMedia::Type::Video ) );
+    ASSERT_NON_NULL( m1 );
+    ASSERT_NON_NULL( m2 );
+    ASSERT_NON_NULL( m3 );
+    ASSERT_NON_NULL( m4 );
+    ASSERT_NON_NULL( m5 );
+    auto m6 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "file:///path/to/media6.mkv", IMedia::Type::Video ) );
+    ASSERT_NON_NULL( m6 );
+
+    /* A properly cached file */
+    ASSERT_TRUE( touch( cachePath + "cached.mkv" ) );
+    auto res = m1->cache( utils::file::toMrl( cachePath + "cached.mkv" ),
+                          IFile::CacheType::Manual, 6 );
+    ASSERT_TRUE( res );
+    res = CacheManifest::commit( ml, "cached.mkv", m1->mainFile()->id(), 6, 0 );
+    ASSERT_TRUE( res );
+
+    /* A file which was being removed */
+    ASSERT_TRUE( touch( cachePath + "removing.mkv" ) );
+    res = m2->cache( utils::file::toMrl( cachePath + "removing.mkv" ),
+                     IFile::CacheType::Manual, 6 );
+    ASSERT_TRUE( res );
+    res = CacheManifest::commit( ml, "removing.mkv", m2->mainFile()->id(), 6, 0 );
+    ASSERT_TRUE( res );
+    res = CacheManifest::setState( ml, "removing.mkv",
+                                   CacheManifest::State::Removing );
+    ASSERT_TRUE( res );
+
+    /* A file whose media was removed */
+    ASSERT_TRUE( touch( cachePath + "stale.mkv" ) );
+    res = m3->cache( utils::file::toMrl( cachePath + "stale.mkv" ),
+                     IFile::CacheType::Manual, 6 );
+    ASSERT_TRUE( res );
+    res = CacheManifest::commit( ml, "stale.mkv", m3->mainFile()->id(), 6, 0 );
+    ASSERT_TRUE( res );
+    ml->deleteMedia( m3->id() );
+
+    /* A file which was modified after being cached */
+    ASSERT_TRUE( touch( cachePath + "modified.mkv" ) );
+    res = m4->cache( utils::file::toMrl( cachePath + "modified.mkv" ),
+                     IFile::CacheType::Manual, 6 );
+    ASSERT_TRUE( res );
+    res = CacheManifest::commit( ml, "modified.mkv", m4->mainFile()->id(), 4, 0 );
+    ASSERT_TRUE( res );
+
+    /* A file which was removed behind our back */
+    res = m5->cache( utils::file::toMrl( cachePath + "missing.mkv" ),
+                     IFile::CacheType::Manual, 6 );
+    ASSERT_TRUE( res );
+    res = CacheManifest::commit( ml, "missing.mkv", m5->mainFile()->id(), 6, 0 );
+    ASSERT_TRUE( res );
+
+    /* A completed transfer that wasn't committed, and an interrupted one */
+    ASSERT_TRUE( touch( cachePath + "uncommitted.mkv" ) );
+    res = CacheManifest::insertPending( ml, "uncommitted.mkv" );
+    ASSERT_TRUE( res );
+    auto s = Subscription::create( ml, IService::Type::Podcast, "collection",
+                                   "artwork", 0 );
+    ASSERT_NON_NULL( s );
+    res = s->addMedia( *m6 );
+    ASSERT_TRUE( res );
+    res = s->markCacheAsHandled();
+    ASSERT_TRUE( res );
+    auto partialName = std::static_pointer_cast<File>( m6->mainFile() )->cachedFileName();
+    ASSERT_TRUE( touch( CacheScheduler::partialPath( cachePath + partialName ) ) );
+    res = CacheManifest::insertPending( ml, partialName );
+    ASSERT_TRUE( res );
+
+    /* An interrupted transfer for a media which doesn't need to be cached anymore */
+    ASSERT_TRUE( touch( CacheScheduler::partialPath( cachePath + "orphan.mkv" ) ) );
+    res = CacheManifest::insertPending( ml, "orphan.mkv" );
+    ASSERT_TRUE( res );
+
+    /* Files unknown to the manifest are left for a repair to handle */
+    ASSERT_TRUE( touch( cachePath + "untracked.mkv" ) );
+
+    /* Starting the cache worker reconciles the manifest */
+    ml->cacheNewSubscriptionMedia();
+    ASSERT_TRUE( T->cbMock->waitIdle() );
+
+    ASSERT_TRUE( exists( cachePath + "cached.mkv" ) );
+    ASSERT_FALSE( exists( cachePath + "removing.mkv" ) );
+    ASSERT_FALSE( exists( cachePath + "stale.mkv" ) );
+    ASSERT_FALSE( exists( cachePath + "uncommitted.mkv" ) );
+    ASSERT_TRUE( exists( CacheScheduler::partialPath( cachePath + partialName ) ) );
+    ASSERT_FALSE( exists( CacheScheduler::partialPath( cachePath + "orphan.mkv" ) ) );
+    ASSERT_TRUE( exists( cachePath + "untracked.mkv" ) );
+    ASSERT_FALSE( exists( cachePath + "modified.mkv" ) );
+
+    for ( auto id : { m2->id(), m4->id(), m5->id() } )
+    {
+        auto f = std::static_pointer_cast<Media>( ml->media( id ) )->mainFile();
+        ASSERT_NE( IFile::Type::Cache, f->type() );
+    }
+    /* The partial transfer is accounted for */
+    ASSERT_EQ( 12u, ml->cacheWorker().cacheSize() );
+
+    auto entries = CacheManifest::fetchAll( ml );
+    ASSERT_EQ( 2u, entries.size() );
+    std::sort( begin( entries ), end( entries ),
+               []( const CacheManifest::Entry& l, const CacheManifest::Entry& r ) {
+        return l.fileName < r.fileName;
+    });
+    /* The cached file name is prefixed with the file ID */
+    ASSERT_EQ( partialName, entries[0].fileName );
+    ASSERT_EQ( CacheManifest::State::Pending, entries[0].state );
+    ASSERT_EQ( "cached.mkv", entries[1].fileName );
+    ASSERT_EQ( CacheManifest::State::Committed, entries[1].state );
+    /* The unknown modification date was recorded */
+    ASSERT_NE( 0, entries[1].lastModificationDate );
+}
+
+static void EvictPlayed( CacheManifestTests* T )
+{
+    auto ml = T->ml.get();
+    auto s = Subscription::create( ml, IService::Type::Podcast, "collection",
+                                   "artwork", 0 );
+    ASSERT_NON_NULL( s );
+    auto res = s->setMaxCachedMedia( 2 );
+    ASSERT_TRUE( res );
+    std::shared_ptr<Media> media[3];
+    for ( auto i = 0u; i < 3; ++i )
+    {
+        auto mrl = "file:///path/to/media" + std::to_string( i + 1 ) + ".mkv";
+        media[i] = std::static_pointer_cast<Media>(
+                    ml->addMedia( mrl, IMedia::Type::Video ) );
+        ASSERT_NON_NULL( media[i] );
+        T->cacher->addSource( mrl, { std::chrono::milliseconds{ 0 }, 16, 0, 0, false } );
+    }
+    res = s->addMedia( *media[0] );
+    ASSERT_TRUE( res );
+    res = s->addMedia( *media[1] );
+    ASSERT_TRUE( res );
+
+    auto mainFile = [ml]( int64_t mediaId ) {
+        return std::static_pointer_cast<Media>( ml->media( mediaId ) )->mainFile();
+    };
+
+    T->cbMock->prepareWait();
+    ml->cacheNewSubscriptionMedia();
+    ASSERT_TRUE( T->cbMock->waitIdle() );
+    auto f1 = mainFile( media[0]->id() );
+    auto f2 = mainFile( media[1]->id() );
+    ASSERT_EQ( IFile::Type::Cache, f1->type() );
+    ASSERT_EQ( IFile::Type::Cache, f2->type() );
+
+    /*
+     * Both files were cached at the same time, so the first one would be
+     * evicted if the worker didn't pick up the play state change
+     */
+    res = media[1]->markAsPlayed();
+    ASSERT_TRUE( res );
+
+    res = s->addMedia( *media[2] );
+    ASSERT_TRUE( res );
+    T->cbMock->prepareWait();
+    ml->cacheNewSubscriptionMedia();
+    ASSERT_TRUE( T->cbMock->waitIdle() );
+
+    ASSERT_EQ( f1->id(), mainFile( media[0]->id() )->id() );
+    ASSERT_NE( IFile::Type::Cache, mainFile( media[1]->id() )->type() );
+    ASSERT_EQ( IFile::Type::Cache, mainFile( media[2]->id() )->type() );
+}
+
+int main( int ac, char** av )
+{
+    INIT_TESTS_C( CacheManifestTests );
+
+    ADD_TEST( Journal );
+    ADD_TEST( Reconcile );
+    ADD_TEST( EvictPlayed );
+
+    END_TESTS;
+}
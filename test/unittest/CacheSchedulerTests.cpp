@@ -0,0 +1,348 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "UnitTests.h"
+
+#include "CacheScheduler.h"
+#include "mocks/SimulatedCacher.h"
+#include "utils/File.h"
+#include "medialibrary/filesystem/Errors.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+
+std::string outputDir( Tests* T )
+{
+    auto dbPath = T->getDbPath();
+    return dbPath.substr( 0, dbPath.length() - strlen( "test.db" ) );
+}
+
+std::vector<CacheScheduler::Transfer> transfers( Tests* T,
+                                                 std::shared_ptr<mock::SimulatedCacher> cacher,
+                                                 int64_t groupId, uint32_t nbTransfers,
+                                                 mock::SimulatedCacher::Source source )
+{
+    std::vector<CacheScheduler::Transfer> res;
+    for ( auto i = 0u; i < nbTransfers; ++i )
+    {
+        auto name = std::to_string( groupId ) + "-" + std::to_string( i );
+        auto mrl = "http://source/" + name;
+        cacher->addSource( mrl, source );
+        res.push_back( CacheScheduler::Transfer{ groupId, i, mrl,
+                                                 outputDir( T ) + name,
+                                                 source.size } );
+    }
+    return res;
+}
+
+CacheScheduler::StartCb acceptAll()
+{
+    return []( const CacheScheduler::Transfer& ) { return true; };
+}
+
+/* A clock which jumps to the deadline instead of waiting for it */
+class SimulatedClock : public CacheScheduler::Clock
+{
+public:
+    SimulatedClock()
+        : m_now( std::chrono::hours{ 1 } )
+    {
+    }
+
+    virtual TimePoint now() override
+    {
+        return m_now;
+    }
+
+    virtual void waitUntil( std::unique_lock<compat::Mutex>&,
+                            compat::ConditionVariable&,
+                            TimePoint deadline ) override
+    {
+        m_now = std::max( m_now, deadline );
+    }
+
+private:
+    TimePoint m_now;
+};
+
+}
+
+static void Concurrency( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>();
+    auto ts = transfers( T, cacher, 1, 8,
+                         { std::chrono::milliseconds{ 0 }, 1024, 0, 0, false } );
+    /*
+     * The transfers only complete once 4 of them are running, so this would
+     * never return if the scheduler ran them sequentially
+     */
+    cacher->setBatchSize( 4 );
+    CacheScheduler scheduler;
+    scheduler.setLimits( 4, 0 );
+    auto nbSuccess = 0u;
+    scheduler.run( cacher, ts, acceptAll(),
+                   [&nbSuccess]( const CacheScheduler::Transfer& t, bool success ) {
+        ASSERT_TRUE( success );
+        ASSERT_EQ( 1024u, utils::fs::fileSize( t.outputPath ) );
+        ++nbSuccess;
+    });
+    ASSERT_EQ( 8u, nbSuccess );
+    ASSERT_EQ( 4u, cacher->maxConcurrency() );
+}
+
+static void NonConcurrentCacher( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>( false );
+    auto ts = transfers( T, cacher, 1, 4,
+                         { std::chrono::milliseconds{ 10 }, 1024, 0, 0, false } );
+    CacheScheduler scheduler;
+    scheduler.setLimits( 4, 0 );
+    auto nbSuccess = 0u;
+    scheduler.run( cacher, ts, acceptAll(),
+                   [&nbSuccess]( const CacheScheduler::Transfer&, bool success ) {
+        ASSERT_TRUE( success );
+        ++nbSuccess;
+    });
+    ASSERT_EQ( 4u, nbSuccess );
+    ASSERT_EQ( 1u, cacher->maxConcurrency() );
+}
+
+static void Fairness( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>( false );
+    auto ts = transfers( T, cacher, 1, 3,
+                         { std::chrono::milliseconds{ 0 }, 16, 0, 0, false } );
+    auto ts2 = transfers( T, cacher, 2, 2,
+                          { std::chrono::milliseconds{ 0 }, 16, 0, 0, false } );
+    ts.insert( end( ts ), begin( ts2 ), end( ts2 ) );
+    CacheScheduler scheduler;
+    scheduler.run( cacher, ts, acceptAll(),
+                   []( const CacheScheduler::Transfer&, bool ) {} );
+    auto order = cacher->startOrder();
+    ASSERT_EQ( 5u, order.size() );
+    ASSERT_EQ( "http://source/1-0", order[0] );
+    ASSERT_EQ( "http://source/2-0", order[1] );
+    ASSERT_EQ( "http://source/1-1", order[2] );
+    ASSERT_EQ( "http://source/2-1", order[3] );
+    ASSERT_EQ( "http://source/1-2", order[4] );
+}
+
+static void SlowSourceDoesntStall( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>();
+    /* The slow source is stuck until the fast one was fully cached */
+    auto ts = transfers( T, cacher, 1, 3,
+                         { std::chrono::milliseconds{ 0 }, 16, 0, 0, true } );
+    auto ts2 = transfers( T, cacher, 2, 3,
+                          { std::chrono::milliseconds{ 0 }, 16, 0, 0, false } );
+    ts.insert( end( ts ), begin( ts2 ), end( ts2 ) );
+    CacheScheduler scheduler;
+    scheduler.setLimits( 2, 0 );
+    std::vector<int64_t> groups;
+    scheduler.run( cacher, ts, acceptAll(),
+                   [&groups, &cacher]( const CacheScheduler::Transfer& t, bool success ) {
+        ASSERT_TRUE( success );
+        groups.push_back( t.groupId );
+        if ( std::count( begin( groups ), end( groups ), 2 ) == 3 )
+            cacher->release();
+    });
+    /* The fast source must have been fully cached while the slow one was stuck */
+    ASSERT_EQ( 6u, groups.size() );
+    ASSERT_EQ( 2, groups[0] );
+    ASSERT_EQ( 2, groups[1] );
+    ASSERT_EQ( 2, groups[2] );
+    ASSERT_EQ( 1, groups[3] );
+}
+
+static void BandwidthBudget( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>();
+    auto ts = transfers( T, cacher, 1, 3,
+                         { std::chrono::milliseconds{ 0 }, 16 * 1024, 0, 0, false } );
+    auto clock = std::make_shared<SimulatedClock>();
+    CacheScheduler scheduler;
+    scheduler.setClock( clock );
+    scheduler.setLimits( 4, 64 * 1024 );
+    std::vector<CacheScheduler::Clock::TimePoint> starts;
+    scheduler.run( cacher, ts,
+                   [&starts, &clock]( const CacheScheduler::Transfer& ) {
+        starts.push_back( clock->now() );
+        return true;
+    },
+                   []( const CacheScheduler::Transfer&, bool success ) {
+        ASSERT_TRUE( success );
+    });
+    /*
+     * The first transfer starts right away, the following ones must wait for
+     * the previous transfers to fit in the budget: 250ms each
+     */
+    ASSERT_EQ( 3u, starts.size() );
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    ASSERT_EQ( 250, duration_cast<milliseconds>( starts[1] - starts[0] ).count() );
+    ASSERT_EQ( 250, duration_cast<milliseconds>( starts[2] - starts[1] ).count() );
+}
+
+static void Resume( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>();
+    auto ts = transfers( T, cacher, 1, 1,
+                         { std::chrono::milliseconds{ 0 }, 10000, 0, 4000, false } );
+    const auto& output = ts[0].outputPath;
+    auto partial = CacheScheduler::partialPath( output );
+    CacheScheduler scheduler;
+    auto res = false;
+    auto onDone = [&res]( const CacheScheduler::Transfer&, bool success ) {
+        res = success;
+    };
+    scheduler.run( cacher, ts, acceptAll(), onDone );
+    ASSERT_FALSE( res );
+    ASSERT_EQ( 4000u, utils::fs::fileSize( partial ) );
+    ASSERT_TRUE( cacher->resumeOffsets().empty() );
+
+    scheduler.run( cacher, ts, acceptAll(), onDone );
+    ASSERT_TRUE( res );
+    auto offsets = cacher->resumeOffsets();
+    ASSERT_EQ( 1u, offsets.size() );
+    ASSERT_EQ( 4000u, offsets[0] );
+    ASSERT_EQ( 10000u, utils::fs::fileSize( output ) );
+    auto partialExists = true;
+    try
+    {
+        utils::fs::fileSize( partial );
+    }
+    catch ( const fs::errors::Exception& )
+    {
+        partialExists = false;
+    }
+    ASSERT_FALSE( partialExists );
+}
+
+static void NoResume( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>();
+    cacher->setResumable( false );
+    auto ts = transfers( T, cacher, 1, 1,
+                         { std::chrono::milliseconds{ 0 }, 10000, 0, 4000, false } );
+    const auto& output = ts[0].outputPath;
+    CacheScheduler scheduler;
+    auto res = false;
+    auto onDone = [&res]( const CacheScheduler::Transfer&, bool success ) {
+        res = success;
+    };
+    scheduler.run( cacher, ts, acceptAll(), onDone );
+    ASSERT_FALSE( res );
+
+    /* The transfer starts over, overwriting the partial file */
+    scheduler.run( cacher, ts, acceptAll(), onDone );
+    ASSERT_TRUE( res );
+    ASSERT_TRUE( cacher->resumeOffsets().empty() );
+    ASSERT_EQ( 10000u, utils::fs::fileSize( output ) );
+}
+
+static void RefusedStart( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>();
+    auto ts = transfers( T, cacher, 1, 3,
+                         { std::chrono::milliseconds{ 0 }, 16, 0, 0, false } );
+    CacheScheduler scheduler;
+    scheduler.setLimits( 2, 0 );
+    std::vector<int64_t> done;
+    scheduler.run( cacher, ts,
+                   []( const CacheScheduler::Transfer& t ) { return t.itemId != 1; },
+                   [&done]( const CacheScheduler::Transfer& t, bool ) {
+        done.push_back( t.itemId );
+    });
+    std::sort( begin( done ), end( done ) );
+    ASSERT_EQ( 2u, done.size() );
+    ASSERT_EQ( 0, done[0] );
+    ASSERT_EQ( 2, done[1] );
+    ASSERT_EQ( 2u, cacher->startOrder().size() );
+}
+
+static void Interrupt( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>( false );
+    auto ts = transfers( T, cacher, 1, 3,
+                         { std::chrono::milliseconds{ 0 }, 16, 0, 0, false } );
+    CacheScheduler scheduler;
+    auto nbDone = 0u;
+    scheduler.run( cacher, ts, acceptAll(),
+                   [&nbDone, &scheduler]( const CacheScheduler::Transfer&, bool ) {
+        ++nbDone;
+        scheduler.interrupt();
+    });
+    ASSERT_EQ( 1u, nbDone );
+    ASSERT_EQ( 1u, cacher->startOrder().size() );
+    /* The interruption is sticky */
+    scheduler.run( cacher, ts, acceptAll(),
+                   [&nbDone]( const CacheScheduler::Transfer&, bool ) {
+        ++nbDone;
+    });
+    ASSERT_EQ( 1u, nbDone );
+}
+
+static void InterruptBeforeStart( Tests* T )
+{
+    auto cacher = std::make_shared<mock::SimulatedCacher>();
+    auto ts = transfers( T, cacher, 1, 1,
+                         { std::chrono::milliseconds{ 0 }, 16, 0, 0, false } );
+    CacheScheduler scheduler;
+    auto nbDone = 0u;
+    /* The transfer is interrupted once accepted, but before a worker starts it */
+    scheduler.run( cacher, ts,
+                   [&scheduler]( const CacheScheduler::Transfer& ) {
+        scheduler.interrupt();
+        return true;
+    },
+                   [&nbDone]( const CacheScheduler::Transfer&, bool success ) {
+        ASSERT_FALSE( success );
+        ++nbDone;
+    });
+    ASSERT_EQ( 1u, nbDone );
+    ASSERT_TRUE( cacher->startOrder().empty() );
+}
+
+int main( int ac, char** av )
+{
+    INIT_TESTS( CacheScheduler );
+
+    ADD_TEST( Concurrency );
+    ADD_TEST( NonConcurrentCacher );
+    ADD_TEST( Fairness );
+    ADD_TEST( SlowSourceDoesntStall );
+    ADD_TEST( BandwidthBudget );
+    ADD_TEST( Resume );
+    ADD_TEST( NoResume );
+    ADD_TEST( RefusedStart );
+    ADD_TEST( Interrupt );
+    ADD_TEST( InterruptBeforeStart );
+
+    END_TESTS;
+}
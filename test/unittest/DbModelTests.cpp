@@ -35,6 +35,10 @@
 #include "Show.h"
 #include "ShowEpisode.h"
 #include "MediaGroup.h"
+#include "CacheManifest.h"
+#include "MediaAggregate.h"
+#include "thumbnails/ThumbnailStore.h"
+#include "Album.h"
 #include "File.h"
 #include "utils/File.h"
 #include "utils/Enums.h"
@@ -74,6 +78,12 @@ namespace
         "insert_folder_fts", "insert_genre_fts", "insert_media_fts",
         "insert_playlist_fts", "insert_show_fts",
         "label_delete_media",
+        "media_aggregate_delete_empty",
+        "media_aggregate_delete_media",
+        "media_aggregate_delete_show_episode",
+        "media_aggregate_insert_media",
+        "media_aggregate_insert_show_episode",
+        "media_aggregate_update_media",
         "media_cascade_file_deletion",
         "media_cascade_file_update",
         "media_decrement_nb_subscriptions",
@@ -129,6 +139,7 @@ namespace
         "audio_track_attached_file_idx",
         "audio_track_media_idx",
         "bookmark_media_id_idx",
+        "cache_manifest_dirty_idx",
         "chapter_media_id_idx",
         "file_folder_id_index",
         "file_media_id_index",
@@ -136,6 +147,8 @@ namespace
         "folder_device_id_idx",
         "index_last_played_date",
         "index_media_presence",
+        "media_aggregate_nb_public_tracks_idx",
+        "media_aggregate_public_duration_idx",
         "media_album_track_idx",
         "media_artist_id_idx",
         "media_duration_idx",
@@ -147,11 +160,18 @@ namespace
         "media_group_forced_singleton",
         "media_group_id_idx",
         "media_group_last_modification_date",
+        "media_import_type_insertion_date_idx",
+        "media_import_type_title_idx",
         "media_insertion_date_idx",
         "media_last_pos_time_idx",
         "media_play_count_idx",
         "media_release_date_idx",
         "media_title_idx",
+        "media_type_duration_idx",
+        "media_type_filename_idx",
+        "media_type_insertion_date_idx",
+        "media_type_release_date_idx",
+        "media_type_title_idx",
         "media_types_idx",
         "movie_media_idx",
         "parent_folder_id_idx",
@@ -166,7 +186,9 @@ namespace
         "subtitle_track_media_idx",
         "task_file_id_idx",
         "task_parent_folder_id_idx",
+        "task_uncompleted_idx",
         "thumbnail_link_index",
+        "thumbnail_pack_segment_idx",
         "video_track_media_idx",
     };
 
@@ -177,6 +199,7 @@ namespace
         "ArtistFts",
         "AudioTrack",
         "Bookmark",
+        "CacheManifest",
         "Chapter",
         "Device",
         "DeviceMountpoint",
@@ -188,6 +211,7 @@ namespace
         "Label",
         "LabelFileRelation",
         "Media",
+        "MediaAggregate",
         "MediaArtistRelation",
         "MediaFts",
         "MediaGroup",
@@ -210,6 +234,8 @@ namespace
         "Thumbnail",
         "ThumbnailCleanup",
         "ThumbnailLinking",
+        "ThumbnailPack",
+        "ThumbnailSegment",
         "VideoTrack",
     };
 
@@ -240,7 +266,19 @@ public:
     }
 };
 
-struct DbModel : public Tests
+class InitializationStepCallback : public mock::NoopCallback
+{
+public:
+    virtual void onInitializationStep( const char* step,
+                                       std::chrono::microseconds ) override
+    {
+        steps.emplace_back( step );
+    }
+
+    std::vector<std::string> steps;
+};
+
+struct DbModel : public UnitTests<InitializationStepCallback>
 {
     virtual void InstantiateMediaLibrary( const std::string& dbPath,
                                           const std::string& mlDir,
@@ -248,6 +286,8 @@ struct DbModel : public Tests
     {
         utils::fs::remove( dbPath );
         ml.reset( new MediaLibraryTesterNoForceRescan( dbPath, mlDir, cfg ) );
+        m_mlDir = mlDir;
+        m_cfg = *cfg;
     }
 
     virtual void Initialize() override
@@ -258,6 +298,15 @@ struct DbModel : public Tests
          */
     }
 
+    /* Reopens the current database with a new, uninitialized, media library */
+    void Restart()
+    {
+        ml.reset();
+        ml.reset( new MediaLibraryTesterNoForceRescan( getDbPath(), m_mlDir, &m_cfg ) );
+        ml->setFsFactory( fsMock );
+        cbMock->steps.clear();
+    }
+
     void LoadFakeDB( const char* dbPath )
     {
         utils::fs::mkdir( utils::file::directory( getDbPath() ) );
@@ -267,13 +316,13 @@ struct DbModel : public Tests
             auto dbConn = sqlite::Connection::connect( getDbPath() );
             ml->deleteAllTables( dbConn.get() );
             // The backup file already contains a transaction
-            char buff[4096];
+            std::string line;
             {
                 sqlite::Connection::WeakDbContext ctx{ dbConn.get() };
                 auto writeCtx = dbConn->acquireWriteContext();
-                while( file.getline( buff, sizeof( buff ) ) )
+                while( std::getline( file, line ) )
                 {
-                    medialibrary::sqlite::Statement stmt( buff );
+                    medialibrary::sqlite::Statement stmt( line );
                     stmt.execute();
                     while ( stmt.row() != nullptr )
                         ;
@@ -376,7 +425,7 @@ struct DbModel : public Tests
              * all others and removing the database from disk
              */
         }
-        Tests::TearDown();
+        UnitTests::TearDown();
     }
 
     void CommonMigrationTest( const char* mockDb )
@@ -388,7 +437,20 @@ struct DbModel : public Tests
         CheckTriggers( expectedTriggers );
         CheckIndexes( expectedIndexes );
         CheckTables( expectedTables );
+        CheckSchemaFingerprint();
     }
+
+    void CheckSchemaFingerprint()
+    {
+        // A successful migration must record the schema it checked
+        OPEN_READ_CONTEXT( ctx, ml->getConn() );
+        ASSERT_EQ( ml->getConn()->schemaFingerprint(),
+                   ml->getConn()->checkedSchemaFingerprint() );
+    }
+
+private:
+    std::string m_mlDir;
+    SetupConfig m_cfg;
 };
 
 static void NbTriggers( DbModel* T )
@@ -401,6 +463,66 @@ static void NbTriggers( DbModel* T )
     T->CheckTables( expectedTables );
 }
 
+static void InitializationSteps( DbModel* T )
+{
+    T->LoadFakeDB( SRC_DIR "/test/unittest/db_v40.sql" );
+    auto res = T->ml->initialize( T->cbMock.get() );
+    ASSERT_EQ( InitializeResult::Success, res );
+
+    const char* expected[] = {
+        "directories", "database", "settings", "migration", "devices", "parser"
+    };
+    const auto& steps = T->cbMock->steps;
+    ASSERT_EQ( sizeof( expected ) / sizeof( expected[0] ), steps.size() );
+    for ( auto i = 0u; i < steps.size(); ++i )
+        ASSERT_EQ( expected[i], steps[i] );
+}
+
+static void SchemaCheckOnStartup( DbModel* T )
+{
+    auto res = T->ml->initialize( T->cbMock.get() );
+    ASSERT_EQ( InitializeResult::Success, res );
+    /* The schema we just created is recorded as checked */
+    T->CheckSchemaFingerprint();
+
+    /* So the check is skipped as long as the schema doesn't change */
+    T->Restart();
+    res = T->ml->initialize( T->cbMock.get() );
+    ASSERT_EQ( InitializeResult::Success, res );
+    const auto& steps = T->cbMock->steps;
+    ASSERT_TRUE( std::find( begin( steps ), end( steps ), "integrity" ) == end( steps ) );
+
+    /* Including after a migration, which verifies the migrated schema */
+    T->ml.reset();
+    ASSERT_TRUE( utils::fs::remove( T->getDbPath() ) );
+    T->Restart();
+    T->LoadFakeDB( SRC_DIR "/test/unittest/db_v46.sql" );
+    res = T->ml->initialize( T->cbMock.get() );
+    ASSERT_EQ( InitializeResult::Success, res );
+    T->CheckSchemaFingerprint();
+    T->Restart();
+    res = T->ml->initialize( T->cbMock.get() );
+    ASSERT_EQ( InitializeResult::Success, res );
+    ASSERT_TRUE( std::find( begin( steps ), end( steps ), "integrity" ) == end( steps ) );
+
+    /* A schema modified behind our back is detected */
+    T->ml.reset();
+    {
+        auto dbConn = sqlite::Connection::connect( T->getDbPath() );
+        sqlite::Connection::WeakDbContext ctx{ dbConn.get() };
+        auto writeCtx = dbConn->acquireWriteContext();
+        medialibrary::sqlite::Statement stmt{ writeCtx.handle(),
+                "DROP INDEX " + Album::indexName( Album::Indexes::Title,
+                                                  Settings::DbModelVersion ) };
+        stmt.execute();
+        while ( stmt.row() != nullptr )
+            ;
+    }
+    T->Restart();
+    res = T->ml->initialize( T->cbMock.get() );
+    ASSERT_EQ( InitializeResult::DbCorrupted, res );
+}
+
 /*
  * Even though we don't support a proper migration from old models, keep a
  * migration from a really old model to check that we properly recreate the
@@ -789,11 +911,109 @@ static void Upgrade38to39( DbModel* T )
     T->CommonMigrationTest( SRC_DIR "/test/unittest/db_v38.sql" );
 }
 
+static void Upgrade39to40( DbModel* T )
+{
+    T->CommonMigrationTest( SRC_DIR "/test/unittest/db_v39.sql" );
+}
+
+static void Upgrade40to41( DbModel* T )
+{
+    T->CommonMigrationTest( SRC_DIR "/test/unittest/db_v40.sql" );
+}
+
+static void Upgrade41to42( DbModel* T )
+{
+    T->CommonMigrationTest( SRC_DIR "/test/unittest/db_v41.sql" );
+
+    /* The existing cached files must have been added to the manifest */
+    auto entries = CacheManifest::fetchAll( T->ml.get() );
+    ASSERT_EQ( 1u, entries.size() );
+    ASSERT_EQ( "1_track_1.mp3", entries[0].fileName );
+    ASSERT_EQ( 201, entries[0].fileId );
+    ASSERT_EQ( 6272u, entries[0].size );
+    ASSERT_EQ( CacheManifest::State::Committed, entries[0].state );
+    ASSERT_TRUE( CacheManifest::fetchDirty( T->ml.get() ).empty() );
+}
+
+static void Upgrade42to43( DbModel* T )
+{
+    T->CommonMigrationTest( SRC_DIR "/test/unittest/db_v42.sql" );
+
+    /* The aggregates must have been computed for the existing entities */
+    OPEN_READ_CONTEXT( ctx, T->ml->getConn() );
+    uint32_t nbAggregates;
+    medialibrary::sqlite::Statement stmt{
+        "SELECT COUNT(*) FROM " + MediaAggregate::Table::Name +
+            " WHERE entity_type = ?"
+    };
+    stmt.execute( MediaAggregate::EntityType::Album );
+    stmt.row() >> nbAggregates;
+    ASSERT_EQ( 20u, nbAggregates );
+
+    uint32_t nbMismatch;
+    medialibrary::sqlite::Statement mismatchStmt{
+        "SELECT COUNT(*) FROM " + Album::Table::Name + " alb"
+        " LEFT JOIN " + MediaAggregate::Table::Name + " agg"
+            " ON agg.entity_type = ? AND agg.entity_id = alb.id_album"
+        " WHERE alb.nb_tracks != IFNULL(agg.nb_tracks, 0)"
+            " OR alb.is_present != IFNULL(agg.nb_present_tracks, 0)"
+            " OR alb.duration != IFNULL(agg.duration, 0)"
+    };
+    mismatchStmt.execute( MediaAggregate::EntityType::Album );
+    mismatchStmt.row() >> nbMismatch;
+    ASSERT_EQ( 0u, nbMismatch );
+}
+
+static void Upgrade43to44( DbModel* T )
+{
+    T->CommonMigrationTest( SRC_DIR "/test/unittest/db_v43.sql" );
+
+    /* Existing thumbnails are left as files */
+    OPEN_READ_CONTEXT( ctx, T->ml->getConn() );
+    uint32_t nbPacked;
+    medialibrary::sqlite::Statement stmt{
+        "SELECT COUNT(*) FROM " + ThumbnailStore::Table::Name
+    };
+    stmt.execute();
+    stmt.row() >> nbPacked;
+    ASSERT_EQ( 0u, nbPacked );
+}
+
+static void Upgrade44to45( DbModel* T )
+{
+    T->CommonMigrationTest( SRC_DIR "/test/unittest/db_v44.sql" );
+}
+
+static void Upgrade45to46( DbModel* T )
+{
+    T->CommonMigrationTest( SRC_DIR "/test/unittest/db_v45.sql" );
+
+    /* The latest insertion dates must have been computed again */
+    OPEN_READ_CONTEXT( ctx, T->ml->getConn() );
+    uint32_t nbMismatch;
+    medialibrary::sqlite::Statement stmt{
+        "SELECT COUNT(*) FROM " + MediaAggregate::Table::Name + " agg"
+        " WHERE agg.entity_type = ? AND agg.last_insertion_date !="
+            " (SELECT MAX(IFNULL(m.insertion_date, 0)) FROM " +
+                Media::Table::Name + " m WHERE m.album_id = agg.entity_id)"
+    };
+    stmt.execute( MediaAggregate::EntityType::Album );
+    stmt.row() >> nbMismatch;
+    ASSERT_EQ( 0u, nbMismatch );
+}
+
+static void Upgrade46to47( DbModel* T )
+{
+    T->CommonMigrationTest( SRC_DIR "/test/unittest/db_v46.sql" );
+}
+
 int main( int ac, char** av )
 {
     INIT_TESTS_C( DbModel )
 
     ADD_TEST( NbTriggers );
+    ADD_TEST( InitializationSteps );
+    ADD_TEST( SchemaCheckOnStartup );
     ADD_TEST( Upgrade3to5 );
     ADD_TEST( Upgrade15to16 );
     ADD_TEST( Upgrade16to17 );
@@ -819,6 +1039,14 @@ int main( int ac, char** av )
     ADD_TEST( Upgrade36to37 );
     ADD_TEST( Upgrade37to38 );
     ADD_TEST( Upgrade38to39 );
+    ADD_TEST( Upgrade39to40 );
+    ADD_TEST( Upgrade40to41 );
+    ADD_TEST( Upgrade41to42 );
+    ADD_TEST( Upgrade42to43 );
+    ADD_TEST( Upgrade43to44 );
+    ADD_TEST( Upgrade44to45 );
+    ADD_TEST( Upgrade45to46 );
+    ADD_TEST( Upgrade46to47 );
 
     END_TESTS
 }
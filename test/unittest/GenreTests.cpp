@@ -602,6 +602,26 @@ static void Favorite( GenreTests* T )
     ASSERT_EQ( r[0]->id(), g2->id() );
 }
 
+static void Page( GenreTests* T )
+{
+    auto g2 = T->ml->createGenre( "genre 2" );
+    auto g3 = T->ml->createGenre( "genre 3" );
+    auto a = T->ml->createAlbum( "album" );
+    auto m = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "track.mp3", IMedia::Type::Audio ) );
+    a->addTrack( m, 1, 1, 0, g2.get() );
+
+    QueryParameters params{ SortingCriteria::Alpha, false };
+    auto page = T->ml->genres( &params )->page( 2, 1 );
+    ASSERT_EQ( 3u, page.count );
+    ASSERT_EQ( 2u, page.items.size() );
+    ASSERT_EQ( g2->id(), page.items[0]->id() );
+    ASSERT_EQ( "genre 2", page.items[0]->name() );
+    ASSERT_EQ( 1u, page.items[0]->nbTracks() );
+    ASSERT_EQ( g3->id(), page.items[1]->id() );
+    ASSERT_EQ( "genre 3", page.items[1]->name() );
+}
+
 int main( int ac, char** av )
 {
     INIT_TESTS_C( GenreTests );
@@ -626,6 +646,7 @@ int main( int ac, char** av )
     ADD_TEST( ConvertToExternal );
     ADD_TEST( Public );
     ADD_TEST( Favorite );
+    ADD_TEST( Page );
 
     END_TESTS
 }
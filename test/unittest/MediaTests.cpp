@@ -1944,6 +1944,95 @@ static void FilenameNumericalOrder( Tests* T )
     ASSERT_EQ( m3->id(), media[0]->id() );
 }
 
+static void Page( Tests* T )
+{
+    std::vector<MediaPtr> media;
+    for ( auto i = 0u; i < 5; ++i )
+        media.push_back( T->ml->addMedia( "media" + std::to_string( i ) + ".mkv",
+                                          IMedia::Type::Video ) );
+    auto playlist = T->ml->createPlaylist( "playlist" );
+    for ( const auto& m : media )
+        playlist->append( *m );
+
+    QueryParameters params{ SortingCriteria::Filename, false };
+    auto checkPage = [T]( const Query<IMedia>& query, uint32_t nbItems, uint32_t offset ) {
+        auto page = query->page( nbItems, offset );
+        ASSERT_EQ( query->count(), page.count );
+        auto items = nbItems == 0 && offset == 0 ? query->all() :
+                                                   query->items( nbItems, offset );
+        ASSERT_EQ( items.size(), page.items.size() );
+        for ( auto i = 0u; i < items.size(); ++i )
+            ASSERT_EQ( items[i]->id(), page.items[i]->id() );
+    };
+
+    Query<IMedia> queries[] = {
+        T->ml->videoFiles( &params ),
+        playlist->media( &params ),
+    };
+    for ( const auto& q : queries )
+    {
+        checkPage( q, 2, 0 );
+        checkPage( q, 2, 4 );
+        checkPage( q, 2, 10 );
+        checkPage( q, 0, 0 );
+    }
+    auto page = T->ml->videoFiles( &params )->page( 2, 1 );
+    ASSERT_EQ( 5u, page.count );
+    ASSERT_EQ( 2u, page.items.size() );
+    ASSERT_EQ( media[1]->id(), page.items[0]->id() );
+    ASSERT_EQ( media[2]->id(), page.items[1]->id() );
+}
+
+static void ForEach( Tests* T )
+{
+    for ( auto i = 0u; i < 5; ++i )
+        T->ml->addMedia( "media" + std::to_string( i ) + ".mkv", IMedia::Type::Video );
+    auto playlist = T->ml->createPlaylist( "playlist" );
+    QueryParameters params{ SortingCriteria::Filename, false };
+    auto expected = T->ml->videoFiles( &params )->all();
+    ASSERT_EQ( 5u, expected.size() );
+    for ( const auto& m : expected )
+        playlist->append( *m );
+
+    Query<IMedia> queries[] = {
+        T->ml->videoFiles( &params ),
+        playlist->media( &params ),
+    };
+    for ( const auto& q : queries )
+    {
+        std::vector<int64_t> ids;
+        auto res = q->forEach( [T, &ids]( MediaPtr m ) {
+            /* Other reads are allowed during the iteration */
+            auto media = T->ml->media( m->id() );
+            ids.push_back( media->id() );
+            return true;
+        });
+        ASSERT_TRUE( res );
+        ASSERT_EQ( expected.size(), ids.size() );
+        for ( auto i = 0u; i < ids.size(); ++i )
+            ASSERT_EQ( expected[i]->id(), ids[i] );
+
+        ids.clear();
+        res = q->forEach( [&ids]( MediaPtr m ) {
+            ids.push_back( m->id() );
+            return ids.size() < 2;
+        });
+        ASSERT_FALSE( res );
+        ASSERT_EQ( 2u, ids.size() );
+        ASSERT_EQ( expected[1]->id(), ids[1] );
+    }
+
+    /* The database can be modified once the iteration is over */
+    auto m = T->ml->addMedia( "media5.mkv", IMedia::Type::Video );
+    ASSERT_NON_NULL( m );
+    auto nbMedia = 0u;
+    T->ml->videoFiles( &params )->forEach( [&nbMedia]( MediaPtr ) {
+        ++nbMedia;
+        return true;
+    });
+    ASSERT_EQ( 6u, nbMedia );
+}
+
 
 int main( int ac, char** av )
 {
@@ -2017,6 +2106,8 @@ int main( int ac, char** av )
     ADD_TEST( Description );
     ADD_TEST( AddCachedMrl );
     ADD_TEST( FilenameNumericalOrder );
+    ADD_TEST( Page );
+    ADD_TEST( ForEach );
 
     END_TESTS
 }
@@ -33,9 +33,15 @@
 #include "utils/Defer.h"
 #include "utils/Xml.h"
 #include "utils/XxHasher.h"
+#include "utils/SharedPool.h"
 #include "utils/Date.h"
+#include "utils/Image.h"
+#include "logging/AsyncLogger.h"
+#include "database/SqliteQueryMetrics.h"
+#include "utils/SWMRLock.h"
 
 #include "parser/Task.h"
+#include "Media.h"
 
 namespace
 {
@@ -57,6 +63,34 @@ namespace
                         strlen( str1 ), str1, strlen( str2 ), str2 );
         }
     };
+    class CaptureLogger : public ILogger
+    {
+    public:
+        virtual void Error( const std::string& msg ) override { add( msg ); }
+        virtual void Warning( const std::string& msg ) override { add( msg ); }
+        virtual void Info( const std::string& msg ) override { add( msg ); }
+        virtual void Debug( const std::string& msg ) override { add( msg ); }
+        virtual void Verbose( const std::string& msg ) override
+        {
+            /* Verbose messages block until released, to fill the async logger */
+            std::unique_lock<compat::Mutex> lock( mutex );
+            blocked = true;
+            cond.notify_all();
+            cond.wait( lock, [this]() { return blocked == false; } );
+            messages.push_back( msg );
+        }
+
+        void add( const std::string& msg )
+        {
+            std::lock_guard<compat::Mutex> lock( mutex );
+            messages.push_back( msg );
+        }
+
+        compat::Mutex mutex;
+        compat::ConditionVariable cond;
+        bool blocked = false;
+        std::vector<std::string> messages;
+    };
 }
 
 struct MiscTests : public Tests
@@ -123,6 +157,10 @@ static void Utf8NbChars( MiscTests* )
     ASSERT_EQ( 7u, utils::str::utf8::nbChars( "NEO지식창고" ) );
     ASSERT_EQ( 0u, utils::str::utf8::nbChars( "INVALID\xC3" ) );
     ASSERT_EQ( 0u, utils::str::utf8::nbChars( "\xEC\xEC" ) );
+    /* Check that we properly handle the vectorized blocks boundaries */
+    ASSERT_EQ( 39u, utils::str::utf8::nbChars( "Fluffy sea otters holding hands (2 CDs)" ) );
+    ASSERT_EQ( 41u, utils::str::utf8::nbChars( "Éléphants roses dans la forêt de Paimpont" ) );
+    ASSERT_EQ( 0u, utils::str::utf8::nbChars( "A long enough string to be invalid at the end\xC3" ) );
 }
 
 static void Utf8NbBytes( MiscTests* )
@@ -137,6 +175,30 @@ static void Utf8NbBytes( MiscTests* )
 
     ASSERT_EQ( 0u, utils::str::utf8::nbBytes( "INVALID\xC3", 5, 3 ) );
     ASSERT_EQ( 0u, utils::str::utf8::nbBytes( "\xEC\xEC", 5, 3 ) );
+
+    ASSERT_EQ( 33u, utils::str::utf8::nbBytes( "Fluffy sea otters holding hands (2 CDs)", 0, 33 ) );
+    ASSERT_EQ( 35u, utils::str::utf8::nbBytes( "Éléphants roses dans la forêt de Paimpont", 0, 32 ) );
+}
+
+static void Utf8CommonPattern( MiscTests* )
+{
+    ASSERT_EQ( "", utils::str::utf8::commonPattern( "", 0, "", 0, 0 ) );
+    ASSERT_EQ( "", utils::str::utf8::commonPattern( "ABC", 0, "DEF", 0, 0 ) );
+    ASSERT_EQ( "ABC", utils::str::utf8::commonPattern( "ABCDE", 0, "abcFG", 0, 3 ) );
+    ASSERT_EQ( "", utils::str::utf8::commonPattern( "ABCDE", 0, "abcFG", 0, 4 ) );
+    ASSERT_EQ( "BC", utils::str::utf8::commonPattern( "ABCDE", 1, "xbcFG", 1, 2 ) );
+    ASSERT_EQ( "Fluffy sea otters holding hands (",
+               utils::str::utf8::commonPattern( "Fluffy sea otters holding hands (1)", 0,
+                                                "fluffy SEA otters holding hands (2)", 0, 6 ) );
+    ASSERT_EQ( "Éléphants roses dans la forêt d",
+               utils::str::utf8::commonPattern( "Éléphants roses dans la forêt de Paimpont", 0,
+                                                "Éléphants ROSES dans la forêt d'Écouves", 0, 6 ) );
+    ASSERT_EQ( "NEO지식",
+               utils::str::utf8::commonPattern( "NEO지식창고", 0, "neo지식고", 0, 5 ) );
+    /* Case insensitive comparisons are only performed on ASCII characters */
+    ASSERT_EQ( "", utils::str::utf8::commonPattern( "é", 0, "É", 0, 0 ) );
+    /* Don't return a partial code point */
+    ASSERT_EQ( "NEO", utils::str::utf8::commonPattern( "NEO\xEC\x8B", 0, "NEO\xEC\x8B", 0, 0 ) );
 }
 
 static void XmlEncode( MiscTests* )
@@ -163,6 +225,36 @@ static void Defer( MiscTests* )
     ASSERT_EQ( 1u, i );
 }
 
+static void SharedPool( MiscTests* )
+{
+    struct Counted
+    {
+        Counted( int v, int& nbAlive ) : value( v ), nbAlive( nbAlive ) { ++nbAlive; }
+        ~Counted() { --nbAlive; }
+        int value;
+        int& nbAlive;
+        char padding[100];
+    };
+    auto nbAlive = 0;
+    std::vector<std::shared_ptr<Counted>> objects;
+    {
+        /* Use small chunks to ensure we span over multiple of them */
+        utils::SharedPool pool{ 1024 };
+        for ( auto i = 0; i < 100; ++i )
+            objects.push_back( pool.make_shared<Counted>( i, nbAlive ) );
+    }
+    /* The objects must outlive the pool they were allocated from */
+    ASSERT_EQ( 100, nbAlive );
+    for ( auto i = 0; i < 100; ++i )
+        ASSERT_EQ( i, objects[i]->value );
+    /* Release objects in a different order than they were allocated in */
+    for ( auto i = 0u; i < objects.size(); i += 2 )
+        objects[i].reset();
+    ASSERT_EQ( 50, nbAlive );
+    objects.clear();
+    ASSERT_EQ( 0, nbAlive );
+}
+
 static void XxHashBuffer( MiscTests* )
 {
     auto hash = utils::hash::xxFromBuff( (const uint8_t*)"message digest",
@@ -207,6 +299,85 @@ static void ClearDatabase( Tests* T )
     ASSERT_TRUE( res );
 }
 
+static void RegisteredRequest( Tests* T )
+{
+    sqlite::Request req{ "SELECT COUNT(*) FROM " + Media::Table::Name };
+    sqlite::Request req2{ "SELECT COUNT(*) FROM " + Media::Table::Name };
+    ASSERT_NE( req.id(), req2.id() );
+
+    auto count = [T]( const sqlite::Request& r ) {
+        OPEN_READ_CONTEXT( ctx, T->ml->getConn() );
+        sqlite::Statement stmt{ r };
+        stmt.execute();
+        return stmt.row().load<int64_t>( 0 );
+    };
+    ASSERT_EQ( 0, count( req ) );
+    T->ml->addMedia( "media.mkv", IMedia::Type::Video );
+    ASSERT_EQ( 1, count( req ) );
+    ASSERT_EQ( 1, count( req2 ) );
+
+    /* Ensure the statement gets compiled again after flushing the cache */
+    sqlite::Statement::FlushStatementCache();
+    ASSERT_EQ( 1, count( req ) );
+}
+
+static void TextColumn( Tests* T )
+{
+    OPEN_READ_CONTEXT( ctx, T->ml->getConn() );
+    sqlite::Statement stmt{ "SELECT 'ok', NULL, 'o'" };
+    stmt.execute();
+    auto row = stmt.row();
+    auto text = row.extract<sqlite::Text>();
+    ASSERT_EQ( 2u, text.size );
+    ASSERT_TRUE( text == "ok" );
+    ASSERT_TRUE( text != "ok!" );
+    ASSERT_TRUE( text != "o" );
+    ASSERT_EQ( "ok", text.str() );
+    text = row.extract<sqlite::Text>();
+    ASSERT_EQ( 0u, text.size );
+    ASSERT_TRUE( text == "" );
+    text = row.extract<sqlite::Text>();
+    ASSERT_TRUE( text != "ok" );
+}
+
+static void StatementCache( Tests* T )
+{
+    OPEN_READ_CONTEXT( ctx, T->ml->getConn() );
+    auto run = []( const std::string& req ) {
+        sqlite::Statement stmt{ req };
+        stmt.execute();
+        return stmt.row().load<int64_t>( 0 );
+    };
+    auto before = sqlite::Statement::cacheStats();
+    ASSERT_EQ( 1, run( "SELECT 1" ) );
+    ASSERT_EQ( 1, run( "SELECT 1" ) );
+    auto after = sqlite::Statement::cacheStats();
+    ASSERT_EQ( before.nbMisses + 1, after.nbMisses );
+    ASSERT_EQ( before.nbHits + 1, after.nbHits );
+
+    /*
+     * Keep a statement alive while filling the cache, it must not be evicted
+     * since it's still in use.
+     */
+    sqlite::Statement busy{ "SELECT 1 UNION ALL SELECT 2" };
+    busy.execute();
+    auto row = busy.row();
+    ASSERT_EQ( 1, row.load<int64_t>( 0 ) );
+    for ( auto i = 2u; i < sqlite::Statement::MaxCachedStatements + 10; ++i )
+        ASSERT_EQ( i, run( "SELECT " + std::to_string( i ) ) );
+    row = busy.row();
+    ASSERT_EQ( 2, row.load<int64_t>( 0 ) );
+    ASSERT_TRUE( busy.row() == nullptr );
+
+    after = sqlite::Statement::cacheStats();
+    ASSERT_NE( before.nbEvictions, after.nbEvictions );
+    /* The least recently used statement was evicted and gets compiled again */
+    before = after;
+    ASSERT_EQ( 1, run( "SELECT 1" ) );
+    after = sqlite::Statement::cacheStats();
+    ASSERT_EQ( before.nbMisses + 1, after.nbMisses );
+}
+
 static void DateFromStr( Tests* )
 {
     struct
@@ -241,6 +412,248 @@ static void DateFromStr( Tests* )
     }
 }
 
+static void Downscale( Tests* )
+{
+    /* A uniform picture stays uniform */
+    std::vector<uint8_t> src( 37 * 23 * 3, 0x7F );
+    std::vector<uint8_t> dst( 11 * 7 * 3 );
+    utils::image::downscale( src.data(), 37, 23, dst.data(), 11, 7, 3 );
+    for ( auto c : dst )
+        ASSERT_EQ( 0x7F, c );
+
+    /* Halving the size averages 2x2 blocks */
+    const uint8_t block[] = { 10, 20, 30, 40 };
+    uint8_t avg;
+    utils::image::downscale( block, 2, 2, &avg, 1, 1, 1 );
+    ASSERT_EQ( 25, avg );
+
+    /* The vectorized version must match the reference one */
+    src.resize( 333 * 187 * 4 );
+    for ( auto i = 0u; i < src.size(); ++i )
+        src[i] = static_cast<uint8_t>( ( i * 2654435761u ) >> 13 );
+    const struct
+    {
+        uint32_t width;
+        uint32_t height;
+    } sizes[] = { { 333, 100 }, { 160, 187 }, { 96, 54 }, { 1, 1 }, { 320, 180 } };
+    for ( const auto& s : sizes )
+    {
+        std::vector<uint8_t> expected( s.width * s.height * 4 );
+        dst.resize( expected.size() );
+        utils::image::scalar::downscale( src.data(), 333, 187, expected.data(),
+                                         s.width, s.height, 4 );
+        utils::image::downscale( src.data(), 333, 187, dst.data(),
+                                 s.width, s.height, 4 );
+        ASSERT_TRUE( expected == dst );
+    }
+}
+
+static void DisabledLogs( Tests* )
+{
+    auto logger = std::make_shared<CaptureLogger>();
+    Log::SetLogger( logger );
+    Log::setLogLevel( LogLevel::Info );
+    auto nbEvaluations = 0u;
+    auto arg = [&nbEvaluations]() {
+        ++nbEvaluations;
+        return std::string{ "expensive" };
+    };
+    LOG_VERBOSE( arg() );
+    LOG_DEBUG( "Debug: ", arg() );
+    ASSERT_EQ( 0u, nbEvaluations );
+    ASSERT_EQ( 0u, logger->messages.size() );
+
+    LOG_INFO( arg() );
+    LOG_WARN( arg() );
+    LOG_ERROR( arg() );
+    ASSERT_EQ( 3u, nbEvaluations );
+    ASSERT_EQ( 3u, logger->messages.size() );
+
+    Log::setLogLevel( LogLevel::Error );
+    LOG_WARN( arg() );
+    ASSERT_EQ( 3u, nbEvaluations );
+    Log::SetLogger( std::make_shared<IostreamLogger>() );
+}
+
+static void AsyncLogging( Tests* )
+{
+    auto sink = std::make_shared<CaptureLogger>();
+    {
+        AsyncLogger logger{ sink };
+        for ( auto i = 0u; i < 100; ++i )
+            logger.Info( std::to_string( i ) );
+        logger.flush();
+        ASSERT_EQ( 100u, sink->messages.size() );
+        for ( auto i = 0u; i < 100; ++i )
+            ASSERT_EQ( std::to_string( i ), sink->messages[i] );
+        ASSERT_EQ( 0u, logger.nbDropped() );
+    }
+    sink->messages.clear();
+    {
+        AsyncLogger logger{ sink, 2 };
+
+        /* Block the logger thread in the sink, and overflow the ring buffer */
+        logger.Verbose( "blocking" );
+        {
+            std::unique_lock<compat::Mutex> lock( sink->mutex );
+            sink->cond.wait( lock, [&sink]() { return sink->blocked; } );
+        }
+        logger.Debug( "1" );
+        logger.Debug( "2" );
+        logger.Debug( "dropped" );
+        ASSERT_EQ( 1u, logger.nbDropped() );
+        {
+            std::lock_guard<compat::Mutex> lock( sink->mutex );
+            sink->blocked = false;
+        }
+        sink->cond.notify_all();
+        logger.flush();
+        logger.Error( "3" );
+        logger.flush();
+        ASSERT_EQ( 1u, logger.nbDropped() );
+        /* The dropped message gets reported along with the next batch */
+        ASSERT_EQ( 5u, sink->messages.size() );
+        ASSERT_EQ( "blocking", sink->messages[0] );
+        ASSERT_EQ( "1", sink->messages[1] );
+        ASSERT_EQ( "2", sink->messages[2] );
+        ASSERT_EQ( "3", sink->messages[4] );
+        /* Pending messages are written when the logger gets destroyed */
+        logger.Info( "4" );
+    }
+    ASSERT_EQ( 6u, sink->messages.size() );
+    ASSERT_EQ( "4", sink->messages[5] );
+}
+
+static void NormalizeQuery( Tests* )
+{
+    using QM = sqlite::QueryMetrics;
+    ASSERT_EQ( "SELECT * FROM Media WHERE id_media = ?",
+               QM::normalize( "SELECT * FROM Media WHERE id_media = 42" ) );
+    ASSERT_EQ( "SELECT * FROM Media WHERE id_media IN (?) AND title = ? LIMIT ? OFFSET ?",
+               QM::normalize( "SELECT  *\n  FROM Media WHERE id_media IN (1, 2,3) "
+                              "AND title = 'it''s' LIMIT 10 OFFSET 20 " ) );
+    /* Numbers are left untouched in identifiers */
+    ASSERT_EQ( "SELECT t1.id_2 FROM t1", QM::normalize( "SELECT t1.id_2 FROM t1" ) );
+    ASSERT_EQ( QM::normalize( "SELECT 1" ), QM::normalize( "SELECT 2.5" ) );
+}
+
+static const LockStats* findLockStats( const std::vector<LockStats>& stats,
+                                       LockMode mode, LockClient client )
+{
+    auto it = std::find_if( begin( stats ), end( stats ),
+                            [mode, client]( const LockStats& s ) {
+        return s.mode == mode && s.client == client;
+    });
+    return it != end( stats ) ? &*it : nullptr;
+}
+
+static void SWMRLockStats( Tests* )
+{
+    utils::SWMRLock l;
+    l.acquire_priority_access();
+    compat::Thread t{ [&l]() {
+        utils::SWMRLock::setThreadClient( LockClient::Parser );
+        /* This one has to wait for the priority access to be released */
+        l.lock_read();
+        l.unlock_read();
+        l.lock_read();
+        l.unlock_read();
+        l.lock_write();
+        l.unlock_write();
+    }};
+    compat::this_thread::sleep_for( std::chrono::milliseconds{ 100 } );
+    l.release_priority_access();
+    t.join();
+
+    auto stats = l.stats();
+    ASSERT_EQ( 3u, stats.size() );
+
+    auto read = findLockStats( stats, LockMode::Read, LockClient::Parser );
+    ASSERT_NON_NULL( read );
+    ASSERT_EQ( 2u, read->nbAcquisitions );
+    ASSERT_EQ( 1u, read->nbPreempted );
+    ASSERT_TRUE( read->maxWait >= std::chrono::milliseconds{ 50 } );
+    ASSERT_TRUE( read->maxWait <= read->totalWait );
+    ASSERT_TRUE( read->maxHold <= read->totalHold );
+    uint64_t nbWaits = 0;
+    uint64_t nbHolds = 0;
+    for ( auto i = 0u; i < LockStats::NbBuckets; ++i )
+    {
+        nbWaits += read->waitHistogram[i];
+        nbHolds += read->holdHistogram[i];
+    }
+    ASSERT_EQ( 2u, nbWaits );
+    ASSERT_EQ( 2u, nbHolds );
+
+    auto write = findLockStats( stats, LockMode::Write, LockClient::Parser );
+    ASSERT_NON_NULL( write );
+    ASSERT_EQ( 1u, write->nbAcquisitions );
+    ASSERT_EQ( 0u, write->nbPreempted );
+
+    auto prio = findLockStats( stats, LockMode::Priority, LockClient::Application );
+    ASSERT_NON_NULL( prio );
+    ASSERT_EQ( 1u, prio->nbAcquisitions );
+    ASSERT_TRUE( prio->maxHold >= std::chrono::milliseconds{ 50 } );
+
+    l.resetStats();
+    ASSERT_TRUE( l.stats().empty() );
+}
+
+static void SWMRLockPolicy( Tests* )
+{
+    /*
+     * Release a write lock while both a reader and a writer are waiting, and
+     * return the order in which they were granted the lock
+     */
+    auto grantOrder = []( LockPolicy policy ) {
+        utils::SWMRLock l;
+        l.setPolicy( policy, 1 );
+        compat::Mutex mutex;
+        std::string order;
+        l.lock_write();
+        compat::Thread reader{ [&]() {
+            l.lock_read();
+            {
+                std::lock_guard<compat::Mutex> lock( mutex );
+                order += 'R';
+            }
+            l.unlock_read();
+        }};
+        compat::Thread writer{ [&]() {
+            l.lock_write();
+            {
+                std::lock_guard<compat::Mutex> lock( mutex );
+                order += 'W';
+            }
+            l.unlock_write();
+        }};
+        compat::this_thread::sleep_for( std::chrono::milliseconds{ 100 } );
+        l.unlock_write();
+        reader.join();
+        writer.join();
+        return order;
+    };
+    ASSERT_EQ( "WR", grantOrder( LockPolicy::WriterPreferring ) );
+    /* The batch of 1 write is over, so the reader gets in first */
+    ASSERT_EQ( "RW", grantOrder( LockPolicy::BoundedWriterBatches ) );
+
+    /* A reader can always join another reader, even with a writer waiting */
+    utils::SWMRLock l;
+    l.lock_read();
+    compat::Thread writer{ [&l]() {
+        l.lock_write();
+        l.unlock_write();
+    }};
+    compat::this_thread::sleep_for( std::chrono::milliseconds{ 100 } );
+    compat::Thread reader{ [&l]() {
+        l.lock_read();
+        l.unlock_read();
+    }};
+    reader.join();
+    l.unlock_read();
+    writer.join();
+}
+
 int test_without_ml_init( int ac, char** av )
 {
     INIT_TESTS_C( MiscTests );
@@ -252,16 +665,94 @@ int test_without_ml_init( int ac, char** av )
     ADD_TEST( SanitizePattern );
     ADD_TEST( Utf8NbChars );
     ADD_TEST( Utf8NbBytes );
+    ADD_TEST( Utf8CommonPattern );
     ADD_TEST( XmlEncode );
     ADD_TEST( Defer );
+    ADD_TEST( SharedPool );
     ADD_TEST( XxHashBuffer );
     ADD_TEST( XxHashFile );
     ADD_TEST( DateFromStr );
     ADD_TEST( FilenameCollate );
+    ADD_TEST( Downscale );
+    ADD_TEST( DisabledLogs );
+    ADD_TEST( AsyncLogging );
+    ADD_TEST( NormalizeQuery );
+    ADD_TEST( SWMRLockStats );
+    ADD_TEST( SWMRLockPolicy );
 
     END_TESTS
 }
 
+static void QueryStatsHistogram( Tests* T )
+{
+    T->ml->addMedia( "media.mkv", IMedia::Type::Video );
+    T->ml->addMedia( "media2.mkv", IMedia::Type::Video );
+    T->ml->resetQueryStats();
+    const std::string req = "SELECT * FROM " + Media::Table::Name +
+                            " WHERE id_media > ";
+    for ( auto i = 0; i < 3; ++i )
+    {
+        auto media = sqlite::Tools::fetchAll<Media, IMedia>(
+                    T->ml.get(), req + std::to_string( i ) + " ORDER BY -duration" );
+        ASSERT_EQ( 2u - std::min( i, 2 ), media.size() );
+    }
+    auto stats = T->ml->queryStats();
+    auto it = std::find_if( begin( stats ), end( stats ), []( const QueryStats& s ) {
+        return s.sql == "SELECT * FROM Media WHERE id_media > ? ORDER BY -duration";
+    });
+    ASSERT_TRUE( it != end( stats ) );
+    ASSERT_EQ( 3u, it->nbExecutions );
+    ASSERT_EQ( 3u, it->nbRows );
+    ASSERT_EQ( 3u, it->nbSorts );
+    ASSERT_NE( 0u, it->nbVmSteps );
+    ASSERT_TRUE( it->maxDuration <= it->totalDuration );
+    uint64_t nbExecutions = 0;
+    for ( auto n : it->latencyHistogram )
+        nbExecutions += n;
+    ASSERT_EQ( 3u, nbExecutions );
+
+    T->ml->resetQueryStats();
+    ASSERT_TRUE( T->ml->queryStats().empty() );
+}
+
+static void SlowQueries( Tests* T )
+{
+    const std::string req = "SELECT * FROM " + Media::Table::Name +
+                            " ORDER BY -duration";
+    std::string plan;
+    auto nbReports = 0u;
+    sqlite::QueryMetrics::setSlowQueryHandler( std::chrono::microseconds{ 1 },
+        [&req, &plan, &nbReports]( const std::string& sql, std::chrono::microseconds,
+                                   const std::string& queryPlan ) {
+            if ( sql != req )
+                return;
+            ++nbReports;
+            plan = queryPlan;
+    });
+    sqlite::Tools::fetchAll<Media, IMedia>( T->ml.get(), req );
+    sqlite::QueryMetrics::setSlowQueryHandler( {}, nullptr );
+    sqlite::Tools::fetchAll<Media, IMedia>( T->ml.get(), req );
+
+    ASSERT_EQ( 1u, nbReports );
+    ASSERT_NE( std::string::npos, plan.find( "SCAN" ) );
+    ASSERT_NE( std::string::npos, plan.find( "TEMP B-TREE FOR ORDER BY" ) );
+}
+
+static void DatabaseLockStats( Tests* T )
+{
+    T->ml->addMedia( "media.mkv", IMedia::Type::Video );
+    T->ml->resetLockStats();
+    auto media = T->ml->media( 1 );
+    ASSERT_NON_NULL( media );
+    auto stats = T->ml->lockStats();
+    auto read = findLockStats( stats, LockMode::Read, LockClient::Application );
+    ASSERT_NON_NULL( read );
+    ASSERT_NE( 0u, read->nbAcquisitions );
+
+    T->ml->resetLockStats();
+    ASSERT_TRUE( T->ml->lockStats().empty() );
+}
+
 int test_with_ml_init( int ac, char** av )
 {
     INIT_TESTS(MiscTests)
@@ -269,6 +760,12 @@ int test_with_ml_init( int ac, char** av )
     ADD_TEST( CheckTaskDbModel );
     ADD_TEST( ClearDatabaseKeepPlaylist );
     ADD_TEST( ClearDatabase );
+    ADD_TEST( RegisteredRequest );
+    ADD_TEST( StatementCache );
+    ADD_TEST( TextColumn );
+    ADD_TEST( QueryStatsHistogram );
+    ADD_TEST( SlowQueries );
+    ADD_TEST( DatabaseLockStats );
 
     END_TESTS
 }
@@ -1589,6 +1589,24 @@ static void Favorite( PlaylistTests* T )
     p2->setFavorite( true );
 }
 
+static void Page( PlaylistTests* T )
+{
+    auto pl2 = T->ml->createPlaylist( "test playlist 2" );
+    auto pl3 = T->ml->createPlaylist( "test playlist 3" );
+    auto m = T->ml->addMedia( "media.mkv", IMedia::Type::Video );
+    pl2->append( *m );
+
+    QueryParameters params{ SortingCriteria::Alpha, false };
+    auto page = T->ml->playlists( PlaylistType::All, &params )->page( 2, 1 );
+    ASSERT_EQ( 3u, page.count );
+    ASSERT_EQ( 2u, page.items.size() );
+    ASSERT_EQ( pl2->id(), page.items[0]->id() );
+    ASSERT_EQ( "test playlist 2", page.items[0]->name() );
+    ASSERT_EQ( 1u, page.items[0]->nbMedia() );
+    ASSERT_EQ( pl3->id(), page.items[1]->id() );
+    ASSERT_EQ( "test playlist 3", page.items[1]->name() );
+}
+
 int main( int ac, char** av )
 {
     INIT_TESTS_C( PlaylistTests );
@@ -1633,6 +1651,7 @@ int main( int ac, char** av )
     ADD_TEST( Public );
     ADD_TEST( SortMediaRequest );
     ADD_TEST( Favorite );
+    ADD_TEST( Page );
 
     END_TESTS
 }
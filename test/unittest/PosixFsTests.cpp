@@ -0,0 +1,223 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "UnitTests.h"
+
+#include "filesystem/posix/FileSystemFactory.h"
+#include "medialibrary/filesystem/IDirectory.h"
+#include "medialibrary/filesystem/IFile.h"
+#include "medialibrary/filesystem/Errors.h"
+#include "utils/Filename.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace medialibrary;
+
+struct PosixFsTests
+{
+    std::string root;
+    std::string rootMrl;
+    std::unique_ptr<fs::posix::FileSystemFactory> fsFactory;
+
+    void SetUp( const std::string&, const std::string& )
+    {
+        Log::SetLogger( std::make_shared<IostreamLogger>() );
+        Log::setLogLevel( LogLevel::Debug );
+        char tmpl[] = "/tmp/ml_posix_fs_XXXXXX";
+        auto path = mkdtemp( tmpl );
+        ASSERT_NON_NULL( path );
+        root = utils::file::toFolderPath( path );
+        rootMrl = utils::file::toMrl( root );
+        fsFactory.reset( new fs::posix::FileSystemFactory );
+    }
+
+    void TearDown()
+    {
+        nftw( root.c_str(), []( const char* p, const struct stat*, int, FTW* ) {
+            return remove( p );
+        }, 16, FTW_DEPTH | FTW_PHYS );
+    }
+
+    void createFile( const std::string& name, const std::string& content = {} )
+    {
+        auto f = fopen( ( root + name ).c_str(), "w" );
+        ASSERT_NON_NULL( f );
+        fwrite( content.data(), 1, content.size(), f );
+        fclose( f );
+    }
+
+    void createDirectory( const std::string& name )
+    {
+        ASSERT_EQ( 0, mkdir( ( root + name ).c_str(), 0700 ) );
+    }
+
+    std::shared_ptr<fs::IFile> find( const fs::IDirectory& dir,
+                                     const std::string& name )
+    {
+        const auto& files = dir.files();
+        auto it = std::find_if( cbegin( files ), cend( files ),
+                                [&name]( const std::shared_ptr<fs::IFile>& f ) {
+            return f->name() == name;
+        });
+        if ( it == cend( files ) )
+            return nullptr;
+        return *it;
+    }
+};
+
+static void List( PosixFsTests* T )
+{
+    T->createFile( "file.mkv", "0123456789" );
+    T->createFile( "with space.mp3" );
+    T->createFile( ".hidden.mkv" );
+    T->createFile( ".nomedia" );
+    T->createFile( "..notHidden.mkv" );
+    T->createDirectory( "folder" );
+    T->createDirectory( ".hiddenFolder" );
+
+    auto dir = T->fsFactory->createDirectory( T->rootMrl );
+    ASSERT_EQ( T->rootMrl, dir->mrl() );
+    const auto& files = dir->files();
+    ASSERT_EQ( 4u, files.size() );
+    ASSERT_NON_NULL( T->find( *dir, ".nomedia" ) );
+    ASSERT_NON_NULL( T->find( *dir, "..notHidden.mkv" ) );
+    ASSERT_EQ( nullptr, T->find( *dir, ".hidden.mkv" ) );
+    ASSERT_TRUE( dir->contains( ".nomedia" ) );
+
+    auto f = dir->file( T->rootMrl + "file.mkv" );
+    ASSERT_EQ( T->rootMrl + "file.mkv", f->mrl() );
+    ASSERT_EQ( 10u, f->size() );
+    ASSERT_NE( 0, f->lastModificationDate() );
+    ASSERT_FALSE( f->isNetwork() );
+    ASSERT_EQ( fs::IFile::LinkedFileType::None, f->linkedType() );
+
+    /* File names are extracted from the encoded MRL */
+    auto f2 = T->find( *dir, "with%20space.mp3" );
+    ASSERT_NON_NULL( f2 );
+    ASSERT_EQ( T->rootMrl + "with%20space.mp3", f2->mrl() );
+
+    const auto& dirs = dir->dirs();
+    ASSERT_EQ( 1u, dirs.size() );
+    ASSERT_EQ( T->rootMrl + "folder/", dirs[0]->mrl() );
+    ASSERT_EQ( 0u, dirs[0]->files().size() );
+}
+
+static void Symlinks( PosixFsTests* T )
+{
+    T->createDirectory( "target" );
+    T->createFile( "target/file.mkv", "abc" );
+    ASSERT_EQ( 0, symlink( ( T->root + "target" ).c_str(),
+                           ( T->root + "link" ).c_str() ) );
+    ASSERT_EQ( 0, symlink( ( T->root + "target/file.mkv" ).c_str(),
+                           ( T->root + "link.mkv" ).c_str() ) );
+    ASSERT_EQ( 0, symlink( ( T->root + "nowhere" ).c_str(),
+                           ( T->root + "dangling.mkv" ).c_str() ) );
+
+    auto dir = T->fsFactory->createDirectory( T->rootMrl );
+    ASSERT_EQ( 2u, dir->dirs().size() );
+    ASSERT_EQ( 1u, dir->files().size() );
+    auto f = T->find( *dir, "link.mkv" );
+    ASSERT_NON_NULL( f );
+    ASSERT_EQ( 3u, f->size() );
+}
+
+static void LinkedFiles( PosixFsTests* T )
+{
+    T->createFile( "My.Movie.mkv" );
+    T->createFile( "My Movie.en.srt" );
+    T->createFile( "my.movie.ac3" );
+    T->createFile( "Other.mkv" );
+    T->createFile( "Unrelated.srt" );
+    T->createFile( "Lonely.ac3" );
+
+    auto dir = T->fsFactory->createDirectory( T->rootMrl );
+    ASSERT_EQ( 6u, dir->files().size() );
+
+    auto sub = T->find( *dir, "My%20Movie.en.srt" );
+    ASSERT_NON_NULL( sub );
+    ASSERT_EQ( fs::IFile::LinkedFileType::Subtitles, sub->linkedType() );
+    ASSERT_EQ( T->rootMrl + "My.Movie.mkv", sub->linkedWith() );
+
+    auto soundtrack = T->find( *dir, "my.movie.ac3" );
+    ASSERT_NON_NULL( soundtrack );
+    ASSERT_EQ( fs::IFile::LinkedFileType::SoundTrack, soundtrack->linkedType() );
+    ASSERT_EQ( T->rootMrl + "My.Movie.mkv", soundtrack->linkedWith() );
+
+    auto unrelated = T->find( *dir, "Unrelated.srt" );
+    ASSERT_NON_NULL( unrelated );
+    ASSERT_EQ( fs::IFile::LinkedFileType::None, unrelated->linkedType() );
+
+    auto lonely = T->find( *dir, "Lonely.ac3" );
+    ASSERT_NON_NULL( lonely );
+    ASSERT_EQ( fs::IFile::LinkedFileType::None, lonely->linkedType() );
+
+    auto movie = T->find( *dir, "My.Movie.mkv" );
+    ASSERT_NON_NULL( movie );
+    ASSERT_EQ( fs::IFile::LinkedFileType::None, movie->linkedType() );
+}
+
+static void ManyFiles( PosixFsTests* T )
+{
+    /* Ensure the batched stats properly handle more files than the queue depth */
+    const auto nbFiles = 300u;
+    for ( auto i = 0u; i < nbFiles; ++i )
+        T->createFile( "file" + std::to_string( i ) + ".mkv",
+                       std::string( i, 'x' ) );
+
+    auto dir = T->fsFactory->createDirectory( T->rootMrl );
+    const auto& files = dir->files();
+    ASSERT_EQ( nbFiles, files.size() );
+    for ( auto i = 0u; i < nbFiles; ++i )
+    {
+        auto f = T->find( *dir, "file" + std::to_string( i ) + ".mkv" );
+        ASSERT_NON_NULL( f );
+        ASSERT_EQ( i, f->size() );
+    }
+}
+
+static void NotFound( PosixFsTests* T )
+{
+    auto dir = T->fsFactory->createDirectory( T->rootMrl + "missing/" );
+    ASSERT_THROW( dir->files(), fs::errors::System );
+}
+
+int main( int ac, char** av )
+{
+    INIT_TESTS_C( PosixFsTests );
+
+    ADD_TEST( List );
+    ADD_TEST( Symlinks );
+    ADD_TEST( LinkedFiles );
+    ADD_TEST( ManyFiles );
+    ADD_TEST( NotFound );
+
+    END_TESTS
+}
@@ -0,0 +1,272 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "UnitTests.h"
+
+#include "Media.h"
+#include "database/SqliteConnection.h"
+#include "common/NoopCallback.h"
+
+#include <atomic>
+
+class HistoryCallback : public mock::NoopCallback
+{
+public:
+    HistoryCallback() : m_nbHistoryChanged( 0 ) {}
+
+    virtual void onHistoryChanged( HistoryType ) override
+    {
+        ++m_nbHistoryChanged;
+    }
+
+    uint32_t nbHistoryChanged() const
+    {
+        return m_nbHistoryChanged;
+    }
+
+private:
+    std::atomic_uint32_t m_nbHistoryChanged;
+};
+
+struct ProgressTests : public UnitTests<HistoryCallback>
+{
+    virtual void InstantiateMediaLibrary( const std::string& dbPath,
+                                          const std::string& mlFolderDir,
+                                          const SetupConfig* cfg ) override
+    {
+        auto deferredCfg = *cfg;
+        deferredCfg.progressDurability = ProgressDurability::Deferred;
+        /* Only flush explicitly to keep the tests deterministic */
+        deferredCfg.progressFlushPeriod = std::chrono::hours{ 1 };
+        ml.reset( new MediaLibraryTester( dbPath, mlFolderDir, &deferredCfg ) );
+    }
+
+    /* Fetches the progress as stored in database, bypassing the buffer */
+    std::pair<float, uint32_t> storedProgress( int64_t mediaId )
+    {
+        return storedProgress( ml->getConn(), mediaId );
+    }
+
+    static std::pair<float, uint32_t> storedProgress( sqlite::Connection* dbConn,
+                                                      int64_t mediaId )
+    {
+        OPEN_READ_CONTEXT( ctx, dbConn );
+        sqlite::Statement stmt{
+            "SELECT last_position, play_count FROM Media WHERE id_media = ?"
+        };
+        stmt.execute( mediaId );
+        auto row = stmt.row();
+        float position;
+        uint32_t playCount;
+        row >> position >> playCount;
+        return { position, playCount };
+    }
+};
+
+static void DeferredWrite( ProgressTests* T )
+{
+    auto m = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media.mkv", IMedia::Type::Video ) );
+    m->setDuration( 60 * 30 * 1000 );
+
+    auto res = m->setLastPosition( 0.5f );
+    ASSERT_EQ( IMedia::ProgressResult::AsIs, res );
+    ASSERT_EQ( 0.5f, m->lastPosition() );
+    ASSERT_EQ( -1.f, T->storedProgress( m->id() ).first );
+
+    /* The pending progress must be visible when fetching the media again */
+    m = T->ml->media( m->id() );
+    ASSERT_EQ( 0.5f, m->lastPosition() );
+    ASSERT_EQ( m->duration() / 2, m->lastTime() );
+    ASSERT_NE( 0, m->lastPlayedDate() );
+
+    res = m->setLastPosition( 0.6f );
+    ASSERT_EQ( IMedia::ProgressResult::AsIs, res );
+    auto flushed = T->ml->flushPlaybackProgress();
+    ASSERT_TRUE( flushed );
+    ASSERT_EQ( 0.6f, T->storedProgress( m->id() ).first );
+    m = T->ml->media( m->id() );
+    ASSERT_EQ( 0.6f, m->lastPosition() );
+}
+
+static void CoalescedPlayCount( ProgressTests* T )
+{
+    auto m = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media.mkv", IMedia::Type::Video ) );
+    m->setDuration( 60 * 30 * 1000 );
+
+    auto res = m->setLastPosition( 0.99f );
+    ASSERT_EQ( IMedia::ProgressResult::End, res );
+    res = m->setLastPosition( 0.5f );
+    ASSERT_EQ( IMedia::ProgressResult::AsIs, res );
+    res = m->setLastPosition( 0.99f );
+    ASSERT_EQ( IMedia::ProgressResult::End, res );
+    ASSERT_EQ( 2u, m->playCount() );
+    ASSERT_EQ( 0u, T->storedProgress( m->id() ).second );
+
+    m = T->ml->media( m->id() );
+    ASSERT_EQ( 2u, m->playCount() );
+    ASSERT_EQ( -1.f, m->lastPosition() );
+
+    auto flushed = T->ml->flushPlaybackProgress();
+    ASSERT_TRUE( flushed );
+    auto stored = T->storedProgress( m->id() );
+    ASSERT_EQ( -1.f, stored.first );
+    ASSERT_EQ( 2u, stored.second );
+
+    /* Setting the play count explicitly must not be offset by a pending update */
+    res = m->setLastPosition( 0.99f );
+    ASSERT_EQ( IMedia::ProgressResult::End, res );
+    auto success = m->setPlayCount( 10 );
+    ASSERT_TRUE( success );
+    ASSERT_EQ( 10u, T->storedProgress( m->id() ).second );
+    m = T->ml->media( m->id() );
+    ASSERT_EQ( 10u, m->playCount() );
+}
+
+static void History( ProgressTests* T )
+{
+    auto m1 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media1.mkv", IMedia::Type::Video ) );
+    auto m2 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media2.mkv", IMedia::Type::Video ) );
+
+    auto history = T->ml->history( HistoryType::Local, nullptr )->all();
+    ASSERT_EQ( 0u, history.size() );
+
+    m1->setLastPosition( 0.5f );
+    history = T->ml->history( HistoryType::Local, nullptr )->all();
+    ASSERT_EQ( 1u, history.size() );
+    ASSERT_EQ( m1->id(), history[0]->id() );
+
+    auto success = m1->removeFromHistory();
+    ASSERT_TRUE( success );
+    m2->setLastPosition( 0.5f );
+    history = T->ml->history( HistoryType::Local, nullptr )->all();
+    ASSERT_EQ( 1u, history.size() );
+    ASSERT_EQ( m2->id(), history[0]->id() );
+
+    success = T->ml->clearHistory( HistoryType::Global );
+    ASSERT_TRUE( success );
+    m2 = T->ml->media( m2->id() );
+    ASSERT_EQ( -1.f, m2->lastPosition() );
+    history = T->ml->history( HistoryType::Local, nullptr )->all();
+    ASSERT_EQ( 0u, history.size() );
+}
+
+static void HistoryNotifications( ProgressTests* T )
+{
+    auto m1 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media1.mkv", IMedia::Type::Video ) );
+    auto m2 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media2.mkv", IMedia::Type::Video ) );
+    ASSERT_EQ( 0u, T->cbMock->nbHistoryChanged() );
+
+    m1->setLastPosition( 0.1f );
+    ASSERT_EQ( 1u, T->cbMock->nbHistoryChanged() );
+    /* The history ordering didn't change, we shouldn't be notified again */
+    m1->setLastPosition( 0.2f );
+    m1->setLastPosition( 0.3f );
+    ASSERT_EQ( 1u, T->cbMock->nbHistoryChanged() );
+
+    m2->setLastPosition( 0.1f );
+    ASSERT_EQ( 2u, T->cbMock->nbHistoryChanged() );
+    m1->setLastPosition( 0.4f );
+    ASSERT_EQ( 3u, T->cbMock->nbHistoryChanged() );
+
+    auto success = m1->removeFromHistory();
+    ASSERT_TRUE( success );
+    ASSERT_EQ( 4u, T->cbMock->nbHistoryChanged() );
+    m1->setLastPosition( 0.5f );
+    ASSERT_EQ( 5u, T->cbMock->nbHistoryChanged() );
+}
+
+static void ImmediateHistoryNotifications( ProgressTests* T )
+{
+    T->ml->progressBuffer().setDurability( ProgressDurability::Immediate,
+                                           std::chrono::seconds{ 0 } );
+    auto m = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media.mkv", IMedia::Type::Video ) );
+
+    /* Each progress update is written & notified right away */
+    m->setLastPosition( 0.1f );
+    ASSERT_EQ( 1u, T->cbMock->nbHistoryChanged() );
+    ASSERT_EQ( 0.1f, T->storedProgress( m->id() ).first );
+    m->setLastPosition( 0.2f );
+    ASSERT_EQ( 2u, T->cbMock->nbHistoryChanged() );
+    ASSERT_EQ( 0.2f, T->storedProgress( m->id() ).first );
+}
+
+static void ListingSync( ProgressTests* T )
+{
+    auto m = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media.mkv", IMedia::Type::Video ) );
+
+    /* Building the queries must not write the pending updates */
+    auto history = T->ml->history( HistoryType::Local, nullptr );
+    auto inProgress = T->ml->inProgressMedia( IMedia::Type::Unknown, nullptr );
+    m->setLastPosition( 0.5f );
+    ASSERT_EQ( -1.f, T->storedProgress( m->id() ).first );
+
+    /* but running them must account for the updates recorded since then */
+    ASSERT_EQ( 1u, history->count() );
+    ASSERT_EQ( 0.5f, T->storedProgress( m->id() ).first );
+
+    m->setLastPosition( 0.6f );
+    auto media = inProgress->items( 10, 0 );
+    ASSERT_EQ( 1u, media.size() );
+    ASSERT_EQ( 0.6f, T->storedProgress( m->id() ).first );
+    ASSERT_EQ( 0.6f, media[0]->lastPosition() );
+}
+
+static void FlushOnShutdown( ProgressTests* T )
+{
+    auto m = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media.mkv", IMedia::Type::Video ) );
+    auto mediaId = m->id();
+    m->setLastPosition( 0.5f );
+    m.reset();
+    ASSERT_EQ( -1.f, T->storedProgress( mediaId ).first );
+
+    T->ml.reset();
+    auto dbConn = sqlite::Connection::connect( T->getDbPath() );
+    ASSERT_EQ( 0.5f, ProgressTests::storedProgress( dbConn.get(), mediaId ).first );
+}
+
+int main( int ac, char** av )
+{
+    INIT_TESTS_C( ProgressTests );
+
+    ADD_TEST( DeferredWrite );
+    ADD_TEST( CoalescedPlayCount );
+    ADD_TEST( History );
+    ADD_TEST( HistoryNotifications );
+    ADD_TEST( ImmediateHistoryNotifications );
+    ADD_TEST( ListingSync );
+    ADD_TEST( FlushOnShutdown );
+
+    END_TESTS;
+}
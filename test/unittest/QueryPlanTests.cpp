@@ -0,0 +1,325 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "UnitTests.h"
+
+#include "Media.h"
+#include "database/SqliteTools.h"
+#include "LibraryGenerator.h"
+
+#include <sqlite3.h>
+#include <cstring>
+
+namespace
+{
+
+/*
+ * The query plans are checked against a generated library with up to date
+ * statistics, as the plans chosen for an empty database aren't the ones
+ * sqlite picks for an actual library
+ */
+class QueryPlan : public Tests
+{
+protected:
+    virtual void TestSpecificSetup() override
+    {
+        generateLibrary( ml.get(), *fsMock->device( mock::FileSystemFactory::Root ),
+                         mock::FileSystemFactory::Root + "library/",
+                         NbMedia, 0x6d6c );
+        const std::string req = "ANALYZE";
+        sqlite::Tools::executeRequest( ml->getConn(), req );
+    }
+
+private:
+    static constexpr uint32_t NbMedia = 2000;
+};
+
+/*
+ * Captures the listing requests executed on the calling thread's connection,
+ * so their query plan can be inspected afterward
+ */
+class RequestCapture
+{
+public:
+    RequestCapture( MediaLibraryTester* ml )
+        : m_ctx( ml->getConn()->acquireReadContext() )
+    {
+        sqlite3_trace_v2( m_ctx.handle(), SQLITE_TRACE_STMT, &onStatement, this );
+    }
+
+    ~RequestCapture()
+    {
+        sqlite3_trace_v2( m_ctx.handle(), 0, nullptr, nullptr );
+    }
+
+    /**
+     * @brief plan Returns the query plan of the last captured SELECT request
+     */
+    std::vector<std::string> plan()
+    {
+        std::vector<std::string> res;
+        sqlite::Statement stmt{ "EXPLAIN QUERY PLAN " + m_lastSelect };
+        stmt.execute();
+        sqlite::Row row;
+        while ( ( row = stmt.row() ) != nullptr )
+            res.push_back( row.load<std::string>( 3 ) );
+        m_lastSelect.clear();
+        return res;
+    }
+
+    const std::string& lastRequest() const
+    {
+        return m_lastSelect;
+    }
+
+private:
+    static int onStatement( unsigned int, void* data, void* p, void* )
+    {
+        auto self = static_cast<RequestCapture*>( data );
+        auto req = sqlite3_sql( static_cast<sqlite3_stmt*>( p ) );
+        if ( req != nullptr && strncmp( req, "SELECT", 6 ) == 0 &&
+             strncmp( req, "SELECT COUNT", 12 ) != 0 )
+            self->m_lastSelect = req;
+        return 0;
+    }
+
+private:
+    sqlite::Connection::ReadContext m_ctx;
+    std::string m_lastSelect;
+};
+
+}
+
+enum class Order
+{
+    /* The listing is read in the requested order from an index */
+    Indexed,
+    /*
+     * The listing is read from an index providing the first sort key, and
+     * only the rows sharing the same key are sorted afterward
+     */
+    TieBreak,
+    /*
+     * The whole listing is sorted, which is expected when ordering by a
+     * joined table column or by a value aggregated over the media
+     */
+    Sorted,
+};
+
+/*
+ * The joined tables must always be reached through a key or an index search,
+ * and the listed table can only be walked without an index when the whole
+ * listing needs to be sorted anyway.
+ * The expected order must match the plan exactly, so that a sort sneaking
+ * back in fails, as well as an expectation which is no longer needed.
+ */
+static void checkPlan( RequestCapture& capture, const std::string& table,
+                       Order order )
+{
+    auto req = capture.lastRequest();
+    if ( req.empty() == true )
+        FAIL_TEST_MSG( "No listing request was captured" );
+    auto plan = capture.plan();
+    auto sorted = false;
+    auto tieBreak = false;
+    for ( const auto& step : plan )
+    {
+        auto unexpected = false;
+        if ( step.compare( 0, 5, "SCAN " ) == 0 && step != "SCAN CONSTANT ROW" )
+        {
+            auto name = step.substr( 5, step.find( ' ', 5 ) - 5 );
+            auto throughIndex = step.find( " USING INDEX " ) != std::string::npos ||
+                    step.find( " USING COVERING INDEX " ) != std::string::npos;
+            if ( name != table ||
+                 ( throughIndex == false && order != Order::Sorted ) )
+                unexpected = true;
+        }
+        else if ( step == "USE TEMP B-TREE FOR RIGHT PART OF ORDER BY" )
+        {
+            tieBreak = true;
+            unexpected = order != Order::TieBreak;
+        }
+        else if ( step.find( "TEMP B-TREE" ) != std::string::npos )
+        {
+            sorted = true;
+            unexpected = order != Order::Sorted;
+        }
+        if ( unexpected == true )
+        {
+            std::string msg = "Unexpected '" + step + "' step for request: " + req;
+            FAIL_TEST_MSG( msg );
+        }
+    }
+    if ( ( order == Order::Sorted && sorted == false ) ||
+         ( order == Order::TieBreak && tieBreak == false ) )
+        FAIL_TEST_MSG( "The expected sort wasn't used by request: " + req );
+}
+
+template <typename Listing, typename Expected>
+static void checkListing( Tests* T, const std::string& table,
+                          Listing&& listing, Expected&& expected )
+{
+    RequestCapture capture{ T->ml.get() };
+    auto last = static_cast<int>( SortingCriteria::TrackNumberAlbumReleaseYear );
+    for ( auto i = 0; i <= last; ++i )
+    {
+        auto sort = static_cast<SortingCriteria>( i );
+        for ( auto desc : { false, true } )
+        {
+            QueryParameters params{};
+            params.sort = sort;
+            params.desc = desc;
+            auto query = listing( &params );
+            ASSERT_NON_NULL( query );
+            query->items( 10, 0 );
+            checkPlan( capture, table, expected( sort ) );
+        }
+    }
+}
+
+/*
+ * Those criteria order by a column from a joined table (file, album or artist)
+ * which can't be covered by an index on the media table.
+ * The others are read from the per type indexes, or from the media table
+ * indexes when the listing isn't restricted to a single type.
+ */
+static Order mediaOrder( SortingCriteria sort )
+{
+    switch ( sort )
+    {
+        case SortingCriteria::LastModificationDate:
+        case SortingCriteria::FileSize:
+        case SortingCriteria::Artist:
+        case SortingCriteria::Album:
+        case SortingCriteria::TrackId:
+        case SortingCriteria::TrackNumberAlbumReleaseYear:
+            return Order::Sorted;
+        default:
+            return Order::Indexed;
+    }
+}
+
+/*
+ * Albums with the same title are ordered by artist name, which isn't part of
+ * the album title index. The duration and release year aren't indexed, and
+ * the play count & insertion date are aggregated over the album tracks.
+ */
+static Order albumOrder( SortingCriteria sort )
+{
+    switch ( sort )
+    {
+        case SortingCriteria::TrackNumber:
+            return Order::Indexed;
+        case SortingCriteria::Artist:
+        case SortingCriteria::Duration:
+        case SortingCriteria::ReleaseDate:
+        case SortingCriteria::PlayCount:
+        case SortingCriteria::InsertionDate:
+            return Order::Sorted;
+        default:
+            return Order::TieBreak;
+    }
+}
+
+/* The artist counters aren't indexed, and the last playback is aggregated */
+static Order artistOrder( SortingCriteria sort )
+{
+    switch ( sort )
+    {
+        case SortingCriteria::TrackNumber:
+        case SortingCriteria::NbAlbum:
+        case SortingCriteria::LastPlaybackDate:
+            return Order::Sorted;
+        default:
+            return Order::Indexed;
+    }
+}
+
+static void AudioListing( QueryPlan* T )
+{
+    checkListing( T, "m", [T]( const QueryParameters* params ) {
+        return T->ml->audioFiles( params );
+    }, mediaOrder );
+}
+
+static void VideoListing( QueryPlan* T )
+{
+    checkListing( T, "m", [T]( const QueryParameters* params ) {
+        return T->ml->videoFiles( params );
+    }, mediaOrder );
+}
+
+static void MovieListing( QueryPlan* T )
+{
+    checkListing( T, "m", [T]( const QueryParameters* params ) {
+        return T->ml->movies( params );
+    }, mediaOrder );
+}
+
+static void MediaListing( QueryPlan* T )
+{
+    checkListing( T, "m", [T]( const QueryParameters* params ) {
+        return T->ml->mediaFiles( params );
+    }, mediaOrder );
+}
+
+static void AlbumListing( QueryPlan* T )
+{
+    checkListing( T, "alb", [T]( const QueryParameters* params ) {
+        return T->ml->albums( params );
+    }, albumOrder );
+}
+
+static void ArtistListing( QueryPlan* T )
+{
+    checkListing( T, "art", [T]( const QueryParameters* params ) {
+        return T->ml->artists( ArtistIncluded::All, params );
+    }, artistOrder );
+}
+
+static void GenreListing( QueryPlan* T )
+{
+    checkListing( T, "Genre", [T]( const QueryParameters* params ) {
+        return T->ml->genres( params );
+    }, []( SortingCriteria ) {
+        return Order::Indexed;
+    });
+}
+
+int main( int ac, char** av )
+{
+    INIT_TESTS_C( QueryPlan );
+
+    ADD_TEST( AudioListing );
+    ADD_TEST( VideoListing );
+    ADD_TEST( MovieListing );
+    ADD_TEST( MediaListing );
+    ADD_TEST( AlbumListing );
+    ADD_TEST( ArtistListing );
+    ADD_TEST( GenreListing );
+
+    END_TESTS;
+}
@@ -323,6 +323,36 @@ static void CheckShowEpisodeDbModel( Tests* T )
     ASSERT_TRUE( res );
 }
 
+static void ListPublic( Tests* T )
+{
+    auto show = T->ml->createShow( "The Otters Show" );
+    auto show2 = T->ml->createShow( "The Otters Show: The Sequel" );
+    auto media = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "Fluffy otters.mkv", IMedia::Type::Video ) );
+    auto media2 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "Juggling otters.mkv", IMedia::Type::Video ) );
+    show->addEpisode( *media, 1, 1, "episode title" );
+    show2->addEpisode( *media2, 1, 1, "episode title" );
+
+    QueryParameters params{};
+    params.publicOnly = true;
+    ASSERT_EQ( 0u, T->ml->shows( &params )->count() );
+
+    T->ml->markMediaAsPublic( media2->id() );
+    auto shows = T->ml->shows( &params )->all();
+    ASSERT_EQ( 1u, shows.size() );
+    ASSERT_EQ( show2->id(), shows[0]->id() );
+
+    auto res = ShowEpisode::deleteByMediaId( T->ml.get(), media2->id() );
+    ASSERT_TRUE( res );
+    ASSERT_EQ( 0u, T->ml->shows( &params )->count() );
+
+    T->ml->markMediaAsPublic( media->id() );
+    ASSERT_EQ( 1u, T->ml->shows( &params )->count() );
+    T->ml->deleteMedia( media->id() );
+    ASSERT_EQ( 0u, T->ml->shows( &params )->count() );
+}
+
 static void NbEpisodes( Tests* T )
 {
     auto show = T->ml->createShow( "The Otters Show" );
@@ -386,6 +416,37 @@ static void DeleteEpisodeByMediaId( Tests* T )
     ASSERT_EQ( 0u, show->nbEpisodes() );
 }
 
+static void Page( Tests* T )
+{
+    std::vector<ShowPtr> shows;
+    for ( auto i = 0u; i < 3; ++i )
+    {
+        auto show = T->ml->createShow( "show " + std::to_string( i ) );
+        auto media = std::static_pointer_cast<Media>(
+                    T->ml->addMedia( "media" + std::to_string( i ) + ".mkv",
+                                     IMedia::Type::Video ) );
+        show->addEpisode( *media, 1, 1, "episode title" );
+        show->setReleaseDate( i );
+        shows.push_back( std::move( show ) );
+    }
+    QueryParameters params{ SortingCriteria::Alpha, false };
+    auto page = T->ml->shows( &params )->page( 2, 1 );
+    ASSERT_EQ( 3u, page.count );
+    ASSERT_EQ( 2u, page.items.size() );
+    ASSERT_EQ( shows[1]->id(), page.items[0]->id() );
+    ASSERT_EQ( "show 1", page.items[0]->title() );
+    ASSERT_EQ( 1u, page.items[0]->nbEpisodes() );
+    ASSERT_EQ( shows[2]->id(), page.items[1]->id() );
+    ASSERT_EQ( 2, page.items[1]->releaseDate() );
+
+    T->ml->markMediaAsPublic( shows[2]->episodes( nullptr )->all()[0]->id() );
+    params.publicOnly = true;
+    page = T->ml->shows( &params )->page( 5, 0 );
+    ASSERT_EQ( 1u, page.count );
+    ASSERT_EQ( 1u, page.items.size() );
+    ASSERT_EQ( shows[2]->id(), page.items[0]->id() );
+}
+
 int main( int ac, char** av )
 {
     INIT_TESTS( Show );
@@ -410,6 +471,8 @@ int main( int ac, char** av )
     ADD_TEST( CheckShowEpisodeDbModel );
     ADD_TEST( NbEpisodes );
     ADD_TEST( DeleteEpisodeByMediaId );
+    ADD_TEST( ListPublic );
+    ADD_TEST( Page );
 
     END_TESTS;
 }
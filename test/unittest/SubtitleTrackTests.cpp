@@ -115,6 +115,23 @@ static void UnlinkExternalTrack( Tests* T )
     ASSERT_EQ( 0u, tracks.size() );
 }
 
+static void Page( Tests* T )
+{
+    auto media = std::static_pointer_cast<Media>( T->ml->addMedia( "media.mkv", IMedia::Type::Video ) );
+    media->addSubtitleTrack( "sea", "otter", "awareness", "week", 0 );
+    media->addSubtitleTrack( "best", "time", "of", "year", 0 );
+
+    auto expected = media->subtitleTracks()->all();
+    auto page = media->subtitleTracks()->page( 1, 1 );
+    ASSERT_EQ( 2u, page.count );
+    ASSERT_EQ( 1u, page.items.size() );
+    ASSERT_EQ( expected[1]->id(), page.items[0]->id() );
+    ASSERT_EQ( "best",      page.items[0]->codec() );
+    ASSERT_EQ( "time",      page.items[0]->language() );
+    ASSERT_EQ( "of",        page.items[0]->description() );
+    ASSERT_EQ( "year",      page.items[0]->encoding() );
+}
+
 int main( int ac, char** av )
 {
     INIT_TESTS(SubtitleTrack);
@@ -124,6 +141,7 @@ int main( int ac, char** av )
     ADD_TEST( RemoveTrack );
     ADD_TEST( CheckDbModel );
     ADD_TEST( UnlinkExternalTrack );
+    ADD_TEST( Page );
 
     END_TESTS;
 }
@@ -0,0 +1,332 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "UnitTests.h"
+
+#include "Album.h"
+#include "Artist.h"
+#include "Media.h"
+#include "Thumbnail.h"
+#include "thumbnails/ThumbnailStore.h"
+#include "utils/File.h"
+#include "utils/Filename.h"
+#include "utils/Url.h"
+
+#include <cstdio>
+
+/* Keeps the database content across restarts */
+class MediaLibraryTesterKeepTables : public MediaLibraryTester
+{
+public:
+    using MediaLibraryTester::MediaLibraryTester;
+
+    virtual void onDbConnectionReady( sqlite::Connection* ) override
+    {
+    }
+};
+
+struct ThumbnailStoreTests : public Tests
+{
+    virtual void InstantiateMediaLibrary( const std::string& dbPath,
+                                          const std::string& mlDir,
+                                          const SetupConfig* cfg ) override
+    {
+        auto packCfg = *cfg;
+        packCfg.packThumbnails = true;
+        Tests::InstantiateMediaLibrary( dbPath, mlDir, &packCfg );
+        m_dbPath = dbPath;
+        m_mlDir = mlDir;
+        m_cfg = *cfg;
+    }
+
+    /* Restarts the media library without the thumbnail store */
+    void restartUnpacked()
+    {
+        ml.reset();
+        ml.reset( new MediaLibraryTesterKeepTables( m_dbPath, m_mlDir, &m_cfg ) );
+        ml->setFsFactory( fsMock );
+        ASSERT_EQ( InitializeResult::Success, ml->initialize( cbMock.get() ) );
+    }
+
+    std::string writeThumbnail( const std::string& fileName,
+                                const std::string& content )
+    {
+        auto path = ml->thumbnailPath() + fileName;
+        auto f = fopen( path.c_str(), "wb" );
+        if ( f == nullptr )
+            return {};
+        fwrite( content.data(), 1, content.size(), f );
+        fclose( f );
+        return utils::file::toMrl( path );
+    }
+
+    bool exists( const std::string& mrl )
+    {
+        uint64_t size;
+        time_t mtime;
+        return utils::fs::fileInfo( utils::url::toLocalPath( mrl ), size, mtime );
+    }
+
+    static std::string toString( const ThumbnailData& d )
+    {
+        return std::string{ reinterpret_cast<const char*>( d.data ), d.size };
+    }
+
+private:
+    std::string m_dbPath;
+    std::string m_mlDir;
+    SetupConfig m_cfg;
+};
+
+static void Pack( ThumbnailStoreTests* T )
+{
+    auto store = T->ml->thumbnailStore();
+    ASSERT_NON_NULL( store );
+
+    auto mrl = T->writeThumbnail( "1.jpg", "first thumbnail" );
+    ASSERT_TRUE( store->pack( mrl ) );
+    /* The source file is removed once packed */
+    ASSERT_FALSE( T->exists( mrl ) );
+
+    auto data = store->read( mrl );
+    ASSERT_NE( 0u, data.size );
+    ASSERT_EQ( "first thumbnail", T->toString( data ) );
+
+    /* Replacing a thumbnail must return the most recent content */
+    mrl = T->writeThumbnail( "1.jpg", "updated thumbnail" );
+    ASSERT_TRUE( store->pack( mrl ) );
+    ASSERT_EQ( "updated thumbnail", T->toString( store->read( mrl ) ) );
+    /* The previous view remains valid */
+    ASSERT_EQ( "first thumbnail", T->toString( data ) );
+
+    auto unknown = utils::file::toMrl( T->ml->thumbnailPath() + "2.jpg" );
+    ASSERT_EQ( 0u, store->read( unknown ).size );
+
+    /* Files outside of the thumbnail folder can't be packed */
+    ASSERT_FALSE( store->pack( "file:///path/to/thumbnail.jpg" ) );
+
+    ASSERT_TRUE( store->remove( "1.jpg" ) );
+    ASSERT_EQ( 0u, store->read( mrl ).size );
+}
+
+static void PackBuffer( ThumbnailStoreTests* T )
+{
+    auto store = T->ml->thumbnailStore();
+    ASSERT_NON_NULL( store );
+
+    auto mrl = utils::file::toMrl( T->ml->thumbnailPath() + "1.jpg" );
+    const std::string content = "encoded thumbnail";
+    auto data = reinterpret_cast<const uint8_t*>( content.data() );
+    ASSERT_TRUE( store->pack( mrl, data, content.size() ) );
+    /* Nothing goes through the thumbnail file */
+    ASSERT_FALSE( T->exists( mrl ) );
+    ASSERT_EQ( content, T->toString( store->read( mrl ) ) );
+
+    ASSERT_FALSE( store->pack( mrl, data, 0 ) );
+    ASSERT_FALSE( store->pack( "file:///path/to/thumbnail.jpg", data, content.size() ) );
+}
+
+static void MediaThumbnailData( ThumbnailStoreTests* T )
+{
+    auto m = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media.mkv", IMedia::Type::Video ) );
+    ASSERT_EQ( 0u, m->thumbnailData( ThumbnailSizeType::Thumbnail ).size );
+
+    auto mrl = T->writeThumbnail( "media.jpg", "packed content" );
+    auto res = m->setThumbnail( std::make_shared<Thumbnail>( T->ml.get(), mrl,
+                                    Thumbnail::Origin::Media,
+                                    ThumbnailSizeType::Thumbnail, true ) );
+    ASSERT_TRUE( res );
+    ASSERT_TRUE( T->ml->thumbnailStore()->pack( mrl ) );
+
+    m = T->ml->media( m->id() );
+    /* The mrl is kept as is, but the content is served from the store */
+    ASSERT_EQ( mrl, m->thumbnailMrl( ThumbnailSizeType::Thumbnail ) );
+    auto data = m->thumbnailData( ThumbnailSizeType::Thumbnail );
+    ASSERT_EQ( "packed content", T->toString( data ) );
+    ASSERT_EQ( 0u, m->thumbnailData( ThumbnailSizeType::Banner ).size );
+
+    /* Thumbnails which aren't owned are never packed */
+    res = m->setThumbnail( "file:///path/to/thumbnail.jpg",
+                           ThumbnailSizeType::Banner );
+    ASSERT_TRUE( res );
+    ASSERT_EQ( 0u, m->thumbnailData( ThumbnailSizeType::Banner ).size );
+}
+
+static void SharedThumbnailData( ThumbnailStoreTests* T )
+{
+    auto m = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "track.mp3", IMedia::Type::Audio ) );
+    auto mrl = T->writeThumbnail( "track.jpg", "shared content" );
+    auto res = m->setThumbnail( std::make_shared<Thumbnail>( T->ml.get(), mrl,
+                                    Thumbnail::Origin::Media,
+                                    ThumbnailSizeType::Thumbnail, true ) );
+    ASSERT_TRUE( res );
+    ASSERT_TRUE( T->ml->thumbnailStore()->pack( mrl ) );
+
+    /* Albums & artists share the thumbnail with their tracks */
+    auto album = std::static_pointer_cast<Album>( T->ml->createAlbum( "album" ) );
+    auto artist = std::static_pointer_cast<Artist>( T->ml->createArtist( "artist" ) );
+    ASSERT_EQ( 0u, album->thumbnailData( ThumbnailSizeType::Thumbnail ).size );
+    ASSERT_EQ( 0u, artist->thumbnailData( ThumbnailSizeType::Thumbnail ).size );
+    auto t = m->thumbnail( ThumbnailSizeType::Thumbnail );
+    ASSERT_TRUE( album->setThumbnail( t ) );
+    ASSERT_TRUE( artist->setThumbnail( t ) );
+
+    album = std::static_pointer_cast<Album>( T->ml->album( album->id() ) );
+    artist = std::static_pointer_cast<Artist>( T->ml->artist( artist->id() ) );
+    ASSERT_EQ( mrl, album->thumbnailMrl( ThumbnailSizeType::Thumbnail ) );
+    ASSERT_EQ( "shared content", T->toString(
+                   album->thumbnailData( ThumbnailSizeType::Thumbnail ) ) );
+    ASSERT_EQ( "shared content", T->toString(
+                   artist->thumbnailData( ThumbnailSizeType::Thumbnail ) ) );
+    ASSERT_EQ( 0u, album->thumbnailData( ThumbnailSizeType::Banner ).size );
+}
+
+static void Compact( ThumbnailStoreTests* T )
+{
+    /* Use some tiny segments, 3 thumbnails per segment */
+    ThumbnailStore store{ T->ml.get(), 39 };
+    store.initialize();
+
+    const std::string names[] = { "1.jpg", "2.jpg", "3.jpg", "4.jpg" };
+    for ( const auto& n : names )
+    {
+        auto mrl = T->writeThumbnail( n, "content_" + n );
+        ASSERT_TRUE( store.pack( mrl ) );
+    }
+    auto firstSegment = ThumbnailStore::segmentPath( T->ml.get(), 1 );
+    ASSERT_EQ( 39u, utils::fs::fileSize( firstSegment ) );
+    ASSERT_EQ( 13u, utils::fs::fileSize(
+                   ThumbnailStore::segmentPath( T->ml.get(), 2 ) ) );
+
+    /* Nothing to reclaim yet */
+    store.compact();
+    ASSERT_EQ( 39u, utils::fs::fileSize( firstSegment ) );
+
+    ASSERT_TRUE( store.remove( "1.jpg" ) );
+    ASSERT_TRUE( store.remove( "2.jpg" ) );
+    store.compact();
+
+    /* The remaining thumbnail was moved to the active segment */
+    uint64_t size;
+    time_t mtime;
+    ASSERT_FALSE( utils::fs::fileInfo( firstSegment, size, mtime ) );
+    for ( auto i = 2u; i < 4; ++i )
+    {
+        auto mrl = utils::file::toMrl( T->ml->thumbnailPath() + names[i] );
+        ASSERT_EQ( "content_" + names[i], T->toString( store.read( mrl ) ) );
+    }
+    ASSERT_EQ( 0u, store.read( utils::file::toMrl(
+                        T->ml->thumbnailPath() + names[0] ) ).size );
+}
+
+static void Cleanup( ThumbnailStoreTests* T )
+{
+    /*
+     * Removing an owned thumbnail schedules a cleanup request, which must
+     * also remove the packed thumbnail
+     */
+    auto mrl = T->writeThumbnail( "cleanup.jpg", "to be removed" );
+    auto t = std::make_shared<Thumbnail>( T->ml.get(), mrl,
+                                          Thumbnail::Origin::Media,
+                                          ThumbnailSizeType::Thumbnail, true );
+    ASSERT_NE( 0, t->insert() );
+    auto store = T->ml->thumbnailStore();
+    ASSERT_TRUE( store->pack( mrl ) );
+
+    ASSERT_TRUE( Thumbnail::destroy( T->ml.get(), t->id() ) );
+    auto cleanupReqs = Thumbnail::fetchCleanups( T->ml.get() );
+    ASSERT_EQ( 1u, cleanupReqs.size() );
+    ASSERT_TRUE( store->remove( cleanupReqs.begin()->second ) );
+    ASSERT_EQ( 0u, store->read( mrl ).size );
+}
+
+static void Unpack( ThumbnailStoreTests* T )
+{
+    auto m1 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media1.mkv", IMedia::Type::Video ) );
+    auto m2 = std::static_pointer_cast<Media>(
+                T->ml->addMedia( "media2.mkv", IMedia::Type::Video ) );
+    auto mrl1 = T->writeThumbnail( "media1.jpg", "first content" );
+    auto mrl2 = T->writeThumbnail( "media2.jpg", "second content" );
+    for ( const auto& p : { std::make_pair( m1, mrl1 ), std::make_pair( m2, mrl2 ) } )
+    {
+        auto res = p.first->setThumbnail( std::make_shared<Thumbnail>( T->ml.get(),
+                                            p.second, Thumbnail::Origin::Media,
+                                            ThumbnailSizeType::Thumbnail, true ) );
+        ASSERT_TRUE( res );
+        ASSERT_TRUE( T->ml->thumbnailStore()->pack( p.second ) );
+        ASSERT_FALSE( T->exists( p.second ) );
+    }
+    /* Make the second thumbnail point past the end of its segment */
+    {
+        medialibrary::sqlite::Connection::WeakDbContext ctx{ T->ml->getConn() };
+        auto res = medialibrary::sqlite::Tools::executeUpdate( T->ml->getConn(),
+                "UPDATE " + ThumbnailStore::Table::Name +
+                " SET offset = 1000 WHERE mrl = ?", std::string{ "media2.jpg" } );
+        ASSERT_TRUE( res );
+    }
+
+    T->restartUnpacked();
+    ASSERT_EQ( nullptr, T->ml->thumbnailStore() );
+
+    /* The first thumbnail is back to being a file */
+    ASSERT_TRUE( T->exists( mrl1 ) );
+    auto path = utils::url::toLocalPath( mrl1 );
+    ASSERT_EQ( 13u, utils::fs::fileSize( path ) );
+    m1 = T->ml->media( m1->id() );
+    ASSERT_EQ( ThumbnailStatus::Available,
+               m1->thumbnailStatus( ThumbnailSizeType::Thumbnail ) );
+    ASSERT_EQ( mrl1, m1->thumbnailMrl( ThumbnailSizeType::Thumbnail ) );
+
+    /* The second one couldn't be restored and is now reported as missing */
+    ASSERT_FALSE( T->exists( mrl2 ) );
+    m2 = T->ml->media( m2->id() );
+    ASSERT_EQ( ThumbnailStatus::Missing,
+               m2->thumbnailStatus( ThumbnailSizeType::Thumbnail ) );
+
+    /* The segments are gone */
+    uint64_t size;
+    time_t mtime;
+    ASSERT_FALSE( utils::fs::fileInfo( ThumbnailStore::segmentPath( T->ml.get(), 1 ),
+                                       size, mtime ) );
+}
+
+int main( int ac, char** av )
+{
+    INIT_TESTS_C( ThumbnailStoreTests );
+
+    ADD_TEST( Pack );
+    ADD_TEST( PackBuffer );
+    ADD_TEST( MediaThumbnailData );
+    ADD_TEST( SharedThumbnailData );
+    ADD_TEST( Compact );
+    ADD_TEST( Cleanup );
+    ADD_TEST( Unpack );
+
+    END_TESTS;
+}
@@ -101,6 +101,27 @@ static void CheckDbModel( Tests* T )
     ASSERT_TRUE( res );
 }
 
+static void Page( Tests* T )
+{
+    auto f = std::static_pointer_cast<Media>( T->ml->addMedia( "file.avi", IMedia::Type::Video ) );
+    f->addVideoTrack( "H264", 1920, 1080, 3000, 100, 5678, 16, 10, "l1", "d1" );
+    f->addVideoTrack( "VP80", 640, 480, 3000, 100, 9876, 16, 9, "l2", "d2" );
+
+    auto expected = f->videoTracks()->all();
+    auto page = f->videoTracks()->page( 1, 1 );
+    ASSERT_EQ( 2u, page.count );
+    ASSERT_EQ( 1u, page.items.size() );
+    auto t = page.items[0];
+    ASSERT_EQ( expected[1]->id(), t->id() );
+    ASSERT_EQ( t->codec(), "VP80" );
+    ASSERT_EQ( t->width(), 640u );
+    ASSERT_EQ( t->height(), 480u );
+    ASSERT_EQ( t->bitrate(), 9876u );
+    ASSERT_EQ( t->sarDen(), 9u );
+    ASSERT_EQ( t->language(), "l2" );
+    ASSERT_EQ( t->description(), "d2" );
+}
+
 int main( int ac, char** av )
 {
     INIT_TESTS(VideoTrack)
@@ -109,6 +130,7 @@ int main( int ac, char** av )
     ADD_TEST( FetchTracks );
     ADD_TEST( RemoveTrack );
     ADD_TEST( CheckDbModel );
+    ADD_TEST( Page );
 
     END_TESTS
 }
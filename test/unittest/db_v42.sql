@@ -0,0 +1,1336 @@
+BEGIN;
+CREATE TABLE Settings(db_model_version UNSIGNED INTEGER NOT NULL,max_task_attempts UNSIGNED INTEGER NOT NULL,max_link_task_attempts UNSIGNED INTEGER NOT NULL,nb_cached_media_per_subscription UNSIGNED INTEGER NOT NULL,max_subscription_cache_size UNSIGNED INTEGER NOT NULL,max_cache_size UNSIGNED INTEGER NOT NULL);
+CREATE TABLE Device(id_device INTEGER PRIMARY KEY AUTOINCREMENT,uuid TEXT COLLATE NOCASE,scheme TEXT,is_removable BOOLEAN,is_present BOOLEAN,is_network BOOLEAN,last_seen UNSIGNED INTEGER,UNIQUE(uuid,scheme) ON CONFLICT FAIL);
+CREATE TABLE DeviceMountpoint(device_id INTEGER,mrl TEXT COLLATE NOCASE,last_seen INTEGER,PRIMARY KEY(device_id, mrl) ON CONFLICT REPLACE,FOREIGN KEY(device_id) REFERENCES Device(id_device) ON DELETE CASCADE);
+CREATE TABLE Folder(id_folder INTEGER PRIMARY KEY AUTOINCREMENT,path TEXT,name TEXT COLLATE NOCASE,parent_id UNSIGNED INTEGER,is_banned BOOLEAN NOT NULL DEFAULT 0,device_id UNSIGNED INTEGER,is_removable BOOLEAN NOT NULL,nb_audio UNSIGNED INTEGER NOT NULL DEFAULT 0,nb_video UNSIGNED INTEGER NOT NULL DEFAULT 0,duration UNSIGNED INTEGER NOT NULL DEFAULT 0,is_public BOOLEAN NOT NULL, is_favorite BOOLEAN NOT NULL DEFAULT FALSE,FOREIGN KEY(parent_id) REFERENCES Folder(id_folder) ON DELETE CASCADE,FOREIGN KEY(device_id) REFERENCES Device(id_device) ON DELETE CASCADE,UNIQUE(path,device_id) ON CONFLICT FAIL);
+CREATE VIRTUAL TABLE FolderFts USING FTS3(name)
+CREATE TABLE IF NOT EXISTS 'FolderFts_content'(docid INTEGER PRIMARY KEY, 'c0name');
+CREATE TABLE IF NOT EXISTS 'FolderFts_segments'(blockid INTEGER PRIMARY KEY, block BLOB);
+CREATE TABLE IF NOT EXISTS 'FolderFts_segdir'(level INTEGER,idx INTEGER,start_block INTEGER,leaves_end_block INTEGER,end_block INTEGER,root BLOB,PRIMARY KEY(level, idx));
+CREATE TABLE Thumbnail(id_thumbnail INTEGER PRIMARY KEY AUTOINCREMENT,mrl TEXT,status UNSIGNED INTEGER NOT NULL,nb_attempts UNSIGNED INTEGER DEFAULT 0,is_owned BOOLEAN NOT NULL,shared_counter INTEGER NOT NULL DEFAULT 0,file_size INTEGER,hash TEXT);
+CREATE TABLE ThumbnailLinking(entity_id UNSIGNED INTEGER NOT NULL,entity_type UNSIGNED INTEGER NOT NULL,size_type UNSIGNED INTEGER NOT NULL,thumbnail_id UNSIGNED INTEGER NOT NULL,origin UNSIGNED INT NOT NULL,PRIMARY KEY(entity_id,entity_type,size_type),FOREIGN KEY(thumbnail_id) REFERENCES Thumbnail(id_thumbnail) ON DELETE CASCADE);
+CREATE TABLE ThumbnailCleanup(id_request INTEGER PRIMARY KEY AUTOINCREMENT,mrl TEXT);
+CREATE TABLE Media(id_media INTEGER PRIMARY KEY AUTOINCREMENT,type INTEGER,subtype INTEGER NOT NULL DEFAULT 0,duration INTEGER DEFAULT -1,last_position REAL DEFAULT -1,last_time INTEGER DEFAULT -1,play_count UNSIGNED INTEGER NOT NULL DEFAULT 0,last_played_date UNSIGNED INTEGER,insertion_date UNSIGNED INTEGER,release_date UNSIGNED INTEGER,title TEXT COLLATE NOCASE,filename TEXT COLLATE FILENAME,is_favorite BOOLEAN NOT NULL DEFAULT 0,is_present BOOLEAN NOT NULL DEFAULT 1,device_id INTEGER,nb_playlists UNSIGNED INTEGER NOT NULL DEFAULT 0,folder_id UNSIGNED INTEGER,import_type UNSIGNED INTEGER NOT NULL,group_id UNSIGNED INTEGER,forced_title BOOLEAN NOT NULL DEFAULT 0,artist_id UNSIGNED INTEGER,genre_id UNSIGNED INTEGER,track_number UNSIGNED INTEGER,album_id UNSIGNED INTEGER,disc_number UNSIGNED INTEGER,lyrics TEXT,is_public BOOLEAN NOT NULL DEFAULT FALSE,nb_subscriptions UNSIGNED INTEGER NOT NULL DEFAULT 0,description TEXT,FOREIGN KEY(group_id) REFERENCES MediaGroup(id_group) ON DELETE RESTRICT,FOREIGN KEY(folder_id) REFERENCES Folder(id_folder)FOREIGN KEY(artist_id) REFERENCES Artist(id_artist) ON DELETE SET NULL,FOREIGN KEY(genre_id) REFERENCES Genre(id_genre),FOREIGN KEY(album_id) REFERENCES Album(id_album)  ON DELETE SET NULL);
+CREATE VIRTUAL TABLE MediaFts USING FTS3(title,labels)
+CREATE TABLE IF NOT EXISTS 'MediaFts_content'(docid INTEGER PRIMARY KEY, 'c0title', 'c1labels');
+CREATE TABLE IF NOT EXISTS 'MediaFts_segments'(blockid INTEGER PRIMARY KEY, block BLOB);
+CREATE TABLE IF NOT EXISTS 'MediaFts_segdir'(level INTEGER,idx INTEGER,start_block INTEGER,leaves_end_block INTEGER,end_block INTEGER,root BLOB,PRIMARY KEY(level, idx));
+CREATE TABLE File(id_file INTEGER PRIMARY KEY AUTOINCREMENT,media_id UNSIGNED INT DEFAULT NULL,playlist_id UNSIGNED INT DEFAULT NULL,mrl TEXT,type UNSIGNED INTEGER,last_modification_date UNSIGNED INT,size UNSIGNED INT,folder_id UNSIGNED INTEGER,is_removable BOOLEAN NOT NULL,is_external BOOLEAN NOT NULL,is_network BOOLEAN NOT NULL,subscription_id UNSIGNED INTEGER UNIQUE,insertion_date UNSIGNED INTEGER,cache_type UNSIGNED INTEGER NOT NULL DEFAULT 0,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE CASCADE,FOREIGN KEY(playlist_id) REFERENCES Playlist(id_playlist) ON DELETE CASCADE,FOREIGN KEY(folder_id) REFERENCES Folder(id_folder) ON DELETE CASCADE,FOREIGN KEY(subscription_id) REFERENCES Subscription(id_subscription) ON DELETE CASCADE,UNIQUE(mrl,folder_id) ON CONFLICT FAIL);
+CREATE TABLE Label(id_label INTEGER PRIMARY KEY AUTOINCREMENT,name TEXT UNIQUE ON CONFLICT FAIL);
+CREATE TABLE LabelFileRelation(label_id INTEGER,entity_id INTEGER,entity_type INTEGER,PRIMARY KEY(label_id,entity_id,entity_type),FOREIGN KEY(label_id) REFERENCES Label(id_label) ON DELETE CASCADE);
+CREATE TABLE Playlist(id_playlist INTEGER PRIMARY KEY AUTOINCREMENT,name TEXT COLLATE NOCASE,creation_date UNSIGNED INT NOT NULL,artwork_mrl TEXT,nb_video UNSIGNED INT NOT NULL DEFAULT 0,nb_audio UNSIGNED INT NOT NULL DEFAULT 0,nb_unknown UNSIGNED INT NOT NULL DEFAULT 0,nb_present_video UNSIGNED INT NOT NULL DEFAULT 0 CHECK(nb_present_video <= nb_video),nb_present_audio UNSIGNED INT NOT NULL DEFAULT 0 CHECK(nb_present_audio <= nb_audio),nb_present_unknown UNSIGNED INT NOT NULL DEFAULT 0 CHECK(nb_present_unknown <= nb_unknown),duration UNSIGNED INT NOT NULL DEFAULT 0,nb_duration_unknown UNSIGNED INT NOT NULL DEFAULT 0, is_favorite BOOLEAN NOT NULL DEFAULT FALSE);
+CREATE VIRTUAL TABLE PlaylistFts USING FTS3(name)
+CREATE TABLE IF NOT EXISTS 'PlaylistFts_content'(docid INTEGER PRIMARY KEY, 'c0name');
+CREATE TABLE IF NOT EXISTS 'PlaylistFts_segments'(blockid INTEGER PRIMARY KEY, block BLOB);
+CREATE TABLE IF NOT EXISTS 'PlaylistFts_segdir'(level INTEGER,idx INTEGER,start_block INTEGER,leaves_end_block INTEGER,end_block INTEGER,root BLOB,PRIMARY KEY(level, idx));
+CREATE TABLE PlaylistMediaRelation(media_id INTEGER,playlist_id INTEGER,position INTEGER,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE NO ACTION,FOREIGN KEY(playlist_id) REFERENCES Playlist(id_playlist) ON DELETE CASCADE);
+CREATE TABLE Genre(id_genre INTEGER PRIMARY KEY AUTOINCREMENT,name TEXT COLLATE NOCASE UNIQUE ON CONFLICT FAIL,nb_tracks INTEGER NOT NULL DEFAULT 0,is_present INTEGER NOT NULL DEFAULT 0 CHECK(is_present <= nb_tracks), is_favorite BOOLEAN NOT NULL DEFAULT FALSE);
+CREATE VIRTUAL TABLE GenreFts USING FTS3(name)
+CREATE TABLE IF NOT EXISTS 'GenreFts_content'(docid INTEGER PRIMARY KEY, 'c0name');
+CREATE TABLE IF NOT EXISTS 'GenreFts_segments'(blockid INTEGER PRIMARY KEY, block BLOB);
+CREATE TABLE IF NOT EXISTS 'GenreFts_segdir'(level INTEGER,idx INTEGER,start_block INTEGER,leaves_end_block INTEGER,end_block INTEGER,root BLOB,PRIMARY KEY(level, idx));
+CREATE TABLE Album(id_album INTEGER PRIMARY KEY AUTOINCREMENT,title TEXT COLLATE NOCASE,artist_id UNSIGNED INTEGER,release_year UNSIGNED INTEGER,short_summary TEXT,nb_tracks UNSIGNED INTEGER DEFAULT 0,duration UNSIGNED INTEGER NOT NULL DEFAULT 0,nb_discs UNSIGNED INTEGER NOT NULL DEFAULT 1,is_present UNSIGNED INTEGER NOT NULL DEFAULT 0 CHECK(is_present <= nb_tracks), is_favorite BOOLEAN NOT NULL DEFAULT FALSE,FOREIGN KEY(artist_id) REFERENCES Artist(id_artist) ON DELETE CASCADE);
+CREATE VIRTUAL TABLE AlbumFts USING FTS3(title,artist)
+CREATE TABLE IF NOT EXISTS 'AlbumFts_content'(docid INTEGER PRIMARY KEY, 'c0title', 'c1artist');
+CREATE TABLE IF NOT EXISTS 'AlbumFts_segments'(blockid INTEGER PRIMARY KEY, block BLOB);
+CREATE TABLE IF NOT EXISTS 'AlbumFts_segdir'(level INTEGER,idx INTEGER,start_block INTEGER,leaves_end_block INTEGER,end_block INTEGER,root BLOB,PRIMARY KEY(level, idx));
+CREATE TABLE Show(id_show INTEGER PRIMARY KEY AUTOINCREMENT,title TEXT,nb_episodes UNSIGNED INTEGER NOT NULL DEFAULT 0,release_date UNSIGNED INTEGER,short_summary TEXT,artwork_mrl TEXT,tvdb_id TEXT,is_present UNSIGNED INTEGER NOT NULL DEFAULT 0 CHECK(is_present <= nb_episodes));
+CREATE VIRTUAL TABLE ShowFts USING FTS3(title)
+CREATE TABLE IF NOT EXISTS 'ShowFts_content'(docid INTEGER PRIMARY KEY, 'c0title');
+CREATE TABLE IF NOT EXISTS 'ShowFts_segments'(blockid INTEGER PRIMARY KEY, block BLOB);
+CREATE TABLE IF NOT EXISTS 'ShowFts_segdir'(level INTEGER,idx INTEGER,start_block INTEGER,leaves_end_block INTEGER,end_block INTEGER,root BLOB,PRIMARY KEY(level, idx));
+CREATE TABLE ShowEpisode(id_episode INTEGER PRIMARY KEY AUTOINCREMENT,media_id UNSIGNED INTEGER NOT NULL,episode_number UNSIGNED INT,season_number UNSIGNED INT,episode_title TEXT,episode_summary TEXT,tvdb_id TEXT,show_id UNSIGNED INT,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE CASCADE,FOREIGN KEY(show_id) REFERENCES Show(id_show) ON DELETE CASCADE);
+CREATE TABLE Movie(id_movie INTEGER PRIMARY KEY AUTOINCREMENT,media_id UNSIGNED INTEGER NOT NULL,summary TEXT,imdb_id TEXT,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE CASCADE);
+CREATE TABLE VideoTrack(id_track INTEGER PRIMARY KEY AUTOINCREMENT,codec TEXT,width UNSIGNED INTEGER,height UNSIGNED INTEGER,fps_num UNSIGNED INTEGER,fps_den UNSIGNED INTEGER,bitrate UNSIGNED INTEGER,sar_num UNSIGNED INTEGER,sar_den UNSIGNED INTEGER,media_id UNSIGNED INT,language TEXT,description TEXT,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE CASCADE);
+CREATE TABLE AudioTrack(id_track INTEGER PRIMARY KEY AUTOINCREMENT,codec TEXT,bitrate UNSIGNED INTEGER,samplerate UNSIGNED INTEGER,nb_channels UNSIGNED INTEGER,language TEXT,description TEXT,media_id UNSIGNED INT,attached_file_id UNSIGNED INT,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE CASCADE,FOREIGN KEY(attached_file_id) REFERENCES File(id_file) ON DELETE CASCADE);
+CREATE TABLE Artist(id_artist INTEGER PRIMARY KEY AUTOINCREMENT,name TEXT COLLATE NOCASE UNIQUE ON CONFLICT FAIL,shortbio TEXT,nb_albums UNSIGNED INT DEFAULT 0,nb_tracks UNSIGNED INT DEFAULT 0,mb_id TEXT,is_present UNSIGNED INTEGER NOT NULL DEFAULT 0 CHECK(is_present <= nb_tracks), is_favorite BOOLEAN NOT NULL DEFAULT FALSE);
+CREATE VIRTUAL TABLE ArtistFts USING FTS3(name)
+CREATE TABLE IF NOT EXISTS 'ArtistFts_content'(docid INTEGER PRIMARY KEY, 'c0name');
+CREATE TABLE IF NOT EXISTS 'ArtistFts_segments'(blockid INTEGER PRIMARY KEY, block BLOB);
+CREATE TABLE IF NOT EXISTS 'ArtistFts_segdir'(level INTEGER,idx INTEGER,start_block INTEGER,leaves_end_block INTEGER,end_block INTEGER,root BLOB,PRIMARY KEY(level, idx));
+CREATE TABLE MediaArtistRelation(media_id INTEGER NOT NULL,artist_id INTEGER,PRIMARY KEY(media_id,artist_id),FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE CASCADE,FOREIGN KEY(artist_id) REFERENCES Artist(id_artist) ON DELETE CASCADE);
+CREATE TABLE Task(id_task INTEGER PRIMARY KEY AUTOINCREMENT,step INTEGER NOT NULL DEFAULT 0,attempts_left INTEGER NOT NULL,type INTEGER NOT NULL,mrl TEXT,file_type INTEGER NOT NULL,file_id UNSIGNED INTEGER,parent_folder_id UNSIGNED INTEGER,link_to_id UNSIGNED INTEGER NOT NULL,link_to_type UNSIGNED INTEGER NOT NULL,link_extra UNSIGNED INTEGER NOT NULL,link_to_mrl TEXT NOT NULL,UNIQUE(mrl,type, link_to_id, link_to_type, link_extra, link_to_mrl) ON CONFLICT FAIL,FOREIGN KEY(parent_folder_id) REFERENCES Folder(id_folder) ON DELETE CASCADE,FOREIGN KEY(file_id) REFERENCES File(id_file) ON DELETE CASCADE);
+CREATE TABLE Metadata(id_media INTEGER,entity_type INTEGER,type INTEGER,value TEXT,PRIMARY KEY(id_media,entity_type,type));
+CREATE TABLE SubtitleTrack(id_track INTEGER PRIMARY KEY AUTOINCREMENT,codec TEXT,language TEXT,description TEXT,encoding TEXT,media_id UNSIGNED INT,attached_file_id UNSIGNED INT,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE CASCADE,FOREIGN KEY(attached_file_id) REFERENCES File(id_file) ON DELETE CASCADE,UNIQUE(media_id, attached_file_id) ON CONFLICT FAIL);
+CREATE TABLE Chapter(id_chapter INTEGER PRIMARY KEY AUTOINCREMENT,offset INTEGER NOT NULL,duration INTEGER NOT NULL,name TEXT,media_id INTEGER,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE CASCADE);
+CREATE TABLE Bookmark(id_bookmark INTEGER PRIMARY KEY AUTOINCREMENT,time UNSIGNED INTEGER NOT NULL,name TEXT,description TEXT,media_id UNSIGNED INTEGER NOT NULL,creation_date UNSIGNED INTEGER NOT NULL,type UNSIGNED INTEGER NOT NULL,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE CASCADE,UNIQUE(time,media_id) ON CONFLICT FAIL);
+CREATE TABLE MediaGroup(id_group INTEGER PRIMARY KEY AUTOINCREMENT,name TEXT COLLATE NOCASE,nb_video UNSIGNED INTEGER DEFAULT 0,nb_audio UNSIGNED INTEGER DEFAULT 0,nb_unknown UNSIGNED INTEGER DEFAULT 0,nb_seen UNSIGNED INTEGER DEFAULT 0,nb_external UNSIGNED INTEGER DEFAULT 0,nb_present_video UNSIGNED INTEGER DEFAULT 0 CHECK(nb_present_video <= nb_video),nb_present_audio UNSIGNED INTEGER DEFAULT 0 CHECK(nb_present_audio <= nb_audio),nb_present_unknown UNSIGNED INTEGER DEFAULT 0 CHECK(nb_present_unknown <= nb_unknown),nb_present_seen UNSIGNED INTEGER DEFAULT 0 CHECK(nb_present_seen <= nb_seen),duration INTEGER DEFAULT 0,creation_date INTEGER NOT NULL,last_modification_date INTEGER NOT NULL,user_interacted BOOLEAN,forced_singleton BOOLEAN, is_favorite BOOLEAN NOT NULL DEFAULT FALSE);
+CREATE VIRTUAL TABLE MediaGroupFts USING FTS3(name)
+CREATE TABLE IF NOT EXISTS 'MediaGroupFts_content'(docid INTEGER PRIMARY KEY, 'c0name');
+CREATE TABLE IF NOT EXISTS 'MediaGroupFts_segments'(blockid INTEGER PRIMARY KEY, block BLOB);
+CREATE TABLE IF NOT EXISTS 'MediaGroupFts_segdir'(level INTEGER,idx INTEGER,start_block INTEGER,leaves_end_block INTEGER,end_block INTEGER,root BLOB,PRIMARY KEY(level, idx));
+CREATE TABLE Subscription(id_subscription INTEGER PRIMARY KEY AUTOINCREMENT,service_id UNSIGNED INTEGER NOT NULL,name TEXT NOT NULL,parent_id UNSIGNED INTEGER,cached_size UNSIGNED INTEGER NOT NULL DEFAULT 0,max_cached_media INTEGER NOT NULL DEFAULT -1,max_cached_size INTEGER NOT NULL DEFAULT -1,new_media_notify INTEGER NOT NULL DEFAULT -1,nb_unplayed_media UNSIGNED INTEGER NOT NULL DEFAULT 0,nb_media UNSIGNED INTEGER NOT NULL DEFAULT 0, artwork_mrl TEXT,FOREIGN KEY(parent_id) REFERENCES Subscription(id_subscription) ON DELETE CASCADE);
+CREATE VIRTUAL TABLE SubscriptionFts USING FTS3(name)
+CREATE TABLE IF NOT EXISTS 'SubscriptionFts_content'(docid INTEGER PRIMARY KEY, 'c0name');
+CREATE TABLE IF NOT EXISTS 'SubscriptionFts_segments'(blockid INTEGER PRIMARY KEY, block BLOB);
+CREATE TABLE IF NOT EXISTS 'SubscriptionFts_segdir'(level INTEGER,idx INTEGER,start_block INTEGER,leaves_end_block INTEGER,end_block INTEGER,root BLOB,PRIMARY KEY(level, idx));
+CREATE TABLE SubscriptionMediaRelation(media_id UNSIGNED INTEGER,subscription_id UNSIGNED INTEGER,auto_cache_handled BOOLEAN NOT NULL DEFAULT 0,UNIQUE(media_id, subscription_id) ON CONFLICT FAIL,FOREIGN KEY(media_id) REFERENCES Media(id_media) ON DELETE NO ACTION,FOREIGN KEY(subscription_id) REFERENCES Subscription(id_subscription) ON DELETE CASCADE);
+CREATE TABLE Service(id_service UNSIGNED INTEGER PRIMARY KEY,auto_download BOOLEAN NOT NULL DEFAULT 1,notify BOOLEAN NOT NULL DEFAULT 1,max_cached_size INTEGER NOT NULL DEFAULT -1,nb_subscriptions UNSIGNED INTEGER NOT NULL DEFAULT 0,nb_unplayed_media UNSIGNED INTEGER NOT NULL DEFAULT 0,nb_media UNSIGNED INTEGER NOT NULL DEFAULT 0);
+CREATE TABLE CacheManifest(file_name TEXT PRIMARY KEY NOT NULL,file_id INTEGER,size UNSIGNED INTEGER NOT NULL,last_modification_date UNSIGNED INTEGER NOT NULL,state UNSIGNED INTEGER NOT NULL,FOREIGN KEY(file_id) REFERENCES File(id_file) ON DELETE SET NULL);
+CREATE TRIGGER insert_folder_fts AFTER INSERT ON Folder BEGIN INSERT INTO FolderFts(rowid,name) VALUES(new.id_folder,new.name);END;
+CREATE TRIGGER delete_folder_fts BEFORE DELETE ON Folder BEGIN DELETE FROM FolderFts WHERE rowid = old.id_folder;END;
+CREATE TRIGGER update_folder_nb_media_on_insert AFTER INSERT ON Media WHEN new.folder_id IS NOT NULL BEGIN UPDATE Folder SET nb_audio = nb_audio + (CASE new.type WHEN 2 THEN 1 ELSE 0 END),nb_video = nb_video + (CASE new.type WHEN 1 THEN 1 ELSE 0 END) WHERE id_folder = new.folder_id;END;
+CREATE TRIGGER update_folder_nb_media_on_delete AFTER DELETE ON Media WHEN old.folder_id IS NOT NULL BEGIN UPDATE Folder SET nb_audio = nb_audio + (CASE old.type WHEN 2 THEN -1 ELSE 0 END),nb_video = nb_video + (CASE old.type WHEN 1 THEN -1 ELSE 0 END),duration = duration - IIF(old.duration > 0, old.duration, 0) WHERE id_folder = old.folder_id;END;
+CREATE TRIGGER folder_update_nb_media_on_media_update AFTER UPDATE OF folder_id, type, duration ON Media WHEN IFNULL(old.folder_id, 0) != IFNULL(new.folder_id, 0) OR old.type != new.type OR old.duration != new.duration BEGIN UPDATE Folder SET nb_audio = nb_audio + (CASE new.type WHEN 2 THEN 1 ELSE 0 END),nb_video = nb_video + (CASE new.type WHEN 1 THEN 1 ELSE 0 END),duration = duration + IIF(new.duration > 0, new.duration, 0) WHERE new.folder_id IS NOT NULL AND id_folder = new.folder_id;UPDATE Folder SET nb_audio = nb_audio - (CASE old.type WHEN 2 THEN -1 ELSE 0 END),nb_video = nb_video - (CASE old.type WHEN 1 THEN 1 ELSE 0 END),duration = duration - IIF(old.duration > 0, old.duration, 0) WHERE old.folder_id IS NOT NULL AND id_folder = old.folder_id; END;
+CREATE TRIGGER folder_update_is_public AFTER UPDATE OF is_public ON Folder WHEN new.is_public != old.is_public BEGIN UPDATE Folder SET is_public = new.is_public WHERE parent_id = new.id_folder; END;
+CREATE INDEX folder_device_id_idx ON Folder (device_id);
+CREATE INDEX parent_folder_id_idx ON Folder (parent_id);
+CREATE TRIGGER album_is_present AFTER UPDATE OF is_present ON Media WHEN new.subtype = 3 AND old.is_present != new.is_present BEGIN  UPDATE Album SET is_present=is_present + (CASE new.is_present WHEN 0 THEN -1 ELSE 1 END)WHERE id_album = new.album_id; END;
+CREATE TRIGGER album_delete_track AFTER DELETE ON Media WHEN old.subtype = 3 BEGIN  UPDATE Album SET nb_tracks = nb_tracks - 1, is_present = is_present - IIF(old.is_present != 0, 1, 0), duration = duration - MAX(old.duration, 0) WHERE id_album = old.album_id; END;
+CREATE TRIGGER insert_album_fts AFTER INSERT ON Album WHEN new.title IS NOT NULL BEGIN INSERT INTO AlbumFts(rowid, title) VALUES(new.id_album, new.title); END;
+CREATE TRIGGER delete_album_fts BEFORE DELETE ON Album WHEN old.title IS NOT NULL BEGIN DELETE FROM AlbumFts WHERE rowid = old.id_album; END;
+CREATE TRIGGER album_delete_empty AFTER UPDATE OF nb_tracks ON Album WHEN new.nb_tracks = 0 BEGIN  DELETE FROM Album WHERE id_album=new.id_album; END;
+CREATE TRIGGER album_update_on_media_album_id AFTER UPDATE OF album_id ON Media WHEN IFNULL(old.album_id, 0) != IFNULL(new.album_id, 0) BEGIN UPDATE Album SET  is_present = is_present - IIF(old.is_present != 0, 1, 0), nb_tracks = nb_tracks - 1, duration = duration - IIF(old.duration >= 0, old.duration, 0) WHERE old.album_id IS NOT NULL AND id_album = old.album_id; UPDATE Album SET  is_present = is_present + IIF(old.is_present != 0, 1, 0), nb_tracks = nb_tracks + 1, duration = duration + IIF(new.duration >= 0, new.duration, 0) WHERE new.album_id IS NOT NULL AND id_album = new.album_id; END;
+CREATE INDEX album_artist_id_idx ON Album(artist_id);
+CREATE INDEX album_nb_tracks_idx ON Album(nb_tracks, is_present);
+CREATE INDEX album_title_idx ON Album(title);
+CREATE TRIGGER artist_has_tracks_present AFTER UPDATE OF is_present ON Media WHEN new.subtype = 3 AND old.is_present != new.is_present BEGIN  UPDATE Artist SET is_present=is_present + (CASE new.is_present WHEN 0 THEN -1 ELSE 1 END)WHERE id_artist = new.artist_id; END;
+CREATE TRIGGER insert_artist_fts AFTER INSERT ON Artist WHEN new.name IS NOT NULL BEGIN INSERT INTO ArtistFts(rowid,name) VALUES(new.id_artist, new.name); END;
+CREATE TRIGGER delete_artist_fts BEFORE DELETE ON Artist WHEN old.name IS NOT NULL BEGIN DELETE FROM ArtistFts WHERE rowid=old.id_artist; END;
+CREATE TRIGGER delete_artist_without_tracks AFTER UPDATE OF nb_tracks, nb_albums ON Artist WHEN new.nb_tracks = 0 AND new.nb_albums = 0 AND new.id_artist != 1 AND new.id_artist != 2 BEGIN DELETE FROM Artist WHERE id_artist = old.id_artist; END;
+CREATE TRIGGER artist_increment_nb_tracks AFTER INSERT ON MediaArtistRelation BEGIN UPDATE Artist SET nb_tracks = nb_tracks + 1, is_present = is_present + 1 WHERE id_artist = new.artist_id; END;
+CREATE TRIGGER artist_decrement_nb_tracks AFTER DELETE ON MediaArtistRelation BEGIN UPDATE Artist SET nb_tracks = nb_tracks - 1, is_present = is_present - 1 WHERE id_artist = old.artist_id; END;
+CREATE TRIGGER artist_update_nb_albums AFTER UPDATE OF artist_id ON Album BEGIN UPDATE Artist SET nb_albums = nb_albums + 1 WHERE id_artist = new.artist_id; UPDATE Artist SET nb_albums = nb_albums - 1 WHERE id_artist = old.artist_id; END;
+CREATE TRIGGER artist_decrement_nb_albums AFTER DELETE ON Album BEGIN UPDATE Artist SET nb_albums = nb_albums - 1 WHERE id_artist = old.artist_id; END;
+CREATE TRIGGER artist_increment_nb_albums_unknown_album AFTER INSERT ON Album WHEN new.artist_id IS NOT NULL BEGIN UPDATE Artist SET nb_albums = nb_albums + 1 WHERE id_artist = new.artist_id; END;
+CREATE INDEX artist_media_rel_artist_id_idx ON MediaArtistRelation(artist_id);
+CREATE TRIGGER media_update_device_presence AFTER UPDATE OF is_present ON Device WHEN old.is_present != new.is_present BEGIN UPDATE Media SET is_present=new.is_present WHERE device_id=new.id_device;END;
+CREATE TRIGGER media_cascade_file_deletion AFTER DELETE ON File WHEN old.type = 1 OR old.type = 6 BEGIN  DELETE FROM Media WHERE id_media=old.media_id; END;
+CREATE TRIGGER insert_media_fts AFTER INSERT ON Media BEGIN INSERT INTO MediaFts(rowid,title,labels) VALUES(new.id_media, new.title, ''); END;
+CREATE TRIGGER media_cascade_file_update AFTER UPDATE OF media_id ON File WHEN old.media_id != new.media_id AND old.type = 1 BEGIN DELETE FROM Media WHERE id_media = old.media_id;END;
+CREATE TRIGGER delete_media_fts BEFORE DELETE ON Media BEGIN DELETE FROM MediaFts WHERE rowid = old.id_media; END;
+CREATE TRIGGER update_media_title_fts AFTER UPDATE OF title ON Media BEGIN UPDATE MediaFts SET title = new.title WHERE rowid = new.id_media; END;
+CREATE TRIGGER increment_media_nb_playlist AFTER INSERT ON PlaylistMediaRelation BEGIN UPDATE Media SET nb_playlists = nb_playlists + 1  WHERE id_media = new.media_id; END;
+CREATE TRIGGER decrement_media_nb_playlist AFTER DELETE ON PlaylistMediaRelation BEGIN UPDATE Media SET nb_playlists = nb_playlists - 1  WHERE id_media = old.media_id; END;
+CREATE TRIGGER media_update_is_public AFTER UPDATE OF is_public ON Folder WHEN new.is_public != old.is_public BEGIN UPDATE Media SET is_public = new.is_public WHERE folder_id = new.id_folder; END;
+CREATE TRIGGER media_increment_nb_subscriptions AFTER INSERT ON SubscriptionMediaRelation BEGIN UPDATE Media SET nb_subscriptions = nb_subscriptions + 1  WHERE id_media = new.media_id; END;
+CREATE TRIGGER media_decrement_nb_subscriptions AFTER DELETE ON SubscriptionMediaRelation BEGIN UPDATE Media SET nb_subscriptions = nb_subscriptions - 1  WHERE id_media = old.media_id; END;
+CREATE INDEX index_last_played_date ON Media(last_played_date DESC);
+CREATE INDEX index_media_presence ON Media(is_present);
+CREATE INDEX media_types_idx ON Media(type, subtype);
+CREATE INDEX media_insertion_date_idx ON Media(insertion_date);
+CREATE INDEX media_folder_id_idx ON Media(folder_id);
+CREATE INDEX media_group_id_idx ON Media(group_id);
+CREATE INDEX media_last_pos_time_idx ON Media(last_position, last_time);
+CREATE INDEX media_album_track_idx ON Media(album_id, genre_id, artist_id);
+CREATE INDEX media_duration_idx ON Media(duration);
+CREATE INDEX media_release_date_idx ON Media(release_date);
+CREATE INDEX media_play_count_idx ON Media(play_count);
+CREATE INDEX media_title_idx ON Media(title);
+CREATE INDEX media_filename_idx ON Media(filename);
+CREATE INDEX media_genre_id_idx ON Media(genre_id);
+CREATE INDEX media_artist_id_idx ON Media(artist_id);
+CREATE INDEX media_type_title_idx ON Media(type, import_type, title) WHERE is_present != 0;
+CREATE INDEX media_type_duration_idx ON Media(type, import_type, duration) WHERE is_present != 0;
+CREATE INDEX media_type_insertion_date_idx ON Media(type, import_type, insertion_date) WHERE is_present != 0;
+CREATE INDEX media_type_release_date_idx ON Media(type, import_type, release_date) WHERE is_present != 0;
+CREATE INDEX media_type_play_count_idx ON Media(type, import_type, play_count) WHERE is_present != 0;
+CREATE INDEX media_type_filename_idx ON Media(type, import_type, filename) WHERE is_present != 0;
+CREATE INDEX media_type_last_played_date_idx ON Media(type, import_type, last_played_date) WHERE is_present != 0;
+CREATE INDEX file_media_id_index ON File(media_id);
+CREATE INDEX file_folder_id_index ON File(folder_id);
+CREATE INDEX file_playlist_id_idx ON File(playlist_id);
+CREATE TRIGGER insert_genre_fts AFTER INSERT ON Genre BEGIN INSERT INTO GenreFts(rowid,name) VALUES(new.id_genre, new.name); END;
+CREATE TRIGGER delete_genre_fts BEFORE DELETE ON Genre BEGIN DELETE FROM GenreFts WHERE rowid = old.id_genre; END;
+CREATE TRIGGER genre_update_on_track_deleted AFTER DELETE ON Media WHEN old.subtype = 3 BEGIN UPDATE Genre SET is_present = is_present - IIF(old.is_present != 0, 1, 0), nb_tracks = nb_tracks - 1 WHERE id_genre = old.genre_id; END;
+CREATE TRIGGER genre_update_is_present AFTER UPDATE OF is_present ON Media WHEN new.subtype = 3 AND old.is_present != new.is_present BEGIN UPDATE Genre SET is_present = is_present + (CASE new.is_present WHEN 0 THEN -1 ELSE 1 END) WHERE id_genre = new.genre_id; END;
+CREATE TRIGGER genre_delete_empty AFTER UPDATE OF nb_tracks ON Genre WHEN new.nb_tracks = 0 BEGIN DELETE FROM Genre WHERE id_genre = old.id_genre; END;
+CREATE TRIGGER genre_update_on_media_genre_id_change AFTER UPDATE OF genre_id ON Media WHEN IFNULL(new.genre_id, 0) != IFNULL(old.genre_id, 0) BEGIN UPDATE Genre SET is_present = is_present - IIF(old.is_present != 0, 1, 0), nb_tracks = nb_tracks - 1 WHERE old.genre_id IS NOT NULL AND id_genre = old.genre_id; UPDATE Genre SET is_present = is_present + IIF(old.is_present != 0, 1, 0), nb_tracks = nb_tracks + 1 WHERE new.genre_id IS NOT NULL AND id_genre = new.genre_id; END;
+CREATE TRIGGER update_playlist_order_on_insert AFTER INSERT ON PlaylistMediaRelation WHEN new.position IS NOT NULL BEGIN UPDATE PlaylistMediaRelation SET position = position + 1 WHERE playlist_id = new.playlist_id AND position >= new.position AND rowid != new.rowid; END;
+CREATE TRIGGER update_playlist_order_on_delete AFTER DELETE ON PlaylistMediaRelation BEGIN UPDATE PlaylistMediaRelation SET position = position - 1 WHERE playlist_id = old.playlist_id AND position > old.position; END;
+CREATE TRIGGER insert_playlist_fts AFTER INSERT ON Playlist BEGIN INSERT INTO PlaylistFts(rowid, name) VALUES(new.id_playlist, new.name); END;
+CREATE TRIGGER update_playlist_fts AFTER UPDATE OF name ON Playlist BEGIN UPDATE PlaylistFts SET name = new.name WHERE rowid = new.id_playlist; END;
+CREATE TRIGGER delete_playlist_fts BEFORE DELETE ON Playlist BEGIN DELETE FROM PlaylistFts WHERE rowid = old.id_playlist; END;
+CREATE TRIGGER playlist_update_nb_media_on_media_deletion AFTER DELETE ON Media WHEN old.nb_playlists > 0 BEGIN UPDATE Playlist SET nb_video = nb_video - IIF(old.type = 1, items.count, 0),nb_present_video = nb_present_video - IIF( old.is_present != 0, IIF(old.type = 1, items.count, 0), 0),nb_audio = nb_audio - IIF(old.type = 2, items.count, 0),nb_present_audio = nb_present_audio - IIF( old.is_present != 0, IIF(old.type = 2, items.count, 0), 0),nb_unknown = nb_unknown - IIF(old.type = 0, items.count, 0),nb_present_unknown = nb_present_unknown - IIF( old.is_present != 0, IIF(old.type = 0, items.count, 0), 0), duration = duration - items.dur, nb_duration_unknown = nb_duration_unknown -IIF(items.dur <= 0, items.count, 0) FROM (SELECT COUNT(media_id) AS count, TOTAL(IIF(old.duration > 0, old.duration, 0)) AS dur, playlist_id FROM PlaylistMediaRelation WHERE media_id = old.id_media GROUP BY playlist_id) AS items WHERE id_playlist = items.playlist_id; DELETE FROM PlaylistMediaRelation WHERE media_id = old.id_media; END;
+CREATE TRIGGER playlist_update_duration_on_media_change AFTER UPDATE OF duration ON Media WHEN old.duration != new.duration BEGIN UPDATE Playlist SET duration = duration - IIF(old.duration > 0, old.duration, 0) + IIF(new.duration > 0, new.duration, 0), nb_duration_unknown = nb_duration_unknown - IIF(old.duration <= 0, 1, 0) + IIF(new.duration <= 0, 1, 0) WHERE id_playlist IN (SELECT DISTINCT playlist_id FROM PlaylistMediaRelation WHERE media_id = new.id_media); END;
+CREATE TRIGGER playlist_update_nb_media_on_media_change AFTER UPDATE OF type, is_present ON Media WHEN old.type != new.type OR old.is_present != new.is_present AND old.nb_playlists > 0 BEGIN UPDATE Playlist SET nb_present_video = nb_present_video - IIF(old.is_present != 0,IIF(old.type = 1, items.count, 0), 0), nb_video = nb_video - IIF(old.type = 1, items.count, 0), nb_present_audio = nb_present_audio - IIF(old.is_present != 0,IIF(old.type = 2, items.count, 0), 0), nb_audio = nb_audio - IIF(old.type = 2, items.count, 0), nb_present_unknown = nb_present_unknown - IIF(old.is_present != 0,IIF(old.type = 0, items.count, 0), 0), nb_unknown = nb_unknown - IIF(old.type = 0, items.count, 0)  FROM (SELECT COUNT(media_id) AS count, playlist_id FROM PlaylistMediaRelation WHERE media_id = old.id_media GROUP BY playlist_id) AS items WHERE id_playlist = items.playlist_id; UPDATE Playlist SET nb_video = nb_video + IIF(new.type = 1, items.count, 0), nb_present_video = nb_present_video + IIF(new.is_present != 0,IIF(new.type = 1, items.count, 0), 0), nb_audio = nb_audio + IIF(new.type = 2, items.count, 0), nb_present_audio = nb_present_audio + IIF(new.is_present != 0,IIF(new.type = 2, items.count, 0), 0), nb_unknown = nb_unknown + IIF(new.type = 0, items.count, 0), nb_present_unknown = nb_present_unknown + IIF(new.is_present != 0,IIF(new.type = 0, items.count, 0), 0)  FROM (SELECT COUNT(media_id) AS count, playlist_id FROM PlaylistMediaRelation WHERE media_id = old.id_media GROUP BY playlist_id) AS items WHERE id_playlist = items.playlist_id; END;
+CREATE TRIGGER playlist_cascade_file_deletion AFTER DELETE ON File WHEN old.type = 5 BEGIN  DELETE FROM Playlist WHERE id_playlist=old.playlist_id; END;
+CREATE INDEX playlist_position_pl_id_index ON PlaylistMediaRelation(playlist_id,position);
+CREATE INDEX playlist_rel_media_id_idx ON PlaylistMediaRelation(media_id);
+CREATE TRIGGER delete_label_fts BEFORE DELETE ON Label BEGIN UPDATE MediaFts SET labels = TRIM(REPLACE(labels, old.name, '')) WHERE labels MATCH old.name; END;
+CREATE TRIGGER label_delete_media AFTER DELETE ON Media BEGIN DELETE FROM LabelFileRelation WHERE entity_type = 0 AND entity_id = old.id_media; END;
+CREATE TRIGGER insert_show_fts AFTER INSERT ON Show BEGIN INSERT INTO ShowFts(rowid,title) VALUES(new.id_show, new.title); END;
+CREATE TRIGGER delete_show_fts BEFORE DELETE ON Show BEGIN DELETE FROM ShowFts WHERE rowid = old.id_show; END;
+CREATE TRIGGER show_increment_nb_episode AFTER INSERT ON ShowEpisode BEGIN UPDATE Show SET nb_episodes = nb_episodes + 1, is_present = is_present + 1 WHERE id_show = new.show_id; END;
+CREATE TRIGGER show_decrement_nb_episode AFTER DELETE ON ShowEpisode BEGIN UPDATE Show SET nb_episodes = nb_episodes - 1, is_present = is_present - 1 WHERE id_show = old.show_id; END;
+CREATE TRIGGER show_update_is_present AFTER UPDATE OF is_present ON Media WHEN new.subtype = 1 AND new.is_present != old.is_present BEGIN  UPDATE Show SET is_present=is_present + (CASE new.is_present WHEN 0 THEN -1 ELSE 1 END) WHERE id_show = (SELECT show_id FROM ShowEpisode WHERE media_id = new.id_media); END;
+CREATE INDEX show_episode_media_idx ON ShowEpisode(media_id);
+CREATE INDEX show_episode_show_id_idx ON ShowEpisode(show_id);
+CREATE TRIGGER auto_delete_album_thumbnail AFTER DELETE ON Album BEGIN DELETE FROM ThumbnailLinking WHERE entity_id = old.id_album AND entity_type = 1; END;
+CREATE TRIGGER auto_delete_artist_thumbnail AFTER DELETE ON Artist BEGIN DELETE FROM ThumbnailLinking WHERE entity_id = old.id_artist AND entity_type = 2; END;
+CREATE TRIGGER auto_delete_media_thumbnail AFTER DELETE ON Media BEGIN DELETE FROM ThumbnailLinking WHERE entity_id = old.id_media AND entity_type = 0; END;
+CREATE TRIGGER incr_thumbnail_refcount AFTER INSERT ON ThumbnailLinking BEGIN UPDATE Thumbnail SET shared_counter = shared_counter + 1 WHERE id_thumbnail = new.thumbnail_id;END;
+CREATE TRIGGER decr_thumbnail_refcount AFTER DELETE ON ThumbnailLinking BEGIN UPDATE Thumbnail SET shared_counter = shared_counter - 1 WHERE id_thumbnail = old.thumbnail_id;END;
+CREATE TRIGGER update_thumbnail_refcount AFTER UPDATE OF thumbnail_id ON ThumbnailLinking WHEN old.thumbnail_id != new.thumbnail_id BEGIN UPDATE Thumbnail SET shared_counter = shared_counter - 1 WHERE id_thumbnail = old.thumbnail_id;UPDATE Thumbnail SET shared_counter = shared_counter + 1 WHERE id_thumbnail = new.thumbnail_id;END;
+CREATE TRIGGER delete_unused_thumbnail AFTER UPDATE OF shared_counter ON Thumbnail WHEN new.shared_counter = 0 BEGIN DELETE FROM Thumbnail WHERE id_thumbnail = new.id_thumbnail;END;
+CREATE TRIGGER thumbnail_insert_cleanup AFTER DELETE ON Thumbnail WHEN old.is_owned != 0 AND old.status = 1 BEGIN INSERT INTO ThumbnailCleanup(mrl) VALUES(old.mrl); END;
+CREATE INDEX thumbnail_link_index ON ThumbnailLinking(thumbnail_id);
+CREATE TRIGGER delete_playlist_linking_tasks AFTER DELETE ON Playlist BEGIN DELETE FROM Task WHERE link_to_type = 1 AND link_to_id = old.id_playlist AND type = 1;END;
+CREATE TRIGGER task_delete_subscription_linking_tasks AFTER DELETE ON Subscription BEGIN DELETE FROM Task WHERE link_to_type = 3 AND link_to_id = old.id_subscription AND type = 1;END;
+CREATE INDEX audio_track_media_idx ON AudioTrack(media_id);
+CREATE INDEX audio_track_attached_file_idx ON AudioTrack(attached_file_id);
+CREATE INDEX subtitle_track_media_idx ON SubtitleTrack(media_id);
+CREATE INDEX subtitle_track_attached_file_idx ON SubtitleTrack(attached_file_id);
+CREATE INDEX video_track_media_idx ON VideoTrack(media_id);
+CREATE TRIGGER media_group_insert_fts AFTER INSERT ON MediaGroup BEGIN INSERT INTO MediaGroupFts(rowid, name) VALUES(new.rowid, new.name); END;
+CREATE TRIGGER media_group_delete_fts AFTER DELETE ON MediaGroup BEGIN DELETE FROM MediaGroupFts WHERE rowid = old.id_group; END;
+CREATE TRIGGER media_group_update_nb_media_types AFTER UPDATE OF type, play_count, group_id ON Media WHEN (IFNULL(old.group_id, 0) != IFNULL(new.group_id, 0) OR old.type != new.type OR new.play_count != old.play_count) AND new.import_type = 0 BEGIN UPDATE MediaGroup SET nb_video = nb_video + (CASE new.type WHEN 1 THEN 1 ELSE 0 END), nb_present_video = nb_present_video + (CASE new.is_present WHEN 0 THEN 0 ELSE (CASE new.type WHEN 1 THEN 1 ELSE 0 END) END), nb_audio = nb_audio + (CASE new.type WHEN 2 THEN 1 ELSE 0 END), nb_seen = nb_seen + IIF(new.play_count > 0, 1, 0), nb_present_audio = nb_present_audio + (CASE new.is_present WHEN 0 THEN 0 ELSE (CASE new.type WHEN 2 THEN 1 ELSE 0 END) END), nb_unknown = nb_unknown + (CASE new.type WHEN 0 THEN 1 ELSE 0 END), nb_present_unknown = nb_present_unknown + (CASE new.is_present WHEN 0 THEN 0 ELSE (CASE new.type WHEN 0 THEN 1 ELSE 0 END) END), nb_present_seen = nb_present_seen + IIF(new.play_count > 0 AND new.is_present, 1, 0), last_modification_date = strftime('%s') WHERE new.group_id IS NOT NULL AND id_group = new.group_id; UPDATE MediaGroup SET nb_present_video = nb_present_video - (CASE old.is_present WHEN 0 THEN 0 ELSE (CASE old.type WHEN 1 THEN 1 ELSE 0 END) END), nb_video = nb_video - (CASE old.type WHEN 1 THEN 1 ELSE 0 END), nb_present_audio = nb_present_audio - (CASE old.is_present WHEN 0 THEN 0 ELSE (CASE old.type WHEN 2 THEN 1 ELSE 0 END) END), nb_present_seen = nb_present_seen - IIF(old.play_count > 0 AND old.is_present != 0, 1, 0), nb_audio = nb_audio - (CASE old.type WHEN 2 THEN 1 ELSE 0 END), nb_present_unknown = nb_present_unknown - (CASE old.is_present WHEN 0 THEN 0 ELSE (CASE old.type WHEN 0 THEN 1 ELSE 0 END) END), nb_unknown = nb_unknown - (CASE old.type WHEN 0 THEN 1 ELSE 0 END), nb_seen = nb_seen - IIF(old.play_count > 0, 1, 0), last_modification_date = strftime('%s') WHERE old.group_id IS NOT NULL AND id_group = old.group_id; END;
+CREATE TRIGGER media_group_decrement_nb_media_on_deletion AFTER DELETE ON Media WHEN old.group_id IS NOT NULL BEGIN UPDATE MediaGroup SET nb_present_video = nb_present_video - (CASE old.is_present WHEN 0 THEN 0 ELSE (CASE old.type WHEN 1 THEN 1 ELSE 0 END) END), nb_video = nb_video - (CASE old.type WHEN 1 THEN 1 ELSE 0 END), nb_present_audio = nb_present_audio - (CASE old.is_present WHEN 0 THEN 0 ELSE (CASE old.type WHEN 2 THEN 1 ELSE 0 END) END), nb_present_seen = nb_present_seen - IIF(old.play_count > 0 AND old.is_present > 0, 1, 0), nb_audio = nb_audio - (CASE old.type WHEN 2 THEN 1 ELSE 0 END), nb_present_unknown = nb_present_unknown - (CASE old.is_present WHEN 0 THEN 0 ELSE (CASE old.type WHEN 0 THEN 1 ELSE 0 END) END), nb_unknown = nb_unknown - (CASE old.type WHEN 0 THEN 1 ELSE 0 END), nb_seen = nb_seen - IIF(old.play_count > 0, 1, 0), last_modification_date = strftime('%s') WHERE id_group = old.group_id; END;
+CREATE TRIGGER media_group_delete_empty_group AFTER UPDATE OF nb_video, nb_audio, nb_unknown, nb_external ON MediaGroup WHEN new.nb_video = 0 AND new.nb_audio = 0 AND new.nb_unknown = 0 AND new.nb_external = 0 BEGIN DELETE FROM MediaGroup WHERE id_group = new.id_group; END;
+CREATE TRIGGER media_group_rename_forced_singleton AFTER UPDATE OF title ON Media WHEN new.group_id IS NOT NULL BEGIN UPDATE MediaGroup SET name = new.title WHERE id_group = new.group_id AND forced_singleton != 0; END;
+CREATE TRIGGER media_group_update_duration_on_media_change AFTER UPDATE OF duration, group_id ON Media BEGIN UPDATE MediaGroup SET duration = duration - max(old.duration, 0) WHERE id_group = old.group_id; UPDATE MediaGroup SET duration = duration + max(new.duration, 0) WHERE id_group = new.group_id; END;
+CREATE TRIGGER media_group_update_duration_on_media_deletion AFTER DELETE ON Media WHEN old.group_id IS NOT NULL AND old.duration > 0 BEGIN UPDATE MediaGroup SET duration = duration - old.duration WHERE id_group = old.group_id; END;
+CREATE TRIGGER media_group_update_nb_media_types_presence AFTER UPDATE OF is_present ON Media WHEN old.is_present != new.is_present AND new.group_id IS NOT NULL BEGIN UPDATE MediaGroup SET nb_present_video = nb_present_video +  (CASE new.type WHEN 1 THEN 1 ELSE 0 END) * (CASE new.is_present WHEN 0 THEN -1 ELSE 1 END), nb_present_audio = nb_present_audio +  (CASE new.type WHEN 2 THEN 1 ELSE 0 END) * (CASE new.is_present WHEN 0 THEN -1 ELSE 1 END), nb_present_unknown = nb_present_unknown +  (CASE new.type WHEN 0 THEN 1 ELSE 0 END) * (CASE new.is_present WHEN 0 THEN -1 ELSE 1 END), nb_present_seen = nb_present_seen + IIF(new.play_count > 0, 1, 0) * IIF(new.is_present != 0, 1, -1) WHERE id_group = new.group_id; END;
+CREATE TRIGGER media_group_update_media_count_on_import_type_change AFTER UPDATE OF group_id, import_type ON Media WHEN ( IFNULL(old.group_id, 0) != IFNULL(new.group_id, 0)  AND new.import_type != 0 ) OR new.import_type != old.import_type BEGIN UPDATE MediaGroup SET nb_video = nb_video + (CASE new.import_type WHEN 0 THEN (CASE new.type WHEN 1 THEN 1 ELSE 0 END) ELSE 0 END), nb_present_video = nb_present_video + (CASE new.import_type WHEN 0 THEN (CASE new.is_present WHEN 0 THEN 0 ELSE (CASE new.type WHEN 1 THEN 1 ELSE 0 END) END) ELSE 0 END), nb_audio = nb_audio + (CASE new.import_type WHEN 0 THEN (CASE new.type WHEN 2 THEN 1 ELSE 0 END) ELSE 0 END), nb_present_audio = nb_present_audio + (CASE new.import_type WHEN 0 THEN (CASE new.is_present WHEN 0 THEN 0 ELSE (CASE new.type WHEN 2 THEN 1 ELSE 0 END) END) ELSE 0 END), nb_unknown = nb_unknown + (CASE new.import_type WHEN 0 THEN (CASE new.type WHEN 0 THEN 1 ELSE 0 END) ELSE 0 END), nb_present_unknown = nb_present_unknown + (CASE new.import_type WHEN 0 THEN (CASE new.is_present WHEN 0 THEN 0 ELSE (CASE new.type WHEN 0 THEN 1 ELSE 0 END) END) ELSE 0 END), nb_external = nb_external + (CASE new.import_type WHEN 0 THEN 0 ELSE 1 END), last_modification_date = strftime('%s') WHERE new.group_id IS NOT NULL AND id_group = new.group_id; UPDATE MediaGroup SET nb_present_video = nb_present_video - (CASE old.import_type WHEN 0 THEN (CASE old.is_present WHEN 0 THEN 0 ELSE (CASE old.type WHEN 1 THEN 1 ELSE 0 END) END) ELSE 0 END), nb_video = nb_video - (CASE old.import_type WHEN 0 THEN (CASE old.type WHEN 1 THEN 1 ELSE 0 END) ELSE 0 END), nb_present_audio = nb_present_audio - (CASE old.import_type WHEN 0 THEN (CASE old.is_present WHEN 0 THEN 0 ELSE (CASE old.type WHEN 2 THEN 1 ELSE 0 END) END) ELSE 0 END), nb_audio = nb_audio - (CASE old.import_type WHEN 0 THEN (CASE old.type WHEN 2 THEN 1 ELSE 0 END) ELSE 0 END), nb_present_unknown = nb_present_unknown - (CASE old.import_type WHEN 0 THEN (CASE old.is_present WHEN 0 THEN 0 ELSE (CASE old.type WHEN 0 THEN 1 ELSE 0 END) END) ELSE 0 END), nb_unknown = nb_unknown - (CASE old.import_type WHEN 0 THEN (CASE old.type WHEN 0 THEN 1 ELSE 0 END) ELSE 0 END), nb_external = nb_external - (CASE old.import_type WHEN 0 THEN 0 ELSE 1 END), last_modification_date = strftime('%s') WHERE old.group_id IS NOT NULL AND id_group = old.group_id; END;
+CREATE INDEX media_group_forced_singleton ON MediaGroup(forced_singleton);
+CREATE INDEX media_group_duration ON MediaGroup(duration);
+CREATE INDEX media_group_creation_date ON MediaGroup(creation_date);
+CREATE INDEX media_group_last_modification_date ON MediaGroup(last_modification_date);
+CREATE INDEX movie_media_idx ON Movie(media_id);
+CREATE INDEX task_parent_folder_id_idx ON Task(parent_folder_id);
+CREATE INDEX task_file_id_idx ON Task(file_id);
+CREATE INDEX task_uncompleted_idx ON Task(parent_folder_id) WHERE step & 3 != 3 AND attempts_left > 0;
+CREATE INDEX bookmark_media_id_idx ON Bookmark(media_id);
+CREATE INDEX chapter_media_id_idx ON Chapter(media_id);
+CREATE TRIGGER subscription_propagate_task_deletion AFTER DELETE ON Subscription BEGIN DELETE FROM Task; END;
+CREATE TRIGGER subscription_increment_cached_size AFTER INSERT ON File WHEN new.type = 8 BEGIN UPDATE Subscription SET cached_size = cached_size + IFNULL(new.size, 0) WHERE id_subscription IN (SELECT subscription_id FROM SubscriptionMediaRelation WHERE media_id = new.media_id); END;
+CREATE TRIGGER subscription_decrement_cached_size AFTER DELETE ON File WHEN old.type = 8 BEGIN UPDATE Subscription SET cached_size = cached_size - IFNULL(old.size, 0) WHERE id_subscription IN (SELECT subscription_id FROM SubscriptionMediaRelation WHERE media_id = old.media_id); END;
+CREATE TRIGGER subscription_decrement_cached_size_on_removal AFTER DELETE ON SubscriptionMediaRelation BEGIN UPDATE Subscription SET cached_size = cached_size - IFNULL((SELECT size FROM File WHERE type = 8 AND media_id = old.media_id), 0) WHERE id_subscription = old.subscription_id; END;
+CREATE TRIGGER subscription_increment_media_counters_on_insert AFTER INSERT ON SubscriptionMediaRelation BEGIN UPDATE Subscription SET nb_media = nb_media + 1, nb_unplayed_media = nb_unplayed_media + IIF((SELECT play_count FROM Media WHERE id_media = new.media_id) = 0, 1, 0) WHERE id_subscription = new.subscription_id; END;
+CREATE TRIGGER subscription_decrement_media_counters_on_removal AFTER DELETE ON SubscriptionMediaRelation BEGIN UPDATE Subscription SET nb_media = nb_media - 1, nb_unplayed_media = nb_unplayed_media - EXISTS(SELECT id_media FROM Media WHERE play_count = 0 AND id_media = old.media_id) WHERE id_subscription = old.subscription_id; END;
+CREATE TRIGGER subscription_decrement_media_counters_on_media_destroy AFTER DELETE ON Media WHEN old.nb_subscriptions > 0 BEGIN UPDATE Subscription SET nb_unplayed_media = nb_unplayed_media - IIF(old.play_count = 0, items.cnt, 0) FROM (SELECT COUNT(media_id) AS cnt, subscription_id FROM SubscriptionMediaRelation WHERE media_id = old.id_media GROUP BY subscription_id) AS items WHERE id_subscription = items.subscription_id; DELETE FROM SubscriptionMediaRelation WHERE  media_id = old.id_media; END;
+CREATE TRIGGER subscription_update_unplayed_media AFTER UPDATE OF play_count ON Media WHEN old.play_count != new.play_count AND (old.play_count = 0 OR new.play_count = 0) BEGIN UPDATE Subscription SET nb_unplayed_media = nb_unplayed_media + (items.cnt * IIF(new.play_count = 0, 1, -1)) FROM (SELECT COUNT(media_id) AS cnt, subscription_id FROM SubscriptionMediaRelation WHERE media_id = old.id_media GROUP BY subscription_id) AS items WHERE id_subscription = items.subscription_id; END;
+CREATE TRIGGER subscription_insert_fts AFTER INSERT ON Subscription BEGIN INSERT INTO SubscriptionFts(rowid, name) VALUES(new.id_subscription, new.name); END;
+CREATE TRIGGER subscription_update_fts AFTER UPDATE OF name ON Subscription BEGIN UPDATE SubscriptionFts SET name = new.name WHERE rowid = new.id_subscription; END;
+CREATE TRIGGER subscription_delete_fts BEFORE DELETE ON Subscription BEGIN DELETE FROM SubscriptionFts WHERE rowid = old.id_subscription; END;
+CREATE INDEX subscription_service_id_idx ON Subscription(service_id);
+CREATE INDEX subscription_rel_media_id_idx ON SubscriptionMediaRelation(media_id);
+CREATE INDEX subscription_rel_subscription_id_idx ON SubscriptionMediaRelation(subscription_id);
+CREATE TRIGGER service_increment_nb_subs AFTER INSERT ON Subscription BEGIN UPDATE Service SET nb_subscriptions = nb_subscriptions + 1 WHERE id_service = new.service_id; END;
+CREATE TRIGGER service_decrement_nb_subs AFTER DELETE ON Subscription BEGIN UPDATE Service SET nb_subscriptions = nb_subscriptions - 1 WHERE id_service = old.service_id; END;
+CREATE TRIGGER service_update_media_counters AFTER UPDATE OF nb_media, nb_unplayed_media ON Subscription WHEN old.nb_unplayed_media != new.nb_unplayed_media OR old.nb_media != new.nb_unplayed_media BEGIN UPDATE Service SET nb_media = nb_media + (new.nb_media - old.nb_media), nb_unplayed_media = nb_unplayed_media + (new.nb_unplayed_media - old.nb_unplayed_media) WHERE id_service = new.service_id; END;
+CREATE TRIGGER service_decrement_media_counters_sub_removal AFTER DELETE ON Subscription WHEN old.nb_unplayed_media > 0 OR old.nb_media > 0 BEGIN UPDATE Service SET nb_media = nb_media - old.nb_media, nb_unplayed_media = nb_unplayed_media - old.nb_unplayed_media WHERE id_service = old.service_id; END;
+CREATE INDEX cache_manifest_dirty_idx ON CacheManifest(state) WHERE state != 1 OR file_id IS NULL;
+INSERT INTO Settings VALUES(42,2,6,2,1073741824,-1073741824);
+INSERT INTO Device VALUES(1,'{dummy-device}','file://',0,1,0,0);
+INSERT INTO Folder VALUES(1,'file:///builds/videolan/medialibrary/dummysamples/','dummysamples',NULL,0,1,0,0,0,0,0,0);
+INSERT INTO Folder VALUES(2,'file:///builds/videolan/medialibrary/dummysamples/artist_2/','artist_2',1,0,1,0,0,0,0,0,0);
+INSERT INTO Folder VALUES(3,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/','album_10',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(4,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/','album_9',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(5,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/','album_8',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(6,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/','album_7',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(7,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/','album_6',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(8,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/','album_5',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(9,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/','album_4',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(10,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/','album_3',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(11,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/','album_2',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(12,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/','album_1',2,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(13,'file:///builds/videolan/medialibrary/dummysamples/artist_1/','artist_1',1,0,1,0,0,0,0,0,0);
+INSERT INTO Folder VALUES(14,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/','album_10',13,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(15,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/','album_9',13,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(16,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/','album_8',13,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(17,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/','album_7',13,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(18,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/','album_6',13,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(19,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/','album_5',13,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(20,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/','album_4',13,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(21,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/','album_3',13,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(22,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/','album_2',13,0,1,0,10,0,0,0,0);
+INSERT INTO Folder VALUES(23,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/','album_1',13,0,1,0,10,0,0,0,0);
+INSERT INTO Media VALUES(1,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_1','track_1.mp3',0,1,1,0,3,0,NULL,0,3,1,1,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(2,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_2','track_2.mp3',0,1,1,0,3,0,NULL,0,3,2,2,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(3,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_3','track_3.mp3',0,1,1,0,3,0,NULL,0,3,3,3,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(4,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_4','track_4.mp3',0,1,1,0,3,0,NULL,0,3,4,4,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(5,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_5','track_5.mp3',0,1,1,0,3,0,NULL,0,3,5,5,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(6,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_6','track_6.mp3',0,1,1,0,3,0,NULL,0,3,6,6,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(7,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_7','track_7.mp3',0,1,1,0,3,0,NULL,0,3,7,7,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(8,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_8','track_8.mp3',0,1,1,0,3,0,NULL,0,3,8,8,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(9,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_9','track_9.mp3',0,1,1,0,3,0,NULL,0,3,9,9,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(10,2,3,639,-1.0,-1,0,NULL,1707820703,1262304000,'track_10','track_10.mp3',0,1,1,0,3,0,NULL,0,3,8,10,1,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(11,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_1','track_1.mp3',0,1,1,0,4,0,NULL,0,3,2,1,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(12,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_2','track_2.mp3',0,1,1,0,4,0,NULL,0,3,10,2,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(13,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_3','track_3.mp3',0,1,1,0,4,0,NULL,0,3,11,3,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(14,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_4','track_4.mp3',0,1,1,0,4,0,NULL,0,3,12,4,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(15,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_5','track_5.mp3',0,1,1,0,4,0,NULL,0,3,13,5,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(16,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_6','track_6.mp3',0,1,1,0,4,0,NULL,0,3,12,6,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(17,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_7','track_7.mp3',0,1,1,0,4,0,NULL,0,3,14,7,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(18,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_8','track_8.mp3',0,1,1,0,4,0,NULL,0,3,15,8,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(19,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_9','track_9.mp3',0,1,1,0,4,0,NULL,0,3,16,9,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(20,2,3,639,-1.0,-1,0,NULL,1707820703,1230768000,'track_10','track_10.mp3',0,1,1,0,4,0,NULL,0,3,17,10,2,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(21,2,3,639,-1.0,-1,0,NULL,1707820703,1199145600,'track_1','track_1.mp3',0,1,1,0,5,0,NULL,0,3,12,1,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(22,2,3,639,-1.0,-1,0,NULL,1707820703,1199145600,'track_2','track_2.mp3',0,1,1,0,5,0,NULL,0,3,16,2,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(23,2,3,639,-1.0,-1,0,NULL,1707820703,1199145600,'track_3','track_3.mp3',0,1,1,0,5,0,NULL,0,3,18,3,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(24,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_4','track_4.mp3',0,1,1,0,5,0,NULL,0,3,19,4,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(25,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_5','track_5.mp3',0,1,1,0,5,0,NULL,0,3,8,5,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(26,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_6','track_6.mp3',0,1,1,0,5,0,NULL,0,3,20,6,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(27,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_7','track_7.mp3',0,1,1,0,5,0,NULL,0,3,21,7,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(28,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_8','track_8.mp3',0,1,1,0,5,0,NULL,0,3,22,8,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(29,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_9','track_9.mp3',0,1,1,0,5,0,NULL,0,3,23,9,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(30,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_10','track_10.mp3',0,1,1,0,5,0,NULL,0,3,24,10,3,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(31,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_1','track_1.mp3',0,1,1,0,6,0,NULL,0,3,4,1,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(32,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_2','track_2.mp3',0,1,1,0,6,0,NULL,0,3,25,2,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(33,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_3','track_3.mp3',0,1,1,0,6,0,NULL,0,3,26,3,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(34,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_4','track_4.mp3',0,1,1,0,6,0,NULL,0,3,27,4,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(35,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_5','track_5.mp3',0,1,1,0,6,0,NULL,0,3,11,5,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(36,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_6','track_6.mp3',0,1,1,0,6,0,NULL,0,3,2,6,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(37,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_7','track_7.mp3',0,1,1,0,6,0,NULL,0,3,6,7,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(38,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_8','track_8.mp3',0,1,1,0,6,0,NULL,0,3,28,8,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(39,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_9','track_9.mp3',0,1,1,0,6,0,NULL,0,3,29,9,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(40,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_10','track_10.mp3',0,1,1,0,6,0,NULL,0,3,11,10,4,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(41,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_1','track_1.mp3',0,1,1,0,7,0,NULL,0,3,30,1,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(42,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_2','track_2.mp3',0,1,1,0,7,0,NULL,0,3,11,2,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(43,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_3','track_3.mp3',0,1,1,0,7,0,NULL,0,3,27,3,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(44,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_4','track_4.mp3',0,1,1,0,7,0,NULL,0,3,2,4,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(45,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_5','track_5.mp3',0,1,1,0,7,0,NULL,0,3,31,5,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(46,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_6','track_6.mp3',0,1,1,0,7,0,NULL,0,3,32,6,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(47,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_7','track_7.mp3',0,1,1,0,7,0,NULL,0,3,33,7,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(48,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_8','track_8.mp3',0,1,1,0,7,0,NULL,0,3,31,8,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(49,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_9','track_9.mp3',0,1,1,0,7,0,NULL,0,3,8,9,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(50,2,3,639,-1.0,-1,0,NULL,1707820704,1136073600,'track_10','track_10.mp3',0,1,1,0,7,0,NULL,0,3,34,10,5,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(51,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_1','track_1.mp3',0,1,1,0,8,0,NULL,0,3,35,1,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(52,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_2','track_2.mp3',0,1,1,0,8,0,NULL,0,3,36,2,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(53,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_3','track_3.mp3',0,1,1,0,8,0,NULL,0,3,37,3,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(54,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_4','track_4.mp3',0,1,1,0,8,0,NULL,0,3,2,4,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(55,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_5','track_5.mp3',0,1,1,0,8,0,NULL,0,3,20,5,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(56,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_6','track_6.mp3',0,1,1,0,8,0,NULL,0,3,28,6,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(57,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_7','track_7.mp3',0,1,1,0,8,0,NULL,0,3,38,7,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(58,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_8','track_8.mp3',0,1,1,0,8,0,NULL,0,3,22,8,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(59,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_9','track_9.mp3',0,1,1,0,8,0,NULL,0,3,7,9,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(60,2,3,639,-1.0,-1,0,NULL,1707820704,1104537600,'track_10','track_10.mp3',0,1,1,0,8,0,NULL,0,3,39,10,6,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(61,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_1','track_1.mp3',0,1,1,0,9,0,NULL,0,3,21,1,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(62,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_2','track_2.mp3',0,1,1,0,9,0,NULL,0,3,40,2,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(63,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_3','track_3.mp3',0,1,1,0,9,0,NULL,0,3,41,3,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(64,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_4','track_4.mp3',0,1,1,0,9,0,NULL,0,3,21,4,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(65,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_5','track_5.mp3',0,1,1,0,9,0,NULL,0,3,27,5,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(66,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_6','track_6.mp3',0,1,1,0,9,0,NULL,0,3,8,6,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(67,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_7','track_7.mp3',0,1,1,0,9,0,NULL,0,3,5,7,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(68,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_8','track_8.mp3',0,1,1,0,9,0,NULL,0,3,42,8,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(69,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_9','track_9.mp3',0,1,1,0,9,0,NULL,0,3,43,9,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(70,2,3,639,-1.0,-1,0,NULL,1707820704,1072915200,'track_10','track_10.mp3',0,1,1,0,9,0,NULL,0,3,44,10,7,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(71,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_1','track_1.mp3',0,1,1,0,10,0,NULL,0,3,45,1,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(72,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_2','track_2.mp3',0,1,1,0,10,0,NULL,0,3,44,2,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(73,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_3','track_3.mp3',0,1,1,0,10,0,NULL,0,3,46,3,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(74,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_4','track_4.mp3',0,1,1,0,10,0,NULL,0,3,38,4,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(75,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_5','track_5.mp3',0,1,1,0,10,0,NULL,0,3,8,5,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(76,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_6','track_6.mp3',0,1,1,0,10,0,NULL,0,3,47,6,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(77,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_7','track_7.mp3',0,1,1,0,10,0,NULL,0,3,48,7,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(78,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_8','track_8.mp3',0,1,1,0,10,0,NULL,0,3,49,8,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(79,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_9','track_9.mp3',0,1,1,0,10,0,NULL,0,3,48,9,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(80,2,3,639,-1.0,-1,0,NULL,1707820704,1041379200,'track_10','track_10.mp3',0,1,1,0,10,0,NULL,0,3,46,10,8,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(81,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_1','track_1.mp3',0,1,1,0,11,0,NULL,0,3,38,1,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(82,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_2','track_2.mp3',0,1,1,0,11,0,NULL,0,3,1,2,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(83,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_3','track_3.mp3',0,1,1,0,11,0,NULL,0,3,38,3,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(84,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_4','track_4.mp3',0,1,1,0,11,0,NULL,0,3,21,4,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(85,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_5','track_5.mp3',0,1,1,0,11,0,NULL,0,3,5,5,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(86,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_6','track_6.mp3',0,1,1,0,11,0,NULL,0,3,28,6,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(87,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_7','track_7.mp3',0,1,1,0,11,0,NULL,0,3,25,7,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(88,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_8','track_8.mp3',0,1,1,0,11,0,NULL,0,3,48,8,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(89,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_9','track_9.mp3',0,1,1,0,11,0,NULL,0,3,42,9,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(90,2,3,639,-1.0,-1,0,NULL,1707820704,1009843200,'track_10','track_10.mp3',0,1,1,0,11,0,NULL,0,3,21,10,9,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(91,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_1','track_1.mp3',0,1,1,0,12,0,NULL,0,3,50,1,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(92,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_2','track_2.mp3',0,1,1,0,12,0,NULL,0,3,31,2,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(93,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_3','track_3.mp3',0,1,1,0,12,0,NULL,0,3,38,3,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(94,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_4','track_4.mp3',0,1,1,0,12,0,NULL,0,3,51,4,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(95,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_5','track_5.mp3',0,1,1,0,12,0,NULL,0,3,45,5,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(96,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_6','track_6.mp3',0,1,1,0,12,0,NULL,0,3,45,6,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(97,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_7','track_7.mp3',0,1,1,0,12,0,NULL,0,3,12,7,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(98,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_8','track_8.mp3',0,1,1,0,12,0,NULL,0,3,25,8,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(99,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_9','track_9.mp3',0,1,1,0,12,0,NULL,0,3,16,9,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(100,2,3,639,-1.0,-1,0,NULL,1707820704,978307200,'track_10','track_10.mp3',0,1,1,0,12,0,NULL,0,3,52,10,10,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(101,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_1','track_1.mp3',0,1,1,0,14,0,NULL,0,4,49,1,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(102,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_2','track_2.mp3',0,1,1,0,14,0,NULL,0,4,24,2,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(103,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_3','track_3.mp3',0,1,1,0,14,0,NULL,0,4,42,3,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(104,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_4','track_4.mp3',0,1,1,0,14,0,NULL,0,4,40,4,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(105,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_5','track_5.mp3',0,1,1,0,14,0,NULL,0,4,13,5,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(106,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_6','track_6.mp3',0,1,1,0,14,0,NULL,0,4,24,6,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(107,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_7','track_7.mp3',0,1,1,0,14,0,NULL,0,4,3,7,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(108,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_8','track_8.mp3',0,1,1,0,14,0,NULL,0,4,53,8,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(109,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_9','track_9.mp3',0,1,1,0,14,0,NULL,0,4,34,9,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(110,2,3,639,-1.0,-1,0,NULL,1707820704,1262304000,'track_10','track_10.mp3',0,1,1,0,14,0,NULL,0,4,30,10,11,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(111,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_1','track_1.mp3',0,1,1,0,15,0,NULL,0,4,22,1,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(112,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_2','track_2.mp3',0,1,1,0,15,0,NULL,0,4,47,2,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(113,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_3','track_3.mp3',0,1,1,0,15,0,NULL,0,4,7,3,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(114,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_4','track_4.mp3',0,1,1,0,15,0,NULL,0,4,28,4,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(115,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_5','track_5.mp3',0,1,1,0,15,0,NULL,0,4,31,5,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(116,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_6','track_6.mp3',0,1,1,0,15,0,NULL,0,4,54,6,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(117,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_7','track_7.mp3',0,1,1,0,15,0,NULL,0,4,38,7,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(118,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_8','track_8.mp3',0,1,1,0,15,0,NULL,0,4,27,8,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(119,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_9','track_9.mp3',0,1,1,0,15,0,NULL,0,4,12,9,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(120,2,3,639,-1.0,-1,0,NULL,1707820704,1230768000,'track_10','track_10.mp3',0,1,1,0,15,0,NULL,0,4,55,10,12,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(121,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_1','track_1.mp3',0,1,1,0,16,0,NULL,0,4,56,1,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(122,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_2','track_2.mp3',0,1,1,0,16,0,NULL,0,4,20,2,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(123,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_3','track_3.mp3',0,1,1,0,16,0,NULL,0,4,2,3,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(124,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_4','track_4.mp3',0,1,1,0,16,0,NULL,0,4,27,4,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(125,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_5','track_5.mp3',0,1,1,0,16,0,NULL,0,4,57,5,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(126,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_6','track_6.mp3',0,1,1,0,16,0,NULL,0,4,19,6,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(127,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_7','track_7.mp3',0,1,1,0,16,0,NULL,0,4,2,7,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(128,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_8','track_8.mp3',0,1,1,0,16,0,NULL,0,4,16,8,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(129,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_9','track_9.mp3',0,1,1,0,16,0,NULL,0,4,8,9,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(130,2,3,639,-1.0,-1,0,NULL,1707820704,1199145600,'track_10','track_10.mp3',0,1,1,0,16,0,NULL,0,4,10,10,13,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(131,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_1','track_1.mp3',0,1,1,0,17,0,NULL,0,4,55,1,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(132,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_2','track_2.mp3',0,1,1,0,17,0,NULL,0,4,16,2,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(133,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_3','track_3.mp3',0,1,1,0,17,0,NULL,0,4,58,3,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(134,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_4','track_4.mp3',0,1,1,0,17,0,NULL,0,4,21,4,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(135,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_5','track_5.mp3',0,1,1,0,17,0,NULL,0,4,2,5,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(136,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_6','track_6.mp3',0,1,1,0,17,0,NULL,0,4,8,6,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(137,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_7','track_7.mp3',0,1,1,0,17,0,NULL,0,4,22,7,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(138,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_8','track_8.mp3',0,1,1,0,17,0,NULL,0,4,30,8,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(139,2,3,639,-1.0,-1,0,NULL,1707820704,1167609600,'track_9','track_9.mp3',0,1,1,0,17,0,NULL,0,4,16,9,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(140,2,3,639,-1.0,-1,0,NULL,1707820705,1167609600,'track_10','track_10.mp3',0,1,1,0,17,0,NULL,0,4,26,10,14,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(141,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_1','track_1.mp3',0,1,1,0,18,0,NULL,0,4,59,1,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(142,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_2','track_2.mp3',0,1,1,0,18,0,NULL,0,4,43,2,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(143,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_3','track_3.mp3',0,1,1,0,18,0,NULL,0,4,60,3,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(144,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_4','track_4.mp3',0,1,1,0,18,0,NULL,0,4,23,4,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(145,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_5','track_5.mp3',0,1,1,0,18,0,NULL,0,4,32,5,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(146,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_6','track_6.mp3',0,1,1,0,18,0,NULL,0,4,36,6,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(147,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_7','track_7.mp3',0,1,1,0,18,0,NULL,0,4,49,7,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(148,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_8','track_8.mp3',0,1,1,0,18,0,NULL,0,4,60,8,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(149,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_9','track_9.mp3',0,1,1,0,18,0,NULL,0,4,55,9,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(150,2,3,639,-1.0,-1,0,NULL,1707820705,1136073600,'track_10','track_10.mp3',0,1,1,0,18,0,NULL,0,4,11,10,15,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(151,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_1','track_1.mp3',0,1,1,0,19,0,NULL,0,4,23,1,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(152,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_2','track_2.mp3',0,1,1,0,19,0,NULL,0,4,61,2,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(153,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_3','track_3.mp3',0,1,1,0,19,0,NULL,0,4,8,3,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(154,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_4','track_4.mp3',0,1,1,0,19,0,NULL,0,4,48,4,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(155,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_5','track_5.mp3',0,1,1,0,19,0,NULL,0,4,58,5,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(156,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_6','track_6.mp3',0,1,1,0,19,0,NULL,0,4,52,6,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(157,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_7','track_7.mp3',0,1,1,0,19,0,NULL,0,4,20,7,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(158,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_8','track_8.mp3',0,1,1,0,19,0,NULL,0,4,1,8,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(159,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_9','track_9.mp3',0,1,1,0,19,0,NULL,0,4,20,9,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(160,2,3,639,-1.0,-1,0,NULL,1707820705,1104537600,'track_10','track_10.mp3',0,1,1,0,19,0,NULL,0,4,9,10,16,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(161,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_1','track_1.mp3',0,1,1,0,20,0,NULL,0,4,19,1,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(162,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_2','track_2.mp3',0,1,1,0,20,0,NULL,0,4,4,2,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(163,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_3','track_3.mp3',0,1,1,0,20,0,NULL,0,4,22,3,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(164,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_4','track_4.mp3',0,1,1,0,20,0,NULL,0,4,62,4,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(165,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_5','track_5.mp3',0,1,1,0,20,0,NULL,0,4,53,5,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(166,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_6','track_6.mp3',0,1,1,0,20,0,NULL,0,4,63,6,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(167,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_7','track_7.mp3',0,1,1,0,20,0,NULL,0,4,8,7,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(168,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_8','track_8.mp3',0,1,1,0,20,0,NULL,0,4,48,8,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(169,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_9','track_9.mp3',0,1,1,0,20,0,NULL,0,4,20,9,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(170,2,3,639,-1.0,-1,0,NULL,1707820705,1072915200,'track_10','track_10.mp3',0,1,1,0,20,0,NULL,0,4,64,10,17,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(171,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_1','track_1.mp3',0,1,1,0,21,0,NULL,0,4,65,1,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(172,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_2','track_2.mp3',0,1,1,0,21,0,NULL,0,4,6,2,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(173,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_3','track_3.mp3',0,1,1,0,21,0,NULL,0,4,16,3,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(174,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_4','track_4.mp3',0,1,1,0,21,0,NULL,0,4,50,4,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(175,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_5','track_5.mp3',0,1,1,0,21,0,NULL,0,4,27,5,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(176,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_6','track_6.mp3',0,1,1,0,21,0,NULL,0,4,22,6,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(177,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_7','track_7.mp3',0,1,1,0,21,0,NULL,0,4,8,7,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(178,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_8','track_8.mp3',0,1,1,0,21,0,NULL,0,4,45,8,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(179,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_9','track_9.mp3',0,1,1,0,21,0,NULL,0,4,66,9,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(180,2,3,639,-1.0,-1,0,NULL,1707820705,1041379200,'track_10','track_10.mp3',0,1,1,0,21,0,NULL,0,4,67,10,18,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(181,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_1','track_1.mp3',0,1,1,0,22,0,NULL,0,4,5,1,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(182,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_2','track_2.mp3',0,1,1,0,22,0,NULL,0,4,51,2,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(183,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_3','track_3.mp3',0,1,1,0,22,0,NULL,0,4,68,3,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(184,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_4','track_4.mp3',0,1,1,0,22,0,NULL,0,4,7,4,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(185,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_5','track_5.mp3',0,1,1,0,22,0,NULL,0,4,3,5,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(186,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_6','track_6.mp3',0,1,1,0,22,0,NULL,0,4,54,6,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(187,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_7','track_7.mp3',0,1,1,0,22,0,NULL,0,4,53,7,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(188,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_8','track_8.mp3',0,1,1,0,22,0,NULL,0,4,20,8,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(189,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_9','track_9.mp3',0,1,1,0,22,0,NULL,0,4,33,9,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(190,2,3,639,-1.0,-1,0,NULL,1707820705,1009843200,'track_10','track_10.mp3',0,1,1,0,22,0,NULL,0,4,69,10,19,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(191,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_1','track_1.mp3',0,1,1,0,23,0,NULL,0,4,48,1,20,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(192,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_2','track_2.mp3',0,1,1,0,23,0,NULL,0,4,30,2,20,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(193,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_3','track_3.mp3',0,1,1,0,23,0,NULL,0,4,70,3,20,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(194,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_4','track_4.mp3',0,1,1,0,23,0,NULL,0,4,19,4,20,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(195,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_5','track_5.mp3',0,1,1,0,23,0,NULL,0,4,45,5,20,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(196,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_6','track_6.mp3',0,1,1,0,23,0,NULL,0,4,28,6,20,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(197,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_7','track_7.mp3',0,1,1,0,23,0,NULL,0,4,32,7,20,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(198,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_8','track_8.mp3',0,1,1,0,23,0,NULL,0,4,42,8,20,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(199,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_9','track_9.mp3',0,1,1,0,23,0,NULL,0,4,69,9,20,0,NULL,0,0,NULL);
+INSERT INTO Media VALUES(200,2,3,639,-1.0,-1,0,NULL,1707820705,978307200,'track_10','track_10.mp3',0,1,1,0,23,0,NULL,0,4,22,10,20,0,NULL,0,0,NULL);
+INSERT INTO File VALUES(1,1,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_1.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(2,2,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_2.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(3,3,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_3.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(4,4,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_4.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(5,5,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_5.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(6,6,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_6.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(7,7,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_7.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(8,8,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_8.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(9,9,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_9.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(10,10,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_10.mp3',1,1707820703,6272,3,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(11,11,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_1.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(12,12,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_2.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(13,13,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_3.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(14,14,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_4.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(15,15,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_5.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(16,16,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_6.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(17,17,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_7.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(18,18,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_8.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(19,19,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_9.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(20,20,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_10.mp3',1,1707820703,6272,4,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(21,21,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_1.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(22,22,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_2.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(23,23,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_3.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820703,0);
+INSERT INTO File VALUES(24,24,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_4.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(25,25,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_5.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(26,26,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_6.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(27,27,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_7.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(28,28,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_8.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(29,29,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_9.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(30,30,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_10.mp3',1,1707820703,6272,5,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(31,31,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_1.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(32,32,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_2.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(33,33,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_3.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(34,34,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_4.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(35,35,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_5.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(36,36,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_6.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(37,37,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_7.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(38,38,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_8.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(39,39,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_9.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(40,40,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_10.mp3',1,1707820703,6272,6,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(41,41,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_1.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(42,42,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_2.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(43,43,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_3.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(44,44,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_4.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(45,45,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_5.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(46,46,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_6.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(47,47,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_7.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(48,48,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_8.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(49,49,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_9.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(50,50,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_10.mp3',1,1707820703,6272,7,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(51,51,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_1.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(52,52,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_2.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(53,53,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_3.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(54,54,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_4.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(55,55,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_5.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(56,56,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_6.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(57,57,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_7.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(58,58,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_8.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(59,59,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_9.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(60,60,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_10.mp3',1,1707820703,6272,8,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(61,61,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_1.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(62,62,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_2.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(63,63,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_3.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(64,64,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_4.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(65,65,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_5.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(66,66,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_6.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(67,67,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_7.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(68,68,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_8.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(69,69,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_9.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(70,70,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_10.mp3',1,1707820703,6272,9,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(71,71,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_1.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(72,72,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_2.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(73,73,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_3.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(74,74,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_4.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(75,75,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_5.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(76,76,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_6.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(77,77,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_7.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(78,78,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_8.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(79,79,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_9.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(80,80,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_10.mp3',1,1707820703,6272,10,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(81,81,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_1.mp3',1,1707820702,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(82,82,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_2.mp3',1,1707820702,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(83,83,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_3.mp3',1,1707820702,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(84,84,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_4.mp3',1,1707820702,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(85,85,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_5.mp3',1,1707820702,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(86,86,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_6.mp3',1,1707820702,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(87,87,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_7.mp3',1,1707820702,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(88,88,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_8.mp3',1,1707820702,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(89,89,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_9.mp3',1,1707820702,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(90,90,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_10.mp3',1,1707820703,6272,11,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(91,91,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_1.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(92,92,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_2.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(93,93,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_3.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(94,94,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_4.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(95,95,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_5.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(96,96,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_6.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(97,97,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_7.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(98,98,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_8.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(99,99,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_9.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(100,100,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_10.mp3',1,1707820702,6272,12,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(101,101,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_1.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(102,102,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_2.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(103,103,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_3.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(104,104,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_4.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(105,105,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_5.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(106,106,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_6.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(107,107,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_7.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(108,108,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_8.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(109,109,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_9.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(110,110,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_10.mp3',1,1707820702,6272,14,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(111,111,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_1.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(112,112,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_2.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(113,113,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_3.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(114,114,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_4.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(115,115,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_5.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(116,116,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_6.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(117,117,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_7.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(118,118,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_8.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(119,119,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_9.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(120,120,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_10.mp3',1,1707820702,6272,15,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(121,121,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_1.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(122,122,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_2.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(123,123,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_3.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(124,124,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_4.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(125,125,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_5.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(126,126,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_6.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(127,127,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_7.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(128,128,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_8.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(129,129,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_9.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(130,130,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_10.mp3',1,1707820702,6272,16,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(131,131,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_1.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(132,132,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_2.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(133,133,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_3.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(134,134,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_4.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(135,135,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_5.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(136,136,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_6.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(137,137,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_7.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(138,138,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_8.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(139,139,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_9.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820704,0);
+INSERT INTO File VALUES(140,140,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_10.mp3',1,1707820702,6272,17,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(141,141,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_1.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(142,142,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_2.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(143,143,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_3.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(144,144,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_4.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(145,145,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_5.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(146,146,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_6.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(147,147,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_7.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(148,148,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_8.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(149,149,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_9.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(150,150,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_10.mp3',1,1707820702,6272,18,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(151,151,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_1.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(152,152,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_2.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(153,153,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_3.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(154,154,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_4.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(155,155,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_5.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(156,156,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_6.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(157,157,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_7.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(158,158,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_8.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(159,159,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_9.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(160,160,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_10.mp3',1,1707820702,6272,19,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(161,161,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_1.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(162,162,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_2.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(163,163,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_3.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(164,164,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_4.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(165,165,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_5.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(166,166,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_6.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(167,167,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_7.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(168,168,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_8.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(169,169,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_9.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(170,170,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_10.mp3',1,1707820702,6272,20,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(171,171,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_1.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(172,172,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_2.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(173,173,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_3.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(174,174,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_4.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(175,175,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_5.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(176,176,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_6.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(177,177,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_7.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(178,178,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_8.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(179,179,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_9.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(180,180,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_10.mp3',1,1707820702,6272,21,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(181,181,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_1.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(182,182,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_2.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(183,183,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_3.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(184,184,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_4.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(185,185,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_5.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(186,186,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_6.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(187,187,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_7.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(188,188,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_8.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(189,189,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_9.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(190,190,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_10.mp3',1,1707820702,6272,22,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(191,191,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_1.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(192,192,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_2.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(193,193,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_3.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(194,194,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_4.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(195,195,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_5.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(196,196,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_6.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(197,197,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_7.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(198,198,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_8.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(199,199,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_9.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(200,200,NULL,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_10.mp3',1,1707820702,6272,23,0,0,0,NULL,1707820705,0);
+INSERT INTO File VALUES(201,1,NULL,'file:///builds/videolan/medialibrary/cache/1_track_1.mp3',8,0,6272,NULL,0,0,0,NULL,1707820706,2);
+INSERT INTO CacheManifest VALUES('1_track_1.mp3',201,6272,0,1);
+INSERT INTO Genre VALUES(1,'Jazz',3,3,0);
+INSERT INTO Genre VALUES(2,'Rap',8,8,0);
+INSERT INTO Genre VALUES(3,'Pranks',3,3,0);
+INSERT INTO Genre VALUES(4,'Christian Rap',3,3,0);
+INSERT INTO Genre VALUES(5,'Instrumental Pop',4,4,0);
+INSERT INTO Genre VALUES(6,'Trailer',3,3,0);
+INSERT INTO Genre VALUES(7,'Pop/Funk',4,4,0);
+INSERT INTO Genre VALUES(8,'Soundtrack',11,11,0);
+INSERT INTO Genre VALUES(9,'Showtunes',2,2,0);
+INSERT INTO Genre VALUES(10,'Euro-Techno',2,2,0);
+INSERT INTO Genre VALUES(11,'Top 40',5,5,0);
+INSERT INTO Genre VALUES(12,'Trip-Hop',5,5,0);
+INSERT INTO Genre VALUES(13,'Other',2,2,0);
+INSERT INTO Genre VALUES(14,'Vocal',1,1,0);
+INSERT INTO Genre VALUES(15,'Rave',1,1,0);
+INSERT INTO Genre VALUES(16,'Meditative',7,7,0);
+INSERT INTO Genre VALUES(17,'Ambient',1,1,0);
+INSERT INTO Genre VALUES(18,'Pop-Folk',1,1,0);
+INSERT INTO Genre VALUES(19,'Instrumental Rock',4,4,0);
+INSERT INTO Genre VALUES(20,'Hip-Hop',7,7,0);
+INSERT INTO Genre VALUES(21,'Gospel',6,6,0);
+INSERT INTO Genre VALUES(22,'Bass',7,7,0);
+INSERT INTO Genre VALUES(23,'Space',3,3,0);
+INSERT INTO Genre VALUES(24,'Ska',3,3,0);
+INSERT INTO Genre VALUES(25,'Comedy',3,3,0);
+INSERT INTO Genre VALUES(26,'Metal',2,2,0);
+INSERT INTO Genre VALUES(27,'Dream',6,6,0);
+INSERT INTO Genre VALUES(28,'Gothic',5,5,0);
+INSERT INTO Genre VALUES(29,'Jungle',1,1,0);
+INSERT INTO Genre VALUES(30,'Native American',4,4,0);
+INSERT INTO Genre VALUES(31,'Folk',4,4,0);
+INSERT INTO Genre VALUES(32,'Eurodance',3,3,0);
+INSERT INTO Genre VALUES(33,'Techno',2,2,0);
+INSERT INTO Genre VALUES(34,'Disco',2,2,0);
+INSERT INTO Genre VALUES(35,'Retro',1,1,0);
+INSERT INTO Genre VALUES(36,'New Age',2,2,0);
+INSERT INTO Genre VALUES(37,'Rock & Roll',1,1,0);
+INSERT INTO Genre VALUES(38,'Southern Rock',6,6,0);
+INSERT INTO Genre VALUES(39,'Ethnic',1,1,0);
+INSERT INTO Genre VALUES(40,'Punk',2,2,0);
+INSERT INTO Genre VALUES(41,'Lo-Fi',1,1,0);
+INSERT INTO Genre VALUES(42,'Alternative Rock',4,4,0);
+INSERT INTO Genre VALUES(43,'Darkwave',2,2,0);
+INSERT INTO Genre VALUES(44,'Oldies',2,2,0);
+INSERT INTO Genre VALUES(45,'House',5,5,0);
+INSERT INTO Genre VALUES(46,'Instrumental',2,2,0);
+INSERT INTO Genre VALUES(47,'Grunge',2,2,0);
+INSERT INTO Genre VALUES(48,'Industrial',6,6,0);
+INSERT INTO Genre VALUES(49,'Electronic',3,3,0);
+INSERT INTO Genre VALUES(50,'Pop',2,2,0);
+INSERT INTO Genre VALUES(51,'Soul',2,2,0);
+INSERT INTO Genre VALUES(52,'Gangsta',2,2,0);
+INSERT INTO Genre VALUES(53,'Musical',3,3,0);
+INSERT INTO Genre VALUES(54,'Classical',2,2,0);
+INSERT INTO Genre VALUES(55,'Acid Jazz',3,3,0);
+INSERT INTO Genre VALUES(56,'Acid',1,1,0);
+INSERT INTO Genre VALUES(57,'Sound Clip',1,1,0);
+INSERT INTO Genre VALUES(58,'Trance',2,2,0);
+INSERT INTO Genre VALUES(59,'Classic Rock',1,1,0);
+INSERT INTO Genre VALUES(60,'Cabaret',2,2,0);
+INSERT INTO Genre VALUES(61,'Hard Rock',1,1,0);
+INSERT INTO Genre VALUES(62,'Techno-Industrial',1,1,0);
+INSERT INTO Genre VALUES(63,'Tribal',1,1,0);
+INSERT INTO Genre VALUES(64,'Jazz-Funk',1,1,0);
+INSERT INTO Genre VALUES(65,'Acid Punk',1,1,0);
+INSERT INTO Genre VALUES(66,'Reggae',1,1,0);
+INSERT INTO Genre VALUES(67,'Alternative',1,1,0);
+INSERT INTO Genre VALUES(68,'Fusion',1,1,0);
+INSERT INTO Genre VALUES(69,'New Wave',2,2,0);
+INSERT INTO Genre VALUES(70,'Death Metal',1,1,0);
+INSERT INTO Album VALUES(1,'album_10',3,2010,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(2,'album_9',3,2009,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(3,'album_8',3,2008,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(4,'album_7',3,2007,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(5,'album_6',3,2006,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(6,'album_5',3,2005,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(7,'album_4',3,2004,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(8,'album_3',3,2003,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(9,'album_2',3,2002,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(10,'album_1',3,2001,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(11,'album_10',4,2010,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(12,'album_9',4,2009,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(13,'album_8',4,2008,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(14,'album_7',4,2007,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(15,'album_6',4,2006,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(16,'album_5',4,2005,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(17,'album_4',4,2004,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(18,'album_3',4,2003,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(19,'album_2',4,2002,NULL,10,6390,1,10,0);
+INSERT INTO Album VALUES(20,'album_1',4,2001,NULL,10,6390,1,10,0);
+INSERT INTO Show VALUES(1,NULL,0,NULL,NULL,NULL,NULL,0);
+INSERT INTO AudioTrack VALUES(1,'mpga',56000,44100,1,'','',1,NULL);
+INSERT INTO AudioTrack VALUES(2,'mpga',56000,44100,1,'','',2,NULL);
+INSERT INTO AudioTrack VALUES(3,'mpga',56000,44100,1,'','',3,NULL);
+INSERT INTO AudioTrack VALUES(4,'mpga',56000,44100,1,'','',4,NULL);
+INSERT INTO AudioTrack VALUES(5,'mpga',56000,44100,1,'','',5,NULL);
+INSERT INTO AudioTrack VALUES(6,'mpga',56000,44100,1,'','',6,NULL);
+INSERT INTO AudioTrack VALUES(7,'mpga',56000,44100,1,'','',7,NULL);
+INSERT INTO AudioTrack VALUES(8,'mpga',56000,44100,1,'','',8,NULL);
+INSERT INTO AudioTrack VALUES(9,'mpga',56000,44100,1,'','',9,NULL);
+INSERT INTO AudioTrack VALUES(10,'mpga',56000,44100,1,'','',10,NULL);
+INSERT INTO AudioTrack VALUES(11,'mpga',56000,44100,1,'','',11,NULL);
+INSERT INTO AudioTrack VALUES(12,'mpga',56000,44100,1,'','',12,NULL);
+INSERT INTO AudioTrack VALUES(13,'mpga',56000,44100,1,'','',13,NULL);
+INSERT INTO AudioTrack VALUES(14,'mpga',56000,44100,1,'','',14,NULL);
+INSERT INTO AudioTrack VALUES(15,'mpga',56000,44100,1,'','',15,NULL);
+INSERT INTO AudioTrack VALUES(16,'mpga',56000,44100,1,'','',16,NULL);
+INSERT INTO AudioTrack VALUES(17,'mpga',56000,44100,1,'','',17,NULL);
+INSERT INTO AudioTrack VALUES(18,'mpga',56000,44100,1,'','',18,NULL);
+INSERT INTO AudioTrack VALUES(19,'mpga',56000,44100,1,'','',19,NULL);
+INSERT INTO AudioTrack VALUES(20,'mpga',56000,44100,1,'','',20,NULL);
+INSERT INTO AudioTrack VALUES(21,'mpga',56000,44100,1,'','',21,NULL);
+INSERT INTO AudioTrack VALUES(22,'mpga',56000,44100,1,'','',22,NULL);
+INSERT INTO AudioTrack VALUES(23,'mpga',56000,44100,1,'','',23,NULL);
+INSERT INTO AudioTrack VALUES(24,'mpga',56000,44100,1,'','',24,NULL);
+INSERT INTO AudioTrack VALUES(25,'mpga',56000,44100,1,'','',25,NULL);
+INSERT INTO AudioTrack VALUES(26,'mpga',56000,44100,1,'','',26,NULL);
+INSERT INTO AudioTrack VALUES(27,'mpga',56000,44100,1,'','',27,NULL);
+INSERT INTO AudioTrack VALUES(28,'mpga',56000,44100,1,'','',28,NULL);
+INSERT INTO AudioTrack VALUES(29,'mpga',56000,44100,1,'','',29,NULL);
+INSERT INTO AudioTrack VALUES(30,'mpga',56000,44100,1,'','',30,NULL);
+INSERT INTO AudioTrack VALUES(31,'mpga',56000,44100,1,'','',31,NULL);
+INSERT INTO AudioTrack VALUES(32,'mpga',56000,44100,1,'','',32,NULL);
+INSERT INTO AudioTrack VALUES(33,'mpga',56000,44100,1,'','',33,NULL);
+INSERT INTO AudioTrack VALUES(34,'mpga',56000,44100,1,'','',34,NULL);
+INSERT INTO AudioTrack VALUES(35,'mpga',56000,44100,1,'','',35,NULL);
+INSERT INTO AudioTrack VALUES(36,'mpga',56000,44100,1,'','',36,NULL);
+INSERT INTO AudioTrack VALUES(37,'mpga',56000,44100,1,'','',37,NULL);
+INSERT INTO AudioTrack VALUES(38,'mpga',56000,44100,1,'','',38,NULL);
+INSERT INTO AudioTrack VALUES(39,'mpga',56000,44100,1,'','',39,NULL);
+INSERT INTO AudioTrack VALUES(40,'mpga',56000,44100,1,'','',40,NULL);
+INSERT INTO AudioTrack VALUES(41,'mpga',56000,44100,1,'','',41,NULL);
+INSERT INTO AudioTrack VALUES(42,'mpga',56000,44100,1,'','',42,NULL);
+INSERT INTO AudioTrack VALUES(43,'mpga',56000,44100,1,'','',43,NULL);
+INSERT INTO AudioTrack VALUES(44,'mpga',56000,44100,1,'','',44,NULL);
+INSERT INTO AudioTrack VALUES(45,'mpga',56000,44100,1,'','',45,NULL);
+INSERT INTO AudioTrack VALUES(46,'mpga',56000,44100,1,'','',46,NULL);
+INSERT INTO AudioTrack VALUES(47,'mpga',56000,44100,1,'','',47,NULL);
+INSERT INTO AudioTrack VALUES(48,'mpga',56000,44100,1,'','',48,NULL);
+INSERT INTO AudioTrack VALUES(49,'mpga',56000,44100,1,'','',49,NULL);
+INSERT INTO AudioTrack VALUES(50,'mpga',56000,44100,1,'','',50,NULL);
+INSERT INTO AudioTrack VALUES(51,'mpga',56000,44100,1,'','',51,NULL);
+INSERT INTO AudioTrack VALUES(52,'mpga',56000,44100,1,'','',52,NULL);
+INSERT INTO AudioTrack VALUES(53,'mpga',56000,44100,1,'','',53,NULL);
+INSERT INTO AudioTrack VALUES(54,'mpga',56000,44100,1,'','',54,NULL);
+INSERT INTO AudioTrack VALUES(55,'mpga',56000,44100,1,'','',55,NULL);
+INSERT INTO AudioTrack VALUES(56,'mpga',56000,44100,1,'','',56,NULL);
+INSERT INTO AudioTrack VALUES(57,'mpga',56000,44100,1,'','',57,NULL);
+INSERT INTO AudioTrack VALUES(58,'mpga',56000,44100,1,'','',58,NULL);
+INSERT INTO AudioTrack VALUES(59,'mpga',56000,44100,1,'','',59,NULL);
+INSERT INTO AudioTrack VALUES(60,'mpga',56000,44100,1,'','',60,NULL);
+INSERT INTO AudioTrack VALUES(61,'mpga',56000,44100,1,'','',61,NULL);
+INSERT INTO AudioTrack VALUES(62,'mpga',56000,44100,1,'','',62,NULL);
+INSERT INTO AudioTrack VALUES(63,'mpga',56000,44100,1,'','',63,NULL);
+INSERT INTO AudioTrack VALUES(64,'mpga',56000,44100,1,'','',64,NULL);
+INSERT INTO AudioTrack VALUES(65,'mpga',56000,44100,1,'','',65,NULL);
+INSERT INTO AudioTrack VALUES(66,'mpga',56000,44100,1,'','',66,NULL);
+INSERT INTO AudioTrack VALUES(67,'mpga',56000,44100,1,'','',67,NULL);
+INSERT INTO AudioTrack VALUES(68,'mpga',56000,44100,1,'','',68,NULL);
+INSERT INTO AudioTrack VALUES(69,'mpga',56000,44100,1,'','',69,NULL);
+INSERT INTO AudioTrack VALUES(70,'mpga',56000,44100,1,'','',70,NULL);
+INSERT INTO AudioTrack VALUES(71,'mpga',56000,44100,1,'','',71,NULL);
+INSERT INTO AudioTrack VALUES(72,'mpga',56000,44100,1,'','',72,NULL);
+INSERT INTO AudioTrack VALUES(73,'mpga',56000,44100,1,'','',73,NULL);
+INSERT INTO AudioTrack VALUES(74,'mpga',56000,44100,1,'','',74,NULL);
+INSERT INTO AudioTrack VALUES(75,'mpga',56000,44100,1,'','',75,NULL);
+INSERT INTO AudioTrack VALUES(76,'mpga',56000,44100,1,'','',76,NULL);
+INSERT INTO AudioTrack VALUES(77,'mpga',56000,44100,1,'','',77,NULL);
+INSERT INTO AudioTrack VALUES(78,'mpga',56000,44100,1,'','',78,NULL);
+INSERT INTO AudioTrack VALUES(79,'mpga',56000,44100,1,'','',79,NULL);
+INSERT INTO AudioTrack VALUES(80,'mpga',56000,44100,1,'','',80,NULL);
+INSERT INTO AudioTrack VALUES(81,'mpga',56000,44100,1,'','',81,NULL);
+INSERT INTO AudioTrack VALUES(82,'mpga',56000,44100,1,'','',82,NULL);
+INSERT INTO AudioTrack VALUES(83,'mpga',56000,44100,1,'','',83,NULL);
+INSERT INTO AudioTrack VALUES(84,'mpga',56000,44100,1,'','',84,NULL);
+INSERT INTO AudioTrack VALUES(85,'mpga',56000,44100,1,'','',85,NULL);
+INSERT INTO AudioTrack VALUES(86,'mpga',56000,44100,1,'','',86,NULL);
+INSERT INTO AudioTrack VALUES(87,'mpga',56000,44100,1,'','',87,NULL);
+INSERT INTO AudioTrack VALUES(88,'mpga',56000,44100,1,'','',88,NULL);
+INSERT INTO AudioTrack VALUES(89,'mpga',56000,44100,1,'','',89,NULL);
+INSERT INTO AudioTrack VALUES(90,'mpga',56000,44100,1,'','',90,NULL);
+INSERT INTO AudioTrack VALUES(91,'mpga',56000,44100,1,'','',91,NULL);
+INSERT INTO AudioTrack VALUES(92,'mpga',56000,44100,1,'','',92,NULL);
+INSERT INTO AudioTrack VALUES(93,'mpga',56000,44100,1,'','',93,NULL);
+INSERT INTO AudioTrack VALUES(94,'mpga',56000,44100,1,'','',94,NULL);
+INSERT INTO AudioTrack VALUES(95,'mpga',56000,44100,1,'','',95,NULL);
+INSERT INTO AudioTrack VALUES(96,'mpga',56000,44100,1,'','',96,NULL);
+INSERT INTO AudioTrack VALUES(97,'mpga',56000,44100,1,'','',97,NULL);
+INSERT INTO AudioTrack VALUES(98,'mpga',56000,44100,1,'','',98,NULL);
+INSERT INTO AudioTrack VALUES(99,'mpga',56000,44100,1,'','',99,NULL);
+INSERT INTO AudioTrack VALUES(100,'mpga',56000,44100,1,'','',100,NULL);
+INSERT INTO AudioTrack VALUES(101,'mpga',56000,44100,1,'','',101,NULL);
+INSERT INTO AudioTrack VALUES(102,'mpga',56000,44100,1,'','',102,NULL);
+INSERT INTO AudioTrack VALUES(103,'mpga',56000,44100,1,'','',103,NULL);
+INSERT INTO AudioTrack VALUES(104,'mpga',56000,44100,1,'','',104,NULL);
+INSERT INTO AudioTrack VALUES(105,'mpga',56000,44100,1,'','',105,NULL);
+INSERT INTO AudioTrack VALUES(106,'mpga',56000,44100,1,'','',106,NULL);
+INSERT INTO AudioTrack VALUES(107,'mpga',56000,44100,1,'','',107,NULL);
+INSERT INTO AudioTrack VALUES(108,'mpga',56000,44100,1,'','',108,NULL);
+INSERT INTO AudioTrack VALUES(109,'mpga',56000,44100,1,'','',109,NULL);
+INSERT INTO AudioTrack VALUES(110,'mpga',56000,44100,1,'','',110,NULL);
+INSERT INTO AudioTrack VALUES(111,'mpga',56000,44100,1,'','',111,NULL);
+INSERT INTO AudioTrack VALUES(112,'mpga',56000,44100,1,'','',112,NULL);
+INSERT INTO AudioTrack VALUES(113,'mpga',56000,44100,1,'','',113,NULL);
+INSERT INTO AudioTrack VALUES(114,'mpga',56000,44100,1,'','',114,NULL);
+INSERT INTO AudioTrack VALUES(115,'mpga',56000,44100,1,'','',115,NULL);
+INSERT INTO AudioTrack VALUES(116,'mpga',56000,44100,1,'','',116,NULL);
+INSERT INTO AudioTrack VALUES(117,'mpga',56000,44100,1,'','',117,NULL);
+INSERT INTO AudioTrack VALUES(118,'mpga',56000,44100,1,'','',118,NULL);
+INSERT INTO AudioTrack VALUES(119,'mpga',56000,44100,1,'','',119,NULL);
+INSERT INTO AudioTrack VALUES(120,'mpga',56000,44100,1,'','',120,NULL);
+INSERT INTO AudioTrack VALUES(121,'mpga',56000,44100,1,'','',121,NULL);
+INSERT INTO AudioTrack VALUES(122,'mpga',56000,44100,1,'','',122,NULL);
+INSERT INTO AudioTrack VALUES(123,'mpga',56000,44100,1,'','',123,NULL);
+INSERT INTO AudioTrack VALUES(124,'mpga',56000,44100,1,'','',124,NULL);
+INSERT INTO AudioTrack VALUES(125,'mpga',56000,44100,1,'','',125,NULL);
+INSERT INTO AudioTrack VALUES(126,'mpga',56000,44100,1,'','',126,NULL);
+INSERT INTO AudioTrack VALUES(127,'mpga',56000,44100,1,'','',127,NULL);
+INSERT INTO AudioTrack VALUES(128,'mpga',56000,44100,1,'','',128,NULL);
+INSERT INTO AudioTrack VALUES(129,'mpga',56000,44100,1,'','',129,NULL);
+INSERT INTO AudioTrack VALUES(130,'mpga',56000,44100,1,'','',130,NULL);
+INSERT INTO AudioTrack VALUES(131,'mpga',56000,44100,1,'','',131,NULL);
+INSERT INTO AudioTrack VALUES(132,'mpga',56000,44100,1,'','',132,NULL);
+INSERT INTO AudioTrack VALUES(133,'mpga',56000,44100,1,'','',133,NULL);
+INSERT INTO AudioTrack VALUES(134,'mpga',56000,44100,1,'','',134,NULL);
+INSERT INTO AudioTrack VALUES(135,'mpga',56000,44100,1,'','',135,NULL);
+INSERT INTO AudioTrack VALUES(136,'mpga',56000,44100,1,'','',136,NULL);
+INSERT INTO AudioTrack VALUES(137,'mpga',56000,44100,1,'','',137,NULL);
+INSERT INTO AudioTrack VALUES(138,'mpga',56000,44100,1,'','',138,NULL);
+INSERT INTO AudioTrack VALUES(139,'mpga',56000,44100,1,'','',139,NULL);
+INSERT INTO AudioTrack VALUES(140,'mpga',56000,44100,1,'','',140,NULL);
+INSERT INTO AudioTrack VALUES(141,'mpga',56000,44100,1,'','',141,NULL);
+INSERT INTO AudioTrack VALUES(142,'mpga',56000,44100,1,'','',142,NULL);
+INSERT INTO AudioTrack VALUES(143,'mpga',56000,44100,1,'','',143,NULL);
+INSERT INTO AudioTrack VALUES(144,'mpga',56000,44100,1,'','',144,NULL);
+INSERT INTO AudioTrack VALUES(145,'mpga',56000,44100,1,'','',145,NULL);
+INSERT INTO AudioTrack VALUES(146,'mpga',56000,44100,1,'','',146,NULL);
+INSERT INTO AudioTrack VALUES(147,'mpga',56000,44100,1,'','',147,NULL);
+INSERT INTO AudioTrack VALUES(148,'mpga',56000,44100,1,'','',148,NULL);
+INSERT INTO AudioTrack VALUES(149,'mpga',56000,44100,1,'','',149,NULL);
+INSERT INTO AudioTrack VALUES(150,'mpga',56000,44100,1,'','',150,NULL);
+INSERT INTO AudioTrack VALUES(151,'mpga',56000,44100,1,'','',151,NULL);
+INSERT INTO AudioTrack VALUES(152,'mpga',56000,44100,1,'','',152,NULL);
+INSERT INTO AudioTrack VALUES(153,'mpga',56000,44100,1,'','',153,NULL);
+INSERT INTO AudioTrack VALUES(154,'mpga',56000,44100,1,'','',154,NULL);
+INSERT INTO AudioTrack VALUES(155,'mpga',56000,44100,1,'','',155,NULL);
+INSERT INTO AudioTrack VALUES(156,'mpga',56000,44100,1,'','',156,NULL);
+INSERT INTO AudioTrack VALUES(157,'mpga',56000,44100,1,'','',157,NULL);
+INSERT INTO AudioTrack VALUES(158,'mpga',56000,44100,1,'','',158,NULL);
+INSERT INTO AudioTrack VALUES(159,'mpga',56000,44100,1,'','',159,NULL);
+INSERT INTO AudioTrack VALUES(160,'mpga',56000,44100,1,'','',160,NULL);
+INSERT INTO AudioTrack VALUES(161,'mpga',56000,44100,1,'','',161,NULL);
+INSERT INTO AudioTrack VALUES(162,'mpga',56000,44100,1,'','',162,NULL);
+INSERT INTO AudioTrack VALUES(163,'mpga',56000,44100,1,'','',163,NULL);
+INSERT INTO AudioTrack VALUES(164,'mpga',56000,44100,1,'','',164,NULL);
+INSERT INTO AudioTrack VALUES(165,'mpga',56000,44100,1,'','',165,NULL);
+INSERT INTO AudioTrack VALUES(166,'mpga',56000,44100,1,'','',166,NULL);
+INSERT INTO AudioTrack VALUES(167,'mpga',56000,44100,1,'','',167,NULL);
+INSERT INTO AudioTrack VALUES(168,'mpga',56000,44100,1,'','',168,NULL);
+INSERT INTO AudioTrack VALUES(169,'mpga',56000,44100,1,'','',169,NULL);
+INSERT INTO AudioTrack VALUES(170,'mpga',56000,44100,1,'','',170,NULL);
+INSERT INTO AudioTrack VALUES(171,'mpga',56000,44100,1,'','',171,NULL);
+INSERT INTO AudioTrack VALUES(172,'mpga',56000,44100,1,'','',172,NULL);
+INSERT INTO AudioTrack VALUES(173,'mpga',56000,44100,1,'','',173,NULL);
+INSERT INTO AudioTrack VALUES(174,'mpga',56000,44100,1,'','',174,NULL);
+INSERT INTO AudioTrack VALUES(175,'mpga',56000,44100,1,'','',175,NULL);
+INSERT INTO AudioTrack VALUES(176,'mpga',56000,44100,1,'','',176,NULL);
+INSERT INTO AudioTrack VALUES(177,'mpga',56000,44100,1,'','',177,NULL);
+INSERT INTO AudioTrack VALUES(178,'mpga',56000,44100,1,'','',178,NULL);
+INSERT INTO AudioTrack VALUES(179,'mpga',56000,44100,1,'','',179,NULL);
+INSERT INTO AudioTrack VALUES(180,'mpga',56000,44100,1,'','',180,NULL);
+INSERT INTO AudioTrack VALUES(181,'mpga',56000,44100,1,'','',181,NULL);
+INSERT INTO AudioTrack VALUES(182,'mpga',56000,44100,1,'','',182,NULL);
+INSERT INTO AudioTrack VALUES(183,'mpga',56000,44100,1,'','',183,NULL);
+INSERT INTO AudioTrack VALUES(184,'mpga',56000,44100,1,'','',184,NULL);
+INSERT INTO AudioTrack VALUES(185,'mpga',56000,44100,1,'','',185,NULL);
+INSERT INTO AudioTrack VALUES(186,'mpga',56000,44100,1,'','',186,NULL);
+INSERT INTO AudioTrack VALUES(187,'mpga',56000,44100,1,'','',187,NULL);
+INSERT INTO AudioTrack VALUES(188,'mpga',56000,44100,1,'','',188,NULL);
+INSERT INTO AudioTrack VALUES(189,'mpga',56000,44100,1,'','',189,NULL);
+INSERT INTO AudioTrack VALUES(190,'mpga',56000,44100,1,'','',190,NULL);
+INSERT INTO AudioTrack VALUES(191,'mpga',56000,44100,1,'','',191,NULL);
+INSERT INTO AudioTrack VALUES(192,'mpga',56000,44100,1,'','',192,NULL);
+INSERT INTO AudioTrack VALUES(193,'mpga',56000,44100,1,'','',193,NULL);
+INSERT INTO AudioTrack VALUES(194,'mpga',56000,44100,1,'','',194,NULL);
+INSERT INTO AudioTrack VALUES(195,'mpga',56000,44100,1,'','',195,NULL);
+INSERT INTO AudioTrack VALUES(196,'mpga',56000,44100,1,'','',196,NULL);
+INSERT INTO AudioTrack VALUES(197,'mpga',56000,44100,1,'','',197,NULL);
+INSERT INTO AudioTrack VALUES(198,'mpga',56000,44100,1,'','',198,NULL);
+INSERT INTO AudioTrack VALUES(199,'mpga',56000,44100,1,'','',199,NULL);
+INSERT INTO AudioTrack VALUES(200,'mpga',56000,44100,1,'','',200,NULL);
+INSERT INTO Artist VALUES(1,NULL,NULL,0,0,NULL,0,0);
+INSERT INTO Artist VALUES(2,NULL,NULL,0,0,NULL,0,0);
+INSERT INTO Artist VALUES(3,'artist_2',NULL,10,100,NULL,100,0);
+INSERT INTO Artist VALUES(4,'artist_1',NULL,10,100,NULL,100,0);
+INSERT INTO MediaArtistRelation VALUES(1,3);
+INSERT INTO MediaArtistRelation VALUES(2,3);
+INSERT INTO MediaArtistRelation VALUES(3,3);
+INSERT INTO MediaArtistRelation VALUES(4,3);
+INSERT INTO MediaArtistRelation VALUES(5,3);
+INSERT INTO MediaArtistRelation VALUES(6,3);
+INSERT INTO MediaArtistRelation VALUES(7,3);
+INSERT INTO MediaArtistRelation VALUES(8,3);
+INSERT INTO MediaArtistRelation VALUES(9,3);
+INSERT INTO MediaArtistRelation VALUES(10,3);
+INSERT INTO MediaArtistRelation VALUES(11,3);
+INSERT INTO MediaArtistRelation VALUES(12,3);
+INSERT INTO MediaArtistRelation VALUES(13,3);
+INSERT INTO MediaArtistRelation VALUES(14,3);
+INSERT INTO MediaArtistRelation VALUES(15,3);
+INSERT INTO MediaArtistRelation VALUES(16,3);
+INSERT INTO MediaArtistRelation VALUES(17,3);
+INSERT INTO MediaArtistRelation VALUES(18,3);
+INSERT INTO MediaArtistRelation VALUES(19,3);
+INSERT INTO MediaArtistRelation VALUES(20,3);
+INSERT INTO MediaArtistRelation VALUES(21,3);
+INSERT INTO MediaArtistRelation VALUES(22,3);
+INSERT INTO MediaArtistRelation VALUES(23,3);
+INSERT INTO MediaArtistRelation VALUES(24,3);
+INSERT INTO MediaArtistRelation VALUES(25,3);
+INSERT INTO MediaArtistRelation VALUES(26,3);
+INSERT INTO MediaArtistRelation VALUES(27,3);
+INSERT INTO MediaArtistRelation VALUES(28,3);
+INSERT INTO MediaArtistRelation VALUES(29,3);
+INSERT INTO MediaArtistRelation VALUES(30,3);
+INSERT INTO MediaArtistRelation VALUES(31,3);
+INSERT INTO MediaArtistRelation VALUES(32,3);
+INSERT INTO MediaArtistRelation VALUES(33,3);
+INSERT INTO MediaArtistRelation VALUES(34,3);
+INSERT INTO MediaArtistRelation VALUES(35,3);
+INSERT INTO MediaArtistRelation VALUES(36,3);
+INSERT INTO MediaArtistRelation VALUES(37,3);
+INSERT INTO MediaArtistRelation VALUES(38,3);
+INSERT INTO MediaArtistRelation VALUES(39,3);
+INSERT INTO MediaArtistRelation VALUES(40,3);
+INSERT INTO MediaArtistRelation VALUES(41,3);
+INSERT INTO MediaArtistRelation VALUES(42,3);
+INSERT INTO MediaArtistRelation VALUES(43,3);
+INSERT INTO MediaArtistRelation VALUES(44,3);
+INSERT INTO MediaArtistRelation VALUES(45,3);
+INSERT INTO MediaArtistRelation VALUES(46,3);
+INSERT INTO MediaArtistRelation VALUES(47,3);
+INSERT INTO MediaArtistRelation VALUES(48,3);
+INSERT INTO MediaArtistRelation VALUES(49,3);
+INSERT INTO MediaArtistRelation VALUES(50,3);
+INSERT INTO MediaArtistRelation VALUES(51,3);
+INSERT INTO MediaArtistRelation VALUES(52,3);
+INSERT INTO MediaArtistRelation VALUES(53,3);
+INSERT INTO MediaArtistRelation VALUES(54,3);
+INSERT INTO MediaArtistRelation VALUES(55,3);
+INSERT INTO MediaArtistRelation VALUES(56,3);
+INSERT INTO MediaArtistRelation VALUES(57,3);
+INSERT INTO MediaArtistRelation VALUES(58,3);
+INSERT INTO MediaArtistRelation VALUES(59,3);
+INSERT INTO MediaArtistRelation VALUES(60,3);
+INSERT INTO MediaArtistRelation VALUES(61,3);
+INSERT INTO MediaArtistRelation VALUES(62,3);
+INSERT INTO MediaArtistRelation VALUES(63,3);
+INSERT INTO MediaArtistRelation VALUES(64,3);
+INSERT INTO MediaArtistRelation VALUES(65,3);
+INSERT INTO MediaArtistRelation VALUES(66,3);
+INSERT INTO MediaArtistRelation VALUES(67,3);
+INSERT INTO MediaArtistRelation VALUES(68,3);
+INSERT INTO MediaArtistRelation VALUES(69,3);
+INSERT INTO MediaArtistRelation VALUES(70,3);
+INSERT INTO MediaArtistRelation VALUES(71,3);
+INSERT INTO MediaArtistRelation VALUES(72,3);
+INSERT INTO MediaArtistRelation VALUES(73,3);
+INSERT INTO MediaArtistRelation VALUES(74,3);
+INSERT INTO MediaArtistRelation VALUES(75,3);
+INSERT INTO MediaArtistRelation VALUES(76,3);
+INSERT INTO MediaArtistRelation VALUES(77,3);
+INSERT INTO MediaArtistRelation VALUES(78,3);
+INSERT INTO MediaArtistRelation VALUES(79,3);
+INSERT INTO MediaArtistRelation VALUES(80,3);
+INSERT INTO MediaArtistRelation VALUES(81,3);
+INSERT INTO MediaArtistRelation VALUES(82,3);
+INSERT INTO MediaArtistRelation VALUES(83,3);
+INSERT INTO MediaArtistRelation VALUES(84,3);
+INSERT INTO MediaArtistRelation VALUES(85,3);
+INSERT INTO MediaArtistRelation VALUES(86,3);
+INSERT INTO MediaArtistRelation VALUES(87,3);
+INSERT INTO MediaArtistRelation VALUES(88,3);
+INSERT INTO MediaArtistRelation VALUES(89,3);
+INSERT INTO MediaArtistRelation VALUES(90,3);
+INSERT INTO MediaArtistRelation VALUES(91,3);
+INSERT INTO MediaArtistRelation VALUES(92,3);
+INSERT INTO MediaArtistRelation VALUES(93,3);
+INSERT INTO MediaArtistRelation VALUES(94,3);
+INSERT INTO MediaArtistRelation VALUES(95,3);
+INSERT INTO MediaArtistRelation VALUES(96,3);
+INSERT INTO MediaArtistRelation VALUES(97,3);
+INSERT INTO MediaArtistRelation VALUES(98,3);
+INSERT INTO MediaArtistRelation VALUES(99,3);
+INSERT INTO MediaArtistRelation VALUES(100,3);
+INSERT INTO MediaArtistRelation VALUES(101,4);
+INSERT INTO MediaArtistRelation VALUES(102,4);
+INSERT INTO MediaArtistRelation VALUES(103,4);
+INSERT INTO MediaArtistRelation VALUES(104,4);
+INSERT INTO MediaArtistRelation VALUES(105,4);
+INSERT INTO MediaArtistRelation VALUES(106,4);
+INSERT INTO MediaArtistRelation VALUES(107,4);
+INSERT INTO MediaArtistRelation VALUES(108,4);
+INSERT INTO MediaArtistRelation VALUES(109,4);
+INSERT INTO MediaArtistRelation VALUES(110,4);
+INSERT INTO MediaArtistRelation VALUES(111,4);
+INSERT INTO MediaArtistRelation VALUES(112,4);
+INSERT INTO MediaArtistRelation VALUES(113,4);
+INSERT INTO MediaArtistRelation VALUES(114,4);
+INSERT INTO MediaArtistRelation VALUES(115,4);
+INSERT INTO MediaArtistRelation VALUES(116,4);
+INSERT INTO MediaArtistRelation VALUES(117,4);
+INSERT INTO MediaArtistRelation VALUES(118,4);
+INSERT INTO MediaArtistRelation VALUES(119,4);
+INSERT INTO MediaArtistRelation VALUES(120,4);
+INSERT INTO MediaArtistRelation VALUES(121,4);
+INSERT INTO MediaArtistRelation VALUES(122,4);
+INSERT INTO MediaArtistRelation VALUES(123,4);
+INSERT INTO MediaArtistRelation VALUES(124,4);
+INSERT INTO MediaArtistRelation VALUES(125,4);
+INSERT INTO MediaArtistRelation VALUES(126,4);
+INSERT INTO MediaArtistRelation VALUES(127,4);
+INSERT INTO MediaArtistRelation VALUES(128,4);
+INSERT INTO MediaArtistRelation VALUES(129,4);
+INSERT INTO MediaArtistRelation VALUES(130,4);
+INSERT INTO MediaArtistRelation VALUES(131,4);
+INSERT INTO MediaArtistRelation VALUES(132,4);
+INSERT INTO MediaArtistRelation VALUES(133,4);
+INSERT INTO MediaArtistRelation VALUES(134,4);
+INSERT INTO MediaArtistRelation VALUES(135,4);
+INSERT INTO MediaArtistRelation VALUES(136,4);
+INSERT INTO MediaArtistRelation VALUES(137,4);
+INSERT INTO MediaArtistRelation VALUES(138,4);
+INSERT INTO MediaArtistRelation VALUES(139,4);
+INSERT INTO MediaArtistRelation VALUES(140,4);
+INSERT INTO MediaArtistRelation VALUES(141,4);
+INSERT INTO MediaArtistRelation VALUES(142,4);
+INSERT INTO MediaArtistRelation VALUES(143,4);
+INSERT INTO MediaArtistRelation VALUES(144,4);
+INSERT INTO MediaArtistRelation VALUES(145,4);
+INSERT INTO MediaArtistRelation VALUES(146,4);
+INSERT INTO MediaArtistRelation VALUES(147,4);
+INSERT INTO MediaArtistRelation VALUES(148,4);
+INSERT INTO MediaArtistRelation VALUES(149,4);
+INSERT INTO MediaArtistRelation VALUES(150,4);
+INSERT INTO MediaArtistRelation VALUES(151,4);
+INSERT INTO MediaArtistRelation VALUES(152,4);
+INSERT INTO MediaArtistRelation VALUES(153,4);
+INSERT INTO MediaArtistRelation VALUES(154,4);
+INSERT INTO MediaArtistRelation VALUES(155,4);
+INSERT INTO MediaArtistRelation VALUES(156,4);
+INSERT INTO MediaArtistRelation VALUES(157,4);
+INSERT INTO MediaArtistRelation VALUES(158,4);
+INSERT INTO MediaArtistRelation VALUES(159,4);
+INSERT INTO MediaArtistRelation VALUES(160,4);
+INSERT INTO MediaArtistRelation VALUES(161,4);
+INSERT INTO MediaArtistRelation VALUES(162,4);
+INSERT INTO MediaArtistRelation VALUES(163,4);
+INSERT INTO MediaArtistRelation VALUES(164,4);
+INSERT INTO MediaArtistRelation VALUES(165,4);
+INSERT INTO MediaArtistRelation VALUES(166,4);
+INSERT INTO MediaArtistRelation VALUES(167,4);
+INSERT INTO MediaArtistRelation VALUES(168,4);
+INSERT INTO MediaArtistRelation VALUES(169,4);
+INSERT INTO MediaArtistRelation VALUES(170,4);
+INSERT INTO MediaArtistRelation VALUES(171,4);
+INSERT INTO MediaArtistRelation VALUES(172,4);
+INSERT INTO MediaArtistRelation VALUES(173,4);
+INSERT INTO MediaArtistRelation VALUES(174,4);
+INSERT INTO MediaArtistRelation VALUES(175,4);
+INSERT INTO MediaArtistRelation VALUES(176,4);
+INSERT INTO MediaArtistRelation VALUES(177,4);
+INSERT INTO MediaArtistRelation VALUES(178,4);
+INSERT INTO MediaArtistRelation VALUES(179,4);
+INSERT INTO MediaArtistRelation VALUES(180,4);
+INSERT INTO MediaArtistRelation VALUES(181,4);
+INSERT INTO MediaArtistRelation VALUES(182,4);
+INSERT INTO MediaArtistRelation VALUES(183,4);
+INSERT INTO MediaArtistRelation VALUES(184,4);
+INSERT INTO MediaArtistRelation VALUES(185,4);
+INSERT INTO MediaArtistRelation VALUES(186,4);
+INSERT INTO MediaArtistRelation VALUES(187,4);
+INSERT INTO MediaArtistRelation VALUES(188,4);
+INSERT INTO MediaArtistRelation VALUES(189,4);
+INSERT INTO MediaArtistRelation VALUES(190,4);
+INSERT INTO MediaArtistRelation VALUES(191,4);
+INSERT INTO MediaArtistRelation VALUES(192,4);
+INSERT INTO MediaArtistRelation VALUES(193,4);
+INSERT INTO MediaArtistRelation VALUES(194,4);
+INSERT INTO MediaArtistRelation VALUES(195,4);
+INSERT INTO MediaArtistRelation VALUES(196,4);
+INSERT INTO MediaArtistRelation VALUES(197,4);
+INSERT INTO MediaArtistRelation VALUES(198,4);
+INSERT INTO MediaArtistRelation VALUES(199,4);
+INSERT INTO MediaArtistRelation VALUES(200,4);
+INSERT INTO Task VALUES(1,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_1.mp3',1,1,3,0,0,0,'');
+INSERT INTO Task VALUES(2,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_2.mp3',1,2,3,0,0,0,'');
+INSERT INTO Task VALUES(3,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_3.mp3',1,3,3,0,0,0,'');
+INSERT INTO Task VALUES(4,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_4.mp3',1,4,3,0,0,0,'');
+INSERT INTO Task VALUES(5,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_5.mp3',1,5,3,0,0,0,'');
+INSERT INTO Task VALUES(6,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_6.mp3',1,6,3,0,0,0,'');
+INSERT INTO Task VALUES(7,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_7.mp3',1,7,3,0,0,0,'');
+INSERT INTO Task VALUES(8,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_8.mp3',1,8,3,0,0,0,'');
+INSERT INTO Task VALUES(9,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_9.mp3',1,9,3,0,0,0,'');
+INSERT INTO Task VALUES(10,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_10/track_10.mp3',1,10,3,0,0,0,'');
+INSERT INTO Task VALUES(11,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_1.mp3',1,11,4,0,0,0,'');
+INSERT INTO Task VALUES(12,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_2.mp3',1,12,4,0,0,0,'');
+INSERT INTO Task VALUES(13,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_3.mp3',1,13,4,0,0,0,'');
+INSERT INTO Task VALUES(14,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_4.mp3',1,14,4,0,0,0,'');
+INSERT INTO Task VALUES(15,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_5.mp3',1,15,4,0,0,0,'');
+INSERT INTO Task VALUES(16,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_6.mp3',1,16,4,0,0,0,'');
+INSERT INTO Task VALUES(17,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_7.mp3',1,17,4,0,0,0,'');
+INSERT INTO Task VALUES(18,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_8.mp3',1,18,4,0,0,0,'');
+INSERT INTO Task VALUES(19,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_9.mp3',1,19,4,0,0,0,'');
+INSERT INTO Task VALUES(20,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_9/track_10.mp3',1,20,4,0,0,0,'');
+INSERT INTO Task VALUES(21,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_1.mp3',1,21,5,0,0,0,'');
+INSERT INTO Task VALUES(22,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_2.mp3',1,22,5,0,0,0,'');
+INSERT INTO Task VALUES(23,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_3.mp3',1,23,5,0,0,0,'');
+INSERT INTO Task VALUES(24,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_4.mp3',1,24,5,0,0,0,'');
+INSERT INTO Task VALUES(25,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_5.mp3',1,25,5,0,0,0,'');
+INSERT INTO Task VALUES(26,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_6.mp3',1,26,5,0,0,0,'');
+INSERT INTO Task VALUES(27,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_7.mp3',1,27,5,0,0,0,'');
+INSERT INTO Task VALUES(28,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_8.mp3',1,28,5,0,0,0,'');
+INSERT INTO Task VALUES(29,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_9.mp3',1,29,5,0,0,0,'');
+INSERT INTO Task VALUES(30,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_8/track_10.mp3',1,30,5,0,0,0,'');
+INSERT INTO Task VALUES(31,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_1.mp3',1,31,6,0,0,0,'');
+INSERT INTO Task VALUES(32,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_2.mp3',1,32,6,0,0,0,'');
+INSERT INTO Task VALUES(33,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_3.mp3',1,33,6,0,0,0,'');
+INSERT INTO Task VALUES(34,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_4.mp3',1,34,6,0,0,0,'');
+INSERT INTO Task VALUES(35,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_5.mp3',1,35,6,0,0,0,'');
+INSERT INTO Task VALUES(36,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_6.mp3',1,36,6,0,0,0,'');
+INSERT INTO Task VALUES(37,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_7.mp3',1,37,6,0,0,0,'');
+INSERT INTO Task VALUES(38,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_8.mp3',1,38,6,0,0,0,'');
+INSERT INTO Task VALUES(39,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_9.mp3',1,39,6,0,0,0,'');
+INSERT INTO Task VALUES(40,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_7/track_10.mp3',1,40,6,0,0,0,'');
+INSERT INTO Task VALUES(41,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_1.mp3',1,41,7,0,0,0,'');
+INSERT INTO Task VALUES(42,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_2.mp3',1,42,7,0,0,0,'');
+INSERT INTO Task VALUES(43,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_3.mp3',1,43,7,0,0,0,'');
+INSERT INTO Task VALUES(44,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_4.mp3',1,44,7,0,0,0,'');
+INSERT INTO Task VALUES(45,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_5.mp3',1,45,7,0,0,0,'');
+INSERT INTO Task VALUES(46,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_6.mp3',1,46,7,0,0,0,'');
+INSERT INTO Task VALUES(47,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_7.mp3',1,47,7,0,0,0,'');
+INSERT INTO Task VALUES(48,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_8.mp3',1,48,7,0,0,0,'');
+INSERT INTO Task VALUES(49,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_9.mp3',1,49,7,0,0,0,'');
+INSERT INTO Task VALUES(50,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_6/track_10.mp3',1,50,7,0,0,0,'');
+INSERT INTO Task VALUES(51,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_1.mp3',1,51,8,0,0,0,'');
+INSERT INTO Task VALUES(52,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_2.mp3',1,52,8,0,0,0,'');
+INSERT INTO Task VALUES(53,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_3.mp3',1,53,8,0,0,0,'');
+INSERT INTO Task VALUES(54,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_4.mp3',1,54,8,0,0,0,'');
+INSERT INTO Task VALUES(55,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_5.mp3',1,55,8,0,0,0,'');
+INSERT INTO Task VALUES(56,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_6.mp3',1,56,8,0,0,0,'');
+INSERT INTO Task VALUES(57,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_7.mp3',1,57,8,0,0,0,'');
+INSERT INTO Task VALUES(58,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_8.mp3',1,58,8,0,0,0,'');
+INSERT INTO Task VALUES(59,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_9.mp3',1,59,8,0,0,0,'');
+INSERT INTO Task VALUES(60,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_5/track_10.mp3',1,60,8,0,0,0,'');
+INSERT INTO Task VALUES(61,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_1.mp3',1,61,9,0,0,0,'');
+INSERT INTO Task VALUES(62,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_2.mp3',1,62,9,0,0,0,'');
+INSERT INTO Task VALUES(63,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_3.mp3',1,63,9,0,0,0,'');
+INSERT INTO Task VALUES(64,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_4.mp3',1,64,9,0,0,0,'');
+INSERT INTO Task VALUES(65,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_5.mp3',1,65,9,0,0,0,'');
+INSERT INTO Task VALUES(66,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_6.mp3',1,66,9,0,0,0,'');
+INSERT INTO Task VALUES(67,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_7.mp3',1,67,9,0,0,0,'');
+INSERT INTO Task VALUES(68,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_8.mp3',1,68,9,0,0,0,'');
+INSERT INTO Task VALUES(69,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_9.mp3',1,69,9,0,0,0,'');
+INSERT INTO Task VALUES(70,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_4/track_10.mp3',1,70,9,0,0,0,'');
+INSERT INTO Task VALUES(71,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_1.mp3',1,71,10,0,0,0,'');
+INSERT INTO Task VALUES(72,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_2.mp3',1,72,10,0,0,0,'');
+INSERT INTO Task VALUES(73,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_3.mp3',1,73,10,0,0,0,'');
+INSERT INTO Task VALUES(74,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_4.mp3',1,74,10,0,0,0,'');
+INSERT INTO Task VALUES(75,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_5.mp3',1,75,10,0,0,0,'');
+INSERT INTO Task VALUES(76,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_6.mp3',1,76,10,0,0,0,'');
+INSERT INTO Task VALUES(77,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_7.mp3',1,77,10,0,0,0,'');
+INSERT INTO Task VALUES(78,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_8.mp3',1,78,10,0,0,0,'');
+INSERT INTO Task VALUES(79,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_9.mp3',1,79,10,0,0,0,'');
+INSERT INTO Task VALUES(80,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_3/track_10.mp3',1,80,10,0,0,0,'');
+INSERT INTO Task VALUES(81,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_1.mp3',1,81,11,0,0,0,'');
+INSERT INTO Task VALUES(82,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_2.mp3',1,82,11,0,0,0,'');
+INSERT INTO Task VALUES(83,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_3.mp3',1,83,11,0,0,0,'');
+INSERT INTO Task VALUES(84,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_4.mp3',1,84,11,0,0,0,'');
+INSERT INTO Task VALUES(85,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_5.mp3',1,85,11,0,0,0,'');
+INSERT INTO Task VALUES(86,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_6.mp3',1,86,11,0,0,0,'');
+INSERT INTO Task VALUES(87,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_7.mp3',1,87,11,0,0,0,'');
+INSERT INTO Task VALUES(88,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_8.mp3',1,88,11,0,0,0,'');
+INSERT INTO Task VALUES(89,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_9.mp3',1,89,11,0,0,0,'');
+INSERT INTO Task VALUES(90,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_2/track_10.mp3',1,90,11,0,0,0,'');
+INSERT INTO Task VALUES(91,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_1.mp3',1,91,12,0,0,0,'');
+INSERT INTO Task VALUES(92,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_2.mp3',1,92,12,0,0,0,'');
+INSERT INTO Task VALUES(93,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_3.mp3',1,93,12,0,0,0,'');
+INSERT INTO Task VALUES(94,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_4.mp3',1,94,12,0,0,0,'');
+INSERT INTO Task VALUES(95,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_5.mp3',1,95,12,0,0,0,'');
+INSERT INTO Task VALUES(96,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_6.mp3',1,96,12,0,0,0,'');
+INSERT INTO Task VALUES(97,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_7.mp3',1,97,12,0,0,0,'');
+INSERT INTO Task VALUES(98,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_8.mp3',1,98,12,0,0,0,'');
+INSERT INTO Task VALUES(99,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_9.mp3',1,99,12,0,0,0,'');
+INSERT INTO Task VALUES(100,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_2/album_1/track_10.mp3',1,100,12,0,0,0,'');
+INSERT INTO Task VALUES(101,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_1.mp3',1,101,14,0,0,0,'');
+INSERT INTO Task VALUES(102,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_2.mp3',1,102,14,0,0,0,'');
+INSERT INTO Task VALUES(103,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_3.mp3',1,103,14,0,0,0,'');
+INSERT INTO Task VALUES(104,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_4.mp3',1,104,14,0,0,0,'');
+INSERT INTO Task VALUES(105,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_5.mp3',1,105,14,0,0,0,'');
+INSERT INTO Task VALUES(106,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_6.mp3',1,106,14,0,0,0,'');
+INSERT INTO Task VALUES(107,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_7.mp3',1,107,14,0,0,0,'');
+INSERT INTO Task VALUES(108,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_8.mp3',1,108,14,0,0,0,'');
+INSERT INTO Task VALUES(109,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_9.mp3',1,109,14,0,0,0,'');
+INSERT INTO Task VALUES(110,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_10/track_10.mp3',1,110,14,0,0,0,'');
+INSERT INTO Task VALUES(111,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_1.mp3',1,111,15,0,0,0,'');
+INSERT INTO Task VALUES(112,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_2.mp3',1,112,15,0,0,0,'');
+INSERT INTO Task VALUES(113,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_3.mp3',1,113,15,0,0,0,'');
+INSERT INTO Task VALUES(114,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_4.mp3',1,114,15,0,0,0,'');
+INSERT INTO Task VALUES(115,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_5.mp3',1,115,15,0,0,0,'');
+INSERT INTO Task VALUES(116,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_6.mp3',1,116,15,0,0,0,'');
+INSERT INTO Task VALUES(117,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_7.mp3',1,117,15,0,0,0,'');
+INSERT INTO Task VALUES(118,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_8.mp3',1,118,15,0,0,0,'');
+INSERT INTO Task VALUES(119,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_9.mp3',1,119,15,0,0,0,'');
+INSERT INTO Task VALUES(120,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_9/track_10.mp3',1,120,15,0,0,0,'');
+INSERT INTO Task VALUES(121,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_1.mp3',1,121,16,0,0,0,'');
+INSERT INTO Task VALUES(122,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_2.mp3',1,122,16,0,0,0,'');
+INSERT INTO Task VALUES(123,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_3.mp3',1,123,16,0,0,0,'');
+INSERT INTO Task VALUES(124,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_4.mp3',1,124,16,0,0,0,'');
+INSERT INTO Task VALUES(125,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_5.mp3',1,125,16,0,0,0,'');
+INSERT INTO Task VALUES(126,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_6.mp3',1,126,16,0,0,0,'');
+INSERT INTO Task VALUES(127,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_7.mp3',1,127,16,0,0,0,'');
+INSERT INTO Task VALUES(128,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_8.mp3',1,128,16,0,0,0,'');
+INSERT INTO Task VALUES(129,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_9.mp3',1,129,16,0,0,0,'');
+INSERT INTO Task VALUES(130,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_8/track_10.mp3',1,130,16,0,0,0,'');
+INSERT INTO Task VALUES(131,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_1.mp3',1,131,17,0,0,0,'');
+INSERT INTO Task VALUES(132,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_2.mp3',1,132,17,0,0,0,'');
+INSERT INTO Task VALUES(133,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_3.mp3',1,133,17,0,0,0,'');
+INSERT INTO Task VALUES(134,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_4.mp3',1,134,17,0,0,0,'');
+INSERT INTO Task VALUES(135,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_5.mp3',1,135,17,0,0,0,'');
+INSERT INTO Task VALUES(136,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_6.mp3',1,136,17,0,0,0,'');
+INSERT INTO Task VALUES(137,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_7.mp3',1,137,17,0,0,0,'');
+INSERT INTO Task VALUES(138,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_8.mp3',1,138,17,0,0,0,'');
+INSERT INTO Task VALUES(139,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_9.mp3',1,139,17,0,0,0,'');
+INSERT INTO Task VALUES(140,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_7/track_10.mp3',1,140,17,0,0,0,'');
+INSERT INTO Task VALUES(141,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_1.mp3',1,141,18,0,0,0,'');
+INSERT INTO Task VALUES(142,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_2.mp3',1,142,18,0,0,0,'');
+INSERT INTO Task VALUES(143,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_3.mp3',1,143,18,0,0,0,'');
+INSERT INTO Task VALUES(144,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_4.mp3',1,144,18,0,0,0,'');
+INSERT INTO Task VALUES(145,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_5.mp3',1,145,18,0,0,0,'');
+INSERT INTO Task VALUES(146,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_6.mp3',1,146,18,0,0,0,'');
+INSERT INTO Task VALUES(147,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_7.mp3',1,147,18,0,0,0,'');
+INSERT INTO Task VALUES(148,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_8.mp3',1,148,18,0,0,0,'');
+INSERT INTO Task VALUES(149,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_9.mp3',1,149,18,0,0,0,'');
+INSERT INTO Task VALUES(150,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_6/track_10.mp3',1,150,18,0,0,0,'');
+INSERT INTO Task VALUES(151,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_1.mp3',1,151,19,0,0,0,'');
+INSERT INTO Task VALUES(152,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_2.mp3',1,152,19,0,0,0,'');
+INSERT INTO Task VALUES(153,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_3.mp3',1,153,19,0,0,0,'');
+INSERT INTO Task VALUES(154,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_4.mp3',1,154,19,0,0,0,'');
+INSERT INTO Task VALUES(155,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_5.mp3',1,155,19,0,0,0,'');
+INSERT INTO Task VALUES(156,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_6.mp3',1,156,19,0,0,0,'');
+INSERT INTO Task VALUES(157,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_7.mp3',1,157,19,0,0,0,'');
+INSERT INTO Task VALUES(158,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_8.mp3',1,158,19,0,0,0,'');
+INSERT INTO Task VALUES(159,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_9.mp3',1,159,19,0,0,0,'');
+INSERT INTO Task VALUES(160,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_5/track_10.mp3',1,160,19,0,0,0,'');
+INSERT INTO Task VALUES(161,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_1.mp3',1,161,20,0,0,0,'');
+INSERT INTO Task VALUES(162,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_2.mp3',1,162,20,0,0,0,'');
+INSERT INTO Task VALUES(163,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_3.mp3',1,163,20,0,0,0,'');
+INSERT INTO Task VALUES(164,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_4.mp3',1,164,20,0,0,0,'');
+INSERT INTO Task VALUES(165,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_5.mp3',1,165,20,0,0,0,'');
+INSERT INTO Task VALUES(166,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_6.mp3',1,166,20,0,0,0,'');
+INSERT INTO Task VALUES(167,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_7.mp3',1,167,20,0,0,0,'');
+INSERT INTO Task VALUES(168,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_8.mp3',1,168,20,0,0,0,'');
+INSERT INTO Task VALUES(169,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_9.mp3',1,169,20,0,0,0,'');
+INSERT INTO Task VALUES(170,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_4/track_10.mp3',1,170,20,0,0,0,'');
+INSERT INTO Task VALUES(171,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_1.mp3',1,171,21,0,0,0,'');
+INSERT INTO Task VALUES(172,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_2.mp3',1,172,21,0,0,0,'');
+INSERT INTO Task VALUES(173,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_3.mp3',1,173,21,0,0,0,'');
+INSERT INTO Task VALUES(174,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_4.mp3',1,174,21,0,0,0,'');
+INSERT INTO Task VALUES(175,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_5.mp3',1,175,21,0,0,0,'');
+INSERT INTO Task VALUES(176,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_6.mp3',1,176,21,0,0,0,'');
+INSERT INTO Task VALUES(177,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_7.mp3',1,177,21,0,0,0,'');
+INSERT INTO Task VALUES(178,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_8.mp3',1,178,21,0,0,0,'');
+INSERT INTO Task VALUES(179,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_9.mp3',1,179,21,0,0,0,'');
+INSERT INTO Task VALUES(180,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_3/track_10.mp3',1,180,21,0,0,0,'');
+INSERT INTO Task VALUES(181,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_1.mp3',1,181,22,0,0,0,'');
+INSERT INTO Task VALUES(182,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_2.mp3',1,182,22,0,0,0,'');
+INSERT INTO Task VALUES(183,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_3.mp3',1,183,22,0,0,0,'');
+INSERT INTO Task VALUES(184,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_4.mp3',1,184,22,0,0,0,'');
+INSERT INTO Task VALUES(185,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_5.mp3',1,185,22,0,0,0,'');
+INSERT INTO Task VALUES(186,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_6.mp3',1,186,22,0,0,0,'');
+INSERT INTO Task VALUES(187,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_7.mp3',1,187,22,0,0,0,'');
+INSERT INTO Task VALUES(188,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_8.mp3',1,188,22,0,0,0,'');
+INSERT INTO Task VALUES(189,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_9.mp3',1,189,22,0,0,0,'');
+INSERT INTO Task VALUES(190,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_2/track_10.mp3',1,190,22,0,0,0,'');
+INSERT INTO Task VALUES(191,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_1.mp3',1,191,23,0,0,0,'');
+INSERT INTO Task VALUES(192,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_2.mp3',1,192,23,0,0,0,'');
+INSERT INTO Task VALUES(193,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_3.mp3',1,193,23,0,0,0,'');
+INSERT INTO Task VALUES(194,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_4.mp3',1,194,23,0,0,0,'');
+INSERT INTO Task VALUES(195,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_5.mp3',1,195,23,0,0,0,'');
+INSERT INTO Task VALUES(196,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_6.mp3',1,196,23,0,0,0,'');
+INSERT INTO Task VALUES(197,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_7.mp3',1,197,23,0,0,0,'');
+INSERT INTO Task VALUES(198,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_8.mp3',1,198,23,0,0,0,'');
+INSERT INTO Task VALUES(199,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_9.mp3',1,199,23,0,0,0,'');
+INSERT INTO Task VALUES(200,3,2,0,'file:///builds/videolan/medialibrary/dummysamples/artist_1/album_1/track_10.mp3',1,200,23,0,0,0,'');
+COMMIT;
@@ -0,0 +1,261 @@
+/*****************************************************************************
+ * Media Library
+ *****************************************************************************
+ * Copyright (C) 2024 Hugo Beauzée-Luyssen, Videolabs, VideoLAN
+ *
+ * Authors: Hugo Beauzée-Luyssen <hugo@beauzee.fr>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include "medialibrary/ICacher.h"
+#include "compat/Mutex.h"
+#include "compat/ConditionVariable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mock
+{
+
+/**
+ * @brief The SimulatedCacher class writes dummy content at a configurable pace
+ *
+ * Each input MRL can be configured with a latency, a size and a throughput,
+ * and can be made to fail once partway through to exercise the resume path.
+ * Transfers can also be held until released by the test, or started in
+ * batches, which allows the tests to control the ordering without relying on
+ * timings.
+ */
+class SimulatedCacher : public medialibrary::ICacher
+{
+public:
+    struct Source
+    {
+        std::chrono::milliseconds latency;
+        uint64_t size;
+        /* 0 means no throughput limit */
+        uint64_t bytesPerSec;
+        /* If non 0, the first transfer fails after writing this many bytes */
+        uint64_t failAfter;
+        /* If true, the transfer doesn't start until release() gets called */
+        bool held;
+    };
+
+    explicit SimulatedCacher( bool concurrent = true )
+        : m_concurrent( concurrent )
+        , m_resumable( true )
+        , m_interrupted( false )
+        , m_released( false )
+        , m_batchSize( 0 )
+        , m_nbArrived( 0 )
+        , m_nbBatches( 0 )
+        , m_nbRunning( 0 )
+        , m_maxConcurrency( 0 )
+    {
+    }
+
+    void setResumable( bool resumable )
+    {
+        m_resumable = resumable;
+    }
+
+    /**
+     * Only let the transfers start once batchSize of them are running. The
+     * number of transfers must be a multiple of the batch size.
+     */
+    void setBatchSize( uint32_t batchSize )
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_batchSize = batchSize;
+    }
+
+    void release()
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_released = true;
+        m_cond.notify_all();
+    }
+
+    void addSource( const std::string& mrl, Source source )
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_sources[mrl] = std::move( source );
+    }
+
+    virtual bool cache( const std::string& inputMrl,
+                        const std::string& outputPath ) override
+    {
+        return transfer( inputMrl, outputPath, 0 );
+    }
+
+    virtual bool resume( const std::string& inputMrl,
+                         const std::string& outputPath,
+                         uint64_t offset ) override
+    {
+        {
+            std::lock_guard<compat::Mutex> lock{ m_mutex };
+            m_resumed.push_back( offset );
+        }
+        return transfer( inputMrl, outputPath, offset );
+    }
+
+    virtual void interrupt() override
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        m_interrupted = true;
+        m_cond.notify_all();
+    }
+
+    virtual bool canCacheConcurrently() const override
+    {
+        return m_concurrent;
+    }
+
+    virtual bool canResume() const override
+    {
+        return m_resumable;
+    }
+
+    uint32_t maxConcurrency()
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        return m_maxConcurrency;
+    }
+
+    std::vector<std::string> startOrder()
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        return m_startOrder;
+    }
+
+    std::vector<uint64_t> resumeOffsets()
+    {
+        std::lock_guard<compat::Mutex> lock{ m_mutex };
+        return m_resumed;
+    }
+
+private:
+    bool transfer( const std::string& inputMrl, const std::string& outputPath,
+                   uint64_t offset )
+    {
+        std::unique_lock<compat::Mutex> lock{ m_mutex };
+        auto it = m_sources.find( inputMrl );
+        if ( it == end( m_sources ) )
+            return false;
+        auto source = it->second;
+        /* Only fail once, so the transfer can be resumed */
+        it->second.failAfter = 0;
+        m_startOrder.push_back( inputMrl );
+        m_maxConcurrency = std::max( m_maxConcurrency, ++m_nbRunning );
+        if ( m_batchSize > 0 )
+        {
+            auto batch = m_nbBatches;
+            if ( ++m_nbArrived == m_batchSize )
+            {
+                m_nbArrived = 0;
+                ++m_nbBatches;
+                m_cond.notify_all();
+            }
+            else
+            {
+                m_cond.wait( lock, [this, batch]() {
+                    return m_nbBatches != batch || m_interrupted;
+                });
+            }
+        }
+        if ( source.held == true )
+        {
+            m_cond.wait( lock, [this]() {
+                return m_released || m_interrupted;
+            });
+        }
+        auto res = write( lock, source, outputPath, offset );
+        --m_nbRunning;
+        return res;
+    }
+
+    bool write( std::unique_lock<compat::Mutex>& lock, const Source& source,
+                const std::string& outputPath, uint64_t offset )
+    {
+        if ( m_cond.wait_for( lock, source.latency,
+                              [this]() { return m_interrupted; } ) == true )
+            return false;
+        lock.unlock();
+        auto f = fopen( outputPath.c_str(), offset > 0 ? "ab" : "wb" );
+        lock.lock();
+        if ( f == nullptr )
+            return false;
+        const uint64_t ChunkSize = 4096;
+        std::vector<char> buff( ChunkSize, 'x' );
+        auto written = offset;
+        auto res = true;
+        while ( written < source.size )
+        {
+            auto chunk = std::min( ChunkSize, source.size - written );
+            if ( source.failAfter > 0 && written + chunk > source.failAfter )
+            {
+                chunk = source.failAfter - written;
+                res = false;
+            }
+            lock.unlock();
+            fwrite( buff.data(), chunk, 1, f );
+            lock.lock();
+            written += chunk;
+            if ( res == false )
+                break;
+            if ( source.bytesPerSec > 0 )
+            {
+                auto delay = std::chrono::microseconds{
+                        chunk * 1000000 / source.bytesPerSec };
+                if ( m_cond.wait_for( lock, delay,
+                                      [this]() { return m_interrupted; } ) == true )
+                {
+                    res = false;
+                    break;
+                }
+            }
+        }
+        lock.unlock();
+        fclose( f );
+        lock.lock();
+        return res;
+    }
+
+private:
+    bool m_concurrent;
+    bool m_resumable;
+    compat::Mutex m_mutex;
+    compat::ConditionVariable m_cond;
+    bool m_interrupted;
+    bool m_released;
+    uint32_t m_batchSize;
+    uint32_t m_nbArrived;
+    uint32_t m_nbBatches;
+    std::unordered_map<std::string, Source> m_sources;
+    uint32_t m_nbRunning;
+    uint32_t m_maxConcurrency;
+    std::vector<std::string> m_startOrder;
+    std::vector<uint64_t> m_resumed;
+};
+
+}